@@ -0,0 +1,133 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "allocator.h"
+#include "benchmark.h"
+#include "cpu.h"
+#include "platform.h"
+
+// blob and workspace sizes seen in a typical inference
+static const size_t g_sizes[] = {
+    64, 256, 1024, 4096, 9280, 18496, 36928, 55360, 73792, 131136, 200768, 401472, 802880, 1605696
+};
+
+static const int g_size_count = sizeof(g_sizes) / sizeof(g_sizes[0]);
+
+struct bench_args
+{
+    ncnn::Allocator* allocator;
+    int loop_count;
+    int seed;
+};
+
+static void* bench_worker(void* _args)
+{
+    bench_args* args = (bench_args*)_args;
+    ncnn::Allocator* allocator = args->allocator;
+
+    // a window of live blocks like the blobs alive during forward
+    const int slot_count = 8;
+    void* ptrs[slot_count];
+    memset(ptrs, 0, sizeof(ptrs));
+
+    unsigned int rng = args->seed;
+    for (int i = 0; i < args->loop_count; i++)
+    {
+        rng = rng * 1103515245 + 12345;
+        const int slot = (rng >> 16) % slot_count;
+
+        if (ptrs[slot])
+        {
+            allocator->fastFree(ptrs[slot]);
+            ptrs[slot] = 0;
+        }
+        else
+        {
+            rng = rng * 1103515245 + 12345;
+            const size_t size = g_sizes[(rng >> 16) % g_size_count];
+            ptrs[slot] = allocator->fastMalloc(size);
+
+            // touch the block
+            ((unsigned char*)ptrs[slot])[0] = 0;
+        }
+    }
+
+    for (int i = 0; i < slot_count; i++)
+    {
+        if (ptrs[i])
+            allocator->fastFree(ptrs[i]);
+    }
+
+    return 0;
+}
+
+static void benchmark(const char* comment, ncnn::Allocator* allocator, int thread_count, int loop_count)
+{
+    std::vector<bench_args> args(thread_count);
+    std::vector<ncnn::Thread*> threads(thread_count);
+
+    double start = ncnn::get_current_time();
+
+    for (int i = 0; i < thread_count; i++)
+    {
+        args[i].allocator = allocator;
+        args[i].loop_count = loop_count;
+        args[i].seed = i + 1;
+        threads[i] = new ncnn::Thread(bench_worker, (void*)&args[i]);
+    }
+
+    for (int i = 0; i < thread_count; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    double end = ncnn::get_current_time();
+
+    const double ops = (double)thread_count * loop_count;
+    fprintf(stderr, "%24s  threads = %2d  time = %8.2f ms  %7.2f Mops/s\n", comment, thread_count, end - start, ops / ((end - start) * 1000));
+}
+
+int main(int argc, char** argv)
+{
+    int loop_count = 1000000;
+    int max_threads = ncnn::get_cpu_count();
+
+    if (argc >= 2)
+    {
+        loop_count = atoi(argv[1]);
+    }
+    if (argc >= 3)
+    {
+        max_threads = atoi(argv[2]);
+    }
+
+    fprintf(stderr, "loop_count = %d\n", loop_count);
+    fprintf(stderr, "max_threads = %d\n", max_threads);
+
+    for (int t = 1; t <= max_threads; t *= 2)
+    {
+        {
+            ncnn::PoolAllocator allocator;
+            allocator.set_size_compare_ratio(0.f);
+            benchmark("PoolAllocator", &allocator, t, loop_count);
+        }
+        {
+            ncnn::LockFreePoolAllocator allocator;
+            benchmark("LockFreePoolAllocator", &allocator, t, loop_count);
+        }
+        if (t == 1)
+        {
+            ncnn::UnlockedPoolAllocator allocator;
+            allocator.set_size_compare_ratio(0.f);
+            benchmark("UnlockedPoolAllocator", &allocator, t, loop_count);
+        }
+    }
+
+    return 0;
+}
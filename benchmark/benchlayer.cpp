@@ -0,0 +1,219 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "benchmark.h"
+#include "cpu.h"
+#include "layer.h"
+#include "modelbin.h"
+#include "paramdict.h"
+#include "platform.h"
+
+static ncnn::Mat RandomMat(int w, int h = 0, int d = 0, int c = 0)
+{
+    ncnn::Mat m;
+    if (c > 0)
+        m.create(w, h, d, c);
+    else if (h > 0)
+        m.create(w, h);
+    else
+        m.create(w);
+
+    unsigned int rng = 7767517;
+    for (int q = 0; q < m.c; q++)
+    {
+        float* ptr = m.channel(q);
+        for (int i = 0; i < m.w * m.h * m.d; i++)
+        {
+            rng = rng * 1103515245 + 12345;
+            ptr[i] = (float)((rng >> 16) % 2000) / 1000.f - 1.f;
+        }
+    }
+
+    return m;
+}
+
+// the elempack Net::convert_layout would feed this layer
+static int resolve_elempack(const ncnn::Layer* layer, const ncnn::Mat& m, const ncnn::Option& opt)
+{
+    if (!opt.use_packing_layout || !layer->support_packing)
+        return 1;
+
+    int elemcount = 0;
+    if (m.dims == 1) elemcount = m.w;
+    if (m.dims == 2) elemcount = m.h;
+    if (m.dims == 3 || m.dims == 4) elemcount = m.c;
+
+#if NCNN_AVX512
+    if (elemcount % 16 == 0 && ncnn::cpu_support_x86_avx512())
+        return 16;
+#endif
+#if NCNN_AVX512 || NCNN_AVX
+    if (elemcount % 8 == 0 && ncnn::cpu_support_x86_avx())
+        return 8;
+#endif
+    if (elemcount % 4 == 0)
+        return 4;
+
+    return 1;
+}
+
+static double benchmark_layer(ncnn::Layer* layer, const ncnn::ParamDict& pd, const std::vector<ncnn::Mat>& weights, const ncnn::Mat& bottom_blob, int loop_count, const ncnn::Option& opt)
+{
+    layer->load_param(pd);
+
+    if (!weights.empty())
+    {
+        layer->load_model(ncnn::ModelBinFromMatArray(weights.data()));
+    }
+
+    layer->create_pipeline(opt);
+
+    ncnn::Mat bottom_blob_packed;
+    ncnn::convert_packing(bottom_blob, bottom_blob_packed, resolve_elempack(layer, bottom_blob, opt), opt);
+
+    // warm up
+    ncnn::Mat top_blob;
+    layer->forward(bottom_blob_packed, top_blob, opt);
+
+    double start = ncnn::get_current_time();
+
+    for (int i = 0; i < loop_count; i++)
+    {
+        layer->forward(bottom_blob_packed, top_blob, opt);
+    }
+
+    double end = ncnn::get_current_time();
+
+    layer->destroy_pipeline(opt);
+
+    return (end - start) / loop_count;
+}
+
+static void benchmark(const char* comment, const char* type, const ncnn::ParamDict& pd, const std::vector<ncnn::Mat>& weights, const ncnn::Mat& bottom_blob, int loop_count, const ncnn::Option& opt)
+{
+    ncnn::Layer* naive = ncnn::create_layer_naive(type);
+    ncnn::Layer* optimized = ncnn::create_layer_cpu(type);
+
+    ncnn::Option opt_naive = opt;
+    opt_naive.use_packing_layout = false;
+
+    const double time_naive = benchmark_layer(naive, pd, weights, bottom_blob, loop_count, opt_naive);
+    const double time_optimized = benchmark_layer(optimized, pd, weights, bottom_blob, loop_count, opt);
+
+    delete naive;
+    delete optimized;
+
+    fprintf(stderr, "%40s  naive = %8.3f ms  optimized = %8.3f ms  speedup = %5.2fx\n", comment, time_naive, time_optimized, time_naive / time_optimized);
+}
+
+static void benchmark_convolution3d(const char* type, int depthwise, int deconv, int ch, int kernel, int stride, int loop_count, const ncnn::Option& opt)
+{
+    const int maxk = kernel * kernel * kernel;
+    const int weight_data_size = depthwise ? ch * maxk : ch * ch * maxk;
+
+    ncnn::ParamDict pd;
+    pd.set(0, ch);                      // num_output
+    pd.set(1, kernel);                  // kernel_w
+    pd.set(3, stride);                  // stride_w
+    pd.set(4, deconv ? 0 : kernel / 2); // pad_left
+    pd.set(5, 1);                       // bias_term
+    pd.set(6, weight_data_size);        // weight_data_size
+    pd.set(7, depthwise ? ch : 1);      // group
+
+    std::vector<ncnn::Mat> weights(2);
+    weights[0] = RandomMat(weight_data_size);
+    weights[1] = RandomMat(ch);
+
+    const int size = deconv ? 12 : 24;
+    ncnn::Mat a = RandomMat(size, size, size, ch);
+
+    char comment[64];
+    sprintf(comment, "%s c=%d k=%d s=%d", type, ch, kernel, stride);
+    benchmark(comment, type, pd, weights, a, loop_count, opt);
+}
+
+static void benchmark_convolution1d(const char* type, int depthwise, int deconv, int ch, int kernel, int stride, int loop_count, const ncnn::Option& opt)
+{
+    const int weight_data_size = depthwise ? ch * kernel : ch * ch * kernel;
+
+    ncnn::ParamDict pd;
+    pd.set(0, ch);                      // num_output
+    pd.set(1, kernel);                  // kernel_w
+    pd.set(3, stride);                  // stride_w
+    pd.set(4, deconv ? 0 : kernel / 2); // pad_left
+    pd.set(5, 1);                       // bias_term
+    pd.set(6, weight_data_size);        // weight_data_size
+    pd.set(7, depthwise ? ch : 1);      // group
+
+    std::vector<ncnn::Mat> weights(2);
+    weights[0] = RandomMat(weight_data_size);
+    weights[1] = RandomMat(ch);
+
+    ncnn::Mat a = RandomMat(deconv ? 1024 : 4096, ch);
+
+    char comment[64];
+    sprintf(comment, "%s c=%d k=%d s=%d", type, ch, kernel, stride);
+    benchmark(comment, type, pd, weights, a, loop_count, opt);
+}
+
+static void benchmark_pooling(const char* type, int dims, int pooling_type, int ch, int kernel, int stride, int loop_count, const ncnn::Option& opt)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, pooling_type); // pooling_type
+    pd.set(1, kernel);       // kernel_w
+    pd.set(2, stride);       // stride_w
+    pd.set(3, kernel / 2);   // pad_left
+
+    std::vector<ncnn::Mat> weights;
+
+    ncnn::Mat a = dims == 1 ? RandomMat(4096, ch) : RandomMat(24, 24, 24, ch);
+
+    char comment[64];
+    sprintf(comment, "%s %s c=%d k=%d s=%d", type, pooling_type == 0 ? "max" : "avg", ch, kernel, stride);
+    benchmark(comment, type, pd, weights, a, loop_count, opt);
+}
+
+int main(int argc, char** argv)
+{
+    int loop_count = 10;
+    int num_threads = ncnn::get_physical_big_cpu_count();
+
+    if (argc >= 2)
+    {
+        loop_count = atoi(argv[1]);
+    }
+    if (argc >= 3)
+    {
+        num_threads = atoi(argv[2]);
+    }
+
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+    opt.use_fp16_storage = false;
+    opt.use_bf16_storage = false;
+
+    fprintf(stderr, "loop_count = %d\n", loop_count);
+    fprintf(stderr, "num_threads = %d\n", num_threads);
+
+    benchmark_convolution1d("ConvolutionDepthWise1D", 1, 0, 64, 3, 1, loop_count, opt);
+    benchmark_convolution1d("ConvolutionDepthWise1D", 1, 0, 256, 7, 1, loop_count, opt);
+    benchmark_convolution1d("Deconvolution1D", 0, 1, 64, 4, 2, loop_count, opt);
+
+    benchmark_convolution3d("Convolution3D", 0, 0, 16, 3, 1, loop_count, opt);
+    benchmark_convolution3d("Convolution3D", 0, 0, 64, 3, 2, loop_count, opt);
+    benchmark_convolution3d("ConvolutionDepthWise3D", 1, 0, 64, 3, 1, loop_count, opt);
+    benchmark_convolution3d("Deconvolution3D", 0, 1, 32, 2, 2, loop_count, opt);
+    benchmark_convolution3d("DeconvolutionDepthWise3D", 1, 1, 64, 2, 2, loop_count, opt);
+
+    benchmark_pooling("Pooling1D", 1, 0, 64, 3, 2, loop_count, opt);
+    benchmark_pooling("Pooling1D", 1, 1, 64, 3, 2, loop_count, opt);
+    benchmark_pooling("Pooling3D", 3, 0, 64, 3, 2, loop_count, opt);
+    benchmark_pooling("Pooling3D", 3, 1, 64, 3, 2, loop_count, opt);
+
+    return 0;
+}
@@ -40,6 +40,9 @@ static bool g_enable_cooling_down = true;
 static ncnn::UnlockedPoolAllocator g_blob_pool_allocator;
 static ncnn::PoolAllocator g_workspace_pool_allocator;
 
+// branch parallel layers allocate blobs concurrently
+static ncnn::PoolAllocator g_blob_locked_pool_allocator;
+
 #if NCNN_VULKAN
 static ncnn::VulkanDevice* g_vkdev = 0;
 static ncnn::VkAllocator* g_blob_vkallocator = 0;
@@ -50,6 +53,7 @@ void benchmark(const char* comment, const std::vector<ncnn::Mat>& _in, const ncn
 {
     g_blob_pool_allocator.clear();
     g_workspace_pool_allocator.clear();
+    g_blob_locked_pool_allocator.clear();
 
 #if NCNN_VULKAN
     if (opt.use_vulkan_compute)
@@ -177,6 +181,7 @@ void show_usage()
     fprintf(stderr, "Usage: benchncnn [loop count] [num threads] [powersave] [gpu device] [cooling down] [(key=value)...]\n");
     fprintf(stderr, "  param=model.param\n");
     fprintf(stderr, "  shape=[227,227,3],...\n");
+    fprintf(stderr, "  branch=1\n");
 }
 
 static std::vector<ncnn::Mat> parse_shape_list(char* s)
@@ -250,6 +255,7 @@ int main(int argc, char** argv)
     int cooling_down = 1;
     char* model = 0;
     std::vector<ncnn::Mat> inputs;
+    int branch_parallel = 0;
 
     for (int i = 1; i < argc; i++)
     {
@@ -308,6 +314,8 @@ int main(int argc, char** argv)
             model = value;
         if (strcmp(key, "shape") == 0)
             inputs = parse_shape_list(value);
+        if (strcmp(key, "branch") == 0)
+            branch_parallel = atoi(value);
     }
 
     if (model && inputs.empty())
@@ -330,6 +338,7 @@ int main(int argc, char** argv)
 
     g_blob_pool_allocator.set_size_compare_ratio(0.f);
     g_workspace_pool_allocator.set_size_compare_ratio(0.f);
+    g_blob_locked_pool_allocator.set_size_compare_ratio(0.f);
 
 #if NCNN_VULKAN
     if (use_vulkan_compute)
@@ -371,11 +380,18 @@ int main(int argc, char** argv)
     opt.use_packing_layout = true;
     opt.use_shader_pack8 = false;
 
+    if (branch_parallel)
+    {
+        opt.use_branch_parallel = true;
+        opt.blob_allocator = &g_blob_locked_pool_allocator;
+    }
+
     fprintf(stderr, "loop_count = %d\n", g_loop_count);
     fprintf(stderr, "num_threads = %d\n", num_threads);
     fprintf(stderr, "powersave = %d\n", ncnn::get_cpu_powersave());
     fprintf(stderr, "gpu_device = %d\n", gpu_device);
     fprintf(stderr, "cooling_down = %d\n", (int)g_enable_cooling_down);
+    fprintf(stderr, "branch_parallel = %d\n", branch_parallel);
 
     if (model != 0)
     {
@@ -127,6 +127,12 @@ PYBIND11_MODULE(ncnn, m)
     .def("clear", &UnlockedPoolAllocator::clear)
     .def("fastMalloc", &UnlockedPoolAllocator::fastMalloc, py::arg("size"))
     .def("fastFree", &UnlockedPoolAllocator::fastFree, py::arg("ptr"));
+    py::class_<LockFreePoolAllocator, Allocator, PyAllocatorOther<LockFreePoolAllocator> >(m, "LockFreePoolAllocator")
+    .def(py::init<>())
+    .def("set_size_drop_threshold", &LockFreePoolAllocator::set_size_drop_threshold, py::arg("threshold"))
+    .def("clear", &LockFreePoolAllocator::clear)
+    .def("fastMalloc", &LockFreePoolAllocator::fastMalloc, py::arg("size"))
+    .def("fastFree", &LockFreePoolAllocator::fastFree, py::arg("ptr"));
 
     py::class_<DataReader, PyDataReader<> >(m, "DataReader")
     .def(py::init<>())
@@ -203,6 +209,8 @@ PYBIND11_MODULE(ncnn, m)
     .def_readwrite("use_packing_layout", &Option::use_packing_layout)
     .def_readwrite("use_shader_pack8", &Option::use_shader_pack8)
     .def_readwrite("use_subgroup_ops", &Option::use_subgroup_ops)
+    .def_readwrite("use_branch_parallel", &Option::use_branch_parallel)
+    .def_readwrite("use_storage_assignment", &Option::use_storage_assignment)
     .def_readwrite("use_tensor_storage", &Option::use_tensor_storage);
 
     py::class_<Mat> mat(m, "Mat", py::buffer_protocol());
@@ -833,6 +841,15 @@ PYBIND11_MODULE(ncnn, m)
     .value("PIXEL_BGRA2GRAY", ncnn::Mat::PixelType::PIXEL_BGRA2GRAY)
     .value("PIXEL_BGRA2RGBA", ncnn::Mat::PixelType::PIXEL_BGRA2RGBA);
 
+    py::class_<Profiler>(m, "Profiler")
+    .def(py::init<>())
+    .def("clear", &Profiler::clear)
+    .def("print_summary", &Profiler::print_summary)
+#if NCNN_STDIO
+    .def("write_chrome_trace", &Profiler::write_chrome_trace, py::arg("path"))
+#endif // NCNN_STDIO
+    ;
+
     py::class_<Extractor>(m, "Extractor")
     .def("__enter__", [](Extractor& ex) -> Extractor& { return ex; })
     .def("__exit__", [](Extractor& ex, pybind11::args) {
@@ -843,6 +860,7 @@ PYBIND11_MODULE(ncnn, m)
     .def("set_num_threads", &Extractor::set_num_threads, py::arg("num_threads"))
     .def("set_blob_allocator", &Extractor::set_blob_allocator, py::arg("allocator"))
     .def("set_workspace_allocator", &Extractor::set_workspace_allocator, py::arg("allocator"))
+    .def("set_profiler", &Extractor::set_profiler, py::arg("profiler"))
 #if NCNN_STRING
     .def("input", (int (Extractor::*)(const char*, const Mat&)) & Extractor::input, py::arg("blob_name"), py::arg("in"))
     .def("extract", (int (Extractor::*)(const char*, Mat&, int)) & Extractor::extract, py::arg("blob_name"), py::arg("feat"), py::arg("type") = 0)
@@ -853,6 +871,18 @@ PYBIND11_MODULE(ncnn, m)
         return py::make_tuple(ret, feat.clone());
     },
     py::arg("blob_name"), py::arg("type") = 0)
+    .def("input_batch", (int (Extractor::*)(const char*, const std::vector<Mat>&)) & Extractor::input, py::arg("blob_name"), py::arg("in"))
+    .def(
+    "extract_batch", [](Extractor& ex, const char* blob_name, int type) {
+        std::vector<ncnn::Mat> feats;
+        int ret = ex.extract(blob_name, feats, type);
+        for (size_t i = 0; i < feats.size(); i++)
+        {
+            feats[i] = feats[i].clone();
+        }
+        return py::make_tuple(ret, feats);
+    },
+    py::arg("blob_name"), py::arg("type") = 0)
 #endif
     .def("input", (int (Extractor::*)(int, const Mat&)) & Extractor::input)
     .def("extract", (int (Extractor::*)(int, Mat&, int)) & Extractor::extract, py::arg("blob_index"), py::arg("feat"), py::arg("type") = 0)
@@ -862,6 +892,18 @@ PYBIND11_MODULE(ncnn, m)
         int ret = ex.extract(blob_index, feat, type);
         return py::make_tuple(ret, feat.clone());
     },
+    py::arg("blob_index"), py::arg("type") = 0)
+    .def("input_batch", (int (Extractor::*)(int, const std::vector<Mat>&)) & Extractor::input, py::arg("blob_index"), py::arg("in"))
+    .def(
+    "extract_batch", [](Extractor& ex, int blob_index, int type) {
+        std::vector<ncnn::Mat> feats;
+        int ret = ex.extract(blob_index, feats, type);
+        for (size_t i = 0; i < feats.size(); i++)
+        {
+            feats[i] = feats[i].clone();
+        }
+        return py::make_tuple(ret, feats);
+    },
     py::arg("blob_index"), py::arg("type") = 0);
 
     py::class_<Layer, PyLayer>(m, "Layer")
@@ -960,7 +1002,24 @@ PYBIND11_MODULE(ncnn, m)
         net.load_model(dr);
     },
     py::arg("mem"))
+    .def("load_model_mmap", &Net::load_model_mmap, py::arg("modelpath"))
+    .def("set_weight_cache", &Net::set_weight_cache, py::arg("path"))
 #endif // NCNN_STDIO
+    .def("referenced_weight_bytes", &Net::referenced_weight_bytes, py::arg("layer_index") = -1)
+    .def("set_lazy_pipeline", &Net::set_lazy_pipeline, py::arg("lazy"))
+#if NCNN_STRING
+    .def(
+    "declare_outputs", [](Net& net, const std::vector<std::string>& blob_names) {
+        std::vector<const char*> names(blob_names.size());
+        for (size_t i = 0; i < blob_names.size(); i++)
+        {
+            names[i] = blob_names[i].c_str();
+        }
+        return net.declare_outputs(names);
+    },
+    py::arg("blob_names"))
+#endif // NCNN_STRING
+    .def("declare_outputs", (int (Net::*)(const std::vector<int>&)) & Net::declare_outputs, py::arg("blob_indexes"))
 
     .def("clear", &Net::clear)
     .def("create_extractor", &Net::create_extractor, py::keep_alive<0, 1>()) //net should be kept alive until retuned ex is freed by gc
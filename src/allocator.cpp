@@ -3,9 +3,12 @@
 
 #include "allocator.h"
 
+#include "atomicops.h"
 #include "gpu.h"
 #include "pipeline.h"
 
+#include <string.h>
+
 #if __ANDROID_API__ >= 26
 #include <android/hardware_buffer.h>
 #endif // __ANDROID_API__ >= 26
@@ -346,6 +349,316 @@ void UnlockedPoolAllocator::fastFree(void* ptr)
     ncnn::fastFree(ptr);
 }
 
+// size classes are 64 and then four classes per power of two up to 2^31
+#define LOCKFREE_POOL_MIN_SHIFT  6
+#define LOCKFREE_POOL_MAX_SHIFT  30
+#define LOCKFREE_POOL_CLASS_NUM  (1 + (LOCKFREE_POOL_MAX_SHIFT - LOCKFREE_POOL_MIN_SHIFT + 1) * 4)
+#define LOCKFREE_POOL_CACHE_SIZE 4
+#define LOCKFREE_POOL_MAGIC      0x4c465041
+
+// return -1 for huge size that is never pooled
+static int lockfree_pool_size_class(size_t size)
+{
+    if (size <= ((size_t)1 << LOCKFREE_POOL_MIN_SHIFT))
+        return 0;
+
+    // size in (2^k, 2^(k+1)]
+    int k = LOCKFREE_POOL_MIN_SHIFT;
+    while (k <= LOCKFREE_POOL_MAX_SHIFT && size > ((size_t)1 << (k + 1)))
+        k++;
+
+    if (k > LOCKFREE_POOL_MAX_SHIFT)
+        return -1;
+
+    const size_t step = (size_t)1 << (k - 2);
+    const int j = (int)((size - ((size_t)1 << k) + step - 1) / step);
+
+    return 1 + (k - LOCKFREE_POOL_MIN_SHIFT) * 4 + (j - 1);
+}
+
+static size_t lockfree_pool_class_size(int size_class)
+{
+    if (size_class == 0)
+        return (size_t)1 << LOCKFREE_POOL_MIN_SHIFT;
+
+    const int k = LOCKFREE_POOL_MIN_SHIFT + (size_class - 1) / 4;
+    const int j = (size_class - 1) % 4 + 1;
+
+    return ((size_t)1 << k) + j * ((size_t)1 << (k - 2));
+}
+
+// block header right before the returned pointer
+struct LockFreePoolBlock
+{
+    LockFreePoolBlock* next;
+    int size_class;
+    int magic;
+};
+
+static NCNN_FORCEINLINE void* lockfree_pool_block_data(LockFreePoolBlock* block)
+{
+    return (unsigned char*)block + NCNN_MALLOC_ALIGN;
+}
+
+static NCNN_FORCEINLINE LockFreePoolBlock* lockfree_pool_data_block(void* ptr)
+{
+    return (LockFreePoolBlock*)((unsigned char*)ptr - NCNN_MALLOC_ALIGN);
+}
+
+class LockFreePoolAllocatorPrivate
+{
+public:
+    struct ThreadCache
+    {
+        LockFreePoolBlock* budgets[LOCKFREE_POOL_CLASS_NUM];
+        int budget_counts[LOCKFREE_POOL_CLASS_NUM];
+    };
+
+    ThreadCache* get_thread_cache();
+
+    // push a chain of blocks from first to last onto the shared list
+    void push_budgets(int size_class, LockFreePoolBlock* first, LockFreePoolBlock* last, int count);
+
+    size_t size_drop_threshold;
+
+    // shared lock-free budget lists of each size class
+    LockFreePoolBlock* budgets[LOCKFREE_POOL_CLASS_NUM];
+    int budget_counts[LOCKFREE_POOL_CLASS_NUM];
+
+    int payout_count;
+
+    ThreadLocalStorage thread_cache_tls;
+    Mutex thread_caches_lock;
+    std::vector<ThreadCache*> thread_caches;
+};
+
+LockFreePoolAllocatorPrivate::ThreadCache* LockFreePoolAllocatorPrivate::get_thread_cache()
+{
+    ThreadCache* tc = (ThreadCache*)thread_cache_tls.get();
+    if (tc)
+        return tc;
+
+    tc = new ThreadCache;
+    memset(tc, 0, sizeof(ThreadCache));
+
+    thread_caches_lock.lock();
+    thread_caches.push_back(tc);
+    thread_caches_lock.unlock();
+
+    thread_cache_tls.set(tc);
+
+    return tc;
+}
+
+void LockFreePoolAllocatorPrivate::push_budgets(int size_class, LockFreePoolBlock* first, LockFreePoolBlock* last, int count)
+{
+    NCNN_XADD(&budget_counts[size_class], count);
+
+    void** head = (void**)&budgets[size_class];
+    for (;;)
+    {
+        LockFreePoolBlock* old_head = (LockFreePoolBlock*)atomic_load_ptr(head);
+        last->next = old_head;
+        if (atomic_compare_exchange_ptr(head, old_head, first))
+            break;
+    }
+}
+
+LockFreePoolAllocator::LockFreePoolAllocator()
+    : Allocator(), d(new LockFreePoolAllocatorPrivate)
+{
+    d->size_drop_threshold = 10;
+    memset(d->budgets, 0, sizeof(d->budgets));
+    memset(d->budget_counts, 0, sizeof(d->budget_counts));
+    d->payout_count = 0;
+}
+
+LockFreePoolAllocator::~LockFreePoolAllocator()
+{
+    clear();
+
+    if (d->payout_count != 0)
+    {
+        NCNN_LOGE("FATAL ERROR! lockfree pool allocator destroyed too early, %d still in use", d->payout_count);
+    }
+
+    for (size_t i = 0; i < d->thread_caches.size(); i++)
+    {
+        delete d->thread_caches[i];
+    }
+
+    delete d;
+}
+
+LockFreePoolAllocator::LockFreePoolAllocator(const LockFreePoolAllocator&)
+    : d(0)
+{
+}
+
+LockFreePoolAllocator& LockFreePoolAllocator::operator=(const LockFreePoolAllocator&)
+{
+    return *this;
+}
+
+void LockFreePoolAllocator::clear()
+{
+    for (int i = 0; i < LOCKFREE_POOL_CLASS_NUM; i++)
+    {
+        LockFreePoolBlock* block = (LockFreePoolBlock*)atomic_exchange_ptr((void**)&d->budgets[i], 0);
+        while (block)
+        {
+            LockFreePoolBlock* next = block->next;
+            ncnn::fastFree(block);
+            block = next;
+        }
+        d->budget_counts[i] = 0;
+    }
+
+    d->thread_caches_lock.lock();
+
+    for (size_t i = 0; i < d->thread_caches.size(); i++)
+    {
+        LockFreePoolAllocatorPrivate::ThreadCache* tc = d->thread_caches[i];
+        for (int j = 0; j < LOCKFREE_POOL_CLASS_NUM; j++)
+        {
+            LockFreePoolBlock* block = tc->budgets[j];
+            while (block)
+            {
+                LockFreePoolBlock* next = block->next;
+                ncnn::fastFree(block);
+                block = next;
+            }
+            tc->budgets[j] = 0;
+            tc->budget_counts[j] = 0;
+        }
+    }
+
+    d->thread_caches_lock.unlock();
+}
+
+void LockFreePoolAllocator::set_size_drop_threshold(size_t threshold)
+{
+    d->size_drop_threshold = threshold;
+}
+
+void* LockFreePoolAllocator::fastMalloc(size_t size)
+{
+    NCNN_XADD(&d->payout_count, 1);
+
+    const int size_class = lockfree_pool_size_class(size);
+    if (size_class == -1)
+    {
+        // huge block
+        LockFreePoolBlock* block = (LockFreePoolBlock*)ncnn::fastMalloc(size + NCNN_MALLOC_ALIGN);
+        if (!block)
+            return 0;
+
+        block->next = 0;
+        block->size_class = -1;
+        block->magic = LOCKFREE_POOL_MAGIC;
+        return lockfree_pool_block_data(block);
+    }
+
+    // pop from thread cache
+    LockFreePoolAllocatorPrivate::ThreadCache* tc = d->get_thread_cache();
+    LockFreePoolBlock* block = tc->budgets[size_class];
+    if (block)
+    {
+        tc->budgets[size_class] = block->next;
+        tc->budget_counts[size_class]--;
+        return lockfree_pool_block_data(block);
+    }
+
+    // take the whole shared list at once, no ABA hazard
+    block = (LockFreePoolBlock*)atomic_exchange_ptr((void**)&d->budgets[size_class], 0);
+    if (block)
+    {
+        int count = 1;
+        for (LockFreePoolBlock* p = block->next; p; p = p->next)
+        {
+            count++;
+        }
+        NCNN_XADD(&d->budget_counts[size_class], -count);
+
+        // refill thread cache and return the rest
+        LockFreePoolBlock* rest = block->next;
+        while (rest && tc->budget_counts[size_class] < LOCKFREE_POOL_CACHE_SIZE)
+        {
+            LockFreePoolBlock* next = rest->next;
+            rest->next = tc->budgets[size_class];
+            tc->budgets[size_class] = rest;
+            tc->budget_counts[size_class]++;
+            rest = next;
+        }
+
+        if (rest)
+        {
+            LockFreePoolBlock* last = rest;
+            int rest_count = 1;
+            while (last->next)
+            {
+                last = last->next;
+                rest_count++;
+            }
+            d->push_budgets(size_class, rest, last, rest_count);
+        }
+
+        return lockfree_pool_block_data(block);
+    }
+
+    // new
+    block = (LockFreePoolBlock*)ncnn::fastMalloc(lockfree_pool_class_size(size_class) + NCNN_MALLOC_ALIGN);
+    if (!block)
+        return 0;
+
+    block->next = 0;
+    block->size_class = size_class;
+    block->magic = LOCKFREE_POOL_MAGIC;
+    return lockfree_pool_block_data(block);
+}
+
+void LockFreePoolAllocator::fastFree(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    LockFreePoolBlock* block = lockfree_pool_data_block(ptr);
+    if (block->magic != LOCKFREE_POOL_MAGIC)
+    {
+        NCNN_LOGE("FATAL ERROR! lockfree pool allocator get wild %p", ptr);
+        ncnn::fastFree(ptr);
+        return;
+    }
+
+    NCNN_XADD(&d->payout_count, -1);
+
+    const int size_class = block->size_class;
+    if (size_class == -1)
+    {
+        ncnn::fastFree(block);
+        return;
+    }
+
+    // return to thread cache
+    LockFreePoolAllocatorPrivate::ThreadCache* tc = d->get_thread_cache();
+    if (tc->budget_counts[size_class] < LOCKFREE_POOL_CACHE_SIZE && (size_t)tc->budget_counts[size_class] < d->size_drop_threshold)
+    {
+        block->next = tc->budgets[size_class];
+        tc->budgets[size_class] = block;
+        tc->budget_counts[size_class]++;
+        return;
+    }
+
+    if ((size_t)atomic_load_int(&d->budget_counts[size_class]) >= d->size_drop_threshold)
+    {
+        // too many budgets of this size, return it to OS
+        ncnn::fastFree(block);
+        return;
+    }
+
+    d->push_budgets(size_class, block, block, 1);
+}
+
 #if NCNN_VULKAN
 VkAllocator::VkAllocator(const VulkanDevice* _vkdev)
     : vkdev(_vkdev)
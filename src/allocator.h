@@ -205,6 +205,35 @@ private:
     UnlockedPoolAllocatorPrivate* const d;
 };
 
+class LockFreePoolAllocatorPrivate;
+class NCNN_EXPORT LockFreePoolAllocator : public Allocator
+{
+public:
+    // thread-safe pool allocator for many threads sharing one instance
+    // requests are rounded up to size classes, four classes per power of two
+    // freed blocks go to a per-thread cache first, then to lock-free per-class lists
+    LockFreePoolAllocator();
+    ~LockFreePoolAllocator();
+
+    // budget drop threshold of each size class
+    // default threshold = 10
+    void set_size_drop_threshold(size_t);
+
+    // release all budgets immediately
+    // must not run concurrently with fastMalloc and fastFree
+    void clear();
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+private:
+    LockFreePoolAllocator(const LockFreePoolAllocator&);
+    LockFreePoolAllocator& operator=(const LockFreePoolAllocator&);
+
+private:
+    LockFreePoolAllocatorPrivate* const d;
+};
+
 #if NCNN_VULKAN
 
 class VulkanDevice;
@@ -0,0 +1,213 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_ATOMICOPS_H
+#define NCNN_ATOMICOPS_H
+
+// internal atomic primitives shared by the lock-free allocator, the inference pool and net
+// loads acquire, stores release, read-modify-write operations are full barriers
+
+#include "platform.h"
+
+namespace ncnn {
+
+#if NCNN_THREADS && defined _MSC_VER && !defined __clang__
+static NCNN_FORCEINLINE int atomic_load_int(int* addr)
+{
+    return InterlockedCompareExchange((LONG volatile*)addr, 0, 0);
+}
+
+static NCNN_FORCEINLINE void atomic_store_int(int* addr, int value)
+{
+    InterlockedExchange((LONG volatile*)addr, value);
+}
+
+static NCNN_FORCEINLINE bool atomic_compare_exchange_int(int* addr, int expected, int desired)
+{
+    return InterlockedCompareExchange((LONG volatile*)addr, desired, expected) == expected;
+}
+
+static NCNN_FORCEINLINE int atomic_fetch_add_int(int* addr, int value)
+{
+    return InterlockedExchangeAdd((LONG volatile*)addr, value);
+}
+
+static NCNN_FORCEINLINE void* atomic_load_ptr(void** addr)
+{
+    return InterlockedCompareExchangePointer((PVOID volatile*)addr, 0, 0);
+}
+
+static NCNN_FORCEINLINE bool atomic_compare_exchange_ptr(void** addr, void* expected, void* desired)
+{
+    return InterlockedCompareExchangePointer((PVOID volatile*)addr, desired, expected) == expected;
+}
+
+static NCNN_FORCEINLINE void* atomic_exchange_ptr(void** addr, void* value)
+{
+    return InterlockedExchangePointer((PVOID volatile*)addr, value);
+}
+
+static NCNN_FORCEINLINE void atomic_fence()
+{
+    MemoryBarrier();
+}
+#elif NCNN_THREADS && defined __GNUC__ && defined __ATOMIC_ACQ_REL && !(defined __riscv && !defined __riscv_atomic)
+static NCNN_FORCEINLINE int atomic_load_int(int* addr)
+{
+    return __atomic_load_n(addr, __ATOMIC_ACQUIRE);
+}
+
+static NCNN_FORCEINLINE void atomic_store_int(int* addr, int value)
+{
+    __atomic_store_n(addr, value, __ATOMIC_RELEASE);
+}
+
+static NCNN_FORCEINLINE bool atomic_compare_exchange_int(int* addr, int expected, int desired)
+{
+    return __atomic_compare_exchange_n(addr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+static NCNN_FORCEINLINE int atomic_fetch_add_int(int* addr, int value)
+{
+    return __atomic_fetch_add(addr, value, __ATOMIC_SEQ_CST);
+}
+
+static NCNN_FORCEINLINE void* atomic_load_ptr(void** addr)
+{
+    return __atomic_load_n(addr, __ATOMIC_ACQUIRE);
+}
+
+static NCNN_FORCEINLINE bool atomic_compare_exchange_ptr(void** addr, void* expected, void* desired)
+{
+    return __atomic_compare_exchange_n(addr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+static NCNN_FORCEINLINE void* atomic_exchange_ptr(void** addr, void* value)
+{
+    return __atomic_exchange_n(addr, value, __ATOMIC_ACQ_REL);
+}
+
+static NCNN_FORCEINLINE void atomic_fence()
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+#elif NCNN_THREADS && defined __GNUC__ && !(defined __riscv && !defined __riscv_atomic)
+static NCNN_FORCEINLINE int atomic_load_int(int* addr)
+{
+    return __sync_val_compare_and_swap(addr, 0, 0);
+}
+
+static NCNN_FORCEINLINE void atomic_store_int(int* addr, int value)
+{
+    __sync_synchronize();
+    *(volatile int*)addr = value;
+}
+
+static NCNN_FORCEINLINE bool atomic_compare_exchange_int(int* addr, int expected, int desired)
+{
+    return __sync_bool_compare_and_swap(addr, expected, desired);
+}
+
+static NCNN_FORCEINLINE int atomic_fetch_add_int(int* addr, int value)
+{
+    return __sync_fetch_and_add(addr, value);
+}
+
+static NCNN_FORCEINLINE void* atomic_load_ptr(void** addr)
+{
+    return __sync_val_compare_and_swap(addr, (void*)0, (void*)0);
+}
+
+static NCNN_FORCEINLINE bool atomic_compare_exchange_ptr(void** addr, void* expected, void* desired)
+{
+    return __sync_bool_compare_and_swap(addr, expected, desired);
+}
+
+static NCNN_FORCEINLINE void* atomic_exchange_ptr(void** addr, void* value)
+{
+    void* old;
+    do
+    {
+        old = *(void* volatile*)addr;
+    } while (!__sync_bool_compare_and_swap(addr, old, value));
+
+    return old;
+}
+
+static NCNN_FORCEINLINE void atomic_fence()
+{
+    __sync_synchronize();
+}
+#else
+// thread-unsafe branch
+static NCNN_FORCEINLINE int atomic_load_int(int* addr)
+{
+    return *addr;
+}
+
+static NCNN_FORCEINLINE void atomic_store_int(int* addr, int value)
+{
+    *addr = value;
+}
+
+static NCNN_FORCEINLINE bool atomic_compare_exchange_int(int* addr, int expected, int desired)
+{
+    if (*addr != expected)
+        return false;
+
+    *addr = desired;
+    return true;
+}
+
+static NCNN_FORCEINLINE int atomic_fetch_add_int(int* addr, int value)
+{
+    int old = *addr;
+    *addr += value;
+    return old;
+}
+
+static NCNN_FORCEINLINE void* atomic_load_ptr(void** addr)
+{
+    return *addr;
+}
+
+static NCNN_FORCEINLINE bool atomic_compare_exchange_ptr(void** addr, void* expected, void* desired)
+{
+    if (*addr != expected)
+        return false;
+
+    *addr = desired;
+    return true;
+}
+
+static NCNN_FORCEINLINE void* atomic_exchange_ptr(void** addr, void* value)
+{
+    void* old = *addr;
+    *addr = value;
+    return old;
+}
+
+static NCNN_FORCEINLINE void atomic_fence()
+{
+}
+#endif
+
+// unsigned counters that wrap around by design, int and unsigned int may alias
+static NCNN_FORCEINLINE unsigned int atomic_load_uint(unsigned int* addr)
+{
+    return (unsigned int)atomic_load_int((int*)addr);
+}
+
+static NCNN_FORCEINLINE void atomic_store_uint(unsigned int* addr, unsigned int value)
+{
+    atomic_store_int((int*)addr, (int)value);
+}
+
+static NCNN_FORCEINLINE bool atomic_compare_exchange_uint(unsigned int* addr, unsigned int expected, unsigned int desired)
+{
+    return atomic_compare_exchange_int((int*)addr, (int)expected, (int)desired);
+}
+
+} // namespace ncnn
+
+#endif // NCNN_ATOMICOPS_H
@@ -5,6 +5,18 @@
 
 #include <string.h>
 
+#if NCNN_STDIO
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#endif // NCNN_STDIO
+
 namespace ncnn {
 
 DataReader::DataReader()
@@ -76,6 +88,117 @@ size_t DataReaderFromStdio::read(void* buf, size_t size) const
 }
 #endif // NCNN_STDIO
 
+#if NCNN_STDIO
+class DataReaderFromMmapPrivate
+{
+public:
+    DataReaderFromMmapPrivate()
+        : data(0), size(0), offset(0)
+    {
+    }
+    const unsigned char* data;
+    size_t size;
+    size_t offset;
+};
+
+DataReaderFromMmap::DataReaderFromMmap(const char* path)
+    : DataReader(), d(new DataReaderFromMmapPrivate)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER file_size;
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        if (mapping)
+        {
+            void* ptr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+            if (ptr)
+            {
+                d->data = (const unsigned char*)ptr;
+                d->size = (size_t)file_size.QuadPart;
+            }
+
+            // the view keeps the mapping alive
+            CloseHandle(mapping);
+        }
+    }
+
+    CloseHandle(file);
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+        return;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        // copy-on-write, pages stay shared unless a layer modifies weights in place
+        void* ptr = mmap(0, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (ptr != MAP_FAILED)
+        {
+            d->data = (const unsigned char*)ptr;
+            d->size = (size_t)st.st_size;
+        }
+    }
+
+    // the mapping stays valid after closing the descriptor
+    close(fd);
+#endif
+}
+
+DataReaderFromMmap::~DataReaderFromMmap()
+{
+    if (d->data)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(d->data);
+#else
+        munmap((void*)d->data, d->size);
+#endif
+    }
+
+    delete d;
+}
+
+DataReaderFromMmap::DataReaderFromMmap(const DataReaderFromMmap&)
+    : d(0)
+{
+}
+
+DataReaderFromMmap& DataReaderFromMmap::operator=(const DataReaderFromMmap&)
+{
+    return *this;
+}
+
+bool DataReaderFromMmap::empty() const
+{
+    return d->data == 0;
+}
+
+size_t DataReaderFromMmap::read(void* buf, size_t size) const
+{
+    size_t nread = size < d->size - d->offset ? size : d->size - d->offset;
+    memcpy(buf, d->data + d->offset, nread);
+    d->offset += nread;
+    return nread;
+}
+
+size_t DataReaderFromMmap::reference(size_t size, const void** buf) const
+{
+    // unaligned data must be copied out
+    if (d->offset % 4 != 0 || size > d->size - d->offset)
+        return 0;
+
+    *buf = d->data + d->offset;
+    d->offset += size;
+    return size;
+}
+#endif // NCNN_STDIO
+
 class DataReaderFromMemoryPrivate
 {
 public:
@@ -61,6 +61,32 @@ private:
 };
 #endif // NCNN_STDIO
 
+#if NCNN_STDIO
+class DataReaderFromMmapPrivate;
+class NCNN_EXPORT DataReaderFromMmap : public DataReader
+{
+public:
+    // map the whole file into memory copy-on-write
+    // the mapping is page aligned, so model data at 32-bit aligned offset can be referenced
+    // the reader must be retained when referenced data is used
+    explicit DataReaderFromMmap(const char* path);
+    virtual ~DataReaderFromMmap();
+
+    // return true if the file could not be mapped
+    bool empty() const;
+
+    virtual size_t read(void* buf, size_t size) const;
+    virtual size_t reference(size_t size, const void** buf) const;
+
+private:
+    DataReaderFromMmap(const DataReaderFromMmap&);
+    DataReaderFromMmap& operator=(const DataReaderFromMmap&);
+
+private:
+    DataReaderFromMmapPrivate* const d;
+};
+#endif // NCNN_STDIO
+
 class DataReaderFromMemoryPrivate;
 class NCNN_EXPORT DataReaderFromMemory : public DataReader
 {
@@ -3,6 +3,8 @@
 
 #include "expression.h"
 
+#include "atomicops.h"
+
 namespace ncnn {
 
 int count_expression_blobs(const std::string& expr)
@@ -82,7 +84,16 @@ struct typed_value
     }
 };
 
-int eval_list_expression(const std::string& expr, const std::vector<Mat>& blobs, std::vector<int>& outlist)
+struct list_expression_token
+{
+    int type; // 0=blob shape 1=literal 2=operator
+    int blob_index;
+    char blob_axis; // w h d c
+    typed_value literal;
+    std::string op;
+};
+
+static int tokenize_list_expression(const std::string& expr, std::vector<list_expression_token>& tokens)
 {
     // /(0w,2),*(0h,2),0c
 
@@ -102,7 +113,7 @@ int eval_list_expression(const std::string& expr, const std::vector<Mat>& blobs,
     // split by , ( )
 
     // split into tokens
-    std::vector<std::string> tokens;
+    std::vector<std::string> strtokens;
     {
         std::string t;
         for (size_t i = 0; i < expr.size(); i++)
@@ -113,7 +124,7 @@ int eval_list_expression(const std::string& expr, const std::vector<Mat>& blobs,
             {
                 if (!t.empty())
                 {
-                    tokens.push_back(t);
+                    strtokens.push_back(t);
                     t.clear();
                 }
             }
@@ -130,25 +141,73 @@ int eval_list_expression(const std::string& expr, const std::vector<Mat>& blobs,
 
         if (!t.empty())
         {
-            tokens.push_back(t);
+            strtokens.push_back(t);
         }
     }
 
     //      / 0w 2 * 0h 2 0c
 
+    // resolve blob references and literals once
+    tokens.resize(strtokens.size());
+    for (size_t i = 0; i < strtokens.size(); i++)
+    {
+        const std::string& t = strtokens[i];
+        list_expression_token& tk = tokens[i];
+
+        tk.blob_index = 0;
+        tk.blob_axis = 0;
+
+        if (t.size() == 2 && (t[0] >= '0' && t[0] <= '9') && (t[1] == 'w' || t[1] == 'h' || t[1] == 'd' || t[1] == 'c'))
+        {
+            tk.type = 0;
+            tk.blob_index = t[0] - '0';
+            tk.blob_axis = t[1];
+            continue;
+        }
+
+        // + - * / and named operators never scan as numbers
+        int vi;
+        float vf;
+        int nscani = sscanf(t.c_str(), "%d", &vi);
+        int nscanf = sscanf(t.c_str(), "%f", &vf);
+        if (nscani == 1 && nscanf == 1 && vi == vf)
+        {
+            tk.type = 1;
+            tk.literal = typed_value(vi);
+        }
+        else if (nscanf == 1)
+        {
+            tk.type = 1;
+            tk.literal = typed_value(vf);
+        }
+        else
+        {
+            tk.type = 2;
+            tk.op = t;
+        }
+    }
+
+    return 0;
+}
+
+static int eval_list_expression_tokens(const std::vector<list_expression_token>& tokens, const std::vector<Mat>& blobs, std::vector<int>& outlist)
+{
+    // empty expression resolves to empty list
+    if (tokens.empty())
+        return 0;
+
     // scan and stack
     std::stack<typed_value> exprstack;
     for (int i = (int)tokens.size() - 1; i >= 0; i--)
     {
-        const std::string& t = tokens[i];
-
-        // NCNN_LOGE("t = %s", t.c_str());
+        const list_expression_token& tk = tokens[i];
+        const std::string& t = tk.op;
 
         // + - * / 0w 0h 0d 0c 12345
 
-        if (t.size() == 2 && (t[0] >= '0' && t[0] <= '9') && (t[1] == 'w' || t[1] == 'h' || t[1] == 'd' || t[1] == 'c'))
+        if (tk.type == 0)
         {
-            size_t blob_index = t[0] - '0';
+            size_t blob_index = tk.blob_index;
             if (blob_index >= blobs.size())
             {
                 NCNN_LOGE("shape expression blob index %d out of bound!", (int)blob_index);
@@ -157,19 +216,21 @@ int eval_list_expression(const std::string& expr, const std::vector<Mat>& blobs,
 
             const Mat& blob = blobs[blob_index].shape();
             int size;
-            if (t[1] == 'w')
+            if (tk.blob_axis == 'w')
                 size = blob.w;
-            else if (t[1] == 'h')
+            else if (tk.blob_axis == 'h')
                 size = blob.h;
-            else if (t[1] == 'd')
+            else if (tk.blob_axis == 'd')
                 size = blob.d;
-            else // if (t[1] == 'c')
+            else // if (tk.blob_axis == 'c')
                 size = blob.c;
 
-            // NCNN_LOGE("t = %s  =>  %d", t.c_str(), size);
-
             exprstack.push(size);
         }
+        else if (tk.type == 1)
+        {
+            exprstack.push(tk.literal);
+        }
         else if (t == "+" || t == "-" || t == "*" || t == "//" || t == "max" || t == "min")
         {
             typed_value ta = exprstack.top();
@@ -521,24 +582,8 @@ int eval_list_expression(const std::string& expr, const std::vector<Mat>& blobs,
         }
         else
         {
-            // literal
-            int vi;
-            float vf;
-            int nscani = sscanf(t.c_str(), "%d", &vi);
-            int nscanf = sscanf(t.c_str(), "%f", &vf);
-            if (nscani == 1 && nscanf == 1 && vi == vf)
-            {
-                exprstack.push(vi);
-            }
-            else if (nscanf == 1)
-            {
-                exprstack.push(vf);
-            }
-            else
-            {
-                NCNN_LOGE("malformed literal token %s", t.c_str());
-                return -1;
-            }
+            NCNN_LOGE("malformed literal token %s", t.c_str());
+            return -1;
         }
     }
 
@@ -552,7 +597,165 @@ int eval_list_expression(const std::string& expr, const std::vector<Mat>& blobs,
         outlist.push_back(size);
     }
 
-    // NCNN_LOGE("shape %s = %d %d", expr.c_str(), list[0], list[1]);
+    return 0;
+}
+
+int eval_list_expression(const std::string& expr, const std::vector<Mat>& blobs, std::vector<int>& outlist)
+{
+    std::vector<list_expression_token> tokens;
+    int ret = tokenize_list_expression(expr, tokens);
+    if (ret != 0)
+        return ret;
+
+    return eval_list_expression_tokens(tokens, blobs, outlist);
+}
+
+// resolved list for one shape of the referenced blobs, immutable once published
+struct ListExpressionCacheEntry
+{
+    std::vector<int> shapes;
+    std::vector<int> outlist;
+};
+
+class ListExpressionPrivate
+{
+public:
+    void clear_cache();
+
+public:
+    std::vector<list_expression_token> tokens;
+    int blob_count;
+
+    // the last 4 entries published, read lock-free by concurrent extractors
+    void* cache_slots[4];
+    int cache_next;
+
+    // every entry created, freed on parse and destruction only since readers may still hold replaced ones
+    // at most 64 entries are created so that endless distinct shapes do not grow memory
+    Mutex cache_lock;
+    std::vector<ListExpressionCacheEntry*> cache_entries;
+};
+
+void ListExpressionPrivate::clear_cache()
+{
+    for (int i = 0; i < 4; i++)
+    {
+        cache_slots[i] = 0;
+    }
+    cache_next = 0;
+
+    for (size_t i = 0; i < cache_entries.size(); i++)
+    {
+        delete cache_entries[i];
+    }
+    cache_entries.clear();
+}
+
+ListExpression::ListExpression()
+    : d(new ListExpressionPrivate)
+{
+    d->blob_count = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        d->cache_slots[i] = 0;
+    }
+    d->cache_next = 0;
+}
+
+ListExpression::~ListExpression()
+{
+    d->clear_cache();
+    delete d;
+}
+
+ListExpression::ListExpression(const ListExpression&)
+    : d(0)
+{
+}
+
+ListExpression& ListExpression::operator=(const ListExpression&)
+{
+    return *this;
+}
+
+int ListExpression::parse(const std::string& expr)
+{
+    d->tokens.clear();
+    d->blob_count = 0;
+    d->clear_cache();
+
+    int ret = tokenize_list_expression(expr, d->tokens);
+    if (ret != 0)
+        return ret;
+
+    for (size_t i = 0; i < d->tokens.size(); i++)
+    {
+        if (d->tokens[i].type == 0)
+            d->blob_count = std::max(d->blob_count, d->tokens[i].blob_index + 1);
+    }
+
+    return 0;
+}
+
+int ListExpression::eval(const std::vector<Mat>& blobs, std::vector<int>& outlist) const
+{
+    if (d->blob_count == 0 || (int)blobs.size() < d->blob_count)
+    {
+        // constant list or bad reference, nothing worth caching
+        return eval_list_expression_tokens(d->tokens, blobs, outlist);
+    }
+
+    std::vector<int> shapes(d->blob_count * 5);
+    for (int i = 0; i < d->blob_count; i++)
+    {
+        const Mat& blob = blobs[i].shape();
+        shapes[i * 5] = blob.dims;
+        shapes[i * 5 + 1] = blob.w;
+        shapes[i * 5 + 2] = blob.h;
+        shapes[i * 5 + 3] = blob.d;
+        shapes[i * 5 + 4] = blob.c;
+    }
+
+    // lock-free lookup
+    for (int i = 0; i < 4; i++)
+    {
+        const ListExpressionCacheEntry* entry = (const ListExpressionCacheEntry*)atomic_load_ptr(&d->cache_slots[i]);
+        if (!entry || entry->shapes != shapes)
+            continue;
+
+        const std::vector<int>& cached_outlist = entry->outlist;
+        for (size_t j = 0; j < cached_outlist.size(); j++)
+        {
+            outlist.push_back(cached_outlist[j]);
+        }
+        return 0;
+    }
+
+    std::vector<int> list;
+    int ret = eval_list_expression_tokens(d->tokens, blobs, list);
+    if (ret != 0)
+        return ret;
+
+    {
+        MutexLockGuard guard(d->cache_lock);
+
+        if (d->cache_entries.size() < 64)
+        {
+            ListExpressionCacheEntry* entry = new ListExpressionCacheEntry;
+            entry->shapes = shapes;
+            entry->outlist = list;
+            d->cache_entries.push_back(entry);
+
+            // the replaced entry stays alive in cache_entries for readers still comparing it
+            atomic_exchange_ptr(&d->cache_slots[d->cache_next], entry);
+            d->cache_next = (d->cache_next + 1) % 4;
+        }
+    }
+
+    for (size_t j = 0; j < list.size(); j++)
+    {
+        outlist.push_back(list[j]);
+    }
 
     return 0;
 }
@@ -1,7 +1,11 @@
 // Copyright 2025 Tencent
 // SPDX-License-Identifier: BSD-3-Clause
 
+#ifndef NCNN_EXPRESSION_H
+#define NCNN_EXPRESSION_H
+
 #include "mat.h"
+#include "platform.h"
 
 namespace ncnn {
 
@@ -14,4 +18,32 @@ NCNN_EXPORT int count_expression_blobs(const std::string& expr);
 // return 0 if success
 NCNN_EXPORT int eval_list_expression(const std::string& expr, const std::vector<Mat>& blobs, std::vector<int>& outlist);
 
+class ListExpressionPrivate;
+// list expression tokenized once, for layers evaluating the same expression every forward
+// the resolved list is cached per shape of the referenced blobs, lookup is lock-free
+// so that inference alternating between a few input shapes skips the evaluation
+class NCNN_EXPORT ListExpression
+{
+public:
+    ListExpression();
+    ~ListExpression();
+
+    // tokenize expression, empty expression is allowed
+    // return 0 if success
+    int parse(const std::string& expr);
+
+    // same as eval_list_expression
+    // return 0 if success
+    int eval(const std::vector<Mat>& blobs, std::vector<int>& outlist) const;
+
+private:
+    ListExpression(const ListExpression&);
+    ListExpression& operator=(const ListExpression&);
+
+private:
+    ListExpressionPrivate* const d;
+};
+
 } // namespace ncnn
+
+#endif // NCNN_EXPRESSION_H
@@ -0,0 +1,508 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "inferencepool.h"
+
+#include "allocator.h"
+#include "atomicops.h"
+#include "cpu.h"
+
+namespace ncnn {
+
+// positions are unsigned and wrap around, compare them by signed distance
+static NCNN_FORCEINLINE int sequence_diff(unsigned int a, unsigned int b)
+{
+    return (int)(a - b);
+}
+
+// bounded multi-producer multi-consumer ring
+// every cell carries a sequence number telling whether it is ready for the producer at position or the consumer at position
+class RequestQueue
+{
+public:
+    RequestQueue(int size)
+    {
+        unsigned int capacity = 1;
+        while (capacity < (unsigned int)size)
+            capacity *= 2;
+
+        mask = capacity - 1;
+        cells.resize(capacity);
+        for (unsigned int i = 0; i < capacity; i++)
+        {
+            cells[i].sequence = i;
+            cells[i].request = 0;
+        }
+
+        enqueue_pos = 0;
+        dequeue_pos = 0;
+    }
+
+    bool enqueue(InferenceRequest* request)
+    {
+        unsigned int pos = atomic_load_uint(&enqueue_pos);
+        for (;;)
+        {
+            Cell& cell = cells[pos & mask];
+            const int diff = sequence_diff(atomic_load_uint(&cell.sequence), pos);
+            if (diff == 0)
+            {
+                if (atomic_compare_exchange_uint(&enqueue_pos, pos, pos + 1))
+                {
+                    cell.request = request;
+                    atomic_store_uint(&cell.sequence, pos + 1);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // full
+                return false;
+            }
+
+            pos = atomic_load_uint(&enqueue_pos);
+        }
+    }
+
+    InferenceRequest* dequeue()
+    {
+        unsigned int pos = atomic_load_uint(&dequeue_pos);
+        for (;;)
+        {
+            Cell& cell = cells[pos & mask];
+            const int diff = sequence_diff(atomic_load_uint(&cell.sequence), pos + 1);
+            if (diff == 0)
+            {
+                if (atomic_compare_exchange_uint(&dequeue_pos, pos, pos + 1))
+                {
+                    InferenceRequest* request = cell.request;
+                    atomic_store_uint(&cell.sequence, pos + mask + 1);
+                    return request;
+                }
+            }
+            else if (diff < 0)
+            {
+                // empty
+                return 0;
+            }
+
+            pos = atomic_load_uint(&dequeue_pos);
+        }
+    }
+
+private:
+    struct Cell
+    {
+        unsigned int sequence;
+        InferenceRequest* request;
+    };
+
+    unsigned int mask;
+    std::vector<Cell> cells;
+
+    // keep the producer and consumer positions on separate cache lines
+    char pad0[64];
+    unsigned int enqueue_pos;
+    char pad1[64];
+    unsigned int dequeue_pos;
+    char pad2[64];
+};
+
+class InferenceRequestPrivate
+{
+public:
+    Mutex lock;
+    ConditionVariable condition;
+    int done;
+};
+
+InferenceRequest::InferenceRequest()
+    : d(new InferenceRequestPrivate)
+{
+    ret = 0;
+    d->done = 0;
+}
+
+InferenceRequest::~InferenceRequest()
+{
+    delete d;
+}
+
+InferenceRequest::InferenceRequest(const InferenceRequest&)
+    : d(0)
+{
+}
+
+InferenceRequest& InferenceRequest::operator=(const InferenceRequest&)
+{
+    return *this;
+}
+
+#if NCNN_STRING
+static int find_blob_index(const Net& net, const char* blob_name)
+{
+    const std::vector<Blob>& blobs = net.blobs();
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        if (blobs[i].name == blob_name)
+            return (int)i;
+    }
+
+    NCNN_LOGE("find_blob_index %s failed", blob_name);
+    return -1;
+}
+
+int InferenceRequest::input(const Net& net, const char* blob_name, const Mat& in)
+{
+    int blob_index = find_blob_index(net, blob_name);
+    if (blob_index == -1)
+        return -1;
+
+    input_indexes.push_back(blob_index);
+    inputs.push_back(in);
+
+    return 0;
+}
+
+int InferenceRequest::output(const Net& net, const char* blob_name)
+{
+    int blob_index = find_blob_index(net, blob_name);
+    if (blob_index == -1)
+        return -1;
+
+    output_indexes.push_back(blob_index);
+
+    return 0;
+}
+#endif // NCNN_STRING
+
+int InferenceRequest::wait()
+{
+    d->lock.lock();
+    while (!d->done)
+    {
+        d->condition.wait(d->lock);
+    }
+    d->lock.unlock();
+
+    return ret;
+}
+
+bool InferenceRequest::finished() const
+{
+    MutexLockGuard g(d->lock);
+
+    return d->done != 0;
+}
+
+struct InferenceWorker
+{
+    InferencePoolPrivate* pool;
+    Thread* thread;
+
+    CpuSet affinity_mask;
+
+    // arenas touched by this worker only
+    UnlockedPoolAllocator blob_allocator;
+    UnlockedPoolAllocator workspace_allocator;
+};
+
+class InferencePoolPrivate
+{
+public:
+    InferencePoolPrivate();
+
+    void run_request(InferenceWorker* worker, InferenceRequest* request) const;
+
+    // wait for a request, return null when stopped and drained
+    InferenceRequest* take_request();
+
+    Net net;
+
+    std::vector<InferenceWorker*> workers;
+    RequestQueue* queue;
+    int started;
+
+    // idle workers sleep here, producers only take the lock when someone sleeps
+    Mutex idle_lock;
+    ConditionVariable idle_condition;
+    int sleeper_count;
+    int stopping;
+};
+
+InferencePoolPrivate::InferencePoolPrivate()
+{
+    queue = 0;
+    started = 0;
+    sleeper_count = 0;
+    stopping = 0;
+}
+
+void InferencePoolPrivate::run_request(InferenceWorker* worker, InferenceRequest* request) const
+{
+    int ret = 0;
+    {
+        Extractor ex = net.create_extractor();
+        ex.set_blob_allocator(&worker->blob_allocator);
+        ex.set_workspace_allocator(&worker->workspace_allocator);
+
+        for (size_t i = 0; i < request->input_indexes.size() && i < request->inputs.size(); i++)
+        {
+            ret = ex.input(request->input_indexes[i], request->inputs[i]);
+            if (ret != 0)
+                break;
+        }
+
+        request->outputs.resize(request->output_indexes.size());
+        for (size_t i = 0; ret == 0 && i < request->output_indexes.size(); i++)
+        {
+            Mat out;
+            ret = ex.extract(request->output_indexes[i], out);
+            if (ret != 0)
+                break;
+
+            // move out of the worker arena before the caller sees it
+            request->outputs[i] = out.clone();
+        }
+    }
+
+    request->ret = ret;
+
+    InferenceRequestPrivate* rd = request->d;
+    rd->lock.lock();
+    rd->done = 1;
+    rd->condition.broadcast();
+    rd->lock.unlock();
+}
+
+InferenceRequest* InferencePoolPrivate::take_request()
+{
+    for (;;)
+    {
+        InferenceRequest* request = queue->dequeue();
+        if (request)
+            return request;
+
+        idle_lock.lock();
+
+        atomic_fetch_add_int(&sleeper_count, 1);
+        atomic_fence();
+
+        // recheck after announcing the sleep, pairs with the fence in submit
+        request = queue->dequeue();
+        if (!request && !stopping)
+        {
+            idle_condition.wait(idle_lock);
+            request = queue->dequeue();
+        }
+
+        atomic_fetch_add_int(&sleeper_count, -1);
+
+        const int stop = stopping;
+
+        idle_lock.unlock();
+
+        if (request)
+            return request;
+
+        if (stop)
+            return 0;
+    }
+}
+
+static void* inference_worker(void* args)
+{
+    InferenceWorker* worker = (InferenceWorker*)args;
+    InferencePoolPrivate* pool = worker->pool;
+
+    set_cpu_thread_affinity(worker->affinity_mask);
+
+    for (;;)
+    {
+        InferenceRequest* request = pool->take_request();
+        if (!request)
+            break;
+
+        pool->run_request(worker, request);
+    }
+
+    return 0;
+}
+
+InferencePool::InferencePool()
+    : d(new InferencePoolPrivate)
+{
+}
+
+InferencePool::~InferencePool()
+{
+    stop();
+
+    delete d;
+}
+
+InferencePool::InferencePool(const InferencePool&)
+    : d(0)
+{
+}
+
+InferencePool& InferencePool::operator=(const InferencePool&)
+{
+    return *this;
+}
+
+Net& InferencePool::net()
+{
+    return d->net;
+}
+
+const Net& InferencePool::net() const
+{
+    return d->net;
+}
+
+int InferencePool::start(int thread_count, int mode, int queue_size)
+{
+    if (d->started)
+    {
+        NCNN_LOGE("inference pool already started");
+        return -1;
+    }
+
+    if (mode != 0 && mode != 1)
+    {
+        NCNN_LOGE("inference pool mode %d not supported", mode);
+        return -1;
+    }
+
+    if (thread_count <= 0)
+        thread_count = mode == 0 ? get_big_cpu_count() : d->net.opt.num_threads;
+
+    // layers pick their forward thread count from the net option
+    const int num_threads = mode == 0 ? 1 : thread_count;
+    if (d->net.opt.num_threads != num_threads)
+    {
+        NCNN_LOGE("inference pool mode %d needs net.opt.num_threads=%d before net.load_param()", mode, num_threads);
+        return -1;
+    }
+
+    if (queue_size <= 0)
+        queue_size = 1;
+
+    // prefer the big cores when they are enough
+    const CpuSet& mask = get_cpu_thread_affinity_mask(thread_count <= get_big_cpu_count() ? 2 : 0);
+
+    std::vector<int> cpus;
+    for (int i = 0; i < get_cpu_count(); i++)
+    {
+        if (mask.is_enabled(i))
+            cpus.push_back(i);
+    }
+
+    const int worker_count = mode == 0 ? thread_count : 1;
+
+    d->workers.resize(worker_count);
+    for (int i = 0; i < worker_count; i++)
+    {
+        InferenceWorker* worker = new InferenceWorker;
+        worker->pool = d;
+        worker->thread = 0;
+
+        // throughput workers take one cpu each, the latency worker spreads over all
+        worker->affinity_mask.disable_all();
+        for (int j = 0; j < num_threads; j++)
+        {
+            if (!cpus.empty())
+                worker->affinity_mask.enable(cpus[(i + j) % cpus.size()]);
+        }
+
+        d->workers[i] = worker;
+    }
+
+    d->queue = new RequestQueue(queue_size);
+    d->stopping = 0;
+    d->sleeper_count = 0;
+    d->started = 1;
+
+#if NCNN_THREADS
+    for (int i = 0; i < worker_count; i++)
+    {
+        d->workers[i]->thread = new Thread(inference_worker, (void*)d->workers[i]);
+    }
+#endif // NCNN_THREADS
+
+    return 0;
+}
+
+void InferencePool::stop()
+{
+    if (!d->started)
+        return;
+
+    d->idle_lock.lock();
+    d->stopping = 1;
+    d->idle_condition.broadcast();
+    d->idle_lock.unlock();
+
+    for (size_t i = 0; i < d->workers.size(); i++)
+    {
+        InferenceWorker* worker = d->workers[i];
+        if (worker->thread)
+        {
+            worker->thread->join();
+            delete worker->thread;
+        }
+
+        delete worker;
+    }
+    d->workers.clear();
+
+    delete d->queue;
+    d->queue = 0;
+
+    d->started = 0;
+}
+
+int InferencePool::submit(InferenceRequest* request)
+{
+    if (!d->started || d->stopping)
+    {
+        NCNN_LOGE("inference pool not started");
+        return -1;
+    }
+
+    request->ret = 0;
+    request->outputs.clear();
+    request->d->done = 0;
+
+#if NCNN_THREADS
+    if (!d->queue->enqueue(request))
+        return -1;
+
+    // publish the request before looking for sleepers, pairs with the recheck in take_request
+    atomic_fence();
+
+    if (atomic_load_int(&d->sleeper_count) > 0)
+    {
+        d->idle_lock.lock();
+        d->idle_condition.signal();
+        d->idle_lock.unlock();
+    }
+#else
+    // no threads, run on the caller
+    d->run_request(d->workers[0], request);
+#endif // NCNN_THREADS
+
+    return 0;
+}
+
+int InferencePool::run(InferenceRequest& request)
+{
+    int ret = submit(&request);
+    if (ret != 0)
+        return ret;
+
+    return request.wait();
+}
+
+} // namespace ncnn
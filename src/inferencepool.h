@@ -0,0 +1,104 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_INFERENCEPOOL_H
+#define NCNN_INFERENCEPOOL_H
+
+#include "mat.h"
+#include "net.h"
+#include "platform.h"
+
+namespace ncnn {
+
+class InferenceRequestPrivate;
+class NCNN_EXPORT InferenceRequest
+{
+public:
+    // empty request
+    InferenceRequest();
+    // clear
+    ~InferenceRequest();
+
+    // blobs to feed, paired with inputs
+    std::vector<int> input_indexes;
+    std::vector<Mat> inputs;
+
+    // blobs to extract
+    std::vector<int> output_indexes;
+
+#if NCNN_STRING
+    // convenient setter by blob name
+    // return 0 if success
+    int input(const Net& net, const char* blob_name, const Mat& in);
+    int output(const Net& net, const char* blob_name);
+#endif // NCNN_STRING
+
+    // filled once the request finished, paired with output_indexes
+    // output mats own their memory
+    std::vector<Mat> outputs;
+
+    // 0 if success
+    int ret;
+
+    // block until the pool finished the request
+    // return ret
+    int wait();
+
+    // return true if the pool finished the request
+    bool finished() const;
+
+private:
+    InferenceRequest(const InferenceRequest&);
+    InferenceRequest& operator=(const InferenceRequest&);
+
+private:
+    friend class InferencePool;
+    friend class InferencePoolPrivate;
+    InferenceRequestPrivate* const d;
+};
+
+class InferencePoolPrivate;
+class NCNN_EXPORT InferencePool
+{
+public:
+    // empty pool
+    InferencePool();
+    // stop
+    ~InferencePool();
+
+    // the net shared by all workers
+    // load it before start and leave it untouched until stop
+    Net& net();
+    const Net& net() const;
+
+    // 0 = throughput, thread_count workers running one request each with one thread
+    // 1 = latency, one worker running one request at a time with thread_count threads
+    // the net must be loaded with opt.num_threads 1 for throughput and thread_count for latency
+    // worker threads are pinned to the chosen cpus and every worker owns unlocked pool allocators
+    // thread_count 0 means the big cpu count for throughput and net opt.num_threads for latency
+    // queue_size is rounded up to power of two
+    // return 0 if success
+    int start(int thread_count = 0, int mode = 0, int queue_size = 256);
+
+    // finish the queued requests and join the workers
+    void stop();
+
+    // queue a request without locking, the request must outlive its completion
+    // return 0 if success, -1 if the queue is full or the pool is not started
+    int submit(InferenceRequest* request);
+
+    // submit and wait
+    // return the request ret
+    int run(InferenceRequest& request);
+
+private:
+    InferencePool(const InferencePool&);
+    InferencePool& operator=(const InferencePool&);
+
+private:
+    InferencePoolPrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_INFERENCEPOOL_H
@@ -116,6 +116,14 @@ public:
     const VulkanDevice* vkdev;
 #endif // NCNN_VULKAN
 
+public:
+    // weights transformed by create_pipeline, listed in a fixed order
+    // the weight cache of net saves them after create_pipeline and restores them before,
+    // create_pipeline then skips the transform of restored weights
+    // appended last to keep the vtable layout of layers built against older headers
+    // return 0 if success
+    virtual int get_pipeline_weights(std::vector<Mat*>& weights);
+
 public:
     // custom user data
     void* userdata;
@@ -0,0 +1,63 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "celu_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#include "neon_mathfun.h"
+#endif // __ARM_NEON
+
+namespace ncnn {
+
+CELU_arm::CELU_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int CELU_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int d = bottom_top_blob.d;
+    int channels = bottom_top_blob.c;
+    int elempack = bottom_top_blob.elempack;
+    int size = w * h * d * elempack;
+
+    const float alpha_inv = 1.f / alpha;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __ARM_NEON
+        float32x4_t _zero = vdupq_n_f32(0.f);
+        float32x4_t _one = vdupq_n_f32(1.f);
+        float32x4_t _alpha = vdupq_n_f32(alpha);
+        float32x4_t _alpha_inv = vdupq_n_f32(alpha_inv);
+        for (; i + 3 < size; i += 4)
+        {
+            float32x4_t _p = vld1q_f32(ptr);
+            float32x4_t _n = vmulq_f32(vsubq_f32(exp_ps(vmulq_f32(_p, _alpha_inv)), _one), _alpha);
+            _p = vbslq_f32(vcltq_f32(_p, _zero), _n, _p);
+            vst1q_f32(ptr, _p);
+
+            ptr += 4;
+        }
+#endif // __ARM_NEON
+        for (; i < size; i++)
+        {
+            if (*ptr < 0.f)
+                *ptr = (expf(*ptr * alpha_inv) - 1.f) * alpha;
+            ptr++;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
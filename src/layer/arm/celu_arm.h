@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_CELU_ARM_H
+#define LAYER_CELU_ARM_H
+
+#include "celu.h"
+
+namespace ncnn {
+
+class CELU_arm : public CELU
+{
+public:
+    CELU_arm();
+
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_CELU_ARM_H
@@ -2925,6 +2925,9 @@ static int conv3x3s1_winograd23_fp16sa(const Mat& bottom_blob, Mat& top_blob, co
     int TILE_M, TILE_N, TILE_K;
     conv3x3s1_winograd_get_optimal_tile_mnk_fp16(M, N, K, B, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -4281,6 +4284,9 @@ static int conv3x3s1_winograd43_fp16sa(const Mat& bottom_blob, Mat& top_blob, co
     int TILE_M, TILE_N, TILE_K;
     conv3x3s1_winograd_get_optimal_tile_mnk_fp16(M, N, K, B, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -5902,6 +5908,9 @@ static int conv3x3s1_winograd63_fp16sa(const Mat& bottom_blob, Mat& top_blob, co
     int TILE_M, TILE_N, TILE_K;
     conv3x3s1_winograd_get_optimal_tile_mnk_fp16(M, N, K, B, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -4266,6 +4266,9 @@ static int conv3x3s1_winograd23_int8(Mat& bottom_blob, Mat& top_blob, const Mat&
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -5623,6 +5626,9 @@ static int conv3x3s1_winograd43_int8(Mat& bottom_blob, Mat& top_blob, const Mat&
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
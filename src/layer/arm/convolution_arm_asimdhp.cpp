@@ -354,11 +354,11 @@ int Convolution_arm::forward_fp16sa(const Mat& bottom_blob, Mat& top_blob, const
         // NCNN_LOGE("prefer_winograd %d %d %d", prefer_winograd23, prefer_winograd43, prefer_winograd63);
 
         int _nT = nT ? nT : opt.num_threads;
-        if (nT != 0 && opt.num_threads != nT)
+        if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
         {
-            // force num_threads the same as in create_pipeline
-            // so we could use pre-packed A/B from the same tile config
-            NCNN_LOGE("opt.num_threads %d changed, convolution winograd will use load-time value %d", opt.num_threads, nT);
+            // pre-packed A/B follow the tile config of the load-time num_threads
+            // fewer threads are fine, branch parallel runs pass their thread share here
+            NCNN_LOGE("opt.num_threads %d changed, convolution winograd will use at most load-time value %d", opt.num_threads, nT);
         }
 
         int ret = 0;
@@ -456,11 +456,11 @@ int Convolution_arm::forward_fp16sa(const Mat& bottom_blob, Mat& top_blob, const
     if ((opt.use_sgemm_convolution && prefer_sgemm) || (kernel_w == 1 && kernel_h == 1))
     {
         int _nT = nT ? nT : opt.num_threads;
-        if (nT != 0 && opt.num_threads != nT)
+        if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
         {
-            // force num_threads the same as in create_pipeline
-            // so we could use pre-packed A/B from the same tile config
-            NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use load-time value %d", opt.num_threads, nT);
+            // pre-packed A/B follow the tile config of the load-time num_threads
+            // fewer threads are fine, branch parallel runs pass their thread share here
+            NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use at most load-time value %d", opt.num_threads, nT);
         }
 
         int ret = convolution_im2col_gemm_fp16sa(bottom_blob_bordered, top_blob, weight_sgemm_data, bias_data_fp16, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, _nT, opt);
@@ -0,0 +1,152 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "convolutiondepthwise1d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+#include "arm_usability.h"
+
+namespace ncnn {
+
+ConvolutionDepthWise1D_arm::ConvolutionDepthWise1D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+
+    activation = 0;
+}
+
+int ConvolutionDepthWise1D_arm::create_pipeline(const Option& opt)
+{
+    if (dynamic_weight)
+    {
+        support_packing = false;
+        return 0;
+    }
+
+    const int maxk = kernel_w;
+    const int channels = (weight_data_size / group) / maxk / (num_output / group) * group;
+
+    // group convolution
+    if (!(channels == group && group == num_output))
+    {
+        support_packing = false;
+        return 0;
+    }
+
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    int elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        elempack = channels % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    Mat weight_data_r2 = weight_data.reshape(maxk, group);
+    convert_packing(weight_data_r2, weight_data_tm, elempack, opt);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int ConvolutionDepthWise1D_arm::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    return 0;
+}
+
+int ConvolutionDepthWise1D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    if (weight_data_tm.empty())
+    {
+        return ConvolutionDepthWise1D::forward(bottom_blob, top_blob, opt);
+    }
+
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+
+    const int maxk = kernel_w;
+
+    top_blob.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int g = 0; g < h; g++)
+    {
+        float* outptr = top_blob.row(g);
+        const float* kptr = (const float*)weight_data_tm + maxk * g * elempack;
+        const float* bptr = bias_term ? (const float*)bias_data + g * elempack : 0;
+        const float* ptr = bottom_blob_bordered.row(g);
+
+        for (int j = 0; j < outw; j++)
+        {
+            const float* sptr = ptr + j * stride_w * elempack;
+
+#if __ARM_NEON
+            if (elempack == 4)
+            {
+                float32x4_t _sum = bptr ? vld1q_f32(bptr) : vdupq_n_f32(0.f);
+
+                for (int k = 0; k < maxk; k++)
+                {
+                    float32x4_t _val = vld1q_f32(sptr + k * dilation_w * elempack);
+                    float32x4_t _w = vld1q_f32(kptr + k * 4);
+                    _sum = vmlaq_f32(_sum, _val, _w);
+                }
+
+                vst1q_f32(outptr, _sum);
+            }
+#endif // __ARM_NEON
+            if (elempack == 1)
+            {
+                float sum = bptr ? bptr[0] : 0.f;
+
+                for (int k = 0; k < maxk; k++)
+                {
+                    sum += sptr[k * dilation_w * elempack] * kptr[k];
+                }
+
+                outptr[0] = sum;
+            }
+
+            outptr += elempack;
+        }
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob, opt);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,29 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_CONVOLUTIONDEPTHWISE1D_ARM_H
+#define LAYER_CONVOLUTIONDEPTHWISE1D_ARM_H
+
+#include "convolutiondepthwise1d.h"
+
+namespace ncnn {
+
+class ConvolutionDepthWise1D_arm : public ConvolutionDepthWise1D
+{
+public:
+    ConvolutionDepthWise1D_arm();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    Layer* activation;
+
+    Mat weight_data_tm;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_CONVOLUTIONDEPTHWISE1D_ARM_H
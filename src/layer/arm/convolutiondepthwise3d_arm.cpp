@@ -0,0 +1,182 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "convolutiondepthwise3d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+#include "arm_usability.h"
+
+namespace ncnn {
+
+ConvolutionDepthWise3D_arm::ConvolutionDepthWise3D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+
+    activation = 0;
+}
+
+int ConvolutionDepthWise3D_arm::create_pipeline(const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h * kernel_d;
+    const int channels = (weight_data_size / group) / maxk / (num_output / group) * group;
+
+    // group convolution
+    if (!(channels == group && group == num_output))
+    {
+        support_packing = false;
+        return 0;
+    }
+
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    int elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        elempack = channels % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    Mat weight_data_r2 = weight_data.reshape(maxk, group);
+    convert_packing(weight_data_r2, weight_data_tm, elempack, opt);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int ConvolutionDepthWise3D_arm::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    return 0;
+}
+
+int ConvolutionDepthWise3D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    if (weight_data_tm.empty())
+    {
+        return ConvolutionDepthWise3D::forward(bottom_blob, top_blob, opt);
+    }
+
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+    const int d = bottom_blob_bordered.d;
+    const int channels = bottom_blob_bordered.c;
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+    const int outh = (h - kernel_extent_h) / stride_h + 1;
+    const int outd = (d - kernel_extent_d) / stride_d + 1;
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap0 = w * dilation_h - kernel_w * dilation_w;
+        int gap1 = h * w * dilation_d - w * kernel_h * dilation_h;
+        for (int z = 0; z < kernel_d; z++)
+        {
+            for (int i = 0; i < kernel_h; i++)
+            {
+                for (int j = 0; j < kernel_w; j++)
+                {
+                    space_ofs[p1] = p2 * elempack;
+                    p1++;
+                    p2 += dilation_w;
+                }
+                p2 += gap0;
+            }
+            p2 += gap1;
+        }
+    }
+
+    top_blob.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int g = 0; g < channels; g++)
+    {
+        float* outptr = top_blob.channel(g);
+        const float* kptr = (const float*)weight_data_tm + maxk * g * elempack;
+        const float* bptr = bias_term ? (const float*)bias_data + g * elempack : 0;
+        const Mat m = bottom_blob_bordered.channel(g);
+
+        for (int z = 0; z < outd; z++)
+        {
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* sptr = (const float*)m.depth(z * stride_d).row(i * stride_h) + j * stride_w * elempack;
+
+#if __ARM_NEON
+                    if (elempack == 4)
+                    {
+                        float32x4_t _sum = bptr ? vld1q_f32(bptr) : vdupq_n_f32(0.f);
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            float32x4_t _val = vld1q_f32(sptr + space_ofs[k]);
+                            float32x4_t _w = vld1q_f32(kptr + k * 4);
+                            _sum = vmlaq_f32(_sum, _val, _w);
+                        }
+
+                        vst1q_f32(outptr, _sum);
+                    }
+#endif // __ARM_NEON
+                    if (elempack == 1)
+                    {
+                        float sum = bptr ? bptr[0] : 0.f;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            sum += sptr[space_ofs[k]] * kptr[k];
+                        }
+
+                        outptr[0] = sum;
+                    }
+
+                    outptr += elempack;
+                }
+            }
+        }
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob, opt);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,272 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deconvolution1d_arm.h"
+
+#include "layer_type.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+#include "arm_usability.h"
+
+namespace ncnn {
+
+Deconvolution1D_arm::Deconvolution1D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+
+    activation = 0;
+    gemm = 0;
+}
+
+int Deconvolution1D_arm::create_pipeline(const Option& opt)
+{
+    if (dynamic_weight)
+    {
+        support_packing = false;
+        return 0;
+    }
+
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    const int maxk = kernel_w;
+    const int num_input = weight_data_size / maxk / num_output;
+
+    int out_elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+    ncnn::ParamDict pd;
+    pd.set(2, 1);                 // transA
+    pd.set(3, 0);                 // transB
+    pd.set(4, 1);                 // constantA
+    pd.set(5, 0);                 // constantB
+    pd.set(6, 1);                 // constantC
+    pd.set(7, maxk * num_output); // M = maxk*num_output
+    pd.set(8, 0);                 // N = size
+    pd.set(9, num_input);         // K = inch
+    pd.set(10, -1);               // constant_broadcast_type_C = null
+    pd.set(11, 0);                // output_N1M
+    pd.set(12, out_elempack);
+
+    gemm->load_param(pd);
+
+    // maxk-inch-outch to pa-maxk-outch/pa-inch
+    Mat tmp;
+    {
+        Mat weight_data_r2 = weight_data.reshape(maxk, num_input, num_output);
+
+        tmp.create(maxk * num_output, num_input);
+
+        for (int p = 0; p < num_input; p += 1)
+        {
+            float* g00 = tmp.row(p);
+
+            for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
+            {
+                for (int k = 0; k < maxk; k++)
+                {
+                    for (int i = 0; i < out_elempack; i++)
+                    {
+                        const float* k00 = weight_data_r2.channel(q + i).row(p);
+                        g00[0] = k00[k];
+                        g00++;
+                    }
+                }
+            }
+        }
+    }
+
+    ncnn::Mat weights[1];
+    weights[0] = tmp;
+
+    gemm->load_model(ModelBinFromMatArray(weights));
+
+    Option opt1 = opt;
+    opt1.use_fp16_storage = false;
+    opt1.use_bf16_storage = false;
+    gemm->create_pipeline(opt1);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int Deconvolution1D_arm::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    if (gemm)
+    {
+        gemm->destroy_pipeline(opt);
+        delete gemm;
+        gemm = 0;
+    }
+
+    return 0;
+}
+
+static NCNN_FORCEINLINE void deconvolution1d_accumulate(float* ptr, const float* sptr, int elempack)
+{
+    int k = 0;
+#if __ARM_NEON
+    for (; k + 3 < elempack; k += 4)
+    {
+        vst1q_f32(ptr + k, vaddq_f32(vld1q_f32(ptr + k), vld1q_f32(sptr + k)));
+    }
+#endif // __ARM_NEON
+    for (; k < elempack; k++)
+    {
+        ptr[k] += sptr[k];
+    }
+}
+
+int Deconvolution1D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int w = bottom_blob.w;
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+
+    const int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+
+    int out_elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+    const size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    const int out_h = num_output / out_elempack;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || output_w > 0)
+    {
+        top_blob_bordered.create(outw, out_h, out_elemsize, out_elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, out_h, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+    const int maxk = kernel_w;
+
+    // sgemm
+    Mat top_col2im;
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+    int ret = gemm->forward(bottom_blob, top_col2im, opt_b);
+    if (ret != 0)
+        return ret;
+
+    // col2im
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < out_h; p++)
+    {
+        const float* sptr = top_col2im.row(p * maxk);
+        float* outptr = top_blob_bordered.row(p);
+
+        {
+            float* ptr = outptr;
+            for (int i = 0; i < outw; i++)
+            {
+                for (int k = 0; k < out_elempack; k++)
+                {
+                    ptr[k] = bias_data.empty() ? 0.f : bias_data[p * out_elempack + k];
+                }
+                ptr += out_elempack;
+            }
+        }
+
+        for (int v = 0; v < kernel_w; v++)
+        {
+            float* ptr = outptr + dilation_w * v * out_elempack;
+
+            for (int j = 0; j < w; j++)
+            {
+                deconvolution1d_accumulate(ptr, sptr, out_elempack);
+
+                ptr += stride_w * out_elempack;
+                sptr += out_elempack;
+            }
+        }
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob_bordered, opt);
+    }
+
+    // copy_cut_border would treat the packed h as rows, cut along w only
+    int wcut_left = 0;
+    int wcut_right = 0;
+    if (pad_left > 0 || pad_right > 0)
+    {
+        wcut_left = pad_left;
+        wcut_right = pad_right;
+    }
+    else if (output_w > 0)
+    {
+        int wcut = outw - output_w;
+
+        if (pad_left == -233 || pad_right == -233)
+        {
+            // onnx padding=SAME_UPPER
+            wcut_left = wcut / 2;
+            wcut_right = wcut - wcut / 2;
+        }
+        else if (pad_left == -234 || pad_right == -234)
+        {
+            // onnx padding=SAME_LOWER
+            wcut_left = wcut - wcut / 2;
+            wcut_right = wcut / 2;
+        }
+    }
+
+    if (wcut_left == 0 && wcut_right == 0)
+    {
+        top_blob = top_blob_bordered;
+        return 0;
+    }
+
+    const int cut_outw = outw - wcut_left - wcut_right;
+
+    top_blob.create(cut_outw, out_h, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    for (int p = 0; p < out_h; p++)
+    {
+        const float* ptr = top_blob_bordered.row(p) + wcut_left * out_elempack;
+        float* outptr = top_blob.row(p);
+
+        memcpy(outptr, ptr, cut_outw * out_elemsize);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,316 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deformableconv2d_arm.h"
+
+#include "layer_type.h"
+
+#include <math.h>
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+#include "arm_usability.h"
+
+namespace ncnn {
+
+DeformableConv2D_arm::DeformableConv2D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+
+    activation = 0;
+    gemm = 0;
+}
+
+int DeformableConv2D_arm::create_pipeline(const Option& opt)
+{
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    const int maxk = kernel_w * kernel_h;
+    const int num_input = weight_data_size / maxk / num_output;
+
+    int elempack = 1;
+    int out_elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        elempack = num_input % 4 == 0 ? 4 : 1;
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+    ncnn::ParamDict pd;
+    pd.set(2, 0);                   // transA
+    pd.set(3, 0);                   // transB
+    pd.set(4, 1);                   // constantA
+    pd.set(5, 0);                   // constantB
+    pd.set(6, 1);                   // constantC
+    pd.set(7, num_output);          // M = outch
+    pd.set(8, 0);                   // N = size
+    pd.set(9, maxk * num_input);    // K = maxk*inch
+    pd.set(10, bias_term ? 1 : -1); // constant_broadcast_type_C = M
+    pd.set(11, 1);                  // output_N1M
+    pd.set(12, out_elempack);
+
+    gemm->load_param(pd);
+
+    // maxk-inch-outch to pa-maxk-inch/pa-outch
+    Mat tmp;
+    {
+        Mat weight_data_r2 = weight_data.reshape(maxk, num_input, num_output);
+
+        tmp.create(maxk * num_input, num_output);
+
+        for (int q = 0; q < num_output; q++)
+        {
+            float* g00 = tmp.row(q);
+
+            for (int p = 0; p + (elempack - 1) < num_input; p += elempack)
+            {
+                for (int k = 0; k < maxk; k++)
+                {
+                    for (int i = 0; i < elempack; i++)
+                    {
+                        const float* k00 = weight_data_r2.channel(q).row(p + i);
+                        g00[0] = k00[k];
+                        g00++;
+                    }
+                }
+            }
+        }
+    }
+
+    ncnn::Mat weights[2];
+    weights[0] = tmp;
+    weights[1] = bias_data;
+
+    gemm->load_model(ModelBinFromMatArray(weights));
+
+    Option opt1 = opt;
+    opt1.use_fp16_storage = false;
+    opt1.use_bf16_storage = false;
+    gemm->create_pipeline(opt1);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int DeformableConv2D_arm::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    if (gemm)
+    {
+        gemm->destroy_pipeline(opt);
+        delete gemm;
+        gemm = 0;
+    }
+
+    return 0;
+}
+
+// bilinear sampling table shared by every input channel
+// each tap stores the four corner offsets scaled by elempack and the corner weights with mask folded in
+static void deformableconv2d_im2col_sampling(const Mat& offset, const Mat& mask, Mat& sampling_ofs, Mat& sampling_weights, int w, int h, int elempack, int outw, int outh, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int pad_left, int pad_top, const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h;
+    const bool has_mask = !mask.empty();
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int k = 0; k < maxk; k++)
+    {
+        const int u = k / kernel_w;
+        const int v = k % kernel_w;
+
+        const Mat offset_h_k = offset.channel(k * 2);
+        const Mat offset_w_k = offset.channel(k * 2 + 1);
+
+        int* ofs = sampling_ofs.row<int>(k);
+        float* ws = sampling_weights.row(k);
+
+        for (int i = 0; i < outh; i++)
+        {
+            for (int j = 0; j < outw; j++)
+            {
+                const float h_im = i * stride_h - pad_top + u * dilation_h + offset_h_k.row(i)[j];
+                const float w_im = j * stride_w - pad_left + v * dilation_w + offset_w_k.row(i)[j];
+
+                ofs[0] = 0;
+                ofs[1] = 0;
+                ofs[2] = 0;
+                ofs[3] = 0;
+                ws[0] = 0.f;
+                ws[1] = 0.f;
+                ws[2] = 0.f;
+                ws[3] = 0.f;
+
+                // Bilinear
+                bool cond = h_im > -1 && w_im > -1 && h_im < h && w_im < w;
+                if (cond)
+                {
+                    int h_low = (int)floorf(h_im);
+                    int w_low = (int)floorf(w_im);
+                    int h_high = h_low + 1;
+                    int w_high = w_low + 1;
+
+                    float lh = h_im - h_low;
+                    float lw = w_im - w_low;
+                    float hh = 1 - lh;
+                    float hw = 1 - lw;
+
+                    const float mask_ = has_mask ? mask.channel(k).row(i)[j] : 1.f;
+
+                    if (h_low >= 0 && w_low >= 0)
+                    {
+                        ofs[0] = (h_low * w + w_low) * elempack;
+                        ws[0] = hh * hw * mask_;
+                    }
+                    if (h_low >= 0 && w_high <= w - 1)
+                    {
+                        ofs[1] = (h_low * w + w_high) * elempack;
+                        ws[1] = hh * lw * mask_;
+                    }
+                    if (h_high <= h - 1 && w_low >= 0)
+                    {
+                        ofs[2] = (h_high * w + w_low) * elempack;
+                        ws[2] = lh * hw * mask_;
+                    }
+                    if (h_high <= h - 1 && w_high <= w - 1)
+                    {
+                        ofs[3] = (h_high * w + w_high) * elempack;
+                        ws[3] = lh * lw * mask_;
+                    }
+                }
+
+                ofs += 4;
+                ws += 4;
+            }
+        }
+    }
+}
+
+static void deformableconv2d_im2col(const Mat& bottom_blob, const Mat& sampling_ofs, const Mat& sampling_weights, Mat& bottom_im2col, int size, int maxk, const Option& opt)
+{
+    const int channels = bottom_blob.c;
+    const int elempack = bottom_blob.elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < channels; p++)
+    {
+        const float* img = bottom_blob.channel(p);
+        float* ptr = bottom_im2col.row(p * maxk);
+
+        for (int k = 0; k < maxk; k++)
+        {
+            const int* ofs = sampling_ofs.row<const int>(k);
+            const float* ws = sampling_weights.row(k);
+
+            int i = 0;
+#if __ARM_NEON
+            if (elempack == 4)
+            {
+                for (; i < size; i++)
+                {
+                    float32x4_t _val = vmulq_n_f32(vld1q_f32(img + ofs[0]), ws[0]);
+                    _val = vmlaq_n_f32(_val, vld1q_f32(img + ofs[1]), ws[1]);
+                    _val = vmlaq_n_f32(_val, vld1q_f32(img + ofs[2]), ws[2]);
+                    _val = vmlaq_n_f32(_val, vld1q_f32(img + ofs[3]), ws[3]);
+                    vst1q_f32(ptr, _val);
+
+                    ofs += 4;
+                    ws += 4;
+                    ptr += 4;
+                }
+            }
+#endif // __ARM_NEON
+            if (elempack == 1)
+            {
+                for (; i < size; i++)
+                {
+                    ptr[0] = img[ofs[0]] * ws[0] + img[ofs[1]] * ws[1] + img[ofs[2]] * ws[2] + img[ofs[3]] * ws[3];
+
+                    ofs += 4;
+                    ws += 4;
+                    ptr += 1;
+                }
+            }
+        }
+    }
+}
+
+int DeformableConv2D_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& offset = bottom_blobs[1];
+    const bool has_mask = (bottom_blobs.size() == 3);
+    Mat& top_blob = top_blobs[0];
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int outw = (w + pad_left + pad_right - kernel_extent_w) / stride_w + 1;
+    const int outh = (h + pad_top + pad_bottom - kernel_extent_h) / stride_h + 1;
+    const int size = outw * outh;
+    const int maxk = kernel_w * kernel_h;
+
+    Mat offset_unpacked;
+    convert_packing(offset, offset_unpacked, 1, opt);
+
+    Mat mask_unpacked;
+    if (has_mask)
+    {
+        const Mat& mask = bottom_blobs[2];
+        convert_packing(mask, mask_unpacked, 1, opt);
+    }
+
+    // resolve the bilinear taps once, then gather every channel with them
+    Mat sampling_ofs(size * 4, maxk, 4u, 1, opt.workspace_allocator);
+    Mat sampling_weights(size * 4, maxk, 4u, 1, opt.workspace_allocator);
+    if (sampling_ofs.empty() || sampling_weights.empty())
+        return -100;
+
+    deformableconv2d_im2col_sampling(offset_unpacked, mask_unpacked, sampling_ofs, sampling_weights, w, h, elempack, outw, outh, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, pad_left, pad_top, opt);
+
+    // im2col
+    Mat bottom_im2col(size, maxk * channels, elemsize, elempack, opt.workspace_allocator);
+    if (bottom_im2col.empty())
+        return -100;
+
+    deformableconv2d_im2col(bottom_blob, sampling_ofs, sampling_weights, bottom_im2col, size, maxk, opt);
+
+    Mat top_blob_gemm;
+    int ret = gemm->forward(bottom_im2col, top_blob_gemm, opt);
+    if (ret != 0)
+        return ret;
+
+    top_blob = top_blob_gemm.reshape(outw, outh, top_blob_gemm.c, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob, opt);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_ERF_ARM_H
+#define LAYER_ERF_ARM_H
+
+#include "erf.h"
+
+namespace ncnn {
+
+class Erf_arm : public Erf
+{
+public:
+    Erf_arm();
+
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_ERF_ARM_H
@@ -0,0 +1,79 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "exp_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#include "neon_mathfun.h"
+#endif // __ARM_NEON
+
+namespace ncnn {
+
+Exp_arm::Exp_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int Exp_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int d = bottom_top_blob.d;
+    int channels = bottom_top_blob.c;
+    int elempack = bottom_top_blob.elempack;
+    int size = w * h * d * elempack;
+
+    if (base != -1.f && base <= 0.f)
+    {
+        // non-positive base has no exp(x * log(base)) form
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            float* ptr = bottom_top_blob.channel(q);
+
+            for (int i = 0; i < size; i++)
+            {
+                ptr[i] = powf(base, (shift + ptr[i] * scale));
+            }
+        }
+
+        return 0;
+    }
+
+    // base^x = exp(x * log(base))
+    const float log_base = base == -1.f ? 1.f : logf(base);
+    const float scale_log_base = scale * log_base;
+    const float shift_log_base = shift * log_base;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __ARM_NEON
+        float32x4_t _scale = vdupq_n_f32(scale_log_base);
+        float32x4_t _shift = vdupq_n_f32(shift_log_base);
+        for (; i + 3 < size; i += 4)
+        {
+            float32x4_t _p = vld1q_f32(ptr);
+            _p = exp_ps(vmlaq_f32(_shift, _p, _scale));
+            vst1q_f32(ptr, _p);
+
+            ptr += 4;
+        }
+#endif // __ARM_NEON
+        for (; i < size; i++)
+        {
+            *ptr = expf(shift_log_base + *ptr * scale_log_base);
+            ptr++;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
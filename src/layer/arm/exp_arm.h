@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_EXP_ARM_H
+#define LAYER_EXP_ARM_H
+
+#include "exp.h"
+
+namespace ncnn {
+
+class Exp_arm : public Exp
+{
+public:
+    Exp_arm();
+
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_EXP_ARM_H
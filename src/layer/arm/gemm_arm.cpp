@@ -11,6 +11,7 @@
 #include "arm_usability.h"
 
 #include "cpu.h"
+#include "layer_type.h"
 
 namespace ncnn {
 
@@ -40,6 +41,8 @@ Gemm_arm::Gemm_arm()
 #endif
 
     nT = 0;
+
+    weight_quant_innerproduct = 0;
 }
 
 void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max_kk)
@@ -3865,6 +3868,9 @@ static int gemm_arm(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob, int
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -3985,6 +3991,9 @@ static int gemm_AT_arm(const Mat& AT, const Mat& B, const Mat& C, Mat& top_blob,
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -4086,6 +4095,9 @@ static int gemm_BT_arm(const Mat& A, const Mat& BT, const Mat& C, Mat& top_blob,
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -4173,6 +4185,9 @@ static int gemm_AT_BT_arm(const Mat& AT, const Mat& BT, const Mat& C, Mat& top_b
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -4235,6 +4250,11 @@ static int gemm_AT_BT_arm(const Mat& AT, const Mat& BT, const Mat& C, Mat& top_b
 
 int Gemm_arm::create_pipeline(const Option& opt)
 {
+    if (weight_quant_bits)
+    {
+        return create_pipeline_weight_quant(opt);
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -4387,8 +4407,25 @@ int Gemm_arm::create_pipeline(const Option& opt)
     return 0;
 }
 
+int Gemm_arm::destroy_pipeline(const Option& opt)
+{
+    if (weight_quant_innerproduct)
+    {
+        weight_quant_innerproduct->destroy_pipeline(opt);
+        delete weight_quant_innerproduct;
+        weight_quant_innerproduct = 0;
+    }
+
+    return 0;
+}
+
 int Gemm_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+    if (weight_quant_bits)
+    {
+        return forward_weight_quant(bottom_blobs, top_blobs, opt);
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -4556,11 +4593,11 @@ int Gemm_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
         return -100;
 
     int _nT = nT ? nT : opt.num_threads;
-    if (nT != 0 && opt.num_threads != nT)
+    if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
     {
-        // force num_threads the same as in create_pipeline
-        // so we could use pre-packed A/B from the same tile config
-        NCNN_LOGE("opt.num_threads %d changed, gemm will use load-time value %d", opt.num_threads, nT);
+        // pre-packed A/B follow the tile config of the load-time num_threads
+        // fewer threads are fine, branch parallel runs pass their thread share here
+        NCNN_LOGE("opt.num_threads %d changed, gemm will use at most load-time value %d", opt.num_threads, nT);
     }
 
     int ret = 0;
@@ -4602,6 +4639,153 @@ int Gemm_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     return 0;
 }
 
+int Gemm_arm::create_pipeline_weight_quant(const Option& opt)
+{
+    // A x transposed constant B plus a constant per-column C is exactly an innerproduct
+    const bool linear = constantA == 0 && transA == 0 && constantC == 1
+                        && (constant_broadcast_type_C == -1 || constant_broadcast_type_C == 0 || constant_broadcast_type_C == 4)
+                        && output_N1M == 0 && output_elempack == 0 && output_elemtype == 0 && output_transpose == 0;
+
+    if (!linear)
+    {
+        // reference path dequantizes B at runtime
+        support_packing = false;
+        support_fp16_storage = false;
+#if NCNN_BF16
+        support_bf16_storage = false;
+#endif
+        return 0;
+    }
+
+    const int N = constantN;
+    const int K = constantK;
+    const int num_group = K / weight_quant_group_size;
+
+    // fold alpha into the group scales and alpha * beta into the bias
+    Mat scales = B_data_quant_scales;
+    if (alpha != 1.f)
+    {
+        scales = B_data_quant_scales.clone();
+        if (scales.empty())
+            return -100;
+
+        for (int i = 0; i < num_group * N; i++)
+        {
+            scales[i] *= alpha;
+        }
+    }
+
+    Mat bias;
+    if (constant_broadcast_type_C != -1)
+    {
+        bias.create(N);
+        if (bias.empty())
+            return -100;
+
+        for (int i = 0; i < N; i++)
+        {
+            const float c = constant_broadcast_type_C == 0 ? C_data[0] : C_data[i];
+            bias[i] = c * beta * alpha;
+        }
+    }
+
+    {
+        weight_quant_innerproduct = ncnn::create_layer_cpu(ncnn::LayerType::InnerProduct);
+        ncnn::ParamDict pd;
+        pd.set(0, N);                    // num_output
+        pd.set(1, bias.empty() ? 0 : 1); // bias_term
+        pd.set(2, N * K);                // weight_data_size
+        pd.set(11, weight_quant_bits);
+        pd.set(12, weight_quant_group_size);
+        weight_quant_innerproduct->load_param(pd);
+
+        Mat weights[4];
+        int wi = 0;
+        weights[wi++] = B_data.reshape(N * K);
+        if (!bias.empty())
+            weights[wi++] = bias;
+        weights[wi++] = scales;
+        weights[wi++] = B_data_quant_zeros;
+
+        weight_quant_innerproduct->load_model(ModelBinFromMatArray(weights));
+        weight_quant_innerproduct->create_pipeline(opt);
+    }
+
+    if (opt.lightmode)
+    {
+        B_data.release();
+        B_data_quant_scales.release();
+        B_data_quant_zeros.release();
+        C_data.release();
+    }
+
+    return 0;
+}
+
+int Gemm_arm::forward_weight_quant(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (!weight_quant_innerproduct)
+    {
+        return Gemm::forward(bottom_blobs, top_blobs, opt);
+    }
+
+    const Mat& A0 = bottom_blobs[0];
+
+    Option opt_unpack = opt;
+    opt_unpack.blob_allocator = opt.workspace_allocator;
+
+    // same storage dispatch as forward, the innerproduct runs in fp32
+    const int elembits = A0.elembits();
+    const bool use_bf16 = elembits == 16 && opt.use_bf16_storage && !(cpu_support_arm_asimdhp() && opt.use_fp16_storage);
+
+    Mat A = A0;
+    if (elembits == 16)
+    {
+#if NCNN_BF16
+        if (use_bf16)
+            cast_bfloat16_to_float32(A0, A, opt_unpack);
+        else
+#endif
+            cast_float16_to_float32(A0, A, opt_unpack);
+        if (A.empty())
+            return -100;
+    }
+
+    // innerproduct takes the M rows as a 2d blob
+    if (A.dims != 2)
+    {
+        Mat A_unpacked;
+        convert_packing(A, A_unpacked, 1, opt_unpack);
+        if (A_unpacked.empty())
+            return -100;
+
+        A = A_unpacked.reshape(A_unpacked.w, A_unpacked.dims == 3 ? A_unpacked.c : 1, opt.workspace_allocator);
+        if (A.empty())
+            return -100;
+    }
+
+    if (elembits != 16)
+    {
+        return weight_quant_innerproduct->forward(A, top_blobs[0], opt);
+    }
+
+    Mat top_blob_fp32;
+    int ret = weight_quant_innerproduct->forward(A, top_blob_fp32, opt_unpack);
+    if (ret != 0)
+        return ret;
+
+#if NCNN_BF16
+    if (use_bf16)
+        cast_float32_to_bfloat16(top_blob_fp32, top_blobs[0], opt);
+    else
+#endif
+        cast_float32_to_float16(top_blob_fp32, top_blobs[0], opt);
+    if (top_blobs[0].empty())
+        return -100;
+
+    return 0;
+}
+
 #if NCNN_BF16
 static int gemm_arm_bf16s(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob, int broadcast_type_C, int transA, int transB, int output_transpose, float alpha, int constant_TILE_M, int constant_TILE_N, int constant_TILE_K, int nT, const Option& opt)
 {
@@ -4614,6 +4798,9 @@ static int gemm_arm_bf16s(const Mat& A, const Mat& B, const Mat& C, Mat& top_blo
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_bf16s_fp16s(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -4735,6 +4922,9 @@ static int gemm_AT_arm_bf16s(const Mat& AT, const Mat& B, const Mat& C, Mat& top
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_bf16s_fp16s(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -4837,6 +5027,9 @@ static int gemm_BT_arm_bf16s(const Mat& A, const Mat& BT, const Mat& C, Mat& top
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_bf16s_fp16s(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -4925,6 +5118,9 @@ static int gemm_AT_BT_arm_bf16s(const Mat& AT, const Mat& BT, const Mat& C, Mat&
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_bf16s_fp16s(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -5251,11 +5447,11 @@ int Gemm_arm::forward_bf16s(const std::vector<Mat>& bottom_blobs, std::vector<Ma
         return -100;
 
     int _nT = nT ? nT : opt.num_threads;
-    if (nT != 0 && opt.num_threads != nT)
+    if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
     {
-        // force num_threads the same as in create_pipeline
-        // so we could use pre-packed A/B from the same tile config
-        NCNN_LOGE("opt.num_threads %d changed, gemm will use load-time value %d", opt.num_threads, nT);
+        // pre-packed A/B follow the tile config of the load-time num_threads
+        // fewer threads are fine, branch parallel runs pass their thread share here
+        NCNN_LOGE("opt.num_threads %d changed, gemm will use at most load-time value %d", opt.num_threads, nT);
     }
 
     int ret = 0;
@@ -5514,6 +5710,9 @@ static int gemm_arm_int8(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -5651,6 +5850,9 @@ static int gemm_AT_arm_int8(const Mat& AT, const Mat& A_int8_scales, const Mat&
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -5763,6 +5965,9 @@ static int gemm_BT_arm_int8(const Mat& A, const Mat& BT, float B_int8_scale, con
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -5868,6 +6073,9 @@ static int gemm_AT_BT_arm_int8(const Mat& AT, const Mat& A_int8_scales, const Ma
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -6241,11 +6449,11 @@ int Gemm_arm::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat
         return -100;
 
     int _nT = nT ? nT : opt.num_threads;
-    if (nT != 0 && opt.num_threads != nT)
+    if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
     {
-        // force num_threads the same as in create_pipeline
-        // so we could use pre-packed A/B from the same tile config
-        NCNN_LOGE("opt.num_threads %d changed, gemm will use load-time value %d", opt.num_threads, nT);
+        // pre-packed A/B follow the tile config of the load-time num_threads
+        // fewer threads are fine, branch parallel runs pass their thread share here
+        NCNN_LOGE("opt.num_threads %d changed, gemm will use at most load-time value %d", opt.num_threads, nT);
     }
 
     int ret = 0;
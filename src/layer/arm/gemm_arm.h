@@ -14,10 +14,13 @@ public:
     Gemm_arm();
 
     virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
 
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
 protected:
+    int create_pipeline_weight_quant(const Option& opt);
+    int forward_weight_quant(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 #if NCNN_VFPV4
     int create_pipeline_fp16s(const Option& opt);
     int forward_fp16s(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
@@ -42,6 +45,9 @@ public:
     Mat CT_data;
 
     int input_elemtype; // 0=auto 1=fp32 2=fp16 3=bf16
+
+    // linear-like weight quantized gemm runs as innerproduct
+    Layer* weight_quant_innerproduct;
 };
 
 } // namespace ncnn
@@ -16,6 +16,220 @@
 
 namespace ncnn {
 
+#if __ARM_NEON
+static inline void innerproduct_weight_quant_load16(const unsigned char* kptr, int bits, int16x8_t& _w0, int16x8_t& _w1)
+{
+    if (bits == 4)
+    {
+        // 8 bytes hold 16 weights, low nibbles first
+        uint8x8_t _w = vld1_u8(kptr);
+        _w0 = vreinterpretq_s16_u16(vmovl_u8(vand_u8(_w, vdup_n_u8(0x0f))));
+        _w1 = vreinterpretq_s16_u16(vmovl_u8(vshr_n_u8(_w, 4)));
+        return;
+    }
+
+    int8x16_t _w = vld1q_s8((const signed char*)kptr);
+    _w0 = vmovl_s8(vget_low_s8(_w));
+    _w1 = vmovl_s8(vget_high_s8(_w));
+}
+
+static inline float32x4_t innerproduct_weight_quant_cvt_low(int16x8_t _w)
+{
+    return vcvtq_f32_s32(vmovl_s16(vget_low_s16(_w)));
+}
+
+static inline float32x4_t innerproduct_weight_quant_cvt_high(int16x8_t _w)
+{
+    return vcvtq_f32_s32(vmovl_s16(vget_high_s16(_w)));
+}
+
+static inline float innerproduct_weight_quant_reduce(float32x4_t _v)
+{
+#if __aarch64__
+    return vaddvq_f32(_v);
+#else
+    float32x2_t _s = vadd_f32(vget_low_f32(_v), vget_high_f32(_v));
+    _s = vpadd_f32(_s, _s);
+    return vget_lane_f32(_s, 0);
+#endif
+}
+#endif // __ARM_NEON
+
+static void innerproduct_weight_quant_neon(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_tm, const Mat& weight_quant_scales, const Mat& weight_quant_offsets, const Mat& bias_data, int bits, int group_size, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    // bottom_blob and top_blob are rows of fp32 without packing
+    const int num_input = bottom_blob.w;
+    const int rows = bottom_blob.h;
+    const int num_output = top_blob.w;
+    const int num_group = num_input / group_size;
+    const int kstep = bits == 4 ? 8 : 16;
+
+    // the zero point term needs the sum of inputs per group
+    Mat xsum(num_group, rows, (size_t)4u, opt.workspace_allocator);
+
+    for (int j = 0; j < rows; j++)
+    {
+        const float* ptr = bottom_blob.row(j);
+        float* xsptr = xsum.row(j);
+
+        for (int g = 0; g < num_group; g++)
+        {
+            float sum = 0.f;
+            for (int k = 0; k < group_size; k++)
+            {
+                sum += ptr[k];
+            }
+            xsptr[g] = sum;
+            ptr += group_size;
+        }
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < num_output; p++)
+    {
+        const float* sptr = weight_quant_scales.row(p);
+        const float* optr = weight_quant_offsets.row(p);
+        const float bias = bias_data.empty() ? 0.f : bias_data[p];
+
+        int j = 0;
+#if __ARM_NEON
+        for (; j + 3 < rows; j += 4)
+        {
+            const unsigned char* kptr = weight_data_tm.row<const unsigned char>(p);
+            const float* x0 = bottom_blob.row(j);
+            const float* x1 = bottom_blob.row(j + 1);
+            const float* x2 = bottom_blob.row(j + 2);
+            const float* x3 = bottom_blob.row(j + 3);
+
+            float32x4_t _sum0 = vdupq_n_f32(0.f);
+            float32x4_t _sum1 = vdupq_n_f32(0.f);
+            float32x4_t _sum2 = vdupq_n_f32(0.f);
+            float32x4_t _sum3 = vdupq_n_f32(0.f);
+
+            for (int g = 0; g < num_group; g++)
+            {
+                float32x4_t _acc0 = vdupq_n_f32(0.f);
+                float32x4_t _acc1 = vdupq_n_f32(0.f);
+                float32x4_t _acc2 = vdupq_n_f32(0.f);
+                float32x4_t _acc3 = vdupq_n_f32(0.f);
+                for (int k = 0; k < group_size; k += 16)
+                {
+                    int16x8_t _w01;
+                    int16x8_t _w23;
+                    innerproduct_weight_quant_load16(kptr, bits, _w01, _w23);
+                    float32x4_t _w0 = innerproduct_weight_quant_cvt_low(_w01);
+                    float32x4_t _w1 = innerproduct_weight_quant_cvt_high(_w01);
+                    float32x4_t _w2 = innerproduct_weight_quant_cvt_low(_w23);
+                    float32x4_t _w3 = innerproduct_weight_quant_cvt_high(_w23);
+                    _acc0 = vmlaq_f32(_acc0, vld1q_f32(x0), _w0);
+                    _acc1 = vmlaq_f32(_acc1, vld1q_f32(x1), _w0);
+                    _acc2 = vmlaq_f32(_acc2, vld1q_f32(x2), _w0);
+                    _acc3 = vmlaq_f32(_acc3, vld1q_f32(x3), _w0);
+                    _acc0 = vmlaq_f32(_acc0, vld1q_f32(x0 + 4), _w1);
+                    _acc1 = vmlaq_f32(_acc1, vld1q_f32(x1 + 4), _w1);
+                    _acc2 = vmlaq_f32(_acc2, vld1q_f32(x2 + 4), _w1);
+                    _acc3 = vmlaq_f32(_acc3, vld1q_f32(x3 + 4), _w1);
+                    _acc0 = vmlaq_f32(_acc0, vld1q_f32(x0 + 8), _w2);
+                    _acc1 = vmlaq_f32(_acc1, vld1q_f32(x1 + 8), _w2);
+                    _acc2 = vmlaq_f32(_acc2, vld1q_f32(x2 + 8), _w2);
+                    _acc3 = vmlaq_f32(_acc3, vld1q_f32(x3 + 8), _w2);
+                    _acc0 = vmlaq_f32(_acc0, vld1q_f32(x0 + 12), _w3);
+                    _acc1 = vmlaq_f32(_acc1, vld1q_f32(x1 + 12), _w3);
+                    _acc2 = vmlaq_f32(_acc2, vld1q_f32(x2 + 12), _w3);
+                    _acc3 = vmlaq_f32(_acc3, vld1q_f32(x3 + 12), _w3);
+                    x0 += 16;
+                    x1 += 16;
+                    x2 += 16;
+                    x3 += 16;
+                    kptr += kstep;
+                }
+                _sum0 = vmlaq_n_f32(_sum0, _acc0, sptr[g]);
+                _sum1 = vmlaq_n_f32(_sum1, _acc1, sptr[g]);
+                _sum2 = vmlaq_n_f32(_sum2, _acc2, sptr[g]);
+                _sum3 = vmlaq_n_f32(_sum3, _acc3, sptr[g]);
+            }
+
+            float sum0 = innerproduct_weight_quant_reduce(_sum0);
+            float sum1 = innerproduct_weight_quant_reduce(_sum1);
+            float sum2 = innerproduct_weight_quant_reduce(_sum2);
+            float sum3 = innerproduct_weight_quant_reduce(_sum3);
+
+            const float* xs0 = xsum.row(j);
+            const float* xs1 = xsum.row(j + 1);
+            const float* xs2 = xsum.row(j + 2);
+            const float* xs3 = xsum.row(j + 3);
+            for (int g = 0; g < num_group; g++)
+            {
+                sum0 -= optr[g] * xs0[g];
+                sum1 -= optr[g] * xs1[g];
+                sum2 -= optr[g] * xs2[g];
+                sum3 -= optr[g] * xs3[g];
+            }
+
+            top_blob.row(j)[p] = activation_ss(sum0 + bias, activation_type, activation_params);
+            top_blob.row(j + 1)[p] = activation_ss(sum1 + bias, activation_type, activation_params);
+            top_blob.row(j + 2)[p] = activation_ss(sum2 + bias, activation_type, activation_params);
+            top_blob.row(j + 3)[p] = activation_ss(sum3 + bias, activation_type, activation_params);
+        }
+#endif // __ARM_NEON
+        for (; j < rows; j++)
+        {
+            const unsigned char* kptr = weight_data_tm.row<const unsigned char>(p);
+            const float* x0 = bottom_blob.row(j);
+
+#if __ARM_NEON
+            float32x4_t _sum0 = vdupq_n_f32(0.f);
+#else
+            float sum0 = 0.f;
+#endif
+
+            for (int g = 0; g < num_group; g++)
+            {
+#if __ARM_NEON
+                float32x4_t _acc0 = vdupq_n_f32(0.f);
+                float32x4_t _acc1 = vdupq_n_f32(0.f);
+                for (int k = 0; k < group_size; k += 16)
+                {
+                    int16x8_t _w01;
+                    int16x8_t _w23;
+                    innerproduct_weight_quant_load16(kptr, bits, _w01, _w23);
+                    _acc0 = vmlaq_f32(_acc0, vld1q_f32(x0), innerproduct_weight_quant_cvt_low(_w01));
+                    _acc1 = vmlaq_f32(_acc1, vld1q_f32(x0 + 4), innerproduct_weight_quant_cvt_high(_w01));
+                    _acc0 = vmlaq_f32(_acc0, vld1q_f32(x0 + 8), innerproduct_weight_quant_cvt_low(_w23));
+                    _acc1 = vmlaq_f32(_acc1, vld1q_f32(x0 + 12), innerproduct_weight_quant_cvt_high(_w23));
+                    x0 += 16;
+                    kptr += kstep;
+                }
+                _sum0 = vmlaq_n_f32(_sum0, vaddq_f32(_acc0, _acc1), sptr[g]);
+#else
+                float acc0 = 0.f;
+                for (int k = 0; k < group_size; k++)
+                {
+                    int w = bits == 4 ? (k % 16 < 8 ? kptr[k % 8] & 0x0f : kptr[k % 8] >> 4) : ((const signed char*)kptr)[k % 16];
+                    acc0 += x0[k] * w;
+                    if (k % 16 == 15)
+                        kptr += kstep;
+                }
+                x0 += group_size;
+                sum0 += acc0 * sptr[g];
+#endif
+            }
+
+#if __ARM_NEON
+            float sum0 = innerproduct_weight_quant_reduce(_sum0);
+#endif
+
+            const float* xs0 = xsum.row(j);
+            for (int g = 0; g < num_group; g++)
+            {
+                sum0 -= optr[g] * xs0[g];
+            }
+
+            top_blob.row(j)[p] = activation_ss(sum0 + bias, activation_type, activation_params);
+        }
+    }
+}
+
 InnerProduct_arm::InnerProduct_arm()
 {
 #if __ARM_NEON
@@ -44,6 +258,11 @@ int InnerProduct_arm::create_pipeline(const Option& opt)
         flatten->create_pipeline(opt);
     }
 
+    if (weight_quant_bits)
+    {
+        return create_pipeline_weight_quant(opt);
+    }
+
 #if NCNN_INT8
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
@@ -129,8 +348,154 @@ int InnerProduct_arm::destroy_pipeline(const Option& opt)
     return 0;
 }
 
+int InnerProduct_arm::create_pipeline_weight_quant(const Option& opt)
+{
+    const int num_input = weight_data_size / num_output;
+    const int num_group = num_input / weight_quant_group_size;
+
+    // src = inch-outch int8
+    // dst = inch-outch int8, or inch/2-outch int4 with 16 weights in 8 bytes, low nibbles first
+    if (weight_data_tm.empty())
+    {
+        Mat weight_data_r2 = weight_data.reshape(num_input, num_output);
+
+        if (weight_quant_bits == 4)
+        {
+            weight_data_tm.create(num_input / 2, num_output, (size_t)1u);
+            if (weight_data_tm.empty())
+                return -100;
+
+            for (int p = 0; p < num_output; p++)
+            {
+                const signed char* k0 = weight_data_r2.row<const signed char>(p);
+                unsigned char* g0 = weight_data_tm.row<unsigned char>(p);
+
+                for (int i = 0; i < num_input; i += 16)
+                {
+                    for (int j = 0; j < 8; j++)
+                    {
+                        // store as unsigned, the +8 goes into the zero point
+                        g0[j] = (unsigned char)((k0[j] + 8) | ((k0[j + 8] + 8) << 4));
+                    }
+
+                    k0 += 16;
+                    g0 += 8;
+                }
+            }
+        }
+        else
+        {
+            weight_data_tm = weight_data_r2.clone();
+            if (weight_data_tm.empty())
+                return -100;
+        }
+    }
+
+    // sum((q - zero) * scale * x) = scale * sum(q * x) - scale * zero * sum(x)
+    weight_quant_offsets_tm.create(num_group, num_output);
+    if (weight_quant_offsets_tm.empty())
+        return -100;
+
+    for (int p = 0; p < num_output; p++)
+    {
+        const float* sptr = weight_quant_scales.row(p);
+        const float* zptr = weight_quant_zeros.row(p);
+        float* optr = weight_quant_offsets_tm.row(p);
+
+        for (int g = 0; g < num_group; g++)
+        {
+            optr[g] = sptr[g] * (weight_quant_bits == 4 ? zptr[g] + 8 : zptr[g]);
+        }
+    }
+
+    if (opt.lightmode)
+    {
+        weight_data.release();
+        weight_quant_zeros.release();
+    }
+
+    return 0;
+}
+
+int InnerProduct_arm::forward_weight_quant_arm(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    Option opt_unpack = opt;
+    opt_unpack.blob_allocator = opt.workspace_allocator;
+    opt_unpack.use_packing_layout = false;
+
+    // weights are dequantized in fp32 registers, cast fp16 / bf16 blob at the boundary
+    const int elembits = bottom_blob.elembits();
+    const bool use_bf16 = elembits == 16 && opt.use_bf16_storage && !(support_fp16_storage && opt.use_fp16_storage);
+
+    Mat bottom_blob_fp32 = bottom_blob;
+    if (elembits == 16)
+    {
+#if NCNN_BF16
+        if (use_bf16)
+            cast_bfloat16_to_float32(bottom_blob, bottom_blob_fp32, opt_unpack);
+        else
+#endif
+            cast_float16_to_float32(bottom_blob, bottom_blob_fp32, opt_unpack);
+        if (bottom_blob_fp32.empty())
+            return -100;
+    }
+
+    Mat bottom_blob_unpacked;
+    convert_packing(bottom_blob_fp32, bottom_blob_unpacked, 1, opt_unpack);
+    if (bottom_blob_unpacked.empty())
+        return -100;
+
+    Mat bottom_blob_flattened = bottom_blob_unpacked;
+    if (bottom_blob_unpacked.dims != 1 && !(bottom_blob_unpacked.dims == 2 && bottom_blob_unpacked.w == num_input))
+    {
+        flatten->forward(bottom_blob_unpacked, bottom_blob_flattened, opt_unpack);
+        if (bottom_blob_flattened.empty())
+            return -100;
+    }
+
+    Mat top_blob_fp32;
+    if (bottom_blob_flattened.dims == 2)
+    {
+        // gemm
+        top_blob_fp32.create(num_output, bottom_blob_flattened.h, 4u, elembits == 16 ? opt.workspace_allocator : opt.blob_allocator);
+    }
+    else
+    {
+        top_blob_fp32.create(num_output, 4u, elembits == 16 ? opt.workspace_allocator : opt.blob_allocator);
+    }
+    if (top_blob_fp32.empty())
+        return -100;
+
+    innerproduct_weight_quant_neon(bottom_blob_flattened, top_blob_fp32, weight_data_tm, weight_quant_scales, weight_quant_offsets_tm, bias_data, weight_quant_bits, weight_quant_group_size, activation_type, activation_params, opt);
+
+    if (elembits == 16)
+    {
+#if NCNN_BF16
+        if (use_bf16)
+            cast_float32_to_bfloat16(top_blob_fp32, top_blob, opt);
+        else
+#endif
+            cast_float32_to_float16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+    }
+    else
+    {
+        top_blob = top_blob_fp32;
+    }
+
+    return 0;
+}
+
 int InnerProduct_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (weight_quant_bits)
+    {
+        return forward_weight_quant_arm(bottom_blob, top_blob, opt);
+    }
+
 #if NCNN_INT8
     if (opt.use_int8_inference && int8_scale_term)
     {
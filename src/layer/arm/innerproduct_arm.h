@@ -30,6 +30,8 @@ protected:
     int create_pipeline_bf16s(const Option& opt);
     int forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #endif
+    int create_pipeline_weight_quant(const Option& opt);
+    int forward_weight_quant_arm(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #if NCNN_INT8
     int create_pipeline_int8_arm(const Option& opt);
     int forward_int8_arm(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
@@ -43,6 +45,8 @@ public:
     // fp16
     Mat bias_data_fp16;
 
+    Mat weight_quant_offsets_tm;
+
 #if NCNN_INT8
     Mat scale_in_data;
 #endif
@@ -0,0 +1,486 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "inversespectrogram_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include <math.h>
+
+namespace ncnn {
+
+InverseSpectrogram_arm::InverseSpectrogram_arm()
+{
+}
+
+// factor n into stockham stages, radix 4 and 2 first, then odd factors
+// each stage stores m * r twiddles w^(p*k) of its length n followed by the r roots of unity of the radix
+static void inversespectrogram_fft_plan(int n, int inverse, std::vector<int>& radix, Mat& twiddles)
+{
+    radix.clear();
+
+    int t = n;
+    while (t % 4 == 0)
+    {
+        radix.push_back(4);
+        t /= 4;
+    }
+    while (t % 2 == 0)
+    {
+        radix.push_back(2);
+        t /= 2;
+    }
+    for (int f = 3; f <= t; f += 2)
+    {
+        while (t % f == 0)
+        {
+            radix.push_back(f);
+            t /= f;
+        }
+    }
+
+    const double sign = inverse ? 1.0 : -1.0;
+
+    int twiddles_size = 0;
+    {
+        int len = n;
+        for (size_t i = 0; i < radix.size(); i++)
+        {
+            twiddles_size += (len + radix[i]) * 2;
+            len /= radix[i];
+        }
+    }
+
+    twiddles.create(twiddles_size > 0 ? twiddles_size : 1);
+
+    float* ptr = twiddles;
+    int len = n;
+    for (size_t i = 0; i < radix.size(); i++)
+    {
+        const int r = radix[i];
+        const int m = len / r;
+
+        for (int p = 0; p < m; p++)
+        {
+            for (int k = 0; k < r; k++)
+            {
+                const double angle = sign * 2 * 3.14159265358979323846 * p * k / len;
+                ptr[0] = (float)cos(angle);
+                ptr[1] = (float)sin(angle);
+                ptr += 2;
+            }
+        }
+
+        for (int k = 0; k < r; k++)
+        {
+            const double angle = sign * 2 * 3.14159265358979323846 * k / r;
+            ptr[0] = (float)cos(angle);
+            ptr[1] = (float)sin(angle);
+            ptr += 2;
+        }
+
+        len = m;
+    }
+}
+
+#if __ARM_NEON
+// stockham autosort fft over 4 frames at once
+// x and y hold n complex values, each as 4 re lanes followed by 4 im lanes
+// returns the buffer holding the result in natural order
+static float* inversespectrogram_fft_pack4(float* x, float* y, int n, const std::vector<int>& radix, const Mat& twiddles, int inverse)
+{
+    const float* tw = twiddles;
+
+    int len = n;
+    int s = 1;
+    for (size_t st = 0; st < radix.size(); st++)
+    {
+        const int r = radix[st];
+        const int m = len / r;
+
+        const float* wp = tw;
+        const float* wr = tw + m * r * 2;
+        tw += (len + r) * 2;
+
+        for (int p = 0; p < m; p++)
+        {
+            for (int q = 0; q < s; q++)
+            {
+                const float* a = x + (q + s * p) * 8;
+                float* b = y + (q + s * r * p) * 8;
+
+                const int astep = s * m * 8;
+                const int bstep = s * 8;
+
+                if (r == 2)
+                {
+                    float32x4_t _a0r = vld1q_f32(a);
+                    float32x4_t _a0i = vld1q_f32(a + 4);
+                    float32x4_t _a1r = vld1q_f32(a + astep);
+                    float32x4_t _a1i = vld1q_f32(a + astep + 4);
+
+                    vst1q_f32(b, vaddq_f32(_a0r, _a1r));
+                    vst1q_f32(b + 4, vaddq_f32(_a0i, _a1i));
+                    vst1q_f32(b + bstep, vsubq_f32(_a0r, _a1r));
+                    vst1q_f32(b + bstep + 4, vsubq_f32(_a0i, _a1i));
+                }
+                else if (r == 4)
+                {
+                    float32x4_t _a0r = vld1q_f32(a);
+                    float32x4_t _a0i = vld1q_f32(a + 4);
+                    float32x4_t _a1r = vld1q_f32(a + astep);
+                    float32x4_t _a1i = vld1q_f32(a + astep + 4);
+                    float32x4_t _a2r = vld1q_f32(a + astep * 2);
+                    float32x4_t _a2i = vld1q_f32(a + astep * 2 + 4);
+                    float32x4_t _a3r = vld1q_f32(a + astep * 3);
+                    float32x4_t _a3i = vld1q_f32(a + astep * 3 + 4);
+
+                    float32x4_t _t0r = vaddq_f32(_a0r, _a2r);
+                    float32x4_t _t0i = vaddq_f32(_a0i, _a2i);
+                    float32x4_t _t1r = vsubq_f32(_a0r, _a2r);
+                    float32x4_t _t1i = vsubq_f32(_a0i, _a2i);
+                    float32x4_t _t2r = vaddq_f32(_a1r, _a3r);
+                    float32x4_t _t2i = vaddq_f32(_a1i, _a3i);
+                    float32x4_t _t3r = vsubq_f32(_a1r, _a3r);
+                    float32x4_t _t3i = vsubq_f32(_a1i, _a3i);
+
+                    vst1q_f32(b, vaddq_f32(_t0r, _t2r));
+                    vst1q_f32(b + 4, vaddq_f32(_t0i, _t2i));
+                    vst1q_f32(b + bstep * 2, vsubq_f32(_t0r, _t2r));
+                    vst1q_f32(b + bstep * 2 + 4, vsubq_f32(_t0i, _t2i));
+
+                    // forward multiplies t3 by -i, inverse by +i
+                    float32x4_t _b1r = inverse ? vsubq_f32(_t1r, _t3i) : vaddq_f32(_t1r, _t3i);
+                    float32x4_t _b1i = inverse ? vaddq_f32(_t1i, _t3r) : vsubq_f32(_t1i, _t3r);
+                    float32x4_t _b3r = inverse ? vaddq_f32(_t1r, _t3i) : vsubq_f32(_t1r, _t3i);
+                    float32x4_t _b3i = inverse ? vsubq_f32(_t1i, _t3r) : vaddq_f32(_t1i, _t3r);
+
+                    vst1q_f32(b + bstep, _b1r);
+                    vst1q_f32(b + bstep + 4, _b1i);
+                    vst1q_f32(b + bstep * 3, _b3r);
+                    vst1q_f32(b + bstep * 3 + 4, _b3i);
+                }
+                else
+                {
+                    // generic odd radix dft
+                    for (int k = 0; k < r; k++)
+                    {
+                        float32x4_t _sumr = vdupq_n_f32(0.f);
+                        float32x4_t _sumi = vdupq_n_f32(0.f);
+                        for (int j = 0; j < r; j++)
+                        {
+                            const float* w = wr + (j * k % r) * 2;
+                            float32x4_t _wr = vdupq_n_f32(w[0]);
+                            float32x4_t _wi = vdupq_n_f32(w[1]);
+                            float32x4_t _ar = vld1q_f32(a + astep * j);
+                            float32x4_t _ai = vld1q_f32(a + astep * j + 4);
+                            _sumr = vaddq_f32(_sumr, vsubq_f32(vmulq_f32(_ar, _wr), vmulq_f32(_ai, _wi)));
+                            _sumi = vaddq_f32(_sumi, vaddq_f32(vmulq_f32(_ar, _wi), vmulq_f32(_ai, _wr)));
+                        }
+                        vst1q_f32(b + bstep * k, _sumr);
+                        vst1q_f32(b + bstep * k + 4, _sumi);
+                    }
+                }
+
+                // twiddle
+                if (p > 0)
+                {
+                    for (int k = 1; k < r; k++)
+                    {
+                        const float* w = wp + (p * r + k) * 2;
+                        float32x4_t _wr = vdupq_n_f32(w[0]);
+                        float32x4_t _wi = vdupq_n_f32(w[1]);
+                        float32x4_t _br = vld1q_f32(b + bstep * k);
+                        float32x4_t _bi = vld1q_f32(b + bstep * k + 4);
+                        vst1q_f32(b + bstep * k, vsubq_f32(vmulq_f32(_br, _wr), vmulq_f32(_bi, _wi)));
+                        vst1q_f32(b + bstep * k + 4, vaddq_f32(vmulq_f32(_br, _wi), vmulq_f32(_bi, _wr)));
+                    }
+                }
+            }
+        }
+
+        std::swap(x, y);
+        len = m;
+        s *= r;
+    }
+
+    return x;
+}
+#endif // __ARM_NEON
+
+int InverseSpectrogram_arm::create_pipeline(const Option& /*opt*/)
+{
+    inversespectrogram_fft_plan(n_fft, 1, fft_radix, fft_twiddles);
+
+    return 0;
+}
+
+int InverseSpectrogram_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if __ARM_NEON
+    const int frames = bottom_blob.h;
+
+    const int outsize = center ? (frames - 1) * hoplen + (n_fft - n_fft / 2 * 2) : (frames - 1) * hoplen + n_fft;
+
+    const size_t elemsize = bottom_blob.elemsize;
+
+    Mat signal;
+    Mat window_sumsquare;
+    int ret = overlap_add_arm(bottom_blob, signal, window_sumsquare, opt);
+    if (ret != 0)
+        return ret;
+
+    if (returns == 0)
+    {
+        top_blob.create(2, outsize, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(outsize, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    const int offset = center == 1 ? n_fft / 2 : 0;
+
+    // square window norm
+    for (int i = 0; i < outsize; i++)
+    {
+        const float* ptr = signal.row(i + offset);
+        const float wss = window_sumsquare[i + offset];
+
+        float re = ptr[0];
+        float im = ptr[1];
+        if (wss != 0.f)
+        {
+            re /= wss;
+            im /= wss;
+        }
+
+        if (returns == 0)
+        {
+            top_blob.row(i)[0] = re;
+            top_blob.row(i)[1] = im;
+        }
+        if (returns == 1)
+        {
+            top_blob[i] = re;
+        }
+        if (returns == 2)
+        {
+            top_blob[i] = im;
+        }
+    }
+
+    return 0;
+#else
+    return InverseSpectrogram::forward(bottom_blob, top_blob, opt);
+#endif // __ARM_NEON
+}
+
+int InverseSpectrogram_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (bottom_blobs.size() == 1)
+    {
+        return forward(bottom_blobs[0], top_blobs[0], opt);
+    }
+
+#if __ARM_NEON
+    // streaming, bottom_blobs[1] holds the pending overlap as (re, im, window square) x (n_fft - hoplen)
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& cache = bottom_blobs[1];
+    const size_t elemsize = bottom_blob.elemsize;
+
+    const int frames = bottom_blob.h;
+    const int overlap = n_fft - hoplen;
+    if (overlap <= 0 || cache.w != 3 || cache.h != overlap)
+    {
+        NCNN_LOGE("InverseSpectrogram streaming needs hoplen < n_fft and a 3 x %d overlap cache", overlap);
+        return -1;
+    }
+
+    Mat signal;
+    Mat window_sumsquare;
+    int ret = overlap_add_arm(bottom_blob, signal, window_sumsquare, opt);
+    if (ret != 0)
+        return ret;
+
+    for (int i = 0; i < overlap; i++)
+    {
+        const float* ptr = cache.row(i);
+        signal.row(i)[0] += ptr[0];
+        signal.row(i)[1] += ptr[1];
+        window_sumsquare[i] += ptr[2];
+    }
+
+    // every frame that touches the first frames * hoplen samples has arrived
+    const int outsize = frames * hoplen;
+
+    Mat& top_blob = top_blobs[0];
+    if (returns == 0)
+    {
+        top_blob.create(2, outsize, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(outsize, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    for (int i = 0; i < outsize; i++)
+    {
+        const float* ptr = signal.row(i);
+        const float wss = window_sumsquare[i];
+
+        float re = ptr[0];
+        float im = ptr[1];
+        if (wss != 0.f)
+        {
+            re /= wss;
+            im /= wss;
+        }
+
+        if (returns == 0)
+        {
+            top_blob.row(i)[0] = re;
+            top_blob.row(i)[1] = im;
+        }
+        if (returns == 1)
+        {
+            top_blob[i] = re;
+        }
+        if (returns == 2)
+        {
+            top_blob[i] = im;
+        }
+    }
+
+    Mat& top_cache = top_blobs[1];
+    top_cache.create(3, overlap, elemsize, opt.blob_allocator);
+    if (top_cache.empty())
+        return -100;
+
+    for (int i = 0; i < overlap; i++)
+    {
+        float* outptr = top_cache.row(i);
+        outptr[0] = signal.row(outsize + i)[0];
+        outptr[1] = signal.row(outsize + i)[1];
+        outptr[2] = window_sumsquare[outsize + i];
+    }
+
+    return 0;
+#else
+    return InverseSpectrogram::forward(bottom_blobs, top_blobs, opt);
+#endif // __ARM_NEON
+}
+
+int InverseSpectrogram_arm::overlap_add_arm(const Mat& bottom_blob, Mat& signal, Mat& window_sumsquare, const Option& opt) const
+{
+#if __ARM_NEON
+    const int frames = bottom_blob.h;
+    const int freqs = bottom_blob.c;
+    // assert freqs == n_fft or freqs == n_fft / 2 + 1
+
+    const int onesided = freqs == n_fft / 2 + 1 ? 1 : 0;
+
+    const int size = (frames - 1) * hoplen + n_fft;
+
+    const size_t elemsize = bottom_blob.elemsize;
+
+    // inverse fft of every frame, re im interleaved
+    Mat frames_ifft(n_fft * 2, frames, elemsize, opt.workspace_allocator);
+    if (frames_ifft.empty())
+        return -100;
+
+    float norm = 1.f / n_fft;
+    if (normalized == 1)
+        norm = sqrt(n_fft) / n_fft;
+    if (normalized == 2)
+        norm = window_data[n_fft] / n_fft;
+
+    const int nn_frames = (frames + 3) / 4;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int jj = 0; jj < nn_frames; jj++)
+    {
+        const int j = jj * 4;
+        const int count = std::min(frames - j, 4);
+
+        Mat tmp(n_fft * 8, 2, 4u, opt.workspace_allocator);
+
+        // collect complex, one frame per lane
+        float* x = tmp.row(0);
+        for (int k = 0; k < n_fft; k++)
+        {
+            const int conj = onesided == 1 && k > n_fft / 2;
+            const float* ptr = bottom_blob.channel(conj ? n_fft - k : k).row(j);
+
+            for (int l = 0; l < 4; l++)
+            {
+                x[k * 8 + l] = l < count ? ptr[l * 2] : 0.f;
+                x[k * 8 + 4 + l] = l < count ? (conj ? -ptr[l * 2 + 1] : ptr[l * 2 + 1]) : 0.f;
+            }
+        }
+
+        const float* X = inversespectrogram_fft_pack4(tmp.row(0), tmp.row(1), n_fft, fft_radix, fft_twiddles, 1);
+
+        float32x4_t _norm = vdupq_n_f32(norm);
+
+        for (int i = 0; i < n_fft; i++)
+        {
+            float re[4];
+            float im[4];
+            vst1q_f32(re, vmulq_f32(vld1q_f32(X + i * 8), _norm));
+            vst1q_f32(im, vmulq_f32(vld1q_f32(X + i * 8 + 4), _norm));
+
+            for (int l = 0; l < count; l++)
+            {
+                float* outptr = frames_ifft.row(j + l);
+                outptr[i * 2] = re[l];
+                outptr[i * 2 + 1] = im[l];
+            }
+        }
+    }
+
+    signal.create(2, size, elemsize, opt.workspace_allocator);
+    if (signal.empty())
+        return -100;
+
+    window_sumsquare.create(size, elemsize, opt.workspace_allocator);
+    if (window_sumsquare.empty())
+        return -100;
+
+    signal.fill(0.f);
+    window_sumsquare.fill(0.f);
+
+    // overlap add, apply window
+    for (int j = 0; j < frames; j++)
+    {
+        const float* ptr = frames_ifft.row(j);
+        float* outptr = signal.row(j * hoplen);
+        float* wssptr = (float*)window_sumsquare + j * hoplen;
+
+        for (int i = 0; i < n_fft; i++)
+        {
+            const float wi = window_data[i];
+
+            outptr[0] += ptr[0] * wi;
+            outptr[1] += ptr[1] * wi;
+            wssptr[0] += wi * wi;
+
+            ptr += 2;
+            outptr += 2;
+            wssptr += 1;
+        }
+    }
+
+    return 0;
+#else
+    return InverseSpectrogram::overlap_add(bottom_blob, signal, window_sumsquare, opt);
+#endif // __ARM_NEON
+}
+
+} // namespace ncnn
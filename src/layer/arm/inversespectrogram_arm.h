@@ -0,0 +1,33 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_INVERSESPECTROGRAM_ARM_H
+#define LAYER_INVERSESPECTROGRAM_ARM_H
+
+#include "inversespectrogram.h"
+
+namespace ncnn {
+
+class InverseSpectrogram_arm : public InverseSpectrogram
+{
+public:
+    InverseSpectrogram_arm();
+
+    virtual int create_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+protected:
+    int overlap_add_arm(const Mat& bottom_blob, Mat& signal, Mat& window_sumsquare, const Option& opt) const;
+
+public:
+    // stockham stage radix and per stage twiddles
+    std::vector<int> fft_radix;
+    Mat fft_twiddles;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_INVERSESPECTROGRAM_ARM_H
@@ -0,0 +1,60 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "log_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#include "neon_mathfun.h"
+#endif // __ARM_NEON
+
+namespace ncnn {
+
+Log_arm::Log_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int Log_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int d = bottom_top_blob.d;
+    int channels = bottom_top_blob.c;
+    int elempack = bottom_top_blob.elempack;
+    int size = w * h * d * elempack;
+
+    const float log_base_inv = base == -1.f ? 1.f : 1.f / logf(base);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __ARM_NEON
+        float32x4_t _scale = vdupq_n_f32(scale);
+        float32x4_t _shift = vdupq_n_f32(shift);
+        float32x4_t _log_base_inv = vdupq_n_f32(log_base_inv);
+        for (; i + 3 < size; i += 4)
+        {
+            float32x4_t _p = vld1q_f32(ptr);
+            _p = vmulq_f32(log_ps(vmlaq_f32(_shift, _p, _scale)), _log_base_inv);
+            vst1q_f32(ptr, _p);
+
+            ptr += 4;
+        }
+#endif // __ARM_NEON
+        for (; i < size; i++)
+        {
+            *ptr = logf(shift + *ptr * scale) * log_base_inv;
+            ptr++;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_LOG_ARM_H
+#define LAYER_LOG_ARM_H
+
+#include "log.h"
+
+namespace ncnn {
+
+class Log_arm : public Log
+{
+public:
+    Log_arm();
+
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_LOG_ARM_H
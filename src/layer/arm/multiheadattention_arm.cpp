@@ -6,8 +6,376 @@
 #include "cpu.h"
 #include "layer_type.h"
 
+#if __ARM_NEON
+#include <arm_neon.h>
+#include "neon_mathfun.h"
+#endif // __ARM_NEON
+
+#include <float.h>
+
 namespace ncnn {
 
+// query rows and key columns processed per attention tile
+#define FLASH_ATTENTION_TILE_Q 8
+#define FLASH_ATTENTION_TILE_K 64
+
+// s = exp(s - max), returns sum(s)
+static float flash_attention_exp_sum(float* s, float max, int n)
+{
+    float sum = 0.f;
+
+    int i = 0;
+#if __ARM_NEON
+    float32x4_t _max = vdupq_n_f32(max);
+    float32x4_t _sum = vdupq_n_f32(0.f);
+    for (; i + 3 < n; i += 4)
+    {
+        float32x4_t _p = exp_ps(vsubq_f32(vld1q_f32(s + i), _max));
+        vst1q_f32(s + i, _p);
+        _sum = vaddq_f32(_sum, _p);
+    }
+#if __aarch64__
+    sum += vaddvq_f32(_sum);
+#else
+    float32x2_t _sum2 = vadd_f32(vget_low_f32(_sum), vget_high_f32(_sum));
+    float32x2_t _ss2 = vpadd_f32(_sum2, _sum2);
+    sum += vget_lane_f32(_ss2, 0);
+#endif
+#endif // __ARM_NEON
+    for (; i < n; i++)
+    {
+        s[i] = expf(s[i] - max);
+        sum += s[i];
+    }
+
+    return sum;
+}
+
+// s[r][kj] = mask[r][kj] + sum_d q[d][r] * k[d][kj] for 4 query rows
+static void flash_attention_qk_4(const float* qptr, const float* kptr, int qstride, int kstride, int dh, const int* qcols, const float* const* maskptrs, float* const* sptrs, int max_kj)
+{
+    const int qc0 = qcols[0];
+    const int qc1 = qcols[1];
+    const int qc2 = qcols[2];
+    const int qc3 = qcols[3];
+
+    int kj = 0;
+#if __ARM_NEON
+    for (; kj + 3 < max_kj; kj += 4)
+    {
+        float32x4_t _s0 = maskptrs[0] ? vld1q_f32(maskptrs[0] + kj) : vdupq_n_f32(0.f);
+        float32x4_t _s1 = maskptrs[1] ? vld1q_f32(maskptrs[1] + kj) : vdupq_n_f32(0.f);
+        float32x4_t _s2 = maskptrs[2] ? vld1q_f32(maskptrs[2] + kj) : vdupq_n_f32(0.f);
+        float32x4_t _s3 = maskptrs[3] ? vld1q_f32(maskptrs[3] + kj) : vdupq_n_f32(0.f);
+
+        const float* q = qptr;
+        const float* k = kptr + kj;
+        for (int d = 0; d < dh; d++)
+        {
+            float32x4_t _k = vld1q_f32(k);
+            _s0 = vmlaq_n_f32(_s0, _k, q[qc0]);
+            _s1 = vmlaq_n_f32(_s1, _k, q[qc1]);
+            _s2 = vmlaq_n_f32(_s2, _k, q[qc2]);
+            _s3 = vmlaq_n_f32(_s3, _k, q[qc3]);
+            q += qstride;
+            k += kstride;
+        }
+
+        vst1q_f32(sptrs[0] + kj, _s0);
+        vst1q_f32(sptrs[1] + kj, _s1);
+        vst1q_f32(sptrs[2] + kj, _s2);
+        vst1q_f32(sptrs[3] + kj, _s3);
+    }
+#endif // __ARM_NEON
+    for (; kj < max_kj; kj++)
+    {
+        float s0 = maskptrs[0] ? maskptrs[0][kj] : 0.f;
+        float s1 = maskptrs[1] ? maskptrs[1][kj] : 0.f;
+        float s2 = maskptrs[2] ? maskptrs[2][kj] : 0.f;
+        float s3 = maskptrs[3] ? maskptrs[3][kj] : 0.f;
+
+        const float* q = qptr;
+        const float* k = kptr + kj;
+        for (int d = 0; d < dh; d++)
+        {
+            s0 += q[qc0] * k[0];
+            s1 += q[qc1] * k[0];
+            s2 += q[qc2] * k[0];
+            s3 += q[qc3] * k[0];
+            q += qstride;
+            k += kstride;
+        }
+
+        sptrs[0][kj] = s0;
+        sptrs[1][kj] = s1;
+        sptrs[2][kj] = s2;
+        sptrs[3][kj] = s3;
+    }
+}
+
+// s[kj] = mask[kj] + sum_d q[d] * k[kj][d] for one query row, k one token per row
+static void flash_attention_qk_1(const float* qptr, const float* kptr, int kstride, int dh, const float* maskptr, float* sptr, int max_kj)
+{
+    int kj = 0;
+    for (; kj + 3 < max_kj; kj += 4)
+    {
+        const float* k0 = kptr + kj * kstride;
+        const float* k1 = k0 + kstride;
+        const float* k2 = k1 + kstride;
+        const float* k3 = k2 + kstride;
+
+        float s0 = 0.f;
+        float s1 = 0.f;
+        float s2 = 0.f;
+        float s3 = 0.f;
+
+        int d = 0;
+#if __ARM_NEON
+        if (d + 3 < dh)
+        {
+            float32x4_t _s0 = vdupq_n_f32(0.f);
+            float32x4_t _s1 = vdupq_n_f32(0.f);
+            float32x4_t _s2 = vdupq_n_f32(0.f);
+            float32x4_t _s3 = vdupq_n_f32(0.f);
+            for (; d + 3 < dh; d += 4)
+            {
+                float32x4_t _q = vld1q_f32(qptr + d);
+                _s0 = vmlaq_f32(_s0, _q, vld1q_f32(k0 + d));
+                _s1 = vmlaq_f32(_s1, _q, vld1q_f32(k1 + d));
+                _s2 = vmlaq_f32(_s2, _q, vld1q_f32(k2 + d));
+                _s3 = vmlaq_f32(_s3, _q, vld1q_f32(k3 + d));
+            }
+#if __aarch64__
+            float32x4_t _ss = vpaddq_f32(vpaddq_f32(_s0, _s1), vpaddq_f32(_s2, _s3));
+#else
+            float32x2_t _s01 = vpadd_f32(vadd_f32(vget_low_f32(_s0), vget_high_f32(_s0)), vadd_f32(vget_low_f32(_s1), vget_high_f32(_s1)));
+            float32x2_t _s23 = vpadd_f32(vadd_f32(vget_low_f32(_s2), vget_high_f32(_s2)), vadd_f32(vget_low_f32(_s3), vget_high_f32(_s3)));
+            float32x4_t _ss = vcombine_f32(_s01, _s23);
+#endif
+            s0 = vgetq_lane_f32(_ss, 0);
+            s1 = vgetq_lane_f32(_ss, 1);
+            s2 = vgetq_lane_f32(_ss, 2);
+            s3 = vgetq_lane_f32(_ss, 3);
+        }
+#endif // __ARM_NEON
+        for (; d < dh; d++)
+        {
+            s0 += qptr[d] * k0[d];
+            s1 += qptr[d] * k1[d];
+            s2 += qptr[d] * k2[d];
+            s3 += qptr[d] * k3[d];
+        }
+
+        sptr[kj] = maskptr ? maskptr[kj] + s0 : s0;
+        sptr[kj + 1] = maskptr ? maskptr[kj + 1] + s1 : s1;
+        sptr[kj + 2] = maskptr ? maskptr[kj + 2] + s2 : s2;
+        sptr[kj + 3] = maskptr ? maskptr[kj + 3] + s3 : s3;
+    }
+    for (; kj < max_kj; kj++)
+    {
+        const float* k = kptr + kj * kstride;
+
+        float s = maskptr ? maskptr[kj] : 0.f;
+        for (int d = 0; d < dh; d++)
+        {
+            s += qptr[d] * k[d];
+        }
+
+        sptr[kj] = s;
+    }
+}
+
+// acc[r][d] += sum_kj p[r][kj] * vt[kj][d] for 4 query rows
+static void flash_attention_pv_4(const float* vtptr, int vtstride, int dh, const float* const* pptrs, float* const* accptrs, int max_kj)
+{
+    const float* p0 = pptrs[0];
+    const float* p1 = pptrs[1];
+    const float* p2 = pptrs[2];
+    const float* p3 = pptrs[3];
+
+    int d = 0;
+#if __ARM_NEON
+    for (; d + 3 < dh; d += 4)
+    {
+        float32x4_t _a0 = vld1q_f32(accptrs[0] + d);
+        float32x4_t _a1 = vld1q_f32(accptrs[1] + d);
+        float32x4_t _a2 = vld1q_f32(accptrs[2] + d);
+        float32x4_t _a3 = vld1q_f32(accptrs[3] + d);
+
+        const float* v = vtptr + d;
+        for (int kj = 0; kj < max_kj; kj++)
+        {
+            float32x4_t _v = vld1q_f32(v);
+            _a0 = vmlaq_n_f32(_a0, _v, p0[kj]);
+            _a1 = vmlaq_n_f32(_a1, _v, p1[kj]);
+            _a2 = vmlaq_n_f32(_a2, _v, p2[kj]);
+            _a3 = vmlaq_n_f32(_a3, _v, p3[kj]);
+            v += vtstride;
+        }
+
+        vst1q_f32(accptrs[0] + d, _a0);
+        vst1q_f32(accptrs[1] + d, _a1);
+        vst1q_f32(accptrs[2] + d, _a2);
+        vst1q_f32(accptrs[3] + d, _a3);
+    }
+#endif // __ARM_NEON
+    for (; d < dh; d++)
+    {
+        float a0 = accptrs[0][d];
+        float a1 = accptrs[1][d];
+        float a2 = accptrs[2][d];
+        float a3 = accptrs[3][d];
+
+        const float* v = vtptr + d;
+        for (int kj = 0; kj < max_kj; kj++)
+        {
+            a0 += p0[kj] * v[0];
+            a1 += p1[kj] * v[0];
+            a2 += p2[kj] * v[0];
+            a3 += p3[kj] * v[0];
+            v += vtstride;
+        }
+
+        accptrs[0][d] = a0;
+        accptrs[1][d] = a1;
+        accptrs[2][d] = a2;
+        accptrs[3][d] = a3;
+    }
+}
+
+// softmax(q^T k + mask) v per head, streamed over key tiles with running max and sum
+// so that the src_seqlen x dst_seqlen attention matrix is never stored
+// q_affine           embed_dim x src_seqlen
+// k_affine           embed_dim x dst_seqlen, or dst_seqlen x embed_dim with k_token_major as the kv cache stores it
+// v_affine_t         dst_seqlen x embed_dim
+static int flash_attention(const Mat& q_affine, const Mat& k_affine, const Mat& v_affine_t, const Mat& attn_mask_blob, Mat& qkv_cross, int num_heads, int k_token_major, const Option& opt)
+{
+    const int src_seqlen = q_affine.w;
+    const int dst_seqlen = k_token_major ? k_affine.h : k_affine.w;
+    const int embed_dim_per_head = q_affine.h / num_heads;
+    const int out_embed_dim_per_head = v_affine_t.w / num_heads;
+
+    const int TILE_Q = FLASH_ATTENTION_TILE_Q;
+    const int TILE_K = FLASH_ATTENTION_TILE_K;
+
+    const int nn_q = (src_seqlen + TILE_Q - 1) / TILE_Q;
+
+    // per thread scores, output accumulator, running max, running sum and the contiguous queries for k_token_major
+    Mat scratch(TILE_Q * TILE_K + TILE_Q * out_embed_dim_per_head + TILE_Q * 2 + TILE_Q * embed_dim_per_head, 1, opt.num_threads, 4u, opt.workspace_allocator);
+    if (scratch.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < num_heads * nn_q; t++)
+    {
+        const int i = t / nn_q;
+        const int q0 = (t % nn_q) * TILE_Q;
+        const int max_qi = std::min(TILE_Q, src_seqlen - q0);
+
+        const Mat maskm = attn_mask_blob.dims == 3 ? attn_mask_blob.channel(i) : attn_mask_blob;
+
+        float* sptr = scratch.channel(get_omp_thread_num());
+        float* accptr = sptr + TILE_Q * TILE_K;
+        float* maxptr = accptr + TILE_Q * out_embed_dim_per_head;
+        float* sumptr = maxptr + TILE_Q;
+        float* qtptr = sumptr + TILE_Q;
+
+        for (int qi = 0; qi < max_qi; qi++)
+        {
+            maxptr[qi] = -FLT_MAX;
+            sumptr[qi] = 0.f;
+        }
+        memset(accptr, 0, TILE_Q * out_embed_dim_per_head * sizeof(float));
+
+        const float* qptr = q_affine.row(i * embed_dim_per_head);
+
+        if (k_token_major)
+        {
+            for (int qi = 0; qi < max_qi; qi++)
+            {
+                for (int d = 0; d < embed_dim_per_head; d++)
+                {
+                    qtptr[qi * embed_dim_per_head + d] = qptr[d * q_affine.w + q0 + qi];
+                }
+            }
+        }
+
+        for (int k0 = 0; k0 < dst_seqlen; k0 += TILE_K)
+        {
+            const int max_kj = std::min(TILE_K, dst_seqlen - k0);
+
+            const float* kptr = k_token_major ? k_affine.row(k0) + i * embed_dim_per_head : k_affine.row(i * embed_dim_per_head) + k0;
+            const float* vtptr = v_affine_t.row(k0) + i * out_embed_dim_per_head;
+
+            for (int qi = 0; qi < max_qi; qi += 4)
+            {
+                // rows past the tail repeat the scores of the last query and are discarded
+                int qcols[4];
+                const float* maskptrs[4];
+                float* sptrs[4];
+                float* accptrs[4];
+                for (int r = 0; r < 4; r++)
+                {
+                    const int qr = std::min(qi + r, max_qi - 1);
+                    qcols[r] = q0 + qr;
+                    maskptrs[r] = maskm.empty() ? 0 : maskm.row(q0 + qr) + k0;
+                    sptrs[r] = sptr + qr * TILE_K;
+                    accptrs[r] = accptr + (qi + r) * out_embed_dim_per_head;
+                }
+
+                if (k_token_major)
+                {
+                    // one query at a time, decoding has a single one
+                    for (int r = 0; r < 4 && qi + r < max_qi; r++)
+                    {
+                        flash_attention_qk_1(qtptr + (qi + r) * embed_dim_per_head, kptr, k_affine.w, embed_dim_per_head, maskptrs[r], sptrs[r], max_kj);
+                    }
+                }
+                else
+                {
+                    flash_attention_qk_4(qptr, kptr, q_affine.w, k_affine.w, embed_dim_per_head, qcols, maskptrs, sptrs, max_kj);
+                }
+
+                for (int r = 0; r < 4 && qi + r < max_qi; r++)
+                {
+                    float* s = sptrs[r];
+
+                    float max = maxptr[qi + r];
+                    for (int kj = 0; kj < max_kj; kj++)
+                    {
+                        max = std::max(max, s[kj]);
+                    }
+
+                    // rescale what was accumulated against the previous max
+                    const float correction = expf(maxptr[qi + r] - max);
+                    sumptr[qi + r] = sumptr[qi + r] * correction + flash_attention_exp_sum(s, max, max_kj);
+                    maxptr[qi + r] = max;
+
+                    float* acc = accptrs[r];
+                    for (int d = 0; d < out_embed_dim_per_head; d++)
+                    {
+                        acc[d] *= correction;
+                    }
+                }
+
+                flash_attention_pv_4(vtptr, v_affine_t.w, out_embed_dim_per_head, sptrs, accptrs, max_kj);
+            }
+        }
+
+        for (int qi = 0; qi < max_qi; qi++)
+        {
+            const float* acc = accptr + qi * out_embed_dim_per_head;
+            const float sum_inv = 1.f / sumptr[qi];
+            for (int d = 0; d < out_embed_dim_per_head; d++)
+            {
+                qkv_cross.row(i * out_embed_dim_per_head + d)[q0 + qi] = acc[d] * sum_inv;
+            }
+        }
+    }
+
+    return 0;
+}
+
 MultiHeadAttention_arm::MultiHeadAttention_arm()
 {
 #if __ARM_NEON
@@ -32,10 +400,18 @@ MultiHeadAttention_arm::MultiHeadAttention_arm()
 
 int MultiHeadAttention_arm::create_pipeline(const Option& _opt)
 {
+    if (kv_cache)
+    {
+        // caches stay fp32 and grow in place, fp16 storage would cast them whole every step
+        support_fp16_storage = false;
+    }
+
     Option opt = _opt;
     opt.use_fp16_storage &= support_fp16_storage;
     opt.use_bf16_storage &= support_bf16_storage;
 
+    // the int8 path keeps qk_gemm and qkv_gemm for dynamic quantization of q k v
+    if (int8_scale_term)
     {
         qk_softmax = ncnn::create_layer_cpu(ncnn::LayerType::Softmax);
         ncnn::ParamDict pd;
@@ -103,6 +479,11 @@ int MultiHeadAttention_arm::create_pipeline(const Option& _opt)
 #if NCNN_INT8
         pd.set(18, int8_scale_term);
 #endif
+        if (kv_cache)
+        {
+            // dst_seqlen x embed_dim to append to the cache
+            pd.set(14, 1);
+        }
         k_gemm->load_param(pd);
         Mat weights[3];
         weights[0] = k_weight_data;
@@ -138,6 +519,11 @@ int MultiHeadAttention_arm::create_pipeline(const Option& _opt)
 #if NCNN_INT8
         pd.set(18, int8_scale_term);
 #endif
+        if (!int8_scale_term)
+        {
+            // dst_seqlen x embed_dim for flash attention
+            pd.set(14, 1);
+        }
         v_gemm->load_param(pd);
         Mat weights[3];
         weights[0] = v_weight_data;
@@ -190,6 +576,7 @@ int MultiHeadAttention_arm::create_pipeline(const Option& _opt)
         }
     }
 
+    if (int8_scale_term)
     {
         qk_gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
         ncnn::ParamDict pd;
@@ -214,6 +601,7 @@ int MultiHeadAttention_arm::create_pipeline(const Option& _opt)
         qk_gemm->create_pipeline(opt1);
     }
 
+    if (int8_scale_term)
     {
         qkv_gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
         ncnn::ParamDict pd;
@@ -302,10 +690,13 @@ int MultiHeadAttention_arm::destroy_pipeline(const Option& _opt)
 
 int MultiHeadAttention_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& _opt) const
 {
+    // q [k] [v] [attn_mask] [cache_k cache_v]
+    const size_t input_blob_count = kv_cache ? bottom_blobs.size() - 2 : bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_blob_count == 1 || (input_blob_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_blob_count == 1 || (input_blob_count == 2 && attn_mask)) ? q_blob : (input_blob_count == 2 || (input_blob_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_blob_count - 1] : Mat();
 
     Option opt = _opt;
     opt.use_fp16_storage &= support_fp16_storage;
@@ -341,6 +732,84 @@ int MultiHeadAttention_arm::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retk != 0)
         return retk;
 
+    if (!int8_scale_term)
+    {
+        // dst_seqlen x embed_dim
+        Mat v_affine_t;
+        int retv = v_gemm->forward(v_blob, v_affine_t, opt);
+        if (retv != 0)
+            return retv;
+
+        if (kv_cache)
+        {
+            // append the new tokens to the caches and attend over all tokens
+            // flash attention reads the k cache one token per row as stored
+            int retc = append_kv_cache(bottom_blobs[input_blob_count], k_affine, top_blobs[1], opt);
+            if (retc != 0)
+                return retc;
+
+            retc = append_kv_cache(bottom_blobs[input_blob_count + 1], v_affine_t, top_blobs[2], opt);
+            if (retc != 0)
+                return retc;
+
+            k_affine = top_blobs[1];
+            v_affine_t = top_blobs[2];
+        }
+
+        // attention runs in fp32, fp16 storage is cast around it
+        if (elemsize == 2u)
+        {
+            Mat q_affine_fp32;
+            cast_float16_to_float32(q_affine, q_affine_fp32, opt);
+            q_affine = q_affine_fp32;
+
+            Mat k_affine_fp32;
+            cast_float16_to_float32(k_affine, k_affine_fp32, opt);
+            k_affine = k_affine_fp32;
+
+            Mat v_affine_t_fp32;
+            cast_float16_to_float32(v_affine_t, v_affine_t_fp32, opt);
+            v_affine_t = v_affine_t_fp32;
+
+            if (q_affine.empty() || k_affine.empty() || v_affine_t.empty())
+                return -100;
+        }
+
+        if (attn_mask && attn_mask_blob_unpacked.elembits() == 16)
+        {
+            Mat attn_mask_blob_fp32;
+            cast_float16_to_float32(attn_mask_blob_unpacked, attn_mask_blob_fp32, opt);
+            if (attn_mask_blob_fp32.empty())
+                return -100;
+
+            attn_mask_blob_unpacked = attn_mask_blob_fp32;
+        }
+
+        Mat qkv_cross(src_seqlen, embed_dim_per_head * num_heads, 4u, opt.blob_allocator);
+        if (qkv_cross.empty())
+            return -100;
+
+        int retqkv = flash_attention(q_affine, k_affine, v_affine_t, attn_mask_blob_unpacked, qkv_cross, num_heads, kv_cache, opt);
+        if (retqkv != 0)
+            return retqkv;
+
+        q_affine.release();
+        k_affine.release();
+        v_affine_t.release();
+
+        if (elemsize == 2u)
+        {
+            Mat qkv_cross_fp16;
+            cast_float32_to_float16(qkv_cross, qkv_cross_fp16, opt);
+            if (qkv_cross_fp16.empty())
+                return -100;
+
+            qkv_cross = qkv_cross_fp16;
+        }
+
+        return o_gemm->forward(qkv_cross, top_blobs[0], opt);
+    }
+
     Mat qk_cross(dst_seqlen, src_seqlen * num_heads, elemsize, opt.blob_allocator);
     if (qk_cross.empty())
         return -100;
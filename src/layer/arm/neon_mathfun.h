@@ -395,5 +395,29 @@ static inline float32x4_t atan2_ps(float32x4_t a, float32x4_t b)
     return vld1q_f32(tmpx);
 }
 
+static inline float32x4_t erf_ps(float32x4_t x)
+{
+    // Abramowitz and Stegun 7.1.26, max abs error 1.5e-7
+    const float32x4_t one = vdupq_n_f32(1.f);
+
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000));
+    float32x4_t absolute = vabsq_f32(x);
+
+    // t = 1 / (1 + p * |x|)
+    float32x4_t t = div_ps(one, vmlaq_f32(one, absolute, vdupq_n_f32(0.3275911f)));
+
+    // y = 1 - (((((a5 * t + a4) * t) + a3) * t + a2) * t + a1) * t * exp(-x * x)
+    float32x4_t y = vmlaq_f32(vdupq_n_f32(-1.453152027f), t, vdupq_n_f32(1.061405429f));
+    y = vmlaq_f32(vdupq_n_f32(1.421413741f), y, t);
+    y = vmlaq_f32(vdupq_n_f32(-0.284496736f), y, t);
+    y = vmlaq_f32(vdupq_n_f32(0.254829592f), y, t);
+    y = vmulq_f32(y, t);
+
+    float32x4_t e = exp_ps(vnegq_f32(vmulq_f32(x, x)));
+    y = vmlsq_f32(one, y, e);
+
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(y), sign));
+}
+
 #include "neon_mathfun_tanh.h"
 #endif // NEON_MATHFUN_H
@@ -0,0 +1,172 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pooling1d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include <float.h>
+
+#include "arm_usability.h"
+
+namespace ncnn {
+
+Pooling1D_arm::Pooling1D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int Pooling1D_arm::create_pipeline(const Option& /*opt*/)
+{
+    if (adaptive_pooling)
+    {
+        support_packing = false;
+    }
+    return 0;
+}
+
+// max or scaled sum of the packed elements at sptr + ofs[0..n)
+static NCNN_FORCEINLINE void pooling1d_packed(const float* sptr, const int* ofs, int n, int elempack, int pooling_type, float scale, float* outptr)
+{
+#if __ARM_NEON
+    if (elempack == 4)
+    {
+        float32x4_t _r = pooling_type == Pooling1D::PoolMethod_MAX ? vdupq_n_f32(-FLT_MAX) : vdupq_n_f32(0.f);
+        if (pooling_type == Pooling1D::PoolMethod_MAX)
+        {
+            for (int k = 0; k < n; k++)
+                _r = vmaxq_f32(_r, vld1q_f32(sptr + ofs[k]));
+        }
+        else
+        {
+            for (int k = 0; k < n; k++)
+                _r = vaddq_f32(_r, vld1q_f32(sptr + ofs[k]));
+            _r = vmulq_f32(_r, vdupq_n_f32(scale));
+        }
+        vst1q_f32(outptr, _r);
+        return;
+    }
+#endif // __ARM_NEON
+}
+
+int Pooling1D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int elempack = bottom_blob.elempack;
+
+    if (elempack == 1 || adaptive_pooling)
+    {
+        return Pooling1D::forward(bottom_blob, top_blob, opt);
+    }
+
+    int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (global_pooling)
+    {
+        top_blob.create(h, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        const float scale = 1.f / w;
+
+        std::vector<int> _ofs(w);
+        for (int i = 0; i < w; i++)
+        {
+            _ofs[i] = i * elempack;
+        }
+        const int* ofs = &_ofs[0];
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < h; q++)
+        {
+            const float* ptr = bottom_blob.row(q);
+            float* outptr = (float*)top_blob + q * elempack;
+
+            pooling1d_packed(ptr, ofs, w, elempack, pooling_type, scale, outptr);
+        }
+
+        return 0;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    w = bottom_blob_bordered.w;
+
+    const int outw = (w - kernel_w) / stride_w + 1;
+
+    top_blob.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(kernel_w);
+    int* space_ofs = &_space_ofs[0];
+    for (int k = 0; k < kernel_w; k++)
+    {
+        space_ofs[k] = k * elempack;
+    }
+
+    if (pooling_type == PoolMethod_MAX || avgpool_count_include_pad == 1)
+    {
+        const float scale = 1.f / kernel_w;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < h; q++)
+        {
+            const float* ptr = bottom_blob_bordered.row(q);
+            float* outptr = top_blob.row(q);
+
+            for (int j = 0; j < outw; j++)
+            {
+                const float* sptr = ptr + j * stride_w * elempack;
+
+                pooling1d_packed(sptr, space_ofs, kernel_w, elempack, pooling_type, scale, outptr);
+
+                outptr += elempack;
+            }
+        }
+
+        return 0;
+    }
+
+    // avgpool_count_include_pad == 0
+    int wtailpad = 0;
+
+    if (pad_mode == 0) // full padding
+    {
+        wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < h; q++)
+    {
+        const float* ptr = bottom_blob_bordered.row(q);
+        float* outptr = top_blob.row(q);
+
+        for (int j = 0; j < outw; j++)
+        {
+            const int sx0 = j * stride_w;
+
+            // the taps that fall inside the unpadded input
+            const int sx_begin = std::max(sx0, pad_left);
+            const int sx_end = std::min(sx0 + kernel_w, w - pad_right - wtailpad);
+            const int area = sx_end - sx_begin;
+
+            pooling1d_packed(ptr + sx_begin * elempack, space_ofs, area, elempack, pooling_type, 1.f / area, outptr);
+
+            outptr += elempack;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,22 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_POOLING1D_ARM_H
+#define LAYER_POOLING1D_ARM_H
+
+#include "pooling1d.h"
+
+namespace ncnn {
+
+class Pooling1D_arm : public Pooling1D
+{
+public:
+    Pooling1D_arm();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_POOLING1D_ARM_H
@@ -0,0 +1,80 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "power_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#include "neon_mathfun.h"
+#endif // __ARM_NEON
+
+namespace ncnn {
+
+Power_arm::Power_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int Power_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int d = bottom_top_blob.d;
+    int channels = bottom_top_blob.c;
+    int elempack = bottom_top_blob.elempack;
+    int size = w * h * d * elempack;
+
+    // integer exponent keeps negative bases valid, as powf does
+    const bool integer_power = fabsf(power) <= 64.f && power == (float)(int)power;
+    const int ipower = integer_power ? (int)fabsf(power) : 0;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __ARM_NEON
+        float32x4_t _scale = vdupq_n_f32(scale);
+        float32x4_t _shift = vdupq_n_f32(shift);
+        float32x4_t _power = vdupq_n_f32(power);
+        float32x4_t _one = vdupq_n_f32(1.f);
+        for (; i + 3 < size; i += 4)
+        {
+            float32x4_t _p = vld1q_f32(ptr);
+            _p = vmlaq_f32(_shift, _p, _scale);
+            if (integer_power)
+            {
+                float32x4_t _x = _p;
+                _p = _one;
+                for (int n = ipower; n; n >>= 1)
+                {
+                    if (n & 1)
+                        _p = vmulq_f32(_p, _x);
+                    _x = vmulq_f32(_x, _x);
+                }
+                if (power < 0.f)
+                    _p = div_ps(_one, _p);
+            }
+            else
+            {
+                _p = pow_ps(_p, _power);
+            }
+            vst1q_f32(ptr, _p);
+
+            ptr += 4;
+        }
+#endif // __ARM_NEON
+        for (; i < size; i++)
+        {
+            *ptr = powf((shift + *ptr * scale), power);
+            ptr++;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
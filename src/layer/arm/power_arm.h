@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_POWER_ARM_H
+#define LAYER_POWER_ARM_H
+
+#include "power.h"
+
+namespace ncnn {
+
+class Power_arm : public Power
+{
+public:
+    Power_arm();
+
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_POWER_ARM_H
@@ -0,0 +1,662 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "reduction_arm.h"
+
+#include <float.h>
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#include "neon_mathfun.h"
+#endif // __ARM_NEON
+
+#include "arm_usability.h"
+
+namespace ncnn {
+
+Reduction_arm::Reduction_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+struct reduction_op_add
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + y;
+    }
+#if __ARM_NEON
+    NCNN_FORCEINLINE float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vaddq_f32(x, y);
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_asum
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + fabsf(y);
+    }
+#if __ARM_NEON
+    NCNN_FORCEINLINE float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vaddq_f32(x, vabsq_f32(y));
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_sumsq
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + y * y;
+    }
+#if __ARM_NEON
+    NCNN_FORCEINLINE float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vmlaq_f32(x, y, y);
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_sumexp
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + expf(y);
+    }
+#if __ARM_NEON
+    NCNN_FORCEINLINE float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vaddq_f32(x, exp_ps(y));
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_max
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return std::max(x, y);
+    }
+#if __ARM_NEON
+    NCNN_FORCEINLINE float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vmaxq_f32(x, y);
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_min
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return std::min(x, y);
+    }
+#if __ARM_NEON
+    NCNN_FORCEINLINE float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vminq_f32(x, y);
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_mul
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x * y;
+    }
+#if __ARM_NEON
+    NCNN_FORCEINLINE float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vmulq_f32(x, y);
+    }
+#endif // __ARM_NEON
+};
+
+// outptr[i] = op(outptr[i], ptr[i])
+template<typename Op>
+static void reduction_v(const float* ptr, float* outptr, int size)
+{
+    const Op op;
+
+    int i = 0;
+#if __ARM_NEON
+    for (; i + 15 < size; i += 16)
+    {
+        float32x4_t _p0 = vld1q_f32(ptr);
+        float32x4_t _p1 = vld1q_f32(ptr + 4);
+        float32x4_t _p2 = vld1q_f32(ptr + 8);
+        float32x4_t _p3 = vld1q_f32(ptr + 12);
+        vst1q_f32(outptr, op.func_pack4(vld1q_f32(outptr), _p0));
+        vst1q_f32(outptr + 4, op.func_pack4(vld1q_f32(outptr + 4), _p1));
+        vst1q_f32(outptr + 8, op.func_pack4(vld1q_f32(outptr + 8), _p2));
+        vst1q_f32(outptr + 12, op.func_pack4(vld1q_f32(outptr + 12), _p3));
+        ptr += 16;
+        outptr += 16;
+    }
+    for (; i + 3 < size; i += 4)
+    {
+        vst1q_f32(outptr, op.func_pack4(vld1q_f32(outptr), vld1q_f32(ptr)));
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __ARM_NEON
+    for (; i < size; i++)
+    {
+        *outptr = op.func(*outptr, *ptr);
+        ptr++;
+        outptr++;
+    }
+}
+
+// reduce size x elempack contiguous floats into the elempack lanes of outptr
+// the accumulators are folded down to elempack lanes with op2
+template<typename Op, typename Op2>
+static void reduction_pack(const float* ptr, int size, int elempack, float v0, float* outptr)
+{
+    const Op op;
+    const Op2 op2;
+
+    const int n = size * elempack;
+
+    int i = 0;
+#if __ARM_NEON
+    float32x4_t _sum0 = vdupq_n_f32(v0);
+    float32x4_t _sum1 = vdupq_n_f32(v0);
+    for (; i + 7 < n; i += 8)
+    {
+        _sum0 = op.func_pack4(_sum0, vld1q_f32(ptr + i));
+        _sum1 = op.func_pack4(_sum1, vld1q_f32(ptr + i + 4));
+    }
+    for (; i + 3 < n; i += 4)
+    {
+        _sum0 = op.func_pack4(_sum0, vld1q_f32(ptr + i));
+    }
+    _sum0 = op2.func_pack4(_sum0, _sum1);
+    if (elempack == 4)
+    {
+        vst1q_f32(outptr, op2.func_pack4(vld1q_f32(outptr), _sum0));
+        return;
+    }
+    float tmp[4];
+    vst1q_f32(tmp, _sum0);
+    float sum = op2.func(op2.func(tmp[0], tmp[1]), op2.func(tmp[2], tmp[3]));
+#else
+    float sum = v0;
+#endif // __ARM_NEON
+    for (; i < n; i++)
+    {
+        sum = op.func(sum, ptr[i]);
+    }
+
+    outptr[0] = op2.func(outptr[0], sum);
+}
+
+// walk the inner segments from outer to inner, the innermost one is contiguous
+// reduced segments have zero outstep so that they accumulate into the same output
+template<typename Op, typename Op2>
+static void reduction_segments(const float* ptr, const int* sizes, const int* steps, const int* outsteps, const int* flags, int nseg, int elempack, float v0, float* outptr)
+{
+    if (nseg == 1)
+    {
+        if (flags[0])
+            reduction_pack<Op, Op2>(ptr, sizes[0], elempack, v0, outptr);
+        else
+            reduction_v<Op>(ptr, outptr, sizes[0] * elempack);
+
+        return;
+    }
+
+    for (int i = 0; i < sizes[0]; i++)
+    {
+        reduction_segments<Op, Op2>(ptr + (size_t)i * steps[0], sizes + 1, steps + 1, outsteps + 1, flags + 1, nseg - 1, elempack, v0, outptr + (size_t)i * outsteps[0]);
+    }
+}
+
+template<typename Op2>
+static void reduction_fold_lanes(const float* ptr, float* outptr, int size, int elempack)
+{
+    const Op2 op2;
+
+    for (int i = 0; i < size; i++)
+    {
+        float sum = ptr[0];
+        for (int k = 1; k < elempack; k++)
+        {
+            sum = op2.func(sum, ptr[k]);
+        }
+
+        outptr[i] = sum;
+        ptr += elempack;
+    }
+}
+
+template<typename Op, typename Op2>
+static int reduction_packed(const Mat& a, Mat& b, int outer, size_t outer_step, int reduce_outer, const int* sizes, const int* steps, const int* outsteps, const int* flags, int nseg, float v0, const Option& opt)
+{
+    const int elempack = a.elempack;
+
+    // accumulator floats per outer and the outermost kept segment
+    int kept_size = elempack;
+    int m = -1;
+    for (int k = 0; k < nseg; k++)
+    {
+        if (flags[k])
+            continue;
+
+        kept_size *= sizes[k];
+        if (m == -1)
+            m = k;
+    }
+
+    if (!reduce_outer)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < outer; g++)
+        {
+            const float* ptr = (const float*)a + g * outer_step;
+            float* outptr = (float*)b + (size_t)g * kept_size;
+
+            for (int i = 0; i < kept_size; i++)
+            {
+                outptr[i] = v0;
+            }
+
+            reduction_segments<Op, Op2>(ptr, sizes, steps, outsteps, flags, nseg, elempack, v0, outptr);
+        }
+
+        return 0;
+    }
+
+    if (m == -1)
+    {
+        // reduce all
+        Mat sums(outer * elempack, 4u, opt.workspace_allocator);
+        if (sums.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < outer; g++)
+        {
+            const float* ptr = (const float*)a + g * outer_step;
+            float* sumsptr = (float*)sums + g * elempack;
+
+            for (int k = 0; k < elempack; k++)
+            {
+                sumsptr[k] = v0;
+            }
+
+            reduction_segments<Op, Op2>(ptr, sizes, steps, outsteps, flags, nseg, elempack, v0, sumsptr);
+        }
+
+        const Op2 op2;
+
+        float sum = v0;
+        for (int i = 0; i < outer * elempack; i++)
+        {
+            sum = op2.func(sum, sums[i]);
+        }
+
+        b[0] = sum;
+
+        return 0;
+    }
+
+    // the outer axis is reduced, tile the outermost kept segment
+    // and accumulate every outer into the tile while it stays in cache
+    Mat acc = b;
+    if (elempack > 1)
+    {
+        acc.create(kept_size, 4u, opt.workspace_allocator);
+        if (acc.empty())
+            return -100;
+    }
+
+    const int nn = sizes[m];
+    const int tile_size = std::min(nn, std::max(1, 4096 / outsteps[m]));
+    const int nn_tile = (nn + tile_size - 1) / tile_size;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < nn_tile; t++)
+    {
+        const int j0 = t * tile_size;
+        const int jn = std::min(tile_size, nn - j0);
+
+        int tile_sizes[3];
+        for (int k = 0; k < nseg; k++)
+        {
+            tile_sizes[k] = sizes[k];
+        }
+        tile_sizes[m] = jn;
+
+        float* outptr = (float*)acc + (size_t)j0 * outsteps[m];
+        const int tile_kept_size = jn * outsteps[m];
+
+        for (int i = 0; i < tile_kept_size; i++)
+        {
+            outptr[i] = v0;
+        }
+
+        for (int g = 0; g < outer; g++)
+        {
+            const float* ptr = (const float*)a + g * outer_step + (size_t)j0 * steps[m];
+
+            reduction_segments<Op, Op2>(ptr, tile_sizes, steps, outsteps, flags, nseg, elempack, v0, outptr);
+        }
+
+        if (elempack > 1)
+        {
+            reduction_fold_lanes<Op2>(outptr, (float*)b + (size_t)j0 * outsteps[m] / elempack, tile_kept_size / elempack, elempack);
+        }
+    }
+
+    return 0;
+}
+
+int Reduction_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+
+    int axes_flag[4] = {0};
+    bool reduce_w = false;
+    bool reduce_h = false;
+    bool reduce_d = false;
+    bool reduce_c = false;
+
+    if (reduce_all)
+    {
+        reduce_w = true;
+        reduce_h = true;
+        reduce_d = true;
+        reduce_c = true;
+    }
+    else
+    {
+        const int* axes_ptr = axes;
+        int reduced_axes_num = axes.w;
+
+        for (int i = 0; i < reduced_axes_num; i++)
+        {
+            int axis = axes_ptr[i];
+            // handle negative axis
+            if (axis < 0)
+                axis += dims;
+            axes_flag[axis] = 1;
+        }
+
+        if (dims == 1)
+        {
+            reduce_w = true;
+        }
+        else if (dims == 2)
+        {
+            if (axes_flag[0] == 1) reduce_h = true;
+            if (axes_flag[1] == 1) reduce_w = true;
+        }
+        else if (dims == 3)
+        {
+            if (axes_flag[0] == 1) reduce_c = true;
+            if (axes_flag[1] == 1) reduce_h = true;
+            if (axes_flag[2] == 1) reduce_w = true;
+        }
+        else if (dims == 4)
+        {
+            if (axes_flag[0] == 1) reduce_c = true;
+            if (axes_flag[1] == 1) reduce_d = true;
+            if (axes_flag[2] == 1) reduce_h = true;
+            if (axes_flag[3] == 1) reduce_w = true;
+        }
+    }
+
+    // view the blob as the packed outermost axis and three inner axes
+    int shape[4];
+    int shape_flags[4];
+    if (dims == 1)
+    {
+        shape[0] = bottom_blob.w;
+        shape[1] = 1;
+        shape[2] = 1;
+        shape[3] = 1;
+        shape_flags[0] = reduce_w;
+        shape_flags[1] = 0;
+        shape_flags[2] = 0;
+        shape_flags[3] = 0;
+    }
+    else if (dims == 2)
+    {
+        shape[0] = bottom_blob.h;
+        shape[1] = 1;
+        shape[2] = 1;
+        shape[3] = bottom_blob.w;
+        shape_flags[0] = reduce_h;
+        shape_flags[1] = 0;
+        shape_flags[2] = 0;
+        shape_flags[3] = reduce_w;
+    }
+    else
+    {
+        shape[0] = bottom_blob.c;
+        shape[1] = bottom_blob.d;
+        shape[2] = bottom_blob.h;
+        shape[3] = bottom_blob.w;
+        shape_flags[0] = reduce_c;
+        shape_flags[1] = reduce_d;
+        shape_flags[2] = reduce_h;
+        shape_flags[3] = reduce_w;
+    }
+
+    const int outer = shape[0];
+    const int reduce_outer = shape_flags[0];
+    const size_t outer_step = dims >= 3 ? bottom_blob.cstep * elempack : (size_t)shape[1] * shape[2] * shape[3] * elempack;
+
+    // merge adjacent inner axes that are reduced or kept alike, skip unit axes
+    int sizes[3];
+    int flags[3];
+    int nseg = 0;
+    for (int k = 1; k < 4; k++)
+    {
+        if (shape[k] == 1)
+            continue;
+
+        if (nseg > 0 && flags[nseg - 1] == shape_flags[k])
+        {
+            sizes[nseg - 1] *= shape[k];
+            continue;
+        }
+
+        sizes[nseg] = shape[k];
+        flags[nseg] = shape_flags[k];
+        nseg++;
+    }
+    if (nseg == 0)
+    {
+        sizes[0] = 1;
+        flags[0] = 1;
+        nseg = 1;
+    }
+
+    int steps[3];
+    int outsteps[3];
+    int kept_size = 1;
+    {
+        int step = elempack;
+        int outstep = elempack;
+        for (int k = nseg - 1; k >= 0; k--)
+        {
+            steps[k] = step;
+            step *= sizes[k];
+
+            outsteps[k] = flags[k] ? 0 : outstep;
+            if (!flags[k])
+            {
+                outstep *= sizes[k];
+                kept_size *= sizes[k];
+            }
+        }
+    }
+
+    // logical output shape, outermost first
+    const int shape_present[4] = {1, dims == 4, dims >= 3, dims >= 2};
+    int out_shape[4];
+    int out_dims = 0;
+    for (int k = 0; k < 4; k++)
+    {
+        if (!shape_present[k])
+            continue;
+
+        const int s = k == 0 ? outer * elempack : shape[k];
+        if (shape_flags[k])
+        {
+            if (keepdims)
+                out_shape[out_dims++] = 1;
+        }
+        else
+        {
+            out_shape[out_dims++] = s;
+        }
+    }
+    if (out_dims == 0)
+    {
+        out_shape[0] = 1;
+        out_dims = 1;
+    }
+
+    const int out_elempack = reduce_outer ? 1 : elempack;
+    const size_t out_elemsize = 4u * out_elempack;
+    if (!reduce_outer)
+        out_shape[0] /= elempack;
+
+    Mat b(reduce_outer ? kept_size : outer * kept_size, out_elemsize, out_elempack, opt.blob_allocator);
+    if (b.empty())
+        return -100;
+
+    int op_type = Reduction::ReductionOp_SUM;
+    float v0 = 0.f;
+
+    switch (operation)
+    {
+    case Reduction::ReductionOp_SUM:
+    case Reduction::ReductionOp_MEAN:
+    case Reduction::ReductionOp_LogSum:
+    {
+        break;
+    }
+    case Reduction::ReductionOp_ASUM:
+    case Reduction::ReductionOp_L1:
+    {
+        op_type = Reduction::ReductionOp_ASUM;
+        break;
+    }
+    case Reduction::ReductionOp_SUMSQ:
+    case Reduction::ReductionOp_L2:
+    {
+        op_type = Reduction::ReductionOp_SUMSQ;
+        break;
+    }
+    case Reduction::ReductionOp_MAX:
+    {
+        op_type = Reduction::ReductionOp_MAX;
+        v0 = -FLT_MAX;
+        break;
+    }
+    case Reduction::ReductionOp_MIN:
+    {
+        op_type = Reduction::ReductionOp_MIN;
+        v0 = FLT_MAX;
+        break;
+    }
+    case Reduction::ReductionOp_PROD:
+    {
+        op_type = Reduction::ReductionOp_PROD;
+        v0 = 1.f;
+        break;
+    }
+    case Reduction::ReductionOp_LogSumExp:
+    {
+        op_type = Reduction::ReductionOp_LogSumExp;
+        break;
+    }
+    default:
+    {
+        // should never reach here
+        break;
+    }
+    }
+
+    int ret = 0;
+    if (op_type == Reduction::ReductionOp_SUM) ret = reduction_packed<reduction_op_add, reduction_op_add>(bottom_blob, b, outer, outer_step, reduce_outer, sizes, steps, outsteps, flags, nseg, v0, opt);
+    if (op_type == Reduction::ReductionOp_ASUM) ret = reduction_packed<reduction_op_asum, reduction_op_add>(bottom_blob, b, outer, outer_step, reduce_outer, sizes, steps, outsteps, flags, nseg, v0, opt);
+    if (op_type == Reduction::ReductionOp_SUMSQ) ret = reduction_packed<reduction_op_sumsq, reduction_op_add>(bottom_blob, b, outer, outer_step, reduce_outer, sizes, steps, outsteps, flags, nseg, v0, opt);
+    if (op_type == Reduction::ReductionOp_PROD) ret = reduction_packed<reduction_op_mul, reduction_op_mul>(bottom_blob, b, outer, outer_step, reduce_outer, sizes, steps, outsteps, flags, nseg, v0, opt);
+    if (op_type == Reduction::ReductionOp_MAX) ret = reduction_packed<reduction_op_max, reduction_op_max>(bottom_blob, b, outer, outer_step, reduce_outer, sizes, steps, outsteps, flags, nseg, v0, opt);
+    if (op_type == Reduction::ReductionOp_MIN) ret = reduction_packed<reduction_op_min, reduction_op_min>(bottom_blob, b, outer, outer_step, reduce_outer, sizes, steps, outsteps, flags, nseg, v0, opt);
+    if (op_type == Reduction::ReductionOp_LogSumExp) ret = reduction_packed<reduction_op_sumexp, reduction_op_add>(bottom_blob, b, outer, outer_step, reduce_outer, sizes, steps, outsteps, flags, nseg, v0, opt);
+    if (ret != 0)
+        return ret;
+
+    float scale = coeff;
+    if (operation == Reduction::ReductionOp_MEAN)
+    {
+        int size = reduce_outer ? outer * elempack : 1;
+        for (int k = 1; k < 4; k++)
+        {
+            if (shape_flags[k])
+                size *= shape[k];
+        }
+
+        scale = coeff / size;
+    }
+
+    const int size = (int)b.total() * out_elempack;
+    float* ptr = b;
+
+    if (operation == Reduction::ReductionOp_LogSum || operation == Reduction::ReductionOp_LogSumExp)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < size; i++)
+        {
+            ptr[i] = logf(ptr[i]);
+        }
+    }
+
+    if (operation == Reduction::ReductionOp_L2)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < size; i++)
+        {
+            // flush subnormal input to zero as the reference does
+            ptr[i] = sqrtf(ptr[i] < FLT_MIN ? 0.f : ptr[i]);
+        }
+    }
+
+    if (scale != 1.f)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < size; i++)
+        {
+            ptr[i] = ptr[i] * scale;
+        }
+    }
+
+    if (out_dims == 1)
+        top_blob = b;
+    if (out_dims == 2)
+        top_blob = b.reshape(out_shape[1], out_shape[0], opt.blob_allocator);
+    if (out_dims == 3)
+        top_blob = b.reshape(out_shape[2], out_shape[1], out_shape[0], opt.blob_allocator);
+    if (out_dims == 4)
+        top_blob = b.reshape(out_shape[3], out_shape[2], out_shape[1], out_shape[0], opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+} // namespace ncnn
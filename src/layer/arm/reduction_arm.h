@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_REDUCTION_ARM_H
+#define LAYER_REDUCTION_ARM_H
+
+#include "reduction.h"
+
+namespace ncnn {
+
+class Reduction_arm : public Reduction
+{
+public:
+    Reduction_arm();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_REDUCTION_ARM_H
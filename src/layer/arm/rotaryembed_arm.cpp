@@ -0,0 +1,181 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "rotaryembed_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_usability.h"
+
+namespace ncnn {
+
+RotaryEmbed_arm::RotaryEmbed_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+static void rotary_embed_pack1(const float* ptr, const float* ctab, const float* stab, float* outptr, int half, int interleaved)
+{
+    int i = 0;
+
+    if (interleaved)
+    {
+#if __ARM_NEON
+        for (; i + 3 < half; i += 4)
+        {
+            float32x4x2_t _x = vld2q_f32(ptr + i * 2);
+            float32x4_t _c = vld1q_f32(ctab + i);
+            float32x4_t _s = vld1q_f32(stab + i);
+            float32x4x2_t _out;
+            _out.val[0] = vmlsq_f32(vmulq_f32(_x.val[0], _c), _x.val[1], _s);
+            _out.val[1] = vmlaq_f32(vmulq_f32(_x.val[1], _c), _x.val[0], _s);
+            vst2q_f32(outptr + i * 2, _out);
+        }
+#endif // __ARM_NEON
+        for (; i < half; i++)
+        {
+            const float x0 = ptr[i * 2];
+            const float x1 = ptr[i * 2 + 1];
+            outptr[i * 2] = x0 * ctab[i] - x1 * stab[i];
+            outptr[i * 2 + 1] = x1 * ctab[i] + x0 * stab[i];
+        }
+
+        return;
+    }
+
+    const float* ptr1 = ptr + half;
+    float* outptr1 = outptr + half;
+
+#if __ARM_NEON
+    for (; i + 3 < half; i += 4)
+    {
+        float32x4_t _x0 = vld1q_f32(ptr + i);
+        float32x4_t _x1 = vld1q_f32(ptr1 + i);
+        float32x4_t _c = vld1q_f32(ctab + i);
+        float32x4_t _s = vld1q_f32(stab + i);
+        vst1q_f32(outptr + i, vmlsq_f32(vmulq_f32(_x0, _c), _x1, _s));
+        vst1q_f32(outptr1 + i, vmlaq_f32(vmulq_f32(_x1, _c), _x0, _s));
+    }
+#endif // __ARM_NEON
+    for (; i < half; i++)
+    {
+        const float x0 = ptr[i];
+        const float x1 = ptr1[i];
+        outptr[i] = x0 * ctab[i] - x1 * stab[i];
+        outptr1[i] = x1 * ctab[i] + x0 * stab[i];
+    }
+}
+
+#if __ARM_NEON
+// every lane holds one element of another head or another position
+// table_elempack 1 broadcasts the same angle to all lanes, otherwise each lane has its own position
+static void rotary_embed_pack4(const float* ptr, const float* ctab, const float* stab, float* outptr, int half, int table_elempack, int interleaved)
+{
+    for (int i = 0; i < half; i++)
+    {
+        const int i0 = interleaved ? i * 2 : i;
+        const int i1 = interleaved ? i * 2 + 1 : i + half;
+
+        float32x4_t _x0 = vld1q_f32(ptr + i0 * 4);
+        float32x4_t _x1 = vld1q_f32(ptr + i1 * 4);
+        float32x4_t _c = table_elempack == 1 ? vdupq_n_f32(ctab[i]) : vld1q_f32(ctab + i * 4);
+        float32x4_t _s = table_elempack == 1 ? vdupq_n_f32(stab[i]) : vld1q_f32(stab + i * 4);
+        vst1q_f32(outptr + i0 * 4, vmlsq_f32(vmulq_f32(_x0, _c), _x1, _s));
+        vst1q_f32(outptr + i1 * 4, vmlaq_f32(vmulq_f32(_x1, _c), _x0, _s));
+    }
+}
+#endif // __ARM_NEON
+
+int RotaryEmbed_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    Mat bottom_blob = bottom_blobs[0];
+    Mat& top_blob = top_blobs[0];
+
+    if (bottom_blob.dims == 1 && bottom_blob.elempack != 1)
+    {
+        // single position, elements packed along embed_dim
+        Option opt_unpack = opt;
+        opt_unpack.blob_allocator = opt.workspace_allocator;
+        convert_packing(bottom_blobs[0], bottom_blob, 1, opt_unpack);
+        if (bottom_blob.empty())
+            return -100;
+    }
+
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+    const int embed_dim = bottom_blob.w;
+    const int seqlen = dims == 1 ? 1 : (dims == 2 ? bottom_blob.h * elempack : bottom_blob.h);
+    const int num_heads = dims == 3 ? bottom_blob.c : 1;
+
+    if (embed_dim % 2 != 0)
+    {
+        NCNN_LOGE("RotaryEmbed embed_dim %d must be even", embed_dim);
+        return -1;
+    }
+
+    const int half = embed_dim / 2;
+
+    Mat cos_table;
+    Mat sin_table;
+    int ret = make_cos_sin_table(bottom_blobs, embed_dim, seqlen, cos_table, sin_table, opt);
+    if (ret != 0)
+        return ret;
+
+    // positions packed along h need one angle per lane
+    int table_elempack = 1;
+    if (dims == 2 && elempack != 1)
+    {
+        Option opt_pack = opt;
+        opt_pack.blob_allocator = opt.workspace_allocator;
+
+        Mat cos_table_packed;
+        Mat sin_table_packed;
+        convert_packing(cos_table, cos_table_packed, elempack, opt_pack);
+        convert_packing(sin_table, sin_table_packed, elempack, opt_pack);
+        if (cos_table_packed.empty() || sin_table_packed.empty())
+            return -100;
+
+        cos_table = cos_table_packed;
+        sin_table = sin_table_packed;
+        table_elempack = elempack;
+    }
+
+    top_blob.create_like(bottom_blob, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const int rows = dims == 1 ? 1 : bottom_blob.h;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_heads; q++)
+    {
+        const Mat head = dims == 3 ? bottom_blob.channel(q) : bottom_blob;
+        Mat outhead = dims == 3 ? top_blob.channel(q) : top_blob;
+
+        for (int y = 0; y < rows; y++)
+        {
+            const float* ptr = (const float*)head + y * embed_dim * elempack;
+            float* outptr = (float*)outhead + y * embed_dim * elempack;
+            const float* ctab = cos_table.row(y);
+            const float* stab = sin_table.row(y);
+
+#if __ARM_NEON
+            if (elempack == 4)
+            {
+                rotary_embed_pack4(ptr, ctab, stab, outptr, half, table_elempack, interleaved);
+                continue;
+            }
+#endif // __ARM_NEON
+
+            rotary_embed_pack1(ptr, ctab, stab, outptr, half, interleaved);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
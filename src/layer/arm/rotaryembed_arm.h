@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_ROTARYEMBED_ARM_H
+#define LAYER_ROTARYEMBED_ARM_H
+
+#include "rotaryembed.h"
+
+namespace ncnn {
+
+class RotaryEmbed_arm : public RotaryEmbed
+{
+public:
+    RotaryEmbed_arm();
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_ROTARYEMBED_ARM_H
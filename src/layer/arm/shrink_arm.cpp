@@ -0,0 +1,60 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "shrink_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+namespace ncnn {
+
+Shrink_arm::Shrink_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int Shrink_arm::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int d = bottom_top_blob.d;
+    int channels = bottom_top_blob.c;
+    int elempack = bottom_top_blob.elempack;
+    int size = w * h * d * elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __ARM_NEON
+        float32x4_t _lambd = vdupq_n_f32(lambd);
+        float32x4_t _neg_lambd = vdupq_n_f32(-lambd);
+        float32x4_t _bias = vdupq_n_f32(bias);
+        for (; i + 3 < size; i += 4)
+        {
+            float32x4_t _p = vld1q_f32(ptr);
+            uint32x4_t _lo = vcltq_f32(_p, _neg_lambd);
+            uint32x4_t _hi = vcgtq_f32(_p, _lambd);
+            _p = vbslq_f32(_lo, vaddq_f32(_p, _bias), _p);
+            _p = vbslq_f32(_hi, vsubq_f32(_p, _bias), _p);
+            vst1q_f32(ptr, _p);
+
+            ptr += 4;
+        }
+#endif // __ARM_NEON
+        for (; i < size; i++)
+        {
+            *ptr = *ptr < -lambd ? *ptr + bias : *ptr > lambd ? *ptr - bias : *ptr;
+            ptr++;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_SHRINK_ARM_H
+#define LAYER_SHRINK_ARM_H
+
+#include "shrink.h"
+
+namespace ncnn {
+
+class Shrink_arm : public Shrink
+{
+public:
+    Shrink_arm();
+
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_SHRINK_ARM_H
@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_SOFTPLUS_ARM_H
+#define LAYER_SOFTPLUS_ARM_H
+
+#include "softplus.h"
+
+namespace ncnn {
+
+class Softplus_arm : public Softplus
+{
+public:
+    Softplus_arm();
+
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_SOFTPLUS_ARM_H
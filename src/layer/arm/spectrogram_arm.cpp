@@ -0,0 +1,425 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "spectrogram_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include <math.h>
+#include <string.h>
+
+namespace ncnn {
+
+Spectrogram_arm::Spectrogram_arm()
+{
+}
+
+// factor n into stockham stages, radix 4 and 2 first, then odd factors
+// each stage stores m * r twiddles w^(p*k) of its length n followed by the r roots of unity of the radix
+static void spectrogram_fft_plan(int n, int inverse, std::vector<int>& radix, Mat& twiddles)
+{
+    radix.clear();
+
+    int t = n;
+    while (t % 4 == 0)
+    {
+        radix.push_back(4);
+        t /= 4;
+    }
+    while (t % 2 == 0)
+    {
+        radix.push_back(2);
+        t /= 2;
+    }
+    for (int f = 3; f <= t; f += 2)
+    {
+        while (t % f == 0)
+        {
+            radix.push_back(f);
+            t /= f;
+        }
+    }
+
+    const double sign = inverse ? 1.0 : -1.0;
+
+    int twiddles_size = 0;
+    {
+        int len = n;
+        for (size_t i = 0; i < radix.size(); i++)
+        {
+            twiddles_size += (len + radix[i]) * 2;
+            len /= radix[i];
+        }
+    }
+
+    twiddles.create(twiddles_size > 0 ? twiddles_size : 1);
+
+    float* ptr = twiddles;
+    int len = n;
+    for (size_t i = 0; i < radix.size(); i++)
+    {
+        const int r = radix[i];
+        const int m = len / r;
+
+        for (int p = 0; p < m; p++)
+        {
+            for (int k = 0; k < r; k++)
+            {
+                const double angle = sign * 2 * 3.14159265358979323846 * p * k / len;
+                ptr[0] = (float)cos(angle);
+                ptr[1] = (float)sin(angle);
+                ptr += 2;
+            }
+        }
+
+        for (int k = 0; k < r; k++)
+        {
+            const double angle = sign * 2 * 3.14159265358979323846 * k / r;
+            ptr[0] = (float)cos(angle);
+            ptr[1] = (float)sin(angle);
+            ptr += 2;
+        }
+
+        len = m;
+    }
+}
+
+#if __ARM_NEON
+// stockham autosort fft over 4 frames at once
+// x and y hold n complex values, each as 4 re lanes followed by 4 im lanes
+// returns the buffer holding the result in natural order
+static float* spectrogram_fft_pack4(float* x, float* y, int n, const std::vector<int>& radix, const Mat& twiddles, int inverse)
+{
+    const float* tw = twiddles;
+
+    int len = n;
+    int s = 1;
+    for (size_t st = 0; st < radix.size(); st++)
+    {
+        const int r = radix[st];
+        const int m = len / r;
+
+        const float* wp = tw;
+        const float* wr = tw + m * r * 2;
+        tw += (len + r) * 2;
+
+        for (int p = 0; p < m; p++)
+        {
+            for (int q = 0; q < s; q++)
+            {
+                const float* a = x + (q + s * p) * 8;
+                float* b = y + (q + s * r * p) * 8;
+
+                const int astep = s * m * 8;
+                const int bstep = s * 8;
+
+                if (r == 2)
+                {
+                    float32x4_t _a0r = vld1q_f32(a);
+                    float32x4_t _a0i = vld1q_f32(a + 4);
+                    float32x4_t _a1r = vld1q_f32(a + astep);
+                    float32x4_t _a1i = vld1q_f32(a + astep + 4);
+
+                    vst1q_f32(b, vaddq_f32(_a0r, _a1r));
+                    vst1q_f32(b + 4, vaddq_f32(_a0i, _a1i));
+                    vst1q_f32(b + bstep, vsubq_f32(_a0r, _a1r));
+                    vst1q_f32(b + bstep + 4, vsubq_f32(_a0i, _a1i));
+                }
+                else if (r == 4)
+                {
+                    float32x4_t _a0r = vld1q_f32(a);
+                    float32x4_t _a0i = vld1q_f32(a + 4);
+                    float32x4_t _a1r = vld1q_f32(a + astep);
+                    float32x4_t _a1i = vld1q_f32(a + astep + 4);
+                    float32x4_t _a2r = vld1q_f32(a + astep * 2);
+                    float32x4_t _a2i = vld1q_f32(a + astep * 2 + 4);
+                    float32x4_t _a3r = vld1q_f32(a + astep * 3);
+                    float32x4_t _a3i = vld1q_f32(a + astep * 3 + 4);
+
+                    float32x4_t _t0r = vaddq_f32(_a0r, _a2r);
+                    float32x4_t _t0i = vaddq_f32(_a0i, _a2i);
+                    float32x4_t _t1r = vsubq_f32(_a0r, _a2r);
+                    float32x4_t _t1i = vsubq_f32(_a0i, _a2i);
+                    float32x4_t _t2r = vaddq_f32(_a1r, _a3r);
+                    float32x4_t _t2i = vaddq_f32(_a1i, _a3i);
+                    float32x4_t _t3r = vsubq_f32(_a1r, _a3r);
+                    float32x4_t _t3i = vsubq_f32(_a1i, _a3i);
+
+                    vst1q_f32(b, vaddq_f32(_t0r, _t2r));
+                    vst1q_f32(b + 4, vaddq_f32(_t0i, _t2i));
+                    vst1q_f32(b + bstep * 2, vsubq_f32(_t0r, _t2r));
+                    vst1q_f32(b + bstep * 2 + 4, vsubq_f32(_t0i, _t2i));
+
+                    // forward multiplies t3 by -i, inverse by +i
+                    float32x4_t _b1r = inverse ? vsubq_f32(_t1r, _t3i) : vaddq_f32(_t1r, _t3i);
+                    float32x4_t _b1i = inverse ? vaddq_f32(_t1i, _t3r) : vsubq_f32(_t1i, _t3r);
+                    float32x4_t _b3r = inverse ? vaddq_f32(_t1r, _t3i) : vsubq_f32(_t1r, _t3i);
+                    float32x4_t _b3i = inverse ? vsubq_f32(_t1i, _t3r) : vaddq_f32(_t1i, _t3r);
+
+                    vst1q_f32(b + bstep, _b1r);
+                    vst1q_f32(b + bstep + 4, _b1i);
+                    vst1q_f32(b + bstep * 3, _b3r);
+                    vst1q_f32(b + bstep * 3 + 4, _b3i);
+                }
+                else
+                {
+                    // generic odd radix dft
+                    for (int k = 0; k < r; k++)
+                    {
+                        float32x4_t _sumr = vdupq_n_f32(0.f);
+                        float32x4_t _sumi = vdupq_n_f32(0.f);
+                        for (int j = 0; j < r; j++)
+                        {
+                            const float* w = wr + (j * k % r) * 2;
+                            float32x4_t _wr = vdupq_n_f32(w[0]);
+                            float32x4_t _wi = vdupq_n_f32(w[1]);
+                            float32x4_t _ar = vld1q_f32(a + astep * j);
+                            float32x4_t _ai = vld1q_f32(a + astep * j + 4);
+                            _sumr = vaddq_f32(_sumr, vsubq_f32(vmulq_f32(_ar, _wr), vmulq_f32(_ai, _wi)));
+                            _sumi = vaddq_f32(_sumi, vaddq_f32(vmulq_f32(_ar, _wi), vmulq_f32(_ai, _wr)));
+                        }
+                        vst1q_f32(b + bstep * k, _sumr);
+                        vst1q_f32(b + bstep * k + 4, _sumi);
+                    }
+                }
+
+                // twiddle
+                if (p > 0)
+                {
+                    for (int k = 1; k < r; k++)
+                    {
+                        const float* w = wp + (p * r + k) * 2;
+                        float32x4_t _wr = vdupq_n_f32(w[0]);
+                        float32x4_t _wi = vdupq_n_f32(w[1]);
+                        float32x4_t _br = vld1q_f32(b + bstep * k);
+                        float32x4_t _bi = vld1q_f32(b + bstep * k + 4);
+                        vst1q_f32(b + bstep * k, vsubq_f32(vmulq_f32(_br, _wr), vmulq_f32(_bi, _wi)));
+                        vst1q_f32(b + bstep * k + 4, vaddq_f32(vmulq_f32(_br, _wi), vmulq_f32(_bi, _wr)));
+                    }
+                }
+            }
+        }
+
+        std::swap(x, y);
+        len = m;
+        s *= r;
+    }
+
+    return x;
+}
+#endif // __ARM_NEON
+
+int Spectrogram_arm::create_pipeline(const Option& /*opt*/)
+{
+    spectrogram_fft_plan(n_fft, 0, fft_radix, fft_twiddles);
+
+    return 0;
+}
+
+int Spectrogram_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if __ARM_NEON
+    Mat bottom_blob_bordered = bottom_blob;
+    if (center == 1)
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        if (pad_type == 0)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_CONSTANT, 0.f, opt_b);
+        if (pad_type == 1)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_REPLICATE, 0.f, opt_b);
+        if (pad_type == 2)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_REFLECT, 0.f, opt_b);
+    }
+
+    return forward_frames_arm(bottom_blob_bordered, top_blob, opt);
+#else
+    return Spectrogram::forward(bottom_blob, top_blob, opt);
+#endif // __ARM_NEON
+}
+
+int Spectrogram_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (bottom_blobs.size() == 1)
+    {
+        return forward(bottom_blobs[0], top_blobs[0], opt);
+    }
+
+#if __ARM_NEON
+    // streaming, bottom_blobs[1] holds the samples left over from the previous chunk
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& cache = bottom_blobs[1];
+    const size_t elemsize = bottom_blob.elemsize;
+
+    const int size = cache.w + bottom_blob.w;
+    if (size < n_fft || hoplen >= n_fft)
+    {
+        NCNN_LOGE("Spectrogram streaming needs at least %d samples per call and hoplen < n_fft", n_fft);
+        return -1;
+    }
+
+    Mat signal(size, elemsize, opt.workspace_allocator);
+    if (signal.empty())
+        return -100;
+
+    memcpy(signal, cache, cache.w * elemsize);
+    memcpy((float*)signal + cache.w, bottom_blob, bottom_blob.w * elemsize);
+
+    int ret = forward_frames_arm(signal, top_blobs[0], opt);
+    if (ret != 0)
+        return ret;
+
+    // keep the tail that has not completed a frame yet
+    const int consumed = ((size - n_fft) / hoplen + 1) * hoplen;
+
+    Mat& top_cache = top_blobs[1];
+    top_cache.create(size - consumed, elemsize, opt.blob_allocator);
+    if (top_cache.empty())
+        return -100;
+
+    memcpy(top_cache, (const float*)signal + consumed, (size - consumed) * elemsize);
+
+    return 0;
+#else
+    return Spectrogram::forward(bottom_blobs, top_blobs, opt);
+#endif // __ARM_NEON
+}
+
+int Spectrogram_arm::forward_frames_arm(const Mat& bottom_blob_bordered, Mat& top_blob, const Option& opt) const
+{
+#if __ARM_NEON
+    const int size = bottom_blob_bordered.w;
+
+    const int frames = (size - n_fft) / hoplen + 1;
+    const int freqs_onesided = n_fft / 2 + 1;
+    const int freqs = onesided ? freqs_onesided : n_fft;
+
+    const size_t elemsize = bottom_blob_bordered.elemsize;
+
+    if (power == 0)
+    {
+        top_blob.create(2, frames, freqs, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(frames, freqs, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    float norm = 1.f;
+    if (normalized == 1)
+        norm = 1.f / sqrt(n_fft);
+    if (normalized == 2)
+        norm = window_data[n_fft];
+
+    const int nn_frames = (frames + 3) / 4;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int jj = 0; jj < nn_frames; jj++)
+    {
+        const int j = jj * 4;
+        const int count = std::min(frames - j, 4);
+
+        Mat tmp(n_fft * 8, 2, 4u, opt.workspace_allocator);
+
+        // windowed frames, one frame per lane
+        float* x = tmp.row(0);
+        for (int k = 0; k < n_fft; k++)
+        {
+            const float* ptr = (const float*)bottom_blob_bordered + j * hoplen + k;
+            const float wk = window_data[k];
+
+            for (int l = 0; l < 4; l++)
+            {
+                x[k * 8 + l] = l < count ? ptr[l * hoplen] * wk : 0.f;
+                x[k * 8 + 4 + l] = 0.f;
+            }
+        }
+
+        const float* X = spectrogram_fft_pack4(tmp.row(0), tmp.row(1), n_fft, fft_radix, fft_twiddles, 0);
+
+        float32x4_t _norm = vdupq_n_f32(norm);
+
+        for (int i = 0; i < freqs_onesided; i++)
+        {
+            float32x4_t _re = vmulq_f32(vld1q_f32(X + i * 8), _norm);
+            float32x4_t _im = vmulq_f32(vld1q_f32(X + i * 8 + 4), _norm);
+
+            float re[4];
+            float im[4];
+            vst1q_f32(re, _re);
+            vst1q_f32(im, _im);
+
+            if (power == 0)
+            {
+                // complex as real
+                float* outptr = top_blob.channel(i).row(j);
+                for (int l = 0; l < count; l++)
+                {
+                    outptr[0] = re[l];
+                    outptr[1] = im[l];
+                    outptr += 2;
+                }
+            }
+            else
+            {
+                float mag[4];
+                float32x4_t _mag = vaddq_f32(vmulq_f32(_re, _re), vmulq_f32(_im, _im));
+#if __aarch64__
+                if (power == 1)
+                    _mag = vsqrtq_f32(_mag);
+#endif
+                vst1q_f32(mag, _mag);
+
+                float* outptr = top_blob.row(i) + j;
+                for (int l = 0; l < count; l++)
+                {
+#if __aarch64__
+                    outptr[l] = mag[l];
+#else
+                    outptr[l] = power == 1 ? sqrtf(mag[l]) : mag[l];
+#endif
+                }
+            }
+        }
+    }
+
+    if (!onesided)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = freqs_onesided; i < n_fft; i++)
+        {
+            if (power == 0)
+            {
+                const float* ptr = top_blob.channel(n_fft - i);
+                float* outptr = top_blob.channel(i);
+
+                for (int j = 0; j < frames; j++)
+                {
+                    // complex as real
+                    outptr[0] = ptr[0];
+                    outptr[1] = -ptr[1];
+                    ptr += 2;
+                    outptr += 2;
+                }
+            }
+            else // if (power == 1 || power == 2)
+            {
+                const float* ptr = top_blob.row(n_fft - i);
+                float* outptr = top_blob.row(i);
+
+                memcpy(outptr, ptr, frames * sizeof(float));
+            }
+        }
+    }
+
+    return 0;
+#else
+    return Spectrogram::forward_frames(bottom_blob_bordered, top_blob, opt);
+#endif // __ARM_NEON
+}
+
+} // namespace ncnn
@@ -58,6 +58,9 @@ int Crop::load_param(const ParamDict& pd)
         // NCNN_LOGE("%d %d %d", starts_blob_count, ends_blob_count, axes_blob_count);
         if (starts_blob_count > 1 || ends_blob_count > 1 || axes_blob_count > 1)
             one_blob_only = false;
+
+        if (starts_expression.parse(starts_expr) != 0 || ends_expression.parse(ends_expr) != 0 || axes_expression.parse(axes_expr) != 0)
+            return -1;
     }
 
     return 0;
@@ -665,15 +668,15 @@ int Crop::eval_crop_expr(const std::vector<Mat>& bottom_blobs, int& _woffset, in
     std::vector<int> _starts;
     std::vector<int> _ends;
     std::vector<int> _axes;
-    int er = eval_list_expression(starts_expr, bottom_blobs, _starts);
+    int er = starts_expression.eval(bottom_blobs, _starts);
     if (er != 0)
         return -1;
 
-    er = eval_list_expression(ends_expr, bottom_blobs, _ends);
+    er = ends_expression.eval(bottom_blobs, _ends);
     if (er != 0)
         return -1;
 
-    er = eval_list_expression(axes_expr, bottom_blobs, _axes);
+    er = axes_expression.eval(bottom_blobs, _axes);
     if (er != 0)
         return -1;
 
@@ -4,6 +4,7 @@
 #ifndef LAYER_CROP_H
 #define LAYER_CROP_H
 
+#include "expression.h"
 #include "layer.h"
 
 namespace ncnn {
@@ -55,6 +56,10 @@ public:
     std::string starts_expr;
     std::string ends_expr;
     std::string axes_expr;
+
+    ListExpression starts_expression;
+    ListExpression ends_expression;
+    ListExpression axes_expression;
 };
 
 } // namespace ncnn
@@ -2,6 +2,9 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "einsum.h"
+
+#include "layer_type.h"
+
 #include <string.h>
 
 namespace ncnn {
@@ -10,6 +13,11 @@ Einsum::Einsum()
 {
     one_blob_only = false;
     support_inplace = false;
+
+    lowering_type = 0;
+
+    gemm = 0;
+    reduction = 0;
 }
 
 int Einsum::load_param(const ParamDict& pd)
@@ -88,6 +96,404 @@ int Einsum::load_param(const ParamDict& pd)
         }
     }
 
+    resolve_lowering();
+
+    return 0;
+}
+
+static bool token_has_repeated_letter(const std::string& token)
+{
+    for (size_t i = 0; i < token.size(); i++)
+    {
+        if (token.find(token[i], i + 1) != std::string::npos)
+            return true;
+    }
+
+    return false;
+}
+
+void Einsum::resolve_lowering()
+{
+    lowering_type = 0;
+
+    if (rhs_token.empty() || token_has_repeated_letter(rhs_token))
+        return;
+
+    for (size_t i = 0; i < lhs_tokens.size(); i++)
+    {
+        if (token_has_repeated_letter(lhs_tokens[i]))
+            return;
+    }
+
+    if (lhs_tokens.size() == 1)
+    {
+        // ijk->ik style, rhs keeps the lhs order with some axes summed out
+        const std::string& a = lhs_tokens[0];
+
+        reduction_axes.clear();
+
+        size_t r = 0;
+        for (size_t s = 0; s < a.size(); s++)
+        {
+            if (r < rhs_token.size() && a[s] == rhs_token[r])
+            {
+                r++;
+                continue;
+            }
+
+            if (rhs_token.find(a[s]) != std::string::npos)
+                return;
+
+            reduction_axes.push_back((int)s);
+        }
+
+        if (r != rhs_token.size() || reduction_axes.empty())
+            return;
+
+        lowering_type = 2;
+        return;
+    }
+
+    if (lhs_tokens.size() != 2)
+        return;
+
+    // bij,bjk->bik style, every letter is either in rhs or contracted between both operands
+    const std::string& a = lhs_tokens[0];
+    const std::string& b = lhs_tokens[1];
+
+    std::string a_only;
+    std::string b_only;
+    batch_token.clear();
+    for (size_t i = 0; i < rhs_token.size(); i++)
+    {
+        const char c = rhs_token[i];
+        const bool in_a = a.find(c) != std::string::npos;
+        const bool in_b = b.find(c) != std::string::npos;
+
+        if (in_a && in_b)
+            batch_token += c;
+        else if (in_a)
+            a_only += c;
+        else if (in_b)
+            b_only += c;
+        else
+            return;
+    }
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (rhs_token.find(a[i]) == std::string::npos && b.find(a[i]) == std::string::npos)
+            return;
+    }
+    for (size_t i = 0; i < b.size(); i++)
+    {
+        if (rhs_token.find(b[i]) == std::string::npos && a.find(b[i]) == std::string::npos)
+            return;
+    }
+
+    // rhs must be grouped as batch + row + col
+    if (rhs_token == batch_token + a_only + b_only)
+    {
+        gemm_x = 0;
+        row_token = a_only;
+        col_token = b_only;
+    }
+    else if (rhs_token == batch_token + b_only + a_only)
+    {
+        gemm_x = 1;
+        row_token = b_only;
+        col_token = a_only;
+    }
+    else
+    {
+        return;
+    }
+
+    const std::string& x = lhs_tokens[gemm_x];
+    const std::string& y = lhs_tokens[1 - gemm_x];
+
+    k_token.clear();
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        if (rhs_token.find(x[i]) == std::string::npos)
+            k_token += x[i];
+    }
+
+    // operands in any other axis order are gathered into batch + row + k and batch + col + k
+    gemm_gather_x = 0;
+    gemm_gather_y = 0;
+    if (x == batch_token + row_token + k_token)
+    {
+        gemm_transA = 0;
+    }
+    else if (x == batch_token + k_token + row_token)
+    {
+        gemm_transA = 1;
+    }
+    else
+    {
+        gemm_transA = 0;
+        gemm_gather_x = 1;
+    }
+
+    if (y == batch_token + k_token + col_token)
+    {
+        gemm_transB = 0;
+    }
+    else if (y == batch_token + col_token + k_token)
+    {
+        gemm_transB = 1;
+    }
+    else
+    {
+        gemm_transB = 1;
+        gemm_gather_y = 1;
+    }
+
+    lowering_type = 1;
+}
+
+int Einsum::create_pipeline(const Option& opt)
+{
+    if (lowering_type == 1)
+    {
+        gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+        ncnn::ParamDict pd;
+        pd.set(2, gemm_transA); // transA
+        pd.set(3, gemm_transB); // transB
+        pd.set(4, 0);           // constantA
+        pd.set(5, 0);           // constantB
+        pd.set(6, 1);           // constantC
+        pd.set(7, 0);           // M
+        pd.set(8, 0);           // N
+        pd.set(9, 0);           // K
+        pd.set(10, -1);         // constant_broadcast_type_C = null
+        pd.set(11, 0);          // output_N1M
+        pd.set(12, 1);          // output_elempack
+
+        gemm->load_param(pd);
+
+        gemm->load_model(ModelBinFromMatArray(0));
+
+        gemm->create_pipeline(opt);
+    }
+
+    if (lowering_type == 2)
+    {
+        reduction = ncnn::create_layer_cpu(ncnn::LayerType::Reduction);
+
+        Mat axes((int)reduction_axes.size());
+        for (size_t i = 0; i < reduction_axes.size(); i++)
+        {
+            ((int*)axes)[i] = reduction_axes[i];
+        }
+
+        ncnn::ParamDict pd;
+        pd.set(0, 0);    // operation = sum
+        pd.set(1, 0);    // reduce_all
+        pd.set(2, 1.f);  // coeff
+        pd.set(3, axes); // axes
+        pd.set(4, 0);    // keepdims
+        pd.set(5, 1);    // fixbug0
+
+        reduction->load_param(pd);
+
+        reduction->load_model(ModelBinFromMatArray(0));
+
+        reduction->create_pipeline(opt);
+    }
+
+    return 0;
+}
+
+int Einsum::destroy_pipeline(const Option& opt)
+{
+    if (gemm)
+    {
+        gemm->destroy_pipeline(opt);
+        delete gemm;
+        gemm = 0;
+    }
+
+    if (reduction)
+    {
+        reduction->destroy_pipeline(opt);
+        delete reduction;
+        reduction = 0;
+    }
+
+    return 0;
+}
+
+static int einsum_axis_size(const Mat& m, int s)
+{
+    // s counts from the outermost axis
+    const int axis = m.dims - 1 - s;
+    if (axis == 0) return m.w;
+    if (axis == 1) return m.h;
+    if (axis == 2) return m.dims == 4 ? m.d : m.c;
+    return m.c;
+}
+
+static size_t einsum_axis_step(const Mat& m, int s)
+{
+    const int axis = m.dims - 1 - s;
+    if (axis == 0) return 1;
+    if (axis == 1) return m.w;
+    if (axis == 2) return m.dims == 4 ? (size_t)m.w * m.h : m.cstep;
+    return m.cstep;
+}
+
+static Mat einsum_reshape(const Mat& m, const std::string& token, const int* letter_sizes, Allocator* allocator)
+{
+    const int dims = (int)token.size();
+
+    int shape[4] = {1, 1, 1, 1};
+    for (int s = 0; s < dims; s++)
+    {
+        shape[dims - 1 - s] = letter_sizes[token[s] - 'i'];
+    }
+
+    if (dims == 1)
+        return m.reshape(shape[0], allocator);
+    if (dims == 2)
+        return m.reshape(shape[0], shape[1], allocator);
+    if (dims == 3)
+        return m.reshape(shape[0], shape[1], shape[2], allocator);
+
+    return m.reshape(shape[0], shape[1], shape[2], shape[3], allocator);
+}
+
+// copy m into a dense buffer with its axes reordered as order, outermost first
+static int einsum_gather(const Mat& m, const std::string& token, const std::string& order, Mat& out, const Option& opt)
+{
+    int size[4] = {1, 1, 1, 1};
+    size_t step[4] = {0, 0, 0, 0};
+
+    const int n = (int)order.size();
+    for (int j = 0; j < n; j++)
+    {
+        const int s = (int)token.find(order[j]);
+        size[4 - n + j] = einsum_axis_size(m, s);
+        step[4 - n + j] = einsum_axis_step(m, s);
+    }
+
+    out.create(size[0] * size[1] * size[2] * size[3], 4u, opt.workspace_allocator);
+    if (out.empty())
+        return -100;
+
+    const float* ptr = m;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < size[0]; q++)
+    {
+        float* outptr = (float*)out + (size_t)q * size[1] * size[2] * size[3];
+
+        for (int z = 0; z < size[1]; z++)
+        {
+            for (int i = 0; i < size[2]; i++)
+            {
+                const float* p = ptr + q * step[0] + z * step[1] + i * step[2];
+
+                for (int j = 0; j < size[3]; j++)
+                {
+                    *outptr++ = p[j * step[3]];
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+int Einsum::forward_gemm(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    int letter_sizes[16];
+    for (int i = 0; i < 16; i++)
+    {
+        letter_sizes[i] = 1;
+    }
+
+    for (size_t b = 0; b < bottom_blobs.size(); b++)
+    {
+        const std::string& lhs_token = lhs_tokens[b];
+        for (size_t s = 0; s < lhs_token.size(); s++)
+        {
+            letter_sizes[lhs_token[s] - 'i'] = einsum_axis_size(bottom_blobs[b], (int)s);
+        }
+    }
+
+    int batch = 1;
+    int M = 1;
+    int N = 1;
+    int K = 1;
+    for (size_t i = 0; i < batch_token.size(); i++) batch *= letter_sizes[batch_token[i] - 'i'];
+    for (size_t i = 0; i < row_token.size(); i++) M *= letter_sizes[row_token[i] - 'i'];
+    for (size_t i = 0; i < col_token.size(); i++) N *= letter_sizes[col_token[i] - 'i'];
+    for (size_t i = 0; i < k_token.size(); i++) K *= letter_sizes[k_token[i] - 'i'];
+
+    const Mat& X = bottom_blobs[gemm_x];
+    const Mat& Y = bottom_blobs[1 - gemm_x];
+
+    // dense batch-major operands
+    Mat X_flat;
+    if (gemm_gather_x)
+    {
+        int ret = einsum_gather(X, lhs_tokens[gemm_x], batch_token + row_token + k_token, X_flat, opt);
+        if (ret != 0)
+            return ret;
+    }
+    else
+    {
+        X_flat = X.reshape(X.w * X.h * X.d * X.c, opt.workspace_allocator);
+    }
+
+    Mat Y_flat;
+    if (gemm_gather_y)
+    {
+        int ret = einsum_gather(Y, lhs_tokens[1 - gemm_x], batch_token + col_token + k_token, Y_flat, opt);
+        if (ret != 0)
+            return ret;
+    }
+    else
+    {
+        Y_flat = Y.reshape(Y.w * Y.h * Y.d * Y.c, opt.workspace_allocator);
+    }
+
+    if (X_flat.empty() || Y_flat.empty())
+        return -100;
+
+    Mat top_blob_gemm;
+    if (batch == 1)
+        top_blob_gemm.create(N, M, 4u, opt.blob_allocator);
+    else
+        top_blob_gemm.create(N, M, batch, 4u, opt.blob_allocator);
+    if (top_blob_gemm.empty())
+        return -100;
+
+    for (int p = 0; p < batch; p++)
+    {
+        float* xptr = (float*)X_flat + (size_t)p * M * K;
+        float* yptr = (float*)Y_flat + (size_t)p * N * K;
+
+        std::vector<Mat> _bottom_blobs(2);
+        _bottom_blobs[0] = gemm_transA ? Mat(M, K, xptr) : Mat(K, M, xptr);
+        _bottom_blobs[1] = gemm_transB ? Mat(K, N, yptr) : Mat(N, K, yptr);
+        std::vector<Mat> _top_blobs(1);
+        _top_blobs[0] = batch == 1 ? top_blob_gemm : top_blob_gemm.channel(p);
+        int ret = gemm->forward(_bottom_blobs, _top_blobs, opt);
+        if (ret != 0)
+            return ret;
+
+        if (batch == 1)
+            top_blob_gemm = _top_blobs[0];
+    }
+
+    top_blobs[0] = einsum_reshape(top_blob_gemm, rhs_token, letter_sizes, opt.blob_allocator);
+    if (top_blobs[0].empty())
+        return -100;
+
     return 0;
 }
 
@@ -154,7 +560,7 @@ static float sum_dim(const std::vector<int>& dim_sizes, int d, const std::vector
     return sum;
 }
 
-int Einsum::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+int Einsum::forward_generic(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
     // assert bottom_blobs.size() == lhs_tokens.size()
     // assert top_blobs.size() == 1
@@ -324,4 +730,35 @@ int Einsum::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
     return 0;
 }
 
+int Einsum::forward_reduction(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    int ret = reduction->forward(bottom_blobs[0], top_blobs[0], opt);
+    if (ret != 0)
+        return ret;
+
+    // restore the rhs shape
+    int letter_sizes[16];
+    for (size_t s = 0; s < lhs_tokens[0].size(); s++)
+    {
+        letter_sizes[lhs_tokens[0][s] - 'i'] = einsum_axis_size(bottom_blobs[0], (int)s);
+    }
+
+    top_blobs[0] = einsum_reshape(top_blobs[0], rhs_token, letter_sizes, opt.blob_allocator);
+    if (top_blobs[0].empty())
+        return -100;
+
+    return 0;
+}
+
+int Einsum::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (gemm)
+        return forward_gemm(bottom_blobs, top_blobs, opt);
+
+    if (reduction)
+        return forward_reduction(bottom_blobs, top_blobs, opt);
+
+    return forward_generic(bottom_blobs, top_blobs, opt);
+}
+
 } // namespace ncnn
@@ -15,12 +15,47 @@ public:
 
     virtual int load_param(const ParamDict& pd);
 
+    virtual int create_pipeline(const Option& opt);
+
+    virtual int destroy_pipeline(const Option& opt);
+
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
+protected:
+    void resolve_lowering();
+
+    int forward_gemm(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+    int forward_reduction(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+    int forward_generic(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
 public:
     // equation tokens
     std::vector<std::string> lhs_tokens;
     std::string rhs_token;
+
+    // 0=generic 1=gemm 2=reduction
+    int lowering_type;
+
+    // gemm lowering, out = batch + row + col, contracted over k
+    // operand gemm_x provides rows and the other one provides columns
+    int gemm_x;
+    int gemm_transA;
+    int gemm_transB;
+    int gemm_gather_x;
+    int gemm_gather_y;
+    std::string batch_token;
+    std::string row_token;
+    std::string col_token;
+    std::string k_token;
+
+    // reduction lowering, sum over the lhs axes absent in rhs
+    std::vector<int> reduction_axes;
+
+    // the lowered layers, created for the current cpu
+    Layer* gemm;
+    Layer* reduction;
 };
 
 } // namespace ncnn
@@ -32,6 +32,8 @@ int Gemm::load_param(const ParamDict& pd)
     constant_TILE_M = pd.get(20, 0);
     constant_TILE_N = pd.get(21, 0);
     constant_TILE_K = pd.get(22, 0);
+    weight_quant_bits = pd.get(23, 0);
+    weight_quant_group_size = pd.get(24, 0);
 
     if (int8_scale_term)
     {
@@ -53,6 +55,27 @@ int Gemm::load_param(const ParamDict& pd)
         return -1;
     }
 
+    if (weight_quant_bits)
+    {
+        if (weight_quant_bits != 4 && weight_quant_bits != 8)
+        {
+            NCNN_LOGE("Gemm weight_quant_bits %d not supported", weight_quant_bits);
+            return -1;
+        }
+
+        if (constantB != 1 || transB != 1 || int8_scale_term)
+        {
+            NCNN_LOGE("Gemm weight_quant_bits requires constantB and transB without int8_scale_term");
+            return -1;
+        }
+
+        if (weight_quant_group_size <= 0 || weight_quant_group_size % 16 != 0 || constantK % weight_quant_group_size != 0)
+        {
+            NCNN_LOGE("Gemm weight_quant_group_size %d must be a multiple of 16 dividing constantK %d", weight_quant_group_size, constantK);
+            return -1;
+        }
+    }
+
     if (constantC == 1 && (constant_broadcast_type_C < -1 || constant_broadcast_type_C > 4))
     {
         NCNN_LOGE("constant_broadcast_type_C must be -1 or 0~4 when constantC enabled");
@@ -91,6 +114,25 @@ int Gemm::load_model(const ModelBin& mb)
             B_data = mb.load(constantK, constantN, 0);
         if (B_data.empty())
             return -100;
+
+        if (weight_quant_bits)
+        {
+            if (B_data.elemsize != (size_t)1u)
+            {
+                NCNN_LOGE("Gemm weight_quant_bits %d expects int8 or int4 B data", weight_quant_bits);
+                return -1;
+            }
+
+            const int num_group = constantK / weight_quant_group_size;
+
+            B_data_quant_scales = mb.load(num_group, constantN, 1);
+            if (B_data_quant_scales.empty())
+                return -100;
+
+            B_data_quant_zeros = mb.load(num_group, constantN, 1);
+            if (B_data_quant_zeros.empty())
+                return -100;
+        }
     }
 
     if (constantC == 1 && constant_broadcast_type_C != -1)
@@ -296,6 +338,30 @@ int Gemm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_bl
 
     size_t elemsize = A0.elemsize;
 
+    Mat B0_dequantized;
+    if (weight_quant_bits)
+    {
+        // dequantize the grouped constant B
+        B0_dequantized.create(constantK, constantN, 4u, opt.workspace_allocator);
+        if (B0_dequantized.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < constantN; i++)
+        {
+            const signed char* ptr = (const signed char*)B_data + i * constantK;
+            const float* scales = B_data_quant_scales.row(i);
+            const float* zeros = B_data_quant_zeros.row(i);
+            float* outptr = B0_dequantized.row(i);
+
+            for (int j = 0; j < constantK; j++)
+            {
+                const int g = j / weight_quant_group_size;
+                outptr[j] = (ptr[j] - zeros[g]) * scales[g];
+            }
+        }
+    }
+
     Mat A;
     if (transA == 0)
     {
@@ -337,7 +403,7 @@ int Gemm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_bl
     }
     else
     {
-        BT = B0;
+        BT = weight_quant_bits ? B0_dequantized : B0;
     }
 
     const int M = A.dims == 3 ? A.c : A.h;
@@ -46,6 +46,10 @@ public:
 
     int int8_scale_term;
 
+    // weight only quantization of constant B, 0=none 4=int4 8=int8
+    int weight_quant_bits;
+    int weight_quant_group_size;
+
     int constant_TILE_M;
     int constant_TILE_N;
     int constant_TILE_K;
@@ -59,6 +63,10 @@ public:
     Mat A_data_int8_scales;
     float B_data_int8_scale;
 #endif
+
+    // per N per K group, b = (q - zero) * scale
+    Mat B_data_quant_scales;
+    Mat B_data_quant_zeros;
 };
 
 } // namespace ncnn
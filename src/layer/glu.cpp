@@ -201,6 +201,72 @@ int GLU::forward(const Mat& bottom_blob, Mat& top_blob,
         return 0;
     } // if (dims == 3 && positive_axis == 2)
 
+    if (dims == 4 && positive_axis == 0)
+    {
+        int w = bottom_blob.w;
+        int h = bottom_blob.h;
+        int d = bottom_blob.d;
+        int c = bottom_blob.c;
+
+        int out_c = c / 2;
+
+        top_blob.create(w, h, d, out_c, sizeof(float), opt.blob_allocator);
+
+        int offset = out_c * bottom_blob.cstep;
+        int size = w * h * d;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < out_c; ++q)
+        {
+            const float* in_ptr = bottom_blob.channel(q);
+            float* out_ptr = top_blob.channel(q);
+
+            for (int i = 0; i < size; ++i)
+            {
+                float sigmoid = 1.f / (1.f + expf(-in_ptr[i + offset]));
+                out_ptr[i] = in_ptr[i] * sigmoid;
+            }
+        }
+        return 0;
+    } // if (dims == 4 && positive_axis == 0)
+
+    if (dims == 4)
+    {
+        int w = bottom_blob.w;
+        int h = bottom_blob.h;
+        int d = bottom_blob.d;
+        int c = bottom_blob.c;
+
+        int out_w = positive_axis == 3 ? w / 2 : w;
+        int out_h = positive_axis == 2 ? h / 2 : h;
+        int out_d = positive_axis == 1 ? d / 2 : d;
+
+        top_blob.create(out_w, out_h, out_d, c, sizeof(float), opt.blob_allocator);
+
+        // outer x [half | half] within each channel
+        int outer = positive_axis == 1 ? 1 : positive_axis == 2 ? d : d * h;
+        int offset = out_w * out_h * out_d / outer;
+        int stride = w * h * d / outer;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < c; ++q)
+        {
+            const float* in_ptr = bottom_blob.channel(q);
+            float* out_ptr = top_blob.channel(q);
+            for (int y = 0; y < outer; ++y)
+            {
+                for (int x = 0; x < offset; ++x)
+                {
+                    float sigmoid = 1.f / (1.f + expf(-in_ptr[x + offset]));
+                    out_ptr[x] = in_ptr[x] * sigmoid;
+                }
+                in_ptr += stride;
+                out_ptr += offset;
+            }
+        }
+        return 0;
+    } // if (dims == 4)
+
     return -100;
 }
 
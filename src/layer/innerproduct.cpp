@@ -23,6 +23,30 @@ int InnerProduct::load_param(const ParamDict& pd)
     int8_scale_term = pd.get(8, 0);
     activation_type = pd.get(9, 0);
     activation_params = pd.get(10, Mat());
+    weight_quant_bits = pd.get(11, 0);
+    weight_quant_group_size = pd.get(12, 0);
+
+    if (weight_quant_bits)
+    {
+        if (weight_quant_bits != 4 && weight_quant_bits != 8)
+        {
+            NCNN_LOGE("InnerProduct weight_quant_bits %d not supported", weight_quant_bits);
+            return -1;
+        }
+
+        const int num_input = weight_data_size / num_output;
+        if (weight_quant_group_size <= 0 || weight_quant_group_size % 16 != 0 || num_input % weight_quant_group_size != 0)
+        {
+            NCNN_LOGE("InnerProduct weight_quant_group_size %d must be a multiple of 16 dividing num_input %d", weight_quant_group_size, num_input);
+            return -1;
+        }
+
+        if (int8_scale_term)
+        {
+            NCNN_LOGE("InnerProduct weight_quant_bits and int8_scale_term are exclusive");
+            return -1;
+        }
+    }
 
     if (int8_scale_term)
     {
@@ -50,6 +74,28 @@ int InnerProduct::load_model(const ModelBin& mb)
             return -100;
     }
 
+    if (weight_quant_bits)
+    {
+        if (weight_data.elemsize != (size_t)1u)
+        {
+            NCNN_LOGE("InnerProduct weight_quant_bits %d expects int8 or int4 weight data", weight_quant_bits);
+            return -1;
+        }
+
+        const int num_input = weight_data_size / num_output;
+        const int num_group = num_input / weight_quant_group_size;
+
+        weight_quant_scales = mb.load(num_group, num_output, 1);
+        if (weight_quant_scales.empty())
+            return -100;
+
+        weight_quant_zeros = mb.load(num_group, num_output, 1);
+        if (weight_quant_zeros.empty())
+            return -100;
+
+        return 0;
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -83,6 +129,11 @@ int InnerProduct::load_model(const ModelBin& mb)
 
 int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (weight_quant_bits)
+    {
+        return forward_weight_quant(bottom_blob, top_blob, opt);
+    }
+
 #if NCNN_INT8
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
@@ -269,4 +320,86 @@ int InnerProduct::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Opti
 }
 #endif // NCNN_INT8
 
+int InnerProduct::forward_weight_quant(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+    int size = w * h;
+
+    if (bottom_blob.dims == 2 && w == num_input)
+    {
+        // gemm
+        top_blob.create(num_output, h, elemsize, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int j = 0; j < h; j++)
+        {
+            const float* m = bottom_blob.row(j);
+            float* outptr = top_blob.row(j);
+
+            for (int p = 0; p < num_output; p++)
+            {
+                const signed char* kptr = (const signed char*)weight_data + w * p;
+                const float* scales = weight_quant_scales.row(p);
+                const float* zeros = weight_quant_zeros.row(p);
+
+                float sum = 0.f;
+
+                if (bias_term)
+                    sum = bias_data[p];
+
+                for (int i = 0; i < w; i++)
+                {
+                    const int g = i / weight_quant_group_size;
+                    sum += m[i] * ((kptr[i] - zeros[g]) * scales[g]);
+                }
+
+                outptr[p] = activation_ss(sum, activation_type, activation_params);
+            }
+        }
+
+        return 0;
+    }
+
+    top_blob.create(num_output, elemsize, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // num_output
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < num_output; p++)
+    {
+        const float* scales = weight_quant_scales.row(p);
+        const float* zeros = weight_quant_zeros.row(p);
+
+        float sum = 0.f;
+
+        if (bias_term)
+            sum = bias_data[p];
+
+        // channels
+        for (int q = 0; q < channels; q++)
+        {
+            const signed char* w = (const signed char*)weight_data + size * channels * p + size * q;
+            const float* m = bottom_blob.channel(q);
+
+            for (int i = 0; i < size; i++)
+            {
+                const int g = (size * q + i) / weight_quant_group_size;
+                sum += m[i] * ((w[i] - zeros[g]) * scales[g]);
+            }
+        }
+
+        top_blob[p] = activation_ss(sum, activation_type, activation_params);
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
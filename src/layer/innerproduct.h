@@ -23,6 +23,7 @@ protected:
 #if NCNN_INT8
     int forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #endif
+    int forward_weight_quant(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
 public:
     // param
@@ -37,6 +38,10 @@ public:
     int activation_type;
     Mat activation_params;
 
+    // weight only quantization, 0=none 4=int4 8=int8
+    int weight_quant_bits;
+    int weight_quant_group_size;
+
     // model
     Mat weight_data;
     Mat bias_data;
@@ -45,6 +50,10 @@ public:
     Mat weight_data_int8_scales;
     Mat bottom_blob_int8_scales;
 #endif
+
+    // per output per group, w = (q - zero) * scale
+    Mat weight_quant_scales;
+    Mat weight_quant_zeros;
 };
 
 } // namespace ncnn
@@ -42,6 +42,9 @@ int Interp::load_param(const ParamDict& pd)
         const int blob_count = count_expression_blobs(size_expr);
         if (blob_count > 1)
             one_blob_only = false;
+
+        if (size_expression.parse(size_expr) != 0)
+            return -1;
     }
 
     return 0;
@@ -682,7 +685,7 @@ int Interp::eval_size_expr(const std::vector<Mat>& bottom_blobs, int& outw, int&
 {
     // [size(@0,0),size(@0,1)]
     std::vector<int> sizes;
-    int er = eval_list_expression(size_expr, bottom_blobs, sizes);
+    int er = size_expression.eval(bottom_blobs, sizes);
     if (er != 0)
         return -1;
 
@@ -4,6 +4,7 @@
 #ifndef LAYER_INTERP_H
 #define LAYER_INTERP_H
 
+#include "expression.h"
 #include "layer.h"
 
 namespace ncnn {
@@ -34,6 +35,8 @@ public:
 
     // see docs/developer-guide/expression.md
     std::string size_expr;
+
+    ListExpression size_expression;
 };
 
 } // namespace ncnn
@@ -7,7 +7,7 @@ namespace ncnn {
 
 InverseSpectrogram::InverseSpectrogram()
 {
-    one_blob_only = true;
+    one_blob_only = false;
     support_inplace = false;
 }
 
@@ -82,15 +82,101 @@ int InverseSpectrogram::forward(const Mat& bottom_blob, Mat& top_blob, const Opt
     // TODO output length
 
     const int frames = bottom_blob.h;
-    const int freqs = bottom_blob.c;
-    // assert freqs == n_fft or freqs == n_fft / 2 + 1
-
-    const int onesided = freqs == n_fft / 2 + 1 ? 1 : 0;
 
     const int outsize = center ? (frames - 1) * hoplen + (n_fft - n_fft / 2 * 2) : (frames - 1) * hoplen + n_fft;
 
     const size_t elemsize = bottom_blob.elemsize;
 
+    Mat signal;
+    Mat window_sumsquare;
+    int ret = overlap_add(bottom_blob, signal, window_sumsquare, opt);
+    if (ret != 0)
+        return ret;
+
+    if (returns == 0)
+    {
+        top_blob.create(2, outsize, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(outsize, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    const int offset = center == 1 ? n_fft / 2 : 0;
+
+    // square window norm
+    for (int i = 0; i < outsize; i++)
+    {
+        const float* ptr = signal.row(i + offset);
+        const float wss = window_sumsquare[i + offset];
+
+        float re = ptr[0];
+        float im = ptr[1];
+        if (wss != 0.f)
+        {
+            re /= wss;
+            im /= wss;
+        }
+
+        if (returns == 0)
+        {
+            top_blob.row(i)[0] = re;
+            top_blob.row(i)[1] = im;
+        }
+        if (returns == 1)
+        {
+            top_blob[i] = re;
+        }
+        if (returns == 2)
+        {
+            top_blob[i] = im;
+        }
+    }
+
+    return 0;
+}
+
+int InverseSpectrogram::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (bottom_blobs.size() == 1)
+    {
+        return forward(bottom_blobs[0], top_blobs[0], opt);
+    }
+
+    // streaming, bottom_blobs[1] holds the pending overlap as (re, im, window square) x (n_fft - hoplen)
+    // start with zeros, center is not applied and the caller drops the first n_fft/2 samples
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& cache = bottom_blobs[1];
+    const size_t elemsize = bottom_blob.elemsize;
+
+    const int frames = bottom_blob.h;
+    const int overlap = n_fft - hoplen;
+    if (overlap <= 0 || cache.w != 3 || cache.h != overlap)
+    {
+        NCNN_LOGE("InverseSpectrogram streaming needs hoplen < n_fft and a 3 x %d overlap cache", overlap);
+        return -1;
+    }
+
+    Mat signal;
+    Mat window_sumsquare;
+    int ret = overlap_add(bottom_blob, signal, window_sumsquare, opt);
+    if (ret != 0)
+        return ret;
+
+    for (int i = 0; i < overlap; i++)
+    {
+        const float* ptr = cache.row(i);
+        signal.row(i)[0] += ptr[0];
+        signal.row(i)[1] += ptr[1];
+        window_sumsquare[i] += ptr[2];
+    }
+
+    // every frame that touches the first frames * hoplen samples has arrived
+    const int outsize = frames * hoplen;
+
+    Mat& top_blob = top_blobs[0];
     if (returns == 0)
     {
         top_blob.create(2, outsize, elemsize, opt.blob_allocator);
@@ -102,11 +188,71 @@ int InverseSpectrogram::forward(const Mat& bottom_blob, Mat& top_blob, const Opt
     if (top_blob.empty())
         return -100;
 
-    Mat window_sumsquare(outsize + n_fft, elemsize, opt.workspace_allocator);
+    for (int i = 0; i < outsize; i++)
+    {
+        const float* ptr = signal.row(i);
+        const float wss = window_sumsquare[i];
+
+        float re = ptr[0];
+        float im = ptr[1];
+        if (wss != 0.f)
+        {
+            re /= wss;
+            im /= wss;
+        }
+
+        if (returns == 0)
+        {
+            top_blob.row(i)[0] = re;
+            top_blob.row(i)[1] = im;
+        }
+        if (returns == 1)
+        {
+            top_blob[i] = re;
+        }
+        if (returns == 2)
+        {
+            top_blob[i] = im;
+        }
+    }
+
+    Mat& top_cache = top_blobs[1];
+    top_cache.create(3, overlap, elemsize, opt.blob_allocator);
+    if (top_cache.empty())
+        return -100;
+
+    for (int i = 0; i < overlap; i++)
+    {
+        float* outptr = top_cache.row(i);
+        outptr[0] = signal.row(outsize + i)[0];
+        outptr[1] = signal.row(outsize + i)[1];
+        outptr[2] = window_sumsquare[outsize + i];
+    }
+
+    return 0;
+}
+
+int InverseSpectrogram::overlap_add(const Mat& bottom_blob, Mat& signal, Mat& window_sumsquare, const Option& opt) const
+{
+    const int frames = bottom_blob.h;
+    const int freqs = bottom_blob.c;
+    // assert freqs == n_fft or freqs == n_fft / 2 + 1
+
+    const int onesided = freqs == n_fft / 2 + 1 ? 1 : 0;
+
+    const int size = (frames - 1) * hoplen + n_fft;
+
+    const size_t elemsize = bottom_blob.elemsize;
+
+    signal.create(2, size, elemsize, opt.workspace_allocator);
+    if (signal.empty())
+        return -100;
+
+    window_sumsquare.create(size, elemsize, opt.workspace_allocator);
     if (window_sumsquare.empty())
         return -100;
 
-    top_blob.fill(0.f);
+    signal.fill(0.f);
     window_sumsquare.fill(0.f);
 
     for (int j = 0; j < frames; j++)
@@ -173,51 +319,13 @@ int InverseSpectrogram::forward(const Mat& bottom_blob, Mat& top_blob, const Opt
             re *= window_data[i];
             im *= window_data[i];
 
-            int output_index = j * hoplen + i;
-            if (center == 1)
-            {
-                output_index -= n_fft / 2;
-            }
-            if (output_index >= 0 && output_index < outsize)
-            {
-                // square window
-                window_sumsquare[output_index] += window_data[i] * window_data[i];
-
-                if (returns == 0)
-                {
-                    top_blob.row(output_index)[0] += re;
-                    top_blob.row(output_index)[1] += im;
-                }
-                if (returns == 1)
-                {
-                    top_blob[output_index] += re;
-                }
-                if (returns == 2)
-                {
-                    top_blob[output_index] += im;
-                }
-            }
-        }
-    }
+            const int output_index = j * hoplen + i;
 
-    // square window norm
-    if (returns == 0)
-    {
-        for (int i = 0; i < outsize; i++)
-        {
-            if (window_sumsquare[i] != 0.f)
-            {
-                top_blob.row(i)[0] /= window_sumsquare[i];
-                top_blob.row(i)[1] /= window_sumsquare[i];
-            }
-        }
-    }
-    else
-    {
-        for (int i = 0; i < outsize; i++)
-        {
-            if (window_sumsquare[i] != 0.f)
-                top_blob[i] /= window_sumsquare[i];
+            // square window
+            window_sumsquare[output_index] += window_data[i] * window_data[i];
+
+            signal.row(output_index)[0] += re;
+            signal.row(output_index)[1] += im;
         }
     }
 
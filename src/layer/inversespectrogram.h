@@ -17,6 +17,11 @@ public:
 
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+protected:
+    int overlap_add(const Mat& bottom_blob, Mat& signal, Mat& window_sumsquare, const Option& opt) const;
+
 public:
     int n_fft;
     int returns; // 0=complex 1=real 2=imag
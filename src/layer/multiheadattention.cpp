@@ -3,6 +3,8 @@
 
 #include "multiheadattention.h"
 
+#include "atomicops.h"
+
 #include <float.h>
 
 namespace ncnn {
@@ -20,8 +22,15 @@ int MultiHeadAttention::load_param(const ParamDict& pd)
     vdim = pd.get(4, embed_dim);
     attn_mask = pd.get(5, 0);
     scale = pd.get(6, 1.f / sqrtf(embed_dim / num_heads));
+    kv_cache = pd.get(7, 0);
     int8_scale_term = pd.get(18, 0);
 
+    if (kv_cache && int8_scale_term)
+    {
+        NCNN_LOGE("MultiHeadAttention kv_cache with int8 is not supported");
+        return -1;
+    }
+
     return 0;
 }
 
@@ -84,13 +93,18 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
     }
 #endif
 
+    // q [k] [v] [attn_mask] [cache_k cache_v]
+    const size_t input_blob_count = kv_cache ? bottom_blobs.size() - 2 : bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_blob_count == 1 || (input_blob_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_blob_count == 1 || (input_blob_count == 2 && attn_mask)) ? q_blob : (input_blob_count == 2 || (input_blob_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_blob_count - 1] : Mat();
+
+    const int past_seqlen = kv_cache ? bottom_blobs[input_blob_count].h : 0;
 
     const int src_seqlen = q_blob.h;
-    const int dst_seqlen = k_blob.h;
+    const int dst_seqlen = past_seqlen + k_blob.h;
     const int embed_dim_per_head = embed_dim / num_heads;
     const int qdim = weight_data_size / embed_dim;
 
@@ -101,6 +115,64 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
     if (top_blob.empty())
         return -100;
 
+    if (kv_cache)
+    {
+        // cache_k cache_v hold affine(k) affine(v) of all tokens so far, one token per row
+        // append the new tokens so that only they are projected
+        const Mat& cache_k_blob = bottom_blobs[input_blob_count];
+        const Mat& cache_v_blob = bottom_blobs[input_blob_count + 1];
+
+        Mat& top_cache_k = top_blobs[1];
+        Mat& top_cache_v = top_blobs[2];
+        top_cache_k.create(embed_dim, dst_seqlen, 1, 4u, opt.blob_allocator);
+        if (top_cache_k.empty())
+            return -100;
+        top_cache_v.create(embed_dim, dst_seqlen, 1, 4u, opt.blob_allocator);
+        if (top_cache_v.empty())
+            return -100;
+
+        if (past_seqlen > 0)
+        {
+            memcpy(top_cache_k, cache_k_blob, embed_dim * past_seqlen * sizeof(float));
+            memcpy(top_cache_v, cache_v_blob, embed_dim * past_seqlen * sizeof(float));
+        }
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < dst_seqlen - past_seqlen; i++)
+        {
+            float* outptr_k = top_cache_k.row(past_seqlen + i);
+            float* outptr_v = top_cache_v.row(past_seqlen + i);
+
+            for (int j = 0; j < embed_dim; j++)
+            {
+                const float* ptr = k_blob.row(i);
+                const float* kptr = (const float*)k_weight_data + kdim * j;
+
+                float sum = k_bias_data[j];
+                for (int k = 0; k < kdim; k++)
+                {
+                    sum += *ptr++ * *kptr++;
+                }
+
+                outptr_k[j] = sum;
+            }
+
+            for (int j = 0; j < embed_dim; j++)
+            {
+                const float* ptr = v_blob.row(i);
+                const float* kptr = (const float*)v_weight_data + vdim * j;
+
+                float sum = v_bias_data[j];
+                for (int k = 0; k < vdim; k++)
+                {
+                    sum += *ptr++ * *kptr++;
+                }
+
+                outptr_v[j] = sum;
+            }
+        }
+    }
+
     Mat xq(embed_dim_per_head, src_seqlen, num_heads, 4u, opt.workspace_allocator);
     if (xq.empty())
         return -100;
@@ -147,6 +219,22 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
         }
 
         // xk = affine(k)
+        if (kv_cache)
+        {
+            Mat outm = xk.channel(q);
+
+            for (int i = 0; i < dst_seqlen; i++)
+            {
+                const float* ptr = (const float*)top_blobs[1].row(i) + q * embed_dim_per_head;
+                float* outptr = outm.row(i);
+
+                for (int j = 0; j < embed_dim_per_head; j++)
+                {
+                    outptr[j] = ptr[j];
+                }
+            }
+        }
+        else
         {
             Mat outm = xk.channel(q);
 
@@ -171,6 +259,21 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
         }
 
         // xv = affine(v)
+        if (kv_cache)
+        {
+            Mat outm = xv.channel(q);
+
+            for (int i = 0; i < embed_dim_per_head; i++)
+            {
+                float* outptr = outm.row(i);
+
+                for (int j = 0; j < dst_seqlen; j++)
+                {
+                    outptr[j] = top_blobs[2].row(j)[q * embed_dim_per_head + i];
+                }
+            }
+        }
+        else
         {
             Mat outm = xv.channel(q);
 
@@ -323,6 +426,67 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
     return 0;
 }
 
+// kv cache tops are [embed_dim, seqlen, 1] with spare rows behind them in the same channel
+// the last two ints of the channel hold a tag and the number of rows in use, the cache that
+// still ends at that count claims the spare rows with a compare exchange and writes in place,
+// so decoding touches only the new rows while a forked or stale cache falls back to a copy
+#define KV_CACHE_TAG 0x6b76636e
+
+int MultiHeadAttention::append_kv_cache(const Mat& cache_blob, const Mat& affine, Mat& top_cache, const Option& opt) const
+{
+    Mat cache_blob_unpacked = cache_blob;
+    if (!cache_blob.empty() && cache_blob.elempack != 1)
+    {
+        convert_packing(cache_blob, cache_blob_unpacked, 1, opt);
+        if (cache_blob_unpacked.empty())
+            return -100;
+    }
+
+    const int w = affine.w;
+    const int past_seqlen = cache_blob_unpacked.empty() ? 0 : cache_blob_unpacked.h;
+    const int seqlen = past_seqlen + affine.h;
+
+    if (past_seqlen > 0 && cache_blob_unpacked.dims == 3 && cache_blob_unpacked.c == 1 && cache_blob_unpacked.w == w && cache_blob_unpacked.elemsize == 4u && cache_blob_unpacked.refcount)
+    {
+        int* tag = (int*)cache_blob_unpacked.data + cache_blob_unpacked.cstep - 2;
+        const int capacity = (int)((cache_blob_unpacked.cstep - 2) / w);
+
+        if (capacity >= seqlen && tag[0] == KV_CACHE_TAG && atomic_compare_exchange_int(&tag[1], past_seqlen, seqlen))
+        {
+            top_cache = cache_blob_unpacked;
+            top_cache.h = seqlen;
+
+            memcpy(top_cache.row(past_seqlen), affine, (size_t)w * affine.h * sizeof(float));
+
+            return 0;
+        }
+    }
+
+    // grow geometrically, plus the rows that hold the tag
+    const int capacity = std::max(past_seqlen * 2, seqlen + 16);
+    const int tag_rows = (2 + w - 1) / w;
+
+    Mat top_cache_buffer;
+    top_cache_buffer.create(w, capacity + tag_rows, 1, 4u, opt.blob_allocator);
+    if (top_cache_buffer.empty())
+        return -100;
+
+    int* tag = (int*)top_cache_buffer.data + top_cache_buffer.cstep - 2;
+    tag[0] = KV_CACHE_TAG;
+    tag[1] = seqlen;
+
+    top_cache = top_cache_buffer;
+    top_cache.h = seqlen;
+
+    if (past_seqlen > 0)
+    {
+        memcpy(top_cache, cache_blob_unpacked, (size_t)w * past_seqlen * sizeof(float));
+    }
+    memcpy(top_cache.row(past_seqlen), affine, (size_t)w * affine.h * sizeof(float));
+
+    return 0;
+}
+
 #if NCNN_INT8
 static inline signed char float2int8(float v)
 {
@@ -24,6 +24,10 @@ protected:
     int forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 #endif
 
+    // top_cache = rows of cache_blob followed by rows of affine, one token per row
+    // writes only the new rows when cache_blob was produced here with spare rows left
+    int append_kv_cache(const Mat& cache_blob, const Mat& affine, Mat& top_cache, const Option& opt) const;
+
 public:
     int embed_dim;
     int num_heads;
@@ -32,6 +36,7 @@ public:
     int vdim;
     int attn_mask;
     float scale;
+    int kv_cache;
 
     int int8_scale_term;
 
@@ -47,6 +47,10 @@ int Reshape::load_param(const ParamDict& pd)
             return -1;
 
         ndim = (int)outshape.size();
+
+        er = shape_expression.parse(shape_expr);
+        if (er != 0)
+            return -1;
     }
 
     return 0;
@@ -194,7 +198,7 @@ int Reshape::eval_shape_expr(const std::vector<Mat>& bottom_blobs, int& outw, in
 {
     // [size(@0,0),size(@0,1),12,64]
     std::vector<int> shape;
-    int er = eval_list_expression(shape_expr, bottom_blobs, shape);
+    int er = shape_expression.eval(bottom_blobs, shape);
     if (er != 0)
         return -1;
 
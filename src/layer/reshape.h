@@ -4,6 +4,7 @@
 #ifndef LAYER_RESHAPE_H
 #define LAYER_RESHAPE_H
 
+#include "expression.h"
 #include "layer.h"
 
 namespace ncnn {
@@ -35,6 +36,8 @@ public:
 
     // see docs/developer-guide/expression.md
     std::string shape_expr;
+
+    ListExpression shape_expression;
 };
 
 } // namespace ncnn
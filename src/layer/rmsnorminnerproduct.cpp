@@ -0,0 +1,159 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "rmsnorminnerproduct.h"
+
+#include "layer_type.h"
+
+#include "fused_activation.h"
+
+namespace ncnn {
+
+RMSNormInnerProduct::RMSNormInnerProduct()
+{
+    one_blob_only = true;
+    support_inplace = false;
+
+    innerproduct = 0;
+}
+
+int RMSNormInnerProduct::load_param(const ParamDict& pd)
+{
+    num_output = pd.get(0, 0);
+    bias_term = pd.get(1, 0);
+    weight_data_size = pd.get(2, 0);
+    eps = pd.get(3, 0.001f);
+    activation_type = pd.get(9, 0);
+    activation_params = pd.get(10, Mat());
+
+    return 0;
+}
+
+int RMSNormInnerProduct::load_model(const ModelBin& mb)
+{
+    weight_data = mb.load(weight_data_size, 0);
+    if (weight_data.empty())
+        return -100;
+
+    if (bias_term)
+    {
+        bias_data = mb.load(num_output, 1);
+        if (bias_data.empty())
+            return -100;
+    }
+
+    return 0;
+}
+
+int RMSNormInnerProduct::create_pipeline(const Option& _opt)
+{
+    // the row scale is applied on the fp32 output of the plain inner product
+    Option opt = _opt;
+    opt.use_packing_layout = false;
+    opt.use_fp16_storage = false;
+    opt.use_bf16_storage = false;
+
+    innerproduct = ncnn::create_layer_cpu(ncnn::LayerType::InnerProduct);
+
+    ncnn::ParamDict pd;
+    pd.set(0, num_output);
+    pd.set(1, 0); // bias is added after the row scale
+    pd.set(2, weight_data_size);
+
+    innerproduct->load_param(pd);
+
+    ncnn::Mat weights[1];
+    weights[0] = weight_data;
+
+    innerproduct->load_model(ModelBinFromMatArray(weights));
+
+    innerproduct->create_pipeline(opt);
+
+    if (opt.lightmode)
+    {
+        weight_data.release();
+    }
+
+    return 0;
+}
+
+int RMSNormInnerProduct::destroy_pipeline(const Option& _opt)
+{
+    Option opt = _opt;
+    opt.use_packing_layout = false;
+    opt.use_fp16_storage = false;
+    opt.use_bf16_storage = false;
+
+    if (innerproduct)
+    {
+        innerproduct->destroy_pipeline(opt);
+        delete innerproduct;
+        innerproduct = 0;
+    }
+
+    return 0;
+}
+
+int RMSNormInnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& _opt) const
+{
+    // rmsnorm(x) * W^T = (x * W^T) / sqrt(mean(x^2) + eps)
+    // so the normalized x is never written, each output row is scaled instead
+
+    Option opt = _opt;
+    opt.use_packing_layout = false;
+    opt.use_fp16_storage = false;
+    opt.use_bf16_storage = false;
+
+    const int num_input = weight_data_size / num_output;
+
+    // one row per token for [num_input, M], otherwise the whole blob is a single row
+    Mat bottom_blob_rows = bottom_blob;
+    if (bottom_blob.dims != 2)
+    {
+        bottom_blob_rows = bottom_blob.reshape(bottom_blob.w * bottom_blob.h * bottom_blob.d * bottom_blob.c, opt.workspace_allocator);
+        if (bottom_blob_rows.empty())
+            return -100;
+    }
+
+    const int w = bottom_blob_rows.w;
+    const int h = bottom_blob_rows.h;
+
+    if (w != num_input)
+    {
+        NCNN_LOGE("RMSNormInnerProduct expects %d inputs per row, got %d", num_input, w);
+        return -1;
+    }
+
+    int ret = innerproduct->forward(bottom_blob_rows, top_blob, opt);
+    if (ret != 0)
+        return ret;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < h; i++)
+    {
+        const float* ptr = bottom_blob_rows.row(i);
+        float* outptr = top_blob.row(i);
+
+        float sqsum = 0.f;
+        for (int k = 0; k < w; k++)
+        {
+            sqsum += ptr[k] * ptr[k];
+        }
+
+        const float a = 1.f / sqrtf(sqsum / w + eps);
+
+        for (int j = 0; j < num_output; j++)
+        {
+            float sum = outptr[j] * a;
+
+            if (bias_term)
+                sum += bias_data[j];
+
+            outptr[j] = activation_ss(sum, activation_type, activation_params);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,49 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_RMSNORMINNERPRODUCT_H
+#define LAYER_RMSNORMINNERPRODUCT_H
+
+#include "layer.h"
+
+namespace ncnn {
+
+// RMSNorm followed by InnerProduct, with the rmsnorm gamma folded into weight
+class RMSNormInnerProduct : public Layer
+{
+public:
+    RMSNormInnerProduct();
+
+    virtual int load_param(const ParamDict& pd);
+
+    virtual int load_model(const ModelBin& mb);
+
+    virtual int create_pipeline(const Option& opt);
+
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    // param
+    int num_output;
+    int bias_term;
+
+    int weight_data_size;
+
+    float eps;
+
+    // 0=none 1=relu 2=leakyrelu 3=clip 4=sigmoid
+    int activation_type;
+    Mat activation_params;
+
+    // model
+    Mat weight_data;
+    Mat bias_data;
+
+    Layer* innerproduct;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_RMSNORMINNERPRODUCT_H
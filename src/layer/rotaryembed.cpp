@@ -0,0 +1,227 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "rotaryembed.h"
+
+namespace ncnn {
+
+RotaryEmbed::RotaryEmbed()
+{
+    one_blob_only = false;
+    support_inplace = false;
+}
+
+int RotaryEmbed::load_param(const ParamDict& pd)
+{
+    interleaved = pd.get(0, 0);
+    rope_theta = pd.get(1, 10000.f);
+    max_position = pd.get(2, 0);
+    head_dim = pd.get(3, 0);
+
+    return 0;
+}
+
+int RotaryEmbed::create_pipeline(const Option& /*opt*/)
+{
+    if (max_position <= 0 || head_dim <= 0)
+        return 0;
+
+    const int half = head_dim / 2;
+
+    cos_cache.create(half, max_position);
+    sin_cache.create(half, max_position);
+    if (cos_cache.empty() || sin_cache.empty())
+        return -100;
+
+    for (int i = 0; i < half; i++)
+    {
+        const float inv_freq = 1.f / powf(rope_theta, (float)(i * 2) / head_dim);
+
+        for (int p = 0; p < max_position; p++)
+        {
+            const float angle = p * inv_freq;
+            cos_cache.row(p)[i] = cosf(angle);
+            sin_cache.row(p)[i] = sinf(angle);
+        }
+    }
+
+    return 0;
+}
+
+int RotaryEmbed::make_cos_sin_table(const std::vector<Mat>& bottom_blobs, int embed_dim, int seqlen, Mat& cos_table, Mat& sin_table, const Option& opt) const
+{
+    const int half = embed_dim / 2;
+
+    if (bottom_blobs.size() == 3)
+    {
+        // cos sin given as [half or embed_dim, seqlen], shared by all heads
+        Mat cos_blob = bottom_blobs[1];
+        Mat sin_blob = bottom_blobs[2];
+
+        Option opt_unpack = opt;
+        opt_unpack.blob_allocator = opt.workspace_allocator;
+        if (cos_blob.elempack != 1)
+        {
+            convert_packing(bottom_blobs[1], cos_blob, 1, opt_unpack);
+            if (cos_blob.empty())
+                return -100;
+        }
+        if (sin_blob.elempack != 1)
+        {
+            convert_packing(bottom_blobs[2], sin_blob, 1, opt_unpack);
+            if (sin_blob.empty())
+                return -100;
+        }
+
+        const int cos_w = cos_blob.w;
+        const int cos_rows = cos_blob.dims == 1 ? 1 : cos_blob.h;
+        if ((cos_w != half && cos_w != embed_dim) || cos_rows != seqlen || (cos_blob.dims == 3 && cos_blob.c != 1))
+        {
+            NCNN_LOGE("RotaryEmbed cos shape %d %d %d mismatch embed_dim %d seqlen %d", cos_blob.w, cos_blob.h, cos_blob.c, embed_dim, seqlen);
+            return -1;
+        }
+
+        // full width table repeats every angle, take the first half or the even entries
+        const int stride = cos_w == half ? 1 : (interleaved ? 2 : 1);
+
+        cos_table.create(half, seqlen, 4u, opt.workspace_allocator);
+        sin_table.create(half, seqlen, 4u, opt.workspace_allocator);
+        if (cos_table.empty() || sin_table.empty())
+            return -100;
+
+        for (int y = 0; y < seqlen; y++)
+        {
+            const float* cptr = (const float*)cos_blob + y * cos_w;
+            const float* sptr = (const float*)sin_blob + y * cos_w;
+            float* ctab = cos_table.row(y);
+            float* stab = sin_table.row(y);
+
+            for (int i = 0; i < half; i++)
+            {
+                ctab[i] = cptr[i * stride];
+                stab[i] = sptr[i * stride];
+            }
+        }
+
+        return 0;
+    }
+
+    if (!cos_cache.empty() && embed_dim != head_dim)
+    {
+        NCNN_LOGE("RotaryEmbed embed_dim %d mismatch head_dim %d", embed_dim, head_dim);
+        return -1;
+    }
+
+    // position ids as int, or 0 1 2 ... when absent
+    const int* positions = 0;
+    if (bottom_blobs.size() == 2)
+    {
+        const Mat& position_blob = bottom_blobs[1];
+        if ((int)position_blob.total() * position_blob.elempack < seqlen)
+        {
+            NCNN_LOGE("RotaryEmbed position ids count %d less than seqlen %d", (int)position_blob.total() * position_blob.elempack, seqlen);
+            return -1;
+        }
+
+        positions = position_blob;
+    }
+
+    cos_table.create(half, seqlen, 4u, opt.workspace_allocator);
+    sin_table.create(half, seqlen, 4u, opt.workspace_allocator);
+    if (cos_table.empty() || sin_table.empty())
+        return -100;
+
+    for (int y = 0; y < seqlen; y++)
+    {
+        const int p = positions ? positions[y] : y;
+        float* ctab = cos_table.row(y);
+        float* stab = sin_table.row(y);
+
+        if (p >= 0 && p < max_position && !cos_cache.empty())
+        {
+            memcpy(ctab, cos_cache.row(p), half * sizeof(float));
+            memcpy(stab, sin_cache.row(p), half * sizeof(float));
+            continue;
+        }
+
+        for (int i = 0; i < half; i++)
+        {
+            const float inv_freq = 1.f / powf(rope_theta, (float)(i * 2) / embed_dim);
+            const float angle = p * inv_freq;
+            ctab[i] = cosf(angle);
+            stab[i] = sinf(angle);
+        }
+    }
+
+    return 0;
+}
+
+int RotaryEmbed::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    Mat& top_blob = top_blobs[0];
+
+    const int embed_dim = bottom_blob.w;
+    const int seqlen = bottom_blob.dims == 1 ? 1 : bottom_blob.h;
+    const int num_heads = bottom_blob.dims == 3 ? bottom_blob.c : 1;
+
+    if (embed_dim % 2 != 0)
+    {
+        NCNN_LOGE("RotaryEmbed embed_dim %d must be even", embed_dim);
+        return -1;
+    }
+
+    const int half = embed_dim / 2;
+
+    Mat cos_table;
+    Mat sin_table;
+    int ret = make_cos_sin_table(bottom_blobs, embed_dim, seqlen, cos_table, sin_table, opt);
+    if (ret != 0)
+        return ret;
+
+    top_blob.create_like(bottom_blob, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_heads; q++)
+    {
+        const Mat head = bottom_blob.dims == 3 ? bottom_blob.channel(q) : bottom_blob;
+        Mat outhead = top_blob.dims == 3 ? top_blob.channel(q) : top_blob;
+
+        for (int y = 0; y < seqlen; y++)
+        {
+            const float* ptr = (const float*)head + y * embed_dim;
+            float* outptr = (float*)outhead + y * embed_dim;
+            const float* ctab = cos_table.row(y);
+            const float* stab = sin_table.row(y);
+
+            if (interleaved)
+            {
+                // rotate pairs (x0, x1) (x2, x3) ...
+                for (int i = 0; i < half; i++)
+                {
+                    const float x0 = ptr[i * 2];
+                    const float x1 = ptr[i * 2 + 1];
+                    outptr[i * 2] = x0 * ctab[i] - x1 * stab[i];
+                    outptr[i * 2 + 1] = x1 * ctab[i] + x0 * stab[i];
+                }
+            }
+            else
+            {
+                // x * cos + rotate_half(x) * sin
+                for (int i = 0; i < half; i++)
+                {
+                    const float x0 = ptr[i];
+                    const float x1 = ptr[i + half];
+                    outptr[i] = x0 * ctab[i] - x1 * stab[i];
+                    outptr[i + half] = x1 * ctab[i] + x0 * stab[i];
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,39 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_ROTARYEMBED_H
+#define LAYER_ROTARYEMBED_H
+
+#include "layer.h"
+
+namespace ncnn {
+
+class RotaryEmbed : public Layer
+{
+public:
+    RotaryEmbed();
+
+    virtual int load_param(const ParamDict& pd);
+
+    virtual int create_pipeline(const Option& opt);
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+protected:
+    // gather the half width cos sin rows for every position of x, elempack 1
+    int make_cos_sin_table(const std::vector<Mat>& bottom_blobs, int embed_dim, int seqlen, Mat& cos_table, Mat& sin_table, const Option& opt) const;
+
+public:
+    int interleaved;
+    float rope_theta;
+    int max_position;
+    int head_dim;
+
+    // precomputed for positions [0, max_position)
+    Mat cos_cache;
+    Mat sin_cache;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_ROTARYEMBED_H
@@ -7,7 +7,7 @@ namespace ncnn {
 
 Spectrogram::Spectrogram()
 {
-    one_blob_only = true;
+    one_blob_only = false;
     support_inplace = false;
 }
 
@@ -95,6 +95,55 @@ int Spectrogram::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
             copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_REFLECT, 0.f, opt_b);
     }
 
+    return forward_frames(bottom_blob_bordered, top_blob, opt);
+}
+
+int Spectrogram::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (bottom_blobs.size() == 1)
+    {
+        return forward(bottom_blobs[0], top_blobs[0], opt);
+    }
+
+    // streaming, bottom_blobs[1] holds the samples left over from the previous chunk
+    // start with n_fft/2 zeros to match center=1 with constant padding
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& cache = bottom_blobs[1];
+    const size_t elemsize = bottom_blob.elemsize;
+
+    const int size = cache.w + bottom_blob.w;
+    if (size < n_fft || hoplen >= n_fft)
+    {
+        NCNN_LOGE("Spectrogram streaming needs at least %d samples per call and hoplen < n_fft", n_fft);
+        return -1;
+    }
+
+    Mat signal(size, elemsize, opt.workspace_allocator);
+    if (signal.empty())
+        return -100;
+
+    memcpy(signal, cache, cache.w * elemsize);
+    memcpy((float*)signal + cache.w, bottom_blob, bottom_blob.w * elemsize);
+
+    int ret = forward_frames(signal, top_blobs[0], opt);
+    if (ret != 0)
+        return ret;
+
+    // keep the tail that has not completed a frame yet
+    const int consumed = ((size - n_fft) / hoplen + 1) * hoplen;
+
+    Mat& top_cache = top_blobs[1];
+    top_cache.create(size - consumed, elemsize, opt.blob_allocator);
+    if (top_cache.empty())
+        return -100;
+
+    memcpy(top_cache, (const float*)signal + consumed, (size - consumed) * elemsize);
+
+    return 0;
+}
+
+int Spectrogram::forward_frames(const Mat& bottom_blob_bordered, Mat& top_blob, const Option& opt) const
+{
     const int size = bottom_blob_bordered.w;
 
     // const int frames = size / hoplen + 1;
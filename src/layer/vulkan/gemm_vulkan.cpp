@@ -18,7 +18,7 @@ int Gemm_vulkan::load_param(const ParamDict& pd)
 {
     int ret = Gemm::load_param(pd);
 
-    if (int8_scale_term)
+    if (int8_scale_term || weight_quant_bits)
     {
         support_vulkan = false;
     }
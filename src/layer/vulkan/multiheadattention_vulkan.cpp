@@ -35,7 +35,7 @@ int MultiHeadAttention_vulkan::load_param(const ParamDict& pd)
 {
     int ret = MultiHeadAttention::load_param(pd);
 
-    if (int8_scale_term)
+    if (int8_scale_term || kv_cache)
     {
         support_vulkan = false;
     }
@@ -842,4 +842,35 @@ static NCNN_FORCEINLINE __m512 abs512_ps(__m512 x)
     return _mm512_and_ps(abs_mask, x);
 }
 
+static NCNN_FORCEINLINE __m512 erf512_ps(__m512 x)
+{
+    // Abramowitz and Stegun 7.1.26, max abs error 1.5e-7
+    const __m512 magic_negative_zero = _mm512_set1_ps(-0.0f);
+    const __m512 magic_one = _mm512_set1_ps(1.0f);
+    const __m512 magic_p = _mm512_set1_ps(0.3275911f);
+    const __m512 magic_a1 = _mm512_set1_ps(0.254829592f);
+    const __m512 magic_a2 = _mm512_set1_ps(-0.284496736f);
+    const __m512 magic_a3 = _mm512_set1_ps(1.421413741f);
+    const __m512 magic_a4 = _mm512_set1_ps(-1.453152027f);
+    const __m512 magic_a5 = _mm512_set1_ps(1.061405429f);
+
+    __m512 sign = _mm512_and_ps(magic_negative_zero, x);
+    __m512 absolute = _mm512_andnot_ps(magic_negative_zero, x);
+
+    // t = 1 / (1 + p * |x|)
+    __m512 t = _mm512_div_ps(magic_one, _mm512_add_ps(magic_one, _mm512_mul_ps(magic_p, absolute)));
+
+    // y = 1 - (((((a5 * t + a4) * t) + a3) * t + a2) * t + a1) * t * exp(-x * x)
+    __m512 y = _mm512_add_ps(_mm512_mul_ps(magic_a5, t), magic_a4);
+    y = _mm512_add_ps(_mm512_mul_ps(y, t), magic_a3);
+    y = _mm512_add_ps(_mm512_mul_ps(y, t), magic_a2);
+    y = _mm512_add_ps(_mm512_mul_ps(y, t), magic_a1);
+    y = _mm512_mul_ps(y, t);
+
+    __m512 e = exp512_ps(_mm512_xor_ps(magic_negative_zero, _mm512_mul_ps(absolute, absolute)));
+    y = _mm512_sub_ps(magic_one, _mm512_mul_ps(y, e));
+
+    return _mm512_or_ps(y, sign);
+}
+
 #endif // AVX512_MATHFUN_H
@@ -1084,4 +1084,35 @@ static NCNN_FORCEINLINE __m256 abs256_ps(__m256 x)
     return _mm256_and_ps(abs_mask, x);
 }
 
+static NCNN_FORCEINLINE __m256 erf256_ps(__m256 x)
+{
+    // Abramowitz and Stegun 7.1.26, max abs error 1.5e-7
+    const __m256 magic_negative_zero = _mm256_set1_ps(-0.0f);
+    const __m256 magic_one = _mm256_set1_ps(1.0f);
+    const __m256 magic_p = _mm256_set1_ps(0.3275911f);
+    const __m256 magic_a1 = _mm256_set1_ps(0.254829592f);
+    const __m256 magic_a2 = _mm256_set1_ps(-0.284496736f);
+    const __m256 magic_a3 = _mm256_set1_ps(1.421413741f);
+    const __m256 magic_a4 = _mm256_set1_ps(-1.453152027f);
+    const __m256 magic_a5 = _mm256_set1_ps(1.061405429f);
+
+    __m256 sign = _mm256_and_ps(magic_negative_zero, x);
+    __m256 absolute = _mm256_andnot_ps(magic_negative_zero, x);
+
+    // t = 1 / (1 + p * |x|)
+    __m256 t = _mm256_div_ps(magic_one, _mm256_add_ps(magic_one, _mm256_mul_ps(magic_p, absolute)));
+
+    // y = 1 - (((((a5 * t + a4) * t) + a3) * t + a2) * t + a1) * t * exp(-x * x)
+    __m256 y = _mm256_add_ps(_mm256_mul_ps(magic_a5, t), magic_a4);
+    y = _mm256_add_ps(_mm256_mul_ps(y, t), magic_a3);
+    y = _mm256_add_ps(_mm256_mul_ps(y, t), magic_a2);
+    y = _mm256_add_ps(_mm256_mul_ps(y, t), magic_a1);
+    y = _mm256_mul_ps(y, t);
+
+    __m256 e = exp256_ps(_mm256_xor_ps(magic_negative_zero, _mm256_mul_ps(absolute, absolute)));
+    y = _mm256_sub_ps(magic_one, _mm256_mul_ps(y, e));
+
+    return _mm256_or_ps(y, sign);
+}
+
 #endif // AVX_MATHFUN_H
@@ -15,13 +15,22 @@
 #endif // __AVX__
 #endif // __SSE2__
 
+#include "x86_usability.h"
+
 namespace ncnn {
 
+#if NCNN_BF16
+#include "x86_bf16s.h"
+#endif // NCNN_BF16
+
 BinaryOp_x86::BinaryOp_x86()
 {
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 template<typename Op>
@@ -930,6 +939,188 @@ static void binary_op_scalar_inplace(Mat& a, float b, int op_type, const Option&
     }
 }
 
+#if NCNN_BF16
+// bf16 rows go through small fp32 tiles that stay in L1 around the fp32 kernel
+#define BINARYOP_BF16S_TILE_SIZE 256
+
+static void binary_op_vector_bf16s(const unsigned short* ptr, const unsigned short* ptr1, unsigned short* outptr, int aw, int bw, int ap, int bp, int op_type)
+{
+    const int w = std::max(aw, bw);
+    const int elempack = std::max(ap, bp);
+    const int tile_w = BINARYOP_BF16S_TILE_SIZE / elempack;
+
+    float tmp_a[BINARYOP_BF16S_TILE_SIZE];
+    float tmp_b[BINARYOP_BF16S_TILE_SIZE];
+    float tmp_out[BINARYOP_BF16S_TILE_SIZE];
+
+    // single a or b is converted once
+    if (aw == 1) bfloat2float_row(ptr, tmp_a, ap);
+    if (bw == 1) bfloat2float_row(ptr1, tmp_b, bp);
+
+    for (int i = 0; i < w; i += tile_w)
+    {
+        const int n = std::min(tile_w, w - i);
+
+        if (aw != 1) bfloat2float_row(ptr + i * ap, tmp_a, n * ap);
+        if (bw != 1) bfloat2float_row(ptr1 + i * bp, tmp_b, n * bp);
+
+        binary_op_vector(tmp_a, tmp_b, tmp_out, aw == 1 ? 1 : n, bw == 1 ? 1 : n, ap, bp, op_type);
+
+        float2bfloat_row(tmp_out, outptr + i * elempack, n * elempack);
+    }
+}
+
+static void binary_op_vector_scalar_bf16s(const unsigned short* ptr, float b, unsigned short* outptr, int size, int op_type)
+{
+    float tmp[BINARYOP_BF16S_TILE_SIZE];
+
+    for (int i = 0; i < size; i += BINARYOP_BF16S_TILE_SIZE)
+    {
+        const int n = std::min(BINARYOP_BF16S_TILE_SIZE, size - i);
+
+        bfloat2float_row(ptr + i, tmp, n);
+
+        binary_op_vector(tmp, &b, tmp, n, 1, 1, 1, op_type);
+
+        float2bfloat_row(tmp, outptr + i, n);
+    }
+}
+
+static void binary_op_scalar_bf16s(const Mat& a, float b, Mat& c, int op_type, const Option& opt)
+{
+    const int channels = a.c;
+    const int size = a.w * a.h * a.d * a.elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const unsigned short* ptr = a.channel(q);
+        unsigned short* outptr = c.channel(q);
+
+        binary_op_vector_scalar_bf16s(ptr, b, outptr, size, op_type);
+    }
+}
+
+static void binary_op_no_broadcast_bf16s(const Mat& a, const Mat& b, Mat& c, int op_type, const Option& opt)
+{
+    const int channels = a.c;
+    const int size = a.w * a.h * a.d * a.elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const unsigned short* ptr = a.channel(q);
+        const unsigned short* ptr1 = b.channel(q);
+        unsigned short* outptr = c.channel(q);
+
+        binary_op_vector_bf16s(ptr, ptr1, outptr, size, size, 1, 1, op_type);
+    }
+}
+
+static void binary_op_broadcast_bf16s(const Mat& a, const Mat& b, Mat& c, int op_type, const Option& opt)
+{
+    if (b.w * b.h * b.d * b.c * b.elempack == 1)
+    {
+        return binary_op_scalar_bf16s(a, bfloat16_to_float32(((const unsigned short*)b)[0]), c, op_type, opt);
+    }
+
+    if (a.dims == b.dims && a.w == b.w && a.h == b.h && a.d == b.d && a.c == b.c && a.elempack == b.elempack)
+    {
+        return binary_op_no_broadcast_bf16s(a, b, c, op_type, opt);
+    }
+
+    const int dims = c.dims;
+
+    if (dims == 2)
+    {
+        const int h = c.h;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int y = 0; y < h; y++)
+        {
+            const int y0 = std::min(y, a.h - 1);
+            const int y1 = std::min(y, b.h - 1);
+
+            const unsigned short* ptr = a.row<const unsigned short>(y0);
+            const unsigned short* ptr1 = b.row<const unsigned short>(y1);
+            unsigned short* outptr = c.row<unsigned short>(y);
+
+            binary_op_vector_bf16s(ptr, ptr1, outptr, a.w, b.w, a.elempack, b.elempack, op_type);
+        }
+    }
+
+    if (dims == 3 || dims == 4)
+    {
+        const int channels = c.c;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const int q0 = std::min(q, a.c - 1);
+            const int q1 = std::min(q, b.c - 1);
+
+            if (b.d * b.h * b.w == 1)
+            {
+                const unsigned short* ptr = a.channel(q0);
+                const unsigned short* ptr1 = b.channel(q1);
+                unsigned short* outptr = c.channel(q);
+
+                binary_op_vector_bf16s(ptr, ptr1, outptr, a.w * a.h * a.d, 1, a.elempack, b.elempack, op_type);
+                continue;
+            }
+
+            if (b.h * b.w == 1)
+            {
+                for (int z = 0; z < c.d; z++)
+                {
+                    const int z0 = std::min(z, a.d - 1);
+                    const int z1 = std::min(z, b.d - 1);
+
+                    const unsigned short* ptr = a.channel(q0).depth(z0);
+                    const unsigned short* ptr1 = b.channel(q1).depth(z1);
+                    unsigned short* outptr = c.channel(q).depth(z);
+
+                    binary_op_vector_bf16s(ptr, ptr1, outptr, a.w * a.h, 1, a.elempack, b.elempack, op_type);
+                }
+                continue;
+            }
+
+            for (int z = 0; z < c.d; z++)
+            {
+                const int z0 = std::min(z, a.d - 1);
+                const int z1 = std::min(z, b.d - 1);
+
+                for (int y = 0; y < c.h; y++)
+                {
+                    const int y0 = std::min(y, a.h - 1);
+                    const int y1 = std::min(y, b.h - 1);
+
+                    const unsigned short* ptr = a.channel(q0).depth(z0).row<const unsigned short>(y0);
+                    const unsigned short* ptr1 = b.channel(q1).depth(z1).row<const unsigned short>(y1);
+                    unsigned short* outptr = c.channel(q).depth(z).row<unsigned short>(y);
+
+                    binary_op_vector_bf16s(ptr, ptr1, outptr, a.w, b.w, a.elempack, b.elempack, op_type);
+                }
+            }
+        }
+    }
+}
+
+static void binary_op_scalar_inplace_bf16s(Mat& a, float b, int op_type, const Option& opt)
+{
+    const int channels = a.c;
+    const int size = a.w * a.h * a.d * a.elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        unsigned short* ptr = a.channel(q);
+
+        binary_op_vector_scalar_bf16s(ptr, b, ptr, size, op_type);
+    }
+}
+#endif // NCNN_BF16
+
 static int get_reverse_op_type(int op_type)
 {
     if (op_type == BinaryOp::Operation_SUB) return BinaryOp::Operation_RSUB;
@@ -1080,6 +1271,22 @@ int BinaryOp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>
     const bool a_pack_is_lower = A2.elempack < B2.elempack;
     const bool a_pack_is_equal = A2.elempack == B2.elempack;
     const bool a_size_is_lower = A2.w * A2.h * A2.d * A2.c * A2.elempack < B2.w * B2.h * B2.d * B2.c * B2.elempack;
+#if NCNN_BF16
+    if (opt.use_bf16_storage && A2.elembits() == 16 && B2.elembits() == 16)
+    {
+        if (a_pack_is_lower || (a_pack_is_equal && a_size_is_lower))
+        {
+            binary_op_broadcast_bf16s(B2, A2, top_blob, get_reverse_op_type(op_type), opt);
+        }
+        else
+        {
+            binary_op_broadcast_bf16s(A2, B2, top_blob, op_type, opt);
+        }
+
+        return 0;
+    }
+#endif
+
     if (a_pack_is_lower || (a_pack_is_equal && a_size_is_lower))
     {
         binary_op_broadcast(B2, A2, top_blob, get_reverse_op_type(op_type), opt);
@@ -1094,6 +1301,15 @@ int BinaryOp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>
 
 int BinaryOp_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+    {
+        binary_op_scalar_inplace_bf16s(bottom_top_blob, b, op_type, opt);
+
+        return 0;
+    }
+#endif
+
     binary_op_scalar_inplace(bottom_top_blob, b, op_type, opt);
 
     return 0;
@@ -0,0 +1,116 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "celu_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+#if NCNN_BF16
+#include "x86_bf16s.h"
+#endif // NCNN_BF16
+
+CELU_x86::CELU_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int CELU_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+        return layer_forward_inplace_bf16s(this, bottom_top_blob, opt);
+#endif
+
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int d = bottom_top_blob.d;
+    int channels = bottom_top_blob.c;
+    int elempack = bottom_top_blob.elempack;
+    int size = w * h * d * elempack;
+
+    const float alpha_inv = 1.f / alpha;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        __m512 _zero512 = _mm512_setzero_ps();
+        __m512 _one512 = _mm512_set1_ps(1.f);
+        __m512 _alpha512 = _mm512_set1_ps(alpha);
+        __m512 _alpha_inv512 = _mm512_set1_ps(alpha_inv);
+        for (; i + 15 < size; i += 16)
+        {
+            __m512 _p = _mm512_loadu_ps(ptr);
+            __m512 _n = _mm512_mul_ps(_mm512_sub_ps(exp512_ps(_mm512_mul_ps(_p, _alpha_inv512)), _one512), _alpha512);
+            _p = _mm512_mask_mov_ps(_p, _mm512_cmp_ps_mask(_p, _zero512, _CMP_LT_OQ), _n);
+            _mm512_storeu_ps(ptr, _p);
+
+            ptr += 16;
+        }
+#endif // __AVX512F__
+        __m256 _zero256 = _mm256_setzero_ps();
+        __m256 _one256 = _mm256_set1_ps(1.f);
+        __m256 _alpha256 = _mm256_set1_ps(alpha);
+        __m256 _alpha_inv256 = _mm256_set1_ps(alpha_inv);
+        for (; i + 7 < size; i += 8)
+        {
+            __m256 _p = _mm256_loadu_ps(ptr);
+            __m256 _n = _mm256_mul_ps(_mm256_sub_ps(exp256_ps(_mm256_mul_ps(_p, _alpha_inv256)), _one256), _alpha256);
+            _p = _mm256_blendv_ps(_p, _n, _mm256_cmp_ps(_p, _zero256, _CMP_LT_OQ));
+            _mm256_storeu_ps(ptr, _p);
+
+            ptr += 8;
+        }
+#endif // __AVX__
+        __m128 _zero128 = _mm_setzero_ps();
+        __m128 _one128 = _mm_set1_ps(1.f);
+        __m128 _alpha128 = _mm_set1_ps(alpha);
+        __m128 _alpha_inv128 = _mm_set1_ps(alpha_inv);
+        for (; i + 3 < size; i += 4)
+        {
+            __m128 _p = _mm_load_ps(ptr);
+            __m128 _n = _mm_mul_ps(_mm_sub_ps(exp_ps(_mm_mul_ps(_p, _alpha_inv128)), _one128), _alpha128);
+            __m128 _mask = _mm_cmplt_ps(_p, _zero128);
+            _p = _mm_or_ps(_mm_and_ps(_mask, _n), _mm_andnot_ps(_mask, _p));
+            _mm_store_ps(ptr, _p);
+
+            ptr += 4;
+        }
+#endif // __SSE2__
+        for (; i < size; i++)
+        {
+            if (*ptr < 0.f)
+                *ptr = (expf(*ptr * alpha_inv) - 1.f) * alpha;
+            ptr++;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -10,17 +10,32 @@
 #endif // __AVX__
 #endif // __SSE2__
 
+#include "x86_usability.h"
+
 namespace ncnn {
 
+#if NCNN_BF16
+#include "x86_bf16s.h"
+#endif // NCNN_BF16
+
 Clip_x86::Clip_x86()
 {
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 int Clip_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+        return layer_forward_inplace_bf16s(this, bottom_top_blob, opt);
+#endif
+
     int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int d = bottom_top_blob.d;
@@ -316,14 +316,15 @@ static void convolution_im2col_pack_A_tile(const Mat& A, Mat& AT, int i, int max
     }
 }
 
-static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, const Mat& CT_tile, Mat& topT_tile, Mat& top_blob, int i, int max_ii, int j, int max_jj, int k, int max_kk, bool k_end)
+template<typename T, typename TB>
+static void convolution_gemm_transB_packed_tile_impl(const Mat& AT_tile, const Mat& BT_tile, const Mat& CT_tile, Mat& topT_tile, Mat& top_blob, int i, int max_ii, int j, int max_jj, int k, int max_kk, bool k_end)
 {
     // NCNN_LOGE("convolution_gemm_transB_packed_tile %d %d %d %d %d %d", i, max_ii, j, max_jj, k, max_kk);
 
     const int out_elempack = top_blob.elempack;
     const int out_hstep = (int)top_blob.cstep;
 
-    const float* pAT = AT_tile;
+    const T* pAT = AT_tile;
     const float* pBT = BT_tile;
     const float* pC = CT_tile;
 
@@ -335,7 +336,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
 #if __AVX512F__
     for (; ii + 15 < max_ii; ii += 16)
     {
-        float* outptr0 = (float*)top_blob + (i + ii) * out_hstep + j * out_elempack;
+        TB* outptr0 = (TB*)top_blob + (i + ii) * out_hstep + j * out_elempack;
 
         const float* pB = pBT;
 
@@ -348,7 +349,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
 #if defined(__x86_64__) || defined(_M_X64)
         for (; jj + 11 < max_jj; jj += 12)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m512 _sum0;
             __m512 _sum1;
@@ -415,7 +416,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m512 _pA = _mm512_load_ps(pA);
+                __m512 _pA = _mm512_load_weight_ps(pA);
 
                 _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[1]), _sum1);
@@ -438,18 +439,18 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr0, _sum0);
-                    _mm512_store_ps(outptr0 + 16 * 1, _sum1);
-                    _mm512_store_ps(outptr0 + 16 * 2, _sum2);
-                    _mm512_store_ps(outptr0 + 16 * 3, _sum3);
-                    _mm512_store_ps(outptr0 + 16 * 4, _sum4);
-                    _mm512_store_ps(outptr0 + 16 * 5, _sum5);
-                    _mm512_store_ps(outptr0 + 16 * 6, _sum6);
-                    _mm512_store_ps(outptr0 + 16 * 7, _sum7);
-                    _mm512_store_ps(outptr0 + 16 * 8, _sum8);
-                    _mm512_store_ps(outptr0 + 16 * 9, _sum9);
-                    _mm512_store_ps(outptr0 + 16 * 10, _suma);
-                    _mm512_store_ps(outptr0 + 16 * 11, _sumb);
+                    _mm512_store_blob_ps(outptr0, _sum0);
+                    _mm512_store_blob_ps(outptr0 + 16 * 1, _sum1);
+                    _mm512_store_blob_ps(outptr0 + 16 * 2, _sum2);
+                    _mm512_store_blob_ps(outptr0 + 16 * 3, _sum3);
+                    _mm512_store_blob_ps(outptr0 + 16 * 4, _sum4);
+                    _mm512_store_blob_ps(outptr0 + 16 * 5, _sum5);
+                    _mm512_store_blob_ps(outptr0 + 16 * 6, _sum6);
+                    _mm512_store_blob_ps(outptr0 + 16 * 7, _sum7);
+                    _mm512_store_blob_ps(outptr0 + 16 * 8, _sum8);
+                    _mm512_store_blob_ps(outptr0 + 16 * 9, _sum9);
+                    _mm512_store_blob_ps(outptr0 + 16 * 10, _suma);
+                    _mm512_store_blob_ps(outptr0 + 16 * 11, _sumb);
                     outptr0 += 192;
                 }
                 if (out_elempack == 8)
@@ -467,19 +468,19 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     __m512 _tmpa = _mm512_shuffle_f32x4(_sum8, _sum9, _MM_SHUFFLE(3, 2, 3, 2));
                     __m512 _tmpb = _mm512_shuffle_f32x4(_suma, _sumb, _MM_SHUFFLE(3, 2, 3, 2));
 
-                    _mm512_storeu_ps(outptr0, _tmp0);
-                    _mm512_storeu_ps(outptr0 + 16, _tmp1);
-                    _mm512_storeu_ps(outptr0 + 16 * 2, _tmp2);
-                    _mm512_storeu_ps(outptr0 + 16 * 3, _tmp3);
-                    _mm512_storeu_ps(outptr0 + 16 * 4, _tmp4);
-                    _mm512_storeu_ps(outptr0 + 16 * 5, _tmp5);
+                    _mm512_storeu_blob_ps(outptr0, _tmp0);
+                    _mm512_storeu_blob_ps(outptr0 + 16, _tmp1);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 2, _tmp2);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 3, _tmp3);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 4, _tmp4);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 5, _tmp5);
 
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _tmp6);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16, _tmp7);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 2, _tmp8);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 3, _tmp9);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 4, _tmpa);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 5, _tmpb);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _tmp6);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16, _tmp7);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 2, _tmp8);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 3, _tmp9);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 4, _tmpa);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 5, _tmpb);
 
                     outptr0 += 96;
                 }
@@ -511,18 +512,18 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     _suma = _mm512_shuffle_f32x4(_tmpa, _tmpb, _MM_SHUFFLE(2, 0, 2, 0));
                     _sumb = _mm512_shuffle_f32x4(_tmpa, _tmpb, _MM_SHUFFLE(3, 1, 3, 1));
 
-                    _mm512_storeu_ps(outptr0, _sum0);
-                    _mm512_storeu_ps(outptr0 + 16, _sum4);
-                    _mm512_storeu_ps(outptr0 + 32, _sum8);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4, _sum1);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4 + 16, _sum5);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4 + 32, _sum9);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _sum2);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16, _sum6);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 32, _suma);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12, _sum3);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12 + 16, _sum7);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12 + 32, _sumb);
+                    _mm512_storeu_blob_ps(outptr0, _sum0);
+                    _mm512_storeu_blob_ps(outptr0 + 16, _sum4);
+                    _mm512_storeu_blob_ps(outptr0 + 32, _sum8);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4, _sum1);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4 + 16, _sum5);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4 + 32, _sum9);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _sum2);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16, _sum6);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 32, _suma);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12, _sum3);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12 + 16, _sum7);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12 + 32, _sumb);
 
                     outptr0 += 48;
                 }
@@ -530,41 +531,41 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 {
                     transpose16x12_ps(_sum0, _sum1, _sum2, _sum3, _sum4, _sum5, _sum6, _sum7, _sum8, _sum9, _suma, _sumb);
 
-                    _mm256_storeu_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
-                    _mm_storeu_ps(outptr0 + 8, _mm512_extractf32x4_ps(_sum0, 2));
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _mm512_extractf32x4_ps(_sum0, 3));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 1 + 4, _mm512_extractf32x8_ps(_sum1, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 2, _mm512_extractf32x8_ps(_sum1, 1));
-                    _mm_storeu_ps(outptr0 + out_hstep * 2 + 8, _mm512_extractf32x4_ps(_sum2, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _mm512_extractf32x4_ps(_sum2, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 3 + 4, _mm512_extractf32x8_ps(_sum2, 1));
-
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _mm512_extractf32x8_ps(_sum3, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 4 + 8, _mm512_extractf32x4_ps(_sum3, 2));
-                    _mm_storeu_ps(outptr0 + out_hstep * 5, _mm512_extractf32x4_ps(_sum3, 3));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 5 + 4, _mm512_extractf32x8_ps(_sum4, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 6, _mm512_extractf32x8_ps(_sum4, 1));
-                    _mm_storeu_ps(outptr0 + out_hstep * 6 + 8, _mm512_extractf32x4_ps(_sum5, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 7, _mm512_extractf32x4_ps(_sum5, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 7 + 4, _mm512_extractf32x8_ps(_sum5, 1));
-
-                    _mm256_storeu_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum6, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 8 + 8, _mm512_extractf32x4_ps(_sum6, 2));
-                    _mm_storeu_ps(outptr0 + out_hstep * 9, _mm512_extractf32x4_ps(_sum6, 3));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 9 + 4, _mm512_extractf32x8_ps(_sum7, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 10, _mm512_extractf32x8_ps(_sum7, 1));
-                    _mm_storeu_ps(outptr0 + out_hstep * 10 + 8, _mm512_extractf32x4_ps(_sum8, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 11, _mm512_extractf32x4_ps(_sum8, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 11 + 4, _mm512_extractf32x8_ps(_sum8, 1));
-
-                    _mm256_storeu_ps(outptr0 + out_hstep * 12, _mm512_extractf32x8_ps(_sum9, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 12 + 8, _mm512_extractf32x4_ps(_sum9, 2));
-                    _mm_storeu_ps(outptr0 + out_hstep * 13, _mm512_extractf32x4_ps(_sum9, 3));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 13 + 4, _mm512_extractf32x8_ps(_suma, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 14, _mm512_extractf32x8_ps(_suma, 1));
-                    _mm_storeu_ps(outptr0 + out_hstep * 14 + 8, _mm512_extractf32x4_ps(_sumb, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 15, _mm512_extractf32x4_ps(_sumb, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 15 + 4, _mm512_extractf32x8_ps(_sumb, 1));
+                    _mm256_storeu_blob_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
+                    _mm_storeu_blob_ps(outptr0 + 8, _mm512_extractf32x4_ps(_sum0, 2));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _mm512_extractf32x4_ps(_sum0, 3));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 1 + 4, _mm512_extractf32x8_ps(_sum1, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 2, _mm512_extractf32x8_ps(_sum1, 1));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2 + 8, _mm512_extractf32x4_ps(_sum2, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _mm512_extractf32x4_ps(_sum2, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 3 + 4, _mm512_extractf32x8_ps(_sum2, 1));
+
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _mm512_extractf32x8_ps(_sum3, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 4 + 8, _mm512_extractf32x4_ps(_sum3, 2));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 5, _mm512_extractf32x4_ps(_sum3, 3));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 5 + 4, _mm512_extractf32x8_ps(_sum4, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 6, _mm512_extractf32x8_ps(_sum4, 1));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 6 + 8, _mm512_extractf32x4_ps(_sum5, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 7, _mm512_extractf32x4_ps(_sum5, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 7 + 4, _mm512_extractf32x8_ps(_sum5, 1));
+
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum6, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 8 + 8, _mm512_extractf32x4_ps(_sum6, 2));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 9, _mm512_extractf32x4_ps(_sum6, 3));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 9 + 4, _mm512_extractf32x8_ps(_sum7, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 10, _mm512_extractf32x8_ps(_sum7, 1));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 10 + 8, _mm512_extractf32x4_ps(_sum8, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 11, _mm512_extractf32x4_ps(_sum8, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 11 + 4, _mm512_extractf32x8_ps(_sum8, 1));
+
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 12, _mm512_extractf32x8_ps(_sum9, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 12 + 8, _mm512_extractf32x4_ps(_sum9, 2));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 13, _mm512_extractf32x4_ps(_sum9, 3));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 13 + 4, _mm512_extractf32x8_ps(_suma, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 14, _mm512_extractf32x8_ps(_suma, 1));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 14 + 8, _mm512_extractf32x4_ps(_sumb, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 15, _mm512_extractf32x4_ps(_sumb, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 15 + 4, _mm512_extractf32x8_ps(_sumb, 1));
 
                     outptr0 += 12;
                 }
@@ -589,7 +590,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
         }
         for (; jj + 7 < max_jj; jj += 8)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m512 _sum0;
             __m512 _sum1;
@@ -640,7 +641,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m512 _pA = _mm512_load_ps(pA);
+                __m512 _pA = _mm512_load_weight_ps(pA);
 
                 _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[1]), _sum1);
@@ -659,14 +660,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr0, _sum0);
-                    _mm512_store_ps(outptr0 + 16 * 1, _sum1);
-                    _mm512_store_ps(outptr0 + 16 * 2, _sum2);
-                    _mm512_store_ps(outptr0 + 16 * 3, _sum3);
-                    _mm512_store_ps(outptr0 + 16 * 4, _sum4);
-                    _mm512_store_ps(outptr0 + 16 * 5, _sum5);
-                    _mm512_store_ps(outptr0 + 16 * 6, _sum6);
-                    _mm512_store_ps(outptr0 + 16 * 7, _sum7);
+                    _mm512_store_blob_ps(outptr0, _sum0);
+                    _mm512_store_blob_ps(outptr0 + 16 * 1, _sum1);
+                    _mm512_store_blob_ps(outptr0 + 16 * 2, _sum2);
+                    _mm512_store_blob_ps(outptr0 + 16 * 3, _sum3);
+                    _mm512_store_blob_ps(outptr0 + 16 * 4, _sum4);
+                    _mm512_store_blob_ps(outptr0 + 16 * 5, _sum5);
+                    _mm512_store_blob_ps(outptr0 + 16 * 6, _sum6);
+                    _mm512_store_blob_ps(outptr0 + 16 * 7, _sum7);
                     outptr0 += 128;
                 }
                 if (out_elempack == 8)
@@ -680,15 +681,15 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     __m512 _tmp6 = _mm512_shuffle_f32x4(_sum4, _sum5, _MM_SHUFFLE(3, 2, 3, 2));
                     __m512 _tmp7 = _mm512_shuffle_f32x4(_sum6, _sum7, _MM_SHUFFLE(3, 2, 3, 2));
 
-                    _mm512_storeu_ps(outptr0, _tmp0);
-                    _mm512_storeu_ps(outptr0 + 16, _tmp1);
-                    _mm512_storeu_ps(outptr0 + 16 * 2, _tmp2);
-                    _mm512_storeu_ps(outptr0 + 16 * 3, _tmp3);
+                    _mm512_storeu_blob_ps(outptr0, _tmp0);
+                    _mm512_storeu_blob_ps(outptr0 + 16, _tmp1);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 2, _tmp2);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 3, _tmp3);
 
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _tmp4);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16, _tmp5);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 2, _tmp6);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 3, _tmp7);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _tmp4);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16, _tmp5);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 2, _tmp6);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 3, _tmp7);
 
                     outptr0 += 64;
                 }
@@ -712,14 +713,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     _sum6 = _mm512_shuffle_f32x4(_tmp6, _tmp7, _MM_SHUFFLE(2, 0, 2, 0));
                     _sum7 = _mm512_shuffle_f32x4(_tmp6, _tmp7, _MM_SHUFFLE(3, 1, 3, 1));
 
-                    _mm512_storeu_ps(outptr0, _sum0);
-                    _mm512_storeu_ps(outptr0 + 16, _sum4);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4, _sum1);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4 + 16, _sum5);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _sum2);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16, _sum6);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12, _sum3);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12 + 16, _sum7);
+                    _mm512_storeu_blob_ps(outptr0, _sum0);
+                    _mm512_storeu_blob_ps(outptr0 + 16, _sum4);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4, _sum1);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4 + 16, _sum5);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _sum2);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16, _sum6);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12, _sum3);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12 + 16, _sum7);
 
                     outptr0 += 32;
                 }
@@ -727,22 +728,22 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 {
                     transpose16x8_ps(_sum0, _sum1, _sum2, _sum3, _sum4, _sum5, _sum6, _sum7);
 
-                    _mm256_storeu_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 1, _mm512_extractf32x8_ps(_sum0, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 2, _mm512_extractf32x8_ps(_sum1, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 3, _mm512_extractf32x8_ps(_sum1, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _mm512_extractf32x8_ps(_sum2, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 5, _mm512_extractf32x8_ps(_sum2, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 6, _mm512_extractf32x8_ps(_sum3, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 7, _mm512_extractf32x8_ps(_sum3, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum4, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 9, _mm512_extractf32x8_ps(_sum4, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 10, _mm512_extractf32x8_ps(_sum5, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 11, _mm512_extractf32x8_ps(_sum5, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 12, _mm512_extractf32x8_ps(_sum6, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 13, _mm512_extractf32x8_ps(_sum6, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 14, _mm512_extractf32x8_ps(_sum7, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 15, _mm512_extractf32x8_ps(_sum7, 1));
+                    _mm256_storeu_blob_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 1, _mm512_extractf32x8_ps(_sum0, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 2, _mm512_extractf32x8_ps(_sum1, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 3, _mm512_extractf32x8_ps(_sum1, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _mm512_extractf32x8_ps(_sum2, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 5, _mm512_extractf32x8_ps(_sum2, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 6, _mm512_extractf32x8_ps(_sum3, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 7, _mm512_extractf32x8_ps(_sum3, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum4, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 9, _mm512_extractf32x8_ps(_sum4, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 10, _mm512_extractf32x8_ps(_sum5, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 11, _mm512_extractf32x8_ps(_sum5, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 12, _mm512_extractf32x8_ps(_sum6, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 13, _mm512_extractf32x8_ps(_sum6, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 14, _mm512_extractf32x8_ps(_sum7, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 15, _mm512_extractf32x8_ps(_sum7, 1));
 
                     outptr0 += 8;
                 }
@@ -764,7 +765,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
 #endif // defined(__x86_64__) || defined(_M_X64)
         for (; jj + 3 < max_jj; jj += 4)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m512 _sum0;
             __m512 _sum1;
@@ -799,7 +800,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m512 _pA = _mm512_load_ps(pA);
+                __m512 _pA = _mm512_load_weight_ps(pA);
 
                 _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[1]), _sum1);
@@ -814,10 +815,10 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr0, _sum0);
-                    _mm512_store_ps(outptr0 + 16 * 1, _sum1);
-                    _mm512_store_ps(outptr0 + 16 * 2, _sum2);
-                    _mm512_store_ps(outptr0 + 16 * 3, _sum3);
+                    _mm512_store_blob_ps(outptr0, _sum0);
+                    _mm512_store_blob_ps(outptr0 + 16 * 1, _sum1);
+                    _mm512_store_blob_ps(outptr0 + 16 * 2, _sum2);
+                    _mm512_store_blob_ps(outptr0 + 16 * 3, _sum3);
                     outptr0 += 64;
                 }
                 if (out_elempack == 8)
@@ -827,11 +828,11 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     __m512 _tmp2 = _mm512_shuffle_f32x4(_sum0, _sum1, _MM_SHUFFLE(3, 2, 3, 2));
                     __m512 _tmp3 = _mm512_shuffle_f32x4(_sum2, _sum3, _MM_SHUFFLE(3, 2, 3, 2));
 
-                    _mm512_storeu_ps(outptr0, _tmp0);
-                    _mm512_storeu_ps(outptr0 + 16, _tmp1);
+                    _mm512_storeu_blob_ps(outptr0, _tmp0);
+                    _mm512_storeu_blob_ps(outptr0 + 16, _tmp1);
 
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _tmp2);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16, _tmp3);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _tmp2);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16, _tmp3);
 
                     outptr0 += 32;
                 }
@@ -847,10 +848,10 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     _sum2 = _mm512_shuffle_f32x4(_tmp2, _tmp3, _MM_SHUFFLE(2, 0, 2, 0));
                     _sum3 = _mm512_shuffle_f32x4(_tmp2, _tmp3, _MM_SHUFFLE(3, 1, 3, 1));
 
-                    _mm512_storeu_ps(outptr0, _sum0);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4, _sum1);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _sum2);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12, _sum3);
+                    _mm512_storeu_blob_ps(outptr0, _sum0);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4, _sum1);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _sum2);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12, _sum3);
 
                     outptr0 += 16;
                 }
@@ -878,22 +879,22 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     _MM_TRANSPOSE4_PS(_sum0_2, _sum1_2, _sum2_2, _sum3_2);
                     _MM_TRANSPOSE4_PS(_sum0_3, _sum1_3, _sum2_3, _sum3_3);
 
-                    _mm_storeu_ps(outptr0, _sum0_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _sum1_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2, _sum2_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _sum3_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 4, _sum0_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 5, _sum1_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 6, _sum2_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 7, _sum3_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 8, _sum0_2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 9, _sum1_2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 10, _sum2_2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 11, _sum3_2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 12, _sum0_3);
-                    _mm_storeu_ps(outptr0 + out_hstep * 13, _sum1_3);
-                    _mm_storeu_ps(outptr0 + out_hstep * 14, _sum2_3);
-                    _mm_storeu_ps(outptr0 + out_hstep * 15, _sum3_3);
+                    _mm_storeu_blob_ps(outptr0, _sum0_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 4, _sum0_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 5, _sum1_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 6, _sum2_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 7, _sum3_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 8, _sum0_2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 9, _sum1_2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 10, _sum2_2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 11, _sum3_2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 12, _sum0_3);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 13, _sum1_3);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 14, _sum2_3);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 15, _sum3_3);
 
                     outptr0 += 4;
                 }
@@ -910,7 +911,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
         }
         for (; jj + 1 < max_jj; jj += 2)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m512 _sum0;
             __m512 _sum1;
@@ -937,7 +938,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m512 _pA = _mm512_load_ps(pA);
+                __m512 _pA = _mm512_load_weight_ps(pA);
 
                 _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[1]), _sum1);
@@ -950,8 +951,8 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr0, _sum0);
-                    _mm512_store_ps(outptr0 + 16, _sum1);
+                    _mm512_store_blob_ps(outptr0, _sum0);
+                    _mm512_store_blob_ps(outptr0 + 16, _sum1);
                     outptr0 += 32;
                 }
                 if (out_elempack == 8)
@@ -959,24 +960,24 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     __m512 _tmp0 = _mm512_shuffle_f32x4(_sum0, _sum1, _MM_SHUFFLE(1, 0, 1, 0));
                     __m512 _tmp1 = _mm512_shuffle_f32x4(_sum0, _sum1, _MM_SHUFFLE(3, 2, 3, 2));
 
-                    _mm512_storeu_ps(outptr0, _tmp0);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _tmp1);
+                    _mm512_storeu_blob_ps(outptr0, _tmp0);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _tmp1);
 
                     outptr0 += 16;
                 }
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _mm512_extractf32x4_ps(_sum0, 0));
-                    _mm_store_ps(outptr0 + 4, _mm512_extractf32x4_ps(_sum1, 0));
+                    _mm_store_blob_ps(outptr0, _mm512_extractf32x4_ps(_sum0, 0));
+                    _mm_store_blob_ps(outptr0 + 4, _mm512_extractf32x4_ps(_sum1, 0));
 
-                    _mm_store_ps(outptr0 + out_hstep * 4, _mm512_extractf32x4_ps(_sum0, 1));
-                    _mm_store_ps(outptr0 + out_hstep * 4 + 4, _mm512_extractf32x4_ps(_sum1, 1));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 4, _mm512_extractf32x4_ps(_sum0, 1));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 4 + 4, _mm512_extractf32x4_ps(_sum1, 1));
 
-                    _mm_store_ps(outptr0 + out_hstep * 8, _mm512_extractf32x4_ps(_sum0, 2));
-                    _mm_store_ps(outptr0 + out_hstep * 8 + 4, _mm512_extractf32x4_ps(_sum1, 2));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 8, _mm512_extractf32x4_ps(_sum0, 2));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 8 + 4, _mm512_extractf32x4_ps(_sum1, 2));
 
-                    _mm_store_ps(outptr0 + out_hstep * 12, _mm512_extractf32x4_ps(_sum0, 3));
-                    _mm_store_ps(outptr0 + out_hstep * 12 + 4, _mm512_extractf32x4_ps(_sum1, 3));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 12, _mm512_extractf32x4_ps(_sum0, 3));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 12 + 4, _mm512_extractf32x4_ps(_sum1, 3));
                     outptr0 += 8;
                 }
                 if (out_elempack == 1)
@@ -1032,7 +1033,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
         }
         for (; jj < max_jj; jj += 1)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m512 _sum0;
 
@@ -1055,7 +1056,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m512 _pA = _mm512_load_ps(pA);
+                __m512 _pA = _mm512_load_weight_ps(pA);
 
                 _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[0]), _sum0);
 
@@ -1067,21 +1068,21 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr0, _sum0);
+                    _mm512_store_blob_ps(outptr0, _sum0);
                     outptr0 += 16;
                 }
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
-                    _mm256_store_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum0, 1));
+                    _mm256_store_blob_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
+                    _mm256_store_blob_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum0, 1));
                     outptr0 += 8;
                 }
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _mm512_extractf32x4_ps(_sum0, 0));
-                    _mm_store_ps(outptr0 + out_hstep * 4, _mm512_extractf32x4_ps(_sum0, 1));
-                    _mm_store_ps(outptr0 + out_hstep * 8, _mm512_extractf32x4_ps(_sum0, 2));
-                    _mm_store_ps(outptr0 + out_hstep * 12, _mm512_extractf32x4_ps(_sum0, 3));
+                    _mm_store_blob_ps(outptr0, _mm512_extractf32x4_ps(_sum0, 0));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 4, _mm512_extractf32x4_ps(_sum0, 1));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 8, _mm512_extractf32x4_ps(_sum0, 2));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 12, _mm512_extractf32x4_ps(_sum0, 3));
                     outptr0 += 4;
                 }
                 if (out_elempack == 1)
@@ -1121,7 +1122,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
 #endif // __AVX512F__
     for (; ii + 7 < max_ii; ii += 8)
     {
-        float* outptr0 = (float*)top_blob + (i + ii) * out_hstep + j * out_elempack;
+        TB* outptr0 = (TB*)top_blob + (i + ii) * out_hstep + j * out_elempack;
 
         const float* pB = pBT;
 
@@ -1134,7 +1135,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
 #if defined(__x86_64__) || defined(_M_X64)
         for (; jj + 11 < max_jj; jj += 12)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m256 _sum0;
             __m256 _sum1;
@@ -1201,7 +1202,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m256 _pA = _mm256_load_ps(pA);
+                __m256 _pA = _mm256_load_weight_ps(pA);
 
                 _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[1]), _sum1);
@@ -1224,18 +1225,18 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _sum0);
-                    _mm256_store_ps(outptr0 + 8 * 1, _sum1);
-                    _mm256_store_ps(outptr0 + 8 * 2, _sum2);
-                    _mm256_store_ps(outptr0 + 8 * 3, _sum3);
-                    _mm256_store_ps(outptr0 + 8 * 4, _sum4);
-                    _mm256_store_ps(outptr0 + 8 * 5, _sum5);
-                    _mm256_store_ps(outptr0 + 8 * 6, _sum6);
-                    _mm256_store_ps(outptr0 + 8 * 7, _sum7);
-                    _mm256_store_ps(outptr0 + 8 * 8, _sum8);
-                    _mm256_store_ps(outptr0 + 8 * 9, _sum9);
-                    _mm256_store_ps(outptr0 + 8 * 10, _suma);
-                    _mm256_store_ps(outptr0 + 8 * 11, _sumb);
+                    _mm256_store_blob_ps(outptr0, _sum0);
+                    _mm256_store_blob_ps(outptr0 + 8 * 1, _sum1);
+                    _mm256_store_blob_ps(outptr0 + 8 * 2, _sum2);
+                    _mm256_store_blob_ps(outptr0 + 8 * 3, _sum3);
+                    _mm256_store_blob_ps(outptr0 + 8 * 4, _sum4);
+                    _mm256_store_blob_ps(outptr0 + 8 * 5, _sum5);
+                    _mm256_store_blob_ps(outptr0 + 8 * 6, _sum6);
+                    _mm256_store_blob_ps(outptr0 + 8 * 7, _sum7);
+                    _mm256_store_blob_ps(outptr0 + 8 * 8, _sum8);
+                    _mm256_store_blob_ps(outptr0 + 8 * 9, _sum9);
+                    _mm256_store_blob_ps(outptr0 + 8 * 10, _suma);
+                    _mm256_store_blob_ps(outptr0 + 8 * 11, _sumb);
                     outptr0 += 96;
                 }
                 if (out_elempack == 4)
@@ -1253,19 +1254,19 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     __m256 _tmpa = _mm256_permute2f128_ps(_sum8, _sum9, _MM_SHUFFLE(0, 3, 0, 1));
                     __m256 _tmpb = _mm256_permute2f128_ps(_suma, _sumb, _MM_SHUFFLE(0, 3, 0, 1));
 
-                    _mm256_storeu_ps(outptr0, _tmp0);
-                    _mm256_storeu_ps(outptr0 + 8, _tmp1);
-                    _mm256_storeu_ps(outptr0 + 8 * 2, _tmp2);
-                    _mm256_storeu_ps(outptr0 + 8 * 3, _tmp3);
-                    _mm256_storeu_ps(outptr0 + 8 * 4, _tmp4);
-                    _mm256_storeu_ps(outptr0 + 8 * 5, _tmp5);
+                    _mm256_storeu_blob_ps(outptr0, _tmp0);
+                    _mm256_storeu_blob_ps(outptr0 + 8, _tmp1);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 2, _tmp2);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 3, _tmp3);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 4, _tmp4);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 5, _tmp5);
 
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _tmp6);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8, _tmp7);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 2, _tmp8);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 3, _tmp9);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 4, _tmpa);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 5, _tmpb);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _tmp6);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8, _tmp7);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 2, _tmp8);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 3, _tmp9);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 4, _tmpa);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 5, _tmpb);
 
                     outptr0 += 48;
                 }
@@ -1273,14 +1274,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 {
                     transpose8x8_ps(_sum0, _sum1, _sum2, _sum3, _sum4, _sum5, _sum6, _sum7);
 
-                    _mm256_storeu_ps(outptr0, _sum0);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 1, _sum1);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 2, _sum2);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 3, _sum3);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _sum4);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 5, _sum5);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 6, _sum6);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 7, _sum7);
+                    _mm256_storeu_blob_ps(outptr0, _sum0);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _sum4);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 5, _sum5);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 6, _sum6);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 7, _sum7);
 
                     __m128 _sum8_0 = _mm256_extractf128_ps(_sum8, 0);
                     __m128 _sum9_0 = _mm256_extractf128_ps(_sum9, 0);
@@ -1294,14 +1295,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     _MM_TRANSPOSE4_PS(_sum8_0, _sum9_0, _suma_0, _sumb_0);
                     _MM_TRANSPOSE4_PS(_sum8_1, _sum9_1, _suma_1, _sumb_1);
 
-                    _mm_storeu_ps(outptr0 + 8, _sum8_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1 + 8, _sum9_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2 + 8, _suma_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3 + 8, _sumb_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 4 + 8, _sum8_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 5 + 8, _sum9_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 6 + 8, _suma_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 7 + 8, _sumb_1);
+                    _mm_storeu_blob_ps(outptr0 + 8, _sum8_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1 + 8, _sum9_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2 + 8, _suma_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3 + 8, _sumb_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 4 + 8, _sum8_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 5 + 8, _sum9_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 6 + 8, _suma_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 7 + 8, _sumb_1);
 
                     outptr0 += 12;
                 }
@@ -1326,7 +1327,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
         }
         for (; jj + 7 < max_jj; jj += 8)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m256 _sum0;
             __m256 _sum1;
@@ -1377,7 +1378,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m256 _pA = _mm256_load_ps(pA);
+                __m256 _pA = _mm256_load_weight_ps(pA);
 
                 _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[1]), _sum1);
@@ -1396,14 +1397,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _sum0);
-                    _mm256_store_ps(outptr0 + 8 * 1, _sum1);
-                    _mm256_store_ps(outptr0 + 8 * 2, _sum2);
-                    _mm256_store_ps(outptr0 + 8 * 3, _sum3);
-                    _mm256_store_ps(outptr0 + 8 * 4, _sum4);
-                    _mm256_store_ps(outptr0 + 8 * 5, _sum5);
-                    _mm256_store_ps(outptr0 + 8 * 6, _sum6);
-                    _mm256_store_ps(outptr0 + 8 * 7, _sum7);
+                    _mm256_store_blob_ps(outptr0, _sum0);
+                    _mm256_store_blob_ps(outptr0 + 8 * 1, _sum1);
+                    _mm256_store_blob_ps(outptr0 + 8 * 2, _sum2);
+                    _mm256_store_blob_ps(outptr0 + 8 * 3, _sum3);
+                    _mm256_store_blob_ps(outptr0 + 8 * 4, _sum4);
+                    _mm256_store_blob_ps(outptr0 + 8 * 5, _sum5);
+                    _mm256_store_blob_ps(outptr0 + 8 * 6, _sum6);
+                    _mm256_store_blob_ps(outptr0 + 8 * 7, _sum7);
                     outptr0 += 64;
                 }
                 if (out_elempack == 4)
@@ -1417,15 +1418,15 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     __m256 _tmp6 = _mm256_permute2f128_ps(_sum4, _sum5, _MM_SHUFFLE(0, 3, 0, 1));
                     __m256 _tmp7 = _mm256_permute2f128_ps(_sum6, _sum7, _MM_SHUFFLE(0, 3, 0, 1));
 
-                    _mm256_storeu_ps(outptr0, _tmp0);
-                    _mm256_storeu_ps(outptr0 + 8, _tmp1);
-                    _mm256_storeu_ps(outptr0 + 8 * 2, _tmp2);
-                    _mm256_storeu_ps(outptr0 + 8 * 3, _tmp3);
+                    _mm256_storeu_blob_ps(outptr0, _tmp0);
+                    _mm256_storeu_blob_ps(outptr0 + 8, _tmp1);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 2, _tmp2);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 3, _tmp3);
 
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _tmp4);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8, _tmp5);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 2, _tmp6);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 3, _tmp7);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _tmp4);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8, _tmp5);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 2, _tmp6);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 3, _tmp7);
 
                     outptr0 += 32;
                 }
@@ -1433,14 +1434,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 {
                     transpose8x8_ps(_sum0, _sum1, _sum2, _sum3, _sum4, _sum5, _sum6, _sum7);
 
-                    _mm256_storeu_ps(outptr0, _sum0);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 1, _sum1);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 2, _sum2);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 3, _sum3);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _sum4);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 5, _sum5);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 6, _sum6);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 7, _sum7);
+                    _mm256_storeu_blob_ps(outptr0, _sum0);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _sum4);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 5, _sum5);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 6, _sum6);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 7, _sum7);
 
                     outptr0 += 8;
                 }
@@ -1462,7 +1463,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
 #endif // defined(__x86_64__) || defined(_M_X64)
         for (; jj + 3 < max_jj; jj += 4)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m256 _sum0;
             __m256 _sum1;
@@ -1497,7 +1498,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m256 _pA = _mm256_load_ps(pA);
+                __m256 _pA = _mm256_load_weight_ps(pA);
 
                 _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[1]), _sum1);
@@ -1512,10 +1513,10 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _sum0);
-                    _mm256_store_ps(outptr0 + 8 * 1, _sum1);
-                    _mm256_store_ps(outptr0 + 8 * 2, _sum2);
-                    _mm256_store_ps(outptr0 + 8 * 3, _sum3);
+                    _mm256_store_blob_ps(outptr0, _sum0);
+                    _mm256_store_blob_ps(outptr0 + 8 * 1, _sum1);
+                    _mm256_store_blob_ps(outptr0 + 8 * 2, _sum2);
+                    _mm256_store_blob_ps(outptr0 + 8 * 3, _sum3);
                     outptr0 += 32;
                 }
                 if (out_elempack == 4)
@@ -1525,11 +1526,11 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     __m256 _tmp2 = _mm256_permute2f128_ps(_sum0, _sum1, _MM_SHUFFLE(0, 3, 0, 1));
                     __m256 _tmp3 = _mm256_permute2f128_ps(_sum2, _sum3, _MM_SHUFFLE(0, 3, 0, 1));
 
-                    _mm256_storeu_ps(outptr0, _tmp0);
-                    _mm256_storeu_ps(outptr0 + 8, _tmp1);
+                    _mm256_storeu_blob_ps(outptr0, _tmp0);
+                    _mm256_storeu_blob_ps(outptr0 + 8, _tmp1);
 
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _tmp2);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8, _tmp3);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _tmp2);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8, _tmp3);
 
                     outptr0 += 16;
                 }
@@ -1547,14 +1548,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     _MM_TRANSPOSE4_PS(_sum0_0, _sum1_0, _sum2_0, _sum3_0);
                     _MM_TRANSPOSE4_PS(_sum0_1, _sum1_1, _sum2_1, _sum3_1);
 
-                    _mm_storeu_ps(outptr0, _sum0_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _sum1_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2, _sum2_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _sum3_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 4, _sum0_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 5, _sum1_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 6, _sum2_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 7, _sum3_1);
+                    _mm_storeu_blob_ps(outptr0, _sum0_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 4, _sum0_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 5, _sum1_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 6, _sum2_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 7, _sum3_1);
 
                     outptr0 += 4;
                 }
@@ -1571,7 +1572,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
         }
         for (; jj + 1 < max_jj; jj += 2)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m256 _sum0;
             __m256 _sum1;
@@ -1598,7 +1599,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m256 _pA = _mm256_load_ps(pA);
+                __m256 _pA = _mm256_load_weight_ps(pA);
 
                 _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[1]), _sum1);
@@ -1611,8 +1612,8 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _sum0);
-                    _mm256_store_ps(outptr0 + 8, _sum1);
+                    _mm256_store_blob_ps(outptr0, _sum0);
+                    _mm256_store_blob_ps(outptr0 + 8, _sum1);
                     outptr0 += 16;
                 }
                 if (out_elempack == 4)
@@ -1620,8 +1621,8 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     __m256 _tmp0 = _mm256_permute2f128_ps(_sum0, _sum1, _MM_SHUFFLE(0, 2, 0, 0));
                     __m256 _tmp1 = _mm256_permute2f128_ps(_sum0, _sum1, _MM_SHUFFLE(0, 3, 0, 1));
 
-                    _mm256_storeu_ps(outptr0, _tmp0);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _tmp1);
+                    _mm256_storeu_blob_ps(outptr0, _tmp0);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _tmp1);
                     outptr0 += 8;
                 }
                 if (out_elempack == 1)
@@ -1661,7 +1662,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
         }
         for (; jj < max_jj; jj += 1)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m256 _sum0;
 
@@ -1684,7 +1685,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m256 _pA = _mm256_load_ps(pA);
+                __m256 _pA = _mm256_load_weight_ps(pA);
 
                 _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[0]), _sum0);
 
@@ -1696,13 +1697,13 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _sum0);
+                    _mm256_store_blob_ps(outptr0, _sum0);
                     outptr0 += 8;
                 }
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _mm256_extractf128_ps(_sum0, 0));
-                    _mm_store_ps(outptr0 + out_hstep * 4, _mm256_extractf128_ps(_sum0, 1));
+                    _mm_store_blob_ps(outptr0, _mm256_extractf128_ps(_sum0, 0));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 4, _mm256_extractf128_ps(_sum0, 1));
                     outptr0 += 4;
                 }
                 if (out_elempack == 1)
@@ -1734,7 +1735,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
 #endif // __AVX__
     for (; ii + 3 < max_ii; ii += 4)
     {
-        float* outptr0 = (float*)top_blob + (i + ii) * out_hstep + j * out_elempack;
+        TB* outptr0 = (TB*)top_blob + (i + ii) * out_hstep + j * out_elempack;
 
         const float* pB = pBT;
 
@@ -1747,7 +1748,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
 #if defined(__x86_64__) || defined(_M_X64)
         for (; jj + 11 < max_jj; jj += 12)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m128 _sum0;
             __m128 _sum1;
@@ -1814,7 +1815,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pA = _mm_loadu_ps(pA);
+                __m128 _pA = _mm_loadu_weight_ps(pA);
 
                 _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[1]), _sum1);
@@ -1837,18 +1838,18 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 4)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + 4, _sum1);
-                    _mm_storeu_ps(outptr0 + 4 * 2, _sum2);
-                    _mm_storeu_ps(outptr0 + 4 * 3, _sum3);
-                    _mm_storeu_ps(outptr0 + 4 * 4, _sum4);
-                    _mm_storeu_ps(outptr0 + 4 * 5, _sum5);
-                    _mm_storeu_ps(outptr0 + 4 * 6, _sum6);
-                    _mm_storeu_ps(outptr0 + 4 * 7, _sum7);
-                    _mm_storeu_ps(outptr0 + 4 * 8, _sum8);
-                    _mm_storeu_ps(outptr0 + 4 * 9, _sum9);
-                    _mm_storeu_ps(outptr0 + 4 * 10, _suma);
-                    _mm_storeu_ps(outptr0 + 4 * 11, _sumb);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 2, _sum2);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 3, _sum3);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 4, _sum4);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 5, _sum5);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 6, _sum6);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 7, _sum7);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 8, _sum8);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 9, _sum9);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 10, _suma);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 11, _sumb);
                     outptr0 += 48;
                 }
                 if (out_elempack == 1)
@@ -1857,18 +1858,18 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     _MM_TRANSPOSE4_PS(_sum4, _sum5, _sum6, _sum7);
                     _MM_TRANSPOSE4_PS(_sum8, _sum9, _suma, _sumb);
 
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _sum1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2, _sum2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _sum3);
-                    _mm_storeu_ps(outptr0 + 4, _sum4);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1 + 4, _sum5);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2 + 4, _sum6);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3 + 4, _sum7);
-                    _mm_storeu_ps(outptr0 + 8, _sum8);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1 + 8, _sum9);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2 + 8, _suma);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3 + 8, _sumb);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum4);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1 + 4, _sum5);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2 + 4, _sum6);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3 + 4, _sum7);
+                    _mm_storeu_blob_ps(outptr0 + 8, _sum8);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1 + 8, _sum9);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2 + 8, _suma);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3 + 8, _sumb);
                     outptr0 += 12;
                 }
             }
@@ -1892,7 +1893,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
         }
         for (; jj + 7 < max_jj; jj += 8)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m128 _sum0;
             __m128 _sum1;
@@ -1943,7 +1944,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pA = _mm_loadu_ps(pA);
+                __m128 _pA = _mm_loadu_weight_ps(pA);
 
                 _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[1]), _sum1);
@@ -1962,14 +1963,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 4)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + 4, _sum1);
-                    _mm_storeu_ps(outptr0 + 4 * 2, _sum2);
-                    _mm_storeu_ps(outptr0 + 4 * 3, _sum3);
-                    _mm_storeu_ps(outptr0 + 4 * 4, _sum4);
-                    _mm_storeu_ps(outptr0 + 4 * 5, _sum5);
-                    _mm_storeu_ps(outptr0 + 4 * 6, _sum6);
-                    _mm_storeu_ps(outptr0 + 4 * 7, _sum7);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 2, _sum2);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 3, _sum3);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 4, _sum4);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 5, _sum5);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 6, _sum6);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 7, _sum7);
                     outptr0 += 32;
                 }
                 if (out_elempack == 1)
@@ -1977,14 +1978,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                     _MM_TRANSPOSE4_PS(_sum0, _sum1, _sum2, _sum3);
                     _MM_TRANSPOSE4_PS(_sum4, _sum5, _sum6, _sum7);
 
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _sum1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2, _sum2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _sum3);
-                    _mm_storeu_ps(outptr0 + 4, _sum4);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1 + 4, _sum5);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2 + 4, _sum6);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3 + 4, _sum7);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum4);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1 + 4, _sum5);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2 + 4, _sum6);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3 + 4, _sum7);
                     outptr0 += 8;
                 }
             }
@@ -2005,7 +2006,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
 #endif // defined(__x86_64__) || defined(_M_X64)
         for (; jj + 3 < max_jj; jj += 4)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m128 _sum0;
             __m128 _sum1;
@@ -2040,7 +2041,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pA = _mm_loadu_ps(pA);
+                __m128 _pA = _mm_loadu_weight_ps(pA);
 
                 _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[1]), _sum1);
@@ -2055,20 +2056,20 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 4)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + 4, _sum1);
-                    _mm_storeu_ps(outptr0 + 4 * 2, _sum2);
-                    _mm_storeu_ps(outptr0 + 4 * 3, _sum3);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 2, _sum2);
+                    _mm_storeu_blob_ps(outptr0 + 4 * 3, _sum3);
                     outptr0 += 16;
                 }
                 if (out_elempack == 1)
                 {
                     _MM_TRANSPOSE4_PS(_sum0, _sum1, _sum2, _sum3);
 
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _sum1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2, _sum2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _sum3);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3);
                     outptr0 += 4;
                 }
             }
@@ -2084,7 +2085,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
         }
         for (; jj + 1 < max_jj; jj += 2)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m128 _sum0;
             __m128 _sum1;
@@ -2111,7 +2112,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pA = _mm_loadu_ps(pA);
+                __m128 _pA = _mm_loadu_weight_ps(pA);
 
                 _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[0]), _sum0);
                 _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[1]), _sum1);
@@ -2124,8 +2125,8 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 4)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + 4, _sum1);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum1);
                     outptr0 += 8;
                 }
                 if (out_elempack == 1)
@@ -2156,7 +2157,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
         }
         for (; jj < max_jj; jj += 1)
         {
-            const float* pA = pAT;
+            const T* pA = pAT;
 
             __m128 _sum0;
 
@@ -2179,7 +2180,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pA = _mm_loadu_ps(pA);
+                __m128 _pA = _mm_loadu_weight_ps(pA);
 
                 _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[0]), _sum0);
 
@@ -2191,7 +2192,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 if (out_elempack == 4)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
                     outptr0 += 4;
                 }
                 if (out_elempack == 1)
@@ -2219,7 +2220,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
 #endif // __SSE2__
     for (; ii + 1 < max_ii; ii += 2)
     {
-        float* outptr0 = (float*)top_blob + (i + ii) * out_hstep + j;
+        TB* outptr0 = (TB*)top_blob + (i + ii) * out_hstep + j;
 
         const float* pB = pBT;
 
@@ -2277,7 +2278,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 _sum12 = _mm_shuffle_ps(_tmp4, _tmp5, _MM_SHUFFLE(3, 1, 3, 1));
             }
 
-            const float* pA = pAT;
+            const T* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
@@ -2285,11 +2286,11 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 __m128 _pB1 = _mm_loadu_ps(pB + 4);
                 __m128 _pB2 = _mm_loadu_ps(pB + 8);
 
-                __m128 _pA0 = _mm_set1_ps(pA[0]);
+                __m128 _pA0 = _mm_set1_ps(load_weight(pA));
                 _sum00 = _mm_comp_fmadd_ps(_pA0, _pB0, _sum00);
                 _sum01 = _mm_comp_fmadd_ps(_pA0, _pB1, _sum01);
                 _sum02 = _mm_comp_fmadd_ps(_pA0, _pB2, _sum02);
-                __m128 _pA1 = _mm_set1_ps(pA[1]);
+                __m128 _pA1 = _mm_set1_ps(load_weight(pA + 1));
                 _sum10 = _mm_comp_fmadd_ps(_pA1, _pB0, _sum10);
                 _sum11 = _mm_comp_fmadd_ps(_pA1, _pB1, _sum11);
                 _sum12 = _mm_comp_fmadd_ps(_pA1, _pB2, _sum12);
@@ -2302,12 +2303,12 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum00);
-                    _mm_storeu_ps(outptr0 + 4, _sum01);
-                    _mm_storeu_ps(outptr0 + 8, _sum02);
-                    _mm_storeu_ps(outptr0 + out_hstep, _sum10);
-                    _mm_storeu_ps(outptr0 + out_hstep + 4, _sum11);
-                    _mm_storeu_ps(outptr0 + out_hstep + 8, _sum12);
+                    _mm_storeu_blob_ps(outptr0, _sum00);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum01);
+                    _mm_storeu_blob_ps(outptr0 + 8, _sum02);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep, _sum10);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep + 4, _sum11);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep + 8, _sum12);
                     outptr0 += 12;
                 }
             }
@@ -2365,17 +2366,17 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 _sum11 = _mm_shuffle_ps(_tmp2, _tmp3, _MM_SHUFFLE(3, 1, 3, 1));
             }
 
-            const float* pA = pAT;
+            const T* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
                 __m128 _pB0 = _mm_loadu_ps(pB);
                 __m128 _pB1 = _mm_loadu_ps(pB + 4);
 
-                __m128 _pA0 = _mm_set1_ps(pA[0]);
+                __m128 _pA0 = _mm_set1_ps(load_weight(pA));
                 _sum00 = _mm_comp_fmadd_ps(_pA0, _pB0, _sum00);
                 _sum01 = _mm_comp_fmadd_ps(_pA0, _pB1, _sum01);
-                __m128 _pA1 = _mm_set1_ps(pA[1]);
+                __m128 _pA1 = _mm_set1_ps(load_weight(pA + 1));
                 _sum10 = _mm_comp_fmadd_ps(_pA1, _pB0, _sum10);
                 _sum11 = _mm_comp_fmadd_ps(_pA1, _pB1, _sum11);
 
@@ -2387,10 +2388,10 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum00);
-                    _mm_storeu_ps(outptr0 + 4, _sum01);
-                    _mm_storeu_ps(outptr0 + out_hstep, _sum10);
-                    _mm_storeu_ps(outptr0 + out_hstep + 4, _sum11);
+                    _mm_storeu_blob_ps(outptr0, _sum00);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum01);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep, _sum10);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep + 4, _sum11);
                     outptr0 += 8;
                 }
             }
@@ -2435,14 +2436,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 _sum1 = _mm_shuffle_ps(_tmp0, _tmp1, _MM_SHUFFLE(3, 1, 3, 1));
             }
 
-            const float* pA = pAT;
+            const T* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
                 __m128 _pB = _mm_loadu_ps(pB);
 
-                _sum0 = _mm_comp_fmadd_ps(_mm_set1_ps(pA[0]), _pB, _sum0);
-                _sum1 = _mm_comp_fmadd_ps(_mm_set1_ps(pA[1]), _pB, _sum1);
+                _sum0 = _mm_comp_fmadd_ps(_mm_set1_ps(load_weight(pA)), _pB, _sum0);
+                _sum1 = _mm_comp_fmadd_ps(_mm_set1_ps(load_weight(pA + 1)), _pB, _sum1);
 
                 pA += 2;
                 pB += 4;
@@ -2452,8 +2453,8 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + out_hstep, _sum1);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep, _sum1);
                     outptr0 += 4;
                 }
             }
@@ -2500,14 +2501,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 sum11 = outptr[3];
             }
 
-            const float* pA = pAT;
+            const T* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                sum00 += pA[0] * pB[0];
-                sum01 += pA[1] * pB[0];
-                sum10 += pA[0] * pB[1];
-                sum11 += pA[1] * pB[1];
+                sum00 += load_weight(pA) * pB[0];
+                sum01 += load_weight(pA + 1) * pB[0];
+                sum10 += load_weight(pA) * pB[1];
+                sum11 += load_weight(pA + 1) * pB[1];
 
                 pA += 2;
                 pB += 2;
@@ -2558,12 +2559,12 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 sum1 = outptr[1];
             }
 
-            const float* pA = pAT;
+            const T* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                sum0 += pA[0] * pB[0];
-                sum1 += pA[1] * pB[0];
+                sum0 += load_weight(pA) * pB[0];
+                sum1 += load_weight(pA + 1) * pB[0];
                 pA += 2;
                 pB += 1;
             }
@@ -2590,7 +2591,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
     }
     for (; ii < max_ii; ii += 1)
     {
-        float* outptr0 = (float*)top_blob + (i + ii) * out_hstep + j;
+        TB* outptr0 = (TB*)top_blob + (i + ii) * out_hstep + j;
 
         const float* pB = pBT;
 
@@ -2630,7 +2631,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 _sum2 = _mm_loadu_ps(outptr + 8);
             }
 
-            const float* pA = pAT;
+            const T* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
@@ -2638,7 +2639,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 __m128 _pB1 = _mm_loadu_ps(pB + 4);
                 __m128 _pB2 = _mm_loadu_ps(pB + 8);
 
-                __m128 _pA0 = _mm_set1_ps(pA[0]);
+                __m128 _pA0 = _mm_set1_ps(load_weight(pA));
                 _sum0 = _mm_comp_fmadd_ps(_pA0, _pB0, _sum0);
                 _sum1 = _mm_comp_fmadd_ps(_pA0, _pB1, _sum1);
                 _sum2 = _mm_comp_fmadd_ps(_pA0, _pB2, _sum2);
@@ -2651,9 +2652,9 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + 4, _sum1);
-                    _mm_storeu_ps(outptr0 + 8, _sum2);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + 8, _sum2);
                     outptr0 += 12;
                 }
             }
@@ -2690,14 +2691,14 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 _sum1 = _mm_loadu_ps(outptr + 4);
             }
 
-            const float* pA = pAT;
+            const T* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
                 __m128 _pB0 = _mm_loadu_ps(pB);
                 __m128 _pB1 = _mm_loadu_ps(pB + 4);
 
-                __m128 _pA0 = _mm_set1_ps(pA[0]);
+                __m128 _pA0 = _mm_set1_ps(load_weight(pA));
                 _sum0 = _mm_comp_fmadd_ps(_pA0, _pB0, _sum0);
                 _sum1 = _mm_comp_fmadd_ps(_pA0, _pB1, _sum1);
 
@@ -2709,8 +2710,8 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + 4, _sum1);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum1);
                     outptr0 += 8;
                 }
             }
@@ -2743,13 +2744,13 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 _sum = _mm_loadu_ps(outptr);
             }
 
-            const float* pA = pAT;
+            const T* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
                 __m128 _pB = _mm_loadu_ps(pB);
 
-                _sum = _mm_comp_fmadd_ps(_mm_set1_ps(pA[0]), _pB, _sum);
+                _sum = _mm_comp_fmadd_ps(_mm_set1_ps(load_weight(pA)), _pB, _sum);
 
                 pA += 1;
                 pB += 4;
@@ -2759,7 +2760,7 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum);
+                    _mm_storeu_blob_ps(outptr0, _sum);
                     outptr0 += 4;
                 }
             }
@@ -2795,12 +2796,12 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 sum1 = outptr[1];
             }
 
-            const float* pA = pAT;
+            const T* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                sum0 += pA[0] * pB[0];
-                sum1 += pA[0] * pB[1];
+                sum0 += load_weight(pA) * pB[0];
+                sum1 += load_weight(pA) * pB[1];
 
                 pA += 1;
                 pB += 2;
@@ -2843,11 +2844,11 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
                 sum = outptr[0];
             }
 
-            const float* pA = pAT;
+            const T* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                sum += pA[0] * pB[0];
+                sum += load_weight(pA) * pB[0];
                 pA += 1;
                 pB += 1;
             }
@@ -2872,6 +2873,19 @@ static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& B
     }
 }
 
+static void convolution_gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, const Mat& CT_tile, Mat& topT_tile, Mat& top_blob, int i, int max_ii, int j, int max_jj, int k, int max_kk, bool k_end)
+{
+#if NCNN_F16C && __F16C__
+    if (AT_tile.elembits() == 16)
+    {
+        convolution_gemm_transB_packed_tile_impl<unsigned short, float>(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, i, max_ii, j, max_jj, k, max_kk, k_end);
+        return;
+    }
+#endif
+
+    convolution_gemm_transB_packed_tile_impl<float, float>(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, i, max_ii, j, max_jj, k, max_kk, k_end);
+}
+
 static void convolution_im2col_gemm_get_optimal_tile_mnk(int M, int N, int K, int& TILE_M, int& TILE_N, int& TILE_K, int nT)
 {
     // resolve optimal tile size from cache size
@@ -3011,6 +3025,7 @@ static void convolution_im2col_gemm_get_optimal_tile_mnk(int M, int N, int K, in
     }
 }
 
+template<typename TB>
 static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Mat& B, int j, int max_jj, int k, int max_kk)
 {
     const int elempack = bottom_blob.elempack;
@@ -3026,23 +3041,23 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #if __AVX512F__
         if (elempack == 16)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 16) + (j + jj) * 16;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 16) + (j + jj) * 16;
 
             int kk = 0;
             for (; kk < max_kk / 16; kk++)
             {
-                __m512 _r0 = _mm512_load_ps(p0);
-                __m512 _r1 = _mm512_load_ps(p0 + 16);
-                __m512 _r2 = _mm512_load_ps(p0 + 16 * 2);
-                __m512 _r3 = _mm512_load_ps(p0 + 16 * 3);
-                __m512 _r4 = _mm512_load_ps(p0 + 16 * 4);
-                __m512 _r5 = _mm512_load_ps(p0 + 16 * 5);
-                __m512 _r6 = _mm512_load_ps(p0 + 16 * 6);
-                __m512 _r7 = _mm512_load_ps(p0 + 16 * 7);
-                __m512 _r8 = _mm512_load_ps(p0 + 16 * 8);
-                __m512 _r9 = _mm512_load_ps(p0 + 16 * 9);
-                __m512 _ra = _mm512_load_ps(p0 + 16 * 10);
-                __m512 _rb = _mm512_load_ps(p0 + 16 * 11);
+                __m512 _r0 = _mm512_load_blob_ps(p0);
+                __m512 _r1 = _mm512_load_blob_ps(p0 + 16);
+                __m512 _r2 = _mm512_load_blob_ps(p0 + 16 * 2);
+                __m512 _r3 = _mm512_load_blob_ps(p0 + 16 * 3);
+                __m512 _r4 = _mm512_load_blob_ps(p0 + 16 * 4);
+                __m512 _r5 = _mm512_load_blob_ps(p0 + 16 * 5);
+                __m512 _r6 = _mm512_load_blob_ps(p0 + 16 * 6);
+                __m512 _r7 = _mm512_load_blob_ps(p0 + 16 * 7);
+                __m512 _r8 = _mm512_load_blob_ps(p0 + 16 * 8);
+                __m512 _r9 = _mm512_load_blob_ps(p0 + 16 * 9);
+                __m512 _ra = _mm512_load_blob_ps(p0 + 16 * 10);
+                __m512 _rb = _mm512_load_blob_ps(p0 + 16 * 11);
                 transpose16x12_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb);
                 _mm512_store_ps(pp, _r0);
                 _mm512_store_ps(pp + 16 * 1, _r1);
@@ -3063,23 +3078,23 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
         if (elempack == 8)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 8) + (j + jj) * 8;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 8) + (j + jj) * 8;
 
             int kk = 0;
             for (; kk < max_kk / 8; kk++)
             {
-                __m256 _r0 = _mm256_load_ps(p0);
-                __m256 _r1 = _mm256_load_ps(p0 + 8);
-                __m256 _r2 = _mm256_load_ps(p0 + 8 * 2);
-                __m256 _r3 = _mm256_load_ps(p0 + 8 * 3);
-                __m256 _r4 = _mm256_load_ps(p0 + 8 * 4);
-                __m256 _r5 = _mm256_load_ps(p0 + 8 * 5);
-                __m256 _r6 = _mm256_load_ps(p0 + 8 * 6);
-                __m256 _r7 = _mm256_load_ps(p0 + 8 * 7);
-                __m256 _r8 = _mm256_load_ps(p0 + 8 * 8);
-                __m256 _r9 = _mm256_load_ps(p0 + 8 * 9);
-                __m256 _ra = _mm256_load_ps(p0 + 8 * 10);
-                __m256 _rb = _mm256_load_ps(p0 + 8 * 11);
+                __m256 _r0 = _mm256_load_blob_ps(p0);
+                __m256 _r1 = _mm256_load_blob_ps(p0 + 8);
+                __m256 _r2 = _mm256_load_blob_ps(p0 + 8 * 2);
+                __m256 _r3 = _mm256_load_blob_ps(p0 + 8 * 3);
+                __m256 _r4 = _mm256_load_blob_ps(p0 + 8 * 4);
+                __m256 _r5 = _mm256_load_blob_ps(p0 + 8 * 5);
+                __m256 _r6 = _mm256_load_blob_ps(p0 + 8 * 6);
+                __m256 _r7 = _mm256_load_blob_ps(p0 + 8 * 7);
+                __m256 _r8 = _mm256_load_blob_ps(p0 + 8 * 8);
+                __m256 _r9 = _mm256_load_blob_ps(p0 + 8 * 9);
+                __m256 _ra = _mm256_load_blob_ps(p0 + 8 * 10);
+                __m256 _rb = _mm256_load_blob_ps(p0 + 8 * 11);
                 transpose8x12_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb);
                 _mm256_store_ps(pp, _r0);
                 _mm256_store_ps(pp + 8 * 1, _r1);
@@ -3100,23 +3115,23 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #endif // __AVX__
         if (elempack == 4)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 4) + (j + jj) * 4;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 4) + (j + jj) * 4;
 
             int kk = 0;
             for (; kk < max_kk / 4; kk++)
             {
-                __m128 _r0 = _mm_load_ps(p0);
-                __m128 _r1 = _mm_load_ps(p0 + 4);
-                __m128 _r2 = _mm_load_ps(p0 + 4 * 2);
-                __m128 _r3 = _mm_load_ps(p0 + 4 * 3);
-                __m128 _r4 = _mm_load_ps(p0 + 4 * 4);
-                __m128 _r5 = _mm_load_ps(p0 + 4 * 5);
-                __m128 _r6 = _mm_load_ps(p0 + 4 * 6);
-                __m128 _r7 = _mm_load_ps(p0 + 4 * 7);
-                __m128 _r8 = _mm_load_ps(p0 + 4 * 8);
-                __m128 _r9 = _mm_load_ps(p0 + 4 * 9);
-                __m128 _ra = _mm_load_ps(p0 + 4 * 10);
-                __m128 _rb = _mm_load_ps(p0 + 4 * 11);
+                __m128 _r0 = _mm_load_blob_ps(p0);
+                __m128 _r1 = _mm_load_blob_ps(p0 + 4);
+                __m128 _r2 = _mm_load_blob_ps(p0 + 4 * 2);
+                __m128 _r3 = _mm_load_blob_ps(p0 + 4 * 3);
+                __m128 _r4 = _mm_load_blob_ps(p0 + 4 * 4);
+                __m128 _r5 = _mm_load_blob_ps(p0 + 4 * 5);
+                __m128 _r6 = _mm_load_blob_ps(p0 + 4 * 6);
+                __m128 _r7 = _mm_load_blob_ps(p0 + 4 * 7);
+                __m128 _r8 = _mm_load_blob_ps(p0 + 4 * 8);
+                __m128 _r9 = _mm_load_blob_ps(p0 + 4 * 9);
+                __m128 _ra = _mm_load_blob_ps(p0 + 4 * 10);
+                __m128 _rb = _mm_load_blob_ps(p0 + 4 * 11);
                 _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                 _MM_TRANSPOSE4_PS(_r4, _r5, _r6, _r7);
                 _MM_TRANSPOSE4_PS(_r8, _r9, _ra, _rb);
@@ -3139,14 +3154,14 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 
         if (elempack == 1)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k) + (j + jj);
+            const TB* p0 = (const TB*)bottom_blob.channel(k) + (j + jj);
 
             int kk = 0;
             for (; kk < max_kk; kk++)
             {
-                __m128 _r0 = _mm_loadu_ps(p0);
-                __m128 _r1 = _mm_loadu_ps(p0 + 4);
-                __m128 _r2 = _mm_loadu_ps(p0 + 8);
+                __m128 _r0 = _mm_loadu_blob_ps(p0);
+                __m128 _r1 = _mm_loadu_blob_ps(p0 + 4);
+                __m128 _r2 = _mm_loadu_blob_ps(p0 + 8);
                 _mm_storeu_ps(pp, _r0);
                 _mm_storeu_ps(pp + 4, _r1);
                 _mm_storeu_ps(pp + 8, _r2);
@@ -3161,19 +3176,19 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #if __AVX512F__
         if (elempack == 16)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 16) + (j + jj) * 16;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 16) + (j + jj) * 16;
 
             int kk = 0;
             for (; kk < max_kk / 16; kk++)
             {
-                __m512 _r0 = _mm512_load_ps(p0);
-                __m512 _r1 = _mm512_load_ps(p0 + 16);
-                __m512 _r2 = _mm512_load_ps(p0 + 16 * 2);
-                __m512 _r3 = _mm512_load_ps(p0 + 16 * 3);
-                __m512 _r4 = _mm512_load_ps(p0 + 16 * 4);
-                __m512 _r5 = _mm512_load_ps(p0 + 16 * 5);
-                __m512 _r6 = _mm512_load_ps(p0 + 16 * 6);
-                __m512 _r7 = _mm512_load_ps(p0 + 16 * 7);
+                __m512 _r0 = _mm512_load_blob_ps(p0);
+                __m512 _r1 = _mm512_load_blob_ps(p0 + 16);
+                __m512 _r2 = _mm512_load_blob_ps(p0 + 16 * 2);
+                __m512 _r3 = _mm512_load_blob_ps(p0 + 16 * 3);
+                __m512 _r4 = _mm512_load_blob_ps(p0 + 16 * 4);
+                __m512 _r5 = _mm512_load_blob_ps(p0 + 16 * 5);
+                __m512 _r6 = _mm512_load_blob_ps(p0 + 16 * 6);
+                __m512 _r7 = _mm512_load_blob_ps(p0 + 16 * 7);
                 transpose16x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
                 _mm512_store_ps(pp, _r0);
                 _mm512_store_ps(pp + 16 * 1, _r1);
@@ -3190,19 +3205,19 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
         if (elempack == 8)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 8) + (j + jj) * 8;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 8) + (j + jj) * 8;
 
             int kk = 0;
             for (; kk < max_kk / 8; kk++)
             {
-                __m256 _r0 = _mm256_load_ps(p0);
-                __m256 _r1 = _mm256_load_ps(p0 + 8);
-                __m256 _r2 = _mm256_load_ps(p0 + 8 * 2);
-                __m256 _r3 = _mm256_load_ps(p0 + 8 * 3);
-                __m256 _r4 = _mm256_load_ps(p0 + 8 * 4);
-                __m256 _r5 = _mm256_load_ps(p0 + 8 * 5);
-                __m256 _r6 = _mm256_load_ps(p0 + 8 * 6);
-                __m256 _r7 = _mm256_load_ps(p0 + 8 * 7);
+                __m256 _r0 = _mm256_load_blob_ps(p0);
+                __m256 _r1 = _mm256_load_blob_ps(p0 + 8);
+                __m256 _r2 = _mm256_load_blob_ps(p0 + 8 * 2);
+                __m256 _r3 = _mm256_load_blob_ps(p0 + 8 * 3);
+                __m256 _r4 = _mm256_load_blob_ps(p0 + 8 * 4);
+                __m256 _r5 = _mm256_load_blob_ps(p0 + 8 * 5);
+                __m256 _r6 = _mm256_load_blob_ps(p0 + 8 * 6);
+                __m256 _r7 = _mm256_load_blob_ps(p0 + 8 * 7);
                 transpose8x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
                 _mm256_store_ps(pp, _r0);
                 _mm256_store_ps(pp + 8 * 1, _r1);
@@ -3219,19 +3234,19 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #endif // __AVX__
         if (elempack == 4)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 4) + (j + jj) * 4;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 4) + (j + jj) * 4;
 
             int kk = 0;
             for (; kk < max_kk / 4; kk++)
             {
-                __m128 _r0 = _mm_load_ps(p0);
-                __m128 _r1 = _mm_load_ps(p0 + 4);
-                __m128 _r2 = _mm_load_ps(p0 + 4 * 2);
-                __m128 _r3 = _mm_load_ps(p0 + 4 * 3);
-                __m128 _r4 = _mm_load_ps(p0 + 4 * 4);
-                __m128 _r5 = _mm_load_ps(p0 + 4 * 5);
-                __m128 _r6 = _mm_load_ps(p0 + 4 * 6);
-                __m128 _r7 = _mm_load_ps(p0 + 4 * 7);
+                __m128 _r0 = _mm_load_blob_ps(p0);
+                __m128 _r1 = _mm_load_blob_ps(p0 + 4);
+                __m128 _r2 = _mm_load_blob_ps(p0 + 4 * 2);
+                __m128 _r3 = _mm_load_blob_ps(p0 + 4 * 3);
+                __m128 _r4 = _mm_load_blob_ps(p0 + 4 * 4);
+                __m128 _r5 = _mm_load_blob_ps(p0 + 4 * 5);
+                __m128 _r6 = _mm_load_blob_ps(p0 + 4 * 6);
+                __m128 _r7 = _mm_load_blob_ps(p0 + 4 * 7);
                 _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                 _MM_TRANSPOSE4_PS(_r4, _r5, _r6, _r7);
                 _mm_store_ps(pp, _r0);
@@ -3249,13 +3264,13 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 
         if (elempack == 1)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k) + (j + jj);
+            const TB* p0 = (const TB*)bottom_blob.channel(k) + (j + jj);
 
             int kk = 0;
             for (; kk < max_kk; kk++)
             {
-                __m128 _r0 = _mm_loadu_ps(p0);
-                __m128 _r1 = _mm_loadu_ps(p0 + 4);
+                __m128 _r0 = _mm_loadu_blob_ps(p0);
+                __m128 _r1 = _mm_loadu_blob_ps(p0 + 4);
                 _mm_storeu_ps(pp, _r0);
                 _mm_storeu_ps(pp + 4, _r1);
                 pp += 8;
@@ -3270,15 +3285,15 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #if __AVX512F__
         if (elempack == 16)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 16) + (j + jj) * 16;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 16) + (j + jj) * 16;
 
             int kk = 0;
             for (; kk < max_kk / 16; kk++)
             {
-                __m512 _r0 = _mm512_load_ps(p0);
-                __m512 _r1 = _mm512_load_ps(p0 + 16);
-                __m512 _r2 = _mm512_load_ps(p0 + 16 * 2);
-                __m512 _r3 = _mm512_load_ps(p0 + 16 * 3);
+                __m512 _r0 = _mm512_load_blob_ps(p0);
+                __m512 _r1 = _mm512_load_blob_ps(p0 + 16);
+                __m512 _r2 = _mm512_load_blob_ps(p0 + 16 * 2);
+                __m512 _r3 = _mm512_load_blob_ps(p0 + 16 * 3);
                 transpose16x4_ps(_r0, _r1, _r2, _r3);
                 _mm512_store_ps(pp, _r0);
                 _mm512_store_ps(pp + 16 * 1, _r1);
@@ -3291,15 +3306,15 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
         if (elempack == 8)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 8) + (j + jj) * 8;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 8) + (j + jj) * 8;
 
             int kk = 0;
             for (; kk < max_kk / 8; kk++)
             {
-                __m256 _r0 = _mm256_load_ps(p0);
-                __m256 _r1 = _mm256_load_ps(p0 + 8);
-                __m256 _r2 = _mm256_load_ps(p0 + 8 * 2);
-                __m256 _r3 = _mm256_load_ps(p0 + 8 * 3);
+                __m256 _r0 = _mm256_load_blob_ps(p0);
+                __m256 _r1 = _mm256_load_blob_ps(p0 + 8);
+                __m256 _r2 = _mm256_load_blob_ps(p0 + 8 * 2);
+                __m256 _r3 = _mm256_load_blob_ps(p0 + 8 * 3);
                 transpose8x4_ps(_r0, _r1, _r2, _r3);
                 _mm256_store_ps(pp, _r0);
                 _mm256_store_ps(pp + 8 * 1, _r1);
@@ -3312,15 +3327,15 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #endif // __AVX__
         if (elempack == 4)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 4) + (j + jj) * 4;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 4) + (j + jj) * 4;
 
             int kk = 0;
             for (; kk < max_kk / 4; kk++)
             {
-                __m128 _r0 = _mm_load_ps(p0);
-                __m128 _r1 = _mm_load_ps(p0 + 4);
-                __m128 _r2 = _mm_load_ps(p0 + 4 * 2);
-                __m128 _r3 = _mm_load_ps(p0 + 4 * 3);
+                __m128 _r0 = _mm_load_blob_ps(p0);
+                __m128 _r1 = _mm_load_blob_ps(p0 + 4);
+                __m128 _r2 = _mm_load_blob_ps(p0 + 4 * 2);
+                __m128 _r3 = _mm_load_blob_ps(p0 + 4 * 3);
                 _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                 _mm_store_ps(pp, _r0);
                 _mm_store_ps(pp + 4 * 1, _r1);
@@ -3333,12 +3348,12 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 
         if (elempack == 1)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k) + (j + jj);
+            const TB* p0 = (const TB*)bottom_blob.channel(k) + (j + jj);
 
             int kk = 0;
             for (; kk < max_kk; kk++)
             {
-                _mm_storeu_ps(pp, _mm_loadu_ps(p0));
+                _mm_storeu_ps(pp, _mm_loadu_blob_ps(p0));
                 pp += 4;
                 p0 += bottom_blob.cstep;
             }
@@ -3352,13 +3367,13 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #if __AVX512F__
         if (elempack == 16)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 16) + (j + jj) * 16;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 16) + (j + jj) * 16;
 
             int kk = 0;
             for (; kk < max_kk / 16; kk++)
             {
-                __m512 _r0 = _mm512_load_ps(p0);
-                __m512 _r1 = _mm512_load_ps(p0 + 16);
+                __m512 _r0 = _mm512_load_blob_ps(p0);
+                __m512 _r1 = _mm512_load_blob_ps(p0 + 16);
                 transpose16x2_ps(_r0, _r1);
                 _mm512_store_ps(pp, _r0);
                 _mm512_store_ps(pp + 16, _r1);
@@ -3369,13 +3384,13 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
         if (elempack == 8)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 8) + (j + jj) * 8;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 8) + (j + jj) * 8;
 
             int kk = 0;
             for (; kk < max_kk / 8; kk++)
             {
-                __m256 _r0 = _mm256_load_ps(p0);
-                __m256 _r1 = _mm256_load_ps(p0 + 8);
+                __m256 _r0 = _mm256_load_blob_ps(p0);
+                __m256 _r1 = _mm256_load_blob_ps(p0 + 8);
                 transpose8x2_ps(_r0, _r1);
                 _mm256_store_ps(pp, _r0);
                 _mm256_store_ps(pp + 8, _r1);
@@ -3386,14 +3401,14 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #endif // __AVX__
         if (elempack == 4)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 4) + (j + jj) * 4;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 4) + (j + jj) * 4;
 
             int kk = 0;
             for (; kk < max_kk / 4; kk++)
             {
                 // transpose4x2
-                __m128 _r0 = _mm_load_ps(p0);
-                __m128 _r1 = _mm_load_ps(p0 + 4);
+                __m128 _r0 = _mm_load_blob_ps(p0);
+                __m128 _r1 = _mm_load_blob_ps(p0 + 4);
                 __m128 _tmp0 = _mm_unpacklo_ps(_r0, _r1);
                 __m128 _tmp1 = _mm_unpackhi_ps(_r0, _r1);
                 _mm_store_ps(pp, _tmp0);
@@ -3406,7 +3421,7 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 
         if (elempack == 1)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k) + (j + jj);
+            const TB* p0 = (const TB*)bottom_blob.channel(k) + (j + jj);
 
             int kk = 0;
             for (; kk < max_kk; kk++)
@@ -3425,12 +3440,12 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #if __AVX512F__
         if (elempack == 16)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 16) + (j + jj) * 16;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 16) + (j + jj) * 16;
 
             int kk = 0;
             for (; kk < max_kk / 16; kk++)
             {
-                _mm512_store_ps(pp, _mm512_load_ps(p0));
+                _mm512_store_ps(pp, _mm512_load_blob_ps(p0));
                 pp += 16;
                 p0 += bottom_blob.cstep * 16;
             }
@@ -3438,12 +3453,12 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
         if (elempack == 8)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 8) + (j + jj) * 8;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 8) + (j + jj) * 8;
 
             int kk = 0;
             for (; kk < max_kk / 8; kk++)
             {
-                _mm256_store_ps(pp, _mm256_load_ps(p0));
+                _mm256_store_ps(pp, _mm256_load_blob_ps(p0));
                 pp += 8;
                 p0 += bottom_blob.cstep * 8;
             }
@@ -3451,12 +3466,12 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 #endif // __AVX__
         if (elempack == 4)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k / 4) + (j + jj) * 4;
+            const TB* p0 = (const TB*)bottom_blob.channel(k / 4) + (j + jj) * 4;
 
             int kk = 0;
             for (; kk < max_kk / 4; kk++)
             {
-                _mm_store_ps(pp, _mm_load_ps(p0));
+                _mm_store_ps(pp, _mm_load_blob_ps(p0));
                 pp += 4;
                 p0 += bottom_blob.cstep * 4;
             }
@@ -3465,7 +3480,7 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
 
         if (elempack == 1)
         {
-            const float* p0 = (const float*)bottom_blob.channel(k) + (j + jj);
+            const TB* p0 = (const TB*)bottom_blob.channel(k) + (j + jj);
 
             int kk = 0;
             for (; kk < max_kk; kk++)
@@ -3478,6 +3493,7 @@ static void convolution_im2col_input_tile_conv1x1s1d1(const Mat& bottom_blob, Ma
     }
 }
 
+template<typename TB>
 static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Mat& B, int j, int max_jj, int k, int max_kk, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h)
 {
     const int w = bottom_blob.w;
@@ -3542,24 +3558,24 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
                 int x0 = stride_w * dx0 + dilation_w * v;
                 int y0 = stride_h * dy0 + dilation_h * u;
 
-                const float* sptr = img.row(y0) + x0 * elempack;
+                const TB* sptr = img.row<const TB>(y0) + x0 * elempack;
 
 #if __AVX__
 #if __AVX512F__
                 if (elempack == 16)
                 {
-                    __m512 _r0 = _mm512_load_ps(sptr);
-                    __m512 _r1 = _mm512_load_ps(sptr + stride_w * 16);
-                    __m512 _r2 = _mm512_load_ps(sptr + stride_w * 32);
-                    __m512 _r3 = _mm512_load_ps(sptr + stride_w * 48);
-                    __m512 _r4 = _mm512_load_ps(sptr + stride_w * 64);
-                    __m512 _r5 = _mm512_load_ps(sptr + stride_w * 80);
-                    __m512 _r6 = _mm512_load_ps(sptr + stride_w * 96);
-                    __m512 _r7 = _mm512_load_ps(sptr + stride_w * 112);
-                    __m512 _r8 = _mm512_load_ps(sptr + stride_w * 128);
-                    __m512 _r9 = _mm512_load_ps(sptr + stride_w * 144);
-                    __m512 _ra = _mm512_load_ps(sptr + stride_w * 160);
-                    __m512 _rb = _mm512_load_ps(sptr + stride_w * 176);
+                    __m512 _r0 = _mm512_load_blob_ps(sptr);
+                    __m512 _r1 = _mm512_load_blob_ps(sptr + stride_w * 16);
+                    __m512 _r2 = _mm512_load_blob_ps(sptr + stride_w * 32);
+                    __m512 _r3 = _mm512_load_blob_ps(sptr + stride_w * 48);
+                    __m512 _r4 = _mm512_load_blob_ps(sptr + stride_w * 64);
+                    __m512 _r5 = _mm512_load_blob_ps(sptr + stride_w * 80);
+                    __m512 _r6 = _mm512_load_blob_ps(sptr + stride_w * 96);
+                    __m512 _r7 = _mm512_load_blob_ps(sptr + stride_w * 112);
+                    __m512 _r8 = _mm512_load_blob_ps(sptr + stride_w * 128);
+                    __m512 _r9 = _mm512_load_blob_ps(sptr + stride_w * 144);
+                    __m512 _ra = _mm512_load_blob_ps(sptr + stride_w * 160);
+                    __m512 _rb = _mm512_load_blob_ps(sptr + stride_w * 176);
                     transpose16x12_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb);
                     _mm512_store_ps(pp, _r0);
                     _mm512_store_ps(pp + 16 * 1, _r1);
@@ -3578,18 +3594,18 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
                 if (elempack == 8)
                 {
-                    __m256 _r0 = _mm256_load_ps(sptr);
-                    __m256 _r1 = _mm256_load_ps(sptr + stride_w * 8);
-                    __m256 _r2 = _mm256_load_ps(sptr + stride_w * 16);
-                    __m256 _r3 = _mm256_load_ps(sptr + stride_w * 24);
-                    __m256 _r4 = _mm256_load_ps(sptr + stride_w * 32);
-                    __m256 _r5 = _mm256_load_ps(sptr + stride_w * 40);
-                    __m256 _r6 = _mm256_load_ps(sptr + stride_w * 48);
-                    __m256 _r7 = _mm256_load_ps(sptr + stride_w * 56);
-                    __m256 _r8 = _mm256_load_ps(sptr + stride_w * 64);
-                    __m256 _r9 = _mm256_load_ps(sptr + stride_w * 72);
-                    __m256 _ra = _mm256_load_ps(sptr + stride_w * 80);
-                    __m256 _rb = _mm256_load_ps(sptr + stride_w * 88);
+                    __m256 _r0 = _mm256_load_blob_ps(sptr);
+                    __m256 _r1 = _mm256_load_blob_ps(sptr + stride_w * 8);
+                    __m256 _r2 = _mm256_load_blob_ps(sptr + stride_w * 16);
+                    __m256 _r3 = _mm256_load_blob_ps(sptr + stride_w * 24);
+                    __m256 _r4 = _mm256_load_blob_ps(sptr + stride_w * 32);
+                    __m256 _r5 = _mm256_load_blob_ps(sptr + stride_w * 40);
+                    __m256 _r6 = _mm256_load_blob_ps(sptr + stride_w * 48);
+                    __m256 _r7 = _mm256_load_blob_ps(sptr + stride_w * 56);
+                    __m256 _r8 = _mm256_load_blob_ps(sptr + stride_w * 64);
+                    __m256 _r9 = _mm256_load_blob_ps(sptr + stride_w * 72);
+                    __m256 _ra = _mm256_load_blob_ps(sptr + stride_w * 80);
+                    __m256 _rb = _mm256_load_blob_ps(sptr + stride_w * 88);
                     transpose8x12_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb);
                     _mm256_store_ps(pp, _r0);
                     _mm256_store_ps(pp + 8 * 1, _r1);
@@ -3608,18 +3624,18 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX__
                 if (elempack == 4)
                 {
-                    __m128 _r0 = _mm_load_ps(sptr);
-                    __m128 _r1 = _mm_load_ps(sptr + stride_w * 4);
-                    __m128 _r2 = _mm_load_ps(sptr + stride_w * 8);
-                    __m128 _r3 = _mm_load_ps(sptr + stride_w * 12);
-                    __m128 _r4 = _mm_load_ps(sptr + stride_w * 16);
-                    __m128 _r5 = _mm_load_ps(sptr + stride_w * 20);
-                    __m128 _r6 = _mm_load_ps(sptr + stride_w * 24);
-                    __m128 _r7 = _mm_load_ps(sptr + stride_w * 28);
-                    __m128 _r8 = _mm_load_ps(sptr + stride_w * 32);
-                    __m128 _r9 = _mm_load_ps(sptr + stride_w * 36);
-                    __m128 _ra = _mm_load_ps(sptr + stride_w * 40);
-                    __m128 _rb = _mm_load_ps(sptr + stride_w * 44);
+                    __m128 _r0 = _mm_load_blob_ps(sptr);
+                    __m128 _r1 = _mm_load_blob_ps(sptr + stride_w * 4);
+                    __m128 _r2 = _mm_load_blob_ps(sptr + stride_w * 8);
+                    __m128 _r3 = _mm_load_blob_ps(sptr + stride_w * 12);
+                    __m128 _r4 = _mm_load_blob_ps(sptr + stride_w * 16);
+                    __m128 _r5 = _mm_load_blob_ps(sptr + stride_w * 20);
+                    __m128 _r6 = _mm_load_blob_ps(sptr + stride_w * 24);
+                    __m128 _r7 = _mm_load_blob_ps(sptr + stride_w * 28);
+                    __m128 _r8 = _mm_load_blob_ps(sptr + stride_w * 32);
+                    __m128 _r9 = _mm_load_blob_ps(sptr + stride_w * 36);
+                    __m128 _ra = _mm_load_blob_ps(sptr + stride_w * 40);
+                    __m128 _rb = _mm_load_blob_ps(sptr + stride_w * 44);
                     _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                     _MM_TRANSPOSE4_PS(_r4, _r5, _r6, _r7);
                     _MM_TRANSPOSE4_PS(_r8, _r9, _ra, _rb);
@@ -3693,35 +3709,35 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
                 int ya = stride_h * dya + dilation_h * u;
                 int yb = stride_h * dyb + dilation_h * u;
 
-                const float* sptr0 = img.row(y0) + x0 * elempack;
-                const float* sptr1 = img.row(y1) + x1 * elempack;
-                const float* sptr2 = img.row(y2) + x2 * elempack;
-                const float* sptr3 = img.row(y3) + x3 * elempack;
-                const float* sptr4 = img.row(y4) + x4 * elempack;
-                const float* sptr5 = img.row(y5) + x5 * elempack;
-                const float* sptr6 = img.row(y6) + x6 * elempack;
-                const float* sptr7 = img.row(y7) + x7 * elempack;
-                const float* sptr8 = img.row(y8) + x8 * elempack;
-                const float* sptr9 = img.row(y9) + x9 * elempack;
-                const float* sptra = img.row(ya) + xa * elempack;
-                const float* sptrb = img.row(yb) + xb * elempack;
+                const TB* sptr0 = img.row<const TB>(y0) + x0 * elempack;
+                const TB* sptr1 = img.row<const TB>(y1) + x1 * elempack;
+                const TB* sptr2 = img.row<const TB>(y2) + x2 * elempack;
+                const TB* sptr3 = img.row<const TB>(y3) + x3 * elempack;
+                const TB* sptr4 = img.row<const TB>(y4) + x4 * elempack;
+                const TB* sptr5 = img.row<const TB>(y5) + x5 * elempack;
+                const TB* sptr6 = img.row<const TB>(y6) + x6 * elempack;
+                const TB* sptr7 = img.row<const TB>(y7) + x7 * elempack;
+                const TB* sptr8 = img.row<const TB>(y8) + x8 * elempack;
+                const TB* sptr9 = img.row<const TB>(y9) + x9 * elempack;
+                const TB* sptra = img.row<const TB>(ya) + xa * elempack;
+                const TB* sptrb = img.row<const TB>(yb) + xb * elempack;
 
 #if __AVX__
 #if __AVX512F__
                 if (elempack == 16)
                 {
-                    __m512 _r0 = _mm512_load_ps(sptr0);
-                    __m512 _r1 = _mm512_load_ps(sptr1);
-                    __m512 _r2 = _mm512_load_ps(sptr2);
-                    __m512 _r3 = _mm512_load_ps(sptr3);
-                    __m512 _r4 = _mm512_load_ps(sptr4);
-                    __m512 _r5 = _mm512_load_ps(sptr5);
-                    __m512 _r6 = _mm512_load_ps(sptr6);
-                    __m512 _r7 = _mm512_load_ps(sptr7);
-                    __m512 _r8 = _mm512_load_ps(sptr8);
-                    __m512 _r9 = _mm512_load_ps(sptr9);
-                    __m512 _ra = _mm512_load_ps(sptra);
-                    __m512 _rb = _mm512_load_ps(sptrb);
+                    __m512 _r0 = _mm512_load_blob_ps(sptr0);
+                    __m512 _r1 = _mm512_load_blob_ps(sptr1);
+                    __m512 _r2 = _mm512_load_blob_ps(sptr2);
+                    __m512 _r3 = _mm512_load_blob_ps(sptr3);
+                    __m512 _r4 = _mm512_load_blob_ps(sptr4);
+                    __m512 _r5 = _mm512_load_blob_ps(sptr5);
+                    __m512 _r6 = _mm512_load_blob_ps(sptr6);
+                    __m512 _r7 = _mm512_load_blob_ps(sptr7);
+                    __m512 _r8 = _mm512_load_blob_ps(sptr8);
+                    __m512 _r9 = _mm512_load_blob_ps(sptr9);
+                    __m512 _ra = _mm512_load_blob_ps(sptra);
+                    __m512 _rb = _mm512_load_blob_ps(sptrb);
                     transpose16x12_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb);
                     _mm512_store_ps(pp, _r0);
                     _mm512_store_ps(pp + 16 * 1, _r1);
@@ -3740,18 +3756,18 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
                 if (elempack == 8)
                 {
-                    __m256 _r0 = _mm256_load_ps(sptr0);
-                    __m256 _r1 = _mm256_load_ps(sptr1);
-                    __m256 _r2 = _mm256_load_ps(sptr2);
-                    __m256 _r3 = _mm256_load_ps(sptr3);
-                    __m256 _r4 = _mm256_load_ps(sptr4);
-                    __m256 _r5 = _mm256_load_ps(sptr5);
-                    __m256 _r6 = _mm256_load_ps(sptr6);
-                    __m256 _r7 = _mm256_load_ps(sptr7);
-                    __m256 _r8 = _mm256_load_ps(sptr8);
-                    __m256 _r9 = _mm256_load_ps(sptr9);
-                    __m256 _ra = _mm256_load_ps(sptra);
-                    __m256 _rb = _mm256_load_ps(sptrb);
+                    __m256 _r0 = _mm256_load_blob_ps(sptr0);
+                    __m256 _r1 = _mm256_load_blob_ps(sptr1);
+                    __m256 _r2 = _mm256_load_blob_ps(sptr2);
+                    __m256 _r3 = _mm256_load_blob_ps(sptr3);
+                    __m256 _r4 = _mm256_load_blob_ps(sptr4);
+                    __m256 _r5 = _mm256_load_blob_ps(sptr5);
+                    __m256 _r6 = _mm256_load_blob_ps(sptr6);
+                    __m256 _r7 = _mm256_load_blob_ps(sptr7);
+                    __m256 _r8 = _mm256_load_blob_ps(sptr8);
+                    __m256 _r9 = _mm256_load_blob_ps(sptr9);
+                    __m256 _ra = _mm256_load_blob_ps(sptra);
+                    __m256 _rb = _mm256_load_blob_ps(sptrb);
                     transpose8x12_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb);
                     _mm256_store_ps(pp, _r0);
                     _mm256_store_ps(pp + 8 * 1, _r1);
@@ -3770,18 +3786,18 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX__
                 if (elempack == 4)
                 {
-                    __m128 _r0 = _mm_load_ps(sptr0);
-                    __m128 _r1 = _mm_load_ps(sptr1);
-                    __m128 _r2 = _mm_load_ps(sptr2);
-                    __m128 _r3 = _mm_load_ps(sptr3);
-                    __m128 _r4 = _mm_load_ps(sptr4);
-                    __m128 _r5 = _mm_load_ps(sptr5);
-                    __m128 _r6 = _mm_load_ps(sptr6);
-                    __m128 _r7 = _mm_load_ps(sptr7);
-                    __m128 _r8 = _mm_load_ps(sptr8);
-                    __m128 _r9 = _mm_load_ps(sptr9);
-                    __m128 _ra = _mm_load_ps(sptra);
-                    __m128 _rb = _mm_load_ps(sptrb);
+                    __m128 _r0 = _mm_load_blob_ps(sptr0);
+                    __m128 _r1 = _mm_load_blob_ps(sptr1);
+                    __m128 _r2 = _mm_load_blob_ps(sptr2);
+                    __m128 _r3 = _mm_load_blob_ps(sptr3);
+                    __m128 _r4 = _mm_load_blob_ps(sptr4);
+                    __m128 _r5 = _mm_load_blob_ps(sptr5);
+                    __m128 _r6 = _mm_load_blob_ps(sptr6);
+                    __m128 _r7 = _mm_load_blob_ps(sptr7);
+                    __m128 _r8 = _mm_load_blob_ps(sptr8);
+                    __m128 _r9 = _mm_load_blob_ps(sptr9);
+                    __m128 _ra = _mm_load_blob_ps(sptra);
+                    __m128 _rb = _mm_load_blob_ps(sptrb);
                     _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                     _MM_TRANSPOSE4_PS(_r4, _r5, _r6, _r7);
                     _MM_TRANSPOSE4_PS(_r8, _r9, _ra, _rb);
@@ -3852,20 +3868,20 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
                 int x0 = stride_w * dx0 + dilation_w * v;
                 int y0 = stride_h * dy0 + dilation_h * u;
 
-                const float* sptr = img.row(y0) + x0 * elempack;
+                const TB* sptr = img.row<const TB>(y0) + x0 * elempack;
 
 #if __AVX__
 #if __AVX512F__
                 if (elempack == 16)
                 {
-                    __m512 _r0 = _mm512_load_ps(sptr);
-                    __m512 _r1 = _mm512_load_ps(sptr + stride_w * 16);
-                    __m512 _r2 = _mm512_load_ps(sptr + stride_w * 32);
-                    __m512 _r3 = _mm512_load_ps(sptr + stride_w * 48);
-                    __m512 _r4 = _mm512_load_ps(sptr + stride_w * 64);
-                    __m512 _r5 = _mm512_load_ps(sptr + stride_w * 80);
-                    __m512 _r6 = _mm512_load_ps(sptr + stride_w * 96);
-                    __m512 _r7 = _mm512_load_ps(sptr + stride_w * 112);
+                    __m512 _r0 = _mm512_load_blob_ps(sptr);
+                    __m512 _r1 = _mm512_load_blob_ps(sptr + stride_w * 16);
+                    __m512 _r2 = _mm512_load_blob_ps(sptr + stride_w * 32);
+                    __m512 _r3 = _mm512_load_blob_ps(sptr + stride_w * 48);
+                    __m512 _r4 = _mm512_load_blob_ps(sptr + stride_w * 64);
+                    __m512 _r5 = _mm512_load_blob_ps(sptr + stride_w * 80);
+                    __m512 _r6 = _mm512_load_blob_ps(sptr + stride_w * 96);
+                    __m512 _r7 = _mm512_load_blob_ps(sptr + stride_w * 112);
                     transpose16x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
                     _mm512_store_ps(pp, _r0);
                     _mm512_store_ps(pp + 16 * 1, _r1);
@@ -3880,14 +3896,14 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
                 if (elempack == 8)
                 {
-                    __m256 _r0 = _mm256_load_ps(sptr);
-                    __m256 _r1 = _mm256_load_ps(sptr + stride_w * 8);
-                    __m256 _r2 = _mm256_load_ps(sptr + stride_w * 16);
-                    __m256 _r3 = _mm256_load_ps(sptr + stride_w * 24);
-                    __m256 _r4 = _mm256_load_ps(sptr + stride_w * 32);
-                    __m256 _r5 = _mm256_load_ps(sptr + stride_w * 40);
-                    __m256 _r6 = _mm256_load_ps(sptr + stride_w * 48);
-                    __m256 _r7 = _mm256_load_ps(sptr + stride_w * 56);
+                    __m256 _r0 = _mm256_load_blob_ps(sptr);
+                    __m256 _r1 = _mm256_load_blob_ps(sptr + stride_w * 8);
+                    __m256 _r2 = _mm256_load_blob_ps(sptr + stride_w * 16);
+                    __m256 _r3 = _mm256_load_blob_ps(sptr + stride_w * 24);
+                    __m256 _r4 = _mm256_load_blob_ps(sptr + stride_w * 32);
+                    __m256 _r5 = _mm256_load_blob_ps(sptr + stride_w * 40);
+                    __m256 _r6 = _mm256_load_blob_ps(sptr + stride_w * 48);
+                    __m256 _r7 = _mm256_load_blob_ps(sptr + stride_w * 56);
                     transpose8x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
                     _mm256_store_ps(pp, _r0);
                     _mm256_store_ps(pp + 8 * 1, _r1);
@@ -3902,14 +3918,14 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX__
                 if (elempack == 4)
                 {
-                    __m128 _r0 = _mm_load_ps(sptr);
-                    __m128 _r1 = _mm_load_ps(sptr + stride_w * 4);
-                    __m128 _r2 = _mm_load_ps(sptr + stride_w * 8);
-                    __m128 _r3 = _mm_load_ps(sptr + stride_w * 12);
-                    __m128 _r4 = _mm_load_ps(sptr + stride_w * 16);
-                    __m128 _r5 = _mm_load_ps(sptr + stride_w * 20);
-                    __m128 _r6 = _mm_load_ps(sptr + stride_w * 24);
-                    __m128 _r7 = _mm_load_ps(sptr + stride_w * 28);
+                    __m128 _r0 = _mm_load_blob_ps(sptr);
+                    __m128 _r1 = _mm_load_blob_ps(sptr + stride_w * 4);
+                    __m128 _r2 = _mm_load_blob_ps(sptr + stride_w * 8);
+                    __m128 _r3 = _mm_load_blob_ps(sptr + stride_w * 12);
+                    __m128 _r4 = _mm_load_blob_ps(sptr + stride_w * 16);
+                    __m128 _r5 = _mm_load_blob_ps(sptr + stride_w * 20);
+                    __m128 _r6 = _mm_load_blob_ps(sptr + stride_w * 24);
+                    __m128 _r7 = _mm_load_blob_ps(sptr + stride_w * 28);
                     _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                     _MM_TRANSPOSE4_PS(_r4, _r5, _r6, _r7);
                     _mm_store_ps(pp, _r0);
@@ -3965,27 +3981,27 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
                 int y6 = stride_h * dy6 + dilation_h * u;
                 int y7 = stride_h * dy7 + dilation_h * u;
 
-                const float* sptr0 = img.row(y0) + x0 * elempack;
-                const float* sptr1 = img.row(y1) + x1 * elempack;
-                const float* sptr2 = img.row(y2) + x2 * elempack;
-                const float* sptr3 = img.row(y3) + x3 * elempack;
-                const float* sptr4 = img.row(y4) + x4 * elempack;
-                const float* sptr5 = img.row(y5) + x5 * elempack;
-                const float* sptr6 = img.row(y6) + x6 * elempack;
-                const float* sptr7 = img.row(y7) + x7 * elempack;
+                const TB* sptr0 = img.row<const TB>(y0) + x0 * elempack;
+                const TB* sptr1 = img.row<const TB>(y1) + x1 * elempack;
+                const TB* sptr2 = img.row<const TB>(y2) + x2 * elempack;
+                const TB* sptr3 = img.row<const TB>(y3) + x3 * elempack;
+                const TB* sptr4 = img.row<const TB>(y4) + x4 * elempack;
+                const TB* sptr5 = img.row<const TB>(y5) + x5 * elempack;
+                const TB* sptr6 = img.row<const TB>(y6) + x6 * elempack;
+                const TB* sptr7 = img.row<const TB>(y7) + x7 * elempack;
 
 #if __AVX__
 #if __AVX512F__
                 if (elempack == 16)
                 {
-                    __m512 _r0 = _mm512_load_ps(sptr0);
-                    __m512 _r1 = _mm512_load_ps(sptr1);
-                    __m512 _r2 = _mm512_load_ps(sptr2);
-                    __m512 _r3 = _mm512_load_ps(sptr3);
-                    __m512 _r4 = _mm512_load_ps(sptr4);
-                    __m512 _r5 = _mm512_load_ps(sptr5);
-                    __m512 _r6 = _mm512_load_ps(sptr6);
-                    __m512 _r7 = _mm512_load_ps(sptr7);
+                    __m512 _r0 = _mm512_load_blob_ps(sptr0);
+                    __m512 _r1 = _mm512_load_blob_ps(sptr1);
+                    __m512 _r2 = _mm512_load_blob_ps(sptr2);
+                    __m512 _r3 = _mm512_load_blob_ps(sptr3);
+                    __m512 _r4 = _mm512_load_blob_ps(sptr4);
+                    __m512 _r5 = _mm512_load_blob_ps(sptr5);
+                    __m512 _r6 = _mm512_load_blob_ps(sptr6);
+                    __m512 _r7 = _mm512_load_blob_ps(sptr7);
                     transpose16x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
                     _mm512_store_ps(pp, _r0);
                     _mm512_store_ps(pp + 16 * 1, _r1);
@@ -4000,14 +4016,14 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
                 if (elempack == 8)
                 {
-                    __m256 _r0 = _mm256_load_ps(sptr0);
-                    __m256 _r1 = _mm256_load_ps(sptr1);
-                    __m256 _r2 = _mm256_load_ps(sptr2);
-                    __m256 _r3 = _mm256_load_ps(sptr3);
-                    __m256 _r4 = _mm256_load_ps(sptr4);
-                    __m256 _r5 = _mm256_load_ps(sptr5);
-                    __m256 _r6 = _mm256_load_ps(sptr6);
-                    __m256 _r7 = _mm256_load_ps(sptr7);
+                    __m256 _r0 = _mm256_load_blob_ps(sptr0);
+                    __m256 _r1 = _mm256_load_blob_ps(sptr1);
+                    __m256 _r2 = _mm256_load_blob_ps(sptr2);
+                    __m256 _r3 = _mm256_load_blob_ps(sptr3);
+                    __m256 _r4 = _mm256_load_blob_ps(sptr4);
+                    __m256 _r5 = _mm256_load_blob_ps(sptr5);
+                    __m256 _r6 = _mm256_load_blob_ps(sptr6);
+                    __m256 _r7 = _mm256_load_blob_ps(sptr7);
                     transpose8x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
                     _mm256_store_ps(pp, _r0);
                     _mm256_store_ps(pp + 8 * 1, _r1);
@@ -4022,14 +4038,14 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX__
                 if (elempack == 4)
                 {
-                    __m128 _r0 = _mm_load_ps(sptr0);
-                    __m128 _r1 = _mm_load_ps(sptr1);
-                    __m128 _r2 = _mm_load_ps(sptr2);
-                    __m128 _r3 = _mm_load_ps(sptr3);
-                    __m128 _r4 = _mm_load_ps(sptr4);
-                    __m128 _r5 = _mm_load_ps(sptr5);
-                    __m128 _r6 = _mm_load_ps(sptr6);
-                    __m128 _r7 = _mm_load_ps(sptr7);
+                    __m128 _r0 = _mm_load_blob_ps(sptr0);
+                    __m128 _r1 = _mm_load_blob_ps(sptr1);
+                    __m128 _r2 = _mm_load_blob_ps(sptr2);
+                    __m128 _r3 = _mm_load_blob_ps(sptr3);
+                    __m128 _r4 = _mm_load_blob_ps(sptr4);
+                    __m128 _r5 = _mm_load_blob_ps(sptr5);
+                    __m128 _r6 = _mm_load_blob_ps(sptr6);
+                    __m128 _r7 = _mm_load_blob_ps(sptr7);
                     _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                     _MM_TRANSPOSE4_PS(_r4, _r5, _r6, _r7);
                     _mm_store_ps(pp, _r0);
@@ -4084,16 +4100,16 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
                 int x0 = stride_w * dx0 + dilation_w * v;
                 int y0 = stride_h * dy0 + dilation_h * u;
 
-                const float* sptr = img.row(y0) + x0 * elempack;
+                const TB* sptr = img.row<const TB>(y0) + x0 * elempack;
 
 #if __AVX__
 #if __AVX512F__
                 if (elempack == 16)
                 {
-                    __m512 _r0 = _mm512_load_ps(sptr);
-                    __m512 _r1 = _mm512_load_ps(sptr + stride_w * 16);
-                    __m512 _r2 = _mm512_load_ps(sptr + stride_w * 32);
-                    __m512 _r3 = _mm512_load_ps(sptr + stride_w * 48);
+                    __m512 _r0 = _mm512_load_blob_ps(sptr);
+                    __m512 _r1 = _mm512_load_blob_ps(sptr + stride_w * 16);
+                    __m512 _r2 = _mm512_load_blob_ps(sptr + stride_w * 32);
+                    __m512 _r3 = _mm512_load_blob_ps(sptr + stride_w * 48);
                     transpose16x4_ps(_r0, _r1, _r2, _r3);
                     _mm512_store_ps(pp, _r0);
                     _mm512_store_ps(pp + 16 * 1, _r1);
@@ -4104,10 +4120,10 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
                 if (elempack == 8)
                 {
-                    __m256 _r0 = _mm256_load_ps(sptr);
-                    __m256 _r1 = _mm256_load_ps(sptr + stride_w * 8);
-                    __m256 _r2 = _mm256_load_ps(sptr + stride_w * 16);
-                    __m256 _r3 = _mm256_load_ps(sptr + stride_w * 24);
+                    __m256 _r0 = _mm256_load_blob_ps(sptr);
+                    __m256 _r1 = _mm256_load_blob_ps(sptr + stride_w * 8);
+                    __m256 _r2 = _mm256_load_blob_ps(sptr + stride_w * 16);
+                    __m256 _r3 = _mm256_load_blob_ps(sptr + stride_w * 24);
                     transpose8x4_ps(_r0, _r1, _r2, _r3);
                     _mm256_store_ps(pp, _r0);
                     _mm256_store_ps(pp + 8 * 1, _r1);
@@ -4118,10 +4134,10 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX__
                 if (elempack == 4)
                 {
-                    __m128 _r0 = _mm_load_ps(sptr);
-                    __m128 _r1 = _mm_load_ps(sptr + stride_w * 4);
-                    __m128 _r2 = _mm_load_ps(sptr + stride_w * 8);
-                    __m128 _r3 = _mm_load_ps(sptr + stride_w * 12);
+                    __m128 _r0 = _mm_load_blob_ps(sptr);
+                    __m128 _r1 = _mm_load_blob_ps(sptr + stride_w * 4);
+                    __m128 _r2 = _mm_load_blob_ps(sptr + stride_w * 8);
+                    __m128 _r3 = _mm_load_blob_ps(sptr + stride_w * 12);
                     _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                     _mm_store_ps(pp, _r0);
                     _mm_store_ps(pp + 4 * 1, _r1);
@@ -4160,19 +4176,19 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
                 int y2 = stride_h * dy2 + dilation_h * u;
                 int y3 = stride_h * dy3 + dilation_h * u;
 
-                const float* sptr0 = img.row(y0) + x0 * elempack;
-                const float* sptr1 = img.row(y1) + x1 * elempack;
-                const float* sptr2 = img.row(y2) + x2 * elempack;
-                const float* sptr3 = img.row(y3) + x3 * elempack;
+                const TB* sptr0 = img.row<const TB>(y0) + x0 * elempack;
+                const TB* sptr1 = img.row<const TB>(y1) + x1 * elempack;
+                const TB* sptr2 = img.row<const TB>(y2) + x2 * elempack;
+                const TB* sptr3 = img.row<const TB>(y3) + x3 * elempack;
 
 #if __AVX__
 #if __AVX512F__
                 if (elempack == 16)
                 {
-                    __m512 _r0 = _mm512_load_ps(sptr0);
-                    __m512 _r1 = _mm512_load_ps(sptr1);
-                    __m512 _r2 = _mm512_load_ps(sptr2);
-                    __m512 _r3 = _mm512_load_ps(sptr3);
+                    __m512 _r0 = _mm512_load_blob_ps(sptr0);
+                    __m512 _r1 = _mm512_load_blob_ps(sptr1);
+                    __m512 _r2 = _mm512_load_blob_ps(sptr2);
+                    __m512 _r3 = _mm512_load_blob_ps(sptr3);
                     transpose16x4_ps(_r0, _r1, _r2, _r3);
                     _mm512_store_ps(pp, _r0);
                     _mm512_store_ps(pp + 16 * 1, _r1);
@@ -4183,10 +4199,10 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
                 if (elempack == 8)
                 {
-                    __m256 _r0 = _mm256_load_ps(sptr0);
-                    __m256 _r1 = _mm256_load_ps(sptr1);
-                    __m256 _r2 = _mm256_load_ps(sptr2);
-                    __m256 _r3 = _mm256_load_ps(sptr3);
+                    __m256 _r0 = _mm256_load_blob_ps(sptr0);
+                    __m256 _r1 = _mm256_load_blob_ps(sptr1);
+                    __m256 _r2 = _mm256_load_blob_ps(sptr2);
+                    __m256 _r3 = _mm256_load_blob_ps(sptr3);
                     transpose8x4_ps(_r0, _r1, _r2, _r3);
                     _mm256_store_ps(pp, _r0);
                     _mm256_store_ps(pp + 8 * 1, _r1);
@@ -4197,10 +4213,10 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX__
                 if (elempack == 4)
                 {
-                    __m128 _r0 = _mm_load_ps(sptr0);
-                    __m128 _r1 = _mm_load_ps(sptr1);
-                    __m128 _r2 = _mm_load_ps(sptr2);
-                    __m128 _r3 = _mm_load_ps(sptr3);
+                    __m128 _r0 = _mm_load_blob_ps(sptr0);
+                    __m128 _r1 = _mm_load_blob_ps(sptr1);
+                    __m128 _r2 = _mm_load_blob_ps(sptr2);
+                    __m128 _r3 = _mm_load_blob_ps(sptr3);
                     _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                     _mm_store_ps(pp, _r0);
                     _mm_store_ps(pp + 4 * 1, _r1);
@@ -4242,15 +4258,15 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
                 int x0 = stride_w * dx0 + dilation_w * v;
                 int y0 = stride_h * dy0 + dilation_h * u;
 
-                const float* sptr = img.row(y0) + x0 * elempack;
+                const TB* sptr = img.row<const TB>(y0) + x0 * elempack;
 
 #if __SSE2__
 #if __AVX__
 #if __AVX512F__
                 if (elempack == 16)
                 {
-                    __m512 _r0 = _mm512_load_ps(sptr);
-                    __m512 _r1 = _mm512_load_ps(sptr + stride_w * 16);
+                    __m512 _r0 = _mm512_load_blob_ps(sptr);
+                    __m512 _r1 = _mm512_load_blob_ps(sptr + stride_w * 16);
                     transpose16x2_ps(_r0, _r1);
                     _mm512_store_ps(pp, _r0);
                     _mm512_store_ps(pp + 16, _r1);
@@ -4259,8 +4275,8 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
                 if (elempack == 8)
                 {
-                    __m256 _r0 = _mm256_load_ps(sptr);
-                    __m256 _r1 = _mm256_load_ps(sptr + stride_w * 8);
+                    __m256 _r0 = _mm256_load_blob_ps(sptr);
+                    __m256 _r1 = _mm256_load_blob_ps(sptr + stride_w * 8);
                     transpose8x2_ps(_r0, _r1);
                     _mm256_store_ps(pp, _r0);
                     _mm256_store_ps(pp + 8, _r1);
@@ -4269,8 +4285,8 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX__
                 if (elempack == 4)
                 {
-                    __m128 _r0 = _mm_load_ps(sptr);
-                    __m128 _r1 = _mm_load_ps(sptr + stride_w * 4);
+                    __m128 _r0 = _mm_load_blob_ps(sptr);
+                    __m128 _r1 = _mm_load_blob_ps(sptr + stride_w * 4);
                     __m128 _tmp0 = _mm_unpacklo_ps(_r0, _r1);
                     __m128 _tmp1 = _mm_unpackhi_ps(_r0, _r1);
                     _mm_store_ps(pp, _tmp0);
@@ -4303,16 +4319,16 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
                 int y0 = stride_h * dy0 + dilation_h * u;
                 int y1 = stride_h * dy1 + dilation_h * u;
 
-                const float* sptr0 = img.row(y0) + x0 * elempack;
-                const float* sptr1 = img.row(y1) + x1 * elempack;
+                const TB* sptr0 = img.row<const TB>(y0) + x0 * elempack;
+                const TB* sptr1 = img.row<const TB>(y1) + x1 * elempack;
 
 #if __SSE2__
 #if __AVX__
 #if __AVX512F__
                 if (elempack == 16)
                 {
-                    __m512 _r0 = _mm512_load_ps(sptr0);
-                    __m512 _r1 = _mm512_load_ps(sptr1);
+                    __m512 _r0 = _mm512_load_blob_ps(sptr0);
+                    __m512 _r1 = _mm512_load_blob_ps(sptr1);
                     transpose16x2_ps(_r0, _r1);
                     _mm512_store_ps(pp, _r0);
                     _mm512_store_ps(pp + 16, _r1);
@@ -4321,8 +4337,8 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX512F__
                 if (elempack == 8)
                 {
-                    __m256 _r0 = _mm256_load_ps(sptr0);
-                    __m256 _r1 = _mm256_load_ps(sptr1);
+                    __m256 _r0 = _mm256_load_blob_ps(sptr0);
+                    __m256 _r1 = _mm256_load_blob_ps(sptr1);
                     transpose8x2_ps(_r0, _r1);
                     _mm256_store_ps(pp, _r0);
                     _mm256_store_ps(pp + 8, _r1);
@@ -4331,8 +4347,8 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
 #endif // __AVX__
                 if (elempack == 4)
                 {
-                    __m128 _r0 = _mm_load_ps(sptr0);
-                    __m128 _r1 = _mm_load_ps(sptr1);
+                    __m128 _r0 = _mm_load_blob_ps(sptr0);
+                    __m128 _r1 = _mm_load_blob_ps(sptr1);
                     __m128 _tmp0 = _mm_unpacklo_ps(_r0, _r1);
                     __m128 _tmp1 = _mm_unpackhi_ps(_r0, _r1);
                     _mm_store_ps(pp, _tmp0);
@@ -4367,26 +4383,26 @@ static inline void convolution_im2col_input_tile_impl(const Mat& bottom_blob, Ma
             int x = stride_w * dx + dilation_w * v;
             int y = stride_h * dy + dilation_h * u;
 
-            const float* sptr = img.row(y) + x * elempack;
+            const TB* sptr = img.row<const TB>(y) + x * elempack;
 
 #if __SSE2__
 #if __AVX__
 #if __AVX512F__
             if (elempack == 16)
             {
-                _mm512_store_ps(pp, _mm512_load_ps(sptr));
+                _mm512_store_ps(pp, _mm512_load_blob_ps(sptr));
                 pp += 16;
             }
 #endif // __AVX512F__
             if (elempack == 8)
             {
-                _mm256_store_ps(pp, _mm256_load_ps(sptr));
+                _mm256_store_ps(pp, _mm256_load_blob_ps(sptr));
                 pp += 8;
             }
 #endif // __AVX__
             if (elempack == 4)
             {
-                _mm_store_ps(pp, _mm_load_ps(sptr));
+                _mm_store_ps(pp, _mm_load_blob_ps(sptr));
                 pp += 4;
             }
 #endif // __SSE2__
@@ -4408,7 +4424,7 @@ void convolution_im2col_input_tile_avx(const Mat& bottom_blob, Mat& B, int j, in
 void convolution_im2col_input_tile(const Mat& bottom_blob, Mat& B, int j, int max_jj, int k, int max_kk)
 #endif
 {
-    convolution_im2col_input_tile_impl(bottom_blob, B, j, max_jj, k, max_kk, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h);
+    convolution_im2col_input_tile_impl<float>(bottom_blob, B, j, max_jj, k, max_kk, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h);
 }
 
 #if __AVX512F__
@@ -4438,7 +4454,7 @@ static void convolution_im2col_input_tile(const Mat& bottom_blob, Mat& B, int j,
 {
     if (kernel_w == 1 && kernel_h == 1 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
     {
-        convolution_im2col_input_tile_conv1x1s1d1(bottom_blob, B, j, max_jj, k, max_kk);
+        convolution_im2col_input_tile_conv1x1s1d1<float>(bottom_blob, B, j, max_jj, k, max_kk);
         return;
     }
 
@@ -4514,10 +4530,11 @@ static void convolution_im2col_input_tile(const Mat& bottom_blob, Mat& B, int j,
         return;
     }
 
-    convolution_im2col_input_tile_impl(bottom_blob, B, j, max_jj, k, max_kk, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h);
+    convolution_im2col_input_tile_impl<float>(bottom_blob, B, j, max_jj, k, max_kk, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h);
 }
 
-static void convolution_im2col_gemm_transform_kernel(const Mat& kernel, Mat& AT, int inch, int outch, int kernel_w, int kernel_h, const Option& opt)
+// elempack is the packing of the input blobs the weights will be used with
+static void convolution_im2col_gemm_transform_kernel(const Mat& kernel, Mat& AT, int inch, int outch, int kernel_w, int kernel_h, int elempack, const Option& opt)
 {
     // NCNN_LOGE("convolution_im2col_gemm_transform_kernel");
     const int maxk = kernel_w * kernel_h;
@@ -4530,20 +4547,6 @@ static void convolution_im2col_gemm_transform_kernel(const Mat& kernel, Mat& AT,
 
     const int nn_M = (M + TILE_M - 1) / TILE_M;
 
-    int elempack = 1;
-#if __SSE2__
-    if (opt.use_packing_layout)
-    {
-#if __AVX512F__
-        elempack = inch % 16 == 0 ? 16 : inch % 8 == 0 ? 8 : inch % 4 == 0 ? 4 : 1;
-#elif __AVX__
-        elempack = inch % 8 == 0 ? 8 : inch % 4 == 0 ? 4 : 1;
-#else
-        elempack = inch % 4 == 0 ? 4 : 1;
-#endif
-    }
-#endif // __SSE2__
-
     // maxk-inch-outch to pa-maxk-inch/pa-outch
     Mat A_data;
     if (maxk == 1)
@@ -4595,6 +4598,25 @@ static void convolution_im2col_gemm_transform_kernel(const Mat& kernel, Mat& AT,
     }
 }
 
+static void convolution_im2col_gemm_transform_kernel(const Mat& kernel, Mat& AT, int inch, int outch, int kernel_w, int kernel_h, const Option& opt)
+{
+    int elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        elempack = inch % 16 == 0 ? 16 : inch % 8 == 0 ? 8 : inch % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        elempack = inch % 8 == 0 ? 8 : inch % 4 == 0 ? 4 : 1;
+#else
+        elempack = inch % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    convolution_im2col_gemm_transform_kernel(kernel, AT, inch, outch, kernel_w, kernel_h, elempack, opt);
+}
+
 static int convolution_im2col_gemm(const Mat& bottom_blob, Mat& top_blob, const Mat& AT, const Mat& bias, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int nT, const Option& opt)
 {
     const int maxk = kernel_w * kernel_h;
@@ -4606,6 +4628,9 @@ static int convolution_im2col_gemm(const Mat& bottom_blob, Mat& top_blob, const
     int TILE_M, TILE_N, TILE_K;
     convolution_im2col_gemm_get_optimal_tile_mnk(M, N, K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -4676,3 +4701,102 @@ static int convolution_im2col_gemm(const Mat& bottom_blob, Mat& top_blob, const
 
     return 0;
 }
+
+#if NCNN_BF16
+// bf16 blobs and weights, the im2col tiles are widened to fp32 and the output tiles narrowed on store
+static void convolution_im2col_input_tile_bf16s(const Mat& bottom_blob, Mat& B, int j, int max_jj, int k, int max_kk, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h)
+{
+    if (kernel_w == 1 && kernel_h == 1 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
+    {
+        convolution_im2col_input_tile_conv1x1s1d1<bfloat16_t>(bottom_blob, B, j, max_jj, k, max_kk);
+        return;
+    }
+
+    convolution_im2col_input_tile_impl<bfloat16_t>(bottom_blob, B, j, max_jj, k, max_kk, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h);
+}
+
+static int convolution_im2col_gemm_bf16s(const Mat& bottom_blob, Mat& top_blob, const Mat& AT, const Mat& bias, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int nT, const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h;
+
+    const int M = top_blob.c * top_blob.elempack;
+    const int N = top_blob.w * top_blob.h;
+    const int K = bottom_blob.c * bottom_blob.elempack * maxk;
+
+    int TILE_M, TILE_N, TILE_K;
+    convolution_im2col_gemm_get_optimal_tile_mnk(M, N, K, TILE_M, TILE_N, TILE_K, nT);
+
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
+    const int nn_M = (M + TILE_M - 1) / TILE_M;
+    const int nn_N = (N + TILE_N - 1) / TILE_N;
+    const int nn_K = (K + TILE_K - 1) / TILE_K;
+
+    // NCNN_LOGE("TILE M/N/K = %d %d %d -> %d %d %d", M, N, K, TILE_M, TILE_N, TILE_K);
+
+    Mat BT(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 4u, opt.workspace_allocator);
+    if (BT.empty())
+        return -100;
+
+    const int nn_NK = nn_N * nn_K;
+
+    #pragma omp parallel for num_threads(nT)
+    for (int ppjk = 0; ppjk < nn_NK; ppjk++)
+    {
+        const int ppj = ppjk / nn_K;
+        const int ppk = ppjk % nn_K;
+
+        const int j = ppj * TILE_N;
+        const int k = ppk * TILE_K;
+
+        const int max_jj = std::min((N - j), TILE_N);
+        const int max_kk = std::min((K - k), TILE_K);
+
+        Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
+
+        // im2col
+        convolution_im2col_input_tile_bf16s(bottom_blob, BT_tile, j, max_jj, k, max_kk, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h);
+    }
+
+    Mat topT_tileX;
+    if (K > TILE_K)
+    {
+        topT_tileX.create(TILE_N * TILE_M, 1, nT, 4u, opt.workspace_allocator);
+        if (topT_tileX.empty())
+            return -100;
+    }
+
+    #pragma omp parallel for num_threads(nT)
+    for (int ppj = 0; ppj < nn_M; ppj++)
+    {
+        const int i = ppj * TILE_M;
+
+        Mat topT_tile;
+        if (K > TILE_K)
+            topT_tile = topT_tileX.channel(get_omp_thread_num());
+
+        const int max_ii = std::min((M - i), TILE_M);
+
+        for (int j = 0; j < N; j += TILE_N)
+        {
+            const int max_jj = std::min((N - j), TILE_N);
+
+            for (int k = 0; k < K; k += TILE_K)
+            {
+                const int max_kk = std::min((K - k), TILE_K);
+
+                const Mat AT_tile = AT.channel(i / TILE_M).row_range(k / TILE_K, 1);
+
+                const Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
+
+                bool k_end = k + TILE_K >= K;
+
+                convolution_gemm_transB_packed_tile_impl<bfloat16_t, bfloat16_t>(AT_tile, BT_tile, bias, topT_tile, top_blob, i, max_ii, j, max_jj, k, max_kk, k_end);
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_BF16
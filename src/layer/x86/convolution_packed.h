@@ -1059,7 +1059,8 @@ static void convolution_transform_kernel_packed(const Mat& kernel, Mat& kernel_t
     }
 }
 
-static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_tm, const Mat& bias_data, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int activation_type, const Mat& activation_params, const Option& opt)
+template<typename T, typename TB>
+static void convolution_packed_impl(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_tm, const Mat& bias_data, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int activation_type, const Mat& activation_params, const Option& opt)
 {
     const int w = bottom_blob.w;
     const int elempack = bottom_blob.elempack;
@@ -1115,7 +1116,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
         const int outh = top_blob.h;
         const int out_elempack = top_blob.elempack;
 
-        float* outptr = top_blob.channel(p / out_elempack);
+        TB* outptr = top_blob.channel(p / out_elempack);
 
         for (int i = 0; i < outh; i++)
         {
@@ -1131,35 +1132,35 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     _sum0 = _mm512_loadu_ps(bias_data_ptr + p);
                 }
 
-                const float* kptr = weight_data_tm.channel(p / 16);
+                const T* kptr = weight_data_tm.channel(p / 16);
 
                 int q = 0;
                 for (; q + 15 < inch; q += 16)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 16)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-
-                            __m512 _w0 = _mm512_load_ps(kptr + 16 * 0);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16 * 1);
-                            __m512 _w2 = _mm512_load_ps(kptr + 16 * 2);
-                            __m512 _w3 = _mm512_load_ps(kptr + 16 * 3);
-                            __m512 _w4 = _mm512_load_ps(kptr + 16 * 4);
-                            __m512 _w5 = _mm512_load_ps(kptr + 16 * 5);
-                            __m512 _w6 = _mm512_load_ps(kptr + 16 * 6);
-                            __m512 _w7 = _mm512_load_ps(kptr + 16 * 7);
-                            __m512 _w8 = _mm512_load_ps(kptr + 16 * 8);
-                            __m512 _w9 = _mm512_load_ps(kptr + 16 * 9);
-                            __m512 _wa = _mm512_load_ps(kptr + 16 * 10);
-                            __m512 _wb = _mm512_load_ps(kptr + 16 * 11);
-                            __m512 _wc = _mm512_load_ps(kptr + 16 * 12);
-                            __m512 _wd = _mm512_load_ps(kptr + 16 * 13);
-                            __m512 _we = _mm512_load_ps(kptr + 16 * 14);
-                            __m512 _wf = _mm512_load_ps(kptr + 16 * 15);
+                            const TB* r0s = r0 + space_ofs[k];
+
+                            __m512 _w0 = _mm512_load_weight_ps(kptr + 16 * 0);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16 * 1);
+                            __m512 _w2 = _mm512_load_weight_ps(kptr + 16 * 2);
+                            __m512 _w3 = _mm512_load_weight_ps(kptr + 16 * 3);
+                            __m512 _w4 = _mm512_load_weight_ps(kptr + 16 * 4);
+                            __m512 _w5 = _mm512_load_weight_ps(kptr + 16 * 5);
+                            __m512 _w6 = _mm512_load_weight_ps(kptr + 16 * 6);
+                            __m512 _w7 = _mm512_load_weight_ps(kptr + 16 * 7);
+                            __m512 _w8 = _mm512_load_weight_ps(kptr + 16 * 8);
+                            __m512 _w9 = _mm512_load_weight_ps(kptr + 16 * 9);
+                            __m512 _wa = _mm512_load_weight_ps(kptr + 16 * 10);
+                            __m512 _wb = _mm512_load_weight_ps(kptr + 16 * 11);
+                            __m512 _wc = _mm512_load_weight_ps(kptr + 16 * 12);
+                            __m512 _wd = _mm512_load_weight_ps(kptr + 16 * 13);
+                            __m512 _we = _mm512_load_weight_ps(kptr + 16 * 14);
+                            __m512 _wf = _mm512_load_weight_ps(kptr + 16 * 15);
 
                             _sum0 = _mm512_fmadd_ps(_w0, _mm512_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm512_fmadd_ps(_w1, _mm512_set1_ps(r0s[1]), _sum1);
@@ -1183,29 +1184,29 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 8)
                     {
-                        const float* r1 = r0 + N;
+                        const TB* r1 = r0 + N;
 
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-                            const float* r1s = r1 + space_ofs[k];
-
-                            __m512 _w0 = _mm512_load_ps(kptr + 16 * 0);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16 * 1);
-                            __m512 _w2 = _mm512_load_ps(kptr + 16 * 2);
-                            __m512 _w3 = _mm512_load_ps(kptr + 16 * 3);
-                            __m512 _w4 = _mm512_load_ps(kptr + 16 * 4);
-                            __m512 _w5 = _mm512_load_ps(kptr + 16 * 5);
-                            __m512 _w6 = _mm512_load_ps(kptr + 16 * 6);
-                            __m512 _w7 = _mm512_load_ps(kptr + 16 * 7);
-                            __m512 _w8 = _mm512_load_ps(kptr + 16 * 8);
-                            __m512 _w9 = _mm512_load_ps(kptr + 16 * 9);
-                            __m512 _wa = _mm512_load_ps(kptr + 16 * 10);
-                            __m512 _wb = _mm512_load_ps(kptr + 16 * 11);
-                            __m512 _wc = _mm512_load_ps(kptr + 16 * 12);
-                            __m512 _wd = _mm512_load_ps(kptr + 16 * 13);
-                            __m512 _we = _mm512_load_ps(kptr + 16 * 14);
-                            __m512 _wf = _mm512_load_ps(kptr + 16 * 15);
+                            const TB* r0s = r0 + space_ofs[k];
+                            const TB* r1s = r1 + space_ofs[k];
+
+                            __m512 _w0 = _mm512_load_weight_ps(kptr + 16 * 0);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16 * 1);
+                            __m512 _w2 = _mm512_load_weight_ps(kptr + 16 * 2);
+                            __m512 _w3 = _mm512_load_weight_ps(kptr + 16 * 3);
+                            __m512 _w4 = _mm512_load_weight_ps(kptr + 16 * 4);
+                            __m512 _w5 = _mm512_load_weight_ps(kptr + 16 * 5);
+                            __m512 _w6 = _mm512_load_weight_ps(kptr + 16 * 6);
+                            __m512 _w7 = _mm512_load_weight_ps(kptr + 16 * 7);
+                            __m512 _w8 = _mm512_load_weight_ps(kptr + 16 * 8);
+                            __m512 _w9 = _mm512_load_weight_ps(kptr + 16 * 9);
+                            __m512 _wa = _mm512_load_weight_ps(kptr + 16 * 10);
+                            __m512 _wb = _mm512_load_weight_ps(kptr + 16 * 11);
+                            __m512 _wc = _mm512_load_weight_ps(kptr + 16 * 12);
+                            __m512 _wd = _mm512_load_weight_ps(kptr + 16 * 13);
+                            __m512 _we = _mm512_load_weight_ps(kptr + 16 * 14);
+                            __m512 _wf = _mm512_load_weight_ps(kptr + 16 * 15);
 
                             _sum0 = _mm512_fmadd_ps(_w0, _mm512_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm512_fmadd_ps(_w1, _mm512_set1_ps(r0s[1]), _sum1);
@@ -1229,33 +1230,33 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 4)
                     {
-                        const float* r1 = r0 + N;
-                        const float* r2 = r0 + N * 2;
-                        const float* r3 = r0 + N * 3;
+                        const TB* r1 = r0 + N;
+                        const TB* r2 = r0 + N * 2;
+                        const TB* r3 = r0 + N * 3;
 
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-                            const float* r1s = r1 + space_ofs[k];
-                            const float* r2s = r2 + space_ofs[k];
-                            const float* r3s = r3 + space_ofs[k];
-
-                            __m512 _w0 = _mm512_load_ps(kptr + 16 * 0);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16 * 1);
-                            __m512 _w2 = _mm512_load_ps(kptr + 16 * 2);
-                            __m512 _w3 = _mm512_load_ps(kptr + 16 * 3);
-                            __m512 _w4 = _mm512_load_ps(kptr + 16 * 4);
-                            __m512 _w5 = _mm512_load_ps(kptr + 16 * 5);
-                            __m512 _w6 = _mm512_load_ps(kptr + 16 * 6);
-                            __m512 _w7 = _mm512_load_ps(kptr + 16 * 7);
-                            __m512 _w8 = _mm512_load_ps(kptr + 16 * 8);
-                            __m512 _w9 = _mm512_load_ps(kptr + 16 * 9);
-                            __m512 _wa = _mm512_load_ps(kptr + 16 * 10);
-                            __m512 _wb = _mm512_load_ps(kptr + 16 * 11);
-                            __m512 _wc = _mm512_load_ps(kptr + 16 * 12);
-                            __m512 _wd = _mm512_load_ps(kptr + 16 * 13);
-                            __m512 _we = _mm512_load_ps(kptr + 16 * 14);
-                            __m512 _wf = _mm512_load_ps(kptr + 16 * 15);
+                            const TB* r0s = r0 + space_ofs[k];
+                            const TB* r1s = r1 + space_ofs[k];
+                            const TB* r2s = r2 + space_ofs[k];
+                            const TB* r3s = r3 + space_ofs[k];
+
+                            __m512 _w0 = _mm512_load_weight_ps(kptr + 16 * 0);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16 * 1);
+                            __m512 _w2 = _mm512_load_weight_ps(kptr + 16 * 2);
+                            __m512 _w3 = _mm512_load_weight_ps(kptr + 16 * 3);
+                            __m512 _w4 = _mm512_load_weight_ps(kptr + 16 * 4);
+                            __m512 _w5 = _mm512_load_weight_ps(kptr + 16 * 5);
+                            __m512 _w6 = _mm512_load_weight_ps(kptr + 16 * 6);
+                            __m512 _w7 = _mm512_load_weight_ps(kptr + 16 * 7);
+                            __m512 _w8 = _mm512_load_weight_ps(kptr + 16 * 8);
+                            __m512 _w9 = _mm512_load_weight_ps(kptr + 16 * 9);
+                            __m512 _wa = _mm512_load_weight_ps(kptr + 16 * 10);
+                            __m512 _wb = _mm512_load_weight_ps(kptr + 16 * 11);
+                            __m512 _wc = _mm512_load_weight_ps(kptr + 16 * 12);
+                            __m512 _wd = _mm512_load_weight_ps(kptr + 16 * 13);
+                            __m512 _we = _mm512_load_weight_ps(kptr + 16 * 14);
+                            __m512 _wf = _mm512_load_weight_ps(kptr + 16 * 15);
 
                             _sum0 = _mm512_fmadd_ps(_w0, _mm512_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm512_fmadd_ps(_w1, _mm512_set1_ps(r0s[1]), _sum1);
@@ -1283,22 +1284,22 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m512 _w0 = _mm512_load_ps(kptr + 16 * 0);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16 * 1);
-                            __m512 _w2 = _mm512_load_ps(kptr + 16 * 2);
-                            __m512 _w3 = _mm512_load_ps(kptr + 16 * 3);
-                            __m512 _w4 = _mm512_load_ps(kptr + 16 * 4);
-                            __m512 _w5 = _mm512_load_ps(kptr + 16 * 5);
-                            __m512 _w6 = _mm512_load_ps(kptr + 16 * 6);
-                            __m512 _w7 = _mm512_load_ps(kptr + 16 * 7);
-                            __m512 _w8 = _mm512_load_ps(kptr + 16 * 8);
-                            __m512 _w9 = _mm512_load_ps(kptr + 16 * 9);
-                            __m512 _wa = _mm512_load_ps(kptr + 16 * 10);
-                            __m512 _wb = _mm512_load_ps(kptr + 16 * 11);
-                            __m512 _wc = _mm512_load_ps(kptr + 16 * 12);
-                            __m512 _wd = _mm512_load_ps(kptr + 16 * 13);
-                            __m512 _we = _mm512_load_ps(kptr + 16 * 14);
-                            __m512 _wf = _mm512_load_ps(kptr + 16 * 15);
+                            __m512 _w0 = _mm512_load_weight_ps(kptr + 16 * 0);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16 * 1);
+                            __m512 _w2 = _mm512_load_weight_ps(kptr + 16 * 2);
+                            __m512 _w3 = _mm512_load_weight_ps(kptr + 16 * 3);
+                            __m512 _w4 = _mm512_load_weight_ps(kptr + 16 * 4);
+                            __m512 _w5 = _mm512_load_weight_ps(kptr + 16 * 5);
+                            __m512 _w6 = _mm512_load_weight_ps(kptr + 16 * 6);
+                            __m512 _w7 = _mm512_load_weight_ps(kptr + 16 * 7);
+                            __m512 _w8 = _mm512_load_weight_ps(kptr + 16 * 8);
+                            __m512 _w9 = _mm512_load_weight_ps(kptr + 16 * 9);
+                            __m512 _wa = _mm512_load_weight_ps(kptr + 16 * 10);
+                            __m512 _wb = _mm512_load_weight_ps(kptr + 16 * 11);
+                            __m512 _wc = _mm512_load_weight_ps(kptr + 16 * 12);
+                            __m512 _wd = _mm512_load_weight_ps(kptr + 16 * 13);
+                            __m512 _we = _mm512_load_weight_ps(kptr + 16 * 14);
+                            __m512 _wf = _mm512_load_weight_ps(kptr + 16 * 15);
 
                             _sum0 = _mm512_fmadd_ps(_w0, _mm512_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm512_fmadd_ps(_w1, _mm512_set1_ps(r0[sok + N]), _sum1);
@@ -1323,22 +1324,22 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q + 7 < inch; q += 8)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 8)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
+                            const TB* r0s = r0 + space_ofs[k];
 
-                            __m512 _w0 = _mm512_load_ps(kptr + 16 * 0);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16 * 1);
-                            __m512 _w2 = _mm512_load_ps(kptr + 16 * 2);
-                            __m512 _w3 = _mm512_load_ps(kptr + 16 * 3);
-                            __m512 _w4 = _mm512_load_ps(kptr + 16 * 4);
-                            __m512 _w5 = _mm512_load_ps(kptr + 16 * 5);
-                            __m512 _w6 = _mm512_load_ps(kptr + 16 * 6);
-                            __m512 _w7 = _mm512_load_ps(kptr + 16 * 7);
+                            __m512 _w0 = _mm512_load_weight_ps(kptr + 16 * 0);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16 * 1);
+                            __m512 _w2 = _mm512_load_weight_ps(kptr + 16 * 2);
+                            __m512 _w3 = _mm512_load_weight_ps(kptr + 16 * 3);
+                            __m512 _w4 = _mm512_load_weight_ps(kptr + 16 * 4);
+                            __m512 _w5 = _mm512_load_weight_ps(kptr + 16 * 5);
+                            __m512 _w6 = _mm512_load_weight_ps(kptr + 16 * 6);
+                            __m512 _w7 = _mm512_load_weight_ps(kptr + 16 * 7);
 
                             _sum0 = _mm512_fmadd_ps(_w0, _mm512_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm512_fmadd_ps(_w1, _mm512_set1_ps(r0s[1]), _sum1);
@@ -1354,21 +1355,21 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 4)
                     {
-                        const float* r1 = r0 + N;
+                        const TB* r1 = r0 + N;
 
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-                            const float* r1s = r1 + space_ofs[k];
-
-                            __m512 _w0 = _mm512_load_ps(kptr + 16 * 0);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16 * 1);
-                            __m512 _w2 = _mm512_load_ps(kptr + 16 * 2);
-                            __m512 _w3 = _mm512_load_ps(kptr + 16 * 3);
-                            __m512 _w4 = _mm512_load_ps(kptr + 16 * 4);
-                            __m512 _w5 = _mm512_load_ps(kptr + 16 * 5);
-                            __m512 _w6 = _mm512_load_ps(kptr + 16 * 6);
-                            __m512 _w7 = _mm512_load_ps(kptr + 16 * 7);
+                            const TB* r0s = r0 + space_ofs[k];
+                            const TB* r1s = r1 + space_ofs[k];
+
+                            __m512 _w0 = _mm512_load_weight_ps(kptr + 16 * 0);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16 * 1);
+                            __m512 _w2 = _mm512_load_weight_ps(kptr + 16 * 2);
+                            __m512 _w3 = _mm512_load_weight_ps(kptr + 16 * 3);
+                            __m512 _w4 = _mm512_load_weight_ps(kptr + 16 * 4);
+                            __m512 _w5 = _mm512_load_weight_ps(kptr + 16 * 5);
+                            __m512 _w6 = _mm512_load_weight_ps(kptr + 16 * 6);
+                            __m512 _w7 = _mm512_load_weight_ps(kptr + 16 * 7);
 
                             _sum0 = _mm512_fmadd_ps(_w0, _mm512_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm512_fmadd_ps(_w1, _mm512_set1_ps(r0s[1]), _sum1);
@@ -1388,14 +1389,14 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m512 _w0 = _mm512_load_ps(kptr + 16 * 0);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16 * 1);
-                            __m512 _w2 = _mm512_load_ps(kptr + 16 * 2);
-                            __m512 _w3 = _mm512_load_ps(kptr + 16 * 3);
-                            __m512 _w4 = _mm512_load_ps(kptr + 16 * 4);
-                            __m512 _w5 = _mm512_load_ps(kptr + 16 * 5);
-                            __m512 _w6 = _mm512_load_ps(kptr + 16 * 6);
-                            __m512 _w7 = _mm512_load_ps(kptr + 16 * 7);
+                            __m512 _w0 = _mm512_load_weight_ps(kptr + 16 * 0);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16 * 1);
+                            __m512 _w2 = _mm512_load_weight_ps(kptr + 16 * 2);
+                            __m512 _w3 = _mm512_load_weight_ps(kptr + 16 * 3);
+                            __m512 _w4 = _mm512_load_weight_ps(kptr + 16 * 4);
+                            __m512 _w5 = _mm512_load_weight_ps(kptr + 16 * 5);
+                            __m512 _w6 = _mm512_load_weight_ps(kptr + 16 * 6);
+                            __m512 _w7 = _mm512_load_weight_ps(kptr + 16 * 7);
 
                             _sum0 = _mm512_fmadd_ps(_w0, _mm512_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm512_fmadd_ps(_w1, _mm512_set1_ps(r0[sok + N]), _sum1);
@@ -1412,18 +1413,18 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q + 3 < inch; q += 4)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 4)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
+                            const TB* r0s = r0 + space_ofs[k];
 
-                            __m512 _w0 = _mm512_load_ps(kptr);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16);
-                            __m512 _w2 = _mm512_load_ps(kptr + 32);
-                            __m512 _w3 = _mm512_load_ps(kptr + 48);
+                            __m512 _w0 = _mm512_load_weight_ps(kptr);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16);
+                            __m512 _w2 = _mm512_load_weight_ps(kptr + 32);
+                            __m512 _w3 = _mm512_load_weight_ps(kptr + 48);
 
                             _sum0 = _mm512_fmadd_ps(_w0, _mm512_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm512_fmadd_ps(_w1, _mm512_set1_ps(r0s[1]), _sum1);
@@ -1439,10 +1440,10 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m512 _w0 = _mm512_load_ps(kptr);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16);
-                            __m512 _w2 = _mm512_load_ps(kptr + 32);
-                            __m512 _w3 = _mm512_load_ps(kptr + 48);
+                            __m512 _w0 = _mm512_load_weight_ps(kptr);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16);
+                            __m512 _w2 = _mm512_load_weight_ps(kptr + 32);
+                            __m512 _w3 = _mm512_load_weight_ps(kptr + 48);
 
                             _sum0 = _mm512_fmadd_ps(_w0, _mm512_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm512_fmadd_ps(_w1, _mm512_set1_ps(r0[sok + N]), _sum1);
@@ -1455,7 +1456,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q + 1 < inch; q += 2)
                 {
-                    const float* r0 = bottom_blob.channel(q).row(i * stride_h) + j * stride_w;
+                    const TB* r0 = bottom_blob.channel(q).row<const TB>(i * stride_h) + j * stride_w;
 
                     // if (elempack == 1)
                     {
@@ -1463,8 +1464,8 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m512 _w0 = _mm512_load_ps(kptr);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16);
+                            __m512 _w0 = _mm512_load_weight_ps(kptr);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16);
 
                             _sum0 = _mm512_fmadd_ps(_w0, _mm512_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm512_fmadd_ps(_w1, _mm512_set1_ps(r0[sok + N]), _sum1);
@@ -1475,14 +1476,14 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q < inch; q++)
                 {
-                    const float* r0 = bottom_blob.channel(q).row(i * stride_h) + j * stride_w;
+                    const TB* r0 = bottom_blob.channel(q).row<const TB>(i * stride_h) + j * stride_w;
 
                     // if (elempack == 1)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             __m512 _val = _mm512_set1_ps(r0[space_ofs[k]]);
-                            __m512 _w = _mm512_load_ps(kptr);
+                            __m512 _w = _mm512_load_weight_ps(kptr);
                             _sum0 = _mm512_fmadd_ps(_val, _w, _sum0);
 
                             kptr += 16;
@@ -1498,21 +1499,21 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
 
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr, _sum0);
+                    _mm512_store_blob_ps(outptr, _sum0);
                     outptr += 16;
                 }
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr, _mm512_extractf32x8_ps(_sum0, 0));
-                    _mm256_store_ps(outptr + M, _mm512_extractf32x8_ps(_sum0, 1));
+                    _mm256_store_blob_ps(outptr, _mm512_extractf32x8_ps(_sum0, 0));
+                    _mm256_store_blob_ps(outptr + M, _mm512_extractf32x8_ps(_sum0, 1));
                     outptr += 8;
                 }
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr, _mm512_extractf32x4_ps(_sum0, 0));
-                    _mm_store_ps(outptr + M, _mm512_extractf32x4_ps(_sum0, 1));
-                    _mm_store_ps(outptr + M * 2, _mm512_extractf32x4_ps(_sum0, 2));
-                    _mm_store_ps(outptr + M * 3, _mm512_extractf32x4_ps(_sum0, 3));
+                    _mm_store_blob_ps(outptr, _mm512_extractf32x4_ps(_sum0, 0));
+                    _mm_store_blob_ps(outptr + M, _mm512_extractf32x4_ps(_sum0, 1));
+                    _mm_store_blob_ps(outptr + M * 2, _mm512_extractf32x4_ps(_sum0, 2));
+                    _mm_store_blob_ps(outptr + M * 3, _mm512_extractf32x4_ps(_sum0, 3));
                     outptr += 4;
                 }
                 if (out_elempack == 1)
@@ -1558,7 +1559,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
         const int outh = top_blob.h;
         const int out_elempack = top_blob.elempack;
 
-        float* outptr = top_blob.channel(p / out_elempack);
+        TB* outptr = top_blob.channel(p / out_elempack);
 
         for (int i = 0; i < outh; i++)
         {
@@ -1575,39 +1576,39 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
 
 #if __AVX512F__
-                const float* kptr = weight_data_tm.channel(p / 16 + (p % 16) / 8);
+                const T* kptr = weight_data_tm.channel(p / 16 + (p % 16) / 8);
 #else
-                const float* kptr = weight_data_tm.channel(p / 8);
+                const T* kptr = weight_data_tm.channel(p / 8);
 #endif
 
                 int q = 0;
 #if __AVX512F__
                 for (; q + 15 < inch; q += 16)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 16)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-
-                            __m256 _w0 = _mm256_load_ps(kptr + 8 * 0);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8 * 1);
-                            __m256 _w2 = _mm256_load_ps(kptr + 8 * 2);
-                            __m256 _w3 = _mm256_load_ps(kptr + 8 * 3);
-                            __m256 _w4 = _mm256_load_ps(kptr + 8 * 4);
-                            __m256 _w5 = _mm256_load_ps(kptr + 8 * 5);
-                            __m256 _w6 = _mm256_load_ps(kptr + 8 * 6);
-                            __m256 _w7 = _mm256_load_ps(kptr + 8 * 7);
-                            __m256 _w8 = _mm256_load_ps(kptr + 8 * 8);
-                            __m256 _w9 = _mm256_load_ps(kptr + 8 * 9);
-                            __m256 _wa = _mm256_load_ps(kptr + 8 * 10);
-                            __m256 _wb = _mm256_load_ps(kptr + 8 * 11);
-                            __m256 _wc = _mm256_load_ps(kptr + 8 * 12);
-                            __m256 _wd = _mm256_load_ps(kptr + 8 * 13);
-                            __m256 _we = _mm256_load_ps(kptr + 8 * 14);
-                            __m256 _wf = _mm256_load_ps(kptr + 8 * 15);
+                            const TB* r0s = r0 + space_ofs[k];
+
+                            __m256 _w0 = _mm256_load_weight_ps(kptr + 8 * 0);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8 * 1);
+                            __m256 _w2 = _mm256_load_weight_ps(kptr + 8 * 2);
+                            __m256 _w3 = _mm256_load_weight_ps(kptr + 8 * 3);
+                            __m256 _w4 = _mm256_load_weight_ps(kptr + 8 * 4);
+                            __m256 _w5 = _mm256_load_weight_ps(kptr + 8 * 5);
+                            __m256 _w6 = _mm256_load_weight_ps(kptr + 8 * 6);
+                            __m256 _w7 = _mm256_load_weight_ps(kptr + 8 * 7);
+                            __m256 _w8 = _mm256_load_weight_ps(kptr + 8 * 8);
+                            __m256 _w9 = _mm256_load_weight_ps(kptr + 8 * 9);
+                            __m256 _wa = _mm256_load_weight_ps(kptr + 8 * 10);
+                            __m256 _wb = _mm256_load_weight_ps(kptr + 8 * 11);
+                            __m256 _wc = _mm256_load_weight_ps(kptr + 8 * 12);
+                            __m256 _wd = _mm256_load_weight_ps(kptr + 8 * 13);
+                            __m256 _we = _mm256_load_weight_ps(kptr + 8 * 14);
+                            __m256 _wf = _mm256_load_weight_ps(kptr + 8 * 15);
 
                             _sum0 = _mm256_fmadd_ps(_w0, _mm256_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm256_fmadd_ps(_w1, _mm256_set1_ps(r0s[1]), _sum1);
@@ -1631,29 +1632,29 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 8)
                     {
-                        const float* r1 = r0 + N;
+                        const TB* r1 = r0 + N;
 
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-                            const float* r1s = r1 + space_ofs[k];
-
-                            __m256 _w0 = _mm256_load_ps(kptr + 8 * 0);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8 * 1);
-                            __m256 _w2 = _mm256_load_ps(kptr + 8 * 2);
-                            __m256 _w3 = _mm256_load_ps(kptr + 8 * 3);
-                            __m256 _w4 = _mm256_load_ps(kptr + 8 * 4);
-                            __m256 _w5 = _mm256_load_ps(kptr + 8 * 5);
-                            __m256 _w6 = _mm256_load_ps(kptr + 8 * 6);
-                            __m256 _w7 = _mm256_load_ps(kptr + 8 * 7);
-                            __m256 _w8 = _mm256_load_ps(kptr + 8 * 8);
-                            __m256 _w9 = _mm256_load_ps(kptr + 8 * 9);
-                            __m256 _wa = _mm256_load_ps(kptr + 8 * 10);
-                            __m256 _wb = _mm256_load_ps(kptr + 8 * 11);
-                            __m256 _wc = _mm256_load_ps(kptr + 8 * 12);
-                            __m256 _wd = _mm256_load_ps(kptr + 8 * 13);
-                            __m256 _we = _mm256_load_ps(kptr + 8 * 14);
-                            __m256 _wf = _mm256_load_ps(kptr + 8 * 15);
+                            const TB* r0s = r0 + space_ofs[k];
+                            const TB* r1s = r1 + space_ofs[k];
+
+                            __m256 _w0 = _mm256_load_weight_ps(kptr + 8 * 0);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8 * 1);
+                            __m256 _w2 = _mm256_load_weight_ps(kptr + 8 * 2);
+                            __m256 _w3 = _mm256_load_weight_ps(kptr + 8 * 3);
+                            __m256 _w4 = _mm256_load_weight_ps(kptr + 8 * 4);
+                            __m256 _w5 = _mm256_load_weight_ps(kptr + 8 * 5);
+                            __m256 _w6 = _mm256_load_weight_ps(kptr + 8 * 6);
+                            __m256 _w7 = _mm256_load_weight_ps(kptr + 8 * 7);
+                            __m256 _w8 = _mm256_load_weight_ps(kptr + 8 * 8);
+                            __m256 _w9 = _mm256_load_weight_ps(kptr + 8 * 9);
+                            __m256 _wa = _mm256_load_weight_ps(kptr + 8 * 10);
+                            __m256 _wb = _mm256_load_weight_ps(kptr + 8 * 11);
+                            __m256 _wc = _mm256_load_weight_ps(kptr + 8 * 12);
+                            __m256 _wd = _mm256_load_weight_ps(kptr + 8 * 13);
+                            __m256 _we = _mm256_load_weight_ps(kptr + 8 * 14);
+                            __m256 _wf = _mm256_load_weight_ps(kptr + 8 * 15);
 
                             _sum0 = _mm256_fmadd_ps(_w0, _mm256_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm256_fmadd_ps(_w1, _mm256_set1_ps(r0s[1]), _sum1);
@@ -1677,33 +1678,33 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 4)
                     {
-                        const float* r1 = r0 + N;
-                        const float* r2 = r0 + N * 2;
-                        const float* r3 = r0 + N * 3;
+                        const TB* r1 = r0 + N;
+                        const TB* r2 = r0 + N * 2;
+                        const TB* r3 = r0 + N * 3;
 
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-                            const float* r1s = r1 + space_ofs[k];
-                            const float* r2s = r2 + space_ofs[k];
-                            const float* r3s = r3 + space_ofs[k];
-
-                            __m256 _w0 = _mm256_load_ps(kptr + 8 * 0);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8 * 1);
-                            __m256 _w2 = _mm256_load_ps(kptr + 8 * 2);
-                            __m256 _w3 = _mm256_load_ps(kptr + 8 * 3);
-                            __m256 _w4 = _mm256_load_ps(kptr + 8 * 4);
-                            __m256 _w5 = _mm256_load_ps(kptr + 8 * 5);
-                            __m256 _w6 = _mm256_load_ps(kptr + 8 * 6);
-                            __m256 _w7 = _mm256_load_ps(kptr + 8 * 7);
-                            __m256 _w8 = _mm256_load_ps(kptr + 8 * 8);
-                            __m256 _w9 = _mm256_load_ps(kptr + 8 * 9);
-                            __m256 _wa = _mm256_load_ps(kptr + 8 * 10);
-                            __m256 _wb = _mm256_load_ps(kptr + 8 * 11);
-                            __m256 _wc = _mm256_load_ps(kptr + 8 * 12);
-                            __m256 _wd = _mm256_load_ps(kptr + 8 * 13);
-                            __m256 _we = _mm256_load_ps(kptr + 8 * 14);
-                            __m256 _wf = _mm256_load_ps(kptr + 8 * 15);
+                            const TB* r0s = r0 + space_ofs[k];
+                            const TB* r1s = r1 + space_ofs[k];
+                            const TB* r2s = r2 + space_ofs[k];
+                            const TB* r3s = r3 + space_ofs[k];
+
+                            __m256 _w0 = _mm256_load_weight_ps(kptr + 8 * 0);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8 * 1);
+                            __m256 _w2 = _mm256_load_weight_ps(kptr + 8 * 2);
+                            __m256 _w3 = _mm256_load_weight_ps(kptr + 8 * 3);
+                            __m256 _w4 = _mm256_load_weight_ps(kptr + 8 * 4);
+                            __m256 _w5 = _mm256_load_weight_ps(kptr + 8 * 5);
+                            __m256 _w6 = _mm256_load_weight_ps(kptr + 8 * 6);
+                            __m256 _w7 = _mm256_load_weight_ps(kptr + 8 * 7);
+                            __m256 _w8 = _mm256_load_weight_ps(kptr + 8 * 8);
+                            __m256 _w9 = _mm256_load_weight_ps(kptr + 8 * 9);
+                            __m256 _wa = _mm256_load_weight_ps(kptr + 8 * 10);
+                            __m256 _wb = _mm256_load_weight_ps(kptr + 8 * 11);
+                            __m256 _wc = _mm256_load_weight_ps(kptr + 8 * 12);
+                            __m256 _wd = _mm256_load_weight_ps(kptr + 8 * 13);
+                            __m256 _we = _mm256_load_weight_ps(kptr + 8 * 14);
+                            __m256 _wf = _mm256_load_weight_ps(kptr + 8 * 15);
 
                             _sum0 = _mm256_fmadd_ps(_w0, _mm256_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm256_fmadd_ps(_w1, _mm256_set1_ps(r0s[1]), _sum1);
@@ -1731,22 +1732,22 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m256 _w0 = _mm256_load_ps(kptr + 8 * 0);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8 * 1);
-                            __m256 _w2 = _mm256_load_ps(kptr + 8 * 2);
-                            __m256 _w3 = _mm256_load_ps(kptr + 8 * 3);
-                            __m256 _w4 = _mm256_load_ps(kptr + 8 * 4);
-                            __m256 _w5 = _mm256_load_ps(kptr + 8 * 5);
-                            __m256 _w6 = _mm256_load_ps(kptr + 8 * 6);
-                            __m256 _w7 = _mm256_load_ps(kptr + 8 * 7);
-                            __m256 _w8 = _mm256_load_ps(kptr + 8 * 8);
-                            __m256 _w9 = _mm256_load_ps(kptr + 8 * 9);
-                            __m256 _wa = _mm256_load_ps(kptr + 8 * 10);
-                            __m256 _wb = _mm256_load_ps(kptr + 8 * 11);
-                            __m256 _wc = _mm256_load_ps(kptr + 8 * 12);
-                            __m256 _wd = _mm256_load_ps(kptr + 8 * 13);
-                            __m256 _we = _mm256_load_ps(kptr + 8 * 14);
-                            __m256 _wf = _mm256_load_ps(kptr + 8 * 15);
+                            __m256 _w0 = _mm256_load_weight_ps(kptr + 8 * 0);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8 * 1);
+                            __m256 _w2 = _mm256_load_weight_ps(kptr + 8 * 2);
+                            __m256 _w3 = _mm256_load_weight_ps(kptr + 8 * 3);
+                            __m256 _w4 = _mm256_load_weight_ps(kptr + 8 * 4);
+                            __m256 _w5 = _mm256_load_weight_ps(kptr + 8 * 5);
+                            __m256 _w6 = _mm256_load_weight_ps(kptr + 8 * 6);
+                            __m256 _w7 = _mm256_load_weight_ps(kptr + 8 * 7);
+                            __m256 _w8 = _mm256_load_weight_ps(kptr + 8 * 8);
+                            __m256 _w9 = _mm256_load_weight_ps(kptr + 8 * 9);
+                            __m256 _wa = _mm256_load_weight_ps(kptr + 8 * 10);
+                            __m256 _wb = _mm256_load_weight_ps(kptr + 8 * 11);
+                            __m256 _wc = _mm256_load_weight_ps(kptr + 8 * 12);
+                            __m256 _wd = _mm256_load_weight_ps(kptr + 8 * 13);
+                            __m256 _we = _mm256_load_weight_ps(kptr + 8 * 14);
+                            __m256 _wf = _mm256_load_weight_ps(kptr + 8 * 15);
 
                             _sum0 = _mm256_fmadd_ps(_w0, _mm256_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm256_fmadd_ps(_w1, _mm256_set1_ps(r0[sok + N]), _sum1);
@@ -1772,22 +1773,22 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
 #endif // __AVX512F__
                 for (; q + 7 < inch; q += 8)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 8)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
+                            const TB* r0s = r0 + space_ofs[k];
 
-                            __m256 _w0 = _mm256_load_ps(kptr);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8);
-                            __m256 _w2 = _mm256_load_ps(kptr + 16);
-                            __m256 _w3 = _mm256_load_ps(kptr + 24);
-                            __m256 _w4 = _mm256_load_ps(kptr + 32);
-                            __m256 _w5 = _mm256_load_ps(kptr + 40);
-                            __m256 _w6 = _mm256_load_ps(kptr + 48);
-                            __m256 _w7 = _mm256_load_ps(kptr + 56);
+                            __m256 _w0 = _mm256_load_weight_ps(kptr);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8);
+                            __m256 _w2 = _mm256_load_weight_ps(kptr + 16);
+                            __m256 _w3 = _mm256_load_weight_ps(kptr + 24);
+                            __m256 _w4 = _mm256_load_weight_ps(kptr + 32);
+                            __m256 _w5 = _mm256_load_weight_ps(kptr + 40);
+                            __m256 _w6 = _mm256_load_weight_ps(kptr + 48);
+                            __m256 _w7 = _mm256_load_weight_ps(kptr + 56);
 
                             _sum0 = _mm256_comp_fmadd_ps(_w0, _mm256_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm256_comp_fmadd_ps(_w1, _mm256_set1_ps(r0s[1]), _sum1);
@@ -1803,21 +1804,21 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 4)
                     {
-                        const float* r1 = r0 + N;
+                        const TB* r1 = r0 + N;
 
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-                            const float* r1s = r1 + space_ofs[k];
-
-                            __m256 _w0 = _mm256_load_ps(kptr);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8);
-                            __m256 _w2 = _mm256_load_ps(kptr + 16);
-                            __m256 _w3 = _mm256_load_ps(kptr + 24);
-                            __m256 _w4 = _mm256_load_ps(kptr + 32);
-                            __m256 _w5 = _mm256_load_ps(kptr + 40);
-                            __m256 _w6 = _mm256_load_ps(kptr + 48);
-                            __m256 _w7 = _mm256_load_ps(kptr + 56);
+                            const TB* r0s = r0 + space_ofs[k];
+                            const TB* r1s = r1 + space_ofs[k];
+
+                            __m256 _w0 = _mm256_load_weight_ps(kptr);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8);
+                            __m256 _w2 = _mm256_load_weight_ps(kptr + 16);
+                            __m256 _w3 = _mm256_load_weight_ps(kptr + 24);
+                            __m256 _w4 = _mm256_load_weight_ps(kptr + 32);
+                            __m256 _w5 = _mm256_load_weight_ps(kptr + 40);
+                            __m256 _w6 = _mm256_load_weight_ps(kptr + 48);
+                            __m256 _w7 = _mm256_load_weight_ps(kptr + 56);
 
                             _sum0 = _mm256_comp_fmadd_ps(_w0, _mm256_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm256_comp_fmadd_ps(_w1, _mm256_set1_ps(r0s[1]), _sum1);
@@ -1837,14 +1838,14 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m256 _w0 = _mm256_load_ps(kptr);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8);
-                            __m256 _w2 = _mm256_load_ps(kptr + 16);
-                            __m256 _w3 = _mm256_load_ps(kptr + 24);
-                            __m256 _w4 = _mm256_load_ps(kptr + 32);
-                            __m256 _w5 = _mm256_load_ps(kptr + 40);
-                            __m256 _w6 = _mm256_load_ps(kptr + 48);
-                            __m256 _w7 = _mm256_load_ps(kptr + 56);
+                            __m256 _w0 = _mm256_load_weight_ps(kptr);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8);
+                            __m256 _w2 = _mm256_load_weight_ps(kptr + 16);
+                            __m256 _w3 = _mm256_load_weight_ps(kptr + 24);
+                            __m256 _w4 = _mm256_load_weight_ps(kptr + 32);
+                            __m256 _w5 = _mm256_load_weight_ps(kptr + 40);
+                            __m256 _w6 = _mm256_load_weight_ps(kptr + 48);
+                            __m256 _w7 = _mm256_load_weight_ps(kptr + 56);
 
                             _sum0 = _mm256_comp_fmadd_ps(_w0, _mm256_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm256_comp_fmadd_ps(_w1, _mm256_set1_ps(r0[sok + N]), _sum1);
@@ -1861,18 +1862,18 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q + 3 < inch; q += 4)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 4)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
+                            const TB* r0s = r0 + space_ofs[k];
 
-                            __m256 _w0 = _mm256_load_ps(kptr);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8);
-                            __m256 _w2 = _mm256_load_ps(kptr + 16);
-                            __m256 _w3 = _mm256_load_ps(kptr + 24);
+                            __m256 _w0 = _mm256_load_weight_ps(kptr);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8);
+                            __m256 _w2 = _mm256_load_weight_ps(kptr + 16);
+                            __m256 _w3 = _mm256_load_weight_ps(kptr + 24);
 
                             _sum0 = _mm256_comp_fmadd_ps(_w0, _mm256_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm256_comp_fmadd_ps(_w1, _mm256_set1_ps(r0s[1]), _sum1);
@@ -1888,10 +1889,10 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m256 _w0 = _mm256_load_ps(kptr);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8);
-                            __m256 _w2 = _mm256_load_ps(kptr + 16);
-                            __m256 _w3 = _mm256_load_ps(kptr + 24);
+                            __m256 _w0 = _mm256_load_weight_ps(kptr);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8);
+                            __m256 _w2 = _mm256_load_weight_ps(kptr + 16);
+                            __m256 _w3 = _mm256_load_weight_ps(kptr + 24);
 
                             _sum0 = _mm256_comp_fmadd_ps(_w0, _mm256_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm256_comp_fmadd_ps(_w1, _mm256_set1_ps(r0[sok + N]), _sum1);
@@ -1904,7 +1905,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q + 1 < inch; q += 2)
                 {
-                    const float* r0 = bottom_blob.channel(q).row(i * stride_h) + j * stride_w;
+                    const TB* r0 = bottom_blob.channel(q).row<const TB>(i * stride_h) + j * stride_w;
 
                     // if (elempack == 1)
                     {
@@ -1912,8 +1913,8 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m256 _w0 = _mm256_load_ps(kptr);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8);
+                            __m256 _w0 = _mm256_load_weight_ps(kptr);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8);
 
                             _sum0 = _mm256_comp_fmadd_ps(_w0, _mm256_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm256_comp_fmadd_ps(_w1, _mm256_set1_ps(r0[sok + N]), _sum1);
@@ -1924,14 +1925,14 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q < inch; q++)
                 {
-                    const float* r0 = bottom_blob.channel(q).row(i * stride_h) + j * stride_w;
+                    const TB* r0 = bottom_blob.channel(q).row<const TB>(i * stride_h) + j * stride_w;
 
                     // if (elempack == 1)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             __m256 _val = _mm256_set1_ps(r0[space_ofs[k]]);
-                            __m256 _w = _mm256_load_ps(kptr);
+                            __m256 _w = _mm256_load_weight_ps(kptr);
                             _sum0 = _mm256_comp_fmadd_ps(_val, _w, _sum0);
 
                             kptr += 8;
@@ -1947,13 +1948,13 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
 
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr, _sum0);
+                    _mm256_store_blob_ps(outptr, _sum0);
                     outptr += 8;
                 }
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr, _mm256_extractf128_ps(_sum0, 0));
-                    _mm_store_ps(outptr + M, _mm256_extractf128_ps(_sum0, 1));
+                    _mm_store_blob_ps(outptr, _mm256_extractf128_ps(_sum0, 0));
+                    _mm_store_blob_ps(outptr + M, _mm256_extractf128_ps(_sum0, 1));
                     outptr += 4;
                 }
                 if (out_elempack == 1)
@@ -1991,7 +1992,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
         const int outh = top_blob.h;
         const int out_elempack = top_blob.elempack;
 
-        float* outptr = top_blob.channel(p / out_elempack);
+        TB* outptr = top_blob.channel(p / out_elempack);
 
         for (int i = 0; i < outh; i++)
         {
@@ -2008,11 +2009,11 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
 
 #if __AVX512F__
-                const float* kptr = weight_data_tm.channel(p / 16 + (p % 16) / 8 + (p % 8) / 4);
+                const T* kptr = weight_data_tm.channel(p / 16 + (p % 16) / 8 + (p % 8) / 4);
 #elif __AVX__
-                const float* kptr = weight_data_tm.channel(p / 8 + (p % 8) / 4);
+                const T* kptr = weight_data_tm.channel(p / 8 + (p % 8) / 4);
 #else
-                const float* kptr = weight_data_tm.channel(p / 4);
+                const T* kptr = weight_data_tm.channel(p / 4);
 #endif
 
                 int q = 0;
@@ -2020,30 +2021,30 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
 #if __AVX512F__
                 for (; q + 15 < inch; q += 16)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 16)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-
-                            __m128 _w0 = _mm_load_ps(kptr + 4 * 0);
-                            __m128 _w1 = _mm_load_ps(kptr + 4 * 1);
-                            __m128 _w2 = _mm_load_ps(kptr + 4 * 2);
-                            __m128 _w3 = _mm_load_ps(kptr + 4 * 3);
-                            __m128 _w4 = _mm_load_ps(kptr + 4 * 4);
-                            __m128 _w5 = _mm_load_ps(kptr + 4 * 5);
-                            __m128 _w6 = _mm_load_ps(kptr + 4 * 6);
-                            __m128 _w7 = _mm_load_ps(kptr + 4 * 7);
-                            __m128 _w8 = _mm_load_ps(kptr + 4 * 8);
-                            __m128 _w9 = _mm_load_ps(kptr + 4 * 9);
-                            __m128 _wa = _mm_load_ps(kptr + 4 * 10);
-                            __m128 _wb = _mm_load_ps(kptr + 4 * 11);
-                            __m128 _wc = _mm_load_ps(kptr + 4 * 12);
-                            __m128 _wd = _mm_load_ps(kptr + 4 * 13);
-                            __m128 _we = _mm_load_ps(kptr + 4 * 14);
-                            __m128 _wf = _mm_load_ps(kptr + 4 * 15);
+                            const TB* r0s = r0 + space_ofs[k];
+
+                            __m128 _w0 = _mm_load_weight_ps(kptr + 4 * 0);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4 * 1);
+                            __m128 _w2 = _mm_load_weight_ps(kptr + 4 * 2);
+                            __m128 _w3 = _mm_load_weight_ps(kptr + 4 * 3);
+                            __m128 _w4 = _mm_load_weight_ps(kptr + 4 * 4);
+                            __m128 _w5 = _mm_load_weight_ps(kptr + 4 * 5);
+                            __m128 _w6 = _mm_load_weight_ps(kptr + 4 * 6);
+                            __m128 _w7 = _mm_load_weight_ps(kptr + 4 * 7);
+                            __m128 _w8 = _mm_load_weight_ps(kptr + 4 * 8);
+                            __m128 _w9 = _mm_load_weight_ps(kptr + 4 * 9);
+                            __m128 _wa = _mm_load_weight_ps(kptr + 4 * 10);
+                            __m128 _wb = _mm_load_weight_ps(kptr + 4 * 11);
+                            __m128 _wc = _mm_load_weight_ps(kptr + 4 * 12);
+                            __m128 _wd = _mm_load_weight_ps(kptr + 4 * 13);
+                            __m128 _we = _mm_load_weight_ps(kptr + 4 * 14);
+                            __m128 _wf = _mm_load_weight_ps(kptr + 4 * 15);
 
                             _sum0 = _mm_fmadd_ps(_w0, _mm_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm_fmadd_ps(_w1, _mm_set1_ps(r0s[1]), _sum1);
@@ -2067,29 +2068,29 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 8)
                     {
-                        const float* r1 = r0 + N;
+                        const TB* r1 = r0 + N;
 
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-                            const float* r1s = r1 + space_ofs[k];
-
-                            __m128 _w0 = _mm_load_ps(kptr + 4 * 0);
-                            __m128 _w1 = _mm_load_ps(kptr + 4 * 1);
-                            __m128 _w2 = _mm_load_ps(kptr + 4 * 2);
-                            __m128 _w3 = _mm_load_ps(kptr + 4 * 3);
-                            __m128 _w4 = _mm_load_ps(kptr + 4 * 4);
-                            __m128 _w5 = _mm_load_ps(kptr + 4 * 5);
-                            __m128 _w6 = _mm_load_ps(kptr + 4 * 6);
-                            __m128 _w7 = _mm_load_ps(kptr + 4 * 7);
-                            __m128 _w8 = _mm_load_ps(kptr + 4 * 8);
-                            __m128 _w9 = _mm_load_ps(kptr + 4 * 9);
-                            __m128 _wa = _mm_load_ps(kptr + 4 * 10);
-                            __m128 _wb = _mm_load_ps(kptr + 4 * 11);
-                            __m128 _wc = _mm_load_ps(kptr + 4 * 12);
-                            __m128 _wd = _mm_load_ps(kptr + 4 * 13);
-                            __m128 _we = _mm_load_ps(kptr + 4 * 14);
-                            __m128 _wf = _mm_load_ps(kptr + 4 * 15);
+                            const TB* r0s = r0 + space_ofs[k];
+                            const TB* r1s = r1 + space_ofs[k];
+
+                            __m128 _w0 = _mm_load_weight_ps(kptr + 4 * 0);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4 * 1);
+                            __m128 _w2 = _mm_load_weight_ps(kptr + 4 * 2);
+                            __m128 _w3 = _mm_load_weight_ps(kptr + 4 * 3);
+                            __m128 _w4 = _mm_load_weight_ps(kptr + 4 * 4);
+                            __m128 _w5 = _mm_load_weight_ps(kptr + 4 * 5);
+                            __m128 _w6 = _mm_load_weight_ps(kptr + 4 * 6);
+                            __m128 _w7 = _mm_load_weight_ps(kptr + 4 * 7);
+                            __m128 _w8 = _mm_load_weight_ps(kptr + 4 * 8);
+                            __m128 _w9 = _mm_load_weight_ps(kptr + 4 * 9);
+                            __m128 _wa = _mm_load_weight_ps(kptr + 4 * 10);
+                            __m128 _wb = _mm_load_weight_ps(kptr + 4 * 11);
+                            __m128 _wc = _mm_load_weight_ps(kptr + 4 * 12);
+                            __m128 _wd = _mm_load_weight_ps(kptr + 4 * 13);
+                            __m128 _we = _mm_load_weight_ps(kptr + 4 * 14);
+                            __m128 _wf = _mm_load_weight_ps(kptr + 4 * 15);
 
                             _sum0 = _mm_fmadd_ps(_w0, _mm_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm_fmadd_ps(_w1, _mm_set1_ps(r0s[1]), _sum1);
@@ -2113,33 +2114,33 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 4)
                     {
-                        const float* r1 = r0 + N;
-                        const float* r2 = r0 + N * 2;
-                        const float* r3 = r0 + N * 3;
+                        const TB* r1 = r0 + N;
+                        const TB* r2 = r0 + N * 2;
+                        const TB* r3 = r0 + N * 3;
 
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-                            const float* r1s = r1 + space_ofs[k];
-                            const float* r2s = r2 + space_ofs[k];
-                            const float* r3s = r3 + space_ofs[k];
-
-                            __m128 _w0 = _mm_load_ps(kptr + 4 * 0);
-                            __m128 _w1 = _mm_load_ps(kptr + 4 * 1);
-                            __m128 _w2 = _mm_load_ps(kptr + 4 * 2);
-                            __m128 _w3 = _mm_load_ps(kptr + 4 * 3);
-                            __m128 _w4 = _mm_load_ps(kptr + 4 * 4);
-                            __m128 _w5 = _mm_load_ps(kptr + 4 * 5);
-                            __m128 _w6 = _mm_load_ps(kptr + 4 * 6);
-                            __m128 _w7 = _mm_load_ps(kptr + 4 * 7);
-                            __m128 _w8 = _mm_load_ps(kptr + 4 * 8);
-                            __m128 _w9 = _mm_load_ps(kptr + 4 * 9);
-                            __m128 _wa = _mm_load_ps(kptr + 4 * 10);
-                            __m128 _wb = _mm_load_ps(kptr + 4 * 11);
-                            __m128 _wc = _mm_load_ps(kptr + 4 * 12);
-                            __m128 _wd = _mm_load_ps(kptr + 4 * 13);
-                            __m128 _we = _mm_load_ps(kptr + 4 * 14);
-                            __m128 _wf = _mm_load_ps(kptr + 4 * 15);
+                            const TB* r0s = r0 + space_ofs[k];
+                            const TB* r1s = r1 + space_ofs[k];
+                            const TB* r2s = r2 + space_ofs[k];
+                            const TB* r3s = r3 + space_ofs[k];
+
+                            __m128 _w0 = _mm_load_weight_ps(kptr + 4 * 0);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4 * 1);
+                            __m128 _w2 = _mm_load_weight_ps(kptr + 4 * 2);
+                            __m128 _w3 = _mm_load_weight_ps(kptr + 4 * 3);
+                            __m128 _w4 = _mm_load_weight_ps(kptr + 4 * 4);
+                            __m128 _w5 = _mm_load_weight_ps(kptr + 4 * 5);
+                            __m128 _w6 = _mm_load_weight_ps(kptr + 4 * 6);
+                            __m128 _w7 = _mm_load_weight_ps(kptr + 4 * 7);
+                            __m128 _w8 = _mm_load_weight_ps(kptr + 4 * 8);
+                            __m128 _w9 = _mm_load_weight_ps(kptr + 4 * 9);
+                            __m128 _wa = _mm_load_weight_ps(kptr + 4 * 10);
+                            __m128 _wb = _mm_load_weight_ps(kptr + 4 * 11);
+                            __m128 _wc = _mm_load_weight_ps(kptr + 4 * 12);
+                            __m128 _wd = _mm_load_weight_ps(kptr + 4 * 13);
+                            __m128 _we = _mm_load_weight_ps(kptr + 4 * 14);
+                            __m128 _wf = _mm_load_weight_ps(kptr + 4 * 15);
 
                             _sum0 = _mm_fmadd_ps(_w0, _mm_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm_fmadd_ps(_w1, _mm_set1_ps(r0s[1]), _sum1);
@@ -2167,22 +2168,22 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m128 _w0 = _mm_load_ps(kptr + 4 * 0);
-                            __m128 _w1 = _mm_load_ps(kptr + 4 * 1);
-                            __m128 _w2 = _mm_load_ps(kptr + 4 * 2);
-                            __m128 _w3 = _mm_load_ps(kptr + 4 * 3);
-                            __m128 _w4 = _mm_load_ps(kptr + 4 * 4);
-                            __m128 _w5 = _mm_load_ps(kptr + 4 * 5);
-                            __m128 _w6 = _mm_load_ps(kptr + 4 * 6);
-                            __m128 _w7 = _mm_load_ps(kptr + 4 * 7);
-                            __m128 _w8 = _mm_load_ps(kptr + 4 * 8);
-                            __m128 _w9 = _mm_load_ps(kptr + 4 * 9);
-                            __m128 _wa = _mm_load_ps(kptr + 4 * 10);
-                            __m128 _wb = _mm_load_ps(kptr + 4 * 11);
-                            __m128 _wc = _mm_load_ps(kptr + 4 * 12);
-                            __m128 _wd = _mm_load_ps(kptr + 4 * 13);
-                            __m128 _we = _mm_load_ps(kptr + 4 * 14);
-                            __m128 _wf = _mm_load_ps(kptr + 4 * 15);
+                            __m128 _w0 = _mm_load_weight_ps(kptr + 4 * 0);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4 * 1);
+                            __m128 _w2 = _mm_load_weight_ps(kptr + 4 * 2);
+                            __m128 _w3 = _mm_load_weight_ps(kptr + 4 * 3);
+                            __m128 _w4 = _mm_load_weight_ps(kptr + 4 * 4);
+                            __m128 _w5 = _mm_load_weight_ps(kptr + 4 * 5);
+                            __m128 _w6 = _mm_load_weight_ps(kptr + 4 * 6);
+                            __m128 _w7 = _mm_load_weight_ps(kptr + 4 * 7);
+                            __m128 _w8 = _mm_load_weight_ps(kptr + 4 * 8);
+                            __m128 _w9 = _mm_load_weight_ps(kptr + 4 * 9);
+                            __m128 _wa = _mm_load_weight_ps(kptr + 4 * 10);
+                            __m128 _wb = _mm_load_weight_ps(kptr + 4 * 11);
+                            __m128 _wc = _mm_load_weight_ps(kptr + 4 * 12);
+                            __m128 _wd = _mm_load_weight_ps(kptr + 4 * 13);
+                            __m128 _we = _mm_load_weight_ps(kptr + 4 * 14);
+                            __m128 _wf = _mm_load_weight_ps(kptr + 4 * 15);
 
                             _sum0 = _mm_fmadd_ps(_w0, _mm_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm_fmadd_ps(_w1, _mm_set1_ps(r0[sok + N]), _sum1);
@@ -2208,22 +2209,22 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
 #endif // __AVX512F__
                 for (; q + 7 < inch; q += 8)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 8)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
+                            const TB* r0s = r0 + space_ofs[k];
 
-                            __m128 _w0 = _mm_load_ps(kptr);
-                            __m128 _w1 = _mm_load_ps(kptr + 4);
-                            __m128 _w2 = _mm_load_ps(kptr + 8);
-                            __m128 _w3 = _mm_load_ps(kptr + 12);
-                            __m128 _w4 = _mm_load_ps(kptr + 16);
-                            __m128 _w5 = _mm_load_ps(kptr + 20);
-                            __m128 _w6 = _mm_load_ps(kptr + 24);
-                            __m128 _w7 = _mm_load_ps(kptr + 28);
+                            __m128 _w0 = _mm_load_weight_ps(kptr);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4);
+                            __m128 _w2 = _mm_load_weight_ps(kptr + 8);
+                            __m128 _w3 = _mm_load_weight_ps(kptr + 12);
+                            __m128 _w4 = _mm_load_weight_ps(kptr + 16);
+                            __m128 _w5 = _mm_load_weight_ps(kptr + 20);
+                            __m128 _w6 = _mm_load_weight_ps(kptr + 24);
+                            __m128 _w7 = _mm_load_weight_ps(kptr + 28);
 
                             _sum0 = _mm_comp_fmadd_ps(_w0, _mm_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm_comp_fmadd_ps(_w1, _mm_set1_ps(r0s[1]), _sum1);
@@ -2239,21 +2240,21 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 4)
                     {
-                        const float* r1 = r0 + N;
+                        const TB* r1 = r0 + N;
 
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
-                            const float* r1s = r1 + space_ofs[k];
-
-                            __m128 _w0 = _mm_load_ps(kptr);
-                            __m128 _w1 = _mm_load_ps(kptr + 4);
-                            __m128 _w2 = _mm_load_ps(kptr + 8);
-                            __m128 _w3 = _mm_load_ps(kptr + 12);
-                            __m128 _w4 = _mm_load_ps(kptr + 16);
-                            __m128 _w5 = _mm_load_ps(kptr + 20);
-                            __m128 _w6 = _mm_load_ps(kptr + 24);
-                            __m128 _w7 = _mm_load_ps(kptr + 28);
+                            const TB* r0s = r0 + space_ofs[k];
+                            const TB* r1s = r1 + space_ofs[k];
+
+                            __m128 _w0 = _mm_load_weight_ps(kptr);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4);
+                            __m128 _w2 = _mm_load_weight_ps(kptr + 8);
+                            __m128 _w3 = _mm_load_weight_ps(kptr + 12);
+                            __m128 _w4 = _mm_load_weight_ps(kptr + 16);
+                            __m128 _w5 = _mm_load_weight_ps(kptr + 20);
+                            __m128 _w6 = _mm_load_weight_ps(kptr + 24);
+                            __m128 _w7 = _mm_load_weight_ps(kptr + 28);
 
                             _sum0 = _mm_comp_fmadd_ps(_w0, _mm_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm_comp_fmadd_ps(_w1, _mm_set1_ps(r0s[1]), _sum1);
@@ -2273,14 +2274,14 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m128 _w0 = _mm_load_ps(kptr);
-                            __m128 _w1 = _mm_load_ps(kptr + 4);
-                            __m128 _w2 = _mm_load_ps(kptr + 8);
-                            __m128 _w3 = _mm_load_ps(kptr + 12);
-                            __m128 _w4 = _mm_load_ps(kptr + 16);
-                            __m128 _w5 = _mm_load_ps(kptr + 20);
-                            __m128 _w6 = _mm_load_ps(kptr + 24);
-                            __m128 _w7 = _mm_load_ps(kptr + 28);
+                            __m128 _w0 = _mm_load_weight_ps(kptr);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4);
+                            __m128 _w2 = _mm_load_weight_ps(kptr + 8);
+                            __m128 _w3 = _mm_load_weight_ps(kptr + 12);
+                            __m128 _w4 = _mm_load_weight_ps(kptr + 16);
+                            __m128 _w5 = _mm_load_weight_ps(kptr + 20);
+                            __m128 _w6 = _mm_load_weight_ps(kptr + 24);
+                            __m128 _w7 = _mm_load_weight_ps(kptr + 28);
 
                             _sum0 = _mm_comp_fmadd_ps(_w0, _mm_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm_comp_fmadd_ps(_w1, _mm_set1_ps(r0[sok + N]), _sum1);
@@ -2298,18 +2299,18 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
 #endif // __AVX__
                 for (; q + 3 < inch; q += 4)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 4)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
-                            const float* r0s = r0 + space_ofs[k];
+                            const TB* r0s = r0 + space_ofs[k];
 
-                            __m128 _w0 = _mm_load_ps(kptr);
-                            __m128 _w1 = _mm_load_ps(kptr + 4);
-                            __m128 _w2 = _mm_load_ps(kptr + 8);
-                            __m128 _w3 = _mm_load_ps(kptr + 12);
+                            __m128 _w0 = _mm_load_weight_ps(kptr);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4);
+                            __m128 _w2 = _mm_load_weight_ps(kptr + 8);
+                            __m128 _w3 = _mm_load_weight_ps(kptr + 12);
 
                             _sum0 = _mm_comp_fmadd_ps(_w0, _mm_set1_ps(r0s[0]), _sum0);
                             _sum1 = _mm_comp_fmadd_ps(_w1, _mm_set1_ps(r0s[1]), _sum1);
@@ -2325,10 +2326,10 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m128 _w0 = _mm_load_ps(kptr);
-                            __m128 _w1 = _mm_load_ps(kptr + 4);
-                            __m128 _w2 = _mm_load_ps(kptr + 8);
-                            __m128 _w3 = _mm_load_ps(kptr + 12);
+                            __m128 _w0 = _mm_load_weight_ps(kptr);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4);
+                            __m128 _w2 = _mm_load_weight_ps(kptr + 8);
+                            __m128 _w3 = _mm_load_weight_ps(kptr + 12);
 
                             _sum0 = _mm_comp_fmadd_ps(_w0, _mm_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm_comp_fmadd_ps(_w1, _mm_set1_ps(r0[sok + N]), _sum1);
@@ -2341,7 +2342,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q + 1 < inch; q += 2)
                 {
-                    const float* r0 = bottom_blob.channel(q).row(i * stride_h) + j * stride_w;
+                    const TB* r0 = bottom_blob.channel(q).row<const TB>(i * stride_h) + j * stride_w;
 
                     // if (elempack == 1)
                     {
@@ -2349,8 +2350,8 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            __m128 _w0 = _mm_load_ps(kptr);
-                            __m128 _w1 = _mm_load_ps(kptr + 4);
+                            __m128 _w0 = _mm_load_weight_ps(kptr);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4);
 
                             _sum0 = _mm_comp_fmadd_ps(_w0, _mm_set1_ps(r0[sok]), _sum0);
                             _sum1 = _mm_comp_fmadd_ps(_w1, _mm_set1_ps(r0[sok + N]), _sum1);
@@ -2361,14 +2362,14 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q < inch; q++)
                 {
-                    const float* r0 = bottom_blob.channel(q).row(i * stride_h) + j * stride_w;
+                    const TB* r0 = bottom_blob.channel(q).row<const TB>(i * stride_h) + j * stride_w;
 
                     // if (elempack == 1)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             __m128 _val = _mm_set1_ps(r0[space_ofs[k]]);
-                            __m128 _w = _mm_load_ps(kptr);
+                            __m128 _w = _mm_load_weight_ps(kptr);
                             _sum0 = _mm_comp_fmadd_ps(_val, _w, _sum0);
 
                             kptr += 4;
@@ -2384,7 +2385,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
 
                 if (out_elempack == 4)
                 {
-                    _mm_storeu_ps(outptr, _sum0);
+                    _mm_storeu_blob_ps(outptr, _sum0);
                     outptr += 4;
                 }
                 if (out_elempack == 1)
@@ -2417,8 +2418,8 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
         const int outw = top_blob.w;
         const int outh = top_blob.h;
 
-        float* outptr0 = top_blob.channel(p);
-        float* outptr1 = top_blob.channel(p + 1);
+        TB* outptr0 = top_blob.channel(p);
+        TB* outptr1 = top_blob.channel(p + 1);
 
         for (int i = 0; i < outh; i++)
         {
@@ -2434,13 +2435,13 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
 
 #if __AVX512F__
-                const float* kptr = weight_data_tm.channel(p / 16 + (p % 16) / 8 + (p % 8) / 4 + (p % 4) / 2);
+                const T* kptr = weight_data_tm.channel(p / 16 + (p % 16) / 8 + (p % 8) / 4 + (p % 4) / 2);
 #elif __AVX__
-                const float* kptr = weight_data_tm.channel(p / 8 + (p % 8) / 4 + (p % 4) / 2);
+                const T* kptr = weight_data_tm.channel(p / 8 + (p % 8) / 4 + (p % 4) / 2);
 #elif __SSE2__
-                const float* kptr = weight_data_tm.channel(p / 4 + (p % 4) / 2);
+                const T* kptr = weight_data_tm.channel(p / 4 + (p % 4) / 2);
 #else
-                const float* kptr = weight_data_tm.channel(p / 2);
+                const T* kptr = weight_data_tm.channel(p / 2);
 #endif
 
                 int q = 0;
@@ -2451,16 +2452,16 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 __m512 _sum1_avx512 = _mm512_setzero_ps();
                 for (; q + 15 < inch; q += 16)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 16)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m512 _r0 = _mm512_load_ps(r0 + sok);
-                            __m512 _w0 = _mm512_load_ps(kptr);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16);
+                            __m512 _r0 = _mm512_load_blob_ps(r0 + sok);
+                            __m512 _w0 = _mm512_load_weight_ps(kptr);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16);
                             _sum0_avx512 = _mm512_fmadd_ps(_r0, _w0, _sum0_avx512);
                             _sum1_avx512 = _mm512_fmadd_ps(_r0, _w1, _sum1_avx512);
 
@@ -2469,14 +2470,14 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 8)
                     {
-                        const float* r1 = r0 + N;
+                        const TB* r1 = r0 + N;
 
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m512 _r0 = combine8x2_ps(_mm256_load_ps(r0 + sok), _mm256_load_ps(r1 + sok));
-                            __m512 _w0 = _mm512_load_ps(kptr);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16);
+                            __m512 _r0 = combine8x2_ps(_mm256_load_blob_ps(r0 + sok), _mm256_load_blob_ps(r1 + sok));
+                            __m512 _w0 = _mm512_load_weight_ps(kptr);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16);
                             _sum0_avx512 = _mm512_fmadd_ps(_r0, _w0, _sum0_avx512);
                             _sum1_avx512 = _mm512_fmadd_ps(_r0, _w1, _sum1_avx512);
 
@@ -2485,16 +2486,16 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 4)
                     {
-                        const float* r1 = r0 + N;
-                        const float* r2 = r0 + N * 2;
-                        const float* r3 = r0 + N * 3;
+                        const TB* r1 = r0 + N;
+                        const TB* r2 = r0 + N * 2;
+                        const TB* r3 = r0 + N * 3;
 
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m512 _r0 = combine4x4_ps(_mm_load_ps(r0 + sok), _mm_load_ps(r1 + sok), _mm_load_ps(r2 + sok), _mm_load_ps(r3 + sok));
-                            __m512 _w0 = _mm512_load_ps(kptr);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16);
+                            __m512 _r0 = combine4x4_ps(_mm_load_blob_ps(r0 + sok), _mm_load_blob_ps(r1 + sok), _mm_load_blob_ps(r2 + sok), _mm_load_blob_ps(r3 + sok));
+                            __m512 _w0 = _mm512_load_weight_ps(kptr);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16);
                             _sum0_avx512 = _mm512_fmadd_ps(_r0, _w0, _sum0_avx512);
                             _sum1_avx512 = _mm512_fmadd_ps(_r0, _w1, _sum1_avx512);
 
@@ -2507,8 +2508,8 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
                             __m512 _r0 = _mm512_set_ps(r0[sok + N * 15], r0[sok + N * 14], r0[sok + N * 13], r0[sok + N * 12], r0[sok + N * 11], r0[sok + N * 10], r0[sok + N * 9], r0[sok + N * 8], r0[sok + N * 7], r0[sok + N * 6], r0[sok + N * 5], r0[sok + N * 4], r0[sok + N * 3], r0[sok + N * 2], r0[sok + N], r0[sok]);
-                            __m512 _w0 = _mm512_load_ps(kptr);
-                            __m512 _w1 = _mm512_load_ps(kptr + 16);
+                            __m512 _w0 = _mm512_load_weight_ps(kptr);
+                            __m512 _w1 = _mm512_load_weight_ps(kptr + 16);
                             _sum0_avx512 = _mm512_fmadd_ps(_r0, _w0, _sum0_avx512);
                             _sum1_avx512 = _mm512_fmadd_ps(_r0, _w1, _sum1_avx512);
 
@@ -2523,16 +2524,16 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 __m256 _sum1_avx = _mm256_setzero_ps();
                 for (; q + 7 < inch; q += 8)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 8)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m256 _r0 = _mm256_load_ps(r0 + sok);
-                            __m256 _w0 = _mm256_load_ps(kptr);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8);
+                            __m256 _r0 = _mm256_load_blob_ps(r0 + sok);
+                            __m256 _w0 = _mm256_load_weight_ps(kptr);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8);
                             _sum0_avx = _mm256_comp_fmadd_ps(_r0, _w0, _sum0_avx);
                             _sum1_avx = _mm256_comp_fmadd_ps(_r0, _w1, _sum1_avx);
 
@@ -2541,14 +2542,14 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 4)
                     {
-                        const float* r1 = r0 + N;
+                        const TB* r1 = r0 + N;
 
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m256 _r0 = combine4x2_ps(_mm_load_ps(r0 + sok), _mm_load_ps(r1 + sok));
-                            __m256 _w0 = _mm256_load_ps(kptr);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8);
+                            __m256 _r0 = combine4x2_ps(_mm_load_blob_ps(r0 + sok), _mm_load_blob_ps(r1 + sok));
+                            __m256 _w0 = _mm256_load_weight_ps(kptr);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8);
                             _sum0_avx = _mm256_comp_fmadd_ps(_r0, _w0, _sum0_avx);
                             _sum1_avx = _mm256_comp_fmadd_ps(_r0, _w1, _sum1_avx);
 
@@ -2561,8 +2562,8 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
                             __m256 _r0 = _mm256_set_ps(r0[sok + N * 7], r0[sok + N * 6], r0[sok + N * 5], r0[sok + N * 4], r0[sok + N * 3], r0[sok + N * 2], r0[sok + N], r0[sok]);
-                            __m256 _w0 = _mm256_load_ps(kptr);
-                            __m256 _w1 = _mm256_load_ps(kptr + 8);
+                            __m256 _w0 = _mm256_load_weight_ps(kptr);
+                            __m256 _w1 = _mm256_load_weight_ps(kptr + 8);
                             _sum0_avx = _mm256_comp_fmadd_ps(_r0, _w0, _sum0_avx);
                             _sum1_avx = _mm256_comp_fmadd_ps(_r0, _w1, _sum1_avx);
 
@@ -2577,16 +2578,16 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 __m128 _sum1 = _mm_setzero_ps();
                 for (; q + 3 < inch; q += 4)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 4)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m128 _r0 = _mm_load_ps(r0 + sok);
-                            __m128 _w0 = _mm_load_ps(kptr);
-                            __m128 _w1 = _mm_load_ps(kptr + 4);
+                            __m128 _r0 = _mm_load_blob_ps(r0 + sok);
+                            __m128 _w0 = _mm_load_weight_ps(kptr);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4);
                             _sum0 = _mm_comp_fmadd_ps(_r0, _w0, _sum0);
                             _sum1 = _mm_comp_fmadd_ps(_r0, _w1, _sum1);
 
@@ -2599,8 +2600,8 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
                             __m128 _r0 = _mm_set_ps(r0[sok + N * 3], r0[sok + N * 2], r0[sok + N], r0[sok]);
-                            __m128 _w0 = _mm_load_ps(kptr);
-                            __m128 _w1 = _mm_load_ps(kptr + 4);
+                            __m128 _w0 = _mm_load_weight_ps(kptr);
+                            __m128 _w1 = _mm_load_weight_ps(kptr + 4);
                             _sum0 = _mm_comp_fmadd_ps(_r0, _w0, _sum0);
                             _sum1 = _mm_comp_fmadd_ps(_r0, _w1, _sum1);
 
@@ -2613,7 +2614,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
 #endif // __SSE2__
                 for (; q + 1 < inch; q += 2)
                 {
-                    const float* r0 = bottom_blob.channel(q).row(i * stride_h) + j * stride_w;
+                    const TB* r0 = bottom_blob.channel(q).row<const TB>(i * stride_h) + j * stride_w;
 
                     // if (elempack == 1)
                     {
@@ -2621,10 +2622,10 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            sum0 += r0[sok] * kptr[0];
-                            sum1 += r0[sok] * kptr[1];
-                            sum0 += r0[sok + N] * kptr[2];
-                            sum1 += r0[sok + N] * kptr[3];
+                            sum0 += r0[sok] * load_weight(kptr);
+                            sum1 += r0[sok] * load_weight(kptr + 1);
+                            sum0 += r0[sok + N] * load_weight(kptr + 2);
+                            sum1 += r0[sok + N] * load_weight(kptr + 3);
 
                             kptr += 4;
                         }
@@ -2632,15 +2633,15 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q < inch; q++)
                 {
-                    const float* r0 = bottom_blob.channel(q).row(i * stride_h) + j * stride_w;
+                    const TB* r0 = bottom_blob.channel(q).row<const TB>(i * stride_h) + j * stride_w;
 
                     // if (elempack == 1)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             float val = r0[space_ofs[k]];
-                            sum0 += val * kptr[0];
-                            sum1 += val * kptr[1];
+                            sum0 += val * load_weight(kptr);
+                            sum1 += val * load_weight(kptr + 1);
 
                             kptr += 2;
                         }
@@ -2660,7 +2661,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
     remain_outch_start += nn_outch * 2;
     for (int p = remain_outch_start; p < outch; p++)
     {
-        float* outptr = top_blob.channel(p);
+        TB* outptr = top_blob.channel(p);
 
         for (int i = 0; i < outh; i++)
         {
@@ -2674,13 +2675,13 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
 
 #if __AVX512F__
-                const float* kptr = weight_data_tm.channel(p / 16 + (p % 16) / 8 + (p % 8) / 4 + (p % 4) / 2 + p % 2);
+                const T* kptr = weight_data_tm.channel(p / 16 + (p % 16) / 8 + (p % 8) / 4 + (p % 4) / 2 + p % 2);
 #elif __AVX__
-                const float* kptr = weight_data_tm.channel(p / 8 + (p % 8) / 4 + (p % 4) / 2 + p % 2);
+                const T* kptr = weight_data_tm.channel(p / 8 + (p % 8) / 4 + (p % 4) / 2 + p % 2);
 #elif __SSE2__
-                const float* kptr = weight_data_tm.channel(p / 4 + (p % 4) / 2 + p % 2);
+                const T* kptr = weight_data_tm.channel(p / 4 + (p % 4) / 2 + p % 2);
 #else
-                const float* kptr = weight_data_tm.channel(p / 2 + p % 2);
+                const T* kptr = weight_data_tm.channel(p / 2 + p % 2);
 #endif
 
                 int q = 0;
@@ -2690,15 +2691,15 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 __m512 _sum_avx512 = _mm512_setzero_ps();
                 for (; q + 15 < inch; q += 16)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 16)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m512 _r0 = _mm512_load_ps(r0 + sok);
-                            __m512 _w = _mm512_load_ps(kptr);
+                            __m512 _r0 = _mm512_load_blob_ps(r0 + sok);
+                            __m512 _w = _mm512_load_weight_ps(kptr);
                             _sum_avx512 = _mm512_fmadd_ps(_r0, _w, _sum_avx512);
 
                             kptr += 16;
@@ -2706,13 +2707,13 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 8)
                     {
-                        const float* r1 = r0 + N;
+                        const TB* r1 = r0 + N;
 
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m512 _r0 = combine8x2_ps(_mm256_load_ps(r0 + sok), _mm256_load_ps(r1 + sok));
-                            __m512 _w = _mm512_load_ps(kptr);
+                            __m512 _r0 = combine8x2_ps(_mm256_load_blob_ps(r0 + sok), _mm256_load_blob_ps(r1 + sok));
+                            __m512 _w = _mm512_load_weight_ps(kptr);
                             _sum_avx512 = _mm512_fmadd_ps(_r0, _w, _sum_avx512);
 
                             kptr += 16;
@@ -2720,15 +2721,15 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 4)
                     {
-                        const float* r1 = r0 + N;
-                        const float* r2 = r0 + N * 2;
-                        const float* r3 = r0 + N * 3;
+                        const TB* r1 = r0 + N;
+                        const TB* r2 = r0 + N * 2;
+                        const TB* r3 = r0 + N * 3;
 
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m512 _r0 = combine4x4_ps(_mm_load_ps(r0 + sok), _mm_load_ps(r1 + sok), _mm_load_ps(r2 + sok), _mm_load_ps(r3 + sok));
-                            __m512 _w = _mm512_load_ps(kptr);
+                            __m512 _r0 = combine4x4_ps(_mm_load_blob_ps(r0 + sok), _mm_load_blob_ps(r1 + sok), _mm_load_blob_ps(r2 + sok), _mm_load_blob_ps(r3 + sok));
+                            __m512 _w = _mm512_load_weight_ps(kptr);
                             _sum_avx512 = _mm512_fmadd_ps(_r0, _w, _sum_avx512);
 
                             kptr += 16;
@@ -2740,7 +2741,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
                             __m512 _r0 = _mm512_set_ps(r0[sok + N * 15], r0[sok + N * 14], r0[sok + N * 13], r0[sok + N * 12], r0[sok + N * 11], r0[sok + N * 10], r0[sok + N * 9], r0[sok + N * 8], r0[sok + N * 7], r0[sok + N * 6], r0[sok + N * 5], r0[sok + N * 4], r0[sok + N * 3], r0[sok + N * 2], r0[sok + N], r0[sok]);
-                            __m512 _w = _mm512_load_ps(kptr);
+                            __m512 _w = _mm512_load_weight_ps(kptr);
                             _sum_avx512 = _mm512_fmadd_ps(_r0, _w, _sum_avx512);
 
                             kptr += 16;
@@ -2752,15 +2753,15 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 __m256 _sum_avx = _mm256_setzero_ps();
                 for (; q + 7 < inch; q += 8)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 8)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m256 _r0 = _mm256_load_ps(r0 + sok);
-                            __m256 _w = _mm256_load_ps(kptr);
+                            __m256 _r0 = _mm256_load_blob_ps(r0 + sok);
+                            __m256 _w = _mm256_load_weight_ps(kptr);
                             _sum_avx = _mm256_comp_fmadd_ps(_r0, _w, _sum_avx);
 
                             kptr += 8;
@@ -2768,13 +2769,13 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                     }
                     if (elempack == 4)
                     {
-                        const float* r1 = r0 + N;
+                        const TB* r1 = r0 + N;
 
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m256 _r0 = combine4x2_ps(_mm_load_ps(r0 + sok), _mm_load_ps(r1 + sok));
-                            __m256 _w = _mm256_load_ps(kptr);
+                            __m256 _r0 = combine4x2_ps(_mm_load_blob_ps(r0 + sok), _mm_load_blob_ps(r1 + sok));
+                            __m256 _w = _mm256_load_weight_ps(kptr);
                             _sum_avx = _mm256_comp_fmadd_ps(_r0, _w, _sum_avx);
 
                             kptr += 8;
@@ -2786,7 +2787,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
                             __m256 _r0 = _mm256_set_ps(r0[sok + N * 7], r0[sok + N * 6], r0[sok + N * 5], r0[sok + N * 4], r0[sok + N * 3], r0[sok + N * 2], r0[sok + N], r0[sok]);
-                            __m256 _w = _mm256_load_ps(kptr);
+                            __m256 _w = _mm256_load_weight_ps(kptr);
                             _sum_avx = _mm256_comp_fmadd_ps(_r0, _w, _sum_avx);
 
                             kptr += 8;
@@ -2798,15 +2799,15 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 __m128 _sum = _mm_setzero_ps();
                 for (; q + 3 < inch; q += 4)
                 {
-                    const float* r0 = bottom_blob.channel(q / elempack).row(i * stride_h) + j * stride_w * elempack;
+                    const TB* r0 = bottom_blob.channel(q / elempack).row<const TB>(i * stride_h) + j * stride_w * elempack;
 
                     if (elempack == 4)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             const int sok = space_ofs[k];
-                            __m128 _r0 = _mm_load_ps(r0 + sok);
-                            __m128 _w = _mm_load_ps(kptr);
+                            __m128 _r0 = _mm_load_blob_ps(r0 + sok);
+                            __m128 _w = _mm_load_weight_ps(kptr);
                             _sum = _mm_comp_fmadd_ps(_r0, _w, _sum);
 
                             kptr += 4;
@@ -2818,7 +2819,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
                             __m128 _r0 = _mm_set_ps(r0[sok + N * 3], r0[sok + N * 2], r0[sok + N], r0[sok]);
-                            __m128 _w = _mm_load_ps(kptr);
+                            __m128 _w = _mm_load_weight_ps(kptr);
                             _sum = _mm_comp_fmadd_ps(_r0, _w, _sum);
 
                             kptr += 4;
@@ -2829,7 +2830,7 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
 #endif // __SSE2__
                 for (; q + 1 < inch; q += 2)
                 {
-                    const float* r0 = bottom_blob.channel(q).row(i * stride_h) + j * stride_w;
+                    const TB* r0 = bottom_blob.channel(q).row<const TB>(i * stride_h) + j * stride_w;
 
                     // if (elempack == 1)
                     {
@@ -2837,8 +2838,8 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                         {
                             const int sok = space_ofs[k];
 
-                            sum += r0[sok] * kptr[0];
-                            sum += r0[sok + N] * kptr[1];
+                            sum += r0[sok] * load_weight(kptr);
+                            sum += r0[sok + N] * load_weight(kptr + 1);
 
                             kptr += 2;
                         }
@@ -2846,14 +2847,14 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
                 }
                 for (; q < inch; q++)
                 {
-                    const float* r0 = bottom_blob.channel(q).row(i * stride_h) + j * stride_w;
+                    const TB* r0 = bottom_blob.channel(q).row<const TB>(i * stride_h) + j * stride_w;
 
                     // if (elempack == 1)
                     {
                         for (int k = 0; k < maxk; k++)
                         {
                             float val = r0[space_ofs[k]];
-                            sum += val * kptr[0];
+                            sum += val * load_weight(kptr);
 
                             kptr += 1;
                         }
@@ -2868,3 +2869,23 @@ static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat&
         }
     }
 }
+
+static void convolution_packed(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_tm, const Mat& bias_data, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int activation_type, const Mat& activation_params, const Option& opt)
+{
+#if NCNN_F16C && __F16C__
+    if (weight_data_tm.elembits() == 16)
+    {
+        convolution_packed_impl<unsigned short, float>(bottom_blob, top_blob, weight_data_tm, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, activation_type, activation_params, opt);
+        return;
+    }
+#endif
+
+    convolution_packed_impl<float, float>(bottom_blob, top_blob, weight_data_tm, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, activation_type, activation_params, opt);
+}
+
+#if NCNN_BF16
+static void convolution_packed_bf16s(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_tm, const Mat& bias_data, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    convolution_packed_impl<bfloat16_t, bfloat16_t>(bottom_blob, top_blob, weight_data_tm, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, activation_type, activation_params, opt);
+}
+#endif // NCNN_BF16
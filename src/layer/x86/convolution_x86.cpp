@@ -24,6 +24,9 @@
 
 namespace ncnn {
 
+#include "x86_fp16s.h"
+#include "x86_bf16s.h"
+
 #include "convolution_3x3.h"
 #include "convolution_5x5.h"
 
@@ -60,6 +63,9 @@ Convolution_x86::Convolution_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 
     activation = 0;
     nT = 0;
@@ -269,7 +275,10 @@ static bool test_prefer_winograd23(int num_input, int num_output, int w, int h)
 int Convolution_x86::create_pipeline(const Option& opt)
 {
     if (dynamic_weight)
+    {
+        support_bf16_storage = false;
         return 0;
+    }
 
     activation = create_activation_layer(activation_type, activation_params, opt);
     nT = opt.num_threads;
@@ -277,10 +286,18 @@ int Convolution_x86::create_pipeline(const Option& opt)
 #if NCNN_INT8
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
+        support_bf16_storage = false;
         return create_pipeline_int8_x86(opt);
     }
 #endif
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage)
+    {
+        return create_pipeline_bf16s(opt);
+    }
+#endif
+
     int kernel_size = kernel_w * kernel_h;
     int num_input = weight_data_size / kernel_size / num_output;
 
@@ -356,11 +373,20 @@ int Convolution_x86::create_pipeline(const Option& opt)
         {
             // dynamic shape
             if ((opt.use_winograd63_convolution) && (num_input <= 32 && num_output <= 32))
-                conv3x3s1_winograd63_transform_kernel(weight_data, weight_winograd63_data, num_input, num_output, opt);
+            {
+                if (weight_winograd63_data.empty())
+                    conv3x3s1_winograd63_transform_kernel(weight_data, weight_winograd63_data, num_input, num_output, opt);
+            }
             else if (opt.use_winograd43_convolution)
-                conv3x3s1_winograd43_transform_kernel(weight_data, weight_winograd43_data, num_input, num_output, opt);
+            {
+                if (weight_winograd43_data.empty())
+                    conv3x3s1_winograd43_transform_kernel(weight_data, weight_winograd43_data, num_input, num_output, opt);
+            }
             else
-                conv3x3s1_winograd23_transform_kernel(weight_data, weight_winograd23_data, num_input, num_output, opt);
+            {
+                if (weight_winograd23_data.empty())
+                    conv3x3s1_winograd23_transform_kernel(weight_data, weight_winograd23_data, num_input, num_output, opt);
+            }
         }
         else
         {
@@ -425,15 +451,18 @@ int Convolution_x86::create_pipeline(const Option& opt)
 
             if (prefer_winograd23)
             {
-                conv3x3s1_winograd23_transform_kernel(weight_data, weight_winograd23_data, num_input, num_output, opt);
+                if (weight_winograd23_data.empty())
+                    conv3x3s1_winograd23_transform_kernel(weight_data, weight_winograd23_data, num_input, num_output, opt);
             }
             else if (prefer_winograd43)
             {
-                conv3x3s1_winograd43_transform_kernel(weight_data, weight_winograd43_data, num_input, num_output, opt);
+                if (weight_winograd43_data.empty())
+                    conv3x3s1_winograd43_transform_kernel(weight_data, weight_winograd43_data, num_input, num_output, opt);
             }
             else if (prefer_winograd63)
             {
-                conv3x3s1_winograd63_transform_kernel(weight_data, weight_winograd63_data, num_input, num_output, opt);
+                if (weight_winograd63_data.empty())
+                    conv3x3s1_winograd63_transform_kernel(weight_data, weight_winograd63_data, num_input, num_output, opt);
             }
             else
             {
@@ -450,9 +479,29 @@ int Convolution_x86::create_pipeline(const Option& opt)
     int l2_cache_size = get_cpu_level2_cache_size();
     bool prefer_sgemm = num_input * num_output * kernel_w * kernel_h * dilation_w * dilation_h * stride_w * stride_h * (int)sizeof(float) * 2 > l2_cache_size || (num_input > 16 || num_output > 16);
 
+#if NCNN_F16C && __F16C__
+    // keep weights that fp16 holds bitwise as fp16, the kernels widen them in registers
+    const bool use_fp16s = opt.use_fp16_storage && weight_fp16_exact(weight_data);
+#endif
+
     if ((opt.use_sgemm_convolution && prefer_sgemm) || (kernel_w == 1 && kernel_h == 1))
     {
-        convolution_im2col_gemm_transform_kernel(weight_data, weight_sgemm_data, num_input, num_output, kernel_w, kernel_h, opt);
+        if (weight_sgemm_data.empty())
+        {
+            convolution_im2col_gemm_transform_kernel(weight_data, weight_sgemm_data, num_input, num_output, kernel_w, kernel_h, opt);
+
+#if NCNN_F16C && __F16C__
+            if (use_fp16s)
+            {
+                Mat weight_sgemm_data_fp16;
+                int ret = cast_packed_weight_fp16s(weight_sgemm_data, weight_sgemm_data_fp16);
+                if (ret != 0)
+                    return ret;
+
+                weight_sgemm_data = weight_sgemm_data_fp16;
+            }
+#endif
+        }
 
         if (opt.lightmode)
             weight_data.release();
@@ -460,7 +509,11 @@ int Convolution_x86::create_pipeline(const Option& opt)
         return 0;
     }
 
-    if ((elempack == 16 && out_elempack == 1 && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
+    if (!weight_data_tm.empty())
+    {
+        // restored from the weight cache
+    }
+    else if ((elempack == 16 && out_elempack == 1 && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             || (elempack == 8 && out_elempack == 8 && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             || (elempack == 8 && out_elempack == 8 && kernel_w == 2 && kernel_h == 2 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             || (elempack == 1 && out_elempack == 8 && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
@@ -474,6 +527,18 @@ int Convolution_x86::create_pipeline(const Option& opt)
     else
     {
         convolution_transform_kernel_packed(weight_data, weight_data_tm, num_input, num_output, kernel_w, kernel_h);
+
+#if NCNN_F16C && __F16C__
+        if (use_fp16s)
+        {
+            Mat weight_data_tm_fp16;
+            int ret = cast_packed_weight_fp16s(weight_data_tm, weight_data_tm_fp16);
+            if (ret != 0)
+                return ret;
+
+            weight_data_tm = weight_data_tm_fp16;
+        }
+#endif
     }
 
     if (opt.lightmode)
@@ -501,6 +566,17 @@ int Convolution_x86::destroy_pipeline(const Option& opt)
     return 0;
 }
 
+int Convolution_x86::get_pipeline_weights(std::vector<Mat*>& weights)
+{
+    weights.resize(5);
+    weights[0] = &weight_data_tm;
+    weights[1] = &weight_sgemm_data;
+    weights[2] = &weight_winograd23_data;
+    weights[3] = &weight_winograd43_data;
+    weights[4] = &weight_winograd63_data;
+    return 0;
+}
+
 int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
 #if NCNN_INT8
@@ -554,6 +630,13 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         return 0;
     }
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage && support_bf16_storage)
+    {
+        return forward_bf16s(bottom_blob, top_blob, opt);
+    }
+#endif
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int channels = bottom_blob.c;
@@ -639,11 +722,11 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         }
 
         int _nT = nT ? nT : opt.num_threads;
-        if (nT != 0 && opt.num_threads != nT)
+        if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
         {
-            // force num_threads the same as in create_pipeline
-            // so we could use pre-packed A/B from the same tile config
-            NCNN_LOGE("opt.num_threads %d changed, convolution winograd will use load-time value %d", opt.num_threads, nT);
+            // pre-packed A/B follow the tile config of the load-time num_threads
+            // fewer threads are fine, branch parallel runs pass their thread share here
+            NCNN_LOGE("opt.num_threads %d changed, convolution winograd will use at most load-time value %d", opt.num_threads, nT);
         }
 
         int ret = 0;
@@ -679,11 +762,11 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     if ((opt.use_sgemm_convolution && prefer_sgemm) || (kernel_w == 1 && kernel_h == 1))
     {
         int _nT = nT ? nT : opt.num_threads;
-        if (nT != 0 && opt.num_threads != nT)
+        if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
         {
-            // force num_threads the same as in create_pipeline
-            // so we could use pre-packed A/B from the same tile config
-            NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use load-time value %d", opt.num_threads, nT);
+            // pre-packed A/B follow the tile config of the load-time num_threads
+            // fewer threads are fine, branch parallel runs pass their thread share here
+            NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use at most load-time value %d", opt.num_threads, nT);
         }
 
         int ret = convolution_im2col_gemm(bottom_blob_bordered, top_blob, weight_sgemm_data, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, _nT, opt);
@@ -890,7 +973,11 @@ int Convolution_x86::create_pipeline_int8_x86(const Option& opt)
 
     bool prefer_winograd = (opt.use_winograd23_convolution || opt.use_winograd43_convolution) && (num_input > 8 || num_output > 8);
 
-    if (opt.use_winograd_convolution && prefer_winograd && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
+    if (!weight_winograd43_data.empty() || !weight_winograd23_data.empty() || !weight_sgemm_data.empty() || !weight_data_tm.empty())
+    {
+        // restored from the weight cache
+    }
+    else if (opt.use_winograd_convolution && prefer_winograd && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
     {
         if (opt.use_winograd43_convolution)
             conv3x3s1_winograd43_transform_kernel_int8(weight_data, weight_winograd43_data, num_input, num_output, opt);
@@ -1030,11 +1117,11 @@ int Convolution_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, con
         return -100;
 
     int _nT = nT ? nT : opt.num_threads;
-    if (nT != 0 && opt.num_threads != nT)
+    if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
     {
-        // force num_threads the same as in create_pipeline
-        // so we could use pre-packed A/B from the same tile config
-        NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use load-time value %d", opt.num_threads, nT);
+        // pre-packed A/B follow the tile config of the load-time num_threads
+        // fewer threads are fine, branch parallel runs pass their thread share here
+        NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use at most load-time value %d", opt.num_threads, nT);
     }
 
     int ret = 0;
@@ -1109,6 +1196,115 @@ int Convolution_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, con
 }
 #endif // NCNN_INT8
 
+#if NCNN_BF16
+int Convolution_x86::create_pipeline_bf16s(const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h;
+    const int num_input = weight_data_size / maxk / num_output;
+
+    // 16-bit blobs are packed by 4
+    int elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+        elempack = num_input % 4 == 0 ? 4 : 1;
+    }
+#endif // __SSE2__
+
+    int l2_cache_size = get_cpu_level2_cache_size();
+    bool prefer_sgemm = num_input * num_output * kernel_w * kernel_h * dilation_w * dilation_h * stride_w * stride_h * (int)sizeof(float) * 2 > l2_cache_size || (num_input > 16 || num_output > 16);
+
+    if ((opt.use_sgemm_convolution && prefer_sgemm) || (kernel_w == 1 && kernel_h == 1))
+    {
+        if (weight_sgemm_data.empty())
+        {
+            Mat weight_sgemm_data_fp32;
+            convolution_im2col_gemm_transform_kernel(weight_data, weight_sgemm_data_fp32, num_input, num_output, kernel_w, kernel_h, elempack, opt);
+
+            int ret = cast_packed_weight_bf16s(weight_sgemm_data_fp32, weight_sgemm_data);
+            if (ret != 0)
+                return ret;
+        }
+    }
+    else if (weight_data_tm.empty())
+    {
+        Mat weight_data_tm_fp32;
+        convolution_transform_kernel_packed(weight_data, weight_data_tm_fp32, num_input, num_output, kernel_w, kernel_h);
+
+        int ret = cast_packed_weight_bf16s(weight_data_tm_fp32, weight_data_tm);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int Convolution_x86::forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    if (bottom_blob.elembits() == 32)
+    {
+        return layer_forward_fp32_bf16s(this, bottom_blob, top_blob, opt);
+    }
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+    const int outh = (h - kernel_extent_h) / stride_h + 1;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+    }
+#endif // __SSE2__
+
+    top_blob.create(outw, outh, num_output / out_elempack, 2u * out_elempack, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (!weight_sgemm_data.empty())
+    {
+        int _nT = nT ? nT : opt.num_threads;
+        if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
+        {
+            // pre-packed A/B follow the tile config of the load-time num_threads
+            // fewer threads are fine, branch parallel runs pass their thread share here
+            NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use at most load-time value %d", opt.num_threads, nT);
+        }
+
+        int ret = convolution_im2col_gemm_bf16s(bottom_blob_bordered, top_blob, weight_sgemm_data, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, _nT, opt);
+        if (ret != 0)
+            return ret;
+
+        if (activation)
+        {
+            // the bf16 activation casts through a workspace block
+            ret = activation->forward_inplace(top_blob, opt);
+            if (ret != 0)
+                return ret;
+        }
+        return 0;
+    }
+
+    convolution_packed_bf16s(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, activation_type, activation_params, opt);
+
+    return 0;
+}
+#endif // NCNN_BF16
+
 int Convolution_x86::forwardDilation_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     int w = bottom_blob.w;
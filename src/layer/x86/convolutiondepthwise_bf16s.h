@@ -0,0 +1,113 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+static void convdw_bf16s(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_tm, const Mat& bias_data, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    const int w = bottom_blob.w;
+    const int channels = bottom_blob.c;
+    const int elempack = bottom_blob.elempack;
+
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+
+    const int maxk = kernel_w * kernel_h;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap = w * dilation_h - kernel_w * dilation_w;
+        for (int i = 0; i < kernel_h; i++)
+        {
+            for (int j = 0; j < kernel_w; j++)
+            {
+                space_ofs[p1] = p2;
+                p1++;
+                p2 += dilation_w;
+            }
+            p2 += gap;
+        }
+    }
+
+    const float* bias_data_ptr = bias_data;
+
+#if __SSE2__
+    if (elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            bfloat16_t* outptr = top_blob.channel(g);
+            const bfloat16_t* kptr = (const bfloat16_t*)weight_data_tm + maxk * g * 4;
+            const Mat m = bottom_blob.channel(g);
+
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    __m128 _sum = _mm_setzero_ps();
+
+                    if (bias_data_ptr)
+                    {
+                        _sum = _mm_loadu_ps(bias_data_ptr + g * 4);
+                    }
+
+                    const bfloat16_t* sptr = m.row<const bfloat16_t>(i * stride_h) + j * stride_w * 4;
+
+                    for (int k = 0; k < maxk; k++)
+                    {
+                        __m128 _val = _mm_loadu_blob_ps(sptr + space_ofs[k] * 4);
+                        __m128 _w = _mm_loadu_weight_ps(kptr + k * 4);
+                        _sum = _mm_comp_fmadd_ps(_val, _w, _sum);
+                    }
+
+                    _sum = activation_sse(_sum, activation_type, activation_params);
+
+                    _mm_storeu_blob_ps(outptr + j * 4, _sum);
+                }
+
+                outptr += outw * 4;
+            }
+        }
+
+        return;
+    }
+#endif // __SSE2__
+
+    // if (elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            bfloat16_t* outptr = top_blob.channel(g);
+            const bfloat16_t* kptr = (const bfloat16_t*)weight_data_tm + maxk * g;
+            const Mat m = bottom_blob.channel(g);
+
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    float sum = 0.f;
+
+                    if (bias_data_ptr)
+                    {
+                        sum = bias_data_ptr[g];
+                    }
+
+                    const bfloat16_t* sptr = m.row<const bfloat16_t>(i * stride_h) + j * stride_w;
+
+                    for (int k = 0; k < maxk; k++)
+                    {
+                        sum += sptr[space_ofs[k]] * load_weight(kptr + k);
+                    }
+
+                    outptr[j] = activation_ss(sum, activation_type, activation_params);
+                }
+
+                outptr += outw;
+            }
+        }
+    }
+}
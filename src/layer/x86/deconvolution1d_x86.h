@@ -0,0 +1,28 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_DECONVOLUTION1D_X86_H
+#define LAYER_DECONVOLUTION1D_X86_H
+
+#include "deconvolution1d.h"
+
+namespace ncnn {
+
+class Deconvolution1D_x86 : public Deconvolution1D
+{
+public:
+    Deconvolution1D_x86();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    Layer* activation;
+    Layer* gemm;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_DECONVOLUTION1D_X86_H
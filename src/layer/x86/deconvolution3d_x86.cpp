@@ -0,0 +1,281 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deconvolution3d_x86.h"
+
+#include "layer_type.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Deconvolution3D_x86::Deconvolution3D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+    activation = 0;
+    gemm = 0;
+}
+
+int Deconvolution3D_x86::create_pipeline(const Option& opt)
+{
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+    const int num_input = weight_data_size / maxk / num_output;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+    ncnn::ParamDict pd;
+    pd.set(2, 1);                 // transA
+    pd.set(3, 0);                 // transB
+    pd.set(4, 1);                 // constantA
+    pd.set(5, 0);                 // constantB
+    pd.set(6, 1);                 // constantC
+    pd.set(7, maxk * num_output); // M = maxk*num_output
+    pd.set(8, 0);                 // N = size
+    pd.set(9, num_input);         // K = inch
+    pd.set(10, -1);               // constant_broadcast_type_C = null
+    pd.set(11, 0);                // output_N1M
+    pd.set(12, out_elempack);
+
+    gemm->load_param(pd);
+
+    // maxk-inch-outch to pa-maxk-outch/pa-inch
+    Mat tmp;
+    {
+        Mat weight_data_r2 = weight_data.reshape(maxk, num_input, num_output);
+
+        tmp.create(maxk * num_output, num_input);
+
+        for (int p = 0; p < num_input; p += 1)
+        {
+            float* g00 = tmp.row(p);
+
+            for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
+            {
+                for (int k = 0; k < maxk; k++)
+                {
+                    for (int i = 0; i < out_elempack; i++)
+                    {
+                        const float* k00 = weight_data_r2.channel(q + i).row(p);
+                        g00[0] = k00[k];
+                        g00++;
+                    }
+                }
+            }
+        }
+    }
+
+    ncnn::Mat weights[1];
+    weights[0] = tmp;
+
+    gemm->load_model(ModelBinFromMatArray(weights));
+
+    gemm->create_pipeline(opt);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int Deconvolution3D_x86::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    if (gemm)
+    {
+        gemm->destroy_pipeline(opt);
+        delete gemm;
+        gemm = 0;
+    }
+
+    return 0;
+}
+
+static NCNN_FORCEINLINE void deconvolution3d_accumulate(float* ptr, const float* sptr, int elempack)
+{
+    int k = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; k + 15 < elempack; k += 16)
+    {
+        _mm512_storeu_ps(ptr + k, _mm512_add_ps(_mm512_loadu_ps(ptr + k), _mm512_loadu_ps(sptr + k)));
+    }
+#endif // __AVX512F__
+    for (; k + 7 < elempack; k += 8)
+    {
+        _mm256_storeu_ps(ptr + k, _mm256_add_ps(_mm256_loadu_ps(ptr + k), _mm256_loadu_ps(sptr + k)));
+    }
+#endif // __AVX__
+    for (; k + 3 < elempack; k += 4)
+    {
+        _mm_storeu_ps(ptr + k, _mm_add_ps(_mm_loadu_ps(ptr + k), _mm_loadu_ps(sptr + k)));
+    }
+#endif // __SSE2__
+    for (; k < elempack; k++)
+    {
+        ptr[k] += sptr[k];
+    }
+}
+
+int Deconvolution3D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int d = bottom_blob.d;
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    const int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+    const int outh = (h - 1) * stride_h + kernel_extent_h + output_pad_bottom;
+    const int outd = (d - 1) * stride_d + kernel_extent_d + output_pad_behind;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    const size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    const int out_channels = num_output / out_elempack;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || pad_front > 0 || pad_behind > 0 || (output_w > 0 && output_h > 0 && output_d > 0))
+    {
+        top_blob_bordered.create(outw, outh, outd, out_channels, out_elemsize, out_elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, outh, outd, out_channels, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+
+    // sgemm
+    Mat bottom_blob_2 = bottom_blob;
+    {
+        bottom_blob_2.dims = 3;
+        bottom_blob_2.w = w * h * d;
+        bottom_blob_2.h = 1;
+        bottom_blob_2.d = 1;
+    }
+    Mat top_col2im;
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+    int ret = gemm->forward(bottom_blob_2, top_col2im, opt_b);
+    if (ret != 0)
+        return ret;
+
+    // col2im
+    const int gap_h = (outw * stride_h - w * stride_w) * out_elempack;
+    const int gap_d = (outw * outh * stride_d - outw * h * stride_h) * out_elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < out_channels; p++)
+    {
+        const float* sptr = top_col2im.row(p * maxk);
+        Mat outm = top_blob_bordered.channel(p);
+
+        {
+            float* ptr = outm;
+            const int size = outw * outh * outd;
+            for (int i = 0; i < size; i++)
+            {
+                for (int k = 0; k < out_elempack; k++)
+                {
+                    ptr[k] = bias_data.empty() ? 0.f : bias_data[p * out_elempack + k];
+                }
+                ptr += out_elempack;
+            }
+        }
+
+        for (int t = 0; t < kernel_d; t++)
+        {
+            for (int u = 0; u < kernel_h; u++)
+            {
+                for (int v = 0; v < kernel_w; v++)
+                {
+                    float* ptr = outm.depth(dilation_d * t).row(dilation_h * u) + dilation_w * v * out_elempack;
+
+                    for (int z = 0; z < d; z++)
+                    {
+                        for (int i = 0; i < h; i++)
+                        {
+                            for (int j = 0; j < w; j++)
+                            {
+                                deconvolution3d_accumulate(ptr, sptr, out_elempack);
+
+                                ptr += stride_w * out_elempack;
+                                sptr += out_elempack;
+                            }
+
+                            ptr += gap_h;
+                        }
+
+                        ptr += gap_d;
+                    }
+                }
+            }
+        }
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob_bordered, opt);
+    }
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+} // namespace ncnn
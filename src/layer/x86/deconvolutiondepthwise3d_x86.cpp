@@ -0,0 +1,245 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deconvolutiondepthwise3d_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+DeconvolutionDepthWise3D_x86::DeconvolutionDepthWise3D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+    activation = 0;
+}
+
+int DeconvolutionDepthWise3D_x86::create_pipeline(const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h * kernel_d;
+    const int channels = (weight_data_size / group) / maxk / (num_output / group) * group;
+
+    // group deconvolution
+    if (!(channels == group && group == num_output))
+    {
+        support_packing = false;
+        return 0;
+    }
+
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    int elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        elempack = channels % 16 == 0 ? 16 : channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        elempack = channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#else
+        elempack = channels % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    Mat weight_data_r2 = weight_data.reshape(maxk, group);
+    convert_packing(weight_data_r2, weight_data_tm, elempack, opt);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int DeconvolutionDepthWise3D_x86::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    return 0;
+}
+
+int DeconvolutionDepthWise3D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    if (weight_data_tm.empty())
+    {
+        return DeconvolutionDepthWise3D::forward(bottom_blob, top_blob, opt);
+    }
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int d = bottom_blob.d;
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    const int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+    const int outh = (h - 1) * stride_h + kernel_extent_h + output_pad_bottom;
+    const int outd = (d - 1) * stride_d + kernel_extent_d + output_pad_behind;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || pad_front > 0 || pad_behind > 0 || (output_w > 0 && output_h > 0 && output_d > 0))
+    {
+        top_blob_bordered.create(outw, outh, outd, channels, elemsize, elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+
+    // gather the input taps of each output pixel, every output is written once
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int g = 0; g < channels; g++)
+    {
+        float* outptr = top_blob_bordered.channel(g);
+        const float* kptr = (const float*)weight_data_tm + maxk * g * elempack;
+        const float* bptr = bias_term ? (const float*)bias_data + g * elempack : 0;
+        const Mat m = bottom_blob.channel(g);
+
+        std::vector<int> _tap_ofs(maxk);
+        std::vector<int> _tap_k(maxk);
+        int* tap_ofs = &_tap_ofs[0];
+        int* tap_k = &_tap_k[0];
+
+        for (int z = 0; z < outd; z++)
+        {
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    int nn = 0;
+                    for (int t = 0; t < kernel_d; t++)
+                    {
+                        int sz = z - t * dilation_d;
+                        if (sz < 0 || sz % stride_d != 0)
+                            continue;
+                        sz /= stride_d;
+                        if (sz >= d)
+                            continue;
+
+                        for (int u = 0; u < kernel_h; u++)
+                        {
+                            int sy = i - u * dilation_h;
+                            if (sy < 0 || sy % stride_h != 0)
+                                continue;
+                            sy /= stride_h;
+                            if (sy >= h)
+                                continue;
+
+                            for (int v = 0; v < kernel_w; v++)
+                            {
+                                int sx = j - v * dilation_w;
+                                if (sx < 0 || sx % stride_w != 0)
+                                    continue;
+                                sx /= stride_w;
+                                if (sx >= w)
+                                    continue;
+
+                                tap_ofs[nn] = ((sz * h + sy) * w + sx) * elempack;
+                                tap_k[nn] = (t * kernel_h + u) * kernel_w + v;
+                                nn++;
+                            }
+                        }
+                    }
+
+                    const float* sptr = m;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+                    if (elempack == 16)
+                    {
+                        __m512 _sum = bptr ? _mm512_loadu_ps(bptr) : _mm512_setzero_ps();
+
+                        for (int k = 0; k < nn; k++)
+                        {
+                            __m512 _val = _mm512_loadu_ps(sptr + tap_ofs[k]);
+                            __m512 _w = _mm512_loadu_ps(kptr + tap_k[k] * 16);
+                            _sum = _mm512_fmadd_ps(_val, _w, _sum);
+                        }
+
+                        _mm512_storeu_ps(outptr, _sum);
+                    }
+#endif // __AVX512F__
+                    if (elempack == 8)
+                    {
+                        __m256 _sum = bptr ? _mm256_loadu_ps(bptr) : _mm256_setzero_ps();
+
+                        for (int k = 0; k < nn; k++)
+                        {
+                            __m256 _val = _mm256_loadu_ps(sptr + tap_ofs[k]);
+                            __m256 _w = _mm256_loadu_ps(kptr + tap_k[k] * 8);
+                            _sum = _mm256_comp_fmadd_ps(_val, _w, _sum);
+                        }
+
+                        _mm256_storeu_ps(outptr, _sum);
+                    }
+#endif // __AVX__
+                    if (elempack == 4)
+                    {
+                        __m128 _sum = bptr ? _mm_loadu_ps(bptr) : _mm_setzero_ps();
+
+                        for (int k = 0; k < nn; k++)
+                        {
+                            __m128 _val = _mm_loadu_ps(sptr + tap_ofs[k]);
+                            __m128 _w = _mm_loadu_ps(kptr + tap_k[k] * 4);
+                            _sum = _mm_comp_fmadd_ps(_val, _w, _sum);
+                        }
+
+                        _mm_storeu_ps(outptr, _sum);
+                    }
+#endif // __SSE2__
+                    if (elempack == 1)
+                    {
+                        float sum = bptr ? bptr[0] : 0.f;
+
+                        for (int k = 0; k < nn; k++)
+                        {
+                            sum += sptr[tap_ofs[k]] * kptr[tap_k[k]];
+                        }
+
+                        outptr[0] = sum;
+                    }
+
+                    outptr += elempack;
+                }
+            }
+        }
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob_bordered, opt);
+    }
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,125 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "exp_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+#if NCNN_BF16
+#include "x86_bf16s.h"
+#endif // NCNN_BF16
+
+Exp_x86::Exp_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int Exp_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+        return layer_forward_inplace_bf16s(this, bottom_top_blob, opt);
+#endif
+
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int d = bottom_top_blob.d;
+    int channels = bottom_top_blob.c;
+    int elempack = bottom_top_blob.elempack;
+    int size = w * h * d * elempack;
+
+    if (base != -1.f && base <= 0.f)
+    {
+        // non-positive base has no exp(x * log(base)) form
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            float* ptr = bottom_top_blob.channel(q);
+
+            for (int i = 0; i < size; i++)
+            {
+                ptr[i] = powf(base, (shift + ptr[i] * scale));
+            }
+        }
+
+        return 0;
+    }
+
+    // base^x = exp(x * log(base))
+    const float log_base = base == -1.f ? 1.f : logf(base);
+    const float scale_log_base = scale * log_base;
+    const float shift_log_base = shift * log_base;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        __m512 _scale512 = _mm512_set1_ps(scale_log_base);
+        __m512 _shift512 = _mm512_set1_ps(shift_log_base);
+        for (; i + 15 < size; i += 16)
+        {
+            __m512 _p = _mm512_loadu_ps(ptr);
+            _p = exp512_ps(_mm512_add_ps(_shift512, _mm512_mul_ps(_p, _scale512)));
+            _mm512_storeu_ps(ptr, _p);
+
+            ptr += 16;
+        }
+#endif // __AVX512F__
+        __m256 _scale256 = _mm256_set1_ps(scale_log_base);
+        __m256 _shift256 = _mm256_set1_ps(shift_log_base);
+        for (; i + 7 < size; i += 8)
+        {
+            __m256 _p = _mm256_loadu_ps(ptr);
+            _p = exp256_ps(_mm256_add_ps(_shift256, _mm256_mul_ps(_p, _scale256)));
+            _mm256_storeu_ps(ptr, _p);
+
+            ptr += 8;
+        }
+#endif // __AVX__
+        __m128 _scale128 = _mm_set1_ps(scale_log_base);
+        __m128 _shift128 = _mm_set1_ps(shift_log_base);
+        for (; i + 3 < size; i += 4)
+        {
+            __m128 _p = _mm_load_ps(ptr);
+            _p = exp_ps(_mm_add_ps(_shift128, _mm_mul_ps(_p, _scale128)));
+            _mm_store_ps(ptr, _p);
+
+            ptr += 4;
+        }
+#endif // __SSE2__
+        for (; i < size; i++)
+        {
+            *ptr = expf(shift_log_base + *ptr * scale_log_base);
+            ptr++;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -17,6 +17,7 @@
 #include "x86_usability.h"
 
 #include "cpu.h"
+#include "layer_type.h"
 
 namespace ncnn {
 
@@ -24,16 +25,25 @@ namespace ncnn {
 #include "gemm_int8.h"
 #endif
 
+#include "x86_fp16s.h"
+#include "x86_bf16s.h"
+
 Gemm_x86::Gemm_x86()
 {
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 
     nT = 0;
+
+    weight_quant_innerproduct = 0;
 }
 
-static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max_kk)
+template<typename TA>
+static void pack_A_tile_impl(const Mat& A, Mat& AT, int i, int max_ii, int k, int max_kk)
 {
     const int elempack = A.elempack;
     const int A_hstep = A.dims == 3 ? (int)A.cstep : A.w;
@@ -48,24 +58,24 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
     {
         if (elempack == 16)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k * 16;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k * 16;
 
             for (int kk = 0; kk < max_kk; kk++)
             {
-                _mm512_store_ps(pp, _mm512_load_ps(p0));
+                _mm512_store_ps(pp, _mm512_load_blob_ps(p0));
                 pp += 16;
                 p0 += 16;
             }
         }
         if (elempack == 8)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k * 8;
-            const float* p1 = (const float*)A + (i + ii + 8) * A_hstep + k * 8;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k * 8;
+            const TA* p1 = (const TA*)A + (i + ii + 8) * A_hstep + k * 8;
 
             for (int kk = 0; kk < max_kk; kk++)
             {
-                _mm256_store_ps(pp, _mm256_load_ps(p0));
-                _mm256_store_ps(pp + 8, _mm256_load_ps(p1));
+                _mm256_store_ps(pp, _mm256_load_blob_ps(p0));
+                _mm256_store_ps(pp + 8, _mm256_load_blob_ps(p1));
                 pp += 16;
                 p0 += 8;
                 p1 += 8;
@@ -73,17 +83,17 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
         }
         if (elempack == 4)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k * 4;
-            const float* p1 = (const float*)A + (i + ii + 4) * A_hstep + k * 4;
-            const float* p2 = (const float*)A + (i + ii + 8) * A_hstep + k * 4;
-            const float* p3 = (const float*)A + (i + ii + 12) * A_hstep + k * 4;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k * 4;
+            const TA* p1 = (const TA*)A + (i + ii + 4) * A_hstep + k * 4;
+            const TA* p2 = (const TA*)A + (i + ii + 8) * A_hstep + k * 4;
+            const TA* p3 = (const TA*)A + (i + ii + 12) * A_hstep + k * 4;
 
             for (int kk = 0; kk < max_kk; kk++)
             {
-                _mm_store_ps(pp, _mm_load_ps(p0));
-                _mm_store_ps(pp + 4, _mm_load_ps(p1));
-                _mm_store_ps(pp + 8, _mm_load_ps(p2));
-                _mm_store_ps(pp + 12, _mm_load_ps(p3));
+                _mm_store_ps(pp, _mm_load_blob_ps(p0));
+                _mm_store_ps(pp + 4, _mm_load_blob_ps(p1));
+                _mm_store_ps(pp + 8, _mm_load_blob_ps(p2));
+                _mm_store_ps(pp + 12, _mm_load_blob_ps(p3));
                 pp += 16;
                 p0 += 4;
                 p1 += 4;
@@ -93,42 +103,42 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
         }
         if (elempack == 1)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k;
-            const float* p1 = (const float*)A + (i + ii + 1) * A_hstep + k;
-            const float* p2 = (const float*)A + (i + ii + 2) * A_hstep + k;
-            const float* p3 = (const float*)A + (i + ii + 3) * A_hstep + k;
-            const float* p4 = (const float*)A + (i + ii + 4) * A_hstep + k;
-            const float* p5 = (const float*)A + (i + ii + 5) * A_hstep + k;
-            const float* p6 = (const float*)A + (i + ii + 6) * A_hstep + k;
-            const float* p7 = (const float*)A + (i + ii + 7) * A_hstep + k;
-            const float* p8 = (const float*)A + (i + ii + 8) * A_hstep + k;
-            const float* p9 = (const float*)A + (i + ii + 9) * A_hstep + k;
-            const float* pa = (const float*)A + (i + ii + 10) * A_hstep + k;
-            const float* pb = (const float*)A + (i + ii + 11) * A_hstep + k;
-            const float* pc = (const float*)A + (i + ii + 12) * A_hstep + k;
-            const float* pd = (const float*)A + (i + ii + 13) * A_hstep + k;
-            const float* pe = (const float*)A + (i + ii + 14) * A_hstep + k;
-            const float* pf = (const float*)A + (i + ii + 15) * A_hstep + k;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k;
+            const TA* p1 = (const TA*)A + (i + ii + 1) * A_hstep + k;
+            const TA* p2 = (const TA*)A + (i + ii + 2) * A_hstep + k;
+            const TA* p3 = (const TA*)A + (i + ii + 3) * A_hstep + k;
+            const TA* p4 = (const TA*)A + (i + ii + 4) * A_hstep + k;
+            const TA* p5 = (const TA*)A + (i + ii + 5) * A_hstep + k;
+            const TA* p6 = (const TA*)A + (i + ii + 6) * A_hstep + k;
+            const TA* p7 = (const TA*)A + (i + ii + 7) * A_hstep + k;
+            const TA* p8 = (const TA*)A + (i + ii + 8) * A_hstep + k;
+            const TA* p9 = (const TA*)A + (i + ii + 9) * A_hstep + k;
+            const TA* pa = (const TA*)A + (i + ii + 10) * A_hstep + k;
+            const TA* pb = (const TA*)A + (i + ii + 11) * A_hstep + k;
+            const TA* pc = (const TA*)A + (i + ii + 12) * A_hstep + k;
+            const TA* pd = (const TA*)A + (i + ii + 13) * A_hstep + k;
+            const TA* pe = (const TA*)A + (i + ii + 14) * A_hstep + k;
+            const TA* pf = (const TA*)A + (i + ii + 15) * A_hstep + k;
 
             int kk = 0;
             for (; kk + 15 < max_kk; kk += 16)
             {
-                __m512 _r0 = _mm512_loadu_ps(p0);
-                __m512 _r1 = _mm512_loadu_ps(p1);
-                __m512 _r2 = _mm512_loadu_ps(p2);
-                __m512 _r3 = _mm512_loadu_ps(p3);
-                __m512 _r4 = _mm512_loadu_ps(p4);
-                __m512 _r5 = _mm512_loadu_ps(p5);
-                __m512 _r6 = _mm512_loadu_ps(p6);
-                __m512 _r7 = _mm512_loadu_ps(p7);
-                __m512 _r8 = _mm512_loadu_ps(p8);
-                __m512 _r9 = _mm512_loadu_ps(p9);
-                __m512 _ra = _mm512_loadu_ps(pa);
-                __m512 _rb = _mm512_loadu_ps(pb);
-                __m512 _rc = _mm512_loadu_ps(pc);
-                __m512 _rd = _mm512_loadu_ps(pd);
-                __m512 _re = _mm512_loadu_ps(pe);
-                __m512 _rf = _mm512_loadu_ps(pf);
+                __m512 _r0 = _mm512_loadu_blob_ps(p0);
+                __m512 _r1 = _mm512_loadu_blob_ps(p1);
+                __m512 _r2 = _mm512_loadu_blob_ps(p2);
+                __m512 _r3 = _mm512_loadu_blob_ps(p3);
+                __m512 _r4 = _mm512_loadu_blob_ps(p4);
+                __m512 _r5 = _mm512_loadu_blob_ps(p5);
+                __m512 _r6 = _mm512_loadu_blob_ps(p6);
+                __m512 _r7 = _mm512_loadu_blob_ps(p7);
+                __m512 _r8 = _mm512_loadu_blob_ps(p8);
+                __m512 _r9 = _mm512_loadu_blob_ps(p9);
+                __m512 _ra = _mm512_loadu_blob_ps(pa);
+                __m512 _rb = _mm512_loadu_blob_ps(pb);
+                __m512 _rc = _mm512_loadu_blob_ps(pc);
+                __m512 _rd = _mm512_loadu_blob_ps(pd);
+                __m512 _re = _mm512_loadu_blob_ps(pe);
+                __m512 _rf = _mm512_loadu_blob_ps(pf);
                 transpose16x16_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb, _rc, _rd, _re, _rf);
                 _mm512_store_ps(pp, _r0);
                 _mm512_store_ps(pp + 16, _r1);
@@ -207,24 +217,24 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
     {
         if (elempack == 8)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k * 8;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k * 8;
 
             for (int kk = 0; kk < max_kk; kk++)
             {
-                _mm256_store_ps(pp, _mm256_load_ps(p0));
+                _mm256_store_ps(pp, _mm256_load_blob_ps(p0));
                 pp += 8;
                 p0 += 8;
             }
         }
         if (elempack == 4)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k * 4;
-            const float* p1 = (const float*)A + (i + ii + 4) * A_hstep + k * 4;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k * 4;
+            const TA* p1 = (const TA*)A + (i + ii + 4) * A_hstep + k * 4;
 
             for (int kk = 0; kk < max_kk; kk++)
             {
-                _mm_store_ps(pp, _mm_load_ps(p0));
-                _mm_store_ps(pp + 4, _mm_load_ps(p1));
+                _mm_store_ps(pp, _mm_load_blob_ps(p0));
+                _mm_store_ps(pp + 4, _mm_load_blob_ps(p1));
                 pp += 8;
                 p0 += 4;
                 p1 += 4;
@@ -232,26 +242,26 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
         }
         if (elempack == 1)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k;
-            const float* p1 = (const float*)A + (i + ii + 1) * A_hstep + k;
-            const float* p2 = (const float*)A + (i + ii + 2) * A_hstep + k;
-            const float* p3 = (const float*)A + (i + ii + 3) * A_hstep + k;
-            const float* p4 = (const float*)A + (i + ii + 4) * A_hstep + k;
-            const float* p5 = (const float*)A + (i + ii + 5) * A_hstep + k;
-            const float* p6 = (const float*)A + (i + ii + 6) * A_hstep + k;
-            const float* p7 = (const float*)A + (i + ii + 7) * A_hstep + k;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k;
+            const TA* p1 = (const TA*)A + (i + ii + 1) * A_hstep + k;
+            const TA* p2 = (const TA*)A + (i + ii + 2) * A_hstep + k;
+            const TA* p3 = (const TA*)A + (i + ii + 3) * A_hstep + k;
+            const TA* p4 = (const TA*)A + (i + ii + 4) * A_hstep + k;
+            const TA* p5 = (const TA*)A + (i + ii + 5) * A_hstep + k;
+            const TA* p6 = (const TA*)A + (i + ii + 6) * A_hstep + k;
+            const TA* p7 = (const TA*)A + (i + ii + 7) * A_hstep + k;
 
             int kk = 0;
             for (; kk + 7 < max_kk; kk += 8)
             {
-                __m256 _r0 = _mm256_loadu_ps(p0);
-                __m256 _r1 = _mm256_loadu_ps(p1);
-                __m256 _r2 = _mm256_loadu_ps(p2);
-                __m256 _r3 = _mm256_loadu_ps(p3);
-                __m256 _r4 = _mm256_loadu_ps(p4);
-                __m256 _r5 = _mm256_loadu_ps(p5);
-                __m256 _r6 = _mm256_loadu_ps(p6);
-                __m256 _r7 = _mm256_loadu_ps(p7);
+                __m256 _r0 = _mm256_loadu_blob_ps(p0);
+                __m256 _r1 = _mm256_loadu_blob_ps(p1);
+                __m256 _r2 = _mm256_loadu_blob_ps(p2);
+                __m256 _r3 = _mm256_loadu_blob_ps(p3);
+                __m256 _r4 = _mm256_loadu_blob_ps(p4);
+                __m256 _r5 = _mm256_loadu_blob_ps(p5);
+                __m256 _r6 = _mm256_loadu_blob_ps(p6);
+                __m256 _r7 = _mm256_loadu_blob_ps(p7);
                 transpose8x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
                 _mm256_store_ps(pp, _r0);
                 _mm256_store_ps(pp + 8, _r1);
@@ -298,30 +308,30 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
     {
         if (elempack == 4)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k * 4;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k * 4;
 
             for (int kk = 0; kk < max_kk; kk++)
             {
-                _mm_store_ps(pp, _mm_load_ps(p0));
+                _mm_store_ps(pp, _mm_load_blob_ps(p0));
                 pp += 4;
                 p0 += 4;
             }
         }
         if (elempack == 1)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k;
-            const float* p1 = (const float*)A + (i + ii + 1) * A_hstep + k;
-            const float* p2 = (const float*)A + (i + ii + 2) * A_hstep + k;
-            const float* p3 = (const float*)A + (i + ii + 3) * A_hstep + k;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k;
+            const TA* p1 = (const TA*)A + (i + ii + 1) * A_hstep + k;
+            const TA* p2 = (const TA*)A + (i + ii + 2) * A_hstep + k;
+            const TA* p3 = (const TA*)A + (i + ii + 3) * A_hstep + k;
 
             int kk = 0;
 #if __AVX__
             for (; kk + 7 < max_kk; kk += 8)
             {
-                __m256 _r0 = _mm256_loadu_ps(p0);
-                __m256 _r1 = _mm256_loadu_ps(p1);
-                __m256 _r2 = _mm256_loadu_ps(p2);
-                __m256 _r3 = _mm256_loadu_ps(p3);
+                __m256 _r0 = _mm256_loadu_blob_ps(p0);
+                __m256 _r1 = _mm256_loadu_blob_ps(p1);
+                __m256 _r2 = _mm256_loadu_blob_ps(p2);
+                __m256 _r3 = _mm256_loadu_blob_ps(p3);
                 transpose8x4_ps(_r0, _r1, _r2, _r3);
                 _mm256_store_ps(pp, _r0);
                 _mm256_store_ps(pp + 8, _r1);
@@ -336,10 +346,10 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
 #endif // __AVX__
             for (; kk + 3 < max_kk; kk += 4)
             {
-                __m128 _r0 = _mm_loadu_ps(p0);
-                __m128 _r1 = _mm_loadu_ps(p1);
-                __m128 _r2 = _mm_loadu_ps(p2);
-                __m128 _r3 = _mm_loadu_ps(p3);
+                __m128 _r0 = _mm_loadu_blob_ps(p0);
+                __m128 _r1 = _mm_loadu_blob_ps(p1);
+                __m128 _r2 = _mm_loadu_blob_ps(p2);
+                __m128 _r3 = _mm_loadu_blob_ps(p3);
                 _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                 _mm_store_ps(pp, _r0);
                 _mm_store_ps(pp + 4, _r1);
@@ -370,16 +380,16 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
     {
         // if (elempack == 1)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k;
-            const float* p1 = (const float*)A + (i + ii + 1) * A_hstep + k;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k;
+            const TA* p1 = (const TA*)A + (i + ii + 1) * A_hstep + k;
 
             int kk = 0;
 #if __SSE2__
 #if __AVX__
             for (; kk + 7 < max_kk; kk += 8)
             {
-                __m256 _r0 = _mm256_loadu_ps(p0);
-                __m256 _r1 = _mm256_loadu_ps(p1);
+                __m256 _r0 = _mm256_loadu_blob_ps(p0);
+                __m256 _r1 = _mm256_loadu_blob_ps(p1);
                 transpose8x2_ps(_r0, _r1);
                 _mm256_storeu_ps(pp, _r0);
                 _mm256_storeu_ps(pp + 8, _r1);
@@ -390,8 +400,8 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
 #endif // __AVX__
             for (; kk + 3 < max_kk; kk += 4)
             {
-                __m128 _r0 = _mm_loadu_ps(p0);
-                __m128 _r1 = _mm_loadu_ps(p1);
+                __m128 _r0 = _mm_loadu_blob_ps(p0);
+                __m128 _r1 = _mm_loadu_blob_ps(p1);
                 __m128 _tmp0 = _mm_unpacklo_ps(_r0, _r1);
                 __m128 _tmp1 = _mm_unpackhi_ps(_r0, _r1);
                 _mm_store_ps(pp, _tmp0);
@@ -415,21 +425,21 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
     {
         // if (elempack == 1)
         {
-            const float* p0 = (const float*)A + (i + ii) * A_hstep + k;
+            const TA* p0 = (const TA*)A + (i + ii) * A_hstep + k;
 
             int kk = 0;
 #if __SSE2__
 #if __AVX__
             for (; kk + 7 < max_kk; kk += 8)
             {
-                _mm256_storeu_ps(pp, _mm256_loadu_ps(p0));
+                _mm256_storeu_ps(pp, _mm256_loadu_blob_ps(p0));
                 pp += 8;
                 p0 += 8;
             }
 #endif // __AVX__
             for (; kk + 3 < max_kk; kk += 4)
             {
-                _mm_storeu_ps(pp, _mm_loadu_ps(p0));
+                _mm_storeu_ps(pp, _mm_loadu_blob_ps(p0));
                 pp += 4;
                 p0 += 4;
             }
@@ -444,7 +454,13 @@ static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max
     }
 }
 
-static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max_kk)
+static void pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max_kk)
+{
+    pack_A_tile_impl<float>(A, AT, i, max_ii, k, max_kk);
+}
+
+template<typename TA>
+static void transpose_pack_A_tile_impl(const Mat& A, Mat& AT, int i, int max_ii, int k, int max_kk)
 {
     const int elempack = A.elempack;
     const int A_hstep = A.dims == 3 ? (int)A.cstep : A.w;
@@ -459,27 +475,27 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
     {
         if (elempack == 16)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 16;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 16;
 
             int kk = 0;
             for (; kk + 15 < max_kk; kk += 16)
             {
-                __m512 _r0 = _mm512_load_ps(p0);
-                __m512 _r1 = _mm512_load_ps(p0 + 16 * 1);
-                __m512 _r2 = _mm512_load_ps(p0 + 16 * 2);
-                __m512 _r3 = _mm512_load_ps(p0 + 16 * 3);
-                __m512 _r4 = _mm512_load_ps(p0 + 16 * 4);
-                __m512 _r5 = _mm512_load_ps(p0 + 16 * 5);
-                __m512 _r6 = _mm512_load_ps(p0 + 16 * 6);
-                __m512 _r7 = _mm512_load_ps(p0 + 16 * 7);
-                __m512 _r8 = _mm512_load_ps(p0 + 16 * 8);
-                __m512 _r9 = _mm512_load_ps(p0 + 16 * 9);
-                __m512 _ra = _mm512_load_ps(p0 + 16 * 10);
-                __m512 _rb = _mm512_load_ps(p0 + 16 * 11);
-                __m512 _rc = _mm512_load_ps(p0 + 16 * 12);
-                __m512 _rd = _mm512_load_ps(p0 + 16 * 13);
-                __m512 _re = _mm512_load_ps(p0 + 16 * 14);
-                __m512 _rf = _mm512_load_ps(p0 + 16 * 15);
+                __m512 _r0 = _mm512_load_blob_ps(p0);
+                __m512 _r1 = _mm512_load_blob_ps(p0 + 16 * 1);
+                __m512 _r2 = _mm512_load_blob_ps(p0 + 16 * 2);
+                __m512 _r3 = _mm512_load_blob_ps(p0 + 16 * 3);
+                __m512 _r4 = _mm512_load_blob_ps(p0 + 16 * 4);
+                __m512 _r5 = _mm512_load_blob_ps(p0 + 16 * 5);
+                __m512 _r6 = _mm512_load_blob_ps(p0 + 16 * 6);
+                __m512 _r7 = _mm512_load_blob_ps(p0 + 16 * 7);
+                __m512 _r8 = _mm512_load_blob_ps(p0 + 16 * 8);
+                __m512 _r9 = _mm512_load_blob_ps(p0 + 16 * 9);
+                __m512 _ra = _mm512_load_blob_ps(p0 + 16 * 10);
+                __m512 _rb = _mm512_load_blob_ps(p0 + 16 * 11);
+                __m512 _rc = _mm512_load_blob_ps(p0 + 16 * 12);
+                __m512 _rd = _mm512_load_blob_ps(p0 + 16 * 13);
+                __m512 _re = _mm512_load_blob_ps(p0 + 16 * 14);
+                __m512 _rf = _mm512_load_blob_ps(p0 + 16 * 15);
                 transpose16x16_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb, _rc, _rd, _re, _rf);
                 _mm512_store_ps(pp, _r0);
                 _mm512_store_ps(pp + 16 * 1, _r1);
@@ -503,27 +519,27 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
         }
         if (elempack == 8)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 8;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 8;
 
             int kk = 0;
             for (; kk + 7 < max_kk; kk += 8)
             {
-                __m256 _r0 = _mm256_load_ps(p0);
-                __m256 _r1 = _mm256_load_ps(p0 + 8 * 1);
-                __m256 _r2 = _mm256_load_ps(p0 + 8 * 2);
-                __m256 _r3 = _mm256_load_ps(p0 + 8 * 3);
-                __m256 _r4 = _mm256_load_ps(p0 + 8 * 4);
-                __m256 _r5 = _mm256_load_ps(p0 + 8 * 5);
-                __m256 _r6 = _mm256_load_ps(p0 + 8 * 6);
-                __m256 _r7 = _mm256_load_ps(p0 + 8 * 7);
-                __m256 _r8 = _mm256_load_ps(p0 + 8 * 8);
-                __m256 _r9 = _mm256_load_ps(p0 + 8 * 9);
-                __m256 _ra = _mm256_load_ps(p0 + 8 * 10);
-                __m256 _rb = _mm256_load_ps(p0 + 8 * 11);
-                __m256 _rc = _mm256_load_ps(p0 + 8 * 12);
-                __m256 _rd = _mm256_load_ps(p0 + 8 * 13);
-                __m256 _re = _mm256_load_ps(p0 + 8 * 14);
-                __m256 _rf = _mm256_load_ps(p0 + 8 * 15);
+                __m256 _r0 = _mm256_load_blob_ps(p0);
+                __m256 _r1 = _mm256_load_blob_ps(p0 + 8 * 1);
+                __m256 _r2 = _mm256_load_blob_ps(p0 + 8 * 2);
+                __m256 _r3 = _mm256_load_blob_ps(p0 + 8 * 3);
+                __m256 _r4 = _mm256_load_blob_ps(p0 + 8 * 4);
+                __m256 _r5 = _mm256_load_blob_ps(p0 + 8 * 5);
+                __m256 _r6 = _mm256_load_blob_ps(p0 + 8 * 6);
+                __m256 _r7 = _mm256_load_blob_ps(p0 + 8 * 7);
+                __m256 _r8 = _mm256_load_blob_ps(p0 + 8 * 8);
+                __m256 _r9 = _mm256_load_blob_ps(p0 + 8 * 9);
+                __m256 _ra = _mm256_load_blob_ps(p0 + 8 * 10);
+                __m256 _rb = _mm256_load_blob_ps(p0 + 8 * 11);
+                __m256 _rc = _mm256_load_blob_ps(p0 + 8 * 12);
+                __m256 _rd = _mm256_load_blob_ps(p0 + 8 * 13);
+                __m256 _re = _mm256_load_blob_ps(p0 + 8 * 14);
+                __m256 _rf = _mm256_load_blob_ps(p0 + 8 * 15);
 
                 transpose8x16_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb, _rc, _rd, _re, _rf);
                 __m512 _rr0 = combine8x2_ps(_r0, _r1);
@@ -549,27 +565,27 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
         }
         if (elempack == 4)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 4;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 4;
 
             int kk = 0;
             for (; kk + 3 < max_kk; kk += 4)
             {
-                __m128 _r0 = _mm_load_ps(p0);
-                __m128 _r1 = _mm_load_ps(p0 + 4 * 1);
-                __m128 _r2 = _mm_load_ps(p0 + 4 * 2);
-                __m128 _r3 = _mm_load_ps(p0 + 4 * 3);
-                __m128 _r4 = _mm_load_ps(p0 + 4 * 4);
-                __m128 _r5 = _mm_load_ps(p0 + 4 * 5);
-                __m128 _r6 = _mm_load_ps(p0 + 4 * 6);
-                __m128 _r7 = _mm_load_ps(p0 + 4 * 7);
-                __m128 _r8 = _mm_load_ps(p0 + 4 * 8);
-                __m128 _r9 = _mm_load_ps(p0 + 4 * 9);
-                __m128 _ra = _mm_load_ps(p0 + 4 * 10);
-                __m128 _rb = _mm_load_ps(p0 + 4 * 11);
-                __m128 _rc = _mm_load_ps(p0 + 4 * 12);
-                __m128 _rd = _mm_load_ps(p0 + 4 * 13);
-                __m128 _re = _mm_load_ps(p0 + 4 * 14);
-                __m128 _rf = _mm_load_ps(p0 + 4 * 15);
+                __m128 _r0 = _mm_load_blob_ps(p0);
+                __m128 _r1 = _mm_load_blob_ps(p0 + 4 * 1);
+                __m128 _r2 = _mm_load_blob_ps(p0 + 4 * 2);
+                __m128 _r3 = _mm_load_blob_ps(p0 + 4 * 3);
+                __m128 _r4 = _mm_load_blob_ps(p0 + 4 * 4);
+                __m128 _r5 = _mm_load_blob_ps(p0 + 4 * 5);
+                __m128 _r6 = _mm_load_blob_ps(p0 + 4 * 6);
+                __m128 _r7 = _mm_load_blob_ps(p0 + 4 * 7);
+                __m128 _r8 = _mm_load_blob_ps(p0 + 4 * 8);
+                __m128 _r9 = _mm_load_blob_ps(p0 + 4 * 9);
+                __m128 _ra = _mm_load_blob_ps(p0 + 4 * 10);
+                __m128 _rb = _mm_load_blob_ps(p0 + 4 * 11);
+                __m128 _rc = _mm_load_blob_ps(p0 + 4 * 12);
+                __m128 _rd = _mm_load_blob_ps(p0 + 4 * 13);
+                __m128 _re = _mm_load_blob_ps(p0 + 4 * 14);
+                __m128 _rf = _mm_load_blob_ps(p0 + 4 * 15);
                 _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                 _MM_TRANSPOSE4_PS(_r4, _r5, _r6, _r7);
                 _MM_TRANSPOSE4_PS(_r8, _r9, _ra, _rb);
@@ -596,12 +612,12 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
         }
         if (elempack == 1)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii);
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii);
 
             int kk = 0;
             for (; kk < max_kk; kk++)
             {
-                _mm512_store_ps(pp, _mm512_loadu_ps(p0));
+                _mm512_store_ps(pp, _mm512_loadu_blob_ps(p0));
                 pp += 16;
                 p0 += A_hstep;
             }
@@ -613,19 +629,19 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #if __AVX512F__
         if (elempack == 16)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 16;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 16;
 
             int kk = 0;
             for (; kk + 15 < max_kk; kk += 16)
             {
-                __m512 _r0 = _mm512_load_ps(p0);
-                __m512 _r1 = _mm512_load_ps(p0 + 16 * 1);
-                __m512 _r2 = _mm512_load_ps(p0 + 16 * 2);
-                __m512 _r3 = _mm512_load_ps(p0 + 16 * 3);
-                __m512 _r4 = _mm512_load_ps(p0 + 16 * 4);
-                __m512 _r5 = _mm512_load_ps(p0 + 16 * 5);
-                __m512 _r6 = _mm512_load_ps(p0 + 16 * 6);
-                __m512 _r7 = _mm512_load_ps(p0 + 16 * 7);
+                __m512 _r0 = _mm512_load_blob_ps(p0);
+                __m512 _r1 = _mm512_load_blob_ps(p0 + 16 * 1);
+                __m512 _r2 = _mm512_load_blob_ps(p0 + 16 * 2);
+                __m512 _r3 = _mm512_load_blob_ps(p0 + 16 * 3);
+                __m512 _r4 = _mm512_load_blob_ps(p0 + 16 * 4);
+                __m512 _r5 = _mm512_load_blob_ps(p0 + 16 * 5);
+                __m512 _r6 = _mm512_load_blob_ps(p0 + 16 * 6);
+                __m512 _r7 = _mm512_load_blob_ps(p0 + 16 * 7);
                 transpose16x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
                 _mm512_store_ps(pp, _r0);
                 _mm512_store_ps(pp + 16 * 1, _r1);
@@ -642,19 +658,19 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #endif // __AVX512F__
         if (elempack == 8)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 8;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 8;
 
             int kk = 0;
             for (; kk + 7 < max_kk; kk += 8)
             {
-                __m256 _r0 = _mm256_load_ps(p0);
-                __m256 _r1 = _mm256_load_ps(p0 + 8 * 1);
-                __m256 _r2 = _mm256_load_ps(p0 + 8 * 2);
-                __m256 _r3 = _mm256_load_ps(p0 + 8 * 3);
-                __m256 _r4 = _mm256_load_ps(p0 + 8 * 4);
-                __m256 _r5 = _mm256_load_ps(p0 + 8 * 5);
-                __m256 _r6 = _mm256_load_ps(p0 + 8 * 6);
-                __m256 _r7 = _mm256_load_ps(p0 + 8 * 7);
+                __m256 _r0 = _mm256_load_blob_ps(p0);
+                __m256 _r1 = _mm256_load_blob_ps(p0 + 8 * 1);
+                __m256 _r2 = _mm256_load_blob_ps(p0 + 8 * 2);
+                __m256 _r3 = _mm256_load_blob_ps(p0 + 8 * 3);
+                __m256 _r4 = _mm256_load_blob_ps(p0 + 8 * 4);
+                __m256 _r5 = _mm256_load_blob_ps(p0 + 8 * 5);
+                __m256 _r6 = _mm256_load_blob_ps(p0 + 8 * 6);
+                __m256 _r7 = _mm256_load_blob_ps(p0 + 8 * 7);
                 transpose8x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
                 _mm256_store_ps(pp, _r0);
                 _mm256_store_ps(pp + 8 * 1, _r1);
@@ -670,19 +686,19 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
         }
         if (elempack == 4)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 4;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 4;
 
             int kk = 0;
             for (; kk + 3 < max_kk; kk += 4)
             {
-                __m128 _r0 = _mm_load_ps(p0);
-                __m128 _r1 = _mm_load_ps(p0 + 4 * 1);
-                __m128 _r2 = _mm_load_ps(p0 + 4 * 2);
-                __m128 _r3 = _mm_load_ps(p0 + 4 * 3);
-                __m128 _r4 = _mm_load_ps(p0 + 4 * 4);
-                __m128 _r5 = _mm_load_ps(p0 + 4 * 5);
-                __m128 _r6 = _mm_load_ps(p0 + 4 * 6);
-                __m128 _r7 = _mm_load_ps(p0 + 4 * 7);
+                __m128 _r0 = _mm_load_blob_ps(p0);
+                __m128 _r1 = _mm_load_blob_ps(p0 + 4 * 1);
+                __m128 _r2 = _mm_load_blob_ps(p0 + 4 * 2);
+                __m128 _r3 = _mm_load_blob_ps(p0 + 4 * 3);
+                __m128 _r4 = _mm_load_blob_ps(p0 + 4 * 4);
+                __m128 _r5 = _mm_load_blob_ps(p0 + 4 * 5);
+                __m128 _r6 = _mm_load_blob_ps(p0 + 4 * 6);
+                __m128 _r7 = _mm_load_blob_ps(p0 + 4 * 7);
                 _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                 _MM_TRANSPOSE4_PS(_r4, _r5, _r6, _r7);
                 _mm_store_ps(pp, _r0);
@@ -699,12 +715,12 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
         }
         if (elempack == 1)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii);
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii);
 
             int kk = 0;
             for (; kk < max_kk; kk++)
             {
-                _mm256_store_ps(pp, _mm256_loadu_ps(p0));
+                _mm256_store_ps(pp, _mm256_loadu_blob_ps(p0));
                 pp += 8;
                 p0 += A_hstep;
             }
@@ -717,15 +733,15 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #if __AVX512F__
         if (elempack == 16)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 16;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 16;
 
             int kk = 0;
             for (; kk + 15 < max_kk; kk += 16)
             {
-                __m512 _r0 = _mm512_load_ps(p0);
-                __m512 _r1 = _mm512_load_ps(p0 + 16 * 1);
-                __m512 _r2 = _mm512_load_ps(p0 + 16 * 2);
-                __m512 _r3 = _mm512_load_ps(p0 + 16 * 3);
+                __m512 _r0 = _mm512_load_blob_ps(p0);
+                __m512 _r1 = _mm512_load_blob_ps(p0 + 16 * 1);
+                __m512 _r2 = _mm512_load_blob_ps(p0 + 16 * 2);
+                __m512 _r3 = _mm512_load_blob_ps(p0 + 16 * 3);
                 transpose16x4_ps(_r0, _r1, _r2, _r3);
                 _mm512_store_ps(pp, _r0);
                 _mm512_store_ps(pp + 16 * 1, _r1);
@@ -738,15 +754,15 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #endif // __AVX512F__
         if (elempack == 8)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 8;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 8;
 
             int kk = 0;
             for (; kk + 7 < max_kk; kk += 8)
             {
-                __m256 _r0 = _mm256_load_ps(p0);
-                __m256 _r1 = _mm256_load_ps(p0 + 8 * 1);
-                __m256 _r2 = _mm256_load_ps(p0 + 8 * 2);
-                __m256 _r3 = _mm256_load_ps(p0 + 8 * 3);
+                __m256 _r0 = _mm256_load_blob_ps(p0);
+                __m256 _r1 = _mm256_load_blob_ps(p0 + 8 * 1);
+                __m256 _r2 = _mm256_load_blob_ps(p0 + 8 * 2);
+                __m256 _r3 = _mm256_load_blob_ps(p0 + 8 * 3);
                 transpose8x4_ps(_r0, _r1, _r2, _r3);
                 _mm256_store_ps(pp, _r0);
                 _mm256_store_ps(pp + 8 * 1, _r1);
@@ -759,15 +775,15 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #endif // __AVX__
         if (elempack == 4)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 4;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 4;
 
             int kk = 0;
             for (; kk + 3 < max_kk; kk += 4)
             {
-                __m128 _r0 = _mm_load_ps(p0);
-                __m128 _r1 = _mm_load_ps(p0 + 4 * 1);
-                __m128 _r2 = _mm_load_ps(p0 + 4 * 2);
-                __m128 _r3 = _mm_load_ps(p0 + 4 * 3);
+                __m128 _r0 = _mm_load_blob_ps(p0);
+                __m128 _r1 = _mm_load_blob_ps(p0 + 4 * 1);
+                __m128 _r2 = _mm_load_blob_ps(p0 + 4 * 2);
+                __m128 _r3 = _mm_load_blob_ps(p0 + 4 * 3);
                 _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
                 _mm_store_ps(pp, _r0);
                 _mm_store_ps(pp + 4 * 1, _r1);
@@ -779,12 +795,12 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
         }
         if (elempack == 1)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii);
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii);
 
             int kk = 0;
             for (; kk < max_kk; kk++)
             {
-                _mm_store_ps(pp, _mm_loadu_ps(p0));
+                _mm_store_ps(pp, _mm_loadu_blob_ps(p0));
                 pp += 4;
                 p0 += A_hstep;
             }
@@ -798,13 +814,13 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #if __AVX512F__
         if (elempack == 16)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 16;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 16;
 
             int kk = 0;
             for (; kk + 15 < max_kk; kk += 16)
             {
-                __m512 _r0 = _mm512_load_ps(p0);
-                __m512 _r1 = _mm512_load_ps(p0 + 16);
+                __m512 _r0 = _mm512_load_blob_ps(p0);
+                __m512 _r1 = _mm512_load_blob_ps(p0 + 16);
                 transpose16x2_ps(_r0, _r1);
                 _mm512_store_ps(pp, _r0);
                 _mm512_store_ps(pp + 16, _r1);
@@ -815,13 +831,13 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #endif // __AVX512F__
         if (elempack == 8)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 8;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 8;
 
             int kk = 0;
             for (; kk + 7 < max_kk; kk += 8)
             {
-                __m256 _r0 = _mm256_load_ps(p0);
-                __m256 _r1 = _mm256_load_ps(p0 + 8);
+                __m256 _r0 = _mm256_load_blob_ps(p0);
+                __m256 _r1 = _mm256_load_blob_ps(p0 + 8);
                 transpose8x2_ps(_r0, _r1);
                 _mm256_store_ps(pp, _r0);
                 _mm256_store_ps(pp + 8, _r1);
@@ -832,13 +848,13 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #endif // __AVX__
         if (elempack == 4)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 4;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 4;
 
             int kk = 0;
             for (; kk + 3 < max_kk; kk += 4)
             {
-                __m128 _r0 = _mm_load_ps(p0);
-                __m128 _r1 = _mm_load_ps(p0 + 4);
+                __m128 _r0 = _mm_load_blob_ps(p0);
+                __m128 _r1 = _mm_load_blob_ps(p0 + 4);
                 __m128 _tmp0 = _mm_unpacklo_ps(_r0, _r1);
                 __m128 _tmp1 = _mm_unpackhi_ps(_r0, _r1);
                 _mm_store_ps(pp, _tmp0);
@@ -850,7 +866,7 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #endif // __SSE2__
         if (elempack == 1)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii);
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii);
 
             int kk = 0;
             for (; kk < max_kk; kk++)
@@ -869,12 +885,12 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #if __AVX512F__
         if (elempack == 16)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 16;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 16;
 
             int kk = 0;
             for (; kk + 15 < max_kk; kk += 16)
             {
-                _mm512_store_ps(pp, _mm512_load_ps(p0));
+                _mm512_store_ps(pp, _mm512_load_blob_ps(p0));
                 pp += 16;
                 p0 += A_hstep * 16;
             }
@@ -882,12 +898,12 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #endif // __AVX512F__
         if (elempack == 8)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 8;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 8;
 
             int kk = 0;
             for (; kk + 7 < max_kk; kk += 8)
             {
-                _mm256_store_ps(pp, _mm256_load_ps(p0));
+                _mm256_store_ps(pp, _mm256_load_blob_ps(p0));
                 pp += 8;
                 p0 += A_hstep * 8;
             }
@@ -895,12 +911,12 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #endif // __AVX__
         if (elempack == 4)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii) * 4;
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii) * 4;
 
             int kk = 0;
             for (; kk + 3 < max_kk; kk += 4)
             {
-                _mm_store_ps(pp, _mm_load_ps(p0));
+                _mm_store_ps(pp, _mm_load_blob_ps(p0));
                 pp += 4;
                 p0 += A_hstep * 4;
             }
@@ -908,7 +924,7 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
 #endif // __SSE2__
         if (elempack == 1)
         {
-            const float* p0 = (const float*)A + k * A_hstep + (i + ii);
+            const TA* p0 = (const TA*)A + k * A_hstep + (i + ii);
 
             int kk = 0;
             for (; kk < max_kk; kk++)
@@ -921,6 +937,11 @@ static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int
     }
 }
 
+static void transpose_pack_A_tile(const Mat& A, Mat& AT, int i, int max_ii, int k, int max_kk)
+{
+    transpose_pack_A_tile_impl<float>(A, AT, i, max_ii, k, max_kk);
+}
+
 static void pack_B_tile(const Mat& B, Mat& BT, int j, int max_jj, int k, int max_kk)
 {
     const int elempack = B.elempack;
@@ -3547,13 +3568,14 @@ static void transpose_unpack_output_tile(const Mat& topT, Mat& top_blob, int i,
     }
 }
 
-static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, const Mat& CT_tile, Mat& topT_tile, Mat& top_blob, int broadcast_type_C, int i, int max_ii, int j, int max_jj, int k, int max_kk, bool k_end)
+template<typename TA, typename TB, typename TO>
+static void gemm_transB_packed_tile_impl(const Mat& AT_tile, const Mat& BT_tile, const Mat& CT_tile, Mat& topT_tile, Mat& top_blob, int broadcast_type_C, int i, int max_ii, int j, int max_jj, int k, int max_kk, bool k_end)
 {
     const int out_elempack = top_blob.elempack;
     const int out_hstep = top_blob.dims == 3 ? (int)top_blob.cstep : top_blob.w;
 
-    const float* pAT = AT_tile;
-    const float* pBT = BT_tile;
+    const TA* pAT = AT_tile;
+    const TB* pBT = BT_tile;
     const float* pC = CT_tile;
 
     float* outptr = topT_tile;
@@ -3564,9 +3586,9 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
 #if __AVX512F__
     for (; ii + 15 < max_ii; ii += 16)
     {
-        float* outptr0 = (float*)top_blob + (i + ii) * out_hstep + j * out_elempack;
+        TO* outptr0 = (TO*)top_blob + (i + ii) * out_hstep + j * out_elempack;
 
-        const float* pB = pBT;
+        const TB* pB = pBT;
 
         if (pC)
         {
@@ -3693,24 +3715,24 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sumb = _mm512_load_ps(outptr + 16 * 11);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m512 _pA = _mm512_load_ps(pA);
-
-                _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[1]), _sum1);
-                _sum2 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[2]), _sum2);
-                _sum3 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[3]), _sum3);
-                _sum4 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[4]), _sum4);
-                _sum5 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[5]), _sum5);
-                _sum6 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[6]), _sum6);
-                _sum7 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[7]), _sum7);
-                _sum8 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[8]), _sum8);
-                _sum9 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[9]), _sum9);
-                _suma = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[10]), _suma);
-                _sumb = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[11]), _sumb);
+                __m512 _pA = _mm512_load_weight_ps(pA);
+
+                _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 1)), _sum1);
+                _sum2 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 2)), _sum2);
+                _sum3 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 3)), _sum3);
+                _sum4 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 4)), _sum4);
+                _sum5 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 5)), _sum5);
+                _sum6 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 6)), _sum6);
+                _sum7 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 7)), _sum7);
+                _sum8 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 8)), _sum8);
+                _sum9 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 9)), _sum9);
+                _suma = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 10)), _suma);
+                _sumb = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 11)), _sumb);
 
                 pA += 16;
                 pB += 12;
@@ -3720,18 +3742,18 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr0, _sum0);
-                    _mm512_store_ps(outptr0 + 16 * 1, _sum1);
-                    _mm512_store_ps(outptr0 + 16 * 2, _sum2);
-                    _mm512_store_ps(outptr0 + 16 * 3, _sum3);
-                    _mm512_store_ps(outptr0 + 16 * 4, _sum4);
-                    _mm512_store_ps(outptr0 + 16 * 5, _sum5);
-                    _mm512_store_ps(outptr0 + 16 * 6, _sum6);
-                    _mm512_store_ps(outptr0 + 16 * 7, _sum7);
-                    _mm512_store_ps(outptr0 + 16 * 8, _sum8);
-                    _mm512_store_ps(outptr0 + 16 * 9, _sum9);
-                    _mm512_store_ps(outptr0 + 16 * 10, _suma);
-                    _mm512_store_ps(outptr0 + 16 * 11, _sumb);
+                    _mm512_store_blob_ps(outptr0, _sum0);
+                    _mm512_store_blob_ps(outptr0 + 16 * 1, _sum1);
+                    _mm512_store_blob_ps(outptr0 + 16 * 2, _sum2);
+                    _mm512_store_blob_ps(outptr0 + 16 * 3, _sum3);
+                    _mm512_store_blob_ps(outptr0 + 16 * 4, _sum4);
+                    _mm512_store_blob_ps(outptr0 + 16 * 5, _sum5);
+                    _mm512_store_blob_ps(outptr0 + 16 * 6, _sum6);
+                    _mm512_store_blob_ps(outptr0 + 16 * 7, _sum7);
+                    _mm512_store_blob_ps(outptr0 + 16 * 8, _sum8);
+                    _mm512_store_blob_ps(outptr0 + 16 * 9, _sum9);
+                    _mm512_store_blob_ps(outptr0 + 16 * 10, _suma);
+                    _mm512_store_blob_ps(outptr0 + 16 * 11, _sumb);
                     outptr0 += 192;
                 }
                 if (out_elempack == 8)
@@ -3749,19 +3771,19 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     __m512 _tmpa = _mm512_shuffle_f32x4(_sum8, _sum9, _MM_SHUFFLE(3, 2, 3, 2));
                     __m512 _tmpb = _mm512_shuffle_f32x4(_suma, _sumb, _MM_SHUFFLE(3, 2, 3, 2));
 
-                    _mm512_storeu_ps(outptr0, _tmp0);
-                    _mm512_storeu_ps(outptr0 + 16, _tmp1);
-                    _mm512_storeu_ps(outptr0 + 16 * 2, _tmp2);
-                    _mm512_storeu_ps(outptr0 + 16 * 3, _tmp3);
-                    _mm512_storeu_ps(outptr0 + 16 * 4, _tmp4);
-                    _mm512_storeu_ps(outptr0 + 16 * 5, _tmp5);
+                    _mm512_storeu_blob_ps(outptr0, _tmp0);
+                    _mm512_storeu_blob_ps(outptr0 + 16, _tmp1);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 2, _tmp2);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 3, _tmp3);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 4, _tmp4);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 5, _tmp5);
 
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _tmp6);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16, _tmp7);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 2, _tmp8);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 3, _tmp9);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 4, _tmpa);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 5, _tmpb);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _tmp6);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16, _tmp7);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 2, _tmp8);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 3, _tmp9);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 4, _tmpa);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 5, _tmpb);
 
                     outptr0 += 96;
                 }
@@ -3793,18 +3815,18 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     _suma = _mm512_shuffle_f32x4(_tmpa, _tmpb, _MM_SHUFFLE(2, 0, 2, 0));
                     _sumb = _mm512_shuffle_f32x4(_tmpa, _tmpb, _MM_SHUFFLE(3, 1, 3, 1));
 
-                    _mm512_storeu_ps(outptr0, _sum0);
-                    _mm512_storeu_ps(outptr0 + 16, _sum4);
-                    _mm512_storeu_ps(outptr0 + 32, _sum8);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4, _sum1);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4 + 16, _sum5);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4 + 32, _sum9);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _sum2);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16, _sum6);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 32, _suma);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12, _sum3);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12 + 16, _sum7);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12 + 32, _sumb);
+                    _mm512_storeu_blob_ps(outptr0, _sum0);
+                    _mm512_storeu_blob_ps(outptr0 + 16, _sum4);
+                    _mm512_storeu_blob_ps(outptr0 + 32, _sum8);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4, _sum1);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4 + 16, _sum5);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4 + 32, _sum9);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _sum2);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16, _sum6);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 32, _suma);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12, _sum3);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12 + 16, _sum7);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12 + 32, _sumb);
 
                     outptr0 += 48;
                 }
@@ -3812,41 +3834,41 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 {
                     transpose16x12_ps(_sum0, _sum1, _sum2, _sum3, _sum4, _sum5, _sum6, _sum7, _sum8, _sum9, _suma, _sumb);
 
-                    _mm256_storeu_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
-                    _mm_storeu_ps(outptr0 + 8, _mm512_extractf32x4_ps(_sum0, 2));
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _mm512_extractf32x4_ps(_sum0, 3));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 1 + 4, _mm512_extractf32x8_ps(_sum1, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 2, _mm512_extractf32x8_ps(_sum1, 1));
-                    _mm_storeu_ps(outptr0 + out_hstep * 2 + 8, _mm512_extractf32x4_ps(_sum2, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _mm512_extractf32x4_ps(_sum2, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 3 + 4, _mm512_extractf32x8_ps(_sum2, 1));
-
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _mm512_extractf32x8_ps(_sum3, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 4 + 8, _mm512_extractf32x4_ps(_sum3, 2));
-                    _mm_storeu_ps(outptr0 + out_hstep * 5, _mm512_extractf32x4_ps(_sum3, 3));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 5 + 4, _mm512_extractf32x8_ps(_sum4, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 6, _mm512_extractf32x8_ps(_sum4, 1));
-                    _mm_storeu_ps(outptr0 + out_hstep * 6 + 8, _mm512_extractf32x4_ps(_sum5, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 7, _mm512_extractf32x4_ps(_sum5, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 7 + 4, _mm512_extractf32x8_ps(_sum5, 1));
-
-                    _mm256_storeu_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum6, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 8 + 8, _mm512_extractf32x4_ps(_sum6, 2));
-                    _mm_storeu_ps(outptr0 + out_hstep * 9, _mm512_extractf32x4_ps(_sum6, 3));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 9 + 4, _mm512_extractf32x8_ps(_sum7, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 10, _mm512_extractf32x8_ps(_sum7, 1));
-                    _mm_storeu_ps(outptr0 + out_hstep * 10 + 8, _mm512_extractf32x4_ps(_sum8, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 11, _mm512_extractf32x4_ps(_sum8, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 11 + 4, _mm512_extractf32x8_ps(_sum8, 1));
-
-                    _mm256_storeu_ps(outptr0 + out_hstep * 12, _mm512_extractf32x8_ps(_sum9, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 12 + 8, _mm512_extractf32x4_ps(_sum9, 2));
-                    _mm_storeu_ps(outptr0 + out_hstep * 13, _mm512_extractf32x4_ps(_sum9, 3));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 13 + 4, _mm512_extractf32x8_ps(_suma, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 14, _mm512_extractf32x8_ps(_suma, 1));
-                    _mm_storeu_ps(outptr0 + out_hstep * 14 + 8, _mm512_extractf32x4_ps(_sumb, 0));
-                    _mm_storeu_ps(outptr0 + out_hstep * 15, _mm512_extractf32x4_ps(_sumb, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 15 + 4, _mm512_extractf32x8_ps(_sumb, 1));
+                    _mm256_storeu_blob_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
+                    _mm_storeu_blob_ps(outptr0 + 8, _mm512_extractf32x4_ps(_sum0, 2));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _mm512_extractf32x4_ps(_sum0, 3));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 1 + 4, _mm512_extractf32x8_ps(_sum1, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 2, _mm512_extractf32x8_ps(_sum1, 1));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2 + 8, _mm512_extractf32x4_ps(_sum2, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _mm512_extractf32x4_ps(_sum2, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 3 + 4, _mm512_extractf32x8_ps(_sum2, 1));
+
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _mm512_extractf32x8_ps(_sum3, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 4 + 8, _mm512_extractf32x4_ps(_sum3, 2));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 5, _mm512_extractf32x4_ps(_sum3, 3));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 5 + 4, _mm512_extractf32x8_ps(_sum4, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 6, _mm512_extractf32x8_ps(_sum4, 1));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 6 + 8, _mm512_extractf32x4_ps(_sum5, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 7, _mm512_extractf32x4_ps(_sum5, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 7 + 4, _mm512_extractf32x8_ps(_sum5, 1));
+
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum6, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 8 + 8, _mm512_extractf32x4_ps(_sum6, 2));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 9, _mm512_extractf32x4_ps(_sum6, 3));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 9 + 4, _mm512_extractf32x8_ps(_sum7, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 10, _mm512_extractf32x8_ps(_sum7, 1));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 10 + 8, _mm512_extractf32x4_ps(_sum8, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 11, _mm512_extractf32x4_ps(_sum8, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 11 + 4, _mm512_extractf32x8_ps(_sum8, 1));
+
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 12, _mm512_extractf32x8_ps(_sum9, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 12 + 8, _mm512_extractf32x4_ps(_sum9, 2));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 13, _mm512_extractf32x4_ps(_sum9, 3));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 13 + 4, _mm512_extractf32x8_ps(_suma, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 14, _mm512_extractf32x8_ps(_suma, 1));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 14 + 8, _mm512_extractf32x4_ps(_sumb, 0));
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 15, _mm512_extractf32x4_ps(_sumb, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 15 + 4, _mm512_extractf32x8_ps(_sumb, 1));
 
                     outptr0 += 12;
                 }
@@ -3953,20 +3975,20 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum7 = _mm512_load_ps(outptr + 16 * 7);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m512 _pA = _mm512_load_ps(pA);
+                __m512 _pA = _mm512_load_weight_ps(pA);
 
-                _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[1]), _sum1);
-                _sum2 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[2]), _sum2);
-                _sum3 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[3]), _sum3);
-                _sum4 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[4]), _sum4);
-                _sum5 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[5]), _sum5);
-                _sum6 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[6]), _sum6);
-                _sum7 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[7]), _sum7);
+                _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 1)), _sum1);
+                _sum2 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 2)), _sum2);
+                _sum3 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 3)), _sum3);
+                _sum4 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 4)), _sum4);
+                _sum5 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 5)), _sum5);
+                _sum6 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 6)), _sum6);
+                _sum7 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 7)), _sum7);
 
                 pA += 16;
                 pB += 8;
@@ -3976,14 +3998,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr0, _sum0);
-                    _mm512_store_ps(outptr0 + 16 * 1, _sum1);
-                    _mm512_store_ps(outptr0 + 16 * 2, _sum2);
-                    _mm512_store_ps(outptr0 + 16 * 3, _sum3);
-                    _mm512_store_ps(outptr0 + 16 * 4, _sum4);
-                    _mm512_store_ps(outptr0 + 16 * 5, _sum5);
-                    _mm512_store_ps(outptr0 + 16 * 6, _sum6);
-                    _mm512_store_ps(outptr0 + 16 * 7, _sum7);
+                    _mm512_store_blob_ps(outptr0, _sum0);
+                    _mm512_store_blob_ps(outptr0 + 16 * 1, _sum1);
+                    _mm512_store_blob_ps(outptr0 + 16 * 2, _sum2);
+                    _mm512_store_blob_ps(outptr0 + 16 * 3, _sum3);
+                    _mm512_store_blob_ps(outptr0 + 16 * 4, _sum4);
+                    _mm512_store_blob_ps(outptr0 + 16 * 5, _sum5);
+                    _mm512_store_blob_ps(outptr0 + 16 * 6, _sum6);
+                    _mm512_store_blob_ps(outptr0 + 16 * 7, _sum7);
                     outptr0 += 128;
                 }
                 if (out_elempack == 8)
@@ -3997,15 +4019,15 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     __m512 _tmp6 = _mm512_shuffle_f32x4(_sum4, _sum5, _MM_SHUFFLE(3, 2, 3, 2));
                     __m512 _tmp7 = _mm512_shuffle_f32x4(_sum6, _sum7, _MM_SHUFFLE(3, 2, 3, 2));
 
-                    _mm512_storeu_ps(outptr0, _tmp0);
-                    _mm512_storeu_ps(outptr0 + 16, _tmp1);
-                    _mm512_storeu_ps(outptr0 + 16 * 2, _tmp2);
-                    _mm512_storeu_ps(outptr0 + 16 * 3, _tmp3);
+                    _mm512_storeu_blob_ps(outptr0, _tmp0);
+                    _mm512_storeu_blob_ps(outptr0 + 16, _tmp1);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 2, _tmp2);
+                    _mm512_storeu_blob_ps(outptr0 + 16 * 3, _tmp3);
 
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _tmp4);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16, _tmp5);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 2, _tmp6);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16 * 3, _tmp7);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _tmp4);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16, _tmp5);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 2, _tmp6);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16 * 3, _tmp7);
 
                     outptr0 += 64;
                 }
@@ -4029,14 +4051,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     _sum6 = _mm512_shuffle_f32x4(_tmp6, _tmp7, _MM_SHUFFLE(2, 0, 2, 0));
                     _sum7 = _mm512_shuffle_f32x4(_tmp6, _tmp7, _MM_SHUFFLE(3, 1, 3, 1));
 
-                    _mm512_storeu_ps(outptr0, _sum0);
-                    _mm512_storeu_ps(outptr0 + 16, _sum4);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4, _sum1);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4 + 16, _sum5);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _sum2);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16, _sum6);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12, _sum3);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12 + 16, _sum7);
+                    _mm512_storeu_blob_ps(outptr0, _sum0);
+                    _mm512_storeu_blob_ps(outptr0 + 16, _sum4);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4, _sum1);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4 + 16, _sum5);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _sum2);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16, _sum6);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12, _sum3);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12 + 16, _sum7);
 
                     outptr0 += 32;
                 }
@@ -4044,22 +4066,22 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 {
                     transpose16x8_ps(_sum0, _sum1, _sum2, _sum3, _sum4, _sum5, _sum6, _sum7);
 
-                    _mm256_storeu_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 1, _mm512_extractf32x8_ps(_sum0, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 2, _mm512_extractf32x8_ps(_sum1, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 3, _mm512_extractf32x8_ps(_sum1, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _mm512_extractf32x8_ps(_sum2, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 5, _mm512_extractf32x8_ps(_sum2, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 6, _mm512_extractf32x8_ps(_sum3, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 7, _mm512_extractf32x8_ps(_sum3, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum4, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 9, _mm512_extractf32x8_ps(_sum4, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 10, _mm512_extractf32x8_ps(_sum5, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 11, _mm512_extractf32x8_ps(_sum5, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 12, _mm512_extractf32x8_ps(_sum6, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 13, _mm512_extractf32x8_ps(_sum6, 1));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 14, _mm512_extractf32x8_ps(_sum7, 0));
-                    _mm256_storeu_ps(outptr0 + out_hstep * 15, _mm512_extractf32x8_ps(_sum7, 1));
+                    _mm256_storeu_blob_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 1, _mm512_extractf32x8_ps(_sum0, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 2, _mm512_extractf32x8_ps(_sum1, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 3, _mm512_extractf32x8_ps(_sum1, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _mm512_extractf32x8_ps(_sum2, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 5, _mm512_extractf32x8_ps(_sum2, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 6, _mm512_extractf32x8_ps(_sum3, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 7, _mm512_extractf32x8_ps(_sum3, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum4, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 9, _mm512_extractf32x8_ps(_sum4, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 10, _mm512_extractf32x8_ps(_sum5, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 11, _mm512_extractf32x8_ps(_sum5, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 12, _mm512_extractf32x8_ps(_sum6, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 13, _mm512_extractf32x8_ps(_sum6, 1));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 14, _mm512_extractf32x8_ps(_sum7, 0));
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 15, _mm512_extractf32x8_ps(_sum7, 1));
 
                     outptr0 += 8;
                 }
@@ -4134,16 +4156,16 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum3 = _mm512_load_ps(outptr + 16 * 3);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m512 _pA = _mm512_load_ps(pA);
+                __m512 _pA = _mm512_load_weight_ps(pA);
 
-                _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[1]), _sum1);
-                _sum2 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[2]), _sum2);
-                _sum3 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[3]), _sum3);
+                _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 1)), _sum1);
+                _sum2 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 2)), _sum2);
+                _sum3 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 3)), _sum3);
 
                 pA += 16;
                 pB += 4;
@@ -4153,10 +4175,10 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr0, _sum0);
-                    _mm512_store_ps(outptr0 + 16 * 1, _sum1);
-                    _mm512_store_ps(outptr0 + 16 * 2, _sum2);
-                    _mm512_store_ps(outptr0 + 16 * 3, _sum3);
+                    _mm512_store_blob_ps(outptr0, _sum0);
+                    _mm512_store_blob_ps(outptr0 + 16 * 1, _sum1);
+                    _mm512_store_blob_ps(outptr0 + 16 * 2, _sum2);
+                    _mm512_store_blob_ps(outptr0 + 16 * 3, _sum3);
                     outptr0 += 64;
                 }
                 if (out_elempack == 8)
@@ -4166,11 +4188,11 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     __m512 _tmp2 = _mm512_shuffle_f32x4(_sum0, _sum1, _MM_SHUFFLE(3, 2, 3, 2));
                     __m512 _tmp3 = _mm512_shuffle_f32x4(_sum2, _sum3, _MM_SHUFFLE(3, 2, 3, 2));
 
-                    _mm512_storeu_ps(outptr0, _tmp0);
-                    _mm512_storeu_ps(outptr0 + 16, _tmp1);
+                    _mm512_storeu_blob_ps(outptr0, _tmp0);
+                    _mm512_storeu_blob_ps(outptr0 + 16, _tmp1);
 
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _tmp2);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8 + 16, _tmp3);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _tmp2);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8 + 16, _tmp3);
 
                     outptr0 += 32;
                 }
@@ -4186,10 +4208,10 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     _sum2 = _mm512_shuffle_f32x4(_tmp2, _tmp3, _MM_SHUFFLE(2, 0, 2, 0));
                     _sum3 = _mm512_shuffle_f32x4(_tmp2, _tmp3, _MM_SHUFFLE(3, 1, 3, 1));
 
-                    _mm512_storeu_ps(outptr0, _sum0);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 4, _sum1);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _sum2);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 12, _sum3);
+                    _mm512_storeu_blob_ps(outptr0, _sum0);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 4, _sum1);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _sum2);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 12, _sum3);
 
                     outptr0 += 16;
                 }
@@ -4217,22 +4239,22 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     _MM_TRANSPOSE4_PS(_sum0_2, _sum1_2, _sum2_2, _sum3_2);
                     _MM_TRANSPOSE4_PS(_sum0_3, _sum1_3, _sum2_3, _sum3_3);
 
-                    _mm_storeu_ps(outptr0, _sum0_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _sum1_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2, _sum2_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _sum3_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 4, _sum0_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 5, _sum1_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 6, _sum2_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 7, _sum3_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 8, _sum0_2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 9, _sum1_2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 10, _sum2_2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 11, _sum3_2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 12, _sum0_3);
-                    _mm_storeu_ps(outptr0 + out_hstep * 13, _sum1_3);
-                    _mm_storeu_ps(outptr0 + out_hstep * 14, _sum2_3);
-                    _mm_storeu_ps(outptr0 + out_hstep * 15, _sum3_3);
+                    _mm_storeu_blob_ps(outptr0, _sum0_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 4, _sum0_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 5, _sum1_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 6, _sum2_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 7, _sum3_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 8, _sum0_2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 9, _sum1_2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 10, _sum2_2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 11, _sum3_2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 12, _sum0_3);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 13, _sum1_3);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 14, _sum2_3);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 15, _sum3_3);
 
                     outptr0 += 4;
                 }
@@ -4289,14 +4311,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum1 = _mm512_load_ps(outptr + 16);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m512 _pA = _mm512_load_ps(pA);
+                __m512 _pA = _mm512_load_weight_ps(pA);
 
-                _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[1]), _sum1);
+                _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB + 1)), _sum1);
 
                 pA += 16;
                 pB += 2;
@@ -4306,8 +4328,8 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr0, _sum0);
-                    _mm512_store_ps(outptr0 + 16, _sum1);
+                    _mm512_store_blob_ps(outptr0, _sum0);
+                    _mm512_store_blob_ps(outptr0 + 16, _sum1);
                     outptr0 += 32;
                 }
                 if (out_elempack == 8)
@@ -4315,24 +4337,24 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     __m512 _tmp0 = _mm512_shuffle_f32x4(_sum0, _sum1, _MM_SHUFFLE(1, 0, 1, 0));
                     __m512 _tmp1 = _mm512_shuffle_f32x4(_sum0, _sum1, _MM_SHUFFLE(3, 2, 3, 2));
 
-                    _mm512_storeu_ps(outptr0, _tmp0);
-                    _mm512_storeu_ps(outptr0 + out_hstep * 8, _tmp1);
+                    _mm512_storeu_blob_ps(outptr0, _tmp0);
+                    _mm512_storeu_blob_ps(outptr0 + out_hstep * 8, _tmp1);
 
                     outptr0 += 16;
                 }
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _mm512_extractf32x4_ps(_sum0, 0));
-                    _mm_store_ps(outptr0 + 4, _mm512_extractf32x4_ps(_sum1, 0));
+                    _mm_store_blob_ps(outptr0, _mm512_extractf32x4_ps(_sum0, 0));
+                    _mm_store_blob_ps(outptr0 + 4, _mm512_extractf32x4_ps(_sum1, 0));
 
-                    _mm_store_ps(outptr0 + out_hstep * 4, _mm512_extractf32x4_ps(_sum0, 1));
-                    _mm_store_ps(outptr0 + out_hstep * 4 + 4, _mm512_extractf32x4_ps(_sum1, 1));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 4, _mm512_extractf32x4_ps(_sum0, 1));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 4 + 4, _mm512_extractf32x4_ps(_sum1, 1));
 
-                    _mm_store_ps(outptr0 + out_hstep * 8, _mm512_extractf32x4_ps(_sum0, 2));
-                    _mm_store_ps(outptr0 + out_hstep * 8 + 4, _mm512_extractf32x4_ps(_sum1, 2));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 8, _mm512_extractf32x4_ps(_sum0, 2));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 8 + 4, _mm512_extractf32x4_ps(_sum1, 2));
 
-                    _mm_store_ps(outptr0 + out_hstep * 12, _mm512_extractf32x4_ps(_sum0, 3));
-                    _mm_store_ps(outptr0 + out_hstep * 12 + 4, _mm512_extractf32x4_ps(_sum1, 3));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 12, _mm512_extractf32x4_ps(_sum0, 3));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 12 + 4, _mm512_extractf32x4_ps(_sum1, 3));
                     outptr0 += 8;
                 }
                 if (out_elempack == 1)
@@ -4421,13 +4443,13 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum0 = _mm512_load_ps(outptr);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m512 _pA = _mm512_load_ps(pA);
+                __m512 _pA = _mm512_load_weight_ps(pA);
 
-                _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(pB[0]), _sum0);
+                _sum0 = _mm512_fmadd_ps(_pA, _mm512_set1_ps(load_weight(pB)), _sum0);
 
                 pA += 16;
                 pB += 1;
@@ -4437,21 +4459,21 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 16)
                 {
-                    _mm512_store_ps(outptr0, _sum0);
+                    _mm512_store_blob_ps(outptr0, _sum0);
                     outptr0 += 16;
                 }
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
-                    _mm256_store_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum0, 1));
+                    _mm256_store_blob_ps(outptr0, _mm512_extractf32x8_ps(_sum0, 0));
+                    _mm256_store_blob_ps(outptr0 + out_hstep * 8, _mm512_extractf32x8_ps(_sum0, 1));
                     outptr0 += 8;
                 }
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _mm512_extractf32x4_ps(_sum0, 0));
-                    _mm_store_ps(outptr0 + out_hstep * 4, _mm512_extractf32x4_ps(_sum0, 1));
-                    _mm_store_ps(outptr0 + out_hstep * 8, _mm512_extractf32x4_ps(_sum0, 2));
-                    _mm_store_ps(outptr0 + out_hstep * 12, _mm512_extractf32x4_ps(_sum0, 3));
+                    _mm_store_blob_ps(outptr0, _mm512_extractf32x4_ps(_sum0, 0));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 4, _mm512_extractf32x4_ps(_sum0, 1));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 8, _mm512_extractf32x4_ps(_sum0, 2));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 12, _mm512_extractf32x4_ps(_sum0, 3));
                     outptr0 += 4;
                 }
                 if (out_elempack == 1)
@@ -4491,9 +4513,9 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
 #endif // __AVX512F__
     for (; ii + 7 < max_ii; ii += 8)
     {
-        float* outptr0 = (float*)top_blob + (i + ii) * out_hstep + j * out_elempack;
+        TO* outptr0 = (TO*)top_blob + (i + ii) * out_hstep + j * out_elempack;
 
-        const float* pB = pBT;
+        const TB* pB = pBT;
 
         if (pC)
         {
@@ -4620,24 +4642,24 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sumb = _mm256_load_ps(outptr + 8 * 11);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m256 _pA = _mm256_load_ps(pA);
-
-                _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[1]), _sum1);
-                _sum2 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[2]), _sum2);
-                _sum3 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[3]), _sum3);
-                _sum4 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[4]), _sum4);
-                _sum5 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[5]), _sum5);
-                _sum6 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[6]), _sum6);
-                _sum7 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[7]), _sum7);
-                _sum8 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[8]), _sum8);
-                _sum9 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[9]), _sum9);
-                _suma = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[10]), _suma);
-                _sumb = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[11]), _sumb);
+                __m256 _pA = _mm256_load_weight_ps(pA);
+
+                _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 1)), _sum1);
+                _sum2 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 2)), _sum2);
+                _sum3 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 3)), _sum3);
+                _sum4 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 4)), _sum4);
+                _sum5 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 5)), _sum5);
+                _sum6 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 6)), _sum6);
+                _sum7 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 7)), _sum7);
+                _sum8 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 8)), _sum8);
+                _sum9 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 9)), _sum9);
+                _suma = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 10)), _suma);
+                _sumb = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 11)), _sumb);
 
                 pA += 8;
                 pB += 12;
@@ -4647,18 +4669,18 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _sum0);
-                    _mm256_store_ps(outptr0 + 8 * 1, _sum1);
-                    _mm256_store_ps(outptr0 + 8 * 2, _sum2);
-                    _mm256_store_ps(outptr0 + 8 * 3, _sum3);
-                    _mm256_store_ps(outptr0 + 8 * 4, _sum4);
-                    _mm256_store_ps(outptr0 + 8 * 5, _sum5);
-                    _mm256_store_ps(outptr0 + 8 * 6, _sum6);
-                    _mm256_store_ps(outptr0 + 8 * 7, _sum7);
-                    _mm256_store_ps(outptr0 + 8 * 8, _sum8);
-                    _mm256_store_ps(outptr0 + 8 * 9, _sum9);
-                    _mm256_store_ps(outptr0 + 8 * 10, _suma);
-                    _mm256_store_ps(outptr0 + 8 * 11, _sumb);
+                    _mm256_store_blob_ps(outptr0, _sum0);
+                    _mm256_store_blob_ps(outptr0 + 8 * 1, _sum1);
+                    _mm256_store_blob_ps(outptr0 + 8 * 2, _sum2);
+                    _mm256_store_blob_ps(outptr0 + 8 * 3, _sum3);
+                    _mm256_store_blob_ps(outptr0 + 8 * 4, _sum4);
+                    _mm256_store_blob_ps(outptr0 + 8 * 5, _sum5);
+                    _mm256_store_blob_ps(outptr0 + 8 * 6, _sum6);
+                    _mm256_store_blob_ps(outptr0 + 8 * 7, _sum7);
+                    _mm256_store_blob_ps(outptr0 + 8 * 8, _sum8);
+                    _mm256_store_blob_ps(outptr0 + 8 * 9, _sum9);
+                    _mm256_store_blob_ps(outptr0 + 8 * 10, _suma);
+                    _mm256_store_blob_ps(outptr0 + 8 * 11, _sumb);
                     outptr0 += 96;
                 }
                 if (out_elempack == 4)
@@ -4676,19 +4698,19 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     __m256 _tmpa = _mm256_permute2f128_ps(_sum8, _sum9, _MM_SHUFFLE(0, 3, 0, 1));
                     __m256 _tmpb = _mm256_permute2f128_ps(_suma, _sumb, _MM_SHUFFLE(0, 3, 0, 1));
 
-                    _mm256_storeu_ps(outptr0, _tmp0);
-                    _mm256_storeu_ps(outptr0 + 8, _tmp1);
-                    _mm256_storeu_ps(outptr0 + 8 * 2, _tmp2);
-                    _mm256_storeu_ps(outptr0 + 8 * 3, _tmp3);
-                    _mm256_storeu_ps(outptr0 + 8 * 4, _tmp4);
-                    _mm256_storeu_ps(outptr0 + 8 * 5, _tmp5);
+                    _mm256_storeu_blob_ps(outptr0, _tmp0);
+                    _mm256_storeu_blob_ps(outptr0 + 8, _tmp1);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 2, _tmp2);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 3, _tmp3);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 4, _tmp4);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 5, _tmp5);
 
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _tmp6);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8, _tmp7);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 2, _tmp8);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 3, _tmp9);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 4, _tmpa);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 5, _tmpb);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _tmp6);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8, _tmp7);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 2, _tmp8);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 3, _tmp9);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 4, _tmpa);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 5, _tmpb);
 
                     outptr0 += 48;
                 }
@@ -4696,14 +4718,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 {
                     transpose8x8_ps(_sum0, _sum1, _sum2, _sum3, _sum4, _sum5, _sum6, _sum7);
 
-                    _mm256_storeu_ps(outptr0, _sum0);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 1, _sum1);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 2, _sum2);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 3, _sum3);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _sum4);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 5, _sum5);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 6, _sum6);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 7, _sum7);
+                    _mm256_storeu_blob_ps(outptr0, _sum0);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _sum4);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 5, _sum5);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 6, _sum6);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 7, _sum7);
 
                     __m128 _sum8_0 = _mm256_extractf128_ps(_sum8, 0);
                     __m128 _sum9_0 = _mm256_extractf128_ps(_sum9, 0);
@@ -4717,14 +4739,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     _MM_TRANSPOSE4_PS(_sum8_0, _sum9_0, _suma_0, _sumb_0);
                     _MM_TRANSPOSE4_PS(_sum8_1, _sum9_1, _suma_1, _sumb_1);
 
-                    _mm_storeu_ps(outptr0 + 8, _sum8_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1 + 8, _sum9_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2 + 8, _suma_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3 + 8, _sumb_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 4 + 8, _sum8_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 5 + 8, _sum9_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 6 + 8, _suma_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 7 + 8, _sumb_1);
+                    _mm_storeu_blob_ps(outptr0 + 8, _sum8_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1 + 8, _sum9_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2 + 8, _suma_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3 + 8, _sumb_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 4 + 8, _sum8_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 5 + 8, _sum9_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 6 + 8, _suma_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 7 + 8, _sumb_1);
 
                     outptr0 += 12;
                 }
@@ -4831,20 +4853,20 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum7 = _mm256_load_ps(outptr + 8 * 7);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m256 _pA = _mm256_load_ps(pA);
+                __m256 _pA = _mm256_load_weight_ps(pA);
 
-                _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[1]), _sum1);
-                _sum2 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[2]), _sum2);
-                _sum3 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[3]), _sum3);
-                _sum4 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[4]), _sum4);
-                _sum5 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[5]), _sum5);
-                _sum6 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[6]), _sum6);
-                _sum7 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[7]), _sum7);
+                _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 1)), _sum1);
+                _sum2 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 2)), _sum2);
+                _sum3 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 3)), _sum3);
+                _sum4 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 4)), _sum4);
+                _sum5 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 5)), _sum5);
+                _sum6 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 6)), _sum6);
+                _sum7 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 7)), _sum7);
 
                 pA += 8;
                 pB += 8;
@@ -4854,14 +4876,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _sum0);
-                    _mm256_store_ps(outptr0 + 8 * 1, _sum1);
-                    _mm256_store_ps(outptr0 + 8 * 2, _sum2);
-                    _mm256_store_ps(outptr0 + 8 * 3, _sum3);
-                    _mm256_store_ps(outptr0 + 8 * 4, _sum4);
-                    _mm256_store_ps(outptr0 + 8 * 5, _sum5);
-                    _mm256_store_ps(outptr0 + 8 * 6, _sum6);
-                    _mm256_store_ps(outptr0 + 8 * 7, _sum7);
+                    _mm256_store_blob_ps(outptr0, _sum0);
+                    _mm256_store_blob_ps(outptr0 + 8 * 1, _sum1);
+                    _mm256_store_blob_ps(outptr0 + 8 * 2, _sum2);
+                    _mm256_store_blob_ps(outptr0 + 8 * 3, _sum3);
+                    _mm256_store_blob_ps(outptr0 + 8 * 4, _sum4);
+                    _mm256_store_blob_ps(outptr0 + 8 * 5, _sum5);
+                    _mm256_store_blob_ps(outptr0 + 8 * 6, _sum6);
+                    _mm256_store_blob_ps(outptr0 + 8 * 7, _sum7);
                     outptr0 += 64;
                 }
                 if (out_elempack == 4)
@@ -4875,15 +4897,15 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     __m256 _tmp6 = _mm256_permute2f128_ps(_sum4, _sum5, _MM_SHUFFLE(0, 3, 0, 1));
                     __m256 _tmp7 = _mm256_permute2f128_ps(_sum6, _sum7, _MM_SHUFFLE(0, 3, 0, 1));
 
-                    _mm256_storeu_ps(outptr0, _tmp0);
-                    _mm256_storeu_ps(outptr0 + 8, _tmp1);
-                    _mm256_storeu_ps(outptr0 + 8 * 2, _tmp2);
-                    _mm256_storeu_ps(outptr0 + 8 * 3, _tmp3);
+                    _mm256_storeu_blob_ps(outptr0, _tmp0);
+                    _mm256_storeu_blob_ps(outptr0 + 8, _tmp1);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 2, _tmp2);
+                    _mm256_storeu_blob_ps(outptr0 + 8 * 3, _tmp3);
 
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _tmp4);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8, _tmp5);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 2, _tmp6);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8 * 3, _tmp7);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _tmp4);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8, _tmp5);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 2, _tmp6);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8 * 3, _tmp7);
 
                     outptr0 += 32;
                 }
@@ -4891,14 +4913,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 {
                     transpose8x8_ps(_sum0, _sum1, _sum2, _sum3, _sum4, _sum5, _sum6, _sum7);
 
-                    _mm256_storeu_ps(outptr0, _sum0);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 1, _sum1);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 2, _sum2);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 3, _sum3);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _sum4);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 5, _sum5);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 6, _sum6);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 7, _sum7);
+                    _mm256_storeu_blob_ps(outptr0, _sum0);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _sum4);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 5, _sum5);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 6, _sum6);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 7, _sum7);
 
                     outptr0 += 8;
                 }
@@ -4973,16 +4995,16 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum3 = _mm256_load_ps(outptr + 8 * 3);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m256 _pA = _mm256_load_ps(pA);
+                __m256 _pA = _mm256_load_weight_ps(pA);
 
-                _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[1]), _sum1);
-                _sum2 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[2]), _sum2);
-                _sum3 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[3]), _sum3);
+                _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 1)), _sum1);
+                _sum2 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 2)), _sum2);
+                _sum3 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 3)), _sum3);
 
                 pA += 8;
                 pB += 4;
@@ -4992,10 +5014,10 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _sum0);
-                    _mm256_store_ps(outptr0 + 8 * 1, _sum1);
-                    _mm256_store_ps(outptr0 + 8 * 2, _sum2);
-                    _mm256_store_ps(outptr0 + 8 * 3, _sum3);
+                    _mm256_store_blob_ps(outptr0, _sum0);
+                    _mm256_store_blob_ps(outptr0 + 8 * 1, _sum1);
+                    _mm256_store_blob_ps(outptr0 + 8 * 2, _sum2);
+                    _mm256_store_blob_ps(outptr0 + 8 * 3, _sum3);
                     outptr0 += 32;
                 }
                 if (out_elempack == 4)
@@ -5005,11 +5027,11 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     __m256 _tmp2 = _mm256_permute2f128_ps(_sum0, _sum1, _MM_SHUFFLE(0, 3, 0, 1));
                     __m256 _tmp3 = _mm256_permute2f128_ps(_sum2, _sum3, _MM_SHUFFLE(0, 3, 0, 1));
 
-                    _mm256_storeu_ps(outptr0, _tmp0);
-                    _mm256_storeu_ps(outptr0 + 8, _tmp1);
+                    _mm256_storeu_blob_ps(outptr0, _tmp0);
+                    _mm256_storeu_blob_ps(outptr0 + 8, _tmp1);
 
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _tmp2);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4 + 8, _tmp3);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _tmp2);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4 + 8, _tmp3);
 
                     outptr0 += 16;
                 }
@@ -5027,14 +5049,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     _MM_TRANSPOSE4_PS(_sum0_0, _sum1_0, _sum2_0, _sum3_0);
                     _MM_TRANSPOSE4_PS(_sum0_1, _sum1_1, _sum2_1, _sum3_1);
 
-                    _mm_storeu_ps(outptr0, _sum0_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _sum1_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2, _sum2_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _sum3_0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 4, _sum0_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 5, _sum1_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 6, _sum2_1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 7, _sum3_1);
+                    _mm_storeu_blob_ps(outptr0, _sum0_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3_0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 4, _sum0_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 5, _sum1_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 6, _sum2_1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 7, _sum3_1);
 
                     outptr0 += 4;
                 }
@@ -5091,14 +5113,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum1 = _mm256_load_ps(outptr + 8);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m256 _pA = _mm256_load_ps(pA);
+                __m256 _pA = _mm256_load_weight_ps(pA);
 
-                _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[1]), _sum1);
+                _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB + 1)), _sum1);
 
                 pA += 8;
                 pB += 2;
@@ -5108,8 +5130,8 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _sum0);
-                    _mm256_store_ps(outptr0 + 8, _sum1);
+                    _mm256_store_blob_ps(outptr0, _sum0);
+                    _mm256_store_blob_ps(outptr0 + 8, _sum1);
                     outptr0 += 16;
                 }
                 if (out_elempack == 4)
@@ -5117,8 +5139,8 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     __m256 _tmp0 = _mm256_permute2f128_ps(_sum0, _sum1, _MM_SHUFFLE(0, 2, 0, 0));
                     __m256 _tmp1 = _mm256_permute2f128_ps(_sum0, _sum1, _MM_SHUFFLE(0, 3, 0, 1));
 
-                    _mm256_storeu_ps(outptr0, _tmp0);
-                    _mm256_storeu_ps(outptr0 + out_hstep * 4, _tmp1);
+                    _mm256_storeu_blob_ps(outptr0, _tmp0);
+                    _mm256_storeu_blob_ps(outptr0 + out_hstep * 4, _tmp1);
                     outptr0 += 8;
                 }
                 if (out_elempack == 1)
@@ -5191,13 +5213,13 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum0 = _mm256_load_ps(outptr);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m256 _pA = _mm256_load_ps(pA);
+                __m256 _pA = _mm256_load_weight_ps(pA);
 
-                _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(pB[0]), _sum0);
+                _sum0 = _mm256_comp_fmadd_ps(_pA, _mm256_set1_ps(load_weight(pB)), _sum0);
 
                 pA += 8;
                 pB += 1;
@@ -5207,13 +5229,13 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 8)
                 {
-                    _mm256_store_ps(outptr0, _sum0);
+                    _mm256_store_blob_ps(outptr0, _sum0);
                     outptr0 += 8;
                 }
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _mm256_extractf128_ps(_sum0, 0));
-                    _mm_store_ps(outptr0 + out_hstep * 4, _mm256_extractf128_ps(_sum0, 1));
+                    _mm_store_blob_ps(outptr0, _mm256_extractf128_ps(_sum0, 0));
+                    _mm_store_blob_ps(outptr0 + out_hstep * 4, _mm256_extractf128_ps(_sum0, 1));
                     outptr0 += 4;
                 }
                 if (out_elempack == 1)
@@ -5245,9 +5267,9 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
 #endif // __AVX__
     for (; ii + 3 < max_ii; ii += 4)
     {
-        float* outptr0 = (float*)top_blob + (i + ii) * out_hstep + j * out_elempack;
+        TO* outptr0 = (TO*)top_blob + (i + ii) * out_hstep + j * out_elempack;
 
-        const float* pB = pBT;
+        const TB* pB = pBT;
 
         if (pC)
         {
@@ -5374,24 +5396,24 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sumb = _mm_load_ps(outptr + 4 * 11);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pA = _mm_load_ps(pA);
-
-                _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[1]), _sum1);
-                _sum2 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[2]), _sum2);
-                _sum3 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[3]), _sum3);
-                _sum4 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[4]), _sum4);
-                _sum5 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[5]), _sum5);
-                _sum6 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[6]), _sum6);
-                _sum7 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[7]), _sum7);
-                _sum8 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[8]), _sum8);
-                _sum9 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[9]), _sum9);
-                _suma = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[10]), _suma);
-                _sumb = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[11]), _sumb);
+                __m128 _pA = _mm_load_weight_ps(pA);
+
+                _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 1)), _sum1);
+                _sum2 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 2)), _sum2);
+                _sum3 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 3)), _sum3);
+                _sum4 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 4)), _sum4);
+                _sum5 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 5)), _sum5);
+                _sum6 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 6)), _sum6);
+                _sum7 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 7)), _sum7);
+                _sum8 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 8)), _sum8);
+                _sum9 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 9)), _sum9);
+                _suma = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 10)), _suma);
+                _sumb = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 11)), _sumb);
 
                 pA += 4;
                 pB += 12;
@@ -5401,18 +5423,18 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _sum0);
-                    _mm_store_ps(outptr0 + 4 * 1, _sum1);
-                    _mm_store_ps(outptr0 + 4 * 2, _sum2);
-                    _mm_store_ps(outptr0 + 4 * 3, _sum3);
-                    _mm_store_ps(outptr0 + 4 * 4, _sum4);
-                    _mm_store_ps(outptr0 + 4 * 5, _sum5);
-                    _mm_store_ps(outptr0 + 4 * 6, _sum6);
-                    _mm_store_ps(outptr0 + 4 * 7, _sum7);
-                    _mm_store_ps(outptr0 + 4 * 8, _sum8);
-                    _mm_store_ps(outptr0 + 4 * 9, _sum9);
-                    _mm_store_ps(outptr0 + 4 * 10, _suma);
-                    _mm_store_ps(outptr0 + 4 * 11, _sumb);
+                    _mm_store_blob_ps(outptr0, _sum0);
+                    _mm_store_blob_ps(outptr0 + 4 * 1, _sum1);
+                    _mm_store_blob_ps(outptr0 + 4 * 2, _sum2);
+                    _mm_store_blob_ps(outptr0 + 4 * 3, _sum3);
+                    _mm_store_blob_ps(outptr0 + 4 * 4, _sum4);
+                    _mm_store_blob_ps(outptr0 + 4 * 5, _sum5);
+                    _mm_store_blob_ps(outptr0 + 4 * 6, _sum6);
+                    _mm_store_blob_ps(outptr0 + 4 * 7, _sum7);
+                    _mm_store_blob_ps(outptr0 + 4 * 8, _sum8);
+                    _mm_store_blob_ps(outptr0 + 4 * 9, _sum9);
+                    _mm_store_blob_ps(outptr0 + 4 * 10, _suma);
+                    _mm_store_blob_ps(outptr0 + 4 * 11, _sumb);
                     outptr0 += 48;
                 }
                 if (out_elempack == 1)
@@ -5421,18 +5443,18 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     _MM_TRANSPOSE4_PS(_sum4, _sum5, _sum6, _sum7);
                     _MM_TRANSPOSE4_PS(_sum8, _sum9, _suma, _sumb);
 
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _sum1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2, _sum2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _sum3);
-                    _mm_storeu_ps(outptr0 + 4, _sum4);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1 + 4, _sum5);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2 + 4, _sum6);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3 + 4, _sum7);
-                    _mm_storeu_ps(outptr0 + 8, _sum8);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1 + 8, _sum9);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2 + 8, _suma);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3 + 8, _sumb);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum4);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1 + 4, _sum5);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2 + 4, _sum6);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3 + 4, _sum7);
+                    _mm_storeu_blob_ps(outptr0 + 8, _sum8);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1 + 8, _sum9);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2 + 8, _suma);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3 + 8, _sumb);
                     outptr0 += 12;
                 }
             }
@@ -5538,20 +5560,20 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum7 = _mm_load_ps(outptr + 4 * 7);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pA = _mm_load_ps(pA);
+                __m128 _pA = _mm_load_weight_ps(pA);
 
-                _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[1]), _sum1);
-                _sum2 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[2]), _sum2);
-                _sum3 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[3]), _sum3);
-                _sum4 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[4]), _sum4);
-                _sum5 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[5]), _sum5);
-                _sum6 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[6]), _sum6);
-                _sum7 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[7]), _sum7);
+                _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 1)), _sum1);
+                _sum2 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 2)), _sum2);
+                _sum3 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 3)), _sum3);
+                _sum4 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 4)), _sum4);
+                _sum5 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 5)), _sum5);
+                _sum6 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 6)), _sum6);
+                _sum7 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 7)), _sum7);
 
                 pA += 4;
                 pB += 8;
@@ -5561,14 +5583,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _sum0);
-                    _mm_store_ps(outptr0 + 4 * 1, _sum1);
-                    _mm_store_ps(outptr0 + 4 * 2, _sum2);
-                    _mm_store_ps(outptr0 + 4 * 3, _sum3);
-                    _mm_store_ps(outptr0 + 4 * 4, _sum4);
-                    _mm_store_ps(outptr0 + 4 * 5, _sum5);
-                    _mm_store_ps(outptr0 + 4 * 6, _sum6);
-                    _mm_store_ps(outptr0 + 4 * 7, _sum7);
+                    _mm_store_blob_ps(outptr0, _sum0);
+                    _mm_store_blob_ps(outptr0 + 4 * 1, _sum1);
+                    _mm_store_blob_ps(outptr0 + 4 * 2, _sum2);
+                    _mm_store_blob_ps(outptr0 + 4 * 3, _sum3);
+                    _mm_store_blob_ps(outptr0 + 4 * 4, _sum4);
+                    _mm_store_blob_ps(outptr0 + 4 * 5, _sum5);
+                    _mm_store_blob_ps(outptr0 + 4 * 6, _sum6);
+                    _mm_store_blob_ps(outptr0 + 4 * 7, _sum7);
                     outptr0 += 32;
                 }
                 if (out_elempack == 1)
@@ -5576,14 +5598,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                     _MM_TRANSPOSE4_PS(_sum0, _sum1, _sum2, _sum3);
                     _MM_TRANSPOSE4_PS(_sum4, _sum5, _sum6, _sum7);
 
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _sum1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2, _sum2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _sum3);
-                    _mm_storeu_ps(outptr0 + 4, _sum4);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1 + 4, _sum5);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2 + 4, _sum6);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3 + 4, _sum7);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum4);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1 + 4, _sum5);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2 + 4, _sum6);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3 + 4, _sum7);
                     outptr0 += 8;
                 }
             }
@@ -5657,16 +5679,16 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum3 = _mm_load_ps(outptr + 4 * 3);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pA = _mm_load_ps(pA);
+                __m128 _pA = _mm_load_weight_ps(pA);
 
-                _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[1]), _sum1);
-                _sum2 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[2]), _sum2);
-                _sum3 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[3]), _sum3);
+                _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 1)), _sum1);
+                _sum2 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 2)), _sum2);
+                _sum3 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 3)), _sum3);
 
                 pA += 4;
                 pB += 4;
@@ -5676,20 +5698,20 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _sum0);
-                    _mm_store_ps(outptr0 + 4 * 1, _sum1);
-                    _mm_store_ps(outptr0 + 4 * 2, _sum2);
-                    _mm_store_ps(outptr0 + 4 * 3, _sum3);
+                    _mm_store_blob_ps(outptr0, _sum0);
+                    _mm_store_blob_ps(outptr0 + 4 * 1, _sum1);
+                    _mm_store_blob_ps(outptr0 + 4 * 2, _sum2);
+                    _mm_store_blob_ps(outptr0 + 4 * 3, _sum3);
                     outptr0 += 16;
                 }
                 if (out_elempack == 1)
                 {
                     _MM_TRANSPOSE4_PS(_sum0, _sum1, _sum2, _sum3);
 
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + out_hstep * 1, _sum1);
-                    _mm_storeu_ps(outptr0 + out_hstep * 2, _sum2);
-                    _mm_storeu_ps(outptr0 + out_hstep * 3, _sum3);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 1, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 2, _sum2);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep * 3, _sum3);
                     outptr0 += 4;
                 }
             }
@@ -5745,14 +5767,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum1 = _mm_load_ps(outptr + 4);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pA = _mm_load_ps(pA);
+                __m128 _pA = _mm_load_weight_ps(pA);
 
-                _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[0]), _sum0);
-                _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[1]), _sum1);
+                _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB)), _sum0);
+                _sum1 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB + 1)), _sum1);
 
                 pA += 4;
                 pB += 2;
@@ -5762,8 +5784,8 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _sum0);
-                    _mm_store_ps(outptr0 + 4, _sum1);
+                    _mm_store_blob_ps(outptr0, _sum0);
+                    _mm_store_blob_ps(outptr0 + 4, _sum1);
                     outptr0 += 8;
                 }
                 if (out_elempack == 1)
@@ -5827,13 +5849,13 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum0 = _mm_load_ps(outptr);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pA = _mm_load_ps(pA);
+                __m128 _pA = _mm_load_weight_ps(pA);
 
-                _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(pB[0]), _sum0);
+                _sum0 = _mm_comp_fmadd_ps(_pA, _mm_set1_ps(load_weight(pB)), _sum0);
 
                 pA += 4;
                 pB += 1;
@@ -5843,7 +5865,7 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 if (out_elempack == 4)
                 {
-                    _mm_store_ps(outptr0, _sum0);
+                    _mm_store_blob_ps(outptr0, _sum0);
                     outptr0 += 4;
                 }
                 if (out_elempack == 1)
@@ -5871,9 +5893,9 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
 #endif // __SSE2__
     for (; ii + 1 < max_ii; ii += 2)
     {
-        float* outptr0 = (float*)top_blob + (i + ii) * out_hstep + j;
+        TO* outptr0 = (TO*)top_blob + (i + ii) * out_hstep + j;
 
-        const float* pB = pBT;
+        const TB* pB = pBT;
 
         if (pC)
         {
@@ -5971,19 +5993,19 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum12 = _mm_shuffle_ps(_tmp4, _tmp5, _MM_SHUFFLE(3, 1, 3, 1));
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pB0 = _mm_load_ps(pB);
-                __m128 _pB1 = _mm_load_ps(pB + 4);
-                __m128 _pB2 = _mm_load_ps(pB + 8);
+                __m128 _pB0 = _mm_load_weight_ps(pB);
+                __m128 _pB1 = _mm_load_weight_ps(pB + 4);
+                __m128 _pB2 = _mm_load_weight_ps(pB + 8);
 
-                __m128 _pA0 = _mm_set1_ps(pA[0]);
+                __m128 _pA0 = _mm_set1_ps(load_weight(pA));
                 _sum00 = _mm_comp_fmadd_ps(_pA0, _pB0, _sum00);
                 _sum01 = _mm_comp_fmadd_ps(_pA0, _pB1, _sum01);
                 _sum02 = _mm_comp_fmadd_ps(_pA0, _pB2, _sum02);
-                __m128 _pA1 = _mm_set1_ps(pA[1]);
+                __m128 _pA1 = _mm_set1_ps(load_weight(pA + 1));
                 _sum10 = _mm_comp_fmadd_ps(_pA1, _pB0, _sum10);
                 _sum11 = _mm_comp_fmadd_ps(_pA1, _pB1, _sum11);
                 _sum12 = _mm_comp_fmadd_ps(_pA1, _pB2, _sum12);
@@ -5996,12 +6018,12 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum00);
-                    _mm_storeu_ps(outptr0 + 4, _sum01);
-                    _mm_storeu_ps(outptr0 + 8, _sum02);
-                    _mm_storeu_ps(outptr0 + out_hstep, _sum10);
-                    _mm_storeu_ps(outptr0 + out_hstep + 4, _sum11);
-                    _mm_storeu_ps(outptr0 + out_hstep + 8, _sum12);
+                    _mm_storeu_blob_ps(outptr0, _sum00);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum01);
+                    _mm_storeu_blob_ps(outptr0 + 8, _sum02);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep, _sum10);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep + 4, _sum11);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep + 8, _sum12);
                     outptr0 += 12;
                 }
             }
@@ -6087,17 +6109,17 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum11 = _mm_shuffle_ps(_tmp2, _tmp3, _MM_SHUFFLE(3, 1, 3, 1));
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pB0 = _mm_load_ps(pB);
-                __m128 _pB1 = _mm_load_ps(pB + 4);
+                __m128 _pB0 = _mm_load_weight_ps(pB);
+                __m128 _pB1 = _mm_load_weight_ps(pB + 4);
 
-                __m128 _pA0 = _mm_set1_ps(pA[0]);
+                __m128 _pA0 = _mm_set1_ps(load_weight(pA));
                 _sum00 = _mm_comp_fmadd_ps(_pA0, _pB0, _sum00);
                 _sum01 = _mm_comp_fmadd_ps(_pA0, _pB1, _sum01);
-                __m128 _pA1 = _mm_set1_ps(pA[1]);
+                __m128 _pA1 = _mm_set1_ps(load_weight(pA + 1));
                 _sum10 = _mm_comp_fmadd_ps(_pA1, _pB0, _sum10);
                 _sum11 = _mm_comp_fmadd_ps(_pA1, _pB1, _sum11);
 
@@ -6109,10 +6131,10 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum00);
-                    _mm_storeu_ps(outptr0 + 4, _sum01);
-                    _mm_storeu_ps(outptr0 + out_hstep, _sum10);
-                    _mm_storeu_ps(outptr0 + out_hstep + 4, _sum11);
+                    _mm_storeu_blob_ps(outptr0, _sum00);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum01);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep, _sum10);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep + 4, _sum11);
                     outptr0 += 8;
                 }
             }
@@ -6176,14 +6198,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum1 = _mm_shuffle_ps(_tmp0, _tmp1, _MM_SHUFFLE(3, 1, 3, 1));
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pB = _mm_load_ps(pB);
+                __m128 _pB = _mm_load_weight_ps(pB);
 
-                _sum0 = _mm_comp_fmadd_ps(_mm_set1_ps(pA[0]), _pB, _sum0);
-                _sum1 = _mm_comp_fmadd_ps(_mm_set1_ps(pA[1]), _pB, _sum1);
+                _sum0 = _mm_comp_fmadd_ps(_mm_set1_ps(load_weight(pA)), _pB, _sum0);
+                _sum1 = _mm_comp_fmadd_ps(_mm_set1_ps(load_weight(pA + 1)), _pB, _sum1);
 
                 pA += 2;
                 pB += 4;
@@ -6193,8 +6215,8 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + out_hstep, _sum1);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + out_hstep, _sum1);
                     outptr0 += 4;
                 }
             }
@@ -6265,14 +6287,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 sum11 = outptr[3];
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                sum00 += pA[0] * pB[0];
-                sum01 += pA[1] * pB[0];
-                sum10 += pA[0] * pB[1];
-                sum11 += pA[1] * pB[1];
+                sum00 += load_weight(pA) * load_weight(pB);
+                sum01 += load_weight(pA + 1) * load_weight(pB);
+                sum10 += load_weight(pA) * load_weight(pB + 1);
+                sum11 += load_weight(pA + 1) * load_weight(pB + 1);
 
                 pA += 2;
                 pB += 2;
@@ -6341,12 +6363,12 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 sum1 = outptr[1];
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                sum0 += pA[0] * pB[0];
-                sum1 += pA[1] * pB[0];
+                sum0 += load_weight(pA) * load_weight(pB);
+                sum1 += load_weight(pA + 1) * load_weight(pB);
                 pA += 2;
                 pB += 1;
             }
@@ -6373,9 +6395,9 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
     }
     for (; ii < max_ii; ii += 1)
     {
-        float* outptr0 = (float*)top_blob + (i + ii) * out_hstep + j;
+        TO* outptr0 = (TO*)top_blob + (i + ii) * out_hstep + j;
 
-        const float* pB = pBT;
+        const TB* pB = pBT;
 
         if (pC)
         {
@@ -6427,15 +6449,15 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum2 = _mm_loadu_ps(outptr + 8);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pB0 = _mm_load_ps(pB);
-                __m128 _pB1 = _mm_load_ps(pB + 4);
-                __m128 _pB2 = _mm_load_ps(pB + 8);
+                __m128 _pB0 = _mm_load_weight_ps(pB);
+                __m128 _pB1 = _mm_load_weight_ps(pB + 4);
+                __m128 _pB2 = _mm_load_weight_ps(pB + 8);
 
-                __m128 _pA0 = _mm_set1_ps(pA[0]);
+                __m128 _pA0 = _mm_set1_ps(load_weight(pA));
                 _sum0 = _mm_comp_fmadd_ps(_pA0, _pB0, _sum0);
                 _sum1 = _mm_comp_fmadd_ps(_pA0, _pB1, _sum1);
                 _sum2 = _mm_comp_fmadd_ps(_pA0, _pB2, _sum2);
@@ -6448,9 +6470,9 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + 4, _sum1);
-                    _mm_storeu_ps(outptr0 + 8, _sum2);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum1);
+                    _mm_storeu_blob_ps(outptr0 + 8, _sum2);
                     outptr0 += 12;
                 }
             }
@@ -6494,14 +6516,14 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum1 = _mm_loadu_ps(outptr + 4);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pB0 = _mm_load_ps(pB);
-                __m128 _pB1 = _mm_load_ps(pB + 4);
+                __m128 _pB0 = _mm_load_weight_ps(pB);
+                __m128 _pB1 = _mm_load_weight_ps(pB + 4);
 
-                __m128 _pA0 = _mm_set1_ps(pA[0]);
+                __m128 _pA0 = _mm_set1_ps(load_weight(pA));
                 _sum0 = _mm_comp_fmadd_ps(_pA0, _pB0, _sum0);
                 _sum1 = _mm_comp_fmadd_ps(_pA0, _pB1, _sum1);
 
@@ -6513,8 +6535,8 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum0);
-                    _mm_storeu_ps(outptr0 + 4, _sum1);
+                    _mm_storeu_blob_ps(outptr0, _sum0);
+                    _mm_storeu_blob_ps(outptr0 + 4, _sum1);
                     outptr0 += 8;
                 }
             }
@@ -6552,13 +6574,13 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 _sum = _mm_loadu_ps(outptr);
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                __m128 _pB = _mm_load_ps(pB);
+                __m128 _pB = _mm_load_weight_ps(pB);
 
-                _sum = _mm_comp_fmadd_ps(_mm_set1_ps(pA[0]), _pB, _sum);
+                _sum = _mm_comp_fmadd_ps(_mm_set1_ps(load_weight(pA)), _pB, _sum);
 
                 pA += 1;
                 pB += 4;
@@ -6568,7 +6590,7 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
             {
                 // if (out_elempack == 1)
                 {
-                    _mm_storeu_ps(outptr0, _sum);
+                    _mm_storeu_blob_ps(outptr0, _sum);
                     outptr0 += 4;
                 }
             }
@@ -6611,12 +6633,12 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 sum1 = outptr[1];
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                sum0 += pA[0] * pB[0];
-                sum1 += pA[0] * pB[1];
+                sum0 += load_weight(pA) * load_weight(pB);
+                sum1 += load_weight(pA) * load_weight(pB + 1);
 
                 pA += 1;
                 pB += 2;
@@ -6665,11 +6687,11 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
                 sum = outptr[0];
             }
 
-            const float* pA = pAT;
+            const TA* pA = pAT;
             int kk = 0;
             for (; kk < max_kk; kk += 1)
             {
-                sum += pA[0] * pB[0];
+                sum += load_weight(pA) * load_weight(pB);
                 pA += 1;
                 pB += 1;
             }
@@ -6694,6 +6716,30 @@ static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, cons
     }
 }
 
+static void gemm_transB_packed_tile(const Mat& AT_tile, const Mat& BT_tile, const Mat& CT_tile, Mat& topT_tile, Mat& top_blob, int broadcast_type_C, int i, int max_ii, int j, int max_jj, int k, int max_kk, bool k_end)
+{
+#if NCNN_F16C && __F16C__
+    // constant A and B may be kept as fp16
+    if (AT_tile.elembits() == 16 && BT_tile.elembits() == 16)
+    {
+        gemm_transB_packed_tile_impl<unsigned short, unsigned short, float>(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, broadcast_type_C, i, max_ii, j, max_jj, k, max_kk, k_end);
+        return;
+    }
+    if (AT_tile.elembits() == 16)
+    {
+        gemm_transB_packed_tile_impl<unsigned short, float, float>(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, broadcast_type_C, i, max_ii, j, max_jj, k, max_kk, k_end);
+        return;
+    }
+    if (BT_tile.elembits() == 16)
+    {
+        gemm_transB_packed_tile_impl<float, unsigned short, float>(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, broadcast_type_C, i, max_ii, j, max_jj, k, max_kk, k_end);
+        return;
+    }
+#endif
+
+    gemm_transB_packed_tile_impl<float, float, float>(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, broadcast_type_C, i, max_ii, j, max_jj, k, max_kk, k_end);
+}
+
 static void get_optimal_tile_mnk(int M, int N, int K, int constant_TILE_M, int constant_TILE_N, int constant_TILE_K, int& TILE_M, int& TILE_N, int& TILE_K, int nT)
 {
     // resolve optimal tile size from cache size
@@ -6850,6 +6896,9 @@ static int gemm_x86(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob, int
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -6970,6 +7019,9 @@ static int gemm_AT_x86(const Mat& AT, const Mat& B, const Mat& C, Mat& top_blob,
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -7071,6 +7123,9 @@ static int gemm_BT_x86(const Mat& A, const Mat& BT, const Mat& C, Mat& top_blob,
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -7158,6 +7213,9 @@ static int gemm_AT_BT_x86(const Mat& AT, const Mat& BT, const Mat& C, Mat& top_b
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -7218,50 +7276,178 @@ static int gemm_AT_BT_x86(const Mat& AT, const Mat& BT, const Mat& C, Mat& top_b
     return 0;
 }
 
-int Gemm_x86::create_pipeline(const Option& opt)
+#if NCNN_BF16
+// constant B kept as bf16, A from a bf16 or fp32 blob, the output type follows top_blob
+static int gemm_BT_x86_bf16s(const Mat& A, const Mat& BT, const Mat& C, Mat& top_blob, int broadcast_type_C, int N, int K, int transA, int constant_TILE_M, int constant_TILE_N, int constant_TILE_K, int nT, const Option& opt)
 {
-#if NCNN_INT8
-    if (int8_scale_term)
+    const int M = transA ? A.w : (A.dims == 3 ? A.c : A.h) * A.elempack;
+
+    int TILE_M, TILE_N, TILE_K;
+    get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
+
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
+    int nn_M = (M + TILE_M - 1) / TILE_M;
+
+    Mat ATX(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, nT, 4u, opt.workspace_allocator);
+    if (ATX.empty())
+        return -100;
+
+    Mat topT;
+    if (K > TILE_K || broadcast_type_C == 3)
     {
-        return create_pipeline_int8(opt);
+        topT.create(TILE_N * TILE_M, 1, nT, 4u, opt.workspace_allocator);
+        if (topT.empty())
+            return -100;
     }
-#endif
 
-    if (constantA)
+    const bool A_bf16 = A.elembits() == 16;
+    const bool top_bf16 = top_blob.elembits() == 16;
+
+    #pragma omp parallel for num_threads(nT)
+    for (int ppi = 0; ppi < nn_M; ppi++)
     {
-        const int M = constantM;
-        const int K = constantK;
+        const int i = ppi * TILE_M;
 
-        int TILE_M, TILE_N, TILE_K;
-        get_optimal_tile_mnk(M, 0, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, opt.num_threads);
+        // shadowed variable for less openmp task args
+        const int M = transA ? A.w : (A.dims == 3 ? A.c : A.h) * A.elempack;
+        const int K = transA ? (A.dims == 3 ? A.c : A.h) * A.elempack : A.w;
 
-        const int nn_M = (M + TILE_M - 1) / TILE_M;
+        const int max_ii = std::min((M - i), TILE_M);
 
-        AT_data.create(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 4u, (Allocator*)0);
-        if (AT_data.empty())
-            return -100;
+        Mat topT_tile;
+        if (K > TILE_K || broadcast_type_C == 3)
+            topT_tile = topT.channel(get_omp_thread_num());
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int ppj = 0; ppj < nn_M; ppj++)
+        for (int j = 0; j < N; j += TILE_N)
         {
-            const int i = ppj * TILE_M;
+            const int max_jj = std::min((N - j), TILE_N);
+
+            if (broadcast_type_C == 3)
+            {
+                pack_A_tile(C, topT_tile, i, max_ii, j, max_jj);
+            }
+
+            const Mat& CT_tile = broadcast_type_C == 3 ? topT_tile : C;
 
             for (int k = 0; k < K; k += TILE_K)
             {
-                const int max_ii = std::min((M - i), TILE_M);
                 const int max_kk = std::min((K - k), TILE_K);
 
-                Mat AT_tile = AT_data.channel(i / TILE_M).row_range(k / TILE_K, 1);
+                Mat AT_tile = ATX.channel(get_omp_thread_num()).row_range(k / TILE_K, 1);
+
+                Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
 
-                if (transA)
+                if (j == 0)
                 {
-                    transpose_pack_A_tile(A_data, AT_tile, i, max_ii, k, max_kk);
+                    if (transA)
+                    {
+                        if (A_bf16)
+                            transpose_pack_A_tile_impl<bfloat16_t>(A, AT_tile, i, max_ii, k, max_kk);
+                        else
+                            transpose_pack_A_tile_impl<float>(A, AT_tile, i, max_ii, k, max_kk);
+                    }
+                    else
+                    {
+                        if (A_bf16)
+                            pack_A_tile_impl<bfloat16_t>(A, AT_tile, i, max_ii, k, max_kk);
+                        else
+                            pack_A_tile_impl<float>(A, AT_tile, i, max_ii, k, max_kk);
+                    }
                 }
+
+                bool k_end = k + TILE_K >= K;
+
+                if (top_bf16)
+                    gemm_transB_packed_tile_impl<float, bfloat16_t, bfloat16_t>(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, broadcast_type_C, i, max_ii, j, max_jj, k, max_kk, k_end);
                 else
+                    gemm_transB_packed_tile_impl<float, bfloat16_t, float>(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, broadcast_type_C, i, max_ii, j, max_jj, k, max_kk, k_end);
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_BF16
+
+int Gemm_x86::create_pipeline(const Option& opt)
+{
+    if (weight_quant_bits)
+    {
+        support_bf16_storage = false;
+        return create_pipeline_weight_quant(opt);
+    }
+
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        support_bf16_storage = false;
+        return create_pipeline_int8(opt);
+    }
+#endif
+
+    // bf16 storage covers the linear layer form, constant B with A from the blob
+    if (!constantB || constantA || output_transpose)
+        support_bf16_storage = false;
+
+#if NCNN_BF16
+    const bool use_bf16s = opt.use_bf16_storage && support_bf16_storage;
+#else
+    const bool use_bf16s = false;
+#endif
+
+    if (constantA)
+    {
+        if (AT_data.empty())
+        {
+            const int M = constantM;
+            const int K = constantK;
+
+            int TILE_M, TILE_N, TILE_K;
+            get_optimal_tile_mnk(M, 0, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, opt.num_threads);
+
+            const int nn_M = (M + TILE_M - 1) / TILE_M;
+
+            AT_data.create(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 4u, (Allocator*)0);
+            if (AT_data.empty())
+                return -100;
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int ppj = 0; ppj < nn_M; ppj++)
+            {
+                const int i = ppj * TILE_M;
+
+                for (int k = 0; k < K; k += TILE_K)
                 {
-                    pack_A_tile(A_data, AT_tile, i, max_ii, k, max_kk);
+                    const int max_ii = std::min((M - i), TILE_M);
+                    const int max_kk = std::min((K - k), TILE_K);
+
+                    Mat AT_tile = AT_data.channel(i / TILE_M).row_range(k / TILE_K, 1);
+
+                    if (transA)
+                    {
+                        transpose_pack_A_tile(A_data, AT_tile, i, max_ii, k, max_kk);
+                    }
+                    else
+                    {
+                        pack_A_tile(A_data, AT_tile, i, max_ii, k, max_kk);
+                    }
                 }
             }
+
+#if NCNN_F16C && __F16C__
+            // keep a constant A that fp16 holds bitwise as fp16, the kernel widens it in registers
+            if (opt.use_fp16_storage && weight_fp16_exact(A_data))
+            {
+                Mat AT_data_fp16;
+                int ret = cast_packed_weight_fp16s(AT_data, AT_data_fp16);
+                if (ret != 0)
+                    return ret;
+
+                AT_data = AT_data_fp16;
+            }
+#endif
         }
 
         if (opt.lightmode)
@@ -7270,43 +7456,81 @@ int Gemm_x86::create_pipeline(const Option& opt)
 
     if (constantB)
     {
-        const int N = constantN;
-        const int K = constantK;
+        if (BT_data.empty())
+        {
+            const int N = constantN;
+            const int K = constantK;
 
-        int TILE_M, TILE_N, TILE_K;
-        get_optimal_tile_mnk(0, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, opt.num_threads);
+            int TILE_M, TILE_N, TILE_K;
+            get_optimal_tile_mnk(0, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, opt.num_threads);
 
-        const int nn_N = (N + TILE_N - 1) / TILE_N;
-        const int nn_K = (K + TILE_K - 1) / TILE_K;
+            const int nn_N = (N + TILE_N - 1) / TILE_N;
+            const int nn_K = (K + TILE_K - 1) / TILE_K;
 
-        BT_data.create(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 4u, (Allocator*)0);
-        if (BT_data.empty())
-            return -100;
+            BT_data.create(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 4u, (Allocator*)0);
+            if (BT_data.empty())
+                return -100;
 
-        const int nn_NK = nn_N * nn_K;
+            const int nn_NK = nn_N * nn_K;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int ppjk = 0; ppjk < nn_NK; ppjk++)
-        {
-            const int ppj = ppjk / nn_K;
-            const int ppk = ppjk % nn_K;
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int ppjk = 0; ppjk < nn_NK; ppjk++)
+            {
+                const int ppj = ppjk / nn_K;
+                const int ppk = ppjk % nn_K;
 
-            const int j = ppj * TILE_N;
-            const int k = ppk * TILE_K;
+                const int j = ppj * TILE_N;
+                const int k = ppk * TILE_K;
 
-            const int max_jj = std::min((N - j), TILE_N);
-            const int max_kk = std::min((K - k), TILE_K);
+                const int max_jj = std::min((N - j), TILE_N);
+                const int max_kk = std::min((K - k), TILE_K);
 
-            Mat BT_tile = BT_data.channel(j / TILE_N).row_range(k / TILE_K, 1);
+                Mat BT_tile = BT_data.channel(j / TILE_N).row_range(k / TILE_K, 1);
 
-            if (transB)
+                if (transB)
+                {
+                    pack_B_tile(B_data, BT_tile, j, max_jj, k, max_kk);
+                }
+                else
+                {
+                    transpose_pack_B_tile(B_data, BT_tile, j, max_jj, k, max_kk);
+                }
+            }
+
+#if NCNN_BF16
+            if (use_bf16s)
             {
-                pack_B_tile(B_data, BT_tile, j, max_jj, k, max_kk);
+                // fold alpha into B, the bf16 output needs no rescale pass
+                if (alpha != 1.f)
+                {
+                    const int size = BT_data.total();
+                    for (int i = 0; i < size; i++)
+                    {
+                        BT_data[i] *= alpha;
+                    }
+                }
+
+                Mat BT_data_bf16;
+                int ret = cast_packed_weight_bf16s(BT_data, BT_data_bf16);
+                if (ret != 0)
+                    return ret;
+
+                BT_data = BT_data_bf16;
             }
-            else
+#endif
+
+#if NCNN_F16C && __F16C__
+            // keep a constant B that fp16 holds bitwise as fp16, the kernel widens it in registers
+            if (!use_bf16s && opt.use_fp16_storage && weight_fp16_exact(B_data))
             {
-                transpose_pack_B_tile(B_data, BT_tile, j, max_jj, k, max_kk);
+                Mat BT_data_fp16;
+                int ret = cast_packed_weight_fp16s(BT_data, BT_data_fp16);
+                if (ret != 0)
+                    return ret;
+
+                BT_data = BT_data_fp16;
             }
+#endif
         }
 
         if (opt.lightmode)
@@ -7331,8 +7555,9 @@ int Gemm_x86::create_pipeline(const Option& opt)
         }
 #endif // __SSE2__
 
-        // pre-multiply C with beta
-        if (beta != 1.f)
+        // pre-multiply C with beta, and with alpha when it is folded into B
+        const float C_scale = use_bf16s ? alpha * beta : beta;
+        if (C_scale != 1.f)
         {
             Mat C2;
             C2.create_like(CT_data);
@@ -7340,7 +7565,7 @@ int Gemm_x86::create_pipeline(const Option& opt)
             const int size = CT_data.total() * CT_data.elempack;
             for (int i = 0; i < size; i++)
             {
-                C2[i] = CT_data[i] * beta;
+                C2[i] = CT_data[i] * C_scale;
             }
 
             CT_data = C2;
@@ -7358,8 +7583,40 @@ int Gemm_x86::create_pipeline(const Option& opt)
     return 0;
 }
 
+int Gemm_x86::destroy_pipeline(const Option& opt)
+{
+    if (weight_quant_innerproduct)
+    {
+        weight_quant_innerproduct->destroy_pipeline(opt);
+        delete weight_quant_innerproduct;
+        weight_quant_innerproduct = 0;
+    }
+
+    return 0;
+}
+
+int Gemm_x86::get_pipeline_weights(std::vector<Mat*>& weights)
+{
+    if (weight_quant_bits)
+    {
+        // quantized weights live in the internal innerproduct
+        weights.clear();
+        return 0;
+    }
+
+    weights.resize(2);
+    weights[0] = &AT_data;
+    weights[1] = &BT_data;
+    return 0;
+}
+
 int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+    if (weight_quant_bits)
+    {
+        return forward_weight_quant(bottom_blobs, top_blobs, opt);
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -7368,6 +7625,13 @@ int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     }
 #endif
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage && support_bf16_storage)
+    {
+        return forward_bf16s(bottom_blobs, top_blobs, opt);
+    }
+#endif
+
     int M;
     int N;
     if (constantA && constantB)
@@ -7509,11 +7773,11 @@ int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
         return -100;
 
     int _nT = nT ? nT : opt.num_threads;
-    if (nT != 0 && opt.num_threads != nT)
+    if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
     {
-        // force num_threads the same as in create_pipeline
-        // so we could use pre-packed A/B from the same tile config
-        NCNN_LOGE("opt.num_threads %d changed, gemm will use load-time value %d", opt.num_threads, nT);
+        // pre-packed A/B follow the tile config of the load-time num_threads
+        // fewer threads are fine, branch parallel runs pass their thread share here
+        NCNN_LOGE("opt.num_threads %d changed, gemm will use at most load-time value %d", opt.num_threads, nT);
     }
 
     int ret = 0;
@@ -7555,6 +7819,240 @@ int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     return 0;
 }
 
+#if NCNN_BF16
+int Gemm_x86::forward_bf16s(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    // constant B, A is the first blob
+    const Mat& A = bottom_blobs[0];
+    const int M = transA ? A.w : (A.dims == 3 ? A.c : A.h) * A.elempack;
+    const int N = constantN;
+
+    Mat C;
+    int broadcast_type_C = 0;
+    if (constantC)
+    {
+        C = CT_data;
+        broadcast_type_C = constant_broadcast_type_C;
+    }
+    else if (bottom_blobs.size() == 2)
+    {
+        C = bottom_blobs[1];
+
+        if (C.dims == 1 && C.w == 1)
+        {
+            // scalar
+            broadcast_type_C = 0;
+        }
+        if (C.dims == 1 && C.w * C.elempack == M)
+        {
+            // M
+            // auto broadcast from h to w is the ncnn-style convention
+            broadcast_type_C = 1;
+        }
+        if (C.dims == 1 && C.w * C.elempack == N)
+        {
+            // N
+            broadcast_type_C = 4;
+        }
+        if (C.dims == 2 && C.w == 1 && C.h * C.elempack == M)
+        {
+            // Mx1
+            broadcast_type_C = 2;
+        }
+        if (C.dims == 2 && C.w == N && C.h * C.elempack == M)
+        {
+            // MxN
+            broadcast_type_C = 3;
+        }
+        if (C.dims == 2 && C.w == N && C.h * C.elempack == 1)
+        {
+            // 1xN
+            broadcast_type_C = 4;
+        }
+
+        // fp32 C pre-multiplied with alpha and beta, alpha is folded into B
+        Mat C2;
+        create_like_fp32(C2, C, opt.workspace_allocator);
+        if (C2.empty())
+            return -100;
+
+        const float scale = alpha * beta;
+        const int size = C.w * C.h * C.elempack;
+        if (C.elembits() == 16)
+        {
+            const unsigned short* ptr = C;
+            for (int i = 0; i < size; i++)
+            {
+                C2[i] = bfloat16_to_float32(ptr[i]) * scale;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < size; i++)
+            {
+                C2[i] = C[i] * scale;
+            }
+        }
+
+        C = C2;
+    }
+
+    // bf16 A gives bf16 output unless fp32 is asked, fp32 A comes from a host layer computing in fp32
+    const bool output_bf16 = A.elembits() == 16 && output_elemtype != 1;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+        if (output_bf16)
+        {
+            // 16-bit blobs are packed by 4
+            out_elempack = M % 4 == 0 ? 4 : 1;
+        }
+        else
+        {
+#if __AVX512F__
+            out_elempack = M % 16 == 0 ? 16 : M % 8 == 0 ? 8 : M % 4 == 0 ? 4 : 1;
+#elif __AVX__
+            out_elempack = M % 8 == 0 ? 8 : M % 4 == 0 ? 4 : 1;
+#else
+            out_elempack = M % 4 == 0 ? 4 : 1;
+#endif
+        }
+    }
+#endif // __SSE2__
+    if (output_elempack)
+        out_elempack = output_elempack;
+    size_t out_elemsize = (output_bf16 ? 2u : 4u) * out_elempack;
+
+    Mat& top_blob = top_blobs[0];
+    if (output_N1M)
+        top_blob.create(N, 1, M / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    else
+        top_blob.create(N, M / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    int _nT = nT ? nT : opt.num_threads;
+    if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
+    {
+        // pre-packed A/B follow the tile config of the load-time num_threads
+        // fewer threads are fine, branch parallel runs pass their thread share here
+        NCNN_LOGE("opt.num_threads %d changed, gemm will use at most load-time value %d", opt.num_threads, nT);
+    }
+
+    return gemm_BT_x86_bf16s(A, BT_data, C, top_blob, broadcast_type_C, constantN, constantK, transA, constant_TILE_M, constant_TILE_N, constant_TILE_K, _nT, opt);
+}
+#endif // NCNN_BF16
+
+int Gemm_x86::create_pipeline_weight_quant(const Option& opt)
+{
+    // A x transposed constant B plus a constant per-column C is exactly an innerproduct
+    const bool linear = constantA == 0 && transA == 0 && constantC == 1
+                        && (constant_broadcast_type_C == -1 || constant_broadcast_type_C == 0 || constant_broadcast_type_C == 4)
+                        && output_N1M == 0 && output_elempack == 0 && output_elemtype == 0 && output_transpose == 0;
+
+    if (!linear)
+    {
+        // reference path dequantizes B at runtime
+        support_packing = false;
+        return 0;
+    }
+
+    const int N = constantN;
+    const int K = constantK;
+    const int num_group = K / weight_quant_group_size;
+
+    // fold alpha into the group scales and alpha * beta into the bias
+    Mat scales = B_data_quant_scales;
+    if (alpha != 1.f)
+    {
+        scales = B_data_quant_scales.clone();
+        if (scales.empty())
+            return -100;
+
+        for (int i = 0; i < num_group * N; i++)
+        {
+            scales[i] *= alpha;
+        }
+    }
+
+    Mat bias;
+    if (constant_broadcast_type_C != -1)
+    {
+        bias.create(N);
+        if (bias.empty())
+            return -100;
+
+        for (int i = 0; i < N; i++)
+        {
+            const float c = constant_broadcast_type_C == 0 ? C_data[0] : C_data[i];
+            bias[i] = c * beta * alpha;
+        }
+    }
+
+    {
+        weight_quant_innerproduct = ncnn::create_layer_cpu(ncnn::LayerType::InnerProduct);
+        ncnn::ParamDict pd;
+        pd.set(0, N);                    // num_output
+        pd.set(1, bias.empty() ? 0 : 1); // bias_term
+        pd.set(2, N * K);                // weight_data_size
+        pd.set(11, weight_quant_bits);
+        pd.set(12, weight_quant_group_size);
+        weight_quant_innerproduct->load_param(pd);
+
+        Mat weights[4];
+        int wi = 0;
+        weights[wi++] = B_data.reshape(N * K);
+        if (!bias.empty())
+            weights[wi++] = bias;
+        weights[wi++] = scales;
+        weights[wi++] = B_data_quant_zeros;
+
+        weight_quant_innerproduct->load_model(ModelBinFromMatArray(weights));
+        weight_quant_innerproduct->create_pipeline(opt);
+    }
+
+    if (opt.lightmode)
+    {
+        B_data.release();
+        B_data_quant_scales.release();
+        B_data_quant_zeros.release();
+        C_data.release();
+    }
+
+    return 0;
+}
+
+int Gemm_x86::forward_weight_quant(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (!weight_quant_innerproduct)
+    {
+        return Gemm::forward(bottom_blobs, top_blobs, opt);
+    }
+
+    const Mat& A0 = bottom_blobs[0];
+
+    // innerproduct takes the M rows as a 2d blob
+    Mat A = A0;
+    if (A0.dims != 2)
+    {
+        Option opt_pack = opt;
+        opt_pack.blob_allocator = opt.workspace_allocator;
+
+        Mat A_unpacked;
+        convert_packing(A0, A_unpacked, 1, opt_pack);
+        if (A_unpacked.empty())
+            return -100;
+
+        A = A_unpacked.reshape(A_unpacked.w, A_unpacked.dims == 3 ? A_unpacked.c : 1, opt.workspace_allocator);
+        if (A.empty())
+            return -100;
+    }
+
+    return weight_quant_innerproduct->forward(A, top_blobs[0], opt);
+}
+
 #if NCNN_INT8
 static void compute_A_tile_int8_scales(const Mat& A, Mat& scales, float B_scale, Mat& out_descales, int i, int max_ii)
 {
@@ -7621,6 +8119,9 @@ static int gemm_x86_int8(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -7775,6 +8276,9 @@ static int gemm_AT_x86_int8(const Mat& AT, const Mat& A_int8_scales, const Mat&
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -7884,6 +8388,9 @@ static int gemm_BT_x86_int8(const Mat& A, const Mat& BT, float B_int8_scale, con
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -8006,6 +8513,9 @@ static int gemm_AT_BT_x86_int8(const Mat& AT, const Mat& A_int8_scales, const Ma
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    // keep the tile config of nT, run with at most opt.num_threads
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
     int nn_M = (M + TILE_M - 1) / TILE_M;
@@ -8074,56 +8584,59 @@ int Gemm_x86::create_pipeline_int8(const Option& opt)
 {
     if (constantA)
     {
-        const int M = constantM;
-        const int K = constantK;
+        if (AT_data.empty())
+        {
+            const int M = constantM;
+            const int K = constantK;
 
-        int TILE_M, TILE_N, TILE_K;
-        get_optimal_tile_mnk_int8(M, 0, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, opt.num_threads);
+            int TILE_M, TILE_N, TILE_K;
+            get_optimal_tile_mnk_int8(M, 0, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, opt.num_threads);
 
-        const int nn_M = (M + TILE_M - 1) / TILE_M;
+            const int nn_M = (M + TILE_M - 1) / TILE_M;
 
 #if NCNN_AVX512VNNI || NCNN_AVXVNNI
-        bool has_w_shift = false;
-        if (TILE_K >= 4)
-        {
-            has_w_shift = ncnn::cpu_support_x86_avx512_vnni() || ncnn::cpu_support_x86_avx_vnni();
+            bool has_w_shift = false;
+            if (TILE_K >= 4)
+            {
+                has_w_shift = ncnn::cpu_support_x86_avx512_vnni() || ncnn::cpu_support_x86_avx_vnni();
 #if NCNN_AVXVNNIINT8
-            if (ncnn::cpu_support_x86_avx_vnni_int8())
-                has_w_shift = false;
+                if (ncnn::cpu_support_x86_avx_vnni_int8())
+                    has_w_shift = false;
 #endif // NCNN_AVXVNNIINT8
-        }
-        if (has_w_shift)
-        {
-            int w_shift_count = TILE_M >= 16 ? 16 : TILE_M >= 8 ? 8 : TILE_M >= 4 ? 4 : TILE_M >= 2 ? 2 : 1;
-            AT_data.create((TILE_K + w_shift_count * 4) * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 1u, (Allocator*)0);
-        }
-        else
+            }
+            if (has_w_shift)
+            {
+                int w_shift_count = TILE_M >= 16 ? 16 : TILE_M >= 8 ? 8 : TILE_M >= 4 ? 4 : TILE_M >= 2 ? 2 : 1;
+                AT_data.create((TILE_K + w_shift_count * 4) * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 1u, (Allocator*)0);
+            }
+            else
 #endif // NCNN_AVX512VNNI || NCNN_AVXVNNI
-        {
-            AT_data.create(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 1u, (Allocator*)0);
-        }
-        if (AT_data.empty())
-            return -100;
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int ppj = 0; ppj < nn_M; ppj++)
-        {
-            const int i = ppj * TILE_M;
-
-            for (int k = 0; k < K; k += TILE_K)
             {
-                const int max_ii = std::min((M - i), TILE_M);
-                const int max_kk = std::min((K - k), TILE_K);
+                AT_data.create(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 1u, (Allocator*)0);
+            }
+            if (AT_data.empty())
+                return -100;
 
-                Mat AT_tile = AT_data.channel(i / TILE_M).row_range(k / TILE_K, 1);
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int ppj = 0; ppj < nn_M; ppj++)
+            {
+                const int i = ppj * TILE_M;
 
-                if (transA)
+                for (int k = 0; k < K; k += TILE_K)
                 {
-                    transpose_pack_A_tile_int8(A_data, AT_tile, i, max_ii, k, max_kk);
-                }
-                else
-                {
-                    pack_A_tile_int8(A_data, AT_tile, i, max_ii, k, max_kk);
+                    const int max_ii = std::min((M - i), TILE_M);
+                    const int max_kk = std::min((K - k), TILE_K);
+
+                    Mat AT_tile = AT_data.channel(i / TILE_M).row_range(k / TILE_K, 1);
+
+                    if (transA)
+                    {
+                        transpose_pack_A_tile_int8(A_data, AT_tile, i, max_ii, k, max_kk);
+                    }
+                    else
+                    {
+                        pack_A_tile_int8(A_data, AT_tile, i, max_ii, k, max_kk);
+                    }
                 }
             }
         }
@@ -8134,37 +8647,40 @@ int Gemm_x86::create_pipeline_int8(const Option& opt)
 
     if (constantB)
     {
-        const int N = constantN;
-        const int K = constantK;
-
-        int TILE_M, TILE_N, TILE_K;
-        get_optimal_tile_mnk_int8(0, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, opt.num_threads);
+        if (BT_data.empty())
+        {
+            const int N = constantN;
+            const int K = constantK;
 
-        const int nn_N = (N + TILE_N - 1) / TILE_N;
+            int TILE_M, TILE_N, TILE_K;
+            get_optimal_tile_mnk_int8(0, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, opt.num_threads);
 
-        BT_data.create(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 1u, (Allocator*)0);
-        if (BT_data.empty())
-            return -100;
+            const int nn_N = (N + TILE_N - 1) / TILE_N;
 
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int ppj = 0; ppj < nn_N; ppj++)
-        {
-            const int j = ppj * TILE_N;
+            BT_data.create(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 1u, (Allocator*)0);
+            if (BT_data.empty())
+                return -100;
 
-            for (int k = 0; k < K; k += TILE_K)
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int ppj = 0; ppj < nn_N; ppj++)
             {
-                const int max_jj = std::min((N - j), TILE_N);
-                const int max_kk = std::min((K - k), TILE_K);
-
-                Mat BT_tile = BT_data.channel(j / TILE_N).row_range(k / TILE_K, 1);
+                const int j = ppj * TILE_N;
 
-                if (transB)
-                {
-                    pack_B_tile_int8(B_data, BT_tile, j, max_jj, k, max_kk);
-                }
-                else
+                for (int k = 0; k < K; k += TILE_K)
                 {
-                    transpose_pack_B_tile_int8(B_data, BT_tile, j, max_jj, k, max_kk);
+                    const int max_jj = std::min((N - j), TILE_N);
+                    const int max_kk = std::min((K - k), TILE_K);
+
+                    Mat BT_tile = BT_data.channel(j / TILE_N).row_range(k / TILE_K, 1);
+
+                    if (transB)
+                    {
+                        pack_B_tile_int8(B_data, BT_tile, j, max_jj, k, max_kk);
+                    }
+                    else
+                    {
+                        transpose_pack_B_tile_int8(B_data, BT_tile, j, max_jj, k, max_kk);
+                    }
                 }
             }
         }
@@ -8326,11 +8842,11 @@ int Gemm_x86::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat
         return -100;
 
     int _nT = nT ? nT : opt.num_threads;
-    if (nT != 0 && opt.num_threads != nT)
+    if (nT != 0 && opt.num_threads > nT && !opt.use_branch_parallel)
     {
-        // force num_threads the same as in create_pipeline
-        // so we could use pre-packed A/B from the same tile config
-        NCNN_LOGE("opt.num_threads %d changed, gemm will use load-time value %d", opt.num_threads, nT);
+        // pre-packed A/B follow the tile config of the load-time num_threads
+        // fewer threads are fine, branch parallel runs pass their thread share here
+        NCNN_LOGE("opt.num_threads %d changed, gemm will use at most load-time value %d", opt.num_threads, nT);
     }
 
     int ret = 0;
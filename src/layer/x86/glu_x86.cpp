@@ -0,0 +1,148 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "glu_x86.h"
+
+#include "x86_activation.h"
+
+namespace ncnn {
+
+GLU_x86::GLU_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+static void glu(const float* ptr, const float* gateptr, float* outptr, int size)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        __m512 _p = _mm512_loadu_ps(ptr);
+        __m512 _g = _mm512_loadu_ps(gateptr);
+        _mm512_storeu_ps(outptr, _mm512_mul_ps(_p, sigmoid_avx512(_g)));
+        ptr += 16;
+        gateptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        __m256 _p = _mm256_loadu_ps(ptr);
+        __m256 _g = _mm256_loadu_ps(gateptr);
+        _mm256_storeu_ps(outptr, _mm256_mul_ps(_p, sigmoid_avx(_g)));
+        ptr += 8;
+        gateptr += 8;
+        outptr += 8;
+    }
+#endif // __AVX__
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = _mm_loadu_ps(ptr);
+        __m128 _g = _mm_loadu_ps(gateptr);
+        _mm_storeu_ps(outptr, _mm_mul_ps(_p, sigmoid_sse(_g)));
+        ptr += 4;
+        gateptr += 4;
+        outptr += 4;
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        *outptr = *ptr / (1.f + expf(-*gateptr));
+        ptr++;
+        gateptr++;
+        outptr++;
+    }
+}
+
+int GLU_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int positive_axis = dims == 1 ? 0 : axis < 0 ? dims + axis : axis;
+
+    Mat bottom_blob_unpacked = bottom_blob;
+    if (bottom_blob.elempack != 1 && positive_axis == 0)
+    {
+        // halving the packed axis must not split a pack
+        const int outer = dims == 1 ? bottom_blob.w : dims == 2 ? bottom_blob.h : bottom_blob.c;
+        if (outer % 2 != 0)
+        {
+            Option opt_pack = opt;
+            opt_pack.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+    }
+
+    const int w = bottom_blob_unpacked.w;
+    const int h = bottom_blob_unpacked.h;
+    const int d = bottom_blob_unpacked.d;
+    const int channels = bottom_blob_unpacked.c;
+    const size_t elemsize = bottom_blob_unpacked.elemsize;
+    const int elempack = bottom_blob_unpacked.elempack;
+
+    if (dims == 1)
+        top_blob.create(w / 2, elemsize, elempack, opt.blob_allocator);
+    if (dims == 2)
+        top_blob.create(positive_axis == 1 ? w / 2 : w, positive_axis == 0 ? h / 2 : h, elemsize, elempack, opt.blob_allocator);
+    if (dims == 3)
+        top_blob.create(positive_axis == 2 ? w / 2 : w, positive_axis == 1 ? h / 2 : h, positive_axis == 0 ? channels / 2 : channels, elemsize, elempack, opt.blob_allocator);
+    if (dims == 4)
+        top_blob.create(positive_axis == 3 ? w / 2 : w, positive_axis == 2 ? h / 2 : h, positive_axis == 1 ? d / 2 : d, positive_axis == 0 ? channels / 2 : channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (dims >= 3 && positive_axis == 0)
+    {
+        const int out_channels = channels / 2;
+        const int size = w * h * d * elempack;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < out_channels; q++)
+        {
+            glu(bottom_blob_unpacked.channel(q), bottom_blob_unpacked.channel(q + out_channels), top_blob.channel(q), size);
+        }
+
+        return 0;
+    }
+
+    // split within each channel, 1d and 2d blob is one channel
+    // outer x [half | half] x inner
+    const int shape[3] = {d, h, w};
+    const int first = dims == 1 ? 2 : dims == 2 ? 1 : dims == 3 ? 1 : 0;
+    const int split = first + (dims <= 2 ? positive_axis : positive_axis - 1);
+
+    int outer = 1;
+    for (int i = first; i < split; i++)
+        outer *= shape[i];
+
+    const int half = shape[split] / 2;
+
+    int inner = elempack;
+    for (int i = split + 1; i < 3; i++)
+        inner *= shape[i];
+
+    const int out_channels = dims <= 2 ? 1 : channels;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < out_channels * outer; i++)
+    {
+        const int q = i / outer;
+        const int j = i % outer;
+
+        const float* ptr = (const float*)bottom_blob_unpacked.channel(q) + j * shape[split] * inner;
+        float* outptr = (float*)top_blob.channel(q) + j * half * inner;
+
+        glu(ptr, ptr + half * inner, outptr, half * inner);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
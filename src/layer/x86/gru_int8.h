@@ -0,0 +1,366 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+static int gru_transform_weight_int8(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_data_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt)
+{
+    // pack RUN for every 4 outputs, input and hidden are interleaved in pairs for pmaddwd
+    // the tail block and the odd tail pair are zero padded
+    const int size2 = (size + 1) / 2 * 2;
+    const int num_output2 = (num_output + 1) / 2 * 2;
+
+    const int nn_num_output = (num_output + 3) / 4;
+
+    weight_data_tm.create((size2 + num_output2) * 12, nn_num_output, num_directions, 1u, 1);
+    weight_data_tm_int8_descales.create(24, nn_num_output, num_directions);
+    bias_c_tm.create(16, nn_num_output, num_directions);
+    if (weight_data_tm.empty() || weight_data_tm_int8_descales.empty() || bias_c_tm.empty())
+        return -100;
+
+    weight_data_tm.fill<signed char>(0);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc_dr = weight_xc.channel(dr);
+        const Mat weight_hc_dr = weight_hc.channel(dr);
+        const Mat bias_c_dr = bias_c.channel(dr);
+        const float* weight_xc_int8_scales_ptr = weight_xc_int8_scales.row(dr);
+        const float* weight_hc_int8_scales_ptr = weight_hc_int8_scales.row(dr);
+
+        Mat weight_data_tm_dr = weight_data_tm.channel(dr);
+        Mat weight_data_tm_int8_descales_dr = weight_data_tm_int8_descales.channel(dr);
+        Mat bias_c_tm_dr = bias_c_tm.channel(dr);
+
+        const float* bias_c_R = bias_c_dr.row(0);
+        const float* bias_c_U = bias_c_dr.row(1);
+        const float* bias_c_WN = bias_c_dr.row(2);
+        const float* bias_c_BN = bias_c_dr.row(3);
+
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            signed char* kptr = weight_data_tm_dr.row<signed char>(qq);
+            float* descales_ptr = weight_data_tm_int8_descales_dr.row(qq);
+            float* bias_c_RUBNWN = bias_c_tm_dr.row(qq);
+
+            signed char* kptr_xc_RU = kptr;
+            signed char* kptr_hc_RU = kptr_xc_RU + size2 * 8;
+            signed char* kptr_hc_N = kptr_hc_RU + num_output2 * 8;
+            signed char* kptr_xc_N = kptr_hc_N + num_output2 * 4;
+
+            for (int k = 0; k < 4; k++)
+            {
+                const int q = qq * 4 + k;
+
+                if (q >= num_output)
+                {
+                    for (int i = 0; i < 4; i++)
+                    {
+                        bias_c_RUBNWN[i * 4 + k] = 0.f;
+                    }
+                    for (int i = 0; i < 6; i++)
+                    {
+                        descales_ptr[i * 4 + k] = 0.f;
+                    }
+                    continue;
+                }
+
+                bias_c_RUBNWN[k] = bias_c_R[q];
+                bias_c_RUBNWN[4 + k] = bias_c_U[q];
+                bias_c_RUBNWN[8 + k] = bias_c_BN[q];
+                bias_c_RUBNWN[12 + k] = bias_c_WN[q];
+
+                descales_ptr[k] = 1.f / weight_xc_int8_scales_ptr[num_output * 0 + q];
+                descales_ptr[4 + k] = 1.f / weight_xc_int8_scales_ptr[num_output * 1 + q];
+                descales_ptr[8 + k] = 1.f / weight_xc_int8_scales_ptr[num_output * 2 + q];
+                descales_ptr[12 + k] = 1.f / weight_hc_int8_scales_ptr[num_output * 0 + q];
+                descales_ptr[16 + k] = 1.f / weight_hc_int8_scales_ptr[num_output * 1 + q];
+                descales_ptr[20 + k] = 1.f / weight_hc_int8_scales_ptr[num_output * 2 + q];
+
+                const signed char* weight_xc_R = weight_xc_dr.row<const signed char>(num_output * 0 + q);
+                const signed char* weight_xc_U = weight_xc_dr.row<const signed char>(num_output * 1 + q);
+                const signed char* weight_xc_N = weight_xc_dr.row<const signed char>(num_output * 2 + q);
+
+                const signed char* weight_hc_R = weight_hc_dr.row<const signed char>(num_output * 0 + q);
+                const signed char* weight_hc_U = weight_hc_dr.row<const signed char>(num_output * 1 + q);
+                const signed char* weight_hc_N = weight_hc_dr.row<const signed char>(num_output * 2 + q);
+
+                for (int i = 0; i < size; i++)
+                {
+                    const int p = i / 2;
+                    const int j = i % 2;
+                    kptr_xc_RU[p * 16 + k * 2 + j] = weight_xc_R[i];
+                    kptr_xc_RU[p * 16 + 8 + k * 2 + j] = weight_xc_U[i];
+                    kptr_xc_N[p * 8 + k * 2 + j] = weight_xc_N[i];
+                }
+
+                for (int i = 0; i < num_output; i++)
+                {
+                    const int p = i / 2;
+                    const int j = i % 2;
+                    kptr_hc_RU[p * 16 + k * 2 + j] = weight_hc_R[i];
+                    kptr_hc_RU[p * 16 + 8 + k * 2 + j] = weight_hc_U[i];
+                    kptr_hc_N[p * 8 + k * 2 + j] = weight_hc_N[i];
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static float gru_dynamic_quantize_int16(const float* ptr, int size, short* outptr)
+{
+    float absmax = 0.f;
+    for (int i = 0; i < size; i++)
+    {
+        absmax = std::max(absmax, (float)fabs(ptr[i]));
+    }
+
+    if (absmax == 0.f)
+    {
+        for (int i = 0; i < size; i++)
+        {
+            outptr[i] = 0;
+        }
+        return 0.f;
+    }
+
+    const float scale = 127.f / absmax;
+    for (int i = 0; i < size; i++)
+    {
+        outptr[i] = float2int8(ptr[i] * scale);
+    }
+
+    return absmax / 127.f;
+}
+
+#if __SSE2__
+static NCNN_FORCEINLINE __m128i gru_dot4_int8_sse2(const signed char* kptr, const short* x, int pairs)
+{
+    // kptr holds 4 outputs x 2 int8 per pair, x holds int16 pairs
+    __m128i _sum0 = _mm_setzero_si128();
+    __m128i _sum1 = _mm_setzero_si128();
+
+    int p = 0;
+    for (; p + 1 < pairs; p += 2)
+    {
+        __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+        __m128i _w0 = _mm_srai_epi16(_mm_unpacklo_epi8(_w, _w), 8);
+        __m128i _w1 = _mm_srai_epi16(_mm_unpackhi_epi8(_w, _w), 8);
+        _sum0 = _mm_add_epi32(_sum0, _mm_madd_epi16(_w0, _mm_set1_epi32(((const int*)x)[p])));
+        _sum1 = _mm_add_epi32(_sum1, _mm_madd_epi16(_w1, _mm_set1_epi32(((const int*)x)[p + 1])));
+
+        kptr += 16;
+    }
+    for (; p < pairs; p++)
+    {
+        __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
+        __m128i _w0 = _mm_srai_epi16(_mm_unpacklo_epi8(_w, _w), 8);
+        _sum0 = _mm_add_epi32(_sum0, _mm_madd_epi16(_w0, _mm_set1_epi32(((const int*)x)[p])));
+
+        kptr += 8;
+    }
+
+    return _mm_add_epi32(_sum0, _sum1);
+}
+
+static NCNN_FORCEINLINE void gru_dot4x2_int8_sse2(const signed char* kptr, const short* x, int pairs, __m128i& _R, __m128i& _U)
+{
+    // kptr holds 4 R outputs and 4 U outputs x 2 int8 per pair
+#if __AVX2__
+    __m256i _RU = _mm256_setzero_si256();
+    for (int p = 0; p < pairs; p++)
+    {
+        __m256i _w = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)kptr));
+        _RU = _mm256_add_epi32(_RU, _mm256_madd_epi16(_w, _mm256_set1_epi32(((const int*)x)[p])));
+
+        kptr += 16;
+    }
+
+    _R = _mm256_castsi256_si128(_RU);
+    _U = _mm256_extracti128_si256(_RU, 1);
+#else
+    _R = _mm_setzero_si128();
+    _U = _mm_setzero_si128();
+    for (int p = 0; p < pairs; p++)
+    {
+        __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+        __m128i _x = _mm_set1_epi32(((const int*)x)[p]);
+        _R = _mm_add_epi32(_R, _mm_madd_epi16(_mm_srai_epi16(_mm_unpacklo_epi8(_w, _w), 8), _x));
+        _U = _mm_add_epi32(_U, _mm_madd_epi16(_mm_srai_epi16(_mm_unpackhi_epi8(_w, _w), 8), _x));
+
+        kptr += 16;
+    }
+#endif
+}
+#endif // __SSE2__
+
+static int gru_int8(const Mat& bottom_blob, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt)
+{
+    const int size = bottom_blob.w;
+    const int T = bottom_blob.h;
+
+    const int num_output = top_blob.w;
+    const int nn_num_output = (num_output + 3) / 4;
+
+    const int size2 = (size + 1) / 2 * 2;
+    const int num_output2 = (num_output + 1) / 2 * 2;
+
+    // U N for every 4 outputs
+    Mat gates(8, nn_num_output, 4u, opt.workspace_allocator);
+    if (gates.empty())
+        return -100;
+
+    // dynamic quantize bottom_blob
+    Mat bottom_blob_int16(size2, T, 2u, opt.workspace_allocator);
+    Mat bottom_blob_int8_descales(T, 4u, opt.workspace_allocator);
+    if (bottom_blob_int16.empty() || bottom_blob_int8_descales.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < T; t++)
+    {
+        short* outptr = bottom_blob_int16.row<short>(t);
+        bottom_blob_int8_descales[t] = gru_dynamic_quantize_int16(bottom_blob.row(t), size, outptr);
+        if (size2 != size)
+            outptr[size] = 0;
+    }
+
+    Mat hidden_state_int16(num_output2, 2u, opt.workspace_allocator);
+    if (hidden_state_int16.empty())
+        return -100;
+
+    hidden_state_int16.fill<short>(0);
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        const int ti = reverse ? T - 1 - t : t;
+
+        // dynamic quantize hidden_state
+        const float descale_h = gru_dynamic_quantize_int16(hidden_state, num_output, hidden_state_int16);
+        const float descale_x = bottom_blob_int8_descales[ti];
+
+        const short* x = bottom_blob_int16.row<const short>(ti);
+        const short* hs = hidden_state_int16;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            const signed char* kptr_xc_RU = weight_data_tm.row<const signed char>(qq);
+            const signed char* kptr_hc_RU = kptr_xc_RU + size2 * 8;
+            const signed char* kptr_hc_N = kptr_hc_RU + num_output2 * 8;
+            const signed char* kptr_xc_N = kptr_hc_N + num_output2 * 4;
+
+            const float* descales_ptr = weight_data_tm_int8_descales.row(qq);
+            const float* bias_c_RUBNWN = bias_c.row(qq);
+
+            float* gates_data = gates.row(qq);
+
+#if __SSE2__
+            __m128i _Rx;
+            __m128i _Ux;
+            __m128i _Rh;
+            __m128i _Uh;
+            gru_dot4x2_int8_sse2(kptr_xc_RU, x, size2 / 2, _Rx, _Ux);
+            gru_dot4x2_int8_sse2(kptr_hc_RU, hs, num_output2 / 2, _Rh, _Uh);
+
+            __m128 _descale_x = _mm_set1_ps(descale_x);
+            __m128 _descale_h = _mm_set1_ps(descale_h);
+
+            // gate reset update
+            __m128 _R = _mm_loadu_ps(bias_c_RUBNWN);
+            __m128 _U = _mm_loadu_ps(bias_c_RUBNWN + 4);
+            _R = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Rx), _mm_mul_ps(_descale_x, _mm_loadu_ps(descales_ptr)), _R);
+            _U = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Ux), _mm_mul_ps(_descale_x, _mm_loadu_ps(descales_ptr + 4)), _U);
+            _R = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Rh), _mm_mul_ps(_descale_h, _mm_loadu_ps(descales_ptr + 12)), _R);
+            _U = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Uh), _mm_mul_ps(_descale_h, _mm_loadu_ps(descales_ptr + 16)), _U);
+
+            // sigmoid(R)
+            // sigmoid(U)
+            _R = sigmoid_sse(_R);
+            _U = sigmoid_sse(_U);
+
+            // gate new
+            __m128i _Nh = gru_dot4_int8_sse2(kptr_hc_N, hs, num_output2 / 2);
+            __m128i _Nx = gru_dot4_int8_sse2(kptr_xc_N, x, size2 / 2);
+
+            __m128 _N = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Nh), _mm_mul_ps(_descale_h, _mm_loadu_ps(descales_ptr + 20)), _mm_loadu_ps(bias_c_RUBNWN + 8));
+            _N = _mm_comp_fmadd_ps(_R, _N, _mm_loadu_ps(bias_c_RUBNWN + 12));
+            _N = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Nx), _mm_mul_ps(_descale_x, _mm_loadu_ps(descales_ptr + 8)), _N);
+
+            // tanh(N)
+            _N = tanh_sse(_N);
+
+            _mm_storeu_ps(gates_data, _U);
+            _mm_storeu_ps(gates_data + 4, _N);
+#else  // __SSE2__
+            for (int k = 0; k < 4; k++)
+            {
+                int Rx = 0;
+                int Ux = 0;
+                int Nx = 0;
+                for (int i = 0; i < size2; i++)
+                {
+                    const int p = i / 2;
+                    const int j = i % 2;
+                    Rx += kptr_xc_RU[p * 16 + k * 2 + j] * x[i];
+                    Ux += kptr_xc_RU[p * 16 + 8 + k * 2 + j] * x[i];
+                    Nx += kptr_xc_N[p * 8 + k * 2 + j] * x[i];
+                }
+
+                int Rh = 0;
+                int Uh = 0;
+                int Nh = 0;
+                for (int i = 0; i < num_output2; i++)
+                {
+                    const int p = i / 2;
+                    const int j = i % 2;
+                    Rh += kptr_hc_RU[p * 16 + k * 2 + j] * hs[i];
+                    Uh += kptr_hc_RU[p * 16 + 8 + k * 2 + j] * hs[i];
+                    Nh += kptr_hc_N[p * 8 + k * 2 + j] * hs[i];
+                }
+
+                // gate reset update
+                float R = bias_c_RUBNWN[k] + Rx * (descale_x * descales_ptr[k]) + Rh * (descale_h * descales_ptr[12 + k]);
+                float U = bias_c_RUBNWN[4 + k] + Ux * (descale_x * descales_ptr[4 + k]) + Uh * (descale_h * descales_ptr[16 + k]);
+
+                // sigmoid(R)
+                // sigmoid(U)
+                R = 1.f / (1.f + expf(-R));
+                U = 1.f / (1.f + expf(-U));
+
+                // gate new
+                float N = bias_c_RUBNWN[8 + k] + Nh * (descale_h * descales_ptr[20 + k]);
+                N = bias_c_RUBNWN[12 + k] + R * N + Nx * (descale_x * descales_ptr[8 + k]);
+
+                // tanh(N)
+                N = tanhf(N);
+
+                gates_data[k] = U;
+                gates_data[4 + k] = N;
+            }
+#endif // __SSE2__
+        }
+
+        // h_t := (1 - update) .* new + update .* h_{t-1}
+        float* output_data = top_blob.row(ti);
+        float* hidden_ptr = hidden_state;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < num_output; q++)
+        {
+            const float* gates_data = gates.row(q / 4);
+
+            const float U = gates_data[q % 4];
+            const float N = gates_data[4 + q % 4];
+
+            const float H = (1 - U) * N + U * hidden_ptr[q];
+
+            hidden_ptr[q] = H;
+            output_data[q] = H;
+        }
+    }
+
+    return 0;
+}
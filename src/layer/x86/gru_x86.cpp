@@ -0,0 +1,598 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gru_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+#if NCNN_INT8
+#include "gru_int8.h"
+#endif
+
+GRU_x86::GRU_x86()
+{
+    one_blob_only = false;
+    support_inplace = false;
+}
+
+int GRU_x86::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return create_pipeline_int8(opt);
+    }
+#endif
+
+    // pack RUN for every 4 outputs, the tail block is zero padded
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output / 3;
+
+    const int nn_num_output = (num_output + 3) / 4;
+
+    weight_xc_data_packed.create(size * 12, nn_num_output, num_directions);
+    bias_c_data_packed.create(16, nn_num_output, num_directions);
+    weight_hc_data_packed.create(num_output * 12, nn_num_output, num_directions);
+    if (weight_xc_data_packed.empty() || bias_c_data_packed.empty() || weight_hc_data_packed.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc = weight_xc_data.channel(dr);
+        const Mat bias_c = bias_c_data.channel(dr);
+        const Mat weight_hc = weight_hc_data.channel(dr);
+
+        Mat weight_xc_data_packed_dr = weight_xc_data_packed.channel(dr);
+        Mat bias_c_data_packed_dr = bias_c_data_packed.channel(dr);
+        Mat weight_hc_data_packed_dr = weight_hc_data_packed.channel(dr);
+
+        const float* bias_c_R = bias_c.row(0);
+        const float* bias_c_U = bias_c.row(1);
+        const float* bias_c_WN = bias_c.row(2);
+        const float* bias_c_BN = bias_c.row(3);
+
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            float* bias_c_RUBNWN = bias_c_data_packed_dr.row(qq);
+            float* weight_xc_RUN = weight_xc_data_packed_dr.row(qq);
+            float* weight_hc_RUN = weight_hc_data_packed_dr.row(qq);
+
+            for (int k = 0; k < 4; k++)
+            {
+                const int q = qq * 4 + k;
+
+                if (q >= num_output)
+                {
+                    bias_c_RUBNWN[k] = 0.f;
+                    bias_c_RUBNWN[4 + k] = 0.f;
+                    bias_c_RUBNWN[8 + k] = 0.f;
+                    bias_c_RUBNWN[12 + k] = 0.f;
+
+                    for (int i = 0; i < size; i++)
+                    {
+                        weight_xc_RUN[i * 8 + k] = 0.f;
+                        weight_xc_RUN[i * 8 + 4 + k] = 0.f;
+                        weight_xc_RUN[size * 8 + i * 4 + k] = 0.f;
+                    }
+
+                    for (int i = 0; i < num_output; i++)
+                    {
+                        weight_hc_RUN[i * 8 + k] = 0.f;
+                        weight_hc_RUN[i * 8 + 4 + k] = 0.f;
+                        weight_hc_RUN[num_output * 8 + i * 4 + k] = 0.f;
+                    }
+
+                    continue;
+                }
+
+                bias_c_RUBNWN[k] = bias_c_R[q];
+                bias_c_RUBNWN[4 + k] = bias_c_U[q];
+                bias_c_RUBNWN[8 + k] = bias_c_BN[q];
+                bias_c_RUBNWN[12 + k] = bias_c_WN[q];
+
+                const float* weight_xc_R = weight_xc.row(num_output * 0 + q);
+                const float* weight_xc_U = weight_xc.row(num_output * 1 + q);
+                const float* weight_xc_N = weight_xc.row(num_output * 2 + q);
+
+                const float* weight_hc_R = weight_hc.row(num_output * 0 + q);
+                const float* weight_hc_U = weight_hc.row(num_output * 1 + q);
+                const float* weight_hc_N = weight_hc.row(num_output * 2 + q);
+
+                for (int i = 0; i < size; i++)
+                {
+                    weight_xc_RUN[i * 8 + k] = weight_xc_R[i];
+                    weight_xc_RUN[i * 8 + 4 + k] = weight_xc_U[i];
+                    weight_xc_RUN[size * 8 + i * 4 + k] = weight_xc_N[i];
+                }
+
+                for (int i = 0; i < num_output; i++)
+                {
+                    weight_hc_RUN[i * 8 + k] = weight_hc_R[i];
+                    weight_hc_RUN[i * 8 + 4 + k] = weight_hc_U[i];
+                    weight_hc_RUN[num_output * 8 + i * 4 + k] = weight_hc_N[i];
+                }
+            }
+        }
+    }
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+    }
+
+    return 0;
+}
+
+static void gru_gate_output(const Mat& gates, Mat& hidden_state, Mat& top_blob, int ti, const Option& opt)
+{
+    const int num_output = top_blob.w;
+
+    // h_t := (1 - update) .* new + update .* h_{t-1}
+    float* output_data = top_blob.row(ti);
+    float* hidden_ptr = hidden_state;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_output; q++)
+    {
+        const float* gates_data = gates.row(q / 4);
+
+        const float U = gates_data[q % 4];
+        const float N = gates_data[4 + q % 4];
+
+        const float H = (1 - U) * N + U * hidden_ptr[q];
+
+        hidden_ptr[q] = H;
+        output_data[q] = H;
+    }
+}
+
+static int gru(const Mat& bottom_blob, Mat& top_blob, int reverse, const Mat& weight_xc, const Mat& bias_c, const Mat& weight_hc, Mat& hidden_state, const Option& opt)
+{
+    const int size = bottom_blob.w;
+    const int T = bottom_blob.h;
+
+    const int num_output = top_blob.w;
+    const int nn_num_output = (num_output + 3) / 4;
+
+    // U N for every 4 outputs
+    Mat gates(8, nn_num_output, 4u, opt.workspace_allocator);
+    if (gates.empty())
+        return -100;
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        const int ti = reverse ? T - 1 - t : t;
+
+        const float* x = bottom_blob.row(ti);
+        const float* hs = hidden_state;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            const float* bias_c_RUBNWN = bias_c.row(qq);
+
+            const float* weight_xc_RUN = weight_xc.row(qq);
+            const float* weight_hc_RUN = weight_hc.row(qq);
+
+            float* gates_data = gates.row(qq);
+
+#if __SSE2__
+            // gate reset update
+#if __AVX__
+            __m256 _RU = _mm256_loadu_ps(bias_c_RUBNWN);
+            __m256 _sum1 = _mm256_setzero_ps();
+            __m256 _sum2 = _mm256_setzero_ps();
+            __m256 _sum3 = _mm256_setzero_ps();
+
+            int i = 0;
+            for (; i + 3 < size; i += 4)
+            {
+                _RU = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_xc_RUN), _mm256_set1_ps(x[i]), _RU);
+                _sum1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_xc_RUN + 8), _mm256_set1_ps(x[i + 1]), _sum1);
+                _sum2 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_xc_RUN + 16), _mm256_set1_ps(x[i + 2]), _sum2);
+                _sum3 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_xc_RUN + 24), _mm256_set1_ps(x[i + 3]), _sum3);
+
+                weight_xc_RUN += 32;
+            }
+            for (; i < size; i++)
+            {
+                _RU = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_xc_RUN), _mm256_set1_ps(x[i]), _RU);
+
+                weight_xc_RUN += 8;
+            }
+
+            i = 0;
+            for (; i + 3 < num_output; i += 4)
+            {
+                _RU = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN), _mm256_set1_ps(hs[i]), _RU);
+                _sum1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN + 8), _mm256_set1_ps(hs[i + 1]), _sum1);
+                _sum2 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN + 16), _mm256_set1_ps(hs[i + 2]), _sum2);
+                _sum3 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN + 24), _mm256_set1_ps(hs[i + 3]), _sum3);
+
+                weight_hc_RUN += 32;
+            }
+            for (; i < num_output; i++)
+            {
+                _RU = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN), _mm256_set1_ps(hs[i]), _RU);
+
+                weight_hc_RUN += 8;
+            }
+
+            _RU = _mm256_add_ps(_mm256_add_ps(_RU, _sum1), _mm256_add_ps(_sum2, _sum3));
+
+            // sigmoid(R)
+            // sigmoid(U)
+            _RU = sigmoid_avx(_RU);
+
+            __m128 _R = _mm256_castps256_ps128(_RU);
+            __m128 _U = _mm256_extractf128_ps(_RU, 1);
+#else  // __AVX__
+            __m128 _R = _mm_loadu_ps(bias_c_RUBNWN);
+            __m128 _U = _mm_loadu_ps(bias_c_RUBNWN + 4);
+            __m128 _sum1 = _mm_setzero_ps();
+            __m128 _sum2 = _mm_setzero_ps();
+
+            int i = 0;
+            for (; i + 1 < size; i += 2)
+            {
+                __m128 _xi0 = _mm_set1_ps(x[i]);
+                __m128 _xi1 = _mm_set1_ps(x[i + 1]);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN), _xi0, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN + 4), _xi0, _U);
+                _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN + 8), _xi1, _sum1);
+                _sum2 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN + 12), _xi1, _sum2);
+
+                weight_xc_RUN += 16;
+            }
+            for (; i < size; i++)
+            {
+                __m128 _xi = _mm_set1_ps(x[i]);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN), _xi, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN + 4), _xi, _U);
+
+                weight_xc_RUN += 8;
+            }
+
+            i = 0;
+            for (; i + 1 < num_output; i += 2)
+            {
+                __m128 _h_cont0 = _mm_set1_ps(hs[i]);
+                __m128 _h_cont1 = _mm_set1_ps(hs[i + 1]);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN), _h_cont0, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 4), _h_cont0, _U);
+                _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 8), _h_cont1, _sum1);
+                _sum2 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 12), _h_cont1, _sum2);
+
+                weight_hc_RUN += 16;
+            }
+            for (; i < num_output; i++)
+            {
+                __m128 _h_cont = _mm_set1_ps(hs[i]);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN), _h_cont, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 4), _h_cont, _U);
+
+                weight_hc_RUN += 8;
+            }
+
+            // sigmoid(R)
+            // sigmoid(U)
+            _R = sigmoid_sse(_mm_add_ps(_R, _sum1));
+            _U = sigmoid_sse(_mm_add_ps(_U, _sum2));
+#endif // __AVX__
+
+            // gate new
+            __m128 _N = _mm_loadu_ps(bias_c_RUBNWN + 8);
+            __m128 _sum4 = _mm_setzero_ps();
+            __m128 _sum5 = _mm_setzero_ps();
+            __m128 _sum6 = _mm_setzero_ps();
+
+            i = 0;
+            for (; i + 3 < num_output; i += 4)
+            {
+                _N = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN), _mm_set1_ps(hs[i]), _N);
+                _sum4 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 4), _mm_set1_ps(hs[i + 1]), _sum4);
+                _sum5 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 8), _mm_set1_ps(hs[i + 2]), _sum5);
+                _sum6 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 12), _mm_set1_ps(hs[i + 3]), _sum6);
+
+                weight_hc_RUN += 16;
+            }
+            for (; i < num_output; i++)
+            {
+                _N = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN), _mm_set1_ps(hs[i]), _N);
+
+                weight_hc_RUN += 4;
+            }
+
+            _N = _mm_add_ps(_mm_add_ps(_N, _sum4), _mm_add_ps(_sum5, _sum6));
+
+            _N = _mm_comp_fmadd_ps(_R, _N, _mm_loadu_ps(bias_c_RUBNWN + 12));
+            _sum4 = _mm_setzero_ps();
+            _sum5 = _mm_setzero_ps();
+            _sum6 = _mm_setzero_ps();
+
+            i = 0;
+            for (; i + 3 < size; i += 4)
+            {
+                _N = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN), _mm_set1_ps(x[i]), _N);
+                _sum4 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN + 4), _mm_set1_ps(x[i + 1]), _sum4);
+                _sum5 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN + 8), _mm_set1_ps(x[i + 2]), _sum5);
+                _sum6 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN + 12), _mm_set1_ps(x[i + 3]), _sum6);
+
+                weight_xc_RUN += 16;
+            }
+            for (; i < size; i++)
+            {
+                _N = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN), _mm_set1_ps(x[i]), _N);
+
+                weight_xc_RUN += 4;
+            }
+
+            _N = _mm_add_ps(_mm_add_ps(_N, _sum4), _mm_add_ps(_sum5, _sum6));
+
+            // tanh(N)
+            _N = tanh_sse(_N);
+
+            _mm_storeu_ps(gates_data, _U);
+            _mm_storeu_ps(gates_data + 4, _N);
+#else  // __SSE2__
+            for (int k = 0; k < 4; k++)
+            {
+                const float* pxc = weight_xc_RUN + k;
+                const float* phc = weight_hc_RUN + k;
+
+                // gate reset update
+                float R = bias_c_RUBNWN[k];
+                float U = bias_c_RUBNWN[4 + k];
+
+                for (int i = 0; i < size; i++)
+                {
+                    R += pxc[0] * x[i];
+                    U += pxc[4] * x[i];
+
+                    pxc += 8;
+                }
+
+                for (int i = 0; i < num_output; i++)
+                {
+                    R += phc[0] * hs[i];
+                    U += phc[4] * hs[i];
+
+                    phc += 8;
+                }
+
+                // sigmoid(R)
+                // sigmoid(U)
+                R = 1.f / (1.f + expf(-R));
+                U = 1.f / (1.f + expf(-U));
+
+                // gate new
+                float N = bias_c_RUBNWN[8 + k];
+
+                for (int i = 0; i < num_output; i++)
+                {
+                    N += phc[0] * hs[i];
+
+                    phc += 4;
+                }
+
+                N = bias_c_RUBNWN[12 + k] + R * N;
+
+                for (int i = 0; i < size; i++)
+                {
+                    N += pxc[0] * x[i];
+
+                    pxc += 4;
+                }
+
+                // tanh(N)
+                N = tanhf(N);
+
+                gates_data[k] = U;
+                gates_data[4 + k] = N;
+            }
+#endif // __SSE2__
+        }
+
+        gru_gate_output(gates, hidden_state, top_blob, ti, opt);
+    }
+
+    return 0;
+}
+
+int GRU_x86::gru_direction(const Mat& bottom_blob, Mat& top_blob, int reverse, int dr, Mat& hidden_state, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return gru_int8(bottom_blob, top_blob, reverse, weight_data_tm.channel(dr), weight_data_tm_int8_descales.channel(dr), bias_c_data_packed.channel(dr), hidden_state, opt);
+    }
+#endif
+
+    return gru(bottom_blob, top_blob, reverse, weight_xc_data_packed.channel(dr), bias_c_data_packed.channel(dr), weight_hc_data_packed.channel(dr), hidden_state, opt);
+}
+
+int GRU_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int T = bottom_blob.h;
+
+    int num_directions = direction == 2 ? 2 : 1;
+
+    // initial hidden state
+    Mat hidden(num_output, 4u, opt.workspace_allocator);
+    if (hidden.empty())
+        return -100;
+    hidden.fill(0.f);
+
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        int ret = gru_direction(bottom_blob, top_blob, direction, 0, hidden, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        {
+            int ret = gru_direction(bottom_blob, top_blob_forward, 0, 0, hidden, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        hidden.fill(0.f);
+
+        {
+            int ret = gru_direction(bottom_blob, top_blob_reverse, 1, 1, hidden, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    return 0;
+}
+
+int GRU_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    int T = bottom_blob.h;
+    int num_directions = direction == 2 ? 2 : 1;
+
+    Mat hidden;
+    Allocator* hidden_allocator = top_blobs.size() == 2 ? opt.blob_allocator : opt.workspace_allocator;
+    if (bottom_blobs.size() == 2)
+    {
+        hidden = bottom_blobs[1].clone(hidden_allocator);
+    }
+    else
+    {
+        hidden.create(num_output, num_directions, 4u, hidden_allocator);
+        if (hidden.empty())
+            return -100;
+        hidden.fill(0.f);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        int ret = gru_direction(bottom_blob, top_blob, direction, 0, hidden, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        Mat hidden0 = hidden.row_range(0, 1);
+        {
+            int ret = gru_direction(bottom_blob, top_blob_forward, 0, 0, hidden0, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        Mat hidden1 = hidden.row_range(1, 1);
+        {
+            int ret = gru_direction(bottom_blob, top_blob_reverse, 1, 1, hidden1, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    if (top_blobs.size() == 2)
+    {
+        top_blobs[1] = hidden;
+    }
+
+    return 0;
+}
+
+#if NCNN_INT8
+int GRU_x86::create_pipeline_int8(const Option& opt)
+{
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output / 3;
+
+    int ret = gru_transform_weight_int8(weight_xc_data, weight_xc_data_int8_scales, weight_hc_data, weight_hc_data_int8_scales, bias_c_data, weight_data_tm, weight_data_tm_int8_descales, bias_c_data_packed, size, num_output, num_directions, opt);
+    if (ret != 0)
+        return ret;
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+        weight_xc_data_int8_scales.release();
+        weight_hc_data_int8_scales.release();
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
+} // namespace ncnn
@@ -29,6 +29,366 @@ namespace ncnn {
 #undef NCNN_IMPL_FP16S
 #endif
 
+#if __SSE2__
+static NCNN_FORCEINLINE __m128i innerproduct_weight_quant_load16(const unsigned char* kptr, int bits)
+{
+    if (bits == 4)
+    {
+        // 8 bytes hold 16 weights, low nibbles first
+        __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
+        __m128i _mask = _mm_set1_epi8(0x0f);
+        __m128i _lo = _mm_and_si128(_w, _mask);
+        __m128i _hi = _mm_and_si128(_mm_srli_epi16(_w, 4), _mask);
+        return _mm_unpacklo_epi64(_lo, _hi);
+    }
+
+    return _mm_loadu_si128((const __m128i*)kptr);
+}
+
+#if __AVX512F__
+static NCNN_FORCEINLINE __m512 innerproduct_weight_quant_cvt16(__m128i _w)
+{
+    return _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_w));
+}
+#elif __AVX__
+static NCNN_FORCEINLINE void innerproduct_weight_quant_cvt16(__m128i _w, __m256& _w0, __m256& _w1)
+{
+#if __AVX2__
+    _w0 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_w));
+    _w1 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_unpackhi_epi64(_w, _w)));
+#else
+    __m128i _w_0 = _mm_cvtepi8_epi32(_w);
+    __m128i _w_1 = _mm_cvtepi8_epi32(_mm_srli_si128(_w, 4));
+    __m128i _w_2 = _mm_cvtepi8_epi32(_mm_srli_si128(_w, 8));
+    __m128i _w_3 = _mm_cvtepi8_epi32(_mm_srli_si128(_w, 12));
+    _w0 = _mm256_cvtepi32_ps(combine4x2_epi32(_w_0, _w_1));
+    _w1 = _mm256_cvtepi32_ps(combine4x2_epi32(_w_2, _w_3));
+#endif
+}
+#else
+static NCNN_FORCEINLINE void innerproduct_weight_quant_cvt16(__m128i _w, __m128& _w0, __m128& _w1, __m128& _w2, __m128& _w3)
+{
+    __m128i _w01 = _mm_srai_epi16(_mm_unpacklo_epi8(_w, _w), 8);
+    __m128i _w23 = _mm_srai_epi16(_mm_unpackhi_epi8(_w, _w), 8);
+    _w0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(_w01, _w01), 16));
+    _w1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(_w01, _w01), 16));
+    _w2 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(_w23, _w23), 16));
+    _w3 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(_w23, _w23), 16));
+}
+#endif
+#endif // __SSE2__
+
+static void innerproduct_weight_quant_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_tm, const Mat& weight_quant_scales, const Mat& weight_quant_offsets, const Mat& bias_data, int bits, int group_size, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    // bottom_blob and top_blob are rows of fp32 without packing
+    const int num_input = bottom_blob.w;
+    const int rows = bottom_blob.h;
+    const int num_output = top_blob.w;
+    const int num_group = num_input / group_size;
+    const int kstep = bits == 4 ? 8 : 16;
+
+    // the zero point term needs the sum of inputs per group
+    Mat xsum(num_group, rows, (size_t)4u, opt.workspace_allocator);
+
+    for (int j = 0; j < rows; j++)
+    {
+        const float* ptr = bottom_blob.row(j);
+        float* xsptr = xsum.row(j);
+
+        for (int g = 0; g < num_group; g++)
+        {
+            float sum = 0.f;
+            for (int k = 0; k < group_size; k++)
+            {
+                sum += ptr[k];
+            }
+            xsptr[g] = sum;
+            ptr += group_size;
+        }
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < num_output; p++)
+    {
+        const float* sptr = weight_quant_scales.row(p);
+        const float* optr = weight_quant_offsets.row(p);
+        const float bias = bias_data.empty() ? 0.f : bias_data[p];
+
+        int j = 0;
+        for (; j + 3 < rows; j += 4)
+        {
+            const unsigned char* kptr = weight_data_tm.row<const unsigned char>(p);
+            const float* x0 = bottom_blob.row(j);
+            const float* x1 = bottom_blob.row(j + 1);
+            const float* x2 = bottom_blob.row(j + 2);
+            const float* x3 = bottom_blob.row(j + 3);
+
+#if __AVX512F__
+            __m512 _sum0 = _mm512_setzero_ps();
+            __m512 _sum1 = _mm512_setzero_ps();
+            __m512 _sum2 = _mm512_setzero_ps();
+            __m512 _sum3 = _mm512_setzero_ps();
+#elif __AVX__
+            __m256 _sum0 = _mm256_setzero_ps();
+            __m256 _sum1 = _mm256_setzero_ps();
+            __m256 _sum2 = _mm256_setzero_ps();
+            __m256 _sum3 = _mm256_setzero_ps();
+#elif __SSE2__
+            __m128 _sum0 = _mm_setzero_ps();
+            __m128 _sum1 = _mm_setzero_ps();
+            __m128 _sum2 = _mm_setzero_ps();
+            __m128 _sum3 = _mm_setzero_ps();
+#else
+            float sum0 = 0.f;
+            float sum1 = 0.f;
+            float sum2 = 0.f;
+            float sum3 = 0.f;
+#endif
+
+            for (int g = 0; g < num_group; g++)
+            {
+#if __AVX512F__
+                __m512 _acc0 = _mm512_setzero_ps();
+                __m512 _acc1 = _mm512_setzero_ps();
+                __m512 _acc2 = _mm512_setzero_ps();
+                __m512 _acc3 = _mm512_setzero_ps();
+                for (int k = 0; k < group_size; k += 16)
+                {
+                    __m512 _w = innerproduct_weight_quant_cvt16(innerproduct_weight_quant_load16(kptr, bits));
+                    _acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x0), _w, _acc0);
+                    _acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(x1), _w, _acc1);
+                    _acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(x2), _w, _acc2);
+                    _acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(x3), _w, _acc3);
+                    x0 += 16;
+                    x1 += 16;
+                    x2 += 16;
+                    x3 += 16;
+                    kptr += kstep;
+                }
+                __m512 _scale = _mm512_set1_ps(sptr[g]);
+                _sum0 = _mm512_fmadd_ps(_acc0, _scale, _sum0);
+                _sum1 = _mm512_fmadd_ps(_acc1, _scale, _sum1);
+                _sum2 = _mm512_fmadd_ps(_acc2, _scale, _sum2);
+                _sum3 = _mm512_fmadd_ps(_acc3, _scale, _sum3);
+#elif __AVX__
+                __m256 _acc0 = _mm256_setzero_ps();
+                __m256 _acc1 = _mm256_setzero_ps();
+                __m256 _acc2 = _mm256_setzero_ps();
+                __m256 _acc3 = _mm256_setzero_ps();
+                for (int k = 0; k < group_size; k += 16)
+                {
+                    __m256 _w0;
+                    __m256 _w1;
+                    innerproduct_weight_quant_cvt16(innerproduct_weight_quant_load16(kptr, bits), _w0, _w1);
+                    _acc0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x0), _w0, _acc0);
+                    _acc1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x1), _w0, _acc1);
+                    _acc2 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x2), _w0, _acc2);
+                    _acc3 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x3), _w0, _acc3);
+                    _acc0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x0 + 8), _w1, _acc0);
+                    _acc1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x1 + 8), _w1, _acc1);
+                    _acc2 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x2 + 8), _w1, _acc2);
+                    _acc3 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x3 + 8), _w1, _acc3);
+                    x0 += 16;
+                    x1 += 16;
+                    x2 += 16;
+                    x3 += 16;
+                    kptr += kstep;
+                }
+                __m256 _scale = _mm256_set1_ps(sptr[g]);
+                _sum0 = _mm256_comp_fmadd_ps(_acc0, _scale, _sum0);
+                _sum1 = _mm256_comp_fmadd_ps(_acc1, _scale, _sum1);
+                _sum2 = _mm256_comp_fmadd_ps(_acc2, _scale, _sum2);
+                _sum3 = _mm256_comp_fmadd_ps(_acc3, _scale, _sum3);
+#elif __SSE2__
+                __m128 _acc0 = _mm_setzero_ps();
+                __m128 _acc1 = _mm_setzero_ps();
+                __m128 _acc2 = _mm_setzero_ps();
+                __m128 _acc3 = _mm_setzero_ps();
+                for (int k = 0; k < group_size; k += 16)
+                {
+                    __m128 _w0;
+                    __m128 _w1;
+                    __m128 _w2;
+                    __m128 _w3;
+                    innerproduct_weight_quant_cvt16(innerproduct_weight_quant_load16(kptr, bits), _w0, _w1, _w2, _w3);
+                    _acc0 = _mm_add_ps(_acc0, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x0), _w0), _mm_mul_ps(_mm_loadu_ps(x0 + 4), _w1)), _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x0 + 8), _w2), _mm_mul_ps(_mm_loadu_ps(x0 + 12), _w3))));
+                    _acc1 = _mm_add_ps(_acc1, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x1), _w0), _mm_mul_ps(_mm_loadu_ps(x1 + 4), _w1)), _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x1 + 8), _w2), _mm_mul_ps(_mm_loadu_ps(x1 + 12), _w3))));
+                    _acc2 = _mm_add_ps(_acc2, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x2), _w0), _mm_mul_ps(_mm_loadu_ps(x2 + 4), _w1)), _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x2 + 8), _w2), _mm_mul_ps(_mm_loadu_ps(x2 + 12), _w3))));
+                    _acc3 = _mm_add_ps(_acc3, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x3), _w0), _mm_mul_ps(_mm_loadu_ps(x3 + 4), _w1)), _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x3 + 8), _w2), _mm_mul_ps(_mm_loadu_ps(x3 + 12), _w3))));
+                    x0 += 16;
+                    x1 += 16;
+                    x2 += 16;
+                    x3 += 16;
+                    kptr += kstep;
+                }
+                __m128 _scale = _mm_set1_ps(sptr[g]);
+                _sum0 = _mm_add_ps(_sum0, _mm_mul_ps(_acc0, _scale));
+                _sum1 = _mm_add_ps(_sum1, _mm_mul_ps(_acc1, _scale));
+                _sum2 = _mm_add_ps(_sum2, _mm_mul_ps(_acc2, _scale));
+                _sum3 = _mm_add_ps(_sum3, _mm_mul_ps(_acc3, _scale));
+#else
+                float acc0 = 0.f;
+                float acc1 = 0.f;
+                float acc2 = 0.f;
+                float acc3 = 0.f;
+                for (int k = 0; k < group_size; k++)
+                {
+                    int w = bits == 4 ? (k % 16 < 8 ? kptr[k % 8] & 0x0f : kptr[k % 8] >> 4) : ((const signed char*)kptr)[k % 16];
+                    acc0 += x0[k] * w;
+                    acc1 += x1[k] * w;
+                    acc2 += x2[k] * w;
+                    acc3 += x3[k] * w;
+                    if (k % 16 == 15)
+                        kptr += kstep;
+                }
+                x0 += group_size;
+                x1 += group_size;
+                x2 += group_size;
+                x3 += group_size;
+                sum0 += acc0 * sptr[g];
+                sum1 += acc1 * sptr[g];
+                sum2 += acc2 * sptr[g];
+                sum3 += acc3 * sptr[g];
+#endif
+            }
+
+#if __AVX512F__
+            float sum0 = _mm512_comp_reduce_add_ps(_sum0);
+            float sum1 = _mm512_comp_reduce_add_ps(_sum1);
+            float sum2 = _mm512_comp_reduce_add_ps(_sum2);
+            float sum3 = _mm512_comp_reduce_add_ps(_sum3);
+#elif __AVX__
+            float sum0 = _mm256_reduce_add_ps(_sum0);
+            float sum1 = _mm256_reduce_add_ps(_sum1);
+            float sum2 = _mm256_reduce_add_ps(_sum2);
+            float sum3 = _mm256_reduce_add_ps(_sum3);
+#elif __SSE2__
+            float sum0 = _mm_reduce_add_ps(_sum0);
+            float sum1 = _mm_reduce_add_ps(_sum1);
+            float sum2 = _mm_reduce_add_ps(_sum2);
+            float sum3 = _mm_reduce_add_ps(_sum3);
+#endif
+
+            const float* xs0 = xsum.row(j);
+            const float* xs1 = xsum.row(j + 1);
+            const float* xs2 = xsum.row(j + 2);
+            const float* xs3 = xsum.row(j + 3);
+            for (int g = 0; g < num_group; g++)
+            {
+                sum0 -= optr[g] * xs0[g];
+                sum1 -= optr[g] * xs1[g];
+                sum2 -= optr[g] * xs2[g];
+                sum3 -= optr[g] * xs3[g];
+            }
+
+            top_blob.row(j)[p] = activation_ss(sum0 + bias, activation_type, activation_params);
+            top_blob.row(j + 1)[p] = activation_ss(sum1 + bias, activation_type, activation_params);
+            top_blob.row(j + 2)[p] = activation_ss(sum2 + bias, activation_type, activation_params);
+            top_blob.row(j + 3)[p] = activation_ss(sum3 + bias, activation_type, activation_params);
+        }
+        for (; j < rows; j++)
+        {
+            const unsigned char* kptr = weight_data_tm.row<const unsigned char>(p);
+            const float* x0 = bottom_blob.row(j);
+
+#if __AVX512F__
+            __m512 _sum0 = _mm512_setzero_ps();
+#elif __AVX__
+            __m256 _sum0 = _mm256_setzero_ps();
+#elif __SSE2__
+            __m128 _sum0 = _mm_setzero_ps();
+#else
+            float sum0 = 0.f;
+#endif
+
+            for (int g = 0; g < num_group; g++)
+            {
+#if __AVX512F__
+                __m512 _acc0 = _mm512_setzero_ps();
+                __m512 _acc1 = _mm512_setzero_ps();
+                int k = 0;
+                for (; k + 31 < group_size; k += 32)
+                {
+                    __m512 _w0 = innerproduct_weight_quant_cvt16(innerproduct_weight_quant_load16(kptr, bits));
+                    __m512 _w1 = innerproduct_weight_quant_cvt16(innerproduct_weight_quant_load16(kptr + kstep, bits));
+                    _acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x0), _w0, _acc0);
+                    _acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(x0 + 16), _w1, _acc1);
+                    x0 += 32;
+                    kptr += kstep * 2;
+                }
+                for (; k < group_size; k += 16)
+                {
+                    __m512 _w = innerproduct_weight_quant_cvt16(innerproduct_weight_quant_load16(kptr, bits));
+                    _acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x0), _w, _acc0);
+                    x0 += 16;
+                    kptr += kstep;
+                }
+                _sum0 = _mm512_fmadd_ps(_mm512_add_ps(_acc0, _acc1), _mm512_set1_ps(sptr[g]), _sum0);
+#elif __AVX__
+                __m256 _acc0 = _mm256_setzero_ps();
+                __m256 _acc1 = _mm256_setzero_ps();
+                for (int k = 0; k < group_size; k += 16)
+                {
+                    __m256 _w0;
+                    __m256 _w1;
+                    innerproduct_weight_quant_cvt16(innerproduct_weight_quant_load16(kptr, bits), _w0, _w1);
+                    _acc0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x0), _w0, _acc0);
+                    _acc1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x0 + 8), _w1, _acc1);
+                    x0 += 16;
+                    kptr += kstep;
+                }
+                _sum0 = _mm256_comp_fmadd_ps(_mm256_add_ps(_acc0, _acc1), _mm256_set1_ps(sptr[g]), _sum0);
+#elif __SSE2__
+                __m128 _acc0 = _mm_setzero_ps();
+                __m128 _acc1 = _mm_setzero_ps();
+                for (int k = 0; k < group_size; k += 16)
+                {
+                    __m128 _w0;
+                    __m128 _w1;
+                    __m128 _w2;
+                    __m128 _w3;
+                    innerproduct_weight_quant_cvt16(innerproduct_weight_quant_load16(kptr, bits), _w0, _w1, _w2, _w3);
+                    _acc0 = _mm_add_ps(_acc0, _mm_mul_ps(_mm_loadu_ps(x0), _w0));
+                    _acc1 = _mm_add_ps(_acc1, _mm_mul_ps(_mm_loadu_ps(x0 + 4), _w1));
+                    _acc0 = _mm_add_ps(_acc0, _mm_mul_ps(_mm_loadu_ps(x0 + 8), _w2));
+                    _acc1 = _mm_add_ps(_acc1, _mm_mul_ps(_mm_loadu_ps(x0 + 12), _w3));
+                    x0 += 16;
+                    kptr += kstep;
+                }
+                _sum0 = _mm_add_ps(_sum0, _mm_mul_ps(_mm_add_ps(_acc0, _acc1), _mm_set1_ps(sptr[g])));
+#else
+                float acc0 = 0.f;
+                for (int k = 0; k < group_size; k++)
+                {
+                    int w = bits == 4 ? (k % 16 < 8 ? kptr[k % 8] & 0x0f : kptr[k % 8] >> 4) : ((const signed char*)kptr)[k % 16];
+                    acc0 += x0[k] * w;
+                    if (k % 16 == 15)
+                        kptr += kstep;
+                }
+                x0 += group_size;
+                sum0 += acc0 * sptr[g];
+#endif
+            }
+
+#if __AVX512F__
+            float sum0 = _mm512_comp_reduce_add_ps(_sum0);
+#elif __AVX__
+            float sum0 = _mm256_reduce_add_ps(_sum0);
+#elif __SSE2__
+            float sum0 = _mm_reduce_add_ps(_sum0);
+#endif
+
+            const float* xs0 = xsum.row(j);
+            for (int g = 0; g < num_group; g++)
+            {
+                sum0 -= optr[g] * xs0[g];
+            }
+
+            top_blob.row(j)[p] = activation_ss(sum0 + bias, activation_type, activation_params);
+        }
+    }
+}
+
 InnerProduct_x86::InnerProduct_x86()
 {
 #if __SSE2__
@@ -51,6 +411,11 @@ int InnerProduct_x86::create_pipeline(const Option& opt)
         flatten->create_pipeline(opt);
     }
 
+    if (weight_quant_bits)
+    {
+        return create_pipeline_weight_quant(opt);
+    }
+
 #if NCNN_INT8
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
@@ -67,7 +432,8 @@ int InnerProduct_x86::create_pipeline(const Option& opt)
 
     const int num_input = weight_data_size / num_output;
 
-    innerproduct_transform_kernel_sse(weight_data, weight_data_tm, num_input, num_output, opt);
+    if (weight_data_tm.empty())
+        innerproduct_transform_kernel_sse(weight_data, weight_data_tm, num_input, num_output, opt);
 
     if (opt.lightmode)
         weight_data.release();
@@ -87,8 +453,20 @@ int InnerProduct_x86::destroy_pipeline(const Option& opt)
     return 0;
 }
 
+int InnerProduct_x86::get_pipeline_weights(std::vector<Mat*>& weights)
+{
+    weights.resize(1);
+    weights[0] = &weight_data_tm;
+    return 0;
+}
+
 int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (weight_quant_bits)
+    {
+        return forward_weight_quant_x86(bottom_blob, top_blob, opt);
+    }
+
 #if NCNN_INT8
     if (opt.use_int8_inference && int8_scale_term)
     {
@@ -165,7 +543,8 @@ int InnerProduct_x86::create_pipeline_fp16s(const Option& opt)
 {
     const int num_input = weight_data_size / num_output;
 
-    innerproduct_transform_kernel_fp16s_sse(weight_data, weight_data_tm, num_input, num_output, opt);
+    if (weight_data_tm.empty())
+        innerproduct_transform_kernel_fp16s_sse(weight_data, weight_data_tm, num_input, num_output, opt);
 
     if (opt.lightmode)
         weight_data.release();
@@ -229,6 +608,118 @@ int InnerProduct_x86::forward_fp16s(const Mat& bottom_blob, Mat& top_blob, const
 }
 #endif // NCNN_F16C && __AVX__
 
+int InnerProduct_x86::create_pipeline_weight_quant(const Option& opt)
+{
+    const int num_input = weight_data_size / num_output;
+    const int num_group = num_input / weight_quant_group_size;
+
+    // src = inch-outch int8
+    // dst = inch-outch int8, or inch/2-outch int4 with 16 weights in 8 bytes, low nibbles first
+    if (weight_data_tm.empty())
+    {
+        Mat weight_data_r2 = weight_data.reshape(num_input, num_output);
+
+        if (weight_quant_bits == 4)
+        {
+            weight_data_tm.create(num_input / 2, num_output, (size_t)1u);
+            if (weight_data_tm.empty())
+                return -100;
+
+            for (int p = 0; p < num_output; p++)
+            {
+                const signed char* k0 = weight_data_r2.row<const signed char>(p);
+                unsigned char* g0 = weight_data_tm.row<unsigned char>(p);
+
+                for (int i = 0; i < num_input; i += 16)
+                {
+                    for (int j = 0; j < 8; j++)
+                    {
+                        // store as unsigned, the +8 goes into the zero point
+                        g0[j] = (unsigned char)((k0[j] + 8) | ((k0[j + 8] + 8) << 4));
+                    }
+
+                    k0 += 16;
+                    g0 += 8;
+                }
+            }
+        }
+        else
+        {
+            weight_data_tm = weight_data_r2.clone();
+            if (weight_data_tm.empty())
+                return -100;
+        }
+    }
+
+    // sum((q - zero) * scale * x) = scale * sum(q * x) - scale * zero * sum(x)
+    weight_quant_offsets_tm.create(num_group, num_output);
+    if (weight_quant_offsets_tm.empty())
+        return -100;
+
+    for (int p = 0; p < num_output; p++)
+    {
+        const float* sptr = weight_quant_scales.row(p);
+        const float* zptr = weight_quant_zeros.row(p);
+        float* optr = weight_quant_offsets_tm.row(p);
+
+        for (int g = 0; g < num_group; g++)
+        {
+            optr[g] = sptr[g] * (weight_quant_bits == 4 ? zptr[g] + 8 : zptr[g]);
+        }
+    }
+
+    if (opt.lightmode)
+    {
+        weight_data.release();
+        weight_quant_zeros.release();
+    }
+
+    return 0;
+}
+
+int InnerProduct_x86::forward_weight_quant_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    Option opt_unpack = opt;
+    opt_unpack.blob_allocator = opt.workspace_allocator;
+    opt_unpack.use_packing_layout = false;
+
+    Mat bottom_blob_unpacked;
+    convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_unpack);
+    if (bottom_blob_unpacked.empty())
+        return -100;
+
+    if (bottom_blob_unpacked.dims == 2 && bottom_blob_unpacked.w == num_input)
+    {
+        // gemm
+        top_blob.create(num_output, bottom_blob_unpacked.h, 4u, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        innerproduct_weight_quant_sse(bottom_blob_unpacked, top_blob, weight_data_tm, weight_quant_scales, weight_quant_offsets_tm, bias_data, weight_quant_bits, weight_quant_group_size, activation_type, activation_params, opt);
+
+        return 0;
+    }
+
+    // flatten
+    Mat bottom_blob_flattened = bottom_blob_unpacked;
+    if (bottom_blob_unpacked.dims != 1)
+    {
+        flatten->forward(bottom_blob_unpacked, bottom_blob_flattened, opt_unpack);
+        if (bottom_blob_flattened.empty())
+            return -100;
+    }
+
+    top_blob.create(num_output, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    innerproduct_weight_quant_sse(bottom_blob_flattened, top_blob, weight_data_tm, weight_quant_scales, weight_quant_offsets_tm, bias_data, weight_quant_bits, weight_quant_group_size, activation_type, activation_params, opt);
+
+    return 0;
+}
+
 #if NCNN_INT8
 int InnerProduct_x86::create_pipeline_int8_x86(const Option& opt)
 {
@@ -244,6 +735,7 @@ int InnerProduct_x86::create_pipeline_int8_x86(const Option& opt)
 
     // src = inch-outch
     // dst = pb-inch-outch/pb
+    if (weight_data_tm.empty())
     {
         Mat weight_data_r2 = weight_data.reshape(num_input, num_output);
 
@@ -32,15 +32,31 @@ namespace ncnn {
 #endif // __AVX__
 #endif // __SSE2__
 
+#if NCNN_BF16
+#include "x86_bf16s.h"
+#endif // NCNN_BF16
+
 Interp_x86::Interp_x86()
 {
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_blobs[0].elembits() == 16)
+    {
+        // size expression may read the channel count
+        return layer_forward_bf16s(this, bottom_blobs, top_blobs, size_expr.empty(), opt);
+    }
+#endif
+
     const Mat& bottom_blob = bottom_blobs[0];
     const Mat& reference_blob = bottom_blobs[1];
     Mat& top_blob = top_blobs[0];
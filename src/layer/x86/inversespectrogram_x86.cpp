@@ -0,0 +1,486 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "inversespectrogram_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#include <math.h>
+
+namespace ncnn {
+
+InverseSpectrogram_x86::InverseSpectrogram_x86()
+{
+}
+
+// factor n into stockham stages, radix 4 and 2 first, then odd factors
+// each stage stores m * r twiddles w^(p*k) of its length n followed by the r roots of unity of the radix
+static void inversespectrogram_fft_plan(int n, int inverse, std::vector<int>& radix, Mat& twiddles)
+{
+    radix.clear();
+
+    int t = n;
+    while (t % 4 == 0)
+    {
+        radix.push_back(4);
+        t /= 4;
+    }
+    while (t % 2 == 0)
+    {
+        radix.push_back(2);
+        t /= 2;
+    }
+    for (int f = 3; f <= t; f += 2)
+    {
+        while (t % f == 0)
+        {
+            radix.push_back(f);
+            t /= f;
+        }
+    }
+
+    const double sign = inverse ? 1.0 : -1.0;
+
+    int twiddles_size = 0;
+    {
+        int len = n;
+        for (size_t i = 0; i < radix.size(); i++)
+        {
+            twiddles_size += (len + radix[i]) * 2;
+            len /= radix[i];
+        }
+    }
+
+    twiddles.create(twiddles_size > 0 ? twiddles_size : 1);
+
+    float* ptr = twiddles;
+    int len = n;
+    for (size_t i = 0; i < radix.size(); i++)
+    {
+        const int r = radix[i];
+        const int m = len / r;
+
+        for (int p = 0; p < m; p++)
+        {
+            for (int k = 0; k < r; k++)
+            {
+                const double angle = sign * 2 * 3.14159265358979323846 * p * k / len;
+                ptr[0] = (float)cos(angle);
+                ptr[1] = (float)sin(angle);
+                ptr += 2;
+            }
+        }
+
+        for (int k = 0; k < r; k++)
+        {
+            const double angle = sign * 2 * 3.14159265358979323846 * k / r;
+            ptr[0] = (float)cos(angle);
+            ptr[1] = (float)sin(angle);
+            ptr += 2;
+        }
+
+        len = m;
+    }
+}
+
+#if __SSE2__
+// stockham autosort fft over 4 frames at once
+// x and y hold n complex values, each as 4 re lanes followed by 4 im lanes
+// returns the buffer holding the result in natural order
+static float* inversespectrogram_fft_pack4(float* x, float* y, int n, const std::vector<int>& radix, const Mat& twiddles, int inverse)
+{
+    const float* tw = twiddles;
+
+    int len = n;
+    int s = 1;
+    for (size_t st = 0; st < radix.size(); st++)
+    {
+        const int r = radix[st];
+        const int m = len / r;
+
+        const float* wp = tw;
+        const float* wr = tw + m * r * 2;
+        tw += (len + r) * 2;
+
+        for (int p = 0; p < m; p++)
+        {
+            for (int q = 0; q < s; q++)
+            {
+                const float* a = x + (q + s * p) * 8;
+                float* b = y + (q + s * r * p) * 8;
+
+                const int astep = s * m * 8;
+                const int bstep = s * 8;
+
+                if (r == 2)
+                {
+                    __m128 _a0r = _mm_load_ps(a);
+                    __m128 _a0i = _mm_load_ps(a + 4);
+                    __m128 _a1r = _mm_load_ps(a + astep);
+                    __m128 _a1i = _mm_load_ps(a + astep + 4);
+
+                    _mm_store_ps(b, _mm_add_ps(_a0r, _a1r));
+                    _mm_store_ps(b + 4, _mm_add_ps(_a0i, _a1i));
+                    _mm_store_ps(b + bstep, _mm_sub_ps(_a0r, _a1r));
+                    _mm_store_ps(b + bstep + 4, _mm_sub_ps(_a0i, _a1i));
+                }
+                else if (r == 4)
+                {
+                    __m128 _a0r = _mm_load_ps(a);
+                    __m128 _a0i = _mm_load_ps(a + 4);
+                    __m128 _a1r = _mm_load_ps(a + astep);
+                    __m128 _a1i = _mm_load_ps(a + astep + 4);
+                    __m128 _a2r = _mm_load_ps(a + astep * 2);
+                    __m128 _a2i = _mm_load_ps(a + astep * 2 + 4);
+                    __m128 _a3r = _mm_load_ps(a + astep * 3);
+                    __m128 _a3i = _mm_load_ps(a + astep * 3 + 4);
+
+                    __m128 _t0r = _mm_add_ps(_a0r, _a2r);
+                    __m128 _t0i = _mm_add_ps(_a0i, _a2i);
+                    __m128 _t1r = _mm_sub_ps(_a0r, _a2r);
+                    __m128 _t1i = _mm_sub_ps(_a0i, _a2i);
+                    __m128 _t2r = _mm_add_ps(_a1r, _a3r);
+                    __m128 _t2i = _mm_add_ps(_a1i, _a3i);
+                    __m128 _t3r = _mm_sub_ps(_a1r, _a3r);
+                    __m128 _t3i = _mm_sub_ps(_a1i, _a3i);
+
+                    _mm_store_ps(b, _mm_add_ps(_t0r, _t2r));
+                    _mm_store_ps(b + 4, _mm_add_ps(_t0i, _t2i));
+                    _mm_store_ps(b + bstep * 2, _mm_sub_ps(_t0r, _t2r));
+                    _mm_store_ps(b + bstep * 2 + 4, _mm_sub_ps(_t0i, _t2i));
+
+                    // forward multiplies t3 by -i, inverse by +i
+                    __m128 _b1r = inverse ? _mm_sub_ps(_t1r, _t3i) : _mm_add_ps(_t1r, _t3i);
+                    __m128 _b1i = inverse ? _mm_add_ps(_t1i, _t3r) : _mm_sub_ps(_t1i, _t3r);
+                    __m128 _b3r = inverse ? _mm_add_ps(_t1r, _t3i) : _mm_sub_ps(_t1r, _t3i);
+                    __m128 _b3i = inverse ? _mm_sub_ps(_t1i, _t3r) : _mm_add_ps(_t1i, _t3r);
+
+                    _mm_store_ps(b + bstep, _b1r);
+                    _mm_store_ps(b + bstep + 4, _b1i);
+                    _mm_store_ps(b + bstep * 3, _b3r);
+                    _mm_store_ps(b + bstep * 3 + 4, _b3i);
+                }
+                else
+                {
+                    // generic odd radix dft
+                    for (int k = 0; k < r; k++)
+                    {
+                        __m128 _sumr = _mm_setzero_ps();
+                        __m128 _sumi = _mm_setzero_ps();
+                        for (int j = 0; j < r; j++)
+                        {
+                            const float* w = wr + (j * k % r) * 2;
+                            __m128 _wr = _mm_set1_ps(w[0]);
+                            __m128 _wi = _mm_set1_ps(w[1]);
+                            __m128 _ar = _mm_load_ps(a + astep * j);
+                            __m128 _ai = _mm_load_ps(a + astep * j + 4);
+                            _sumr = _mm_add_ps(_sumr, _mm_sub_ps(_mm_mul_ps(_ar, _wr), _mm_mul_ps(_ai, _wi)));
+                            _sumi = _mm_add_ps(_sumi, _mm_add_ps(_mm_mul_ps(_ar, _wi), _mm_mul_ps(_ai, _wr)));
+                        }
+                        _mm_store_ps(b + bstep * k, _sumr);
+                        _mm_store_ps(b + bstep * k + 4, _sumi);
+                    }
+                }
+
+                // twiddle
+                if (p > 0)
+                {
+                    for (int k = 1; k < r; k++)
+                    {
+                        const float* w = wp + (p * r + k) * 2;
+                        __m128 _wr = _mm_set1_ps(w[0]);
+                        __m128 _wi = _mm_set1_ps(w[1]);
+                        __m128 _br = _mm_load_ps(b + bstep * k);
+                        __m128 _bi = _mm_load_ps(b + bstep * k + 4);
+                        _mm_store_ps(b + bstep * k, _mm_sub_ps(_mm_mul_ps(_br, _wr), _mm_mul_ps(_bi, _wi)));
+                        _mm_store_ps(b + bstep * k + 4, _mm_add_ps(_mm_mul_ps(_br, _wi), _mm_mul_ps(_bi, _wr)));
+                    }
+                }
+            }
+        }
+
+        std::swap(x, y);
+        len = m;
+        s *= r;
+    }
+
+    return x;
+}
+#endif // __SSE2__
+
+int InverseSpectrogram_x86::create_pipeline(const Option& /*opt*/)
+{
+    inversespectrogram_fft_plan(n_fft, 1, fft_radix, fft_twiddles);
+
+    return 0;
+}
+
+int InverseSpectrogram_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if __SSE2__
+    const int frames = bottom_blob.h;
+
+    const int outsize = center ? (frames - 1) * hoplen + (n_fft - n_fft / 2 * 2) : (frames - 1) * hoplen + n_fft;
+
+    const size_t elemsize = bottom_blob.elemsize;
+
+    Mat signal;
+    Mat window_sumsquare;
+    int ret = overlap_add_x86(bottom_blob, signal, window_sumsquare, opt);
+    if (ret != 0)
+        return ret;
+
+    if (returns == 0)
+    {
+        top_blob.create(2, outsize, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(outsize, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    const int offset = center == 1 ? n_fft / 2 : 0;
+
+    // square window norm
+    for (int i = 0; i < outsize; i++)
+    {
+        const float* ptr = signal.row(i + offset);
+        const float wss = window_sumsquare[i + offset];
+
+        float re = ptr[0];
+        float im = ptr[1];
+        if (wss != 0.f)
+        {
+            re /= wss;
+            im /= wss;
+        }
+
+        if (returns == 0)
+        {
+            top_blob.row(i)[0] = re;
+            top_blob.row(i)[1] = im;
+        }
+        if (returns == 1)
+        {
+            top_blob[i] = re;
+        }
+        if (returns == 2)
+        {
+            top_blob[i] = im;
+        }
+    }
+
+    return 0;
+#else
+    return InverseSpectrogram::forward(bottom_blob, top_blob, opt);
+#endif // __SSE2__
+}
+
+int InverseSpectrogram_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (bottom_blobs.size() == 1)
+    {
+        return forward(bottom_blobs[0], top_blobs[0], opt);
+    }
+
+#if __SSE2__
+    // streaming, bottom_blobs[1] holds the pending overlap as (re, im, window square) x (n_fft - hoplen)
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& cache = bottom_blobs[1];
+    const size_t elemsize = bottom_blob.elemsize;
+
+    const int frames = bottom_blob.h;
+    const int overlap = n_fft - hoplen;
+    if (overlap <= 0 || cache.w != 3 || cache.h != overlap)
+    {
+        NCNN_LOGE("InverseSpectrogram streaming needs hoplen < n_fft and a 3 x %d overlap cache", overlap);
+        return -1;
+    }
+
+    Mat signal;
+    Mat window_sumsquare;
+    int ret = overlap_add_x86(bottom_blob, signal, window_sumsquare, opt);
+    if (ret != 0)
+        return ret;
+
+    for (int i = 0; i < overlap; i++)
+    {
+        const float* ptr = cache.row(i);
+        signal.row(i)[0] += ptr[0];
+        signal.row(i)[1] += ptr[1];
+        window_sumsquare[i] += ptr[2];
+    }
+
+    // every frame that touches the first frames * hoplen samples has arrived
+    const int outsize = frames * hoplen;
+
+    Mat& top_blob = top_blobs[0];
+    if (returns == 0)
+    {
+        top_blob.create(2, outsize, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(outsize, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    for (int i = 0; i < outsize; i++)
+    {
+        const float* ptr = signal.row(i);
+        const float wss = window_sumsquare[i];
+
+        float re = ptr[0];
+        float im = ptr[1];
+        if (wss != 0.f)
+        {
+            re /= wss;
+            im /= wss;
+        }
+
+        if (returns == 0)
+        {
+            top_blob.row(i)[0] = re;
+            top_blob.row(i)[1] = im;
+        }
+        if (returns == 1)
+        {
+            top_blob[i] = re;
+        }
+        if (returns == 2)
+        {
+            top_blob[i] = im;
+        }
+    }
+
+    Mat& top_cache = top_blobs[1];
+    top_cache.create(3, overlap, elemsize, opt.blob_allocator);
+    if (top_cache.empty())
+        return -100;
+
+    for (int i = 0; i < overlap; i++)
+    {
+        float* outptr = top_cache.row(i);
+        outptr[0] = signal.row(outsize + i)[0];
+        outptr[1] = signal.row(outsize + i)[1];
+        outptr[2] = window_sumsquare[outsize + i];
+    }
+
+    return 0;
+#else
+    return InverseSpectrogram::forward(bottom_blobs, top_blobs, opt);
+#endif // __SSE2__
+}
+
+int InverseSpectrogram_x86::overlap_add_x86(const Mat& bottom_blob, Mat& signal, Mat& window_sumsquare, const Option& opt) const
+{
+#if __SSE2__
+    const int frames = bottom_blob.h;
+    const int freqs = bottom_blob.c;
+    // assert freqs == n_fft or freqs == n_fft / 2 + 1
+
+    const int onesided = freqs == n_fft / 2 + 1 ? 1 : 0;
+
+    const int size = (frames - 1) * hoplen + n_fft;
+
+    const size_t elemsize = bottom_blob.elemsize;
+
+    // inverse fft of every frame, re im interleaved
+    Mat frames_ifft(n_fft * 2, frames, elemsize, opt.workspace_allocator);
+    if (frames_ifft.empty())
+        return -100;
+
+    float norm = 1.f / n_fft;
+    if (normalized == 1)
+        norm = sqrt(n_fft) / n_fft;
+    if (normalized == 2)
+        norm = window_data[n_fft] / n_fft;
+
+    const int nn_frames = (frames + 3) / 4;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int jj = 0; jj < nn_frames; jj++)
+    {
+        const int j = jj * 4;
+        const int count = std::min(frames - j, 4);
+
+        Mat tmp(n_fft * 8, 2, 4u, opt.workspace_allocator);
+
+        // collect complex, one frame per lane
+        float* x = tmp.row(0);
+        for (int k = 0; k < n_fft; k++)
+        {
+            const int conj = onesided == 1 && k > n_fft / 2;
+            const float* ptr = bottom_blob.channel(conj ? n_fft - k : k).row(j);
+
+            for (int l = 0; l < 4; l++)
+            {
+                x[k * 8 + l] = l < count ? ptr[l * 2] : 0.f;
+                x[k * 8 + 4 + l] = l < count ? (conj ? -ptr[l * 2 + 1] : ptr[l * 2 + 1]) : 0.f;
+            }
+        }
+
+        const float* X = inversespectrogram_fft_pack4(tmp.row(0), tmp.row(1), n_fft, fft_radix, fft_twiddles, 1);
+
+        __m128 _norm = _mm_set1_ps(norm);
+
+        for (int i = 0; i < n_fft; i++)
+        {
+            float re[4];
+            float im[4];
+            _mm_storeu_ps(re, _mm_mul_ps(_mm_load_ps(X + i * 8), _norm));
+            _mm_storeu_ps(im, _mm_mul_ps(_mm_load_ps(X + i * 8 + 4), _norm));
+
+            for (int l = 0; l < count; l++)
+            {
+                float* outptr = frames_ifft.row(j + l);
+                outptr[i * 2] = re[l];
+                outptr[i * 2 + 1] = im[l];
+            }
+        }
+    }
+
+    signal.create(2, size, elemsize, opt.workspace_allocator);
+    if (signal.empty())
+        return -100;
+
+    window_sumsquare.create(size, elemsize, opt.workspace_allocator);
+    if (window_sumsquare.empty())
+        return -100;
+
+    signal.fill(0.f);
+    window_sumsquare.fill(0.f);
+
+    // overlap add, apply window
+    for (int j = 0; j < frames; j++)
+    {
+        const float* ptr = frames_ifft.row(j);
+        float* outptr = signal.row(j * hoplen);
+        float* wssptr = (float*)window_sumsquare + j * hoplen;
+
+        for (int i = 0; i < n_fft; i++)
+        {
+            const float wi = window_data[i];
+
+            outptr[0] += ptr[0] * wi;
+            outptr[1] += ptr[1] * wi;
+            wssptr[0] += wi * wi;
+
+            ptr += 2;
+            outptr += 2;
+            wssptr += 1;
+        }
+    }
+
+    return 0;
+#else
+    return InverseSpectrogram::overlap_add(bottom_blob, signal, window_sumsquare, opt);
+#endif // __SSE2__
+}
+
+} // namespace ncnn
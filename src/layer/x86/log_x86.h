@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_LOG_X86_H
+#define LAYER_LOG_X86_H
+
+#include "log.h"
+
+namespace ncnn {
+
+class Log_x86 : public Log
+{
+public:
+    Log_x86();
+
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_LOG_X86_H
@@ -5,8 +5,542 @@
 
 #include "layer_type.h"
 
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+#include "cpu.h"
+
+#include <float.h>
+
 namespace ncnn {
 
+// query rows and key columns processed per attention tile
+#define FLASH_ATTENTION_TILE_Q 8
+#define FLASH_ATTENTION_TILE_K 64
+
+// s = exp(s - max), returns sum(s)
+static float flash_attention_exp_sum(float* s, float max, int n)
+{
+    float sum = 0.f;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _max512 = _mm512_set1_ps(max);
+    __m512 _sum512 = _mm512_setzero_ps();
+    for (; i + 15 < n; i += 16)
+    {
+        __m512 _p = exp512_ps(_mm512_sub_ps(_mm512_loadu_ps(s + i), _max512));
+        _mm512_storeu_ps(s + i, _p);
+        _sum512 = _mm512_add_ps(_sum512, _p);
+    }
+    sum += _mm512_comp_reduce_add_ps(_sum512);
+#endif // __AVX512F__
+    __m256 _max256 = _mm256_set1_ps(max);
+    __m256 _sum256 = _mm256_setzero_ps();
+    for (; i + 7 < n; i += 8)
+    {
+        __m256 _p = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(s + i), _max256));
+        _mm256_storeu_ps(s + i, _p);
+        _sum256 = _mm256_add_ps(_sum256, _p);
+    }
+    sum += _mm256_reduce_add_ps(_sum256);
+#endif // __AVX__
+    __m128 _max128 = _mm_set1_ps(max);
+    __m128 _sum128 = _mm_setzero_ps();
+    for (; i + 3 < n; i += 4)
+    {
+        __m128 _p = exp_ps(_mm_sub_ps(_mm_loadu_ps(s + i), _max128));
+        _mm_storeu_ps(s + i, _p);
+        _sum128 = _mm_add_ps(_sum128, _p);
+    }
+    sum += _mm_reduce_add_ps(_sum128);
+#endif // __SSE2__
+    for (; i < n; i++)
+    {
+        s[i] = expf(s[i] - max);
+        sum += s[i];
+    }
+
+    return sum;
+}
+
+// s[r][kj] = mask[r][kj] + sum_d q[d][r] * k[d][kj] for 4 query rows
+static void flash_attention_qk_4(const float* qptr, const float* kptr, int qstride, int kstride, int dh, const int* qcols, const float* const* maskptrs, float* const* sptrs, int max_kj)
+{
+    const int qc0 = qcols[0];
+    const int qc1 = qcols[1];
+    const int qc2 = qcols[2];
+    const int qc3 = qcols[3];
+
+    int kj = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; kj + 15 < max_kj; kj += 16)
+    {
+        __m512 _s0 = maskptrs[0] ? _mm512_loadu_ps(maskptrs[0] + kj) : _mm512_setzero_ps();
+        __m512 _s1 = maskptrs[1] ? _mm512_loadu_ps(maskptrs[1] + kj) : _mm512_setzero_ps();
+        __m512 _s2 = maskptrs[2] ? _mm512_loadu_ps(maskptrs[2] + kj) : _mm512_setzero_ps();
+        __m512 _s3 = maskptrs[3] ? _mm512_loadu_ps(maskptrs[3] + kj) : _mm512_setzero_ps();
+
+        const float* q = qptr;
+        const float* k = kptr + kj;
+        for (int d = 0; d < dh; d++)
+        {
+            __m512 _k = _mm512_loadu_ps(k);
+            _s0 = _mm512_fmadd_ps(_mm512_set1_ps(q[qc0]), _k, _s0);
+            _s1 = _mm512_fmadd_ps(_mm512_set1_ps(q[qc1]), _k, _s1);
+            _s2 = _mm512_fmadd_ps(_mm512_set1_ps(q[qc2]), _k, _s2);
+            _s3 = _mm512_fmadd_ps(_mm512_set1_ps(q[qc3]), _k, _s3);
+            q += qstride;
+            k += kstride;
+        }
+
+        _mm512_storeu_ps(sptrs[0] + kj, _s0);
+        _mm512_storeu_ps(sptrs[1] + kj, _s1);
+        _mm512_storeu_ps(sptrs[2] + kj, _s2);
+        _mm512_storeu_ps(sptrs[3] + kj, _s3);
+    }
+#endif // __AVX512F__
+    for (; kj + 7 < max_kj; kj += 8)
+    {
+        __m256 _s0 = maskptrs[0] ? _mm256_loadu_ps(maskptrs[0] + kj) : _mm256_setzero_ps();
+        __m256 _s1 = maskptrs[1] ? _mm256_loadu_ps(maskptrs[1] + kj) : _mm256_setzero_ps();
+        __m256 _s2 = maskptrs[2] ? _mm256_loadu_ps(maskptrs[2] + kj) : _mm256_setzero_ps();
+        __m256 _s3 = maskptrs[3] ? _mm256_loadu_ps(maskptrs[3] + kj) : _mm256_setzero_ps();
+
+        const float* q = qptr;
+        const float* k = kptr + kj;
+        for (int d = 0; d < dh; d++)
+        {
+            __m256 _k = _mm256_loadu_ps(k);
+            _s0 = _mm256_comp_fmadd_ps(_mm256_set1_ps(q[qc0]), _k, _s0);
+            _s1 = _mm256_comp_fmadd_ps(_mm256_set1_ps(q[qc1]), _k, _s1);
+            _s2 = _mm256_comp_fmadd_ps(_mm256_set1_ps(q[qc2]), _k, _s2);
+            _s3 = _mm256_comp_fmadd_ps(_mm256_set1_ps(q[qc3]), _k, _s3);
+            q += qstride;
+            k += kstride;
+        }
+
+        _mm256_storeu_ps(sptrs[0] + kj, _s0);
+        _mm256_storeu_ps(sptrs[1] + kj, _s1);
+        _mm256_storeu_ps(sptrs[2] + kj, _s2);
+        _mm256_storeu_ps(sptrs[3] + kj, _s3);
+    }
+#endif // __AVX__
+    for (; kj + 3 < max_kj; kj += 4)
+    {
+        __m128 _s0 = maskptrs[0] ? _mm_loadu_ps(maskptrs[0] + kj) : _mm_setzero_ps();
+        __m128 _s1 = maskptrs[1] ? _mm_loadu_ps(maskptrs[1] + kj) : _mm_setzero_ps();
+        __m128 _s2 = maskptrs[2] ? _mm_loadu_ps(maskptrs[2] + kj) : _mm_setzero_ps();
+        __m128 _s3 = maskptrs[3] ? _mm_loadu_ps(maskptrs[3] + kj) : _mm_setzero_ps();
+
+        const float* q = qptr;
+        const float* k = kptr + kj;
+        for (int d = 0; d < dh; d++)
+        {
+            __m128 _k = _mm_loadu_ps(k);
+            _s0 = _mm_comp_fmadd_ps(_mm_set1_ps(q[qc0]), _k, _s0);
+            _s1 = _mm_comp_fmadd_ps(_mm_set1_ps(q[qc1]), _k, _s1);
+            _s2 = _mm_comp_fmadd_ps(_mm_set1_ps(q[qc2]), _k, _s2);
+            _s3 = _mm_comp_fmadd_ps(_mm_set1_ps(q[qc3]), _k, _s3);
+            q += qstride;
+            k += kstride;
+        }
+
+        _mm_storeu_ps(sptrs[0] + kj, _s0);
+        _mm_storeu_ps(sptrs[1] + kj, _s1);
+        _mm_storeu_ps(sptrs[2] + kj, _s2);
+        _mm_storeu_ps(sptrs[3] + kj, _s3);
+    }
+#endif // __SSE2__
+    for (; kj < max_kj; kj++)
+    {
+        float s0 = maskptrs[0] ? maskptrs[0][kj] : 0.f;
+        float s1 = maskptrs[1] ? maskptrs[1][kj] : 0.f;
+        float s2 = maskptrs[2] ? maskptrs[2][kj] : 0.f;
+        float s3 = maskptrs[3] ? maskptrs[3][kj] : 0.f;
+
+        const float* q = qptr;
+        const float* k = kptr + kj;
+        for (int d = 0; d < dh; d++)
+        {
+            s0 += q[qc0] * k[0];
+            s1 += q[qc1] * k[0];
+            s2 += q[qc2] * k[0];
+            s3 += q[qc3] * k[0];
+            q += qstride;
+            k += kstride;
+        }
+
+        sptrs[0][kj] = s0;
+        sptrs[1][kj] = s1;
+        sptrs[2][kj] = s2;
+        sptrs[3][kj] = s3;
+    }
+}
+
+// s[kj] = mask[kj] + sum_d q[d] * k[kj][d] for one query row, k one token per row
+static void flash_attention_qk_1(const float* qptr, const float* kptr, int kstride, int dh, const float* maskptr, float* sptr, int max_kj)
+{
+    int kj = 0;
+    for (; kj + 3 < max_kj; kj += 4)
+    {
+        const float* k0 = kptr + kj * kstride;
+        const float* k1 = k0 + kstride;
+        const float* k2 = k1 + kstride;
+        const float* k3 = k2 + kstride;
+
+        float s0 = 0.f;
+        float s1 = 0.f;
+        float s2 = 0.f;
+        float s3 = 0.f;
+
+        int d = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        if (d + 15 < dh)
+        {
+            __m512 _s0 = _mm512_setzero_ps();
+            __m512 _s1 = _mm512_setzero_ps();
+            __m512 _s2 = _mm512_setzero_ps();
+            __m512 _s3 = _mm512_setzero_ps();
+            for (; d + 15 < dh; d += 16)
+            {
+                __m512 _q = _mm512_loadu_ps(qptr + d);
+                _s0 = _mm512_fmadd_ps(_q, _mm512_loadu_ps(k0 + d), _s0);
+                _s1 = _mm512_fmadd_ps(_q, _mm512_loadu_ps(k1 + d), _s1);
+                _s2 = _mm512_fmadd_ps(_q, _mm512_loadu_ps(k2 + d), _s2);
+                _s3 = _mm512_fmadd_ps(_q, _mm512_loadu_ps(k3 + d), _s3);
+            }
+            s0 += _mm512_comp_reduce_add_ps(_s0);
+            s1 += _mm512_comp_reduce_add_ps(_s1);
+            s2 += _mm512_comp_reduce_add_ps(_s2);
+            s3 += _mm512_comp_reduce_add_ps(_s3);
+        }
+#endif // __AVX512F__
+        if (d + 7 < dh)
+        {
+            __m256 _s0 = _mm256_setzero_ps();
+            __m256 _s1 = _mm256_setzero_ps();
+            __m256 _s2 = _mm256_setzero_ps();
+            __m256 _s3 = _mm256_setzero_ps();
+            for (; d + 7 < dh; d += 8)
+            {
+                __m256 _q = _mm256_loadu_ps(qptr + d);
+                _s0 = _mm256_comp_fmadd_ps(_q, _mm256_loadu_ps(k0 + d), _s0);
+                _s1 = _mm256_comp_fmadd_ps(_q, _mm256_loadu_ps(k1 + d), _s1);
+                _s2 = _mm256_comp_fmadd_ps(_q, _mm256_loadu_ps(k2 + d), _s2);
+                _s3 = _mm256_comp_fmadd_ps(_q, _mm256_loadu_ps(k3 + d), _s3);
+            }
+            s0 += _mm256_reduce_add_ps(_s0);
+            s1 += _mm256_reduce_add_ps(_s1);
+            s2 += _mm256_reduce_add_ps(_s2);
+            s3 += _mm256_reduce_add_ps(_s3);
+        }
+#endif // __AVX__
+        if (d + 3 < dh)
+        {
+            __m128 _s0 = _mm_setzero_ps();
+            __m128 _s1 = _mm_setzero_ps();
+            __m128 _s2 = _mm_setzero_ps();
+            __m128 _s3 = _mm_setzero_ps();
+            for (; d + 3 < dh; d += 4)
+            {
+                __m128 _q = _mm_loadu_ps(qptr + d);
+                _s0 = _mm_comp_fmadd_ps(_q, _mm_loadu_ps(k0 + d), _s0);
+                _s1 = _mm_comp_fmadd_ps(_q, _mm_loadu_ps(k1 + d), _s1);
+                _s2 = _mm_comp_fmadd_ps(_q, _mm_loadu_ps(k2 + d), _s2);
+                _s3 = _mm_comp_fmadd_ps(_q, _mm_loadu_ps(k3 + d), _s3);
+            }
+            s0 += _mm_reduce_add_ps(_s0);
+            s1 += _mm_reduce_add_ps(_s1);
+            s2 += _mm_reduce_add_ps(_s2);
+            s3 += _mm_reduce_add_ps(_s3);
+        }
+#endif // __SSE2__
+        for (; d < dh; d++)
+        {
+            s0 += qptr[d] * k0[d];
+            s1 += qptr[d] * k1[d];
+            s2 += qptr[d] * k2[d];
+            s3 += qptr[d] * k3[d];
+        }
+
+        sptr[kj] = maskptr ? maskptr[kj] + s0 : s0;
+        sptr[kj + 1] = maskptr ? maskptr[kj + 1] + s1 : s1;
+        sptr[kj + 2] = maskptr ? maskptr[kj + 2] + s2 : s2;
+        sptr[kj + 3] = maskptr ? maskptr[kj + 3] + s3 : s3;
+    }
+    for (; kj < max_kj; kj++)
+    {
+        const float* k = kptr + kj * kstride;
+
+        float s = maskptr ? maskptr[kj] : 0.f;
+        for (int d = 0; d < dh; d++)
+        {
+            s += qptr[d] * k[d];
+        }
+
+        sptr[kj] = s;
+    }
+}
+
+// acc[r][d] += sum_kj p[r][kj] * vt[kj][d] for 4 query rows
+static void flash_attention_pv_4(const float* vtptr, int vtstride, int dh, const float* const* pptrs, float* const* accptrs, int max_kj)
+{
+    const float* p0 = pptrs[0];
+    const float* p1 = pptrs[1];
+    const float* p2 = pptrs[2];
+    const float* p3 = pptrs[3];
+
+    int d = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; d + 15 < dh; d += 16)
+    {
+        __m512 _a0 = _mm512_loadu_ps(accptrs[0] + d);
+        __m512 _a1 = _mm512_loadu_ps(accptrs[1] + d);
+        __m512 _a2 = _mm512_loadu_ps(accptrs[2] + d);
+        __m512 _a3 = _mm512_loadu_ps(accptrs[3] + d);
+
+        const float* v = vtptr + d;
+        for (int kj = 0; kj < max_kj; kj++)
+        {
+            __m512 _v = _mm512_loadu_ps(v);
+            _a0 = _mm512_fmadd_ps(_mm512_set1_ps(p0[kj]), _v, _a0);
+            _a1 = _mm512_fmadd_ps(_mm512_set1_ps(p1[kj]), _v, _a1);
+            _a2 = _mm512_fmadd_ps(_mm512_set1_ps(p2[kj]), _v, _a2);
+            _a3 = _mm512_fmadd_ps(_mm512_set1_ps(p3[kj]), _v, _a3);
+            v += vtstride;
+        }
+
+        _mm512_storeu_ps(accptrs[0] + d, _a0);
+        _mm512_storeu_ps(accptrs[1] + d, _a1);
+        _mm512_storeu_ps(accptrs[2] + d, _a2);
+        _mm512_storeu_ps(accptrs[3] + d, _a3);
+    }
+#endif // __AVX512F__
+    for (; d + 7 < dh; d += 8)
+    {
+        __m256 _a0 = _mm256_loadu_ps(accptrs[0] + d);
+        __m256 _a1 = _mm256_loadu_ps(accptrs[1] + d);
+        __m256 _a2 = _mm256_loadu_ps(accptrs[2] + d);
+        __m256 _a3 = _mm256_loadu_ps(accptrs[3] + d);
+
+        const float* v = vtptr + d;
+        for (int kj = 0; kj < max_kj; kj++)
+        {
+            __m256 _v = _mm256_loadu_ps(v);
+            _a0 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p0[kj]), _v, _a0);
+            _a1 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p1[kj]), _v, _a1);
+            _a2 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p2[kj]), _v, _a2);
+            _a3 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p3[kj]), _v, _a3);
+            v += vtstride;
+        }
+
+        _mm256_storeu_ps(accptrs[0] + d, _a0);
+        _mm256_storeu_ps(accptrs[1] + d, _a1);
+        _mm256_storeu_ps(accptrs[2] + d, _a2);
+        _mm256_storeu_ps(accptrs[3] + d, _a3);
+    }
+#endif // __AVX__
+    for (; d + 3 < dh; d += 4)
+    {
+        __m128 _a0 = _mm_loadu_ps(accptrs[0] + d);
+        __m128 _a1 = _mm_loadu_ps(accptrs[1] + d);
+        __m128 _a2 = _mm_loadu_ps(accptrs[2] + d);
+        __m128 _a3 = _mm_loadu_ps(accptrs[3] + d);
+
+        const float* v = vtptr + d;
+        for (int kj = 0; kj < max_kj; kj++)
+        {
+            __m128 _v = _mm_loadu_ps(v);
+            _a0 = _mm_comp_fmadd_ps(_mm_set1_ps(p0[kj]), _v, _a0);
+            _a1 = _mm_comp_fmadd_ps(_mm_set1_ps(p1[kj]), _v, _a1);
+            _a2 = _mm_comp_fmadd_ps(_mm_set1_ps(p2[kj]), _v, _a2);
+            _a3 = _mm_comp_fmadd_ps(_mm_set1_ps(p3[kj]), _v, _a3);
+            v += vtstride;
+        }
+
+        _mm_storeu_ps(accptrs[0] + d, _a0);
+        _mm_storeu_ps(accptrs[1] + d, _a1);
+        _mm_storeu_ps(accptrs[2] + d, _a2);
+        _mm_storeu_ps(accptrs[3] + d, _a3);
+    }
+#endif // __SSE2__
+    for (; d < dh; d++)
+    {
+        float a0 = accptrs[0][d];
+        float a1 = accptrs[1][d];
+        float a2 = accptrs[2][d];
+        float a3 = accptrs[3][d];
+
+        const float* v = vtptr + d;
+        for (int kj = 0; kj < max_kj; kj++)
+        {
+            a0 += p0[kj] * v[0];
+            a1 += p1[kj] * v[0];
+            a2 += p2[kj] * v[0];
+            a3 += p3[kj] * v[0];
+            v += vtstride;
+        }
+
+        accptrs[0][d] = a0;
+        accptrs[1][d] = a1;
+        accptrs[2][d] = a2;
+        accptrs[3][d] = a3;
+    }
+}
+
+// softmax(q^T k + mask) v per head, streamed over key tiles with running max and sum
+// so that the src_seqlen x dst_seqlen attention matrix is never stored
+// q_affine           embed_dim x src_seqlen
+// k_affine           embed_dim x dst_seqlen, or dst_seqlen x embed_dim with k_token_major as the kv cache stores it
+// v_affine_t         dst_seqlen x embed_dim
+static int flash_attention(const Mat& q_affine, const Mat& k_affine, const Mat& v_affine_t, const Mat& attn_mask_blob, Mat& qkv_cross, int num_heads, int k_token_major, const Option& opt)
+{
+    const int src_seqlen = q_affine.w;
+    const int dst_seqlen = k_token_major ? k_affine.h : k_affine.w;
+    const int embed_dim_per_head = q_affine.h / num_heads;
+    const int out_embed_dim_per_head = v_affine_t.w / num_heads;
+
+    const int TILE_Q = FLASH_ATTENTION_TILE_Q;
+    const int TILE_K = FLASH_ATTENTION_TILE_K;
+
+    const int nn_q = (src_seqlen + TILE_Q - 1) / TILE_Q;
+
+    // per thread scores, output accumulator, running max, running sum and the contiguous queries for k_token_major
+    Mat scratch(TILE_Q * TILE_K + TILE_Q * out_embed_dim_per_head + TILE_Q * 2 + TILE_Q * embed_dim_per_head, 1, opt.num_threads, 4u, opt.workspace_allocator);
+    if (scratch.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < num_heads * nn_q; t++)
+    {
+        const int i = t / nn_q;
+        const int q0 = (t % nn_q) * TILE_Q;
+        const int max_qi = std::min(TILE_Q, src_seqlen - q0);
+
+        const Mat maskm = attn_mask_blob.dims == 3 ? attn_mask_blob.channel(i) : attn_mask_blob;
+
+        float* sptr = scratch.channel(get_omp_thread_num());
+        float* accptr = sptr + TILE_Q * TILE_K;
+        float* maxptr = accptr + TILE_Q * out_embed_dim_per_head;
+        float* sumptr = maxptr + TILE_Q;
+        float* qtptr = sumptr + TILE_Q;
+
+        for (int qi = 0; qi < max_qi; qi++)
+        {
+            maxptr[qi] = -FLT_MAX;
+            sumptr[qi] = 0.f;
+        }
+        memset(accptr, 0, TILE_Q * out_embed_dim_per_head * sizeof(float));
+
+        const float* qptr = q_affine.row(i * embed_dim_per_head);
+
+        if (k_token_major)
+        {
+            for (int qi = 0; qi < max_qi; qi++)
+            {
+                for (int d = 0; d < embed_dim_per_head; d++)
+                {
+                    qtptr[qi * embed_dim_per_head + d] = qptr[d * q_affine.w + q0 + qi];
+                }
+            }
+        }
+
+        for (int k0 = 0; k0 < dst_seqlen; k0 += TILE_K)
+        {
+            const int max_kj = std::min(TILE_K, dst_seqlen - k0);
+
+            const float* kptr = k_token_major ? k_affine.row(k0) + i * embed_dim_per_head : k_affine.row(i * embed_dim_per_head) + k0;
+            const float* vtptr = v_affine_t.row(k0) + i * out_embed_dim_per_head;
+
+            for (int qi = 0; qi < max_qi; qi += 4)
+            {
+                // rows past the tail repeat the scores of the last query and are discarded
+                int qcols[4];
+                const float* maskptrs[4];
+                float* sptrs[4];
+                float* accptrs[4];
+                for (int r = 0; r < 4; r++)
+                {
+                    const int qr = std::min(qi + r, max_qi - 1);
+                    qcols[r] = q0 + qr;
+                    maskptrs[r] = maskm.empty() ? 0 : maskm.row(q0 + qr) + k0;
+                    sptrs[r] = sptr + qr * TILE_K;
+                    accptrs[r] = accptr + (qi + r) * out_embed_dim_per_head;
+                }
+
+                if (k_token_major)
+                {
+                    // one query at a time, decoding has a single one
+                    for (int r = 0; r < 4 && qi + r < max_qi; r++)
+                    {
+                        flash_attention_qk_1(qtptr + (qi + r) * embed_dim_per_head, kptr, k_affine.w, embed_dim_per_head, maskptrs[r], sptrs[r], max_kj);
+                    }
+                }
+                else
+                {
+                    flash_attention_qk_4(qptr, kptr, q_affine.w, k_affine.w, embed_dim_per_head, qcols, maskptrs, sptrs, max_kj);
+                }
+
+                for (int r = 0; r < 4 && qi + r < max_qi; r++)
+                {
+                    float* s = sptrs[r];
+
+                    float max = maxptr[qi + r];
+                    for (int kj = 0; kj < max_kj; kj++)
+                    {
+                        max = std::max(max, s[kj]);
+                    }
+
+                    // rescale what was accumulated against the previous max
+                    const float correction = expf(maxptr[qi + r] - max);
+                    sumptr[qi + r] = sumptr[qi + r] * correction + flash_attention_exp_sum(s, max, max_kj);
+                    maxptr[qi + r] = max;
+
+                    float* acc = accptrs[r];
+                    for (int d = 0; d < out_embed_dim_per_head; d++)
+                    {
+                        acc[d] *= correction;
+                    }
+                }
+
+                flash_attention_pv_4(vtptr, v_affine_t.w, out_embed_dim_per_head, sptrs, accptrs, max_kj);
+            }
+        }
+
+        for (int qi = 0; qi < max_qi; qi++)
+        {
+            const float* acc = accptr + qi * out_embed_dim_per_head;
+            const float sum_inv = 1.f / sumptr[qi];
+            for (int d = 0; d < out_embed_dim_per_head; d++)
+            {
+                qkv_cross.row(i * out_embed_dim_per_head + d)[q0 + qi] = acc[d] * sum_inv;
+            }
+        }
+    }
+
+    return 0;
+}
+
 MultiHeadAttention_x86::MultiHeadAttention_x86()
 {
 #if __SSE2__
@@ -35,6 +569,8 @@ int MultiHeadAttention_x86::create_pipeline(const Option& _opt)
         opt.use_packing_layout = false; // TODO enable packing
     }
 
+    // the int8 path keeps qk_gemm and qkv_gemm for dynamic quantization of q k v
+    if (int8_scale_term)
     {
         qk_softmax = ncnn::create_layer_cpu(ncnn::LayerType::Softmax);
         ncnn::ParamDict pd;
@@ -102,6 +638,11 @@ int MultiHeadAttention_x86::create_pipeline(const Option& _opt)
 #if NCNN_INT8
         pd.set(18, int8_scale_term);
 #endif
+        if (kv_cache)
+        {
+            // dst_seqlen x embed_dim to append to the cache
+            pd.set(14, 1);
+        }
         k_gemm->load_param(pd);
         Mat weights[3];
         weights[0] = k_weight_data;
@@ -137,6 +678,11 @@ int MultiHeadAttention_x86::create_pipeline(const Option& _opt)
 #if NCNN_INT8
         pd.set(18, int8_scale_term);
 #endif
+        if (!int8_scale_term)
+        {
+            // dst_seqlen x embed_dim for flash attention
+            pd.set(14, 1);
+        }
         v_gemm->load_param(pd);
         Mat weights[3];
         weights[0] = v_weight_data;
@@ -189,6 +735,7 @@ int MultiHeadAttention_x86::create_pipeline(const Option& _opt)
         }
     }
 
+    if (int8_scale_term)
     {
         qk_gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
         ncnn::ParamDict pd;
@@ -213,6 +760,7 @@ int MultiHeadAttention_x86::create_pipeline(const Option& _opt)
         qk_gemm->create_pipeline(opt1);
     }
 
+    if (int8_scale_term)
     {
         qkv_gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
         ncnn::ParamDict pd;
@@ -302,10 +850,13 @@ int MultiHeadAttention_x86::destroy_pipeline(const Option& _opt)
 
 int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& _opt) const
 {
+    // q [k] [v] [attn_mask] [cache_k cache_v]
+    const size_t input_blob_count = kv_cache ? bottom_blobs.size() - 2 : bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_blob_count == 1 || (input_blob_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_blob_count == 1 || (input_blob_count == 2 && attn_mask)) ? q_blob : (input_blob_count == 2 || (input_blob_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_blob_count - 1] : Mat();
 
     Option opt = _opt;
     if (int8_scale_term)
@@ -339,6 +890,45 @@ int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retk != 0)
         return retk;
 
+    if (!int8_scale_term)
+    {
+        // dst_seqlen x embed_dim
+        Mat v_affine_t;
+        int retv = v_gemm->forward(v_blob, v_affine_t, opt);
+        if (retv != 0)
+            return retv;
+
+        if (kv_cache)
+        {
+            // append the new tokens to the caches and attend over all tokens
+            // flash attention reads the k cache one token per row as stored
+            int retc = append_kv_cache(bottom_blobs[input_blob_count], k_affine, top_blobs[1], opt);
+            if (retc != 0)
+                return retc;
+
+            retc = append_kv_cache(bottom_blobs[input_blob_count + 1], v_affine_t, top_blobs[2], opt);
+            if (retc != 0)
+                return retc;
+
+            k_affine = top_blobs[1];
+            v_affine_t = top_blobs[2];
+        }
+
+        Mat qkv_cross(src_seqlen, embed_dim_per_head * num_heads, 4u, opt.blob_allocator);
+        if (qkv_cross.empty())
+            return -100;
+
+        int retqkv = flash_attention(q_affine, k_affine, v_affine_t, attn_mask_blob_unpacked, qkv_cross, num_heads, kv_cache, opt);
+        if (retqkv != 0)
+            return retqkv;
+
+        q_affine.release();
+        k_affine.release();
+        v_affine_t.release();
+
+        return o_gemm->forward(qkv_cross, top_blobs[0], opt);
+    }
+
     Mat qk_cross(dst_seqlen, src_seqlen * num_heads, 4u, opt.blob_allocator);
     if (qk_cross.empty())
         return -100;
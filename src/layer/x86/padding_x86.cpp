@@ -11,6 +11,8 @@
 #endif // __AVX__
 #endif // __SSE2__
 
+#include "x86_usability.h"
+
 namespace ncnn {
 
 #if __SSE2__
@@ -24,11 +26,19 @@ namespace ncnn {
 #endif // __AVX__
 #endif // __SSE2__
 
+#if NCNN_BF16
+#include "x86_bf16s.h"
+#endif // NCNN_BF16
+
 Padding_x86::Padding_x86()
 {
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 int Padding_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
@@ -44,6 +54,15 @@ int Padding_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
     if (elembits == 8)
         return forward_int8(bottom_blob, top_blob, opt);
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage && elembits == 16)
+    {
+        // channels are padded on their own unless the channel axis itself is padded
+        const bool channel_blocks = bottom_blob.dims == 3 && front == 0 && behind == 0 && per_channel_pad_data_size == 0;
+        return layer_forward_bf16s(this, bottom_blob, top_blob, channel_blocks, opt);
+    }
+#endif
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int d = bottom_blob.d;
@@ -343,6 +362,11 @@ int Padding_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
 #else
             int out_elempack = outh % 4 == 0 ? 4 : 1;
 #endif
+            if (top == 0 && bottom == 0)
+            {
+                // keep packing when the packed axis is not padded
+                out_elempack = elempack;
+            }
             size_t out_elemsize = elemsize / elempack * out_elempack;
 
             if (top % 4 == 0 && out_elempack == 4 && type == 0)
@@ -369,6 +393,11 @@ int Padding_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
 #else
             int out_elempack = outc % 4 == 0 ? 4 : 1;
 #endif
+            if (front == 0 && behind == 0)
+            {
+                // keep packing when the packed axis is not padded
+                out_elempack = elempack;
+            }
             size_t out_elemsize = elemsize / elempack * out_elempack;
 
             if (front % 4 == 0 && out_elempack == 4 && !(outc != channels * elempack && type != 0))
@@ -0,0 +1,273 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "permute_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Permute_x86::Permute_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+// the input axis taken by output w h d c, 0=w 1=h 2=d 3=c
+static const int permute_order_2d[2][4] = {
+    {0, 1, 2, 3},
+    {3, 1, 2, 0},
+};
+
+static const int permute_order_3d[6][4] = {
+    {0, 1, 2, 3},
+    {1, 0, 2, 3},
+    {0, 3, 2, 1},
+    {3, 0, 2, 1},
+    {1, 3, 2, 0},
+    {3, 1, 2, 0},
+};
+
+static const int permute_order_4d[24][4] = {
+    {0, 1, 2, 3},
+    {1, 0, 2, 3},
+    {0, 2, 1, 3},
+    {2, 0, 1, 3},
+    {1, 2, 0, 3},
+    {2, 1, 0, 3},
+    {0, 1, 3, 2},
+    {1, 0, 3, 2},
+    {0, 3, 1, 2},
+    {3, 0, 1, 2},
+    {1, 3, 0, 2},
+    {3, 1, 0, 2},
+    {0, 2, 3, 1},
+    {2, 0, 3, 1},
+    {0, 3, 2, 1},
+    {3, 0, 2, 1},
+    {2, 3, 0, 1},
+    {3, 2, 0, 1},
+    {1, 2, 3, 0},
+    {2, 1, 3, 0},
+    {1, 3, 2, 0},
+    {3, 1, 2, 0},
+    {2, 3, 1, 0},
+    {3, 2, 1, 0},
+};
+
+int Permute_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+
+    if (dims == 1 || order_type == 0)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    // view 2d blob as w x 1 x 1 x h, the packed axis is always the outermost c
+    int size[4];
+    size_t step[4];
+    const int* order;
+    if (dims == 2)
+    {
+        size[0] = bottom_blob.w;
+        size[1] = 1;
+        size[2] = 1;
+        size[3] = bottom_blob.h * elempack;
+        step[3] = (size_t)bottom_blob.w * elempack;
+        order = permute_order_2d[order_type];
+    }
+    else
+    {
+        size[0] = bottom_blob.w;
+        size[1] = bottom_blob.h;
+        size[2] = bottom_blob.d;
+        size[3] = bottom_blob.c * elempack;
+        step[3] = bottom_blob.cstep * elempack;
+        order = dims == 3 ? permute_order_3d[order_type] : permute_order_4d[order_type];
+    }
+    step[0] = elempack;
+    step[1] = (size_t)size[0] * elempack;
+    step[2] = (size_t)size[0] * size[1] * elempack;
+
+    int outsize[4];
+    for (int j = 0; j < 4; j++)
+    {
+        outsize[j] = size[order[j]];
+    }
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = outsize[3] % 16 == 0 ? 16 : outsize[3] % 8 == 0 ? 8 : outsize[3] % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = outsize[3] % 8 == 0 ? 8 : outsize[3] % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = outsize[3] % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    const size_t out_elemsize = bottom_blob.elemsize / elempack * out_elempack;
+
+    const int outw = outsize[0];
+    const int outh = outsize[1];
+    const int outd = outsize[2];
+    const int outc = outsize[3] / out_elempack;
+
+    if (dims == 2)
+        top_blob.create(outw, outc, out_elemsize, out_elempack, opt.blob_allocator);
+    if (dims == 3)
+        top_blob.create(outw, outh, outc, out_elemsize, out_elempack, opt.blob_allocator);
+    if (dims == 4)
+        top_blob.create(outw, outh, outd, outc, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // input offset of every coordinate along the output axes
+    std::vector<size_t> offsets(outsize[0] + outsize[1] + outsize[2] + outsize[3]);
+    size_t* offset[4];
+    offset[0] = offsets.data();
+    offset[1] = offset[0] + outsize[0];
+    offset[2] = offset[1] + outsize[1];
+    offset[3] = offset[2] + outsize[2];
+    for (int j = 0; j < 4; j++)
+    {
+        const int a = order[j];
+        for (int v = 0; v < outsize[j]; v++)
+        {
+            offset[j][v] = a == 3 ? v / elempack * step[3] + v % elempack : v * step[a];
+        }
+    }
+
+    const size_t out_cstep = dims == 2 ? (size_t)outw * out_elempack : top_blob.cstep * out_elempack;
+    const size_t outstep[3] = {(size_t)out_elempack, (size_t)outw * out_elempack, (size_t)outw * outh * out_elempack};
+
+    // the output axis taken from the packed input axis
+    int jp = 3;
+    for (int j = 0; j < 3; j++)
+    {
+        if (order[j] == 3)
+            jp = j;
+    }
+
+    const float* ptr = bottom_blob;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < outc; q++)
+    {
+        float* outptr0 = (float*)top_blob + q * out_cstep;
+
+        if (elempack > 1 && out_elempack == elempack && jp == 3)
+        {
+            // packed axis stays outermost, copy whole packs
+            const float* ptr0 = ptr + offset[3][q * elempack];
+
+            float* outptr = outptr0;
+            for (int z = 0; z < outd; z++)
+            {
+                for (int i = 0; i < outh; i++)
+                {
+                    const float* ptr1 = ptr0 + offset[2][z] + offset[1][i];
+
+                    for (int j = 0; j < outw; j++)
+                    {
+                        const float* p = ptr1 + offset[0][j];
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+                        if (elempack == 16)
+                        {
+                            _mm512_storeu_ps(outptr, _mm512_loadu_ps(p));
+                        }
+#endif // __AVX512F__
+                        if (elempack == 8)
+                        {
+                            _mm256_storeu_ps(outptr, _mm256_loadu_ps(p));
+                        }
+#endif // __AVX__
+                        if (elempack == 4)
+                        {
+                            _mm_storeu_ps(outptr, _mm_loadu_ps(p));
+                        }
+#endif // __SSE2__
+                        outptr += elempack;
+                    }
+                }
+            }
+
+            continue;
+        }
+
+#if __SSE2__
+        if (elempack > 1 && out_elempack == elempack)
+        {
+            // packed axis moves inside, transpose elempack x elempack blocks
+            const int stepz = jp == 2 ? elempack : 1;
+            const int stepi = jp == 1 ? elempack : 1;
+            const int stepj = jp == 0 ? elempack : 1;
+
+            const size_t lane_step = offset[3][1] - offset[3][0];
+
+            for (int z = 0; z < outd; z += stepz)
+            {
+                for (int i = 0; i < outh; i += stepi)
+                {
+                    for (int j = 0; j < outw; j += stepj)
+                    {
+                        const float* p = ptr + offset[3][q * elempack] + offset[2][z] + offset[1][i] + offset[0][j];
+                        float* outptr = outptr0 + z * outstep[2] + i * outstep[1] + j * outstep[0];
+
+                        const float* ptrs[16];
+                        float* outptrs[16];
+                        for (int k = 0; k < elempack; k++)
+                        {
+                            ptrs[k] = p + k * lane_step;
+                            outptrs[k] = outptr + k * outstep[jp];
+                        }
+
+                        transpose_packed_ps(ptrs, outptrs, elempack);
+                    }
+                }
+            }
+
+            continue;
+        }
+#endif // __SSE2__
+
+        // gather lane by lane
+        float* outptr = outptr0;
+        for (int z = 0; z < outd; z++)
+        {
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* p = ptr + offset[2][z] + offset[1][i] + offset[0][j];
+
+                    for (int k = 0; k < out_elempack; k++)
+                    {
+                        outptr[k] = p[offset[3][q * out_elempack + k]];
+                    }
+
+                    outptr += out_elempack;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,189 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pixelshuffle_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+PixelShuffle_x86::PixelShuffle_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int PixelShuffle_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int r = upscale_factor;
+
+    const int outw = w * r;
+    const int outh = h * r;
+    const int outc = channels * elempack / (r * r);
+
+    // mode 0 with r * r == elempack is a pack transpose, mode 1 moves whole packs
+    const bool fast_path = elempack > 1 && outc % elempack == 0 && (mode == 1 || r * r == elempack);
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = outc % 16 == 0 ? 16 : outc % 8 == 0 ? 8 : outc % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = outc % 8 == 0 ? 8 : outc % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = outc % 4 == 0 ? 4 : 1;
+#endif
+
+        if (fast_path)
+            out_elempack = elempack;
+    }
+#endif // __SSE2__
+    const size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    top_blob.create(outw, outh, outc / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+#if __SSE2__
+    if (fast_path && out_elempack == elempack && mode == 0)
+    {
+        // out channel p * elempack + k at sub pixel s comes from lane s of in channel p * elempack + k
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < outc / out_elempack; p++)
+        {
+            Mat m = top_blob.channel(p);
+
+            for (int i = 0; i < h; i++)
+            {
+                for (int j = 0; j < w; j++)
+                {
+                    const float* ptrs[16];
+                    float* outptrs[16];
+                    for (int k = 0; k < elempack; k++)
+                    {
+                        ptrs[k] = bottom_blob.channel(p * elempack + k).row(i) + j * elempack;
+                    }
+                    for (int sh = 0; sh < r; sh++)
+                    {
+                        for (int sw = 0; sw < r; sw++)
+                        {
+                            outptrs[sh * r + sw] = m.row(i * r + sh) + (j * r + sw) * out_elempack;
+                        }
+                    }
+
+                    transpose_packed_ps(ptrs, outptrs, elempack);
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    if (fast_path && out_elempack == elempack && mode == 1)
+    {
+        // in channel (sh * r + sw) * outc + p keeps its lanes
+        const int outc_packed = outc / out_elempack;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < outc_packed; p++)
+        {
+            Mat m = top_blob.channel(p);
+
+            for (int sh = 0; sh < r; sh++)
+            {
+                for (int sw = 0; sw < r; sw++)
+                {
+                    const float* sptr = bottom_blob.channel((sh * r + sw) * outc_packed + p);
+
+                    for (int i = 0; i < h; i++)
+                    {
+                        float* outptr = m.row(i * r + sh) + sw * elempack;
+                        for (int j = 0; j < w; j++)
+                        {
+#if __AVX__
+#if __AVX512F__
+                            if (elempack == 16)
+                            {
+                                _mm512_storeu_ps(outptr, _mm512_loadu_ps(sptr));
+                            }
+#endif // __AVX512F__
+                            if (elempack == 8)
+                            {
+                                _mm256_storeu_ps(outptr, _mm256_loadu_ps(sptr));
+                            }
+#endif // __AVX__
+                            if (elempack == 4)
+                            {
+                                _mm_storeu_ps(outptr, _mm_loadu_ps(sptr));
+                            }
+
+                            sptr += elempack;
+                            outptr += r * elempack;
+                        }
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+#endif // __SSE2__
+
+    // gather lane by lane
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < outc / out_elempack; p++)
+    {
+        Mat m = top_blob.channel(p);
+
+        for (int sh = 0; sh < r; sh++)
+        {
+            for (int sw = 0; sw < r; sw++)
+            {
+                for (int k = 0; k < out_elempack; k++)
+                {
+                    const int pp = p * out_elempack + k;
+
+                    int q;
+                    if (mode == 0)
+                        q = pp * r * r + sh * r + sw;
+                    else // if (mode == 1)
+                        q = (sh * r + sw) * outc + pp;
+
+                    const float* sptr = (const float*)bottom_blob.channel(q / elempack) + q % elempack;
+
+                    for (int i = 0; i < h; i++)
+                    {
+                        float* outptr = m.row(i * r + sh) + sw * out_elempack + k;
+                        for (int j = 0; j < w; j++)
+                        {
+                            outptr[0] = sptr[0];
+
+                            sptr += elempack;
+                            outptr += r * out_elempack;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
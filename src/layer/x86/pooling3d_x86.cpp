@@ -0,0 +1,294 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pooling3d_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include <float.h>
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Pooling3D_x86::Pooling3D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int Pooling3D_x86::create_pipeline(const Option& /*opt*/)
+{
+    if (adaptive_pooling)
+    {
+        support_packing = false;
+    }
+    return 0;
+}
+
+// max or scaled sum of the packed elements at sptr + ofs[0..n)
+static NCNN_FORCEINLINE void pooling3d_packed(const float* sptr, const int* ofs, int n, int elempack, int pooling_type, float scale, float* outptr)
+{
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        __m512 _r = pooling_type == Pooling3D::PoolMethod_MAX ? _mm512_set1_ps(-FLT_MAX) : _mm512_setzero_ps();
+        if (pooling_type == Pooling3D::PoolMethod_MAX)
+        {
+            for (int k = 0; k < n; k++)
+                _r = _mm512_max_ps(_r, _mm512_loadu_ps(sptr + ofs[k]));
+        }
+        else
+        {
+            for (int k = 0; k < n; k++)
+                _r = _mm512_add_ps(_r, _mm512_loadu_ps(sptr + ofs[k]));
+            _r = _mm512_mul_ps(_r, _mm512_set1_ps(scale));
+        }
+        _mm512_storeu_ps(outptr, _r);
+        return;
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        __m256 _r = pooling_type == Pooling3D::PoolMethod_MAX ? _mm256_set1_ps(-FLT_MAX) : _mm256_setzero_ps();
+        if (pooling_type == Pooling3D::PoolMethod_MAX)
+        {
+            for (int k = 0; k < n; k++)
+                _r = _mm256_max_ps(_r, _mm256_loadu_ps(sptr + ofs[k]));
+        }
+        else
+        {
+            for (int k = 0; k < n; k++)
+                _r = _mm256_add_ps(_r, _mm256_loadu_ps(sptr + ofs[k]));
+            _r = _mm256_mul_ps(_r, _mm256_set1_ps(scale));
+        }
+        _mm256_storeu_ps(outptr, _r);
+        return;
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        __m128 _r = pooling_type == Pooling3D::PoolMethod_MAX ? _mm_set1_ps(-FLT_MAX) : _mm_setzero_ps();
+        if (pooling_type == Pooling3D::PoolMethod_MAX)
+        {
+            for (int k = 0; k < n; k++)
+                _r = _mm_max_ps(_r, _mm_loadu_ps(sptr + ofs[k]));
+        }
+        else
+        {
+            for (int k = 0; k < n; k++)
+                _r = _mm_add_ps(_r, _mm_loadu_ps(sptr + ofs[k]));
+            _r = _mm_mul_ps(_r, _mm_set1_ps(scale));
+        }
+        _mm_storeu_ps(outptr, _r);
+        return;
+    }
+#endif // __SSE2__
+}
+
+int Pooling3D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int elempack = bottom_blob.elempack;
+
+    if (elempack == 1 || adaptive_pooling)
+    {
+        return Pooling3D::forward(bottom_blob, top_blob, opt);
+    }
+
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int d = bottom_blob.d;
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (global_pooling)
+    {
+        top_blob.create(channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        const int size = w * h * d;
+        const float scale = 1.f / size;
+
+        std::vector<int> _ofs(size);
+        for (int i = 0; i < size; i++)
+        {
+            _ofs[i] = i * elempack;
+        }
+        const int* ofs = &_ofs[0];
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const float* ptr = bottom_blob.channel(q);
+            float* outptr = (float*)top_blob + q * elempack;
+
+            pooling3d_packed(ptr, ofs, size, elempack, pooling_type, scale, outptr);
+        }
+
+        return 0;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    w = bottom_blob_bordered.w;
+    h = bottom_blob_bordered.h;
+    d = bottom_blob_bordered.d;
+
+    const int outw = (w - kernel_w) / stride_w + 1;
+    const int outh = (h - kernel_h) / stride_h + 1;
+    const int outd = (d - kernel_d) / stride_d + 1;
+
+    top_blob.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap0 = w - kernel_w;
+        int gap1 = h * w - w * kernel_h;
+        for (int z = 0; z < kernel_d; z++)
+        {
+            for (int i = 0; i < kernel_h; i++)
+            {
+                for (int j = 0; j < kernel_w; j++)
+                {
+                    space_ofs[p1] = p2 * elempack;
+                    p1++;
+                    p2 += 1;
+                }
+                p2 += gap0;
+            }
+            p2 += gap1;
+        }
+    }
+
+    if (pooling_type == PoolMethod_MAX || avgpool_count_include_pad == 1)
+    {
+        const float scale = 1.f / maxk;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const Mat m = bottom_blob_bordered.channel(q);
+            float* outptr = top_blob.channel(q);
+
+            for (int z = 0; z < outd; z++)
+            {
+                for (int i = 0; i < outh; i++)
+                {
+                    for (int j = 0; j < outw; j++)
+                    {
+                        const float* sptr = m.depth(z * stride_d).row(i * stride_h) + j * stride_w * elempack;
+
+                        pooling3d_packed(sptr, space_ofs, maxk, elempack, pooling_type, scale, outptr);
+
+                        outptr += elempack;
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    // avgpool_count_include_pad == 0
+    int wtailpad = 0;
+    int htailpad = 0;
+    int dtailpad = 0;
+
+    if (pad_mode == 0) // full padding
+    {
+        wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+        htailpad = bottom_blob_bordered.h - bottom_blob.h - pad_top - pad_bottom;
+        dtailpad = bottom_blob_bordered.d - bottom_blob.d - pad_front - pad_behind;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const Mat m = bottom_blob_bordered.channel(q);
+        float* outptr = top_blob.channel(q);
+
+        std::vector<int> _ofs(maxk);
+        int* ofs = &_ofs[0];
+
+        for (int z = 0; z < outd; z++)
+        {
+            const int sz0 = z * stride_d;
+
+            for (int i = 0; i < outh; i++)
+            {
+                const int sy0 = i * stride_h;
+
+                for (int j = 0; j < outw; j++)
+                {
+                    const int sx0 = j * stride_w;
+
+                    // the taps that fall inside the unpadded input
+                    int area = 0;
+                    for (int kd = 0; kd < kernel_d; kd++)
+                    {
+                        const int sz = sz0 + kd;
+
+                        if (sz < pad_front)
+                            continue;
+
+                        if (sz >= d - pad_behind - dtailpad)
+                            break;
+
+                        for (int ki = 0; ki < kernel_h; ki++)
+                        {
+                            const int sy = sy0 + ki;
+
+                            if (sy < pad_top)
+                                continue;
+
+                            if (sy >= h - pad_bottom - htailpad)
+                                break;
+
+                            for (int kj = 0; kj < kernel_w; kj++)
+                            {
+                                const int sx = sx0 + kj;
+
+                                if (sx < pad_left)
+                                    continue;
+
+                                if (sx >= w - pad_right - wtailpad)
+                                    break;
+
+                                ofs[area] = ((sz * h + sy) * w + sx) * elempack;
+                                area++;
+                            }
+                        }
+                    }
+
+                    pooling3d_packed(m, ofs, area, elempack, pooling_type, 1.f / area, outptr);
+
+                    outptr += elempack;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
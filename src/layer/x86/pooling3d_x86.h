@@ -0,0 +1,22 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_POOLING3D_X86_H
+#define LAYER_POOLING3D_X86_H
+
+#include "pooling3d.h"
+
+namespace ncnn {
+
+class Pooling3D_x86 : public Pooling3D
+{
+public:
+    Pooling3D_x86();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_POOLING3D_X86_H
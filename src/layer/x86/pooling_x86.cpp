@@ -12,6 +12,8 @@
 
 #include <float.h>
 
+#include "x86_usability.h"
+
 namespace ncnn {
 
 #if __SSE2__
@@ -28,11 +30,19 @@ namespace ncnn {
 #endif // __AVX__
 #endif // __SSE2__
 
+#if NCNN_BF16
+#include "x86_bf16s.h"
+#endif // NCNN_BF16
+
 Pooling_x86::Pooling_x86()
 {
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 int Pooling_x86::create_pipeline(const Option& /*opt*/)
@@ -59,6 +69,11 @@ int Pooling_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
         return Pooling::forward(bottom_blob, top_blob, opt);
     }
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_blob.elembits() == 16)
+        return layer_forward_bf16s(this, bottom_blob, top_blob, true, opt);
+#endif
+
 #if __SSE2__
     int elempack = bottom_blob.elempack;
     int w = bottom_blob.w;
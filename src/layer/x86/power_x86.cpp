@@ -0,0 +1,176 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "power_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+#if NCNN_BF16
+#include "x86_bf16s.h"
+#endif // NCNN_BF16
+
+Power_x86::Power_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int Power_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+        return layer_forward_inplace_bf16s(this, bottom_top_blob, opt);
+#endif
+
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int d = bottom_top_blob.d;
+    int channels = bottom_top_blob.c;
+    int elempack = bottom_top_blob.elempack;
+    int size = w * h * d * elempack;
+
+    // integer exponent keeps negative bases valid, as powf does
+    const bool integer_power = fabsf(power) <= 64.f && power == (float)(int)power;
+    const int ipower = integer_power ? (int)fabsf(power) : 0;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        __m512 _scale512 = _mm512_set1_ps(scale);
+        __m512 _shift512 = _mm512_set1_ps(shift);
+        __m512 _power512 = _mm512_set1_ps(power);
+        __m512 _one512 = _mm512_set1_ps(1.f);
+        for (; i + 15 < size; i += 16)
+        {
+            __m512 _p = _mm512_loadu_ps(ptr);
+            _p = _mm512_add_ps(_shift512, _mm512_mul_ps(_p, _scale512));
+            if (integer_power)
+            {
+                __m512 _x = _p;
+                _p = _one512;
+                for (int n = ipower; n; n >>= 1)
+                {
+                    if (n & 1)
+                        _p = _mm512_mul_ps(_p, _x);
+                    _x = _mm512_mul_ps(_x, _x);
+                }
+                if (power < 0.f)
+                    _p = _mm512_div_ps(_one512, _p);
+            }
+            else if (power == 0.5f)
+            {
+                _p = _mm512_sqrt_ps(_p);
+            }
+            else
+            {
+                _p = pow512_ps(_p, _power512);
+            }
+            _mm512_storeu_ps(ptr, _p);
+
+            ptr += 16;
+        }
+#endif // __AVX512F__
+        __m256 _scale256 = _mm256_set1_ps(scale);
+        __m256 _shift256 = _mm256_set1_ps(shift);
+        __m256 _power256 = _mm256_set1_ps(power);
+        __m256 _one256 = _mm256_set1_ps(1.f);
+        for (; i + 7 < size; i += 8)
+        {
+            __m256 _p = _mm256_loadu_ps(ptr);
+            _p = _mm256_add_ps(_shift256, _mm256_mul_ps(_p, _scale256));
+            if (integer_power)
+            {
+                __m256 _x = _p;
+                _p = _one256;
+                for (int n = ipower; n; n >>= 1)
+                {
+                    if (n & 1)
+                        _p = _mm256_mul_ps(_p, _x);
+                    _x = _mm256_mul_ps(_x, _x);
+                }
+                if (power < 0.f)
+                    _p = _mm256_div_ps(_one256, _p);
+            }
+            else if (power == 0.5f)
+            {
+                _p = _mm256_sqrt_ps(_p);
+            }
+            else
+            {
+                _p = pow256_ps(_p, _power256);
+            }
+            _mm256_storeu_ps(ptr, _p);
+
+            ptr += 8;
+        }
+#endif // __AVX__
+        __m128 _scale128 = _mm_set1_ps(scale);
+        __m128 _shift128 = _mm_set1_ps(shift);
+        __m128 _power128 = _mm_set1_ps(power);
+        __m128 _one128 = _mm_set1_ps(1.f);
+        for (; i + 3 < size; i += 4)
+        {
+            __m128 _p = _mm_load_ps(ptr);
+            _p = _mm_add_ps(_shift128, _mm_mul_ps(_p, _scale128));
+            if (integer_power)
+            {
+                __m128 _x = _p;
+                _p = _one128;
+                for (int n = ipower; n; n >>= 1)
+                {
+                    if (n & 1)
+                        _p = _mm_mul_ps(_p, _x);
+                    _x = _mm_mul_ps(_x, _x);
+                }
+                if (power < 0.f)
+                    _p = _mm_div_ps(_one128, _p);
+            }
+            else if (power == 0.5f)
+            {
+                _p = _mm_sqrt_ps(_p);
+            }
+            else
+            {
+                _p = pow_ps(_p, _power128);
+            }
+            _mm_store_ps(ptr, _p);
+
+            ptr += 4;
+        }
+#endif // __SSE2__
+        for (; i < size; i++)
+        {
+            *ptr = powf((shift + *ptr * scale), power);
+            ptr++;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_POWER_X86_H
+#define LAYER_POWER_X86_H
+
+#include "power.h"
+
+namespace ncnn {
+
+class Power_x86 : public Power
+{
+public:
+    Power_x86();
+
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_POWER_X86_H
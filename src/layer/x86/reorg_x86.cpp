@@ -0,0 +1,190 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "reorg_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Reorg_x86::Reorg_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int Reorg_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int channels = bottom_blob.c * bottom_blob.elempack;
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int outw = w / stride;
+    const int outh = h / stride;
+    const int outc = channels * stride * stride;
+
+    // mode 0 with stride * stride == elempack is a pack transpose, mode 1 moves whole packs
+    const bool fast_path = elempack > 1 && (mode == 1 || stride * stride == elempack);
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = outc % 16 == 0 ? 16 : outc % 8 == 0 ? 8 : outc % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = outc % 8 == 0 ? 8 : outc % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = outc % 4 == 0 ? 4 : 1;
+#endif
+
+        if (fast_path)
+            out_elempack = elempack;
+    }
+#endif // __SSE2__
+    const size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    top_blob.create(outw, outh, outc / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+#if __SSE2__
+    if (fast_path && out_elempack == elempack && mode == 0)
+    {
+        // lane k of in channel q at sub pixel s goes to lane s of out channel q * elempack + k
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < bottom_blob.c; q++)
+        {
+            const Mat m = bottom_blob.channel(q);
+
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* ptrs[16];
+                    float* outptrs[16];
+                    for (int sh = 0; sh < stride; sh++)
+                    {
+                        for (int sw = 0; sw < stride; sw++)
+                        {
+                            ptrs[sh * stride + sw] = m.row(i * stride + sh) + (j * stride + sw) * elempack;
+                        }
+                    }
+                    for (int k = 0; k < elempack; k++)
+                    {
+                        outptrs[k] = top_blob.channel(q * elempack + k).row(i) + j * out_elempack;
+                    }
+
+                    transpose_packed_ps(ptrs, outptrs, elempack);
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    if (fast_path && out_elempack == elempack && mode == 1)
+    {
+        // in channel q at sub pixel s goes to out channel s * channels + q keeping its lanes
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < bottom_blob.c; q++)
+        {
+            const Mat m = bottom_blob.channel(q);
+
+            for (int sh = 0; sh < stride; sh++)
+            {
+                for (int sw = 0; sw < stride; sw++)
+                {
+                    float* outptr = top_blob.channel((sh * stride + sw) * bottom_blob.c + q);
+
+                    for (int i = 0; i < outh; i++)
+                    {
+                        const float* sptr = m.row(i * stride + sh) + sw * elempack;
+                        for (int j = 0; j < outw; j++)
+                        {
+#if __AVX__
+#if __AVX512F__
+                            if (elempack == 16)
+                            {
+                                _mm512_storeu_ps(outptr, _mm512_loadu_ps(sptr));
+                            }
+#endif // __AVX512F__
+                            if (elempack == 8)
+                            {
+                                _mm256_storeu_ps(outptr, _mm256_loadu_ps(sptr));
+                            }
+#endif // __AVX__
+                            if (elempack == 4)
+                            {
+                                _mm_storeu_ps(outptr, _mm_loadu_ps(sptr));
+                            }
+
+                            sptr += stride * elempack;
+                            outptr += elempack;
+                        }
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+#endif // __SSE2__
+
+    // gather lane by lane
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < outc / out_elempack; p++)
+    {
+        float* outptr0 = top_blob.channel(p);
+
+        for (int k = 0; k < out_elempack; k++)
+        {
+            const int pp = p * out_elempack + k;
+
+            int q;
+            int s;
+            if (mode == 0)
+            {
+                q = pp / (stride * stride);
+                s = pp % (stride * stride);
+            }
+            else // if (mode == 1)
+            {
+                q = pp % channels;
+                s = pp / channels;
+            }
+
+            const int sh = s / stride;
+            const int sw = s % stride;
+
+            const Mat m = bottom_blob.channel(q / elempack);
+
+            float* outptr = outptr0 + k;
+            for (int i = 0; i < outh; i++)
+            {
+                const float* sptr = m.row(i * stride + sh) + sw * elempack + q % elempack;
+                for (int j = 0; j < outw; j++)
+                {
+                    outptr[0] = sptr[0];
+
+                    sptr += stride * elempack;
+                    outptr += out_elempack;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_REORG_X86_H
+#define LAYER_REORG_X86_H
+
+#include "reorg.h"
+
+namespace ncnn {
+
+class Reorg_x86 : public Reorg
+{
+public:
+    Reorg_x86();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_REORG_X86_H
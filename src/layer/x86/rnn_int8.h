@@ -0,0 +1,241 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+static int rnn_transform_weight_int8(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_data_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt)
+{
+    // pack for every 4 outputs, input and hidden are interleaved in pairs for pmaddwd
+    // the tail block and the odd tail pair are zero padded
+    const int size2 = (size + 1) / 2 * 2;
+    const int num_output2 = (num_output + 1) / 2 * 2;
+
+    const int nn_num_output = (num_output + 3) / 4;
+
+    weight_data_tm.create((size2 + num_output2) * 4, nn_num_output, num_directions, 1u, 1);
+    weight_data_tm_int8_descales.create(8, nn_num_output, num_directions);
+    bias_c_tm.create(4, nn_num_output, num_directions);
+    if (weight_data_tm.empty() || weight_data_tm_int8_descales.empty() || bias_c_tm.empty())
+        return -100;
+
+    weight_data_tm.fill<signed char>(0);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc_dr = weight_xc.channel(dr);
+        const Mat weight_hc_dr = weight_hc.channel(dr);
+        const float* bias_c_dr = bias_c.channel(dr);
+        const float* weight_xc_int8_scales_ptr = weight_xc_int8_scales.row(dr);
+        const float* weight_hc_int8_scales_ptr = weight_hc_int8_scales.row(dr);
+
+        Mat weight_data_tm_dr = weight_data_tm.channel(dr);
+        Mat weight_data_tm_int8_descales_dr = weight_data_tm_int8_descales.channel(dr);
+        Mat bias_c_tm_dr = bias_c_tm.channel(dr);
+
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            signed char* kptr_xc = weight_data_tm_dr.row<signed char>(qq);
+            signed char* kptr_hc = kptr_xc + size2 * 4;
+            float* descales_ptr = weight_data_tm_int8_descales_dr.row(qq);
+            float* bias_c_ptr = bias_c_tm_dr.row(qq);
+
+            for (int k = 0; k < 4; k++)
+            {
+                const int q = qq * 4 + k;
+
+                if (q >= num_output)
+                {
+                    bias_c_ptr[k] = 0.f;
+                    descales_ptr[k] = 0.f;
+                    descales_ptr[4 + k] = 0.f;
+                    continue;
+                }
+
+                bias_c_ptr[k] = bias_c_dr[q];
+
+                descales_ptr[k] = 1.f / weight_xc_int8_scales_ptr[q];
+                descales_ptr[4 + k] = 1.f / weight_hc_int8_scales_ptr[q];
+
+                const signed char* weight_xc_q = weight_xc_dr.row<const signed char>(q);
+                const signed char* weight_hc_q = weight_hc_dr.row<const signed char>(q);
+
+                for (int i = 0; i < size; i++)
+                {
+                    kptr_xc[i / 2 * 8 + k * 2 + i % 2] = weight_xc_q[i];
+                }
+
+                for (int i = 0; i < num_output; i++)
+                {
+                    kptr_hc[i / 2 * 8 + k * 2 + i % 2] = weight_hc_q[i];
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static float rnn_dynamic_quantize_int16(const float* ptr, int size, short* outptr)
+{
+    float absmax = 0.f;
+    for (int i = 0; i < size; i++)
+    {
+        absmax = std::max(absmax, (float)fabs(ptr[i]));
+    }
+
+    if (absmax == 0.f)
+    {
+        for (int i = 0; i < size; i++)
+        {
+            outptr[i] = 0;
+        }
+        return 0.f;
+    }
+
+    const float scale = 127.f / absmax;
+    for (int i = 0; i < size; i++)
+    {
+        outptr[i] = float2int8(ptr[i] * scale);
+    }
+
+    return absmax / 127.f;
+}
+
+#if __SSE2__
+static NCNN_FORCEINLINE __m128i rnn_dot4_int8_sse2(const signed char* kptr, const short* x, int pairs)
+{
+    // kptr holds 4 outputs x 2 int8 per pair, x holds int16 pairs
+    __m128i _sum0 = _mm_setzero_si128();
+    __m128i _sum1 = _mm_setzero_si128();
+
+    int p = 0;
+    for (; p + 1 < pairs; p += 2)
+    {
+        __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+        __m128i _w0 = _mm_srai_epi16(_mm_unpacklo_epi8(_w, _w), 8);
+        __m128i _w1 = _mm_srai_epi16(_mm_unpackhi_epi8(_w, _w), 8);
+        _sum0 = _mm_add_epi32(_sum0, _mm_madd_epi16(_w0, _mm_set1_epi32(((const int*)x)[p])));
+        _sum1 = _mm_add_epi32(_sum1, _mm_madd_epi16(_w1, _mm_set1_epi32(((const int*)x)[p + 1])));
+
+        kptr += 16;
+    }
+    for (; p < pairs; p++)
+    {
+        __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
+        __m128i _w0 = _mm_srai_epi16(_mm_unpacklo_epi8(_w, _w), 8);
+        _sum0 = _mm_add_epi32(_sum0, _mm_madd_epi16(_w0, _mm_set1_epi32(((const int*)x)[p])));
+
+        kptr += 8;
+    }
+
+    return _mm_add_epi32(_sum0, _sum1);
+}
+#endif // __SSE2__
+
+static int rnn_int8(const Mat& bottom_blob, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt)
+{
+    const int size = bottom_blob.w;
+    const int T = bottom_blob.h;
+
+    const int num_output = top_blob.w;
+    const int nn_num_output = (num_output + 3) / 4;
+
+    const int size2 = (size + 1) / 2 * 2;
+    const int num_output2 = (num_output + 1) / 2 * 2;
+
+    // H for every 4 outputs
+    Mat gates(4, nn_num_output, 4u, opt.workspace_allocator);
+    if (gates.empty())
+        return -100;
+
+    // dynamic quantize bottom_blob
+    Mat bottom_blob_int16(size2, T, 2u, opt.workspace_allocator);
+    Mat bottom_blob_int8_descales(T, 4u, opt.workspace_allocator);
+    if (bottom_blob_int16.empty() || bottom_blob_int8_descales.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < T; t++)
+    {
+        short* outptr = bottom_blob_int16.row<short>(t);
+        bottom_blob_int8_descales[t] = rnn_dynamic_quantize_int16(bottom_blob.row(t), size, outptr);
+        if (size2 != size)
+            outptr[size] = 0;
+    }
+
+    Mat hidden_state_int16(num_output2, 2u, opt.workspace_allocator);
+    if (hidden_state_int16.empty())
+        return -100;
+
+    hidden_state_int16.fill<short>(0);
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        const int ti = reverse ? T - 1 - t : t;
+
+        // dynamic quantize hidden_state
+        const float descale_h = rnn_dynamic_quantize_int16(hidden_state, num_output, hidden_state_int16);
+        const float descale_x = bottom_blob_int8_descales[ti];
+
+        const short* x = bottom_blob_int16.row<const short>(ti);
+        const short* hs = hidden_state_int16;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            const signed char* kptr_xc = weight_data_tm.row<const signed char>(qq);
+            const signed char* kptr_hc = kptr_xc + size2 * 4;
+
+            const float* descales_ptr = weight_data_tm_int8_descales.row(qq);
+            const float* bias_c_ptr = bias_c.row(qq);
+
+            float* gates_data = gates.row(qq);
+
+#if __SSE2__
+            __m128i _Hx = rnn_dot4_int8_sse2(kptr_xc, x, size2 / 2);
+            __m128i _Hh = rnn_dot4_int8_sse2(kptr_hc, hs, num_output2 / 2);
+
+            __m128 _H = _mm_loadu_ps(bias_c_ptr);
+            _H = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Hx), _mm_mul_ps(_mm_set1_ps(descale_x), _mm_loadu_ps(descales_ptr)), _H);
+            _H = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Hh), _mm_mul_ps(_mm_set1_ps(descale_h), _mm_loadu_ps(descales_ptr + 4)), _H);
+
+            _H = tanh_sse(_H);
+
+            _mm_storeu_ps(gates_data, _H);
+#else  // __SSE2__
+            for (int k = 0; k < 4; k++)
+            {
+                int Hx = 0;
+                for (int i = 0; i < size2; i++)
+                {
+                    Hx += kptr_xc[i / 2 * 8 + k * 2 + i % 2] * x[i];
+                }
+
+                int Hh = 0;
+                for (int i = 0; i < num_output2; i++)
+                {
+                    Hh += kptr_hc[i / 2 * 8 + k * 2 + i % 2] * hs[i];
+                }
+
+                float H = bias_c_ptr[k] + Hx * (descale_x * descales_ptr[k]) + Hh * (descale_h * descales_ptr[4 + k]);
+
+                gates_data[k] = tanhf(H);
+            }
+#endif // __SSE2__
+        }
+
+        float* output_data = top_blob.row(ti);
+        float* hidden_ptr = hidden_state;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < num_output; q++)
+        {
+            const float H = gates.row(q / 4)[q % 4];
+
+            hidden_ptr[q] = H;
+            output_data[q] = H;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,409 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "rnn_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+#if NCNN_INT8
+#include "rnn_int8.h"
+#endif
+
+RNN_x86::RNN_x86()
+{
+    one_blob_only = false;
+    support_inplace = false;
+}
+
+int RNN_x86::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return create_pipeline_int8(opt);
+    }
+#endif
+
+    // pack for every 4 outputs, the tail block is zero padded
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output;
+
+    const int nn_num_output = (num_output + 3) / 4;
+
+    weight_xc_data_packed.create(size * 4, nn_num_output, num_directions);
+    bias_c_data_packed.create(4, nn_num_output, num_directions);
+    weight_hc_data_packed.create(num_output * 4, nn_num_output, num_directions);
+    if (weight_xc_data_packed.empty() || bias_c_data_packed.empty() || weight_hc_data_packed.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc = weight_xc_data.channel(dr);
+        const Mat weight_hc = weight_hc_data.channel(dr);
+        const float* bias_c = bias_c_data.channel(dr);
+
+        Mat weight_xc_data_packed_dr = weight_xc_data_packed.channel(dr);
+        Mat bias_c_data_packed_dr = bias_c_data_packed.channel(dr);
+        Mat weight_hc_data_packed_dr = weight_hc_data_packed.channel(dr);
+
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            float* bias_c_ptr = bias_c_data_packed_dr.row(qq);
+            float* weight_xc_ptr = weight_xc_data_packed_dr.row(qq);
+            float* weight_hc_ptr = weight_hc_data_packed_dr.row(qq);
+
+            for (int k = 0; k < 4; k++)
+            {
+                const int q = qq * 4 + k;
+
+                if (q >= num_output)
+                {
+                    bias_c_ptr[k] = 0.f;
+
+                    for (int i = 0; i < size; i++)
+                    {
+                        weight_xc_ptr[i * 4 + k] = 0.f;
+                    }
+
+                    for (int i = 0; i < num_output; i++)
+                    {
+                        weight_hc_ptr[i * 4 + k] = 0.f;
+                    }
+
+                    continue;
+                }
+
+                bias_c_ptr[k] = bias_c[q];
+
+                const float* weight_xc_q = weight_xc.row(q);
+                const float* weight_hc_q = weight_hc.row(q);
+
+                for (int i = 0; i < size; i++)
+                {
+                    weight_xc_ptr[i * 4 + k] = weight_xc_q[i];
+                }
+
+                for (int i = 0; i < num_output; i++)
+                {
+                    weight_hc_ptr[i * 4 + k] = weight_hc_q[i];
+                }
+            }
+        }
+    }
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+    }
+
+    return 0;
+}
+
+static int rnn(const Mat& bottom_blob, Mat& top_blob, int reverse, const Mat& weight_xc, const Mat& bias_c, const Mat& weight_hc, Mat& hidden_state, const Option& opt)
+{
+    const int size = bottom_blob.w;
+    const int T = bottom_blob.h;
+
+    const int num_output = top_blob.w;
+    const int nn_num_output = (num_output + 3) / 4;
+
+    // H for every 4 outputs
+    Mat gates(4, nn_num_output, 4u, opt.workspace_allocator);
+    if (gates.empty())
+        return -100;
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        const int ti = reverse ? T - 1 - t : t;
+
+        const float* x = bottom_blob.row(ti);
+        const float* hs = hidden_state;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            const float* bias_c_ptr = bias_c.row(qq);
+
+            const float* weight_xc_ptr = weight_xc.row(qq);
+            const float* weight_hc_ptr = weight_hc.row(qq);
+
+            float* gates_data = gates.row(qq);
+
+#if __SSE2__
+            __m128 _H = _mm_loadu_ps(bias_c_ptr);
+            __m128 _sum1 = _mm_setzero_ps();
+            __m128 _sum2 = _mm_setzero_ps();
+            __m128 _sum3 = _mm_setzero_ps();
+
+            int i = 0;
+            for (; i + 3 < size; i += 4)
+            {
+                _H = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_ptr), _mm_set1_ps(x[i]), _H);
+                _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_ptr + 4), _mm_set1_ps(x[i + 1]), _sum1);
+                _sum2 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_ptr + 8), _mm_set1_ps(x[i + 2]), _sum2);
+                _sum3 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_ptr + 12), _mm_set1_ps(x[i + 3]), _sum3);
+
+                weight_xc_ptr += 16;
+            }
+            for (; i < size; i++)
+            {
+                _H = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_ptr), _mm_set1_ps(x[i]), _H);
+
+                weight_xc_ptr += 4;
+            }
+
+            i = 0;
+            for (; i + 3 < num_output; i += 4)
+            {
+                _H = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_ptr), _mm_set1_ps(hs[i]), _H);
+                _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_ptr + 4), _mm_set1_ps(hs[i + 1]), _sum1);
+                _sum2 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_ptr + 8), _mm_set1_ps(hs[i + 2]), _sum2);
+                _sum3 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_ptr + 12), _mm_set1_ps(hs[i + 3]), _sum3);
+
+                weight_hc_ptr += 16;
+            }
+            for (; i < num_output; i++)
+            {
+                _H = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_ptr), _mm_set1_ps(hs[i]), _H);
+
+                weight_hc_ptr += 4;
+            }
+
+            _H = _mm_add_ps(_mm_add_ps(_H, _sum1), _mm_add_ps(_sum2, _sum3));
+
+            _H = tanh_sse(_H);
+
+            _mm_storeu_ps(gates_data, _H);
+#else  // __SSE2__
+            for (int k = 0; k < 4; k++)
+            {
+                float H = bias_c_ptr[k];
+
+                for (int i = 0; i < size; i++)
+                {
+                    H += weight_xc_ptr[i * 4 + k] * x[i];
+                }
+
+                for (int i = 0; i < num_output; i++)
+                {
+                    H += weight_hc_ptr[i * 4 + k] * hs[i];
+                }
+
+                gates_data[k] = tanhf(H);
+            }
+#endif // __SSE2__
+        }
+
+        float* output_data = top_blob.row(ti);
+        float* hidden_ptr = hidden_state;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < num_output; q++)
+        {
+            const float H = gates.row(q / 4)[q % 4];
+
+            hidden_ptr[q] = H;
+            output_data[q] = H;
+        }
+    }
+
+    return 0;
+}
+
+int RNN_x86::rnn_direction(const Mat& bottom_blob, Mat& top_blob, int reverse, int dr, Mat& hidden_state, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return rnn_int8(bottom_blob, top_blob, reverse, weight_data_tm.channel(dr), weight_data_tm_int8_descales.channel(dr), bias_c_data_packed.channel(dr), hidden_state, opt);
+    }
+#endif
+
+    return rnn(bottom_blob, top_blob, reverse, weight_xc_data_packed.channel(dr), bias_c_data_packed.channel(dr), weight_hc_data_packed.channel(dr), hidden_state, opt);
+}
+
+int RNN_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int T = bottom_blob.h;
+
+    int num_directions = direction == 2 ? 2 : 1;
+
+    // initial hidden state
+    Mat hidden(num_output, 4u, opt.workspace_allocator);
+    if (hidden.empty())
+        return -100;
+    hidden.fill(0.f);
+
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        int ret = rnn_direction(bottom_blob, top_blob, direction, 0, hidden, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        {
+            int ret = rnn_direction(bottom_blob, top_blob_forward, 0, 0, hidden, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        hidden.fill(0.f);
+
+        {
+            int ret = rnn_direction(bottom_blob, top_blob_reverse, 1, 1, hidden, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    return 0;
+}
+
+int RNN_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    int T = bottom_blob.h;
+    int num_directions = direction == 2 ? 2 : 1;
+
+    Mat hidden;
+    Allocator* hidden_allocator = top_blobs.size() == 2 ? opt.blob_allocator : opt.workspace_allocator;
+    if (bottom_blobs.size() == 2)
+    {
+        hidden = bottom_blobs[1].clone(hidden_allocator);
+    }
+    else
+    {
+        hidden.create(num_output, num_directions, 4u, hidden_allocator);
+        if (hidden.empty())
+            return -100;
+        hidden.fill(0.f);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        int ret = rnn_direction(bottom_blob, top_blob, direction, 0, hidden, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        Mat hidden0 = hidden.row_range(0, 1);
+        {
+            int ret = rnn_direction(bottom_blob, top_blob_forward, 0, 0, hidden0, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        Mat hidden1 = hidden.row_range(1, 1);
+        {
+            int ret = rnn_direction(bottom_blob, top_blob_reverse, 1, 1, hidden1, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    if (top_blobs.size() == 2)
+    {
+        top_blobs[1] = hidden;
+    }
+
+    return 0;
+}
+
+#if NCNN_INT8
+int RNN_x86::create_pipeline_int8(const Option& opt)
+{
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output;
+
+    int ret = rnn_transform_weight_int8(weight_xc_data, weight_xc_data_int8_scales, weight_hc_data, weight_hc_data_int8_scales, bias_c_data, weight_data_tm, weight_data_tm_int8_descales, bias_c_data_packed, size, num_output, num_directions, opt);
+    if (ret != 0)
+        return ret;
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+        weight_xc_data_int8_scales.release();
+        weight_hc_data_int8_scales.release();
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
+} // namespace ncnn
@@ -0,0 +1,253 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "rotaryembed_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+RotaryEmbed_x86::RotaryEmbed_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+static void rotary_embed_pack1(const float* ptr, const float* ctab, const float* stab, float* outptr, int half, int interleaved)
+{
+    int i = 0;
+
+    if (interleaved)
+    {
+#if __SSE2__
+#if __AVX__
+        for (; i + 3 < half; i += 4)
+        {
+            __m256 _x = _mm256_loadu_ps(ptr + i * 2);
+            __m256 _c = _mm256_setr_ps(ctab[i], ctab[i], ctab[i + 1], ctab[i + 1], ctab[i + 2], ctab[i + 2], ctab[i + 3], ctab[i + 3]);
+            __m256 _s = _mm256_setr_ps(-stab[i], stab[i], -stab[i + 1], stab[i + 1], -stab[i + 2], stab[i + 2], -stab[i + 3], stab[i + 3]);
+            __m256 _xs = _mm256_permute_ps(_x, _MM_SHUFFLE(2, 3, 0, 1));
+            __m256 _out = _mm256_comp_fmadd_ps(_xs, _s, _mm256_mul_ps(_x, _c));
+            _mm256_storeu_ps(outptr + i * 2, _out);
+        }
+#endif // __AVX__
+        for (; i + 1 < half; i += 2)
+        {
+            __m128 _x = _mm_loadu_ps(ptr + i * 2);
+            __m128 _c = _mm_setr_ps(ctab[i], ctab[i], ctab[i + 1], ctab[i + 1]);
+            __m128 _s = _mm_setr_ps(-stab[i], stab[i], -stab[i + 1], stab[i + 1]);
+            __m128 _xs = _mm_shuffle_ps(_x, _x, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 _out = _mm_comp_fmadd_ps(_xs, _s, _mm_mul_ps(_x, _c));
+            _mm_storeu_ps(outptr + i * 2, _out);
+        }
+#endif // __SSE2__
+        for (; i < half; i++)
+        {
+            const float x0 = ptr[i * 2];
+            const float x1 = ptr[i * 2 + 1];
+            outptr[i * 2] = x0 * ctab[i] - x1 * stab[i];
+            outptr[i * 2 + 1] = x1 * ctab[i] + x0 * stab[i];
+        }
+
+        return;
+    }
+
+    const float* ptr1 = ptr + half;
+    float* outptr1 = outptr + half;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < half; i += 16)
+    {
+        __m512 _x0 = _mm512_loadu_ps(ptr + i);
+        __m512 _x1 = _mm512_loadu_ps(ptr1 + i);
+        __m512 _c = _mm512_loadu_ps(ctab + i);
+        __m512 _s = _mm512_loadu_ps(stab + i);
+        _mm512_storeu_ps(outptr + i, _mm512_fnmadd_ps(_x1, _s, _mm512_mul_ps(_x0, _c)));
+        _mm512_storeu_ps(outptr1 + i, _mm512_fmadd_ps(_x0, _s, _mm512_mul_ps(_x1, _c)));
+    }
+#endif // __AVX512F__
+    for (; i + 7 < half; i += 8)
+    {
+        __m256 _x0 = _mm256_loadu_ps(ptr + i);
+        __m256 _x1 = _mm256_loadu_ps(ptr1 + i);
+        __m256 _c = _mm256_loadu_ps(ctab + i);
+        __m256 _s = _mm256_loadu_ps(stab + i);
+        _mm256_storeu_ps(outptr + i, _mm256_comp_fnmadd_ps(_x1, _s, _mm256_mul_ps(_x0, _c)));
+        _mm256_storeu_ps(outptr1 + i, _mm256_comp_fmadd_ps(_x0, _s, _mm256_mul_ps(_x1, _c)));
+    }
+#endif // __AVX__
+    for (; i + 3 < half; i += 4)
+    {
+        __m128 _x0 = _mm_loadu_ps(ptr + i);
+        __m128 _x1 = _mm_loadu_ps(ptr1 + i);
+        __m128 _c = _mm_loadu_ps(ctab + i);
+        __m128 _s = _mm_loadu_ps(stab + i);
+        _mm_storeu_ps(outptr + i, _mm_comp_fnmadd_ps(_x1, _s, _mm_mul_ps(_x0, _c)));
+        _mm_storeu_ps(outptr1 + i, _mm_comp_fmadd_ps(_x0, _s, _mm_mul_ps(_x1, _c)));
+    }
+#endif // __SSE2__
+    for (; i < half; i++)
+    {
+        const float x0 = ptr[i];
+        const float x1 = ptr1[i];
+        outptr[i] = x0 * ctab[i] - x1 * stab[i];
+        outptr1[i] = x1 * ctab[i] + x0 * stab[i];
+    }
+}
+
+#if __SSE2__
+// every lane holds one element of another head or another position
+// table_elempack 1 broadcasts the same angle to all lanes, otherwise each lane has its own position
+static void rotary_embed_packed(const float* ptr, const float* ctab, const float* stab, float* outptr, int half, int elempack, int table_elempack, int interleaved)
+{
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        for (int i = 0; i < half; i++)
+        {
+            const int i0 = interleaved ? i * 2 : i;
+            const int i1 = interleaved ? i * 2 + 1 : i + half;
+
+            __m512 _x0 = _mm512_load_ps(ptr + i0 * 16);
+            __m512 _x1 = _mm512_load_ps(ptr + i1 * 16);
+            __m512 _c = table_elempack == 1 ? _mm512_set1_ps(ctab[i]) : _mm512_loadu_ps(ctab + i * 16);
+            __m512 _s = table_elempack == 1 ? _mm512_set1_ps(stab[i]) : _mm512_loadu_ps(stab + i * 16);
+            _mm512_store_ps(outptr + i0 * 16, _mm512_fnmadd_ps(_x1, _s, _mm512_mul_ps(_x0, _c)));
+            _mm512_store_ps(outptr + i1 * 16, _mm512_fmadd_ps(_x0, _s, _mm512_mul_ps(_x1, _c)));
+        }
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        for (int i = 0; i < half; i++)
+        {
+            const int i0 = interleaved ? i * 2 : i;
+            const int i1 = interleaved ? i * 2 + 1 : i + half;
+
+            __m256 _x0 = _mm256_load_ps(ptr + i0 * 8);
+            __m256 _x1 = _mm256_load_ps(ptr + i1 * 8);
+            __m256 _c = table_elempack == 1 ? _mm256_set1_ps(ctab[i]) : _mm256_loadu_ps(ctab + i * 8);
+            __m256 _s = table_elempack == 1 ? _mm256_set1_ps(stab[i]) : _mm256_loadu_ps(stab + i * 8);
+            _mm256_store_ps(outptr + i0 * 8, _mm256_comp_fnmadd_ps(_x1, _s, _mm256_mul_ps(_x0, _c)));
+            _mm256_store_ps(outptr + i1 * 8, _mm256_comp_fmadd_ps(_x0, _s, _mm256_mul_ps(_x1, _c)));
+        }
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        for (int i = 0; i < half; i++)
+        {
+            const int i0 = interleaved ? i * 2 : i;
+            const int i1 = interleaved ? i * 2 + 1 : i + half;
+
+            __m128 _x0 = _mm_load_ps(ptr + i0 * 4);
+            __m128 _x1 = _mm_load_ps(ptr + i1 * 4);
+            __m128 _c = table_elempack == 1 ? _mm_set1_ps(ctab[i]) : _mm_loadu_ps(ctab + i * 4);
+            __m128 _s = table_elempack == 1 ? _mm_set1_ps(stab[i]) : _mm_loadu_ps(stab + i * 4);
+            _mm_store_ps(outptr + i0 * 4, _mm_comp_fnmadd_ps(_x1, _s, _mm_mul_ps(_x0, _c)));
+            _mm_store_ps(outptr + i1 * 4, _mm_comp_fmadd_ps(_x0, _s, _mm_mul_ps(_x1, _c)));
+        }
+    }
+}
+#endif // __SSE2__
+
+int RotaryEmbed_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    Mat bottom_blob = bottom_blobs[0];
+    Mat& top_blob = top_blobs[0];
+
+    if (bottom_blob.dims == 1 && bottom_blob.elempack != 1)
+    {
+        // single position, elements packed along embed_dim
+        Option opt_unpack = opt;
+        opt_unpack.blob_allocator = opt.workspace_allocator;
+        convert_packing(bottom_blobs[0], bottom_blob, 1, opt_unpack);
+        if (bottom_blob.empty())
+            return -100;
+    }
+
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+    const int embed_dim = bottom_blob.w;
+    const int seqlen = dims == 1 ? 1 : (dims == 2 ? bottom_blob.h * elempack : bottom_blob.h);
+    const int num_heads = dims == 3 ? bottom_blob.c : 1;
+
+    if (embed_dim % 2 != 0)
+    {
+        NCNN_LOGE("RotaryEmbed embed_dim %d must be even", embed_dim);
+        return -1;
+    }
+
+    const int half = embed_dim / 2;
+
+    Mat cos_table;
+    Mat sin_table;
+    int ret = make_cos_sin_table(bottom_blobs, embed_dim, seqlen, cos_table, sin_table, opt);
+    if (ret != 0)
+        return ret;
+
+    // positions packed along h need one angle per lane
+    int table_elempack = 1;
+    if (dims == 2 && elempack != 1)
+    {
+        Option opt_pack = opt;
+        opt_pack.blob_allocator = opt.workspace_allocator;
+
+        Mat cos_table_packed;
+        Mat sin_table_packed;
+        convert_packing(cos_table, cos_table_packed, elempack, opt_pack);
+        convert_packing(sin_table, sin_table_packed, elempack, opt_pack);
+        if (cos_table_packed.empty() || sin_table_packed.empty())
+            return -100;
+
+        cos_table = cos_table_packed;
+        sin_table = sin_table_packed;
+        table_elempack = elempack;
+    }
+
+    top_blob.create_like(bottom_blob, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const int rows = dims == 1 ? 1 : bottom_blob.h;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_heads; q++)
+    {
+        const Mat head = dims == 3 ? bottom_blob.channel(q) : bottom_blob;
+        Mat outhead = dims == 3 ? top_blob.channel(q) : top_blob;
+
+        for (int y = 0; y < rows; y++)
+        {
+            const float* ptr = (const float*)head + y * embed_dim * elempack;
+            float* outptr = (float*)outhead + y * embed_dim * elempack;
+            const float* ctab = cos_table.row(y);
+            const float* stab = sin_table.row(y);
+
+#if __SSE2__
+            if (elempack != 1)
+            {
+                rotary_embed_packed(ptr, ctab, stab, outptr, half, elempack, table_elempack, interleaved);
+                continue;
+            }
+#endif // __SSE2__
+
+            rotary_embed_pack1(ptr, ctab, stab, outptr, half, interleaved);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
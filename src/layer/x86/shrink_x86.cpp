@@ -0,0 +1,108 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "shrink_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+#if NCNN_BF16
+#include "x86_bf16s.h"
+#endif // NCNN_BF16
+
+Shrink_x86::Shrink_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int Shrink_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+        return layer_forward_inplace_bf16s(this, bottom_top_blob, opt);
+#endif
+
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int d = bottom_top_blob.d;
+    int channels = bottom_top_blob.c;
+    int elempack = bottom_top_blob.elempack;
+    int size = w * h * d * elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        __m512 _lambd512 = _mm512_set1_ps(lambd);
+        __m512 _neg_lambd512 = _mm512_set1_ps(-lambd);
+        __m512 _bias512 = _mm512_set1_ps(bias);
+        for (; i + 15 < size; i += 16)
+        {
+            __m512 _p = _mm512_loadu_ps(ptr);
+            __mmask16 _lo = _mm512_cmp_ps_mask(_p, _neg_lambd512, _CMP_LT_OQ);
+            __mmask16 _hi = _mm512_cmp_ps_mask(_p, _lambd512, _CMP_GT_OQ);
+            _p = _mm512_mask_add_ps(_p, _lo, _p, _bias512);
+            _p = _mm512_mask_sub_ps(_p, _hi, _p, _bias512);
+            _mm512_storeu_ps(ptr, _p);
+
+            ptr += 16;
+        }
+#endif // __AVX512F__
+        __m256 _lambd256 = _mm256_set1_ps(lambd);
+        __m256 _neg_lambd256 = _mm256_set1_ps(-lambd);
+        __m256 _bias256 = _mm256_set1_ps(bias);
+        for (; i + 7 < size; i += 8)
+        {
+            __m256 _p = _mm256_loadu_ps(ptr);
+            __m256 _lo = _mm256_cmp_ps(_p, _neg_lambd256, _CMP_LT_OQ);
+            __m256 _hi = _mm256_cmp_ps(_p, _lambd256, _CMP_GT_OQ);
+            _p = _mm256_add_ps(_p, _mm256_sub_ps(_mm256_and_ps(_lo, _bias256), _mm256_and_ps(_hi, _bias256)));
+            _mm256_storeu_ps(ptr, _p);
+
+            ptr += 8;
+        }
+#endif // __AVX__
+        __m128 _lambd128 = _mm_set1_ps(lambd);
+        __m128 _neg_lambd128 = _mm_set1_ps(-lambd);
+        __m128 _bias128 = _mm_set1_ps(bias);
+        for (; i + 3 < size; i += 4)
+        {
+            __m128 _p = _mm_load_ps(ptr);
+            __m128 _lo = _mm_cmplt_ps(_p, _neg_lambd128);
+            __m128 _hi = _mm_cmpgt_ps(_p, _lambd128);
+            _p = _mm_add_ps(_p, _mm_sub_ps(_mm_and_ps(_lo, _bias128), _mm_and_ps(_hi, _bias128)));
+            _mm_store_ps(ptr, _p);
+
+            ptr += 4;
+        }
+#endif // __SSE2__
+        for (; i < size; i++)
+        {
+            *ptr = *ptr < -lambd ? *ptr + bias : *ptr > lambd ? *ptr - bias : *ptr;
+            ptr++;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,419 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "spectrogram_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#include <math.h>
+#include <string.h>
+
+namespace ncnn {
+
+Spectrogram_x86::Spectrogram_x86()
+{
+}
+
+// factor n into stockham stages, radix 4 and 2 first, then odd factors
+// each stage stores m * r twiddles w^(p*k) of its length n followed by the r roots of unity of the radix
+static void spectrogram_fft_plan(int n, int inverse, std::vector<int>& radix, Mat& twiddles)
+{
+    radix.clear();
+
+    int t = n;
+    while (t % 4 == 0)
+    {
+        radix.push_back(4);
+        t /= 4;
+    }
+    while (t % 2 == 0)
+    {
+        radix.push_back(2);
+        t /= 2;
+    }
+    for (int f = 3; f <= t; f += 2)
+    {
+        while (t % f == 0)
+        {
+            radix.push_back(f);
+            t /= f;
+        }
+    }
+
+    const double sign = inverse ? 1.0 : -1.0;
+
+    int twiddles_size = 0;
+    {
+        int len = n;
+        for (size_t i = 0; i < radix.size(); i++)
+        {
+            twiddles_size += (len + radix[i]) * 2;
+            len /= radix[i];
+        }
+    }
+
+    twiddles.create(twiddles_size > 0 ? twiddles_size : 1);
+
+    float* ptr = twiddles;
+    int len = n;
+    for (size_t i = 0; i < radix.size(); i++)
+    {
+        const int r = radix[i];
+        const int m = len / r;
+
+        for (int p = 0; p < m; p++)
+        {
+            for (int k = 0; k < r; k++)
+            {
+                const double angle = sign * 2 * 3.14159265358979323846 * p * k / len;
+                ptr[0] = (float)cos(angle);
+                ptr[1] = (float)sin(angle);
+                ptr += 2;
+            }
+        }
+
+        for (int k = 0; k < r; k++)
+        {
+            const double angle = sign * 2 * 3.14159265358979323846 * k / r;
+            ptr[0] = (float)cos(angle);
+            ptr[1] = (float)sin(angle);
+            ptr += 2;
+        }
+
+        len = m;
+    }
+}
+
+#if __SSE2__
+// stockham autosort fft over 4 frames at once
+// x and y hold n complex values, each as 4 re lanes followed by 4 im lanes
+// returns the buffer holding the result in natural order
+static float* spectrogram_fft_pack4(float* x, float* y, int n, const std::vector<int>& radix, const Mat& twiddles, int inverse)
+{
+    const float* tw = twiddles;
+
+    int len = n;
+    int s = 1;
+    for (size_t st = 0; st < radix.size(); st++)
+    {
+        const int r = radix[st];
+        const int m = len / r;
+
+        const float* wp = tw;
+        const float* wr = tw + m * r * 2;
+        tw += (len + r) * 2;
+
+        for (int p = 0; p < m; p++)
+        {
+            for (int q = 0; q < s; q++)
+            {
+                const float* a = x + (q + s * p) * 8;
+                float* b = y + (q + s * r * p) * 8;
+
+                const int astep = s * m * 8;
+                const int bstep = s * 8;
+
+                if (r == 2)
+                {
+                    __m128 _a0r = _mm_load_ps(a);
+                    __m128 _a0i = _mm_load_ps(a + 4);
+                    __m128 _a1r = _mm_load_ps(a + astep);
+                    __m128 _a1i = _mm_load_ps(a + astep + 4);
+
+                    _mm_store_ps(b, _mm_add_ps(_a0r, _a1r));
+                    _mm_store_ps(b + 4, _mm_add_ps(_a0i, _a1i));
+                    _mm_store_ps(b + bstep, _mm_sub_ps(_a0r, _a1r));
+                    _mm_store_ps(b + bstep + 4, _mm_sub_ps(_a0i, _a1i));
+                }
+                else if (r == 4)
+                {
+                    __m128 _a0r = _mm_load_ps(a);
+                    __m128 _a0i = _mm_load_ps(a + 4);
+                    __m128 _a1r = _mm_load_ps(a + astep);
+                    __m128 _a1i = _mm_load_ps(a + astep + 4);
+                    __m128 _a2r = _mm_load_ps(a + astep * 2);
+                    __m128 _a2i = _mm_load_ps(a + astep * 2 + 4);
+                    __m128 _a3r = _mm_load_ps(a + astep * 3);
+                    __m128 _a3i = _mm_load_ps(a + astep * 3 + 4);
+
+                    __m128 _t0r = _mm_add_ps(_a0r, _a2r);
+                    __m128 _t0i = _mm_add_ps(_a0i, _a2i);
+                    __m128 _t1r = _mm_sub_ps(_a0r, _a2r);
+                    __m128 _t1i = _mm_sub_ps(_a0i, _a2i);
+                    __m128 _t2r = _mm_add_ps(_a1r, _a3r);
+                    __m128 _t2i = _mm_add_ps(_a1i, _a3i);
+                    __m128 _t3r = _mm_sub_ps(_a1r, _a3r);
+                    __m128 _t3i = _mm_sub_ps(_a1i, _a3i);
+
+                    _mm_store_ps(b, _mm_add_ps(_t0r, _t2r));
+                    _mm_store_ps(b + 4, _mm_add_ps(_t0i, _t2i));
+                    _mm_store_ps(b + bstep * 2, _mm_sub_ps(_t0r, _t2r));
+                    _mm_store_ps(b + bstep * 2 + 4, _mm_sub_ps(_t0i, _t2i));
+
+                    // forward multiplies t3 by -i, inverse by +i
+                    __m128 _b1r = inverse ? _mm_sub_ps(_t1r, _t3i) : _mm_add_ps(_t1r, _t3i);
+                    __m128 _b1i = inverse ? _mm_add_ps(_t1i, _t3r) : _mm_sub_ps(_t1i, _t3r);
+                    __m128 _b3r = inverse ? _mm_add_ps(_t1r, _t3i) : _mm_sub_ps(_t1r, _t3i);
+                    __m128 _b3i = inverse ? _mm_sub_ps(_t1i, _t3r) : _mm_add_ps(_t1i, _t3r);
+
+                    _mm_store_ps(b + bstep, _b1r);
+                    _mm_store_ps(b + bstep + 4, _b1i);
+                    _mm_store_ps(b + bstep * 3, _b3r);
+                    _mm_store_ps(b + bstep * 3 + 4, _b3i);
+                }
+                else
+                {
+                    // generic odd radix dft
+                    for (int k = 0; k < r; k++)
+                    {
+                        __m128 _sumr = _mm_setzero_ps();
+                        __m128 _sumi = _mm_setzero_ps();
+                        for (int j = 0; j < r; j++)
+                        {
+                            const float* w = wr + (j * k % r) * 2;
+                            __m128 _wr = _mm_set1_ps(w[0]);
+                            __m128 _wi = _mm_set1_ps(w[1]);
+                            __m128 _ar = _mm_load_ps(a + astep * j);
+                            __m128 _ai = _mm_load_ps(a + astep * j + 4);
+                            _sumr = _mm_add_ps(_sumr, _mm_sub_ps(_mm_mul_ps(_ar, _wr), _mm_mul_ps(_ai, _wi)));
+                            _sumi = _mm_add_ps(_sumi, _mm_add_ps(_mm_mul_ps(_ar, _wi), _mm_mul_ps(_ai, _wr)));
+                        }
+                        _mm_store_ps(b + bstep * k, _sumr);
+                        _mm_store_ps(b + bstep * k + 4, _sumi);
+                    }
+                }
+
+                // twiddle
+                if (p > 0)
+                {
+                    for (int k = 1; k < r; k++)
+                    {
+                        const float* w = wp + (p * r + k) * 2;
+                        __m128 _wr = _mm_set1_ps(w[0]);
+                        __m128 _wi = _mm_set1_ps(w[1]);
+                        __m128 _br = _mm_load_ps(b + bstep * k);
+                        __m128 _bi = _mm_load_ps(b + bstep * k + 4);
+                        _mm_store_ps(b + bstep * k, _mm_sub_ps(_mm_mul_ps(_br, _wr), _mm_mul_ps(_bi, _wi)));
+                        _mm_store_ps(b + bstep * k + 4, _mm_add_ps(_mm_mul_ps(_br, _wi), _mm_mul_ps(_bi, _wr)));
+                    }
+                }
+            }
+        }
+
+        std::swap(x, y);
+        len = m;
+        s *= r;
+    }
+
+    return x;
+}
+#endif // __SSE2__
+
+int Spectrogram_x86::create_pipeline(const Option& /*opt*/)
+{
+    spectrogram_fft_plan(n_fft, 0, fft_radix, fft_twiddles);
+
+    return 0;
+}
+
+int Spectrogram_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if __SSE2__
+    Mat bottom_blob_bordered = bottom_blob;
+    if (center == 1)
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        if (pad_type == 0)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_CONSTANT, 0.f, opt_b);
+        if (pad_type == 1)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_REPLICATE, 0.f, opt_b);
+        if (pad_type == 2)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_REFLECT, 0.f, opt_b);
+    }
+
+    return forward_frames_x86(bottom_blob_bordered, top_blob, opt);
+#else
+    return Spectrogram::forward(bottom_blob, top_blob, opt);
+#endif // __SSE2__
+}
+
+int Spectrogram_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (bottom_blobs.size() == 1)
+    {
+        return forward(bottom_blobs[0], top_blobs[0], opt);
+    }
+
+#if __SSE2__
+    // streaming, bottom_blobs[1] holds the samples left over from the previous chunk
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& cache = bottom_blobs[1];
+    const size_t elemsize = bottom_blob.elemsize;
+
+    const int size = cache.w + bottom_blob.w;
+    if (size < n_fft || hoplen >= n_fft)
+    {
+        NCNN_LOGE("Spectrogram streaming needs at least %d samples per call and hoplen < n_fft", n_fft);
+        return -1;
+    }
+
+    Mat signal(size, elemsize, opt.workspace_allocator);
+    if (signal.empty())
+        return -100;
+
+    memcpy(signal, cache, cache.w * elemsize);
+    memcpy((float*)signal + cache.w, bottom_blob, bottom_blob.w * elemsize);
+
+    int ret = forward_frames_x86(signal, top_blobs[0], opt);
+    if (ret != 0)
+        return ret;
+
+    // keep the tail that has not completed a frame yet
+    const int consumed = ((size - n_fft) / hoplen + 1) * hoplen;
+
+    Mat& top_cache = top_blobs[1];
+    top_cache.create(size - consumed, elemsize, opt.blob_allocator);
+    if (top_cache.empty())
+        return -100;
+
+    memcpy(top_cache, (const float*)signal + consumed, (size - consumed) * elemsize);
+
+    return 0;
+#else
+    return Spectrogram::forward(bottom_blobs, top_blobs, opt);
+#endif // __SSE2__
+}
+
+int Spectrogram_x86::forward_frames_x86(const Mat& bottom_blob_bordered, Mat& top_blob, const Option& opt) const
+{
+#if __SSE2__
+    const int size = bottom_blob_bordered.w;
+
+    const int frames = (size - n_fft) / hoplen + 1;
+    const int freqs_onesided = n_fft / 2 + 1;
+    const int freqs = onesided ? freqs_onesided : n_fft;
+
+    const size_t elemsize = bottom_blob_bordered.elemsize;
+
+    if (power == 0)
+    {
+        top_blob.create(2, frames, freqs, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(frames, freqs, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    float norm = 1.f;
+    if (normalized == 1)
+        norm = 1.f / sqrt(n_fft);
+    if (normalized == 2)
+        norm = window_data[n_fft];
+
+    const int nn_frames = (frames + 3) / 4;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int jj = 0; jj < nn_frames; jj++)
+    {
+        const int j = jj * 4;
+        const int count = std::min(frames - j, 4);
+
+        Mat tmp(n_fft * 8, 2, 4u, opt.workspace_allocator);
+
+        // windowed frames, one frame per lane
+        float* x = tmp.row(0);
+        for (int k = 0; k < n_fft; k++)
+        {
+            const float* ptr = (const float*)bottom_blob_bordered + j * hoplen + k;
+            const float wk = window_data[k];
+
+            for (int l = 0; l < 4; l++)
+            {
+                x[k * 8 + l] = l < count ? ptr[l * hoplen] * wk : 0.f;
+                x[k * 8 + 4 + l] = 0.f;
+            }
+        }
+
+        const float* X = spectrogram_fft_pack4(tmp.row(0), tmp.row(1), n_fft, fft_radix, fft_twiddles, 0);
+
+        __m128 _norm = _mm_set1_ps(norm);
+
+        for (int i = 0; i < freqs_onesided; i++)
+        {
+            __m128 _re = _mm_mul_ps(_mm_load_ps(X + i * 8), _norm);
+            __m128 _im = _mm_mul_ps(_mm_load_ps(X + i * 8 + 4), _norm);
+
+            float re[4];
+            float im[4];
+            _mm_storeu_ps(re, _re);
+            _mm_storeu_ps(im, _im);
+
+            if (power == 0)
+            {
+                // complex as real
+                float* outptr = top_blob.channel(i).row(j);
+                for (int l = 0; l < count; l++)
+                {
+                    outptr[0] = re[l];
+                    outptr[1] = im[l];
+                    outptr += 2;
+                }
+            }
+            else
+            {
+                float mag[4];
+                __m128 _mag = _mm_add_ps(_mm_mul_ps(_re, _re), _mm_mul_ps(_im, _im));
+                if (power == 1)
+                    _mag = _mm_sqrt_ps(_mag);
+                _mm_storeu_ps(mag, _mag);
+
+                float* outptr = top_blob.row(i) + j;
+                for (int l = 0; l < count; l++)
+                {
+                    outptr[l] = mag[l];
+                }
+            }
+        }
+    }
+
+    if (!onesided)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = freqs_onesided; i < n_fft; i++)
+        {
+            if (power == 0)
+            {
+                const float* ptr = top_blob.channel(n_fft - i);
+                float* outptr = top_blob.channel(i);
+
+                for (int j = 0; j < frames; j++)
+                {
+                    // complex as real
+                    outptr[0] = ptr[0];
+                    outptr[1] = -ptr[1];
+                    ptr += 2;
+                    outptr += 2;
+                }
+            }
+            else // if (power == 1 || power == 2)
+            {
+                const float* ptr = top_blob.row(n_fft - i);
+                float* outptr = top_blob.row(i);
+
+                memcpy(outptr, ptr, frames * sizeof(float));
+            }
+        }
+    }
+
+    return 0;
+#else
+    return Spectrogram::forward_frames(bottom_blob_bordered, top_blob, opt);
+#endif // __SSE2__
+}
+
+} // namespace ncnn
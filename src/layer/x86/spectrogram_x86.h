@@ -0,0 +1,33 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_SPECTROGRAM_X86_H
+#define LAYER_SPECTROGRAM_X86_H
+
+#include "spectrogram.h"
+
+namespace ncnn {
+
+class Spectrogram_x86 : public Spectrogram
+{
+public:
+    Spectrogram_x86();
+
+    virtual int create_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+protected:
+    int forward_frames_x86(const Mat& signal, Mat& top_blob, const Option& opt) const;
+
+public:
+    // stockham stage radix and per stage twiddles
+    std::vector<int> fft_radix;
+    Mat fft_twiddles;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_SPECTROGRAM_X86_H
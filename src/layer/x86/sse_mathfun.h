@@ -1154,4 +1154,35 @@ static NCNN_FORCEINLINE __m128 abs_ps(__m128 x)
     return _mm_and_ps(abs_mask, x);
 }
 
+static NCNN_FORCEINLINE __m128 erf_ps(__m128 x)
+{
+    // Abramowitz and Stegun 7.1.26, max abs error 1.5e-7
+    const __m128 magic_negative_zero = _mm_set1_ps(-0.0f);
+    const __m128 magic_one = _mm_set1_ps(1.0f);
+    const __m128 magic_p = _mm_set1_ps(0.3275911f);
+    const __m128 magic_a1 = _mm_set1_ps(0.254829592f);
+    const __m128 magic_a2 = _mm_set1_ps(-0.284496736f);
+    const __m128 magic_a3 = _mm_set1_ps(1.421413741f);
+    const __m128 magic_a4 = _mm_set1_ps(-1.453152027f);
+    const __m128 magic_a5 = _mm_set1_ps(1.061405429f);
+
+    __m128 sign = _mm_and_ps(magic_negative_zero, x);
+    __m128 absolute = _mm_andnot_ps(magic_negative_zero, x);
+
+    // t = 1 / (1 + p * |x|)
+    __m128 t = _mm_div_ps(magic_one, _mm_add_ps(magic_one, _mm_mul_ps(magic_p, absolute)));
+
+    // y = 1 - (((((a5 * t + a4) * t) + a3) * t + a2) * t + a1) * t * exp(-x * x)
+    __m128 y = _mm_add_ps(_mm_mul_ps(magic_a5, t), magic_a4);
+    y = _mm_add_ps(_mm_mul_ps(y, t), magic_a3);
+    y = _mm_add_ps(_mm_mul_ps(y, t), magic_a2);
+    y = _mm_add_ps(_mm_mul_ps(y, t), magic_a1);
+    y = _mm_mul_ps(y, t);
+
+    __m128 e = exp_ps(_mm_xor_ps(magic_negative_zero, _mm_mul_ps(absolute, absolute)));
+    y = _mm_sub_ps(magic_one, _mm_mul_ps(y, e));
+
+    return _mm_or_ps(y, sign);
+}
+
 #endif // SSE_MATHFUN_H
@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_THRESHOLD_X86_H
+#define LAYER_THRESHOLD_X86_H
+
+#include "threshold.h"
+
+namespace ncnn {
+
+class Threshold_x86 : public Threshold
+{
+public:
+    Threshold_x86();
+
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_THRESHOLD_X86_H
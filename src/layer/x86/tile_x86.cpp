@@ -0,0 +1,212 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "tile_x86.h"
+
+namespace ncnn {
+
+Tile_x86::Tile_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int Tile_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+
+    int repeat_w = 1;
+    int repeat_h = 1;
+    int repeat_d = 1;
+    int repeat_c = 1;
+
+    const int repeats_num = repeats.w;
+
+    if (repeats.empty())
+    {
+        if (dims == 1) // axis == 0
+        {
+            repeat_w = tiles;
+        }
+        else if (dims == 2)
+        {
+            if (axis == 0) repeat_h = tiles;
+            if (axis == 1) repeat_w = tiles;
+        }
+        else if (dims == 3)
+        {
+            if (axis == 0) repeat_c = tiles;
+            if (axis == 1) repeat_h = tiles;
+            if (axis == 2) repeat_w = tiles;
+        }
+        else if (dims == 4)
+        {
+            if (axis == 0) repeat_c = tiles;
+            if (axis == 1) repeat_d = tiles;
+            if (axis == 2) repeat_h = tiles;
+            if (axis == 3) repeat_w = tiles;
+        }
+    }
+    else
+    {
+        // numpy style tile
+        const int* repeats_ptr = repeats;
+
+        if (repeats_num == 1)
+        {
+            repeat_w = repeats_ptr[0];
+        }
+        if (repeats_num == 2)
+        {
+            repeat_h = repeats_ptr[0];
+            repeat_w = repeats_ptr[1];
+        }
+        if (repeats_num == 3)
+        {
+            if (dims == 4)
+            {
+                repeat_d = repeats_ptr[0];
+                repeat_h = repeats_ptr[1];
+                repeat_w = repeats_ptr[2];
+            }
+            else
+            {
+                repeat_c = repeats_ptr[0];
+                repeat_h = repeats_ptr[1];
+                repeat_w = repeats_ptr[2];
+            }
+        }
+        if (repeats_num == 4)
+        {
+            repeat_c = repeats_ptr[0];
+            repeat_d = repeats_ptr[1];
+            repeat_h = repeats_ptr[2];
+            repeat_w = repeats_ptr[3];
+        }
+    }
+
+    const int outdims = std::max(dims, repeats_num);
+
+    if (repeat_w == 1 && repeat_h == 1 && repeat_d == 1 && repeat_c == 1 && (repeats_num == 0 || dims == repeats_num))
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    if (outdims != dims)
+    {
+        // rank expansion, fallback to the unpacked reference
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (elempack != 1)
+        {
+            Option opt_pack = opt;
+            opt_pack.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return Tile::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    // view the blob as outer packed groups of w x h x d, the outermost axis repeats whole groups
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int d = bottom_blob.d;
+    int outer = bottom_blob.c;
+    int repeat_outer = repeat_c;
+    size_t gstep = bottom_blob.cstep;
+    if (dims == 1)
+    {
+        outer = w;
+        w = 1;
+        repeat_outer = repeat_w;
+        repeat_w = 1;
+        gstep = 1;
+    }
+    if (dims == 2)
+    {
+        outer = h;
+        h = 1;
+        repeat_outer = repeat_h;
+        repeat_h = 1;
+        gstep = w;
+    }
+
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (dims == 1)
+        top_blob.create(outer * repeat_outer, elemsize, elempack, opt.blob_allocator);
+    if (dims == 2)
+        top_blob.create(w * repeat_w, outer * repeat_outer, elemsize, elempack, opt.blob_allocator);
+    if (dims == 3)
+        top_blob.create(w * repeat_w, h * repeat_h, outer * repeat_outer, elemsize, elempack, opt.blob_allocator);
+    if (dims == 4)
+        top_blob.create(w * repeat_w, h * repeat_h, d * repeat_d, outer * repeat_outer, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const size_t out_gstep = dims >= 3 ? top_blob.cstep : (size_t)w * repeat_w;
+
+    // one packed element is elemsize bytes, copy rows of whole packs
+    const size_t row_size = w * elemsize;
+    const size_t out_row_size = row_size * repeat_w;
+
+    const int outer_count = outer * repeat_outer;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int qo = 0; qo < outer_count; qo++)
+    {
+        const unsigned char* ptr0 = (const unsigned char*)bottom_blob.data + (qo % outer) * gstep * elemsize;
+        unsigned char* outptr0 = (unsigned char*)top_blob.data + qo * out_gstep * elemsize;
+
+        // repeat 0-w
+        for (int z = 0; z < d; z++)
+        {
+            for (int y = 0; y < h; y++)
+            {
+                const unsigned char* ptr = ptr0 + (z * h + y) * row_size;
+                unsigned char* outptr = outptr0 + (z * h * repeat_h + y) * out_row_size;
+
+                for (int p = 0; p < repeat_w; p++)
+                {
+                    memcpy(outptr, ptr, row_size);
+                    outptr += row_size;
+                }
+            }
+        }
+
+        // repeat 1-h
+        for (int z = 0; z < d; z++)
+        {
+            const unsigned char* ptr = outptr0 + z * h * repeat_h * out_row_size;
+            unsigned char* outptr = outptr0 + (z * h * repeat_h + h) * out_row_size;
+
+            const size_t size = h * out_row_size;
+            for (int p = 1; p < repeat_h; p++)
+            {
+                memcpy(outptr, ptr, size);
+                outptr += size;
+            }
+        }
+
+        // repeat 1-d
+        {
+            const size_t size = d * h * repeat_h * out_row_size;
+
+            unsigned char* outptr = outptr0 + size;
+            for (int p = 1; p < repeat_d; p++)
+            {
+                memcpy(outptr, outptr0, size);
+                outptr += size;
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,585 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef X86_BF16S_H
+#define X86_BF16S_H
+
+// bf16 storage for x86 layers computing in fp32
+// include inside namespace ncnn after x86_usability.h
+
+static inline void bfloat2float_row(const unsigned short* ptr, float* outptr, int size)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(outptr, bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)ptr)));
+        ptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(outptr, bfloat2float_avx(_mm_loadu_si128((const __m128i*)ptr)));
+        ptr += 8;
+        outptr += 8;
+    }
+#endif // __AVX__
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(outptr, bfloat2float_sse(_mm_loadl_epi64((const __m128i*)ptr)));
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        *outptr++ = bfloat16_to_float32(*ptr++);
+    }
+}
+
+static inline void float2bfloat_row(const float* ptr, unsigned short* outptr, int size)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm256_storeu_si256((__m256i*)outptr, float2bfloat_avx512(_mm512_loadu_ps(ptr)));
+        ptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm_storeu_si128((__m128i*)outptr, float2bfloat_avx(_mm256_loadu_ps(ptr)));
+        ptr += 8;
+        outptr += 8;
+    }
+#else  // __AVX__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm_storeu_si128((__m128i*)outptr, float2bfloat_sse(_mm_loadu_ps(ptr), _mm_loadu_ps(ptr + 4)));
+        ptr += 8;
+        outptr += 8;
+    }
+#endif // __AVX__
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        *outptr++ = float32_to_bfloat16(*ptr++);
+    }
+}
+
+// bf16 element of packed weights and blobs in kernels templated on the storage type
+// reads widen to fp32 and writes narrow to bf16, so the scalar kernel code is shared with fp32
+struct bfloat16_t
+{
+    unsigned short u;
+
+    NCNN_FORCEINLINE operator float() const
+    {
+        return bfloat16_to_float32(u);
+    }
+
+    NCNN_FORCEINLINE bfloat16_t& operator=(float v)
+    {
+        u = float32_to_bfloat16(v);
+        return *this;
+    }
+};
+
+// packed fp32 weight tiles to bf16 with the same shape
+static inline int cast_packed_weight_bf16s(const Mat& weight_fp32, Mat& weight_bf16)
+{
+    weight_bf16.create(weight_fp32.w, weight_fp32.h, weight_fp32.c, 2u, (Allocator*)0);
+    if (weight_bf16.empty())
+        return -100;
+
+    for (int q = 0; q < weight_fp32.c; q++)
+    {
+        float2bfloat_row(weight_fp32.channel(q), weight_bf16.channel(q), weight_fp32.w * weight_fp32.h);
+    }
+
+    return 0;
+}
+
+// bf16 weight loads, the fp32 and fp16 ones are in x86_fp16s.h
+static NCNN_FORCEINLINE float load_weight(const bfloat16_t* ptr)
+{
+    return ptr[0];
+}
+
+#if __SSE2__
+static NCNN_FORCEINLINE __m128 _mm_load_weight_ps(const bfloat16_t* ptr)
+{
+    return bfloat2float_sse(_mm_loadl_epi64((const __m128i*)ptr));
+}
+
+static NCNN_FORCEINLINE __m128 _mm_loadu_weight_ps(const bfloat16_t* ptr)
+{
+    return bfloat2float_sse(_mm_loadl_epi64((const __m128i*)ptr));
+}
+
+#if __AVX__
+static NCNN_FORCEINLINE __m256 _mm256_load_weight_ps(const bfloat16_t* ptr)
+{
+    return bfloat2float_avx(_mm_loadu_si128((const __m128i*)ptr));
+}
+
+#if __AVX512F__
+static NCNN_FORCEINLINE __m512 _mm512_load_weight_ps(const bfloat16_t* ptr)
+{
+    return bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)ptr));
+}
+#endif // __AVX512F__
+#endif // __AVX__
+
+// blob loads and stores for kernels templated on fp32 or bf16 blobs
+static NCNN_FORCEINLINE __m128 _mm_load_blob_ps(const float* ptr)
+{
+    return _mm_load_ps(ptr);
+}
+
+static NCNN_FORCEINLINE __m128 _mm_loadu_blob_ps(const float* ptr)
+{
+    return _mm_loadu_ps(ptr);
+}
+
+static NCNN_FORCEINLINE void _mm_store_blob_ps(float* ptr, const __m128& _v)
+{
+    _mm_store_ps(ptr, _v);
+}
+
+static NCNN_FORCEINLINE void _mm_storeu_blob_ps(float* ptr, const __m128& _v)
+{
+    _mm_storeu_ps(ptr, _v);
+}
+
+static NCNN_FORCEINLINE __m128 _mm_load_blob_ps(const bfloat16_t* ptr)
+{
+    return bfloat2float_sse(_mm_loadl_epi64((const __m128i*)ptr));
+}
+
+static NCNN_FORCEINLINE __m128 _mm_loadu_blob_ps(const bfloat16_t* ptr)
+{
+    return bfloat2float_sse(_mm_loadl_epi64((const __m128i*)ptr));
+}
+
+static NCNN_FORCEINLINE void _mm_store_blob_ps(bfloat16_t* ptr, const __m128& _v)
+{
+    _mm_storel_epi64((__m128i*)ptr, float2bfloat_sse(_v, _v));
+}
+
+static NCNN_FORCEINLINE void _mm_storeu_blob_ps(bfloat16_t* ptr, const __m128& _v)
+{
+    _mm_storel_epi64((__m128i*)ptr, float2bfloat_sse(_v, _v));
+}
+
+#if __AVX__
+static NCNN_FORCEINLINE __m256 _mm256_load_blob_ps(const float* ptr)
+{
+    return _mm256_load_ps(ptr);
+}
+
+static NCNN_FORCEINLINE __m256 _mm256_loadu_blob_ps(const float* ptr)
+{
+    return _mm256_loadu_ps(ptr);
+}
+
+static NCNN_FORCEINLINE void _mm256_store_blob_ps(float* ptr, const __m256& _v)
+{
+    _mm256_store_ps(ptr, _v);
+}
+
+static NCNN_FORCEINLINE void _mm256_storeu_blob_ps(float* ptr, const __m256& _v)
+{
+    _mm256_storeu_ps(ptr, _v);
+}
+
+static NCNN_FORCEINLINE __m256 _mm256_load_blob_ps(const bfloat16_t* ptr)
+{
+    return bfloat2float_avx(_mm_loadu_si128((const __m128i*)ptr));
+}
+
+static NCNN_FORCEINLINE __m256 _mm256_loadu_blob_ps(const bfloat16_t* ptr)
+{
+    return bfloat2float_avx(_mm_loadu_si128((const __m128i*)ptr));
+}
+
+static NCNN_FORCEINLINE void _mm256_store_blob_ps(bfloat16_t* ptr, const __m256& _v)
+{
+    _mm_storeu_si128((__m128i*)ptr, float2bfloat_avx(_v));
+}
+
+static NCNN_FORCEINLINE void _mm256_storeu_blob_ps(bfloat16_t* ptr, const __m256& _v)
+{
+    _mm_storeu_si128((__m128i*)ptr, float2bfloat_avx(_v));
+}
+
+#if __AVX512F__
+static NCNN_FORCEINLINE __m512 _mm512_load_blob_ps(const float* ptr)
+{
+    return _mm512_load_ps(ptr);
+}
+
+static NCNN_FORCEINLINE __m512 _mm512_loadu_blob_ps(const float* ptr)
+{
+    return _mm512_loadu_ps(ptr);
+}
+
+static NCNN_FORCEINLINE void _mm512_store_blob_ps(float* ptr, const __m512& _v)
+{
+    _mm512_store_ps(ptr, _v);
+}
+
+static NCNN_FORCEINLINE void _mm512_storeu_blob_ps(float* ptr, const __m512& _v)
+{
+    _mm512_storeu_ps(ptr, _v);
+}
+
+static NCNN_FORCEINLINE __m512 _mm512_load_blob_ps(const bfloat16_t* ptr)
+{
+    return bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)ptr));
+}
+
+static NCNN_FORCEINLINE __m512 _mm512_loadu_blob_ps(const bfloat16_t* ptr)
+{
+    return bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)ptr));
+}
+
+static NCNN_FORCEINLINE void _mm512_store_blob_ps(bfloat16_t* ptr, const __m512& _v)
+{
+    _mm256_storeu_si256((__m256i*)ptr, float2bfloat_avx512(_v));
+}
+
+static NCNN_FORCEINLINE void _mm512_storeu_blob_ps(bfloat16_t* ptr, const __m512& _v)
+{
+    _mm256_storeu_si256((__m256i*)ptr, float2bfloat_avx512(_v));
+}
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+static inline void create_like_fp32(Mat& m, const Mat& ref, Allocator* allocator)
+{
+    const size_t elemsize = 4u * ref.elempack;
+
+    if (ref.dims == 1) m.create(ref.w, elemsize, ref.elempack, allocator);
+    if (ref.dims == 2) m.create(ref.w, ref.h, elemsize, ref.elempack, allocator);
+    if (ref.dims == 3) m.create(ref.w, ref.h, ref.c, elemsize, ref.elempack, allocator);
+    if (ref.dims == 4) m.create(ref.w, ref.h, ref.d, ref.c, elemsize, ref.elempack, allocator);
+}
+
+static inline void create_like_bf16(Mat& m, const Mat& ref, Allocator* allocator)
+{
+    const size_t elemsize = 2u * ref.elempack;
+
+    if (ref.dims == 1) m.create(ref.w, elemsize, ref.elempack, allocator);
+    if (ref.dims == 2) m.create(ref.w, ref.h, elemsize, ref.elempack, allocator);
+    if (ref.dims == 3) m.create(ref.w, ref.h, ref.c, elemsize, ref.elempack, allocator);
+    if (ref.dims == 4) m.create(ref.w, ref.h, ref.d, ref.c, elemsize, ref.elempack, allocator);
+}
+
+// src and dst have the same shape, channel padding is left untouched
+static inline void cast_bf16_to_fp32_blob(const Mat& src, Mat& dst, const Option& opt)
+{
+    if (src.dims <= 2)
+    {
+        bfloat2float_row(src, dst, src.w * src.h * src.elempack);
+        return;
+    }
+
+    const int size = src.w * src.h * src.d * src.elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < src.c; q++)
+    {
+        bfloat2float_row(src.channel(q), dst.channel(q), size);
+    }
+}
+
+static inline void cast_fp32_to_bf16_blob(const Mat& src, Mat& dst, const Option& opt)
+{
+    if (src.dims <= 2)
+    {
+        float2bfloat_row(src, dst, src.w * src.h * src.elempack);
+        return;
+    }
+
+    const int size = src.w * src.h * src.d * src.elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < src.c; q++)
+    {
+        float2bfloat_row(src.channel(q), dst.channel(q), size);
+    }
+}
+
+// channels, or rows of 2d blob, converted at once
+// about 64KB fp32 per thread so that a block stays in cache between the casts and the fp32 kernel
+static inline int get_bf16s_block_size(const Mat& m, int outer, int num_threads)
+{
+    const size_t unit_size = m.dims >= 3 ? m.cstep * m.elempack : (size_t)m.w * m.elempack;
+
+    int block = (int)((16384 * (size_t)num_threads) / std::max(unit_size, (size_t)1));
+    block = std::max(block, num_threads);
+
+    return std::min(block, outer);
+}
+
+// elementwise layers, the fp32 forward_inplace runs on cached fp32 blocks
+static inline int layer_forward_inplace_bf16s(const Layer* layer, Mat& bottom_top_blob, const Option& opt)
+{
+    Option opt_fp32 = opt;
+    opt_fp32.use_bf16_storage = false;
+    opt_fp32.blob_allocator = opt.workspace_allocator;
+
+    const int dims = bottom_top_blob.dims;
+    const int outer = dims == 1 ? 1 : dims == 2 ? bottom_top_blob.h : bottom_top_blob.c;
+    const int block = dims == 1 ? 1 : get_bf16s_block_size(bottom_top_blob, outer, opt.num_threads);
+
+    Mat block_fp32;
+    for (int q = 0; q < outer; q += block)
+    {
+        const int n = std::min(block, outer - q);
+
+        Mat m = dims == 1 ? bottom_top_blob : dims == 2 ? bottom_top_blob.row_range(q, n) : bottom_top_blob.channel_range(q, n);
+
+        create_like_fp32(block_fp32, m, opt.workspace_allocator);
+        if (block_fp32.empty())
+            return -100;
+
+        cast_bf16_to_fp32_blob(m, block_fp32, opt);
+
+        int ret = layer->forward_inplace(block_fp32, opt_fp32);
+        if (ret != 0)
+            return ret;
+
+        cast_fp32_to_bf16_blob(block_fp32, m, opt);
+    }
+
+    return 0;
+}
+
+// 16-bit blobs are packed by 4, repack to the layout the fp32 kernels were prepared for
+static inline int repack_fp32_blob(Mat& m, const Option& opt)
+{
+    const int elemcount = (m.dims == 1 ? m.w : m.dims == 2 ? m.h : m.c) * m.elempack;
+
+    int dst_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        dst_elempack = elemcount % 16 == 0 ? 16 : elemcount % 8 == 0 ? 8 : elemcount % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        dst_elempack = elemcount % 8 == 0 ? 8 : elemcount % 4 == 0 ? 4 : 1;
+#else
+        dst_elempack = elemcount % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    if (m.elempack == dst_elempack)
+        return 0;
+
+    Mat m_packed;
+    convert_packing(m, m_packed, dst_elempack, opt);
+    if (m_packed.empty())
+        return -100;
+
+    m = m_packed;
+    return 0;
+}
+
+static inline int layer_forward_fp32(const Layer* layer, const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt)
+{
+    if (layer->one_blob_only)
+        return layer->forward(bottom_blobs[0], top_blobs[0], opt);
+
+    return layer->forward(bottom_blobs, top_blobs, opt);
+}
+
+// cast bf16 inputs to fp32, run the fp32 forward and cast the outputs back
+// channel_blocks streams channels through cache for layers computing every channel on its own,
+// the extra inputs are passed as is and the first output keeps the channel count or collapses to 1d
+static inline int layer_forward_bf16s(const Layer* layer, const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, bool channel_blocks, const Option& opt)
+{
+    Option opt_fp32 = opt;
+    opt_fp32.use_bf16_storage = false;
+    opt_fp32.blob_allocator = opt.workspace_allocator;
+
+    const Mat& bottom_blob = bottom_blobs[0];
+
+    if (!channel_blocks || bottom_blob.dims < 3 || top_blobs.size() != 1)
+    {
+        std::vector<Mat> bottom_blobs_fp32(bottom_blobs.size());
+        for (size_t i = 0; i < bottom_blobs.size(); i++)
+        {
+            if (bottom_blobs[i].elembits() != 16)
+            {
+                bottom_blobs_fp32[i] = bottom_blobs[i];
+                continue;
+            }
+
+            create_like_fp32(bottom_blobs_fp32[i], bottom_blobs[i], opt.workspace_allocator);
+            if (bottom_blobs_fp32[i].empty())
+                return -100;
+
+            cast_bf16_to_fp32_blob(bottom_blobs[i], bottom_blobs_fp32[i], opt);
+
+            if (layer->support_packing)
+            {
+                int ret = repack_fp32_blob(bottom_blobs_fp32[i], opt_fp32);
+                if (ret != 0)
+                    return ret;
+            }
+        }
+
+        std::vector<Mat> top_blobs_fp32(top_blobs.size());
+        int ret = layer_forward_fp32(layer, bottom_blobs_fp32, top_blobs_fp32, opt_fp32);
+        if (ret != 0)
+            return ret;
+
+        for (size_t i = 0; i < top_blobs.size(); i++)
+        {
+            if (top_blobs_fp32[i].elembits() != 32)
+            {
+                top_blobs[i] = top_blobs_fp32[i];
+                continue;
+            }
+
+            create_like_bf16(top_blobs[i], top_blobs_fp32[i], opt.blob_allocator);
+            if (top_blobs[i].empty())
+                return -100;
+
+            cast_fp32_to_bf16_blob(top_blobs_fp32[i], top_blobs[i], opt);
+        }
+
+        return 0;
+    }
+
+    const int channels = bottom_blob.c;
+    const int block = get_bf16s_block_size(bottom_blob, channels, opt.num_threads);
+
+    std::vector<Mat> bottom_blobs_fp32 = bottom_blobs;
+    std::vector<Mat> top_blobs_fp32(1);
+
+    Mat& top_blob = top_blobs[0];
+
+    for (int q = 0; q < channels; q += block)
+    {
+        const int n = std::min(block, channels - q);
+
+        const Mat m = bottom_blob.channel_range(q, n);
+
+        Mat& block_fp32 = bottom_blobs_fp32[0];
+        create_like_fp32(block_fp32, m, opt.workspace_allocator);
+        if (block_fp32.empty())
+            return -100;
+
+        cast_bf16_to_fp32_blob(m, block_fp32, opt);
+
+        int ret = layer_forward_fp32(layer, bottom_blobs_fp32, top_blobs_fp32, opt_fp32);
+        if (ret != 0)
+            return ret;
+
+        const Mat& top_block_fp32 = top_blobs_fp32[0];
+
+        if (top_block_fp32.dims == 1)
+        {
+            // one value per channel
+            if (q == 0)
+            {
+                top_blob.create(channels, 2u * top_block_fp32.elempack, top_block_fp32.elempack, opt.blob_allocator);
+                if (top_blob.empty())
+                    return -100;
+            }
+
+            Mat top_block = top_blob.range(q, n);
+            cast_fp32_to_bf16_blob(top_block_fp32, top_block, opt);
+            continue;
+        }
+
+        if (top_block_fp32.dims < 3 || top_block_fp32.c != n)
+        {
+            NCNN_LOGE("layer_forward_bf16s channel blocks changed channel count %d -> %d", n, top_block_fp32.c);
+            return -1;
+        }
+
+        if (q == 0)
+        {
+            const size_t out_elemsize = 2u * top_block_fp32.elempack;
+
+            if (top_block_fp32.dims == 3)
+                top_blob.create(top_block_fp32.w, top_block_fp32.h, channels, out_elemsize, top_block_fp32.elempack, opt.blob_allocator);
+            else
+                top_blob.create(top_block_fp32.w, top_block_fp32.h, top_block_fp32.d, channels, out_elemsize, top_block_fp32.elempack, opt.blob_allocator);
+            if (top_blob.empty())
+                return -100;
+        }
+
+        Mat top_block = top_blob.channel_range(q, n);
+        cast_fp32_to_bf16_blob(top_block_fp32, top_block, opt);
+    }
+
+    return 0;
+}
+
+static inline int layer_forward_bf16s(const Layer* layer, const Mat& bottom_blob, Mat& top_blob, bool channel_blocks, const Option& opt)
+{
+    std::vector<Mat> bottom_blobs(1, bottom_blob);
+    std::vector<Mat> top_blobs(1);
+
+    int ret = layer_forward_bf16s(layer, bottom_blobs, top_blobs, channel_blocks, opt);
+
+    top_blob = top_blobs[0];
+
+    return ret;
+}
+
+// bf16 kernels fed with fp32 blobs by a host layer running them as a sublayer
+static inline int layer_forward_fp32_bf16s(const Layer* layer, const Mat& bottom_blob, Mat& top_blob, const Option& opt)
+{
+    Option opt_bf16 = opt;
+    opt_bf16.blob_allocator = opt.workspace_allocator;
+
+    Mat bottom_blob_bf16;
+    create_like_bf16(bottom_blob_bf16, bottom_blob, opt.workspace_allocator);
+    if (bottom_blob_bf16.empty())
+        return -100;
+
+    cast_fp32_to_bf16_blob(bottom_blob, bottom_blob_bf16, opt);
+
+    // 16-bit blobs are packed by 4
+    const int elemcount = (bottom_blob.dims == 1 ? bottom_blob.w : bottom_blob.dims == 2 ? bottom_blob.h : bottom_blob.c) * bottom_blob.elempack;
+    const int elempack = layer->support_packing && opt.use_packing_layout && elemcount % 4 == 0 ? 4 : 1;
+    if (bottom_blob_bf16.elempack != elempack)
+    {
+        Mat bottom_blob_bf16_packed;
+        convert_packing(bottom_blob_bf16, bottom_blob_bf16_packed, elempack, opt_bf16);
+        if (bottom_blob_bf16_packed.empty())
+            return -100;
+
+        bottom_blob_bf16 = bottom_blob_bf16_packed;
+    }
+
+    Mat top_blob_bf16;
+    int ret = layer->forward(bottom_blob_bf16, top_blob_bf16, opt_bf16);
+    if (ret != 0)
+        return ret;
+
+    create_like_fp32(top_blob, top_blob_bf16, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    cast_bf16_to_fp32_blob(top_blob_bf16, top_blob, opt);
+
+    return 0;
+}
+
+#endif // X86_BF16S_H
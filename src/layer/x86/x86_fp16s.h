@@ -0,0 +1,166 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef X86_FP16S_H
+#define X86_FP16S_H
+
+// fp16 storage for packed weight tiles, widened to fp32 in registers by the kernels
+// include inside namespace ncnn after x86_usability.h, the fma and avx512 variants have f16c
+
+static inline void float16_to_float32_row(const unsigned short* ptr, float* outptr, int size)
+{
+    int i = 0;
+#if __F16C__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(outptr, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)ptr)));
+        ptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(outptr, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)ptr)));
+        ptr += 8;
+        outptr += 8;
+    }
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(outptr, _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)ptr)));
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __F16C__
+    for (; i < size; i++)
+    {
+        *outptr++ = float16_to_float32(*ptr++);
+    }
+}
+
+static inline void float32_to_float16_row(const float* ptr, unsigned short* outptr, int size)
+{
+    int i = 0;
+#if __F16C__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm256_storeu_si256((__m256i*)outptr, _mm512_cvtps_ph(_mm512_loadu_ps(ptr), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+        ptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm_storeu_si128((__m128i*)outptr, _mm256_cvtps_ph(_mm256_loadu_ps(ptr), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+        ptr += 8;
+        outptr += 8;
+    }
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storel_epi64((__m128i*)outptr, _mm_cvtps_ph(_mm_loadu_ps(ptr), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __F16C__
+    for (; i < size; i++)
+    {
+        *outptr++ = float32_to_float16(*ptr++);
+    }
+}
+
+// packed fp32 weight tiles to fp16 with the same shape
+static inline int cast_packed_weight_fp16s(const Mat& weight_fp32, Mat& weight_fp16)
+{
+    weight_fp16.create(weight_fp32.w, weight_fp32.h, weight_fp32.c, 2u, (Allocator*)0);
+    if (weight_fp16.empty())
+        return -100;
+
+    for (int q = 0; q < weight_fp32.c; q++)
+    {
+        float32_to_float16_row(weight_fp32.channel(q), weight_fp16.channel(q), weight_fp32.w * weight_fp32.h);
+    }
+
+    return 0;
+}
+
+// fp16 keeps these weights bitwise, as for models stored with fp16 weights
+static inline bool weight_fp16_exact(const Mat& weight)
+{
+    for (int q = 0; q < weight.c; q++)
+    {
+        const float* ptr = weight.channel(q);
+        const int size = weight.w * weight.h * weight.d * weight.elempack;
+
+        for (int i = 0; i < size; i++)
+        {
+            if (float16_to_float32(float32_to_float16(ptr[i])) != ptr[i])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// weight loads for kernels templated on fp32 or fp16 weights, fp16 is widened in registers
+static NCNN_FORCEINLINE float load_weight(const float* ptr)
+{
+    return ptr[0];
+}
+
+#if __SSE2__
+static NCNN_FORCEINLINE __m128 _mm_load_weight_ps(const float* ptr)
+{
+    return _mm_load_ps(ptr);
+}
+
+static NCNN_FORCEINLINE __m128 _mm_loadu_weight_ps(const float* ptr)
+{
+    return _mm_loadu_ps(ptr);
+}
+
+#if __AVX__
+static NCNN_FORCEINLINE __m256 _mm256_load_weight_ps(const float* ptr)
+{
+    return _mm256_load_ps(ptr);
+}
+
+#if __AVX512F__
+static NCNN_FORCEINLINE __m512 _mm512_load_weight_ps(const float* ptr)
+{
+    return _mm512_load_ps(ptr);
+}
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#if __F16C__
+static NCNN_FORCEINLINE float load_weight(const unsigned short* ptr)
+{
+    return _cvtsh_ss(ptr[0]);
+}
+
+static NCNN_FORCEINLINE __m128 _mm_load_weight_ps(const unsigned short* ptr)
+{
+    return _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)ptr));
+}
+
+static NCNN_FORCEINLINE __m128 _mm_loadu_weight_ps(const unsigned short* ptr)
+{
+    return _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)ptr));
+}
+
+static NCNN_FORCEINLINE __m256 _mm256_load_weight_ps(const unsigned short* ptr)
+{
+    return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)ptr));
+}
+
+#if __AVX512F__
+static NCNN_FORCEINLINE __m512 _mm512_load_weight_ps(const unsigned short* ptr)
+{
+    return _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)ptr));
+}
+#endif // __AVX512F__
+#endif // __F16C__
+
+#endif // X86_FP16S_H
@@ -1824,4 +1824,86 @@ static NCNN_FORCEINLINE __m512i float2bfloat_avx512(const __m512& v0, const __m5
 #endif // __AVX__
 #endif // __SSE2__
 
+#if __SSE2__
+// transpose elempack x elempack floats, ptrs and outptrs point to the rows
+static NCNN_FORCEINLINE void transpose_packed_ps(const float* const* ptrs, float* const* outptrs, int elempack)
+{
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        __m512 _r0 = _mm512_loadu_ps(ptrs[0]);
+        __m512 _r1 = _mm512_loadu_ps(ptrs[1]);
+        __m512 _r2 = _mm512_loadu_ps(ptrs[2]);
+        __m512 _r3 = _mm512_loadu_ps(ptrs[3]);
+        __m512 _r4 = _mm512_loadu_ps(ptrs[4]);
+        __m512 _r5 = _mm512_loadu_ps(ptrs[5]);
+        __m512 _r6 = _mm512_loadu_ps(ptrs[6]);
+        __m512 _r7 = _mm512_loadu_ps(ptrs[7]);
+        __m512 _r8 = _mm512_loadu_ps(ptrs[8]);
+        __m512 _r9 = _mm512_loadu_ps(ptrs[9]);
+        __m512 _ra = _mm512_loadu_ps(ptrs[10]);
+        __m512 _rb = _mm512_loadu_ps(ptrs[11]);
+        __m512 _rc = _mm512_loadu_ps(ptrs[12]);
+        __m512 _rd = _mm512_loadu_ps(ptrs[13]);
+        __m512 _re = _mm512_loadu_ps(ptrs[14]);
+        __m512 _rf = _mm512_loadu_ps(ptrs[15]);
+        transpose16x16_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb, _rc, _rd, _re, _rf);
+        _mm512_storeu_ps(outptrs[0], _r0);
+        _mm512_storeu_ps(outptrs[1], _r1);
+        _mm512_storeu_ps(outptrs[2], _r2);
+        _mm512_storeu_ps(outptrs[3], _r3);
+        _mm512_storeu_ps(outptrs[4], _r4);
+        _mm512_storeu_ps(outptrs[5], _r5);
+        _mm512_storeu_ps(outptrs[6], _r6);
+        _mm512_storeu_ps(outptrs[7], _r7);
+        _mm512_storeu_ps(outptrs[8], _r8);
+        _mm512_storeu_ps(outptrs[9], _r9);
+        _mm512_storeu_ps(outptrs[10], _ra);
+        _mm512_storeu_ps(outptrs[11], _rb);
+        _mm512_storeu_ps(outptrs[12], _rc);
+        _mm512_storeu_ps(outptrs[13], _rd);
+        _mm512_storeu_ps(outptrs[14], _re);
+        _mm512_storeu_ps(outptrs[15], _rf);
+        return;
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        __m256 _r0 = _mm256_loadu_ps(ptrs[0]);
+        __m256 _r1 = _mm256_loadu_ps(ptrs[1]);
+        __m256 _r2 = _mm256_loadu_ps(ptrs[2]);
+        __m256 _r3 = _mm256_loadu_ps(ptrs[3]);
+        __m256 _r4 = _mm256_loadu_ps(ptrs[4]);
+        __m256 _r5 = _mm256_loadu_ps(ptrs[5]);
+        __m256 _r6 = _mm256_loadu_ps(ptrs[6]);
+        __m256 _r7 = _mm256_loadu_ps(ptrs[7]);
+        transpose8x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
+        _mm256_storeu_ps(outptrs[0], _r0);
+        _mm256_storeu_ps(outptrs[1], _r1);
+        _mm256_storeu_ps(outptrs[2], _r2);
+        _mm256_storeu_ps(outptrs[3], _r3);
+        _mm256_storeu_ps(outptrs[4], _r4);
+        _mm256_storeu_ps(outptrs[5], _r5);
+        _mm256_storeu_ps(outptrs[6], _r6);
+        _mm256_storeu_ps(outptrs[7], _r7);
+        return;
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        __m128 _r0 = _mm_loadu_ps(ptrs[0]);
+        __m128 _r1 = _mm_loadu_ps(ptrs[1]);
+        __m128 _r2 = _mm_loadu_ps(ptrs[2]);
+        __m128 _r3 = _mm_loadu_ps(ptrs[3]);
+        _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
+        _mm_storeu_ps(outptrs[0], _r0);
+        _mm_storeu_ps(outptrs[1], _r1);
+        _mm_storeu_ps(outptrs[2], _r2);
+        _mm_storeu_ps(outptrs[3], _r3);
+        return;
+    }
+}
+#endif // __SSE2__
+
 #endif // X86_USABILITY_H
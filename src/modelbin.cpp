@@ -183,6 +183,35 @@ Mat ModelBinFromDataReader::load(int w, int type) const
 
             return m;
         }
+        else if (flag_struct.tag == 0x000D4B34)
+        {
+            // int4 data, two values per byte, low nibble first
+            size_t align_data_size = alignSize((w + 1) / 2, 4);
+
+            std::vector<unsigned char> int4_weights;
+            int4_weights.resize(align_data_size);
+            nread = d->dr.read(&int4_weights[0], align_data_size);
+            if (nread != align_data_size)
+            {
+                NCNN_LOGE("ModelBin read int4_weights failed %zd", nread);
+                return Mat();
+            }
+
+            // unpack to sign extended int8
+            m.create(w, (size_t)1u);
+            if (m.empty())
+                return m;
+
+            signed char* ptr = m;
+            for (int i = 0; i < w; i++)
+            {
+                const unsigned char v = int4_weights[i / 2];
+                const int v4 = i % 2 == 0 ? v & 0x0f : v >> 4;
+                ptr[i] = (signed char)(v4 >= 8 ? v4 - 16 : v4);
+            }
+
+            return m;
+        }
         else if (flag_struct.tag == 0x0002C056)
         {
 #if !__BIG_ENDIAN__
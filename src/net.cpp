@@ -3,19 +3,26 @@
 
 #include "net.h"
 
+#include "atomicops.h"
 #include "cpu.h"
 #include "datareader.h"
+#include "layer/convolution.h"
+#include "layer/gemm.h"
+#include "layer/innerproduct.h"
+#include "layer/input.h"
 #include "layer_type.h"
 #include "modelbin.h"
 #include "paramdict.h"
+#include "profiler.h"
 
 #include <stdarg.h>
 #include <stdint.h>
 #include <string.h>
 
-#if NCNN_BENCHMARK
+#include <algorithm>
+#include <list>
+
 #include "benchmark.h"
-#endif // NCNN_BENCHMARK
 
 #if NCNN_VULKAN
 #include "command.h"
@@ -24,6 +31,26 @@
 
 namespace ncnn {
 
+#if NCNN_THREADS
+class BranchThreadPool;
+#endif // NCNN_THREADS
+class MemoryArenaAllocator;
+struct LayerProfile;
+
+// weights referenced from external memory are never freed
+class ReferencedWeightAllocator : public Allocator
+{
+public:
+    virtual void* fastMalloc(size_t /*size*/)
+    {
+        return 0;
+    }
+
+    virtual void fastFree(void* /*ptr*/)
+    {
+    }
+};
+
 class NetPrivate
 {
 public:
@@ -38,7 +65,15 @@ public:
 #endif // NCNN_VULKAN
 
     friend class Extractor;
-    int forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+    int forward_layer(int layer_index, std::vector<Mat>& blob_mats, Profiler* profiler, const Option& opt) const;
+    int forward_layer_branch_parallel(int layer_index, std::vector<Mat>& blob_mats, Profiler* profiler, const Option& opt) const;
+
+    // forward one layer whose bottom blobs are all ready
+    int run_layer(int layer_index, std::vector<Mat>& blob_mats, Profiler* profiler, const Option& opt) const;
+
+    // forward all samples, blob mats indexed by sample then blob
+    int forward_layer_batch(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, Profiler* profiler, const Option& opt) const;
+    int run_layer_batch(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, Profiler* profiler, const Option& opt) const;
 
 #if NCNN_VULKAN
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
@@ -46,7 +81,7 @@ public:
 
     int convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const;
 
-    int do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt) const;
+    int do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, LayerProfile* profile, const Option& opt) const;
 #if NCNN_VULKAN
     int do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
 #endif // NCNN_VULKAN
@@ -55,6 +90,41 @@ public:
 #if NCNN_STRING
     void update_input_output_names();
 #endif // NCNN_STRING
+    void update_layer_dependencies();
+
+    // choose fp32 or reduced precision storage for every layer before create_pipeline
+    void assign_layer_storage();
+
+    // bottom blobs cast or repacked before layer forward
+    mutable int layout_conversion_count;
+
+    // mark the layers the declared outputs depend on
+    void update_needed_layers();
+
+    // create_pipeline of a lazy layer on first forward, thread-safe
+    int create_lazy_pipeline(int layer_index) const;
+
+#if NCNN_STDIO
+    // pipeline weights of one layer in the weight cache file
+    struct WeightCacheEntry
+    {
+        uint64_t key;
+        std::vector<Mat> weights;
+    };
+
+    // map the weight cache file, entries are indexed by layer
+    // return 0 if success
+    int load_weight_cache(std::vector<WeightCacheEntry>& entries);
+    // write pipeline weights of all layers with their keys
+    // return 0 if success
+    int save_weight_cache(const std::vector<uint64_t>& layer_keys) const;
+#endif // NCNN_STDIO
+
+    // arena for one extractor drawn from the memory plan
+    MemoryArenaAllocator* acquire_memory_arena();
+    void reclaim_memory_arena(MemoryArenaAllocator* arena);
+    void clear_memory_arenas();
+    bool memory_arenas_in_use();
 
     std::vector<Blob> blobs;
     std::vector<Layer*> layers;
@@ -72,6 +142,65 @@ public:
     PoolAllocator* local_blob_allocator;
     PoolAllocator* local_workspace_allocator;
 
+    // distinct producer layers of bottom blobs
+    std::vector<std::vector<int> > layer_producers;
+    // distinct consumer layers of top blobs
+    std::vector<std::vector<int> > layer_consumers;
+    // the max number of layers that may run at the same time
+    int max_branch_width;
+
+#if NCNN_THREADS
+    mutable Mutex branch_thread_pool_lock;
+    mutable BranchThreadPool* branch_thread_pool;
+#endif // NCNN_THREADS
+
+    // arena offset and size of every allocation in the planned order
+    std::vector<size_t> memory_plan_offsets;
+    std::vector<size_t> memory_plan_sizes;
+    // the earlier allocations overlapping one and overlapped by no allocation in between
+    // they must be freed before it is taken in the planned order
+    std::vector<std::vector<int> > memory_plan_predecessors;
+    size_t memory_plan_bytes;
+
+    Mutex memory_arenas_lock;
+    std::vector<MemoryArenaAllocator*> memory_arenas;
+
+    // weights referenced from model memory without copying
+    // the refcount drops to zero once the layer repacks and releases it
+    struct ReferencedWeight
+    {
+        int layer_index;
+        size_t size;
+        int* refcount;
+    };
+    std::vector<ReferencedWeight> referenced_weights;
+    ReferencedWeightAllocator referenced_weight_allocator;
+
+    // create layer pipelines on first forward
+    bool lazy_pipeline;
+    // the blobs extractors are going to extract, all if empty
+    std::vector<int> declared_output_indexes;
+    // layers the declared outputs depend on, all if empty
+    std::vector<char> needed_layers;
+    // layers whose create_pipeline has been called
+    // published atomically, lazy_pipeline_lock is only taken to create
+    mutable std::vector<int> created_layers;
+    mutable Mutex lazy_pipeline_lock;
+
+#if NCNN_STDIO
+    DataReaderFromMmap* model_mmap;
+
+    // weight cache file, disabled if empty
+    std::string weight_cache_path;
+    DataReaderFromMmap* weight_cache_mmap;
+
+    // param dict hash of every layer
+    std::vector<uint64_t> layer_param_hashes;
+
+    // size and mtime of the model file being loaded, 0 if not from a file
+    // weights are hashed for the cache key only when it is 0
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     const VulkanDevice* vkdev;
 
@@ -88,6 +217,22 @@ NetPrivate::NetPrivate(Option& _opt)
     local_blob_allocator = 0;
     local_workspace_allocator = 0;
 
+    max_branch_width = 1;
+
+#if NCNN_THREADS
+    branch_thread_pool = 0;
+#endif // NCNN_THREADS
+
+    memory_plan_bytes = 0;
+
+    lazy_pipeline = false;
+    layout_conversion_count = 0;
+
+#if NCNN_STDIO
+    model_mmap = 0;
+    weight_cache_mmap = 0;
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     vkdev = 0;
     weight_vkallocator = 0;
@@ -115,111 +260,1102 @@ static Option get_masked_option(const Option& opt, int featmask)
     if (featmask & (1 << 7))
         opt1.num_threads = 1;
 
-    return opt1;
+    return opt1;
+}
+
+#if NCNN_VULKAN
+int NetPrivate::upload_model()
+{
+    ncnn::VkTransfer cmd(vkdev);
+
+    // create gpu device allocator if null
+    if (!weight_vkallocator)
+    {
+        weight_vkallocator = new VkWeightAllocator(vkdev);
+    }
+    if (!weight_staging_vkallocator)
+    {
+        weight_staging_vkallocator = new VkWeightStagingAllocator(vkdev);
+    }
+
+    Option opt_upload = opt;
+    opt_upload.blob_allocator = 0;
+    opt_upload.workspace_allocator = 0;
+    opt_upload.blob_vkallocator = weight_vkallocator;
+    opt_upload.workspace_vkallocator = weight_vkallocator;
+    opt_upload.staging_vkallocator = weight_staging_vkallocator;
+
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (layers[i]->support_vulkan)
+        {
+            int uret = layers[i]->upload_model(cmd, get_masked_option(opt_upload, layers[i]->featmask));
+            if (uret != 0)
+            {
+                NCNN_LOGE("layer upload_model %d failed", (int)i);
+                return -1;
+            }
+        }
+    }
+
+    return cmd.submit_and_wait();
+}
+#endif // NCNN_VULKAN
+
+// layer run timestamps taken when profiling
+struct LayerProfile
+{
+    LayerProfile()
+    {
+        start = 0.0;
+        forward_start = 0.0;
+        converted = false;
+        bytes[0] = 0;
+        bytes[1] = 0;
+        convert_bytes[0] = 0;
+        convert_bytes[1] = 0;
+    }
+
+    // before and after layout conversion
+    double start;
+    double forward_start;
+    bool converted;
+
+    // bottom blobs before and after layout conversion
+    std::vector<Mat> bottom_shapes;
+    std::vector<Mat> converted_shapes;
+
+    // blob and workspace allocation, the part before forward_start is for layout conversion
+    size_t bytes[2];
+    size_t convert_bytes[2];
+};
+
+// points to the LayerProfile bytes of the layer running on the current thread
+static ThreadLocalStorage g_profiled_bytes;
+
+// counts the allocation for profiling and forwards to the real allocator
+class ProfiledAllocator : public Allocator
+{
+public:
+    ProfiledAllocator(int _index)
+        : allocator(0), index(_index)
+    {
+    }
+
+    virtual void* fastMalloc(size_t size)
+    {
+        size_t* bytes = (size_t*)g_profiled_bytes.get();
+        if (bytes)
+            bytes[index] += size;
+
+        return allocator ? allocator->fastMalloc(size) : ncnn::fastMalloc(size);
+    }
+
+    virtual void fastFree(void* ptr)
+    {
+        if (allocator)
+            allocator->fastFree(ptr);
+        else
+            ncnn::fastFree(ptr);
+    }
+
+public:
+    Allocator* allocator;
+
+    // 0=blob 1=workspace
+    int index;
+};
+
+static Mat get_blob_shape(const Mat& m)
+{
+    Mat shape;
+    shape.dims = m.dims;
+    shape.w = m.w;
+    shape.h = m.h;
+    shape.d = m.d;
+    shape.c = m.c;
+    shape.elempack = m.elempack;
+    shape.elemsize = m.elemsize;
+    return shape;
+}
+
+static void record_layer_profile(Profiler* profiler, int layer_index, const Layer* layer, const LayerProfile& profile, double end, const std::vector<Mat>& blob_mats, int num_threads)
+{
+    ProfilerRecord r;
+    r.layer_index = layer_index;
+#if NCNN_STRING
+    r.layer_type = layer->type;
+    r.layer_name = layer->name;
+#endif // NCNN_STRING
+    r.num_threads = num_threads;
+
+    if (profile.converted)
+    {
+        r.type = 1;
+        r.start = profile.start;
+        r.end = profile.forward_start;
+        r.bottom_shapes = profile.bottom_shapes;
+        r.top_shapes = profile.converted_shapes;
+        r.blob_bytes = profile.convert_bytes[0];
+        r.workspace_bytes = profile.convert_bytes[1];
+        profiler->record(r);
+    }
+
+    r.type = 0;
+    r.start = profile.forward_start;
+    r.end = end;
+    r.bottom_shapes = profile.converted_shapes;
+    r.top_shapes.resize(layer->tops.size());
+    for (size_t i = 0; i < layer->tops.size(); i++)
+    {
+        r.top_shapes[i] = get_blob_shape(blob_mats[layer->tops[i]]);
+    }
+    r.blob_bytes = profile.bytes[0] - profile.convert_bytes[0];
+    r.workspace_bytes = profile.bytes[1] - profile.convert_bytes[1];
+    profiler->record(r);
+}
+
+int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, Profiler* profiler, const Option& opt) const
+{
+    const Layer* layer = layers[layer_index];
+
+    //     NCNN_LOGE("forward_layer %d %s", layer_index, layer->name.c_str());
+
+    // load bottom blobs
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        int bottom_blob_index = layer->bottoms[i];
+
+        if (blob_mats[bottom_blob_index].dims == 0)
+        {
+            int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, profiler, opt);
+            if (ret != 0)
+                return ret;
+        }
+    }
+
+    return run_layer(layer_index, blob_mats, profiler, opt);
+}
+
+int NetPrivate::run_layer(int layer_index, std::vector<Mat>& blob_mats, Profiler* profiler, const Option& opt) const
+{
+    const Layer* layer = layers[layer_index];
+
+    if (lazy_pipeline)
+    {
+        int ret = create_lazy_pipeline(layer_index);
+        if (ret != 0)
+            return ret;
+    }
+
+#if NCNN_BENCHMARK
+    double start = get_current_time();
+    Mat bottom_blob;
+    if (layer->one_blob_only)
+    {
+        int bottom_blob_index = layer->bottoms[0];
+        bottom_blob.dims = blob_mats[bottom_blob_index].dims;
+        bottom_blob.w = blob_mats[bottom_blob_index].w;
+        bottom_blob.h = blob_mats[bottom_blob_index].h;
+        bottom_blob.d = blob_mats[bottom_blob_index].d;
+        bottom_blob.c = blob_mats[bottom_blob_index].c;
+        bottom_blob.elempack = blob_mats[bottom_blob_index].elempack;
+        bottom_blob.elemsize = blob_mats[bottom_blob_index].elemsize;
+    }
+#endif
+    LayerProfile profile;
+    if (profiler)
+    {
+        profile.start = get_current_time();
+        g_profiled_bytes.set(profile.bytes);
+    }
+
+    int ret = 0;
+    if (layer->featmask)
+    {
+        ret = do_forward_layer(layer, blob_mats, profiler ? &profile : 0, get_masked_option(opt, layer->featmask));
+    }
+    else
+    {
+        ret = do_forward_layer(layer, blob_mats, profiler ? &profile : 0, opt);
+    }
+
+    if (profiler)
+    {
+        double end = get_current_time();
+        g_profiled_bytes.set(0);
+
+        if (ret == 0)
+        {
+            const int num_threads = layer->featmask ? get_masked_option(opt, layer->featmask).num_threads : opt.num_threads;
+            record_layer_profile(profiler, layer_index, layer, profile, end, blob_mats, num_threads);
+        }
+    }
+#if NCNN_BENCHMARK
+    double end = get_current_time();
+    if (layer->one_blob_only)
+    {
+        int top_blob_index = layer->tops[0];
+        benchmark(layer, bottom_blob, blob_mats[top_blob_index], start, end);
+    }
+    else
+    {
+        benchmark(layer, start, end);
+    }
+#endif
+    if (ret != 0)
+        return ret;
+
+    //     NCNN_LOGE("forward_layer %d %s done", layer_index, layer->name.c_str());
+    //     const Mat& blob = blob_mats[layer->tops[0]];
+    //     NCNN_LOGE("[%-2d %-16s %-16s]  %d    blobs count = %-3d   size = %-3d x %-3d", layer_index, layer->type.c_str(), layer->name.c_str(), layer->tops[0], blob.c, blob.h, blob.w);
+
+    return 0;
+}
+
+// stack the rows of every sample into one 2d blob
+// 1d and higher rank samples are flattened into one row when keep_rows is false
+static int stack_batch_rows(const std::vector<std::vector<Mat> >& batch_blob_mats, int blob_index, bool keep_rows, Mat& stacked, int& rows, const Option& opt)
+{
+    const int batch = (int)batch_blob_mats.size();
+
+    for (int i = 0; i < batch; i++)
+    {
+        Mat m = batch_blob_mats[i][blob_index];
+        if (m.elempack != 1)
+        {
+            Mat m_unpacked;
+            convert_packing(m, m_unpacked, 1, opt);
+            m = m_unpacked;
+            if (m.empty())
+                return -100;
+        }
+
+        if (!keep_rows && m.dims != 1)
+        {
+            m = m.reshape(m.w * m.h * m.d * m.c, opt.workspace_allocator);
+            if (m.empty())
+                return -100;
+        }
+
+        if (i == 0)
+        {
+            rows = m.dims == 2 ? m.h : 1;
+            stacked.create(m.w, rows * batch, m.elemsize, opt.blob_allocator);
+            if (stacked.empty())
+                return -100;
+        }
+
+        memcpy(stacked.row<unsigned char>(i * rows), m.data, m.w * rows * m.elemsize);
+    }
+
+    return 0;
+}
+
+static int unstack_batch_rows(const Mat& stacked, int rows, bool flatten, std::vector<std::vector<Mat> >& batch_blob_mats, int blob_index, const Option& opt)
+{
+    const int batch = (int)batch_blob_mats.size();
+
+    Mat m = stacked;
+    if (m.elempack != 1)
+    {
+        convert_packing(stacked, m, 1, opt);
+        if (m.empty())
+            return -100;
+    }
+
+    for (int i = 0; i < batch; i++)
+    {
+        Mat& out = batch_blob_mats[i][blob_index];
+        if (flatten)
+            out.create(m.w, m.elemsize, opt.blob_allocator);
+        else
+            out.create(m.w, rows, m.elemsize, opt.blob_allocator);
+        if (out.empty())
+            return -100;
+
+        memcpy(out.data, m.row<const unsigned char>(i * rows), m.w * rows * m.elemsize);
+    }
+
+    return 0;
+}
+
+// stack the samples along height with zero rows in between
+// every sample starts at a multiple of stride_h so that its output rows stay contiguous
+static int stack_batch_convolution(const std::vector<std::vector<Mat> >& batch_blob_mats, int blob_index, const Convolution* convolution, Mat& stacked, int& step, const Option& opt)
+{
+    const int batch = (int)batch_blob_mats.size();
+
+    const Mat& m0 = batch_blob_mats[0][blob_index];
+    const int w = m0.w;
+    const int h = m0.h;
+    const int channels = m0.c;
+    const size_t elemsize = m0.elemsize;
+    const int elempack = m0.elempack;
+
+    // the gap serves as bottom padding of one sample and top padding of the next one
+    const int gap = std::max(convolution->pad_top, convolution->pad_bottom);
+    const int stride_h = convolution->stride_h;
+    const int period = (h + gap + stride_h - 1) / stride_h * stride_h;
+
+    stacked.create(w, period * (batch - 1) + h, channels, elemsize, elempack, opt.blob_allocator);
+    if (stacked.empty())
+        return -100;
+
+    const size_t plane_size = w * h * elemsize;
+    const size_t gap_size = w * (period - h) * elemsize;
+
+    for (int q = 0; q < channels; q++)
+    {
+        unsigned char* outptr = stacked.channel(q);
+
+        for (int i = 0; i < batch; i++)
+        {
+            memcpy(outptr, batch_blob_mats[i][blob_index].channel(q), plane_size);
+            outptr += plane_size;
+
+            if (i + 1 < batch)
+            {
+                memset(outptr, 0, gap_size);
+                outptr += gap_size;
+            }
+        }
+    }
+
+    step = period / stride_h;
+
+    return 0;
+}
+
+static int unstack_batch_convolution(const Mat& stacked, int step, std::vector<std::vector<Mat> >& batch_blob_mats, int blob_index, const Option& opt)
+{
+    const int batch = (int)batch_blob_mats.size();
+
+    const int outw = stacked.w;
+    const int outh = stacked.h - step * (batch - 1);
+    const int channels = stacked.c;
+
+    for (int i = 0; i < batch; i++)
+    {
+        Mat& out = batch_blob_mats[i][blob_index];
+        out.create(outw, outh, channels, stacked.elemsize, stacked.elempack, opt.blob_allocator);
+        if (out.empty())
+            return -100;
+
+        for (int q = 0; q < channels; q++)
+        {
+            memcpy(out.channel(q), stacked.channel(q).row<const unsigned char>(i * step), outw * outh * stacked.elemsize);
+        }
+    }
+
+    return 0;
+}
+
+int NetPrivate::forward_layer_batch(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, Profiler* profiler, const Option& opt) const
+{
+    const Layer* layer = layers[layer_index];
+
+    // load bottom blobs, all samples are forwarded together
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        int bottom_blob_index = layer->bottoms[i];
+
+        if (batch_blob_mats[0][bottom_blob_index].dims == 0)
+        {
+            int ret = forward_layer_batch(blobs[bottom_blob_index].producer, batch_blob_mats, profiler, opt);
+            if (ret != 0)
+                return ret;
+        }
+    }
+
+    return run_layer_batch(layer_index, batch_blob_mats, profiler, opt);
+}
+
+int NetPrivate::run_layer_batch(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, Profiler* profiler, const Option& opt) const
+{
+    const Layer* layer = layers[layer_index];
+    const int batch = (int)batch_blob_mats.size();
+
+    // 0=per sample 1=rows 2=flattened rows 3=convolution
+    int stack_type = 0;
+    if (batch > 1 && layer->bottoms.size() == 1 && layer->tops.size() == 1)
+    {
+        const Mat& bottom_blob = batch_blob_mats[0][layer->bottoms[0]];
+
+        if (layer->typeindex == LayerType::InnerProduct)
+        {
+            const InnerProduct* innerproduct = (const InnerProduct*)layer;
+            const int num_input = innerproduct->weight_data_size / innerproduct->num_output;
+
+            if (innerproduct->int8_scale_term == 0)
+                stack_type = bottom_blob.dims == 2 && bottom_blob.w == num_input ? 1 : 2;
+        }
+        if (layer->typeindex == LayerType::Gemm)
+        {
+            const Gemm* gemm = (const Gemm*)layer;
+
+            // stacked rows extend M of A
+            if (gemm->constantA == 0 && gemm->constantB == 1 && gemm->transA == 0 && gemm->output_transpose == 0 && gemm->output_N1M == 0 && gemm->int8_scale_term == 0
+                    && (gemm->constantC == 0 || gemm->constant_broadcast_type_C == -1 || gemm->constant_broadcast_type_C == 0 || gemm->constant_broadcast_type_C == 4)
+                    && bottom_blob.dims == 2)
+                stack_type = 1;
+        }
+        if (layer->typeindex == LayerType::Convolution)
+        {
+            const Convolution* convolution = (const Convolution*)layer;
+
+            if (convolution->dynamic_weight == 0 && convolution->int8_scale_term == 0
+                    && convolution->pad_left >= 0 && convolution->pad_right >= 0 && convolution->pad_top >= 0 && convolution->pad_bottom >= 0
+                    && (convolution->pad_value == 0.f || (convolution->pad_top == 0 && convolution->pad_bottom == 0))
+                    && bottom_blob.dims == 3)
+                stack_type = 3;
+        }
+    }
+
+    if (stack_type == 0)
+    {
+        // cheap layers loop over samples
+        for (int i = 0; i < batch; i++)
+        {
+            int ret = run_layer(layer_index, batch_blob_mats[i], profiler, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        return 0;
+    }
+
+    const int bottom_blob_index = layer->bottoms[0];
+    const int top_blob_index = layer->tops[0];
+
+    // forward the stacked samples at once so that weights are streamed only once
+    std::vector<Mat> blob_mats(blobs.size());
+
+    int rows = 0;
+    int ret = 0;
+    if (stack_type == 3)
+        ret = stack_batch_convolution(batch_blob_mats, bottom_blob_index, (const Convolution*)layer, blob_mats[bottom_blob_index], rows, opt);
+    else
+        ret = stack_batch_rows(batch_blob_mats, bottom_blob_index, stack_type == 1, blob_mats[bottom_blob_index], rows, opt);
+    if (ret != 0)
+        return ret;
+
+    if (opt.lightmode)
+    {
+        // delete after stacked in light mode
+        for (int i = 0; i < batch; i++)
+        {
+            batch_blob_mats[i][bottom_blob_index].release();
+        }
+    }
+
+    ret = run_layer(layer_index, blob_mats, profiler, opt);
+    if (ret != 0)
+        return ret;
+
+    if (stack_type == 3)
+        return unstack_batch_convolution(blob_mats[top_blob_index], rows, batch_blob_mats, top_blob_index, opt);
+
+    return unstack_batch_rows(blob_mats[top_blob_index], rows, stack_type == 2, batch_blob_mats, top_blob_index, opt);
+}
+
+#if NCNN_THREADS
+// the layers of one extract call scheduled by dependency
+struct BranchRun
+{
+    const NetPrivate* net;
+    std::vector<Mat>* blob_mats;
+    Profiler* profiler;
+    Option opt;
+
+    // the count of producer layers not finished yet
+    // -1 for layers not involved
+    std::vector<int> pending;
+    std::vector<int> ready;
+    int running;
+    int remaining;
+    int ret;
+
+    // the most layers running at the same time, from opt.num_threads
+    int max_running;
+};
+
+class BranchThreadPool
+{
+public:
+    BranchThreadPool();
+    ~BranchThreadPool();
+
+    // grow the pool to at least thread_count threads
+    // a run never keeps more than its max_running threads busy
+    void reserve(int thread_count);
+
+    // execute all layers of run on the calling thread and the pool threads
+    // return when all done or any layer failed
+    int run(BranchRun& r);
+
+protected:
+    static void* worker_main(void* args);
+
+    // lock must be held on entry and it is held again on exit
+    void execute_one(BranchRun& r);
+
+    static bool runnable(const BranchRun& r);
+
+private:
+    Mutex lock;
+    ConditionVariable cond;
+    std::vector<Thread*> threads;
+    std::list<BranchRun*> runs;
+    bool quit;
+};
+
+BranchThreadPool::BranchThreadPool()
+{
+    quit = false;
+}
+
+BranchThreadPool::~BranchThreadPool()
+{
+    lock.lock();
+    quit = true;
+    cond.broadcast();
+    lock.unlock();
+
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+}
+
+void BranchThreadPool::reserve(int thread_count)
+{
+    MutexLockGuard guard(lock);
+
+    while ((int)threads.size() < thread_count)
+    {
+        threads.push_back(new Thread(worker_main, (void*)this));
+    }
+}
+
+bool BranchThreadPool::runnable(const BranchRun& r)
+{
+    return r.ret == 0 && !r.ready.empty() && r.running < r.max_running;
+}
+
+int BranchThreadPool::run(BranchRun& r)
+{
+    lock.lock();
+
+    runs.push_back(&r);
+    cond.broadcast();
+
+    while (r.remaining > 0 && (r.ret == 0 || r.running > 0))
+    {
+        if (runnable(r))
+        {
+            execute_one(r);
+        }
+        else
+        {
+            cond.wait(lock);
+        }
+    }
+
+    runs.remove(&r);
+
+    lock.unlock();
+
+    return r.ret;
+}
+
+void* BranchThreadPool::worker_main(void* args)
+{
+    BranchThreadPool* pool = (BranchThreadPool*)args;
+
+    pool->lock.lock();
+
+    while (!pool->quit)
+    {
+        BranchRun* r = 0;
+        for (std::list<BranchRun*>::iterator it = pool->runs.begin(); it != pool->runs.end(); ++it)
+        {
+            if (runnable(**it))
+            {
+                r = *it;
+                break;
+            }
+        }
+
+        if (!r)
+        {
+            pool->cond.wait(pool->lock);
+            continue;
+        }
+
+        pool->execute_one(*r);
+    }
+
+    pool->lock.unlock();
+
+    return 0;
+}
+
+void BranchThreadPool::execute_one(BranchRun& r)
+{
+    int layer_index = r.ready.back();
+    r.ready.pop_back();
+    r.running++;
+
+    // share threads among the layers running and waiting now
+    const int active = std::min(r.running + (int)r.ready.size(), r.max_running);
+
+    Option opt = r.opt;
+    opt.num_threads = std::max(r.opt.num_threads / active, 1);
+
+    lock.unlock();
+
+    set_flush_denormals(opt.flush_denormals);
+
+    int ret = r.net->run_layer(layer_index, *r.blob_mats, r.profiler, opt);
+
+    lock.lock();
+
+    r.running--;
+    r.remaining--;
+
+    if (ret != 0)
+    {
+        r.ret = ret;
+    }
+    else
+    {
+        const std::vector<int>& consumers = r.net->layer_consumers[layer_index];
+        for (size_t i = 0; i < consumers.size(); i++)
+        {
+            int consumer = consumers[i];
+            if (r.pending[consumer] > 0)
+            {
+                r.pending[consumer]--;
+                if (r.pending[consumer] == 0)
+                    r.ready.push_back(consumer);
+            }
+        }
+    }
+
+    cond.broadcast();
+}
+#endif // NCNN_THREADS
+
+int NetPrivate::forward_layer_branch_parallel(int layer_index, std::vector<Mat>& blob_mats, Profiler* profiler, const Option& opt) const
+{
+#if NCNN_THREADS
+    const int thread_count = std::min(opt.num_threads, max_branch_width);
+    if (thread_count < 2)
+        return forward_layer(layer_index, blob_mats, profiler, opt);
+
+    // collect layers required to produce the top blobs of layer_index
+    BranchRun r;
+    r.net = this;
+    r.blob_mats = &blob_mats;
+    r.profiler = profiler;
+    r.opt = opt;
+    r.pending.resize(layers.size(), -1);
+    r.running = 0;
+    r.remaining = 0;
+    r.ret = 0;
+    r.max_running = thread_count;
+
+    std::vector<int> stack(1, layer_index);
+    r.pending[layer_index] = 0;
+    while (!stack.empty())
+    {
+        int i = stack.back();
+        stack.pop_back();
+
+        r.remaining++;
+
+        const std::vector<int>& producers = layer_producers[i];
+        for (size_t j = 0; j < producers.size(); j++)
+        {
+            int producer = producers[j];
+
+            // skip producer whose top blobs consumed here are all ready
+            bool required = false;
+            const Layer* layer = layers[i];
+            for (size_t k = 0; k < layer->bottoms.size(); k++)
+            {
+                int bottom_blob_index = layer->bottoms[k];
+                if (blobs[bottom_blob_index].producer == producer && blob_mats[bottom_blob_index].dims == 0)
+                {
+                    required = true;
+                    break;
+                }
+            }
+
+            if (!required)
+                continue;
+
+            r.pending[i]++;
+
+            if (r.pending[producer] == -1)
+            {
+                r.pending[producer] = 0;
+                stack.push_back(producer);
+            }
+        }
+    }
+
+    if (r.remaining < 2)
+        return forward_layer(layer_index, blob_mats, profiler, opt);
+
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (r.pending[i] == 0)
+            r.ready.push_back((int)i);
+    }
+
+    {
+        MutexLockGuard guard(branch_thread_pool_lock);
+        if (!branch_thread_pool)
+        {
+            branch_thread_pool = new BranchThreadPool;
+        }
+    }
+
+    // follow opt.num_threads changed after the first run
+    branch_thread_pool->reserve(thread_count - 1);
+
+    return branch_thread_pool->run(r);
+#else
+    return forward_layer(layer_index, blob_mats, profiler, opt);
+#endif // NCNN_THREADS
+}
+
+// record the size and lifetime of every allocation
+class MemoryRecordAllocator : public Allocator
+{
+public:
+    MemoryRecordAllocator();
+    virtual ~MemoryRecordAllocator();
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+public:
+    struct Record
+    {
+        size_t size;
+        int alloc_time;
+        int free_time;
+    };
+
+    std::vector<Record> records;
+
+private:
+    Mutex lock;
+    std::list<std::pair<void*, int> > live;
+    int time;
+};
+
+MemoryRecordAllocator::MemoryRecordAllocator()
+    : Allocator()
+{
+    time = 0;
+}
+
+MemoryRecordAllocator::~MemoryRecordAllocator()
+{
+    if (!live.empty())
+    {
+        NCNN_LOGE("FATAL ERROR! memory record allocator destroyed too early");
+
+        std::list<std::pair<void*, int> >::iterator it = live.begin();
+        for (; it != live.end(); ++it)
+        {
+            ncnn::fastFree(it->first);
+        }
+    }
+}
+
+void* MemoryRecordAllocator::fastMalloc(size_t size)
+{
+    void* ptr = ncnn::fastMalloc(size);
+
+    MutexLockGuard guard(lock);
+
+    Record r;
+    r.size = size;
+    r.alloc_time = time++;
+    r.free_time = -1;
+
+    live.push_back(std::make_pair(ptr, (int)records.size()));
+    records.push_back(r);
+
+    return ptr;
+}
+
+void MemoryRecordAllocator::fastFree(void* ptr)
+{
+    {
+        MutexLockGuard guard(lock);
+
+        std::list<std::pair<void*, int> >::iterator it = live.begin();
+        for (; it != live.end(); ++it)
+        {
+            if (it->first == ptr)
+            {
+                records[it->second].free_time = time++;
+                live.erase(it);
+                break;
+            }
+        }
+    }
+
+    ncnn::fastFree(ptr);
 }
 
-#if NCNN_VULKAN
-int NetPrivate::upload_model()
+// hand out planned arena regions in allocation order
+// while allocations follow the plan, the next region is a lookup checked against the regions planned to be freed before it
+// once the order deviates, an unused region of the same size or larger not overlapping live ones is searched
+// fall back to heap if no free region fits
+class MemoryArenaAllocator : public Allocator
 {
-    ncnn::VkTransfer cmd(vkdev);
+public:
+    MemoryArenaAllocator(const std::vector<size_t>& offsets, const std::vector<size_t>& sizes, const std::vector<std::vector<int> >& predecessors, size_t arena_size);
+    virtual ~MemoryArenaAllocator();
 
-    // create gpu device allocator if null
-    if (!weight_vkallocator)
-    {
-        weight_vkallocator = new VkWeightAllocator(vkdev);
-    }
-    if (!weight_staging_vkallocator)
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+    // restart the plan for a new extractor
+    void reset();
+
+    bool busy();
+
+protected:
+    int find_region(size_t aligned_size) const;
+
+public:
+    bool in_use;
+
+private:
+    Mutex lock;
+    const std::vector<size_t>& offsets;
+    const std::vector<size_t>& sizes;
+    const std::vector<std::vector<int> >& predecessors;
+    unsigned char* arena;
+    size_t arena_size;
+    // the next planned region while the plan is followed
+    int cursor;
+    bool in_order;
+    std::vector<unsigned char> used;
+    std::vector<unsigned char> alive;
+    // arena regions alive
+    std::vector<int> live;
+    int heap_count;
+};
+
+MemoryArenaAllocator::MemoryArenaAllocator(const std::vector<size_t>& _offsets, const std::vector<size_t>& _sizes, const std::vector<std::vector<int> >& _predecessors, size_t _arena_size)
+    : Allocator(), offsets(_offsets), sizes(_sizes), predecessors(_predecessors)
+{
+    in_use = false;
+    arena = (unsigned char*)ncnn::fastMalloc(_arena_size);
+    arena_size = _arena_size;
+    cursor = 0;
+    in_order = true;
+    used.resize(offsets.size(), 0);
+    alive.resize(offsets.size(), 0);
+    heap_count = 0;
+}
+
+MemoryArenaAllocator::~MemoryArenaAllocator()
+{
+    if (busy())
     {
-        weight_staging_vkallocator = new VkWeightStagingAllocator(vkdev);
+        NCNN_LOGE("FATAL ERROR! memory arena allocator destroyed too early");
     }
 
-    Option opt_upload = opt;
-    opt_upload.blob_allocator = 0;
-    opt_upload.workspace_allocator = 0;
-    opt_upload.blob_vkallocator = weight_vkallocator;
-    opt_upload.workspace_vkallocator = weight_vkallocator;
-    opt_upload.staging_vkallocator = weight_staging_vkallocator;
+    ncnn::fastFree(arena);
+}
 
-    for (size_t i = 0; i < layers.size(); i++)
+int MemoryArenaAllocator::find_region(size_t aligned_size) const
+{
+    // exact size first, then any larger region
+    for (int pass = 0; pass < 2; pass++)
     {
-        if (layers[i]->support_vulkan)
+        for (int i = 0; i < (int)offsets.size(); i++)
         {
-            int uret = layers[i]->upload_model(cmd, get_masked_option(opt_upload, layers[i]->featmask));
-            if (uret != 0)
+            if (used[i])
+                continue;
+
+            if (pass == 0 ? sizes[i] != aligned_size : sizes[i] < aligned_size)
+                continue;
+
+            const size_t offset = offsets[i];
+            const size_t end = offset + sizes[i];
+
+            // regions planned for other lifetimes may still be alive
+            bool overlap = false;
+            for (size_t j = 0; j < live.size(); j++)
             {
-                NCNN_LOGE("layer upload_model %d failed", (int)i);
-                return -1;
+                const int y = live[j];
+                if (offset < offsets[y] + sizes[y] && offsets[y] < end)
+                {
+                    overlap = true;
+                    break;
+                }
             }
+
+            if (!overlap)
+                return i;
         }
     }
 
-    return cmd.submit_and_wait();
+    return -1;
 }
-#endif // NCNN_VULKAN
 
-int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const
+void* MemoryArenaAllocator::fastMalloc(size_t size)
 {
-    const Layer* layer = layers[layer_index];
+    MutexLockGuard guard(lock);
 
-    //     NCNN_LOGE("forward_layer %d %s", layer_index, layer->name.c_str());
+    const size_t aligned_size = alignSize(size, NCNN_MALLOC_ALIGN);
 
-    // load bottom blobs
-    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    int x = -1;
+    if (in_order && cursor < (int)offsets.size() && sizes[cursor] == aligned_size)
     {
-        int bottom_blob_index = layer->bottoms[i];
-
-        if (blob_mats[bottom_blob_index].dims == 0)
+        // earlier regions overlapping this one are freed before it in the plan
+        // only the latest of them is checked here, the others were checked by the regions in between
+        const std::vector<int>& p = predecessors[cursor];
+        bool ready = true;
+        for (size_t j = 0; j < p.size(); j++)
         {
-            int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt);
-            if (ret != 0)
-                return ret;
+            if (alive[p[j]])
+            {
+                ready = false;
+                break;
+            }
         }
+
+        if (ready)
+            x = cursor++;
     }
 
-#if NCNN_BENCHMARK
-    double start = get_current_time();
-    Mat bottom_blob;
-    if (layer->one_blob_only)
+    if (x == -1)
     {
-        int bottom_blob_index = layer->bottoms[0];
-        bottom_blob.dims = blob_mats[bottom_blob_index].dims;
-        bottom_blob.w = blob_mats[bottom_blob_index].w;
-        bottom_blob.h = blob_mats[bottom_blob_index].h;
-        bottom_blob.d = blob_mats[bottom_blob_index].d;
-        bottom_blob.c = blob_mats[bottom_blob_index].c;
-        bottom_blob.elempack = blob_mats[bottom_blob_index].elempack;
-        bottom_blob.elemsize = blob_mats[bottom_blob_index].elemsize;
+        // the plan is not followed any more, search the unused regions
+        in_order = false;
+        x = find_region(aligned_size);
     }
-#endif
-    int ret = 0;
-    if (layer->featmask)
+
+    if (x == -1)
     {
-        ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask));
+        heap_count++;
+        return ncnn::fastMalloc(size);
     }
-    else
+
+    used[x] = 1;
+    alive[x] = 1;
+    live.push_back(x);
+    return arena + offsets[x];
+}
+
+void MemoryArenaAllocator::fastFree(void* ptr)
+{
+    MutexLockGuard guard(lock);
+
+    unsigned char* p = (unsigned char*)ptr;
+    if (p >= arena && p < arena + arena_size)
     {
-        ret = do_forward_layer(layer, blob_mats, opt);
+        // regions alive never share an offset
+        const size_t offset = p - arena;
+        for (size_t j = 0; j < live.size(); j++)
+        {
+            if (offsets[live[j]] == offset)
+            {
+                alive[live[j]] = 0;
+                live[j] = live.back();
+                live.pop_back();
+                break;
+            }
+        }
+        return;
     }
-#if NCNN_BENCHMARK
-    double end = get_current_time();
-    if (layer->one_blob_only)
+
+    heap_count--;
+    ncnn::fastFree(ptr);
+}
+
+void MemoryArenaAllocator::reset()
+{
+    MutexLockGuard guard(lock);
+
+    cursor = 0;
+    in_order = true;
+    std::fill(used.begin(), used.end(), 0);
+}
+
+bool MemoryArenaAllocator::busy()
+{
+    MutexLockGuard guard(lock);
+
+    return !live.empty() || heap_count != 0;
+}
+
+MemoryArenaAllocator* NetPrivate::acquire_memory_arena()
+{
+    MutexLockGuard guard(memory_arenas_lock);
+
+    for (size_t i = 0; i < memory_arenas.size(); i++)
     {
-        int top_blob_index = layer->tops[0];
-        benchmark(layer, bottom_blob, blob_mats[top_blob_index], start, end);
+        MemoryArenaAllocator* arena = memory_arenas[i];
+
+        // regions may still be referenced by mats outliving the extractor
+        if (!arena->in_use && !arena->busy())
+        {
+            arena->in_use = true;
+            arena->reset();
+            return arena;
+        }
     }
-    else
+
+    MemoryArenaAllocator* arena = new MemoryArenaAllocator(memory_plan_offsets, memory_plan_sizes, memory_plan_predecessors, memory_plan_bytes);
+    arena->in_use = true;
+    memory_arenas.push_back(arena);
+
+    return arena;
+}
+
+void NetPrivate::reclaim_memory_arena(MemoryArenaAllocator* arena)
+{
+    MutexLockGuard guard(memory_arenas_lock);
+
+    arena->in_use = false;
+}
+
+bool NetPrivate::memory_arenas_in_use()
+{
+    MutexLockGuard guard(memory_arenas_lock);
+
+    for (size_t i = 0; i < memory_arenas.size(); i++)
     {
-        benchmark(layer, start, end);
+        if (memory_arenas[i]->in_use || memory_arenas[i]->busy())
+            return true;
     }
-#endif
-    if (ret != 0)
-        return ret;
 
-    //     NCNN_LOGE("forward_layer %d %s done", layer_index, layer->name.c_str());
-    //     const Mat& blob = blob_mats[layer->tops[0]];
-    //     NCNN_LOGE("[%-2d %-16s %-16s]  %d    blobs count = %-3d   size = %-3d x %-3d", layer_index, layer->type.c_str(), layer->name.c_str(), layer->tops[0], blob.c, blob.h, blob.w);
+    return false;
+}
 
-    return 0;
+void NetPrivate::clear_memory_arenas()
+{
+    MutexLockGuard guard(memory_arenas_lock);
+
+    for (size_t i = 0; i < memory_arenas.size(); i++)
+    {
+        delete memory_arenas[i];
+    }
+    memory_arenas.clear();
 }
 
 #if NCNN_VULKAN
@@ -333,11 +1469,11 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std:
 #endif
         if (layer->featmask)
         {
-            ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask));
+            ret = do_forward_layer(layer, blob_mats, 0, get_masked_option(opt, layer->featmask));
         }
         else
         {
-            ret = do_forward_layer(layer, blob_mats, opt);
+            ret = do_forward_layer(layer, blob_mats, 0, opt);
         }
 #if NCNN_BENCHMARK
         double end = get_current_time();
@@ -363,6 +1499,12 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std:
 
 int NetPrivate::convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const
 {
+    if (bottom_blob.dims != 0 && bottom_blob.total() == 0)
+    {
+        // zero length blob, such as the initial kv cache, has nothing to convert
+        return 0;
+    }
+
     if (bottom_blob.elembits() == 32)
     {
         // clang-format off
@@ -545,7 +1687,7 @@ int NetPrivate::convert_layout(Mat& bottom_blob, const Layer* layer, const Optio
     return 0;
 }
 
-int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt) const
+int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, LayerProfile* profile, const Option& opt) const
 {
     if (layer->one_blob_only)
     {
@@ -574,6 +1716,19 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
         if (ret != 0)
             return ret;
 
+        if (bottom_blob.elempack != bottom_blob_ref.elempack || bottom_blob.elemsize != bottom_blob_ref.elemsize)
+            atomic_fetch_add_int(&layout_conversion_count, 1);
+
+        if (profile)
+        {
+            profile->converted = bottom_blob.elempack != bottom_blob_ref.elempack || bottom_blob.elemsize != bottom_blob_ref.elemsize;
+            profile->bottom_shapes.push_back(get_blob_shape(bottom_blob_ref));
+            profile->converted_shapes.push_back(get_blob_shape(bottom_blob));
+            profile->convert_bytes[0] = profile->bytes[0];
+            profile->convert_bytes[1] = profile->bytes[1];
+            profile->forward_start = get_current_time();
+        }
+
         // forward
         if (opt.lightmode && layer->support_inplace)
         {
@@ -630,6 +1785,23 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
             int ret = convert_layout(bottom_blobs[i], layer, opt);
             if (ret != 0)
                 return ret;
+
+            if (bottom_blobs[i].elempack != bottom_blob_ref.elempack || bottom_blobs[i].elemsize != bottom_blob_ref.elemsize)
+                atomic_fetch_add_int(&layout_conversion_count, 1);
+
+            if (profile)
+            {
+                profile->converted = profile->converted || bottom_blobs[i].elempack != bottom_blob_ref.elempack || bottom_blobs[i].elemsize != bottom_blob_ref.elemsize;
+                profile->bottom_shapes.push_back(get_blob_shape(bottom_blob_ref));
+                profile->converted_shapes.push_back(get_blob_shape(bottom_blobs[i]));
+            }
+        }
+
+        if (profile)
+        {
+            profile->convert_bytes[0] = profile->bytes[0];
+            profile->convert_bytes[1] = profile->bytes[1];
+            profile->forward_start = get_current_time();
         }
 
         // forward
@@ -821,34 +1993,307 @@ void NetPrivate::update_input_output_indexes()
         }
     }
 
-    for (size_t i = 0; i < blobs.size(); i++)
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        if (blobs[i].producer != -1 && blobs[i].consumer == -1)
+        {
+            output_blob_indexes.push_back(i);
+        }
+    }
+}
+
+#if NCNN_STRING
+void NetPrivate::update_input_output_names()
+{
+    input_blob_names.clear();
+    output_blob_names.clear();
+
+    for (size_t i = 0; i < input_blob_indexes.size(); i++)
+    {
+        int blob_index = input_blob_indexes[i];
+        input_blob_names.push_back(blobs[blob_index].name.c_str());
+    }
+
+    for (size_t i = 0; i < output_blob_indexes.size(); i++)
+    {
+        int blob_index = output_blob_indexes[i];
+        output_blob_names.push_back(blobs[blob_index].name.c_str());
+    }
+}
+#endif // NCNN_STRING
+
+// the featmask bit of the reduced precision storage that convert_layout casts to
+static int get_reduced_storage_featmask(const Option& opt)
+{
+    // clang-format off
+    // *INDENT-OFF*
+#if NCNN_ARM82
+    if (opt.use_fp16_storage && cpu_support_arm_asimdhp())
+        return 1 << 1;
+#endif // NCNN_ARM82
+#if NCNN_VFPV4
+    if (opt.use_fp16_storage && !opt.use_bf16_storage && cpu_support_arm_vfpv4())
+        return 1 << 1;
+#endif // NCNN_VFPV4
+#if NCNN_ZFH
+    if (opt.use_fp16_storage && (ncnn::cpu_support_riscv_zvfh() || (!ncnn::cpu_support_riscv_v() && ncnn::cpu_support_riscv_zfh())))
+        return 1 << 1;
+#endif // NCNN_ZFH
+#if NCNN_BF16
+    if (opt.use_bf16_storage)
+        return 1 << 2;
+#endif // NCNN_BF16
+    // *INDENT-ON*
+    // clang-format on
+
+    return 0;
+}
+
+// layers whose own work outweighs the casts around them
+static bool is_weight_heavy_layer(const Layer* layer)
+{
+    switch (layer->typeindex)
+    {
+    case LayerType::Convolution:
+    case LayerType::Convolution1D:
+    case LayerType::Convolution3D:
+    case LayerType::ConvolutionDepthWise:
+    case LayerType::ConvolutionDepthWise1D:
+    case LayerType::ConvolutionDepthWise3D:
+    case LayerType::Deconvolution:
+    case LayerType::Deconvolution1D:
+    case LayerType::Deconvolution3D:
+    case LayerType::DeconvolutionDepthWise:
+    case LayerType::DeconvolutionDepthWise1D:
+    case LayerType::DeconvolutionDepthWise3D:
+    case LayerType::InnerProduct:
+    case LayerType::Gemm:
+    case LayerType::MatMul:
+    case LayerType::MultiHeadAttention:
+    case LayerType::LSTM:
+    case LayerType::GRU:
+    case LayerType::RNN:
+    case LayerType::Embed:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// unit capacity graph for the storage min cut
+struct StorageCutGraph
+{
+    struct Edge
+    {
+        int to;
+        int capacity;
+    };
+
+    std::vector<Edge> edges;
+    std::vector<std::vector<int> > adjacency;
+
+    void add_edge(int from, int to, int capacity, int reverse_capacity)
+    {
+        adjacency[from].push_back((int)edges.size());
+        Edge e0 = {to, capacity};
+        edges.push_back(e0);
+
+        adjacency[to].push_back((int)edges.size());
+        Edge e1 = {from, reverse_capacity};
+        edges.push_back(e1);
+    }
+
+    // augment one path from source to sink, return false if none
+    bool augment(int source, int sink)
+    {
+        std::vector<int> parent_edge(adjacency.size(), -1);
+        std::vector<int> queue;
+        queue.push_back(source);
+        parent_edge[source] = -2;
+
+        for (size_t i = 0; i < queue.size() && parent_edge[sink] == -1; i++)
+        {
+            const int v = queue[i];
+            for (size_t j = 0; j < adjacency[v].size(); j++)
+            {
+                const int e = adjacency[v][j];
+                if (edges[e].capacity > 0 && parent_edge[edges[e].to] == -1)
+                {
+                    parent_edge[edges[e].to] = e;
+                    queue.push_back(edges[e].to);
+                }
+            }
+        }
+
+        if (parent_edge[sink] == -1)
+            return false;
+
+        int bottleneck = edges[parent_edge[sink]].capacity;
+        for (int v = sink; v != source; v = edges[parent_edge[v] ^ 1].to)
+        {
+            bottleneck = std::min(bottleneck, edges[parent_edge[v]].capacity);
+        }
+        for (int v = sink; v != source; v = edges[parent_edge[v] ^ 1].to)
+        {
+            edges[parent_edge[v]].capacity -= bottleneck;
+            edges[parent_edge[v] ^ 1].capacity += bottleneck;
+        }
+
+        return true;
+    }
+
+    // vertices still reachable from source after max flow
+    std::vector<bool> source_side(int source) const
+    {
+        std::vector<bool> visited(adjacency.size(), false);
+        std::vector<int> stack;
+        stack.push_back(source);
+        visited[source] = true;
+
+        while (!stack.empty())
+        {
+            const int v = stack.back();
+            stack.pop_back();
+            for (size_t j = 0; j < adjacency[v].size(); j++)
+            {
+                const Edge& e = edges[adjacency[v][j]];
+                if (e.capacity > 0 && !visited[e.to])
+                {
+                    visited[e.to] = true;
+                    stack.push_back(e.to);
+                }
+            }
+        }
+
+        return visited;
+    }
+};
+
+void NetPrivate::assign_layer_storage()
+{
+    const int featmask = get_reduced_storage_featmask(opt);
+    if (!opt.use_storage_assignment || featmask == 0 || opt.use_vulkan_compute)
+        return;
+
+    // a layer either keeps reduced precision storage or stays in fp32
+    // every blob between layers of different storage costs one cast
+    // the cheapest assignment is the min cut between weight-heavy layers and fp32-only layers
+    const int layer_count = (int)layers.size();
+    const int source = layer_count;
+    const int sink = layer_count + 1;
+    const int infinity = (int)blobs.size() + 1;
+
+    StorageCutGraph graph;
+    graph.adjacency.resize(layer_count + 2);
+
+    std::vector<bool> flexible(layer_count, false);
+    for (int i = 0; i < layer_count; i++)
+    {
+        const Layer* layer = layers[i];
+
+        const bool support_reduced = featmask == (1 << 1) ? layer->support_fp16_storage : layer->support_bf16_storage;
+        if (!support_reduced || (layer->featmask & featmask) || layer->support_int8_storage || layer->typeindex == LayerType::Input)
+        {
+            // input blobs are fed in fp32
+            graph.add_edge(i, sink, infinity, 0);
+        }
+        else if (is_weight_heavy_layer(layer))
+        {
+            graph.add_edge(source, i, infinity, 0);
+        }
+        else
+        {
+            flexible[i] = true;
+        }
+    }
+
+    for (int i = 0; i < layer_count; i++)
+    {
+        const Layer* layer = layers[i];
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            int producer = blobs[layer->bottoms[j]].producer;
+            if (producer != -1 && producer != i)
+                graph.add_edge(producer, i, 1, 1);
+        }
+    }
+
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        // outputs are cast back to fp32 on extract
+        if (blobs[i].producer != -1 && blobs[i].consumer == -1)
+            graph.add_edge(blobs[i].producer, sink, 1, 0);
+    }
+
+    while (graph.augment(source, sink))
     {
-        if (blobs[i].producer != -1 && blobs[i].consumer == -1)
+    }
+
+    // flexible layers left out of the reduced side run in fp32
+    const std::vector<bool> reduced = graph.source_side(source);
+    for (int i = 0; i < layer_count; i++)
+    {
+        if (flexible[i] && !reduced[i])
         {
-            output_blob_indexes.push_back(i);
+            layers[i]->featmask |= (1 << 1) | (1 << 2);
         }
     }
 }
 
-#if NCNN_STRING
-void NetPrivate::update_input_output_names()
+void NetPrivate::update_layer_dependencies()
 {
-    input_blob_names.clear();
-    output_blob_names.clear();
+    const size_t layer_count = layers.size();
 
-    for (size_t i = 0; i < input_blob_indexes.size(); i++)
+    layer_producers.clear();
+    layer_consumers.clear();
+    layer_producers.resize(layer_count);
+    layer_consumers.resize(layer_count);
+
+    // layers are stored in topological order
+    // the depth of layer is one more than its deepest producer
+    std::vector<int> layer_depths(layer_count, 0);
+    int max_depth = 0;
+
+    for (size_t i = 0; i < layer_count; i++)
     {
-        int blob_index = input_blob_indexes[i];
-        input_blob_names.push_back(blobs[blob_index].name.c_str());
+        const Layer* layer = layers[i];
+        if (!layer)
+            continue;
+
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            int producer = blobs[layer->bottoms[j]].producer;
+            if (producer == -1 || producer == (int)i)
+                continue;
+
+            std::vector<int>& producers = layer_producers[i];
+            if (std::find(producers.begin(), producers.end(), producer) != producers.end())
+                continue;
+
+            producers.push_back(producer);
+            layer_consumers[producer].push_back((int)i);
+
+            layer_depths[i] = std::max(layer_depths[i], layer_depths[producer] + 1);
+        }
+
+        max_depth = std::max(max_depth, layer_depths[i]);
     }
 
-    for (size_t i = 0; i < output_blob_indexes.size(); i++)
+    // layers of the same depth never depend on each other
+    std::vector<int> depth_widths(max_depth + 1, 0);
+    for (size_t i = 0; i < layer_count; i++)
     {
-        int blob_index = output_blob_indexes[i];
-        output_blob_names.push_back(blobs[blob_index].name.c_str());
+        depth_widths[layer_depths[i]]++;
+    }
+
+    max_branch_width = 1;
+    for (int i = 0; i <= max_depth; i++)
+    {
+        // input layers are never executed
+        int width = i == 0 ? 1 : depth_widths[i];
+        max_branch_width = std::max(max_branch_width, width);
     }
 }
-#endif // NCNN_STRING
 
 Net::Net()
     : d(new NetPrivate(opt))
@@ -963,6 +2408,124 @@ int Net::register_custom_layer(int index, layer_creator_func creator, layer_dest
     return 0;
 }
 
+void NetPrivate::update_needed_layers()
+{
+    needed_layers.clear();
+    if (declared_output_indexes.empty())
+        return;
+
+    needed_layers.resize(layers.size(), 0);
+    for (size_t i = 0; i < declared_output_indexes.size(); i++)
+    {
+        int producer = blobs[declared_output_indexes[i]].producer;
+        if (producer != -1)
+            needed_layers[producer] = 1;
+    }
+
+    // layers are stored in topological order, walk back from the outputs
+    for (int i = (int)layers.size() - 1; i >= 0; i--)
+    {
+        if (!needed_layers[i] || !layers[i])
+            continue;
+
+        const Layer* layer = layers[i];
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            int producer = blobs[layer->bottoms[j]].producer;
+            if (producer != -1)
+                needed_layers[producer] = 1;
+        }
+    }
+}
+
+int NetPrivate::create_lazy_pipeline(int layer_index) const
+{
+    // fast path once created
+    if (atomic_load_int(&created_layers[layer_index]))
+        return 0;
+
+    MutexLockGuard g(lazy_pipeline_lock);
+
+    if (created_layers[layer_index])
+        return 0;
+
+    Layer* layer = layers[layer_index];
+
+    Option opt1 = get_masked_option(opt, layer->featmask);
+
+    int cret = layer->create_pipeline(opt1);
+    if (cret != 0)
+    {
+#if NCNN_STRING
+        NCNN_LOGE("layer create_pipeline %d %s failed", layer_index, layer->name.c_str());
+#else
+        NCNN_LOGE("layer create_pipeline %d failed", layer_index);
+#endif
+        return cret;
+    }
+
+    atomic_store_int(&created_layers[layer_index], 1);
+
+    return 0;
+}
+
+#if NCNN_STDIO
+// 64-bit fnv-1a, eight bytes a step
+static uint64_t hash_bytes(uint64_t h, const void* data, size_t size)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    for (; size >= 8; size -= 8, p += 8)
+    {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        h = (h ^ v) * 0x100000001b3ULL;
+    }
+    for (; size > 0; size--, p++)
+    {
+        h = (h ^ *p) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static uint64_t hash_int(uint64_t h, int v)
+{
+    return hash_bytes(h, &v, sizeof(v));
+}
+
+static const uint64_t hash_seed = 0xcbf29ce484222325ULL;
+
+static uint64_t hash_param_dict(const ParamDict& pd)
+{
+    uint64_t h = hash_seed;
+    for (int i = 0; i < NCNN_MAX_PARAM_COUNT; i++)
+    {
+        const int type = pd.type(i);
+        if (type == 0)
+            continue;
+
+        h = hash_int(h, i);
+        h = hash_int(h, type);
+
+        if (type >= 1 && type <= 3)
+        {
+            // int and float share the bits
+            h = hash_int(h, pd.get(i, 0));
+        }
+        if (type >= 4 && type <= 6)
+        {
+            Mat v = pd.get(i, Mat());
+            h = hash_bytes(h, v.data, v.total() * v.elemsize);
+        }
+        if (type == 7)
+        {
+            std::string v = pd.get(i, std::string());
+            h = hash_bytes(h, v.data(), v.size());
+        }
+    }
+    return h;
+}
+#endif // NCNN_STDIO
+
 #if NCNN_STRING
 int Net::load_param(const DataReader& dr)
 {
@@ -994,6 +2557,9 @@ int Net::load_param(const DataReader& dr)
 
     d->layers.resize((size_t)layer_count);
     d->blobs.resize((size_t)blob_count);
+#if NCNN_STDIO
+    d->layer_param_hashes.resize((size_t)layer_count);
+#endif // NCNN_STDIO
 
 #if NCNN_VULKAN
     // TODO enable gpu when bf16 conversion implemented
@@ -1187,6 +2753,10 @@ int Net::load_param(const DataReader& dr)
         // pull out layer specific feature disabled set
         layer->featmask = pd.get(31, 0);
 
+#if NCNN_STDIO
+        d->layer_param_hashes[i] = hash_param_dict(pd);
+#endif // NCNN_STDIO
+
         int lr = layer->load_param(pd);
         if (lr != 0)
         {
@@ -1293,6 +2863,9 @@ int Net::load_param_bin(const DataReader& dr)
 
     d->layers.resize(layer_count);
     d->blobs.resize(blob_count);
+#if NCNN_STDIO
+    d->layer_param_hashes.resize(layer_count);
+#endif // NCNN_STDIO
 
 #if NCNN_VULKAN
     // TODO enable gpu when bf16 conversion implemented
@@ -1453,82 +3026,483 @@ int Net::load_param_bin(const DataReader& dr)
             }
         }
 
-        // set bottom and top shape hints
-        layer->bottom_shapes.resize(bottom_count);
-        for (int j = 0; j < bottom_count; j++)
-        {
-            layer->bottom_shapes[j] = d->blobs[layer->bottoms[j]].shape;
-        }
+        // set bottom and top shape hints
+        layer->bottom_shapes.resize(bottom_count);
+        for (int j = 0; j < bottom_count; j++)
+        {
+            layer->bottom_shapes[j] = d->blobs[layer->bottoms[j]].shape;
+        }
+
+        layer->top_shapes.resize(top_count);
+        for (int j = 0; j < top_count; j++)
+        {
+            layer->top_shapes[j] = d->blobs[layer->tops[j]].shape;
+        }
+
+        // pull out layer specific feature disabled set
+        layer->featmask = pd.get(31, 0);
+
+#if NCNN_STDIO
+        d->layer_param_hashes[i] = hash_param_dict(pd);
+#endif // NCNN_STDIO
+
+        int lr = layer->load_param(pd);
+        if (lr != 0)
+        {
+            NCNN_LOGE("layer load_param %d failed", i);
+            continue;
+        }
+
+        if (layer->support_int8_storage)
+        {
+            // no int8 gpu support yet
+            opt.use_vulkan_compute = false;
+        }
+
+        Option opt1 = get_masked_option(opt, layer->featmask);
+
+        if (layer_support_vulkan && (!layer->support_vulkan || !opt1.use_vulkan_compute))
+        {
+            // vulkan layer cannot handle these param, recreate cpu layer
+            Layer* layer_cpu = create_overwrite_builtin_layer(typeindex);
+            if (!layer_cpu)
+            {
+                layer_cpu = create_layer_cpu(typeindex);
+            }
+            if (!layer_cpu)
+            {
+                int custom_index = typeindex & ~LayerType::CustomBit;
+                layer_cpu = create_custom_layer(custom_index);
+            }
+            if (!layer_cpu)
+            {
+                NCNN_LOGE("layer %d not exists or registered", typeindex);
+                clear();
+                return -1;
+            }
+
+            layer_cpu->bottoms = layer->bottoms;
+            layer_cpu->tops = layer->tops;
+            layer_cpu->bottom_shapes = layer->bottom_shapes;
+            layer_cpu->top_shapes = layer->top_shapes;
+            layer_cpu->featmask = layer->featmask;
+
+            int lr = layer_cpu->load_param(pd);
+            if (lr != 0)
+            {
+                NCNN_LOGE("layer load_param %d failed", i);
+                continue;
+            }
+
+            delete layer;
+            layer = layer_cpu;
+        }
+
+        d->layers[i] = layer;
+    }
+
+    d->update_input_output_indexes();
+
+#undef READ_VALUE
+    return 0;
+}
+
+// track weights referenced from the data reader
+class ModelBinReferenceTracker : public ModelBin
+{
+public:
+    ModelBinReferenceTracker(const ModelBin& _mb, NetPrivate* _d)
+        : mb(_mb), d(_d), layer_index(0)
+    {
+#if NCNN_STDIO
+        hash_weights = false;
+        weight_hash = hash_seed;
+#endif // NCNN_STDIO
+    }
+
+    virtual Mat load(int w, int type) const
+    {
+        Mat m = mb.load(w, type);
+#if NCNN_STDIO
+        if (hash_weights)
+            weight_hash = hash_bytes(weight_hash, m.data, m.total() * m.elemsize);
+#endif // NCNN_STDIO
+        if (m.data && !m.refcount)
+        {
+            NetPrivate::ReferencedWeight rw;
+            rw.layer_index = layer_index;
+            rw.size = m.total() * m.elemsize;
+            rw.refcount = new int(1);
+            d->referenced_weights.push_back(rw);
+
+            // take the referenced data with refcount
+            Mat m_tracked = m;
+            m_tracked.refcount = rw.refcount;
+            m_tracked.allocator = &d->referenced_weight_allocator;
+            return m_tracked;
+        }
+
+        return m;
+    }
+
+private:
+    const ModelBin& mb;
+    NetPrivate* d;
+
+public:
+    int layer_index;
+
+#if NCNN_STDIO
+    // hash of the weight data loaded since reset
+    bool hash_weights;
+    mutable uint64_t weight_hash;
+#endif // NCNN_STDIO
+};
+
+#if NCNN_STDIO
+static const int weight_cache_magic = 0x6e636e77; // "wncn"
+static const int weight_cache_version = 2;
+
+// the library build and the cpu features and cache size that steer layer implementation selection and tiling
+static uint64_t get_weight_cache_cpu_key()
+{
+    // the layer code that packed the cached weights, and which isa variants were compiled in
+    const int build[] = {
+        NCNN_RUNTIME_CPU,
+        NCNN_AVX,
+        NCNN_XOP,
+        NCNN_FMA,
+        NCNN_F16C,
+        NCNN_AVX2,
+        NCNN_AVXVNNI,
+        NCNN_AVXVNNIINT8,
+        NCNN_AVXVNNIINT16,
+        NCNN_AVXNECONVERT,
+        NCNN_AVX512,
+        NCNN_AVX512VNNI,
+        NCNN_AVX512BF16,
+        NCNN_AVX512FP16,
+        NCNN_VFPV4,
+        NCNN_ARM82,
+        NCNN_ARM82DOT,
+        NCNN_ARM82FP16FML,
+        NCNN_ARM84BF16,
+        NCNN_ARM84I8MM,
+        NCNN_ARM86SVE,
+        NCNN_ARM86SVE2,
+        NCNN_ARM86SVEBF16,
+        NCNN_ARM86SVEI8MM,
+        NCNN_ARM86SVEF32MM,
+        NCNN_MSA,
+        NCNN_LSX,
+        NCNN_MMI,
+        NCNN_RVV,
+        NCNN_ZFH,
+        NCNN_ZVFH,
+        NCNN_XTHEADVECTOR,
+        NCNN_INT8,
+        NCNN_BF16,
+#if __AVX512F__
+        512,
+#elif __AVX2__
+        256,
+#elif __AVX__
+        255,
+#elif __SSE2__
+        128,
+#else
+        0,
+#endif
+#if __F16C__
+        1,
+#else
+        0,
+#endif
+#if __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+        1,
+#else
+        0,
+#endif
+    };
+
+    const int features[] = {
+        (int)sizeof(void*),
+        cpu_support_arm_neon(),
+        cpu_support_arm_vfpv4(),
+        cpu_support_arm_asimdhp(),
+        cpu_support_arm_asimddp(),
+        cpu_support_arm_asimdfhm(),
+        cpu_support_arm_bf16(),
+        cpu_support_arm_i8mm(),
+        cpu_support_arm_sve(),
+        cpu_support_x86_avx(),
+        cpu_support_x86_fma(),
+        cpu_support_x86_f16c(),
+        cpu_support_x86_avx2(),
+        cpu_support_x86_avx_vnni(),
+        cpu_support_x86_avx_vnni_int8(),
+        cpu_support_x86_avx512(),
+        cpu_support_x86_avx512_vnni(),
+        cpu_support_x86_avx512_bf16(),
+        cpu_support_x86_avx512_fp16(),
+        get_cpu_level2_cache_size(),
+    };
+
+    uint64_t h = hash_seed;
+#ifdef NCNN_VERSION_STRING
+    h = hash_bytes(h, NCNN_VERSION_STRING, strlen(NCNN_VERSION_STRING));
+#endif
+    h = hash_bytes(h, build, sizeof(build));
+    h = hash_bytes(h, features, sizeof(features));
+    return h;
+}
+
+static uint64_t get_weight_cache_key(const Layer* layer, uint64_t param_hash, uint64_t weight_hash, const Option& opt)
+{
+    const int options[] = {
+        opt.num_threads,
+        opt.use_winograd_convolution,
+        opt.use_sgemm_convolution,
+        opt.use_int8_inference,
+        opt.use_bf16_storage,
+        opt.use_fp16_packed,
+        opt.use_fp16_storage,
+        opt.use_fp16_arithmetic,
+        opt.use_int8_packed,
+        opt.use_int8_storage,
+        opt.use_int8_arithmetic,
+        opt.use_packing_layout,
+        opt.use_winograd23_convolution,
+        opt.use_winograd43_convolution,
+        opt.use_winograd63_convolution,
+        opt.use_a53_a55_optimized_kernel,
+    };
+
+    uint64_t h = hash_int(hash_seed, layer->typeindex);
+    h = hash_bytes(h, &param_hash, sizeof(param_hash));
+    h = hash_bytes(h, &weight_hash, sizeof(weight_hash));
+    h = hash_bytes(h, options, sizeof(options));
+
+    // shape hints pick the winograd tile size
+    for (size_t i = 0; i < layer->bottom_shapes.size(); i++)
+    {
+        const Mat& shape = layer->bottom_shapes[i];
+        const int dims[] = {shape.dims, shape.w, shape.h, shape.d, shape.c};
+        h = hash_bytes(h, dims, sizeof(dims));
+    }
+    for (size_t i = 0; i < layer->top_shapes.size(); i++)
+    {
+        const Mat& shape = layer->top_shapes[i];
+        const int dims[] = {shape.dims, shape.w, shape.h, shape.d, shape.c};
+        h = hash_bytes(h, dims, sizeof(dims));
+    }
+
+    return h;
+}
+
+// file layout
+//   header     int magic, int version, int entry_count, int reserved, uint64 cpu_key
+//   entry      int layer_index, int weight_count, uint64 key
+//   weight     int dims, w, h, d, c, elempack, uint64 elemsize, cstep
+//              then data at 64 byte aligned offset
+struct WeightCacheMatHeader
+{
+    int dims;
+    int w;
+    int h;
+    int d;
+    int c;
+    int elempack;
+    uint64_t elemsize;
+    uint64_t cstep;
+};
+
+int NetPrivate::load_weight_cache(std::vector<WeightCacheEntry>& entries)
+{
+    entries.clear();
+
+    DataReaderFromMmap* dr = new DataReaderFromMmap(weight_cache_path.c_str());
+    if (dr->empty())
+    {
+        // not created yet
+        delete dr;
+        return -1;
+    }
+
+    std::vector<WeightCacheEntry> cached(layers.size());
+
+    int header[4];
+    uint64_t cpu_key = 0;
+    bool ok = dr->read(header, sizeof(header)) == sizeof(header) && dr->read(&cpu_key, sizeof(cpu_key)) == sizeof(cpu_key);
+    ok = ok && header[0] == weight_cache_magic && header[1] == weight_cache_version && cpu_key == get_weight_cache_cpu_key();
+
+    size_t offset = sizeof(header) + sizeof(cpu_key);
+    const int entry_count = ok ? header[2] : 0;
+    for (int i = 0; ok && i < entry_count; i++)
+    {
+        int entry_header[2];
+        uint64_t key = 0;
+        ok = dr->read(entry_header, sizeof(entry_header)) == sizeof(entry_header) && dr->read(&key, sizeof(key)) == sizeof(key);
+        offset += sizeof(entry_header) + sizeof(key);
+
+        const int layer_index = entry_header[0];
+        const int weight_count = entry_header[1];
+        ok = ok && layer_index >= 0 && layer_index < (int)layers.size() && weight_count >= 0;
+        if (!ok)
+            break;
+
+        WeightCacheEntry& entry = cached[layer_index];
+        entry.key = key;
+        entry.weights.resize(weight_count);
+        for (int j = 0; ok && j < weight_count; j++)
+        {
+            WeightCacheMatHeader mh;
+            ok = dr->read(&mh, sizeof(mh)) == sizeof(mh);
+            offset += sizeof(mh);
+            if (!ok || mh.dims == 0)
+                continue;
+
+            unsigned char padding[64];
+            const size_t padding_size = alignSize(offset, 64) - offset;
+            ok = dr->read(padding, padding_size) == padding_size;
+            offset += padding_size;
+
+            const size_t size = (size_t)(mh.cstep * mh.c * mh.elemsize);
+            const void* data = 0;
+            ok = ok && dr->reference(size, &data) == size;
+            offset += size;
+            if (!ok)
+                break;
+
+            // point to the mapping, released with it
+            Mat& m = entry.weights[j];
+            m.data = (void*)data;
+            m.elemsize = (size_t)mh.elemsize;
+            m.elempack = mh.elempack;
+            m.dims = mh.dims;
+            m.w = mh.w;
+            m.h = mh.h;
+            m.d = mh.d;
+            m.c = mh.c;
+            m.cstep = (size_t)mh.cstep;
+        }
+    }
+
+    if (!ok)
+    {
+        NCNN_LOGE("weight cache %s is corrupted or for another net", weight_cache_path.c_str());
+        delete dr;
+        return -1;
+    }
+
+    // retain the mapping for restored weights
+    delete weight_cache_mmap;
+    weight_cache_mmap = dr;
+
+    entries = cached;
+
+    return 0;
+}
+
+int NetPrivate::save_weight_cache(const std::vector<uint64_t>& layer_keys) const
+{
+    // write aside and rename, the old file may still be mapped
+    std::string tmppath = weight_cache_path + ".tmp";
+    FILE* fp = fopen(tmppath.c_str(), "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", tmppath.c_str());
+        return -1;
+    }
+
+    std::vector<int> cached_layers;
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        // lazy layers are not transformed yet
+        if (!created_layers[i])
+            continue;
 
-        layer->top_shapes.resize(top_count);
-        for (int j = 0; j < top_count; j++)
-        {
-            layer->top_shapes[j] = d->blobs[layer->tops[j]].shape;
-        }
+        std::vector<Mat*> weights;
+        layers[i]->get_pipeline_weights(weights);
+        if (!weights.empty())
+            cached_layers.push_back((int)i);
+    }
 
-        // pull out layer specific feature disabled set
-        layer->featmask = pd.get(31, 0);
+    const int header[4] = {weight_cache_magic, weight_cache_version, (int)cached_layers.size(), 0};
+    const uint64_t cpu_key = get_weight_cache_cpu_key();
+    fwrite(header, sizeof(header), 1, fp);
+    fwrite(&cpu_key, sizeof(cpu_key), 1, fp);
 
-        int lr = layer->load_param(pd);
-        if (lr != 0)
-        {
-            NCNN_LOGE("layer load_param %d failed", i);
-            continue;
-        }
+    size_t offset = sizeof(header) + sizeof(cpu_key);
+    for (size_t i = 0; i < cached_layers.size(); i++)
+    {
+        const int layer_index = cached_layers[i];
 
-        if (layer->support_int8_storage)
-        {
-            // no int8 gpu support yet
-            opt.use_vulkan_compute = false;
-        }
+        std::vector<Mat*> weights;
+        layers[layer_index]->get_pipeline_weights(weights);
 
-        Option opt1 = get_masked_option(opt, layer->featmask);
+        const int entry_header[2] = {layer_index, (int)weights.size()};
+        const uint64_t key = layer_keys[layer_index];
+        fwrite(entry_header, sizeof(entry_header), 1, fp);
+        fwrite(&key, sizeof(key), 1, fp);
+        offset += sizeof(entry_header) + sizeof(key);
 
-        if (layer_support_vulkan && (!layer->support_vulkan || !opt1.use_vulkan_compute))
+        for (size_t j = 0; j < weights.size(); j++)
         {
-            // vulkan layer cannot handle these param, recreate cpu layer
-            Layer* layer_cpu = create_overwrite_builtin_layer(typeindex);
-            if (!layer_cpu)
-            {
-                layer_cpu = create_layer_cpu(typeindex);
-            }
-            if (!layer_cpu)
-            {
-                int custom_index = typeindex & ~LayerType::CustomBit;
-                layer_cpu = create_custom_layer(custom_index);
-            }
-            if (!layer_cpu)
-            {
-                NCNN_LOGE("layer %d not exists or registered", typeindex);
-                clear();
-                return -1;
-            }
+            const Mat& m = *weights[j];
 
-            layer_cpu->bottoms = layer->bottoms;
-            layer_cpu->tops = layer->tops;
-            layer_cpu->bottom_shapes = layer->bottom_shapes;
-            layer_cpu->top_shapes = layer->top_shapes;
-            layer_cpu->featmask = layer->featmask;
-
-            int lr = layer_cpu->load_param(pd);
-            if (lr != 0)
+            WeightCacheMatHeader mh;
+            memset(&mh, 0, sizeof(mh));
+            if (!m.empty())
             {
-                NCNN_LOGE("layer load_param %d failed", i);
-                continue;
+                mh.dims = m.dims;
+                mh.w = m.w;
+                mh.h = m.h;
+                mh.d = m.d;
+                mh.c = m.c;
+                mh.elempack = m.elempack;
+                mh.elemsize = m.elemsize;
+                mh.cstep = m.cstep;
             }
+            fwrite(&mh, sizeof(mh), 1, fp);
+            offset += sizeof(mh);
+            if (m.empty())
+                continue;
 
-            delete layer;
-            layer = layer_cpu;
+            const unsigned char padding[64] = {0};
+            const size_t padding_size = alignSize(offset, 64) - offset;
+            fwrite(padding, 1, padding_size, fp);
+            offset += padding_size;
+
+            const size_t size = m.total() * m.elemsize;
+            fwrite(m.data, 1, size, fp);
+            offset += size;
         }
+    }
 
-        d->layers[i] = layer;
+    const bool failed = ferror(fp) != 0;
+    fclose(fp);
+
+    if (failed)
+    {
+        NCNN_LOGE("fwrite %s failed", tmppath.c_str());
+        remove(tmppath.c_str());
+        return -1;
     }
 
-    d->update_input_output_indexes();
+#ifdef _WIN32
+    remove(weight_cache_path.c_str());
+#endif
+    if (rename(tmppath.c_str(), weight_cache_path.c_str()) != 0)
+    {
+        NCNN_LOGE("rename %s failed", tmppath.c_str());
+        remove(tmppath.c_str());
+        return -1;
+    }
 
-#undef READ_VALUE
     return 0;
 }
+#endif // NCNN_STDIO
 
 int Net::load_model(const DataReader& dr)
 {
@@ -1555,11 +3529,45 @@ int Net::load_model(const DataReader& dr)
     }
 #endif // NCNN_VULKAN
 
-    ModelBinFromDataReader mb(dr);
+    d->assign_layer_storage();
+
+    // lazy pipeline and declared outputs are for cpu
+    const bool lazy_pipeline = d->lazy_pipeline && !opt.use_vulkan_compute;
+    if (opt.use_vulkan_compute)
+        d->needed_layers.clear();
+    else
+        d->update_needed_layers();
+
+    d->created_layers.assign(layer_count, 0);
+
+    ModelBinFromDataReader mb0(dr);
+    ModelBinReferenceTracker mb(mb0, d);
+
+#if NCNN_STDIO
+    // pipeline weights restored from the cache file, and the keys of the ones to save
+    const bool use_weight_cache = !d->weight_cache_path.empty() && !opt.use_vulkan_compute;
+    std::vector<NetPrivate::WeightCacheEntry> weight_cache_entries;
+    std::vector<uint64_t> weight_cache_keys(layer_count, 0);
+    bool weight_cache_outdated = false;
+    if (use_weight_cache)
+    {
+        d->load_weight_cache(weight_cache_entries);
+    }
+#endif // NCNN_STDIO
+
     for (int i = 0; i < layer_count; i++)
     {
         Layer* layer = d->layers[i];
 
+        // layers created later or never, only loaded here
+        const bool create_now = !lazy_pipeline && (d->needed_layers.empty() || d->needed_layers[i]);
+
+        mb.layer_index = i;
+#if NCNN_STDIO
+        mb.hash_weights = use_weight_cache && create_now;
+        mb.weight_hash = hash_seed;
+#endif // NCNN_STDIO
+
         //Here we found inconsistent content in the parameter file.
         if (!layer)
         {
@@ -1580,8 +3588,38 @@ int Net::load_model(const DataReader& dr)
             break;
         }
 
+        if (!create_now)
+            continue;
+
         Option opt1 = get_masked_option(opt, layer->featmask);
 
+#if NCNN_STDIO
+        if (use_weight_cache)
+        {
+            std::vector<Mat*> weights;
+            layer->get_pipeline_weights(weights);
+
+            const uint64_t key = get_weight_cache_key(layer, d->layer_param_hashes[i], mb.weight_hash, opt1);
+            weight_cache_keys[i] = key;
+
+            if (!weights.empty())
+            {
+                if (i < (int)weight_cache_entries.size() && weight_cache_entries[i].key == key && weight_cache_entries[i].weights.size() == weights.size())
+                {
+                    // create_pipeline keeps them
+                    for (size_t j = 0; j < weights.size(); j++)
+                    {
+                        *weights[j] = weight_cache_entries[i].weights[j];
+                    }
+                }
+                else
+                {
+                    weight_cache_outdated = true;
+                }
+            }
+        }
+#endif // NCNN_STDIO
+
         int cret = layer->create_pipeline(opt1);
         if (cret != 0)
         {
@@ -1593,6 +3631,8 @@ int Net::load_model(const DataReader& dr)
             ret = -1;
             break;
         }
+
+        d->created_layers[i] = 1;
     }
 
     if (opt.use_local_pool_allocator)
@@ -1615,6 +3655,16 @@ int Net::load_model(const DataReader& dr)
         }
     }
 
+    d->update_layer_dependencies();
+
+#if NCNN_STDIO
+    if (ret == 0 && weight_cache_outdated)
+    {
+        // failing to write the cache is not fatal
+        d->save_weight_cache(weight_cache_keys);
+    }
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     if (ret == 0 && opt.use_vulkan_compute)
     {
@@ -1692,8 +3742,33 @@ int Net::load_model(const char* modelpath)
 
     int ret = load_model(fp);
     fclose(fp);
+
+    return ret;
+}
+
+int Net::load_model_mmap(const char* modelpath)
+{
+    DataReaderFromMmap* dr = new DataReaderFromMmap(modelpath);
+    if (dr->empty())
+    {
+        NCNN_LOGE("mmap %s failed", modelpath);
+        delete dr;
+        return -1;
+    }
+
+    int ret = load_model(*dr);
+
+    // retain the mapping for referenced weights
+    delete d->model_mmap;
+    d->model_mmap = dr;
+
     return ret;
 }
+
+void Net::set_weight_cache(const char* path)
+{
+    d->weight_cache_path = path ? path : "";
+}
 #endif // NCNN_STDIO
 
 int Net::load_param(const unsigned char* _mem)
@@ -1704,6 +3779,58 @@ int Net::load_param(const unsigned char* _mem)
     return static_cast<int>(mem - _mem);
 }
 
+void Net::set_lazy_pipeline(bool lazy)
+{
+    d->lazy_pipeline = lazy;
+}
+
+#if NCNN_STRING
+int Net::declare_outputs(const std::vector<const char*>& blob_names)
+{
+    std::vector<int> blob_indexes(blob_names.size());
+    for (size_t i = 0; i < blob_names.size(); i++)
+    {
+        blob_indexes[i] = find_blob_index_by_name(blob_names[i]);
+        if (blob_indexes[i] == -1)
+            return -1;
+    }
+
+    return declare_outputs(blob_indexes);
+}
+#endif // NCNN_STRING
+
+int Net::declare_outputs(const std::vector<int>& blob_indexes)
+{
+    for (size_t i = 0; i < blob_indexes.size(); i++)
+    {
+        if (blob_indexes[i] < 0 || blob_indexes[i] >= (int)d->blobs.size())
+        {
+            NCNN_LOGE("declare_outputs blob %d not exists", blob_indexes[i]);
+            return -1;
+        }
+    }
+
+    d->declared_output_indexes = blob_indexes;
+
+    return 0;
+}
+
+size_t Net::referenced_weight_bytes(int layer_index) const
+{
+    size_t bytes = 0;
+    for (size_t i = 0; i < d->referenced_weights.size(); i++)
+    {
+        const NetPrivate::ReferencedWeight& rw = d->referenced_weights[i];
+        if (layer_index != -1 && rw.layer_index != layer_index)
+            continue;
+
+        if (*rw.refcount > 0)
+            bytes += rw.size;
+    }
+
+    return bytes;
+}
+
 int Net::load_model(const unsigned char* _mem)
 {
     const unsigned char* mem = _mem;
@@ -1780,6 +3907,11 @@ int Net::load_model(AAssetManager* mgr, const char* assetpath)
 
 void Net::clear()
 {
+#if NCNN_THREADS
+    delete d->branch_thread_pool;
+    d->branch_thread_pool = 0;
+#endif // NCNN_THREADS
+
     d->blobs.clear();
     for (size_t i = 0; i < d->layers.size(); i++)
     {
@@ -1787,11 +3919,15 @@ void Net::clear()
 
         Option opt1 = get_masked_option(opt, layer->featmask);
 
-        int dret = layer->destroy_pipeline(opt1);
-        if (dret != 0)
+        // skip the layers lazy or not needed
+        if (i >= d->created_layers.size() || d->created_layers[i])
         {
-            NCNN_LOGE("layer destroy_pipeline failed");
-            // ignore anyway
+            int dret = layer->destroy_pipeline(opt1);
+            if (dret != 0)
+            {
+                NCNN_LOGE("layer destroy_pipeline failed");
+                // ignore anyway
+            }
         }
 
         if (layer->typeindex & ncnn::LayerType::CustomBit)
@@ -1831,6 +3967,9 @@ void Net::clear()
         }
     }
     d->layers.clear();
+    d->created_layers.clear();
+    d->needed_layers.clear();
+    d->declared_output_indexes.clear();
 
     if (d->local_blob_allocator)
     {
@@ -1843,24 +3982,232 @@ void Net::clear()
         d->local_workspace_allocator = 0;
     }
 
-#if NCNN_VULKAN
-    if (d->weight_vkallocator)
-    {
-        delete d->weight_vkallocator;
-        d->weight_vkallocator = 0;
-    }
-    if (d->weight_staging_vkallocator)
-    {
-        delete d->weight_staging_vkallocator;
-        d->weight_staging_vkallocator = 0;
+    d->clear_memory_arenas();
+    d->memory_plan_offsets.clear();
+    d->memory_plan_sizes.clear();
+    d->memory_plan_predecessors.clear();
+    d->memory_plan_bytes = 0;
+
+    for (size_t i = 0; i < d->referenced_weights.size(); i++)
+    {
+        delete d->referenced_weights[i].refcount;
+    }
+    d->referenced_weights.clear();
+
+#if NCNN_STDIO
+    if (d->model_mmap)
+    {
+        delete d->model_mmap;
+        d->model_mmap = 0;
+    }
+    if (d->weight_cache_mmap)
+    {
+        delete d->weight_cache_mmap;
+        d->weight_cache_mmap = 0;
+    }
+    d->layer_param_hashes.clear();
+#endif // NCNN_STDIO
+
+#if NCNN_VULKAN
+    if (d->weight_vkallocator)
+    {
+        delete d->weight_vkallocator;
+        d->weight_vkallocator = 0;
+    }
+    if (d->weight_staging_vkallocator)
+    {
+        delete d->weight_staging_vkallocator;
+        d->weight_staging_vkallocator = 0;
+    }
+    if (d->pipeline_cache)
+    {
+        delete d->pipeline_cache;
+        d->pipeline_cache = 0;
+        opt.pipeline_cache = 0;
+    }
+#endif // NCNN_VULKAN
+}
+
+int Net::plan_memory(const std::vector<Mat>& _inputs)
+{
+    if (d->layers.empty())
+    {
+        NCNN_LOGE("network graph not ready");
+        return -1;
+    }
+
+    const size_t input_count = d->input_blob_indexes.size();
+
+    std::vector<Mat> inputs = _inputs;
+    if (inputs.empty())
+    {
+        // fixed input shape from shape hints or input layer
+        inputs.resize(input_count);
+        for (size_t i = 0; i < input_count; i++)
+        {
+            int blob_index = d->input_blob_indexes[i];
+
+            const Mat& shape = d->blobs[blob_index].shape;
+            if (shape.dims == 1) inputs[i].create(shape.w);
+            if (shape.dims == 2) inputs[i].create(shape.w, shape.h);
+            if (shape.dims == 3) inputs[i].create(shape.w, shape.h, shape.c);
+            if (shape.dims == 4) inputs[i].create(shape.w, shape.h, shape.d, shape.c);
+
+            const Layer* layer = d->layers[d->blobs[blob_index].producer];
+            if (inputs[i].empty() && layer->typeindex == LayerType::Input)
+            {
+                const Input* input = (const Input*)layer;
+                if (input->d != 0) inputs[i].create(input->w, input->h, input->d, input->c);
+                else if (input->c != 0) inputs[i].create(input->w, input->h, input->c);
+                else if (input->h != 0) inputs[i].create(input->w, input->h);
+                else if (input->w != 0) inputs[i].create(input->w);
+            }
+
+            if (inputs[i].empty())
+            {
+                NCNN_LOGE("plan_memory input %d shape unknown", (int)i);
+                return -1;
+            }
+
+            inputs[i].fill(0.f);
+        }
+    }
+
+    if (inputs.size() != input_count)
+    {
+        NCNN_LOGE("plan_memory got %d inputs while network has %d inputs", (int)inputs.size(), (int)input_count);
+        return -1;
+    }
+
+    // arenas and the plan they refer to must outlive extractors and extracted mats
+    if (d->memory_arenas_in_use())
+    {
+        NCNN_LOGE("plan_memory while extractors or mats still use the planned arena");
+        return -1;
+    }
+
+    d->clear_memory_arenas();
+    d->memory_plan_offsets.clear();
+    d->memory_plan_sizes.clear();
+    d->memory_plan_predecessors.clear();
+    d->memory_plan_bytes = 0;
+
+    // record one inference on the fixed shape
+    MemoryRecordAllocator recorder;
+    {
+        Extractor ex = create_extractor();
+        ex.set_blob_allocator(&recorder);
+        ex.set_workspace_allocator(&recorder);
+
+        for (size_t i = 0; i < input_count; i++)
+        {
+            ex.input(d->input_blob_indexes[i], inputs[i]);
+        }
+
+        for (size_t i = 0; i < d->output_blob_indexes.size(); i++)
+        {
+            Mat out;
+            int ret = ex.extract(d->output_blob_indexes[i], out);
+            if (ret != 0)
+            {
+                NCNN_LOGE("plan_memory extract %d failed", d->output_blob_indexes[i]);
+                return ret;
+            }
+        }
+    }
+
+    const std::vector<MemoryRecordAllocator::Record>& records = recorder.records;
+    const int record_count = (int)records.size();
+    const int end_time = record_count * 2;
+
+    d->memory_plan_sizes.resize(record_count);
+    for (int i = 0; i < record_count; i++)
+    {
+        d->memory_plan_sizes[i] = alignSize(records[i].size, NCNN_MALLOC_ALIGN);
+    }
+
+    // place large blocks first at the lowest offset free during their lifetime
+    std::vector<int> order(record_count);
+    for (int i = 0; i < record_count; i++)
+    {
+        order[i] = i;
+    }
+    for (int i = 1; i < record_count; i++)
+    {
+        // stable insertion sort by size descending
+        int x = order[i];
+        int j = i - 1;
+        for (; j >= 0 && d->memory_plan_sizes[order[j]] < d->memory_plan_sizes[x]; j--)
+        {
+            order[j + 1] = order[j];
+        }
+        order[j + 1] = x;
+    }
+
+    d->memory_plan_offsets.resize(record_count);
+    std::vector<int> placed;
+    for (int i = 0; i < record_count; i++)
+    {
+        const int x = order[i];
+        const int x_begin = records[x].alloc_time;
+        const int x_end = records[x].free_time == -1 ? end_time : records[x].free_time;
+        const size_t x_size = d->memory_plan_sizes[x];
+
+        // placed blocks alive at the same time, sorted by offset
+        std::vector<std::pair<size_t, size_t> > conflicts;
+        for (size_t j = 0; j < placed.size(); j++)
+        {
+            const int y = placed[j];
+            const int y_begin = records[y].alloc_time;
+            const int y_end = records[y].free_time == -1 ? end_time : records[y].free_time;
+            if (x_begin < y_end && y_begin < x_end)
+            {
+                conflicts.push_back(std::make_pair(d->memory_plan_offsets[y], d->memory_plan_sizes[y]));
+            }
+        }
+        std::sort(conflicts.begin(), conflicts.end());
+
+        size_t offset = 0;
+        for (size_t j = 0; j < conflicts.size(); j++)
+        {
+            if (offset + x_size <= conflicts[j].first)
+                break;
+
+            offset = std::max(offset, conflicts[j].first + conflicts[j].second);
+        }
+
+        d->memory_plan_offsets[x] = offset;
+        d->memory_plan_bytes = std::max(d->memory_plan_bytes, offset + x_size);
+        placed.push_back(x);
     }
-    if (d->pipeline_cache)
+
+    // the next allocation overlapping each one checks that it is freed
+    d->memory_plan_predecessors.resize(record_count);
+    for (int i = 0; i < record_count; i++)
     {
-        delete d->pipeline_cache;
-        d->pipeline_cache = 0;
-        opt.pipeline_cache = 0;
+        const size_t offset = d->memory_plan_offsets[i];
+        const size_t end = offset + d->memory_plan_sizes[i];
+        for (int j = i + 1; j < record_count; j++)
+        {
+            if (offset < d->memory_plan_offsets[j] + d->memory_plan_sizes[j] && d->memory_plan_offsets[j] < end)
+            {
+                d->memory_plan_predecessors[j].push_back(i);
+                break;
+            }
+        }
     }
-#endif // NCNN_VULKAN
+
+    return 0;
+}
+
+size_t Net::planned_memory_bytes() const
+{
+    return d->memory_plan_bytes;
+}
+
+int Net::layout_conversion_count() const
+{
+    return atomic_load_int(&d->layout_conversion_count);
 }
 
 Extractor Net::create_extractor() const
@@ -2035,13 +4382,26 @@ class ExtractorPrivate
 {
 public:
     ExtractorPrivate(const Net* _net)
-        : net(_net)
+        : net(_net), profiler(0), profiled_blob_allocator(0), profiled_workspace_allocator(1)
     {
     }
     const Net* net;
     std::vector<Mat> blob_mats;
     Option opt;
 
+    Profiler* profiler;
+    ProfiledAllocator profiled_blob_allocator;
+    ProfiledAllocator profiled_workspace_allocator;
+
+    // blob mats of each sample in batch mode
+    std::vector<std::vector<Mat> > batch_blob_mats;
+
+    MemoryArenaAllocator* local_memory_arena;
+
+    void use_local_allocator();
+    Option get_forward_option();
+    int convert_output(Mat& feat, int type) const;
+
 #if NCNN_VULKAN
     VkAllocator* local_blob_vkallocator;
     VkAllocator* local_staging_vkallocator;
@@ -2050,11 +4410,132 @@ public:
 #endif // NCNN_VULKAN
 };
 
+void ExtractorPrivate::use_local_allocator()
+{
+    if (!opt.use_local_pool_allocator)
+        return;
+
+    if (!opt.blob_allocator && !opt.workspace_allocator && net->d->memory_plan_bytes != 0)
+    {
+        // draw blobs and workspace from the planned arena
+        local_memory_arena = net->d->acquire_memory_arena();
+        opt.blob_allocator = local_memory_arena;
+        opt.workspace_allocator = local_memory_arena;
+    }
+    if (!opt.blob_allocator)
+    {
+        opt.blob_allocator = net->d->local_blob_allocator;
+    }
+    if (!opt.workspace_allocator)
+    {
+        opt.workspace_allocator = net->d->local_workspace_allocator;
+    }
+}
+
+Option ExtractorPrivate::get_forward_option()
+{
+    if (!profiler)
+        return opt;
+
+    // count the allocation of each layer
+    Option opt_profiled = opt;
+    profiled_blob_allocator.allocator = opt.blob_allocator;
+    profiled_workspace_allocator.allocator = opt.workspace_allocator;
+    opt_profiled.blob_allocator = &profiled_blob_allocator;
+    opt_profiled.workspace_allocator = &profiled_workspace_allocator;
+    return opt_profiled;
+}
+
+int ExtractorPrivate::convert_output(Mat& feat, int type) const
+{
+    if (opt.use_packing_layout && (type == 0) && feat.elempack != 1)
+    {
+        Mat bottom_blob_unpacked;
+        convert_packing(feat, bottom_blob_unpacked, 1, opt);
+        feat = bottom_blob_unpacked;
+        if (feat.empty())
+            return -100;
+    }
+
+    // clang-format off
+    // *INDENT-OFF*
+#if NCNN_ARM82
+    if (opt.use_fp16_storage && cpu_support_arm_asimdhp() && (type == 0))
+    {
+        if (feat.elembits() == 16)
+        {
+            Mat feat_fp32;
+            cast_float16_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+        }
+    }
+    else
+#endif // NCNN_ARM82
+#if NCNN_VFPV4
+    if (opt.use_fp16_storage && !opt.use_bf16_storage && cpu_support_arm_vfpv4() && (type == 0))
+    {
+        if (feat.elembits() == 16)
+        {
+            Mat feat_fp32;
+            cast_float16_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+        }
+    }
+    else
+#endif // NCNN_VFPV4
+#if NCNN_ZVFH
+    if (opt.use_fp16_storage && cpu_support_riscv_zvfh() && (type == 0))
+    {
+        if (feat.elembits() == 16)
+        {
+            Mat feat_fp32;
+            cast_float16_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+        }
+    }
+    else
+#endif // NCNN_ZVFH
+#if NCNN_BF16
+    if (opt.use_bf16_storage && (type == 0))
+    {
+        if (feat.elembits() == 16)
+        {
+            Mat feat_fp32;
+            cast_bfloat16_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+        }
+    }
+    else
+#endif // NCNN_BF16
+    if (feat.elembits() == 8 && (type == 0))
+    {
+        Mat feat_fp32;
+        cast_int8_to_float32(feat, feat_fp32, opt);
+        feat = feat_fp32;
+    }
+    // *INDENT-ON*
+    // clang-format on
+    if (feat.empty())
+        return -100;
+
+    if ((opt.use_local_pool_allocator && (feat.allocator == net->d->local_blob_allocator || (local_memory_arena && feat.allocator == local_memory_arena))) || feat.allocator == &profiled_blob_allocator)
+    {
+        // detach the returned mat from local pool allocator
+        // so we could destroy net instance much earlier
+        feat = feat.clone();
+        if (feat.empty())
+            return -100;
+    }
+
+    return 0;
+}
+
 Extractor::Extractor(const Net* _net, size_t blob_count)
     : d(new ExtractorPrivate(_net))
 {
     d->blob_mats.resize(blob_count);
     d->opt = d->net->opt;
+    d->local_memory_arena = 0;
 
 #if NCNN_VULKAN
     if (d->net->opt.use_vulkan_compute)
@@ -2079,7 +4560,19 @@ Extractor::Extractor(const Extractor& rhs)
 {
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->batch_blob_mats = rhs.d->batch_blob_mats;
     d->opt = rhs.d->opt;
+    d->profiler = rhs.d->profiler;
+    d->local_memory_arena = 0;
+
+    // the planned arena belongs to rhs
+    if (rhs.d->local_memory_arena)
+    {
+        if (d->opt.blob_allocator == rhs.d->local_memory_arena)
+            d->opt.blob_allocator = 0;
+        if (d->opt.workspace_allocator == rhs.d->local_memory_arena)
+            d->opt.workspace_allocator = 0;
+    }
 
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
@@ -2094,9 +4587,26 @@ Extractor& Extractor::operator=(const Extractor& rhs)
     if (this == &rhs)
         return *this;
 
+    if (d->local_memory_arena)
+    {
+        d->net->d->reclaim_memory_arena(d->local_memory_arena);
+    }
+
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->batch_blob_mats = rhs.d->batch_blob_mats;
     d->opt = rhs.d->opt;
+    d->profiler = rhs.d->profiler;
+    d->local_memory_arena = 0;
+
+    // the planned arena belongs to rhs
+    if (rhs.d->local_memory_arena)
+    {
+        if (d->opt.blob_allocator == rhs.d->local_memory_arena)
+            d->opt.blob_allocator = 0;
+        if (d->opt.workspace_allocator == rhs.d->local_memory_arena)
+            d->opt.workspace_allocator = 0;
+    }
 
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
@@ -2111,6 +4621,18 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 void Extractor::clear()
 {
     d->blob_mats.clear();
+    d->batch_blob_mats.clear();
+
+    if (d->local_memory_arena)
+    {
+        if (d->opt.blob_allocator == d->local_memory_arena)
+            d->opt.blob_allocator = 0;
+        if (d->opt.workspace_allocator == d->local_memory_arena)
+            d->opt.workspace_allocator = 0;
+
+        d->net->d->reclaim_memory_arena(d->local_memory_arena);
+        d->local_memory_arena = 0;
+    }
 
 #if NCNN_VULKAN
     if (d->opt.use_vulkan_compute)
@@ -2136,6 +4658,16 @@ void Extractor::set_light_mode(bool enable)
     d->opt.lightmode = enable;
 }
 
+void Extractor::set_branch_parallel(bool enable)
+{
+    d->opt.use_branch_parallel = enable;
+}
+
+void Extractor::set_profiler(Profiler* profiler)
+{
+    d->profiler = profiler;
+}
+
 void Extractor::set_num_threads(int num_threads)
 {
     NCNN_LOGE("ex.set_num_threads() is no-op, please set net.opt.num_threads=N before net.load_param()");
@@ -2236,22 +4768,16 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
 
     int ret = 0;
 
-    if (d->blob_mats[blob_index].dims == 0)
+    if (d->blob_mats[blob_index].dims == 0 && !d->net->d->needed_layers.empty() && !d->net->d->needed_layers[d->net->blobs()[blob_index].producer])
+    {
+        NCNN_LOGE("extract blob %d not declared by declare_outputs", blob_index);
+        ret = -1;
+    }
+    else if (d->blob_mats[blob_index].dims == 0)
     {
         int layer_index = d->net->blobs()[blob_index].producer;
 
-        // use local allocator
-        if (d->opt.use_local_pool_allocator)
-        {
-            if (!d->opt.blob_allocator)
-            {
-                d->opt.blob_allocator = d->net->d->local_blob_allocator;
-            }
-            if (!d->opt.workspace_allocator)
-            {
-                d->opt.workspace_allocator = d->net->d->local_workspace_allocator;
-            }
-        }
+        d->use_local_allocator();
 
 #if NCNN_VULKAN
         if (d->opt.use_vulkan_compute)
@@ -2304,10 +4830,18 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
         }
         else
         {
-            ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+            const Option opt = d->get_forward_option();
+            if (opt.use_branch_parallel)
+                ret = d->net->d->forward_layer_branch_parallel(layer_index, d->blob_mats, d->profiler, opt);
+            else
+                ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->profiler, opt);
         }
 #else
-        ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+        const Option opt = d->get_forward_option();
+        if (opt.use_branch_parallel)
+            ret = d->net->d->forward_layer_branch_parallel(layer_index, d->blob_mats, d->profiler, opt);
+        else
+            ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->profiler, opt);
 #endif // NCNN_VULKAN
     }
 
@@ -2316,83 +4850,152 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
     // empty is valid for outputs
     if (!feat.empty())
     {
-        if (d->opt.use_packing_layout && (type == 0) && feat.elempack != 1)
-        {
-            Mat bottom_blob_unpacked;
-            convert_packing(feat, bottom_blob_unpacked, 1, d->opt);
-            feat = bottom_blob_unpacked;
-            if (feat.empty())
-                return -100;
-        }
+        ret = d->convert_output(feat, type);
+    }
 
-        // clang-format off
-        // *INDENT-OFF*
-#if NCNN_ARM82
-        if (d->opt.use_fp16_storage && cpu_support_arm_asimdhp() && (type == 0))
-        {
-            if (feat.elembits() == 16)
-            {
-                Mat feat_fp32;
-                cast_float16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
-            }
-        }
-        else
-#endif // NCNN_ARM82
-#if NCNN_VFPV4
-        if (d->opt.use_fp16_storage && !d->opt.use_bf16_storage && cpu_support_arm_vfpv4() && (type == 0))
+    set_kmp_blocktime(old_blocktime);
+    set_flush_denormals(old_flush_denormals);
+
+    return ret;
+}
+
+#if NCNN_STRING
+int Extractor::input(const char* blob_name, const std::vector<Mat>& in)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& input_names = d->net->input_names();
+        for (size_t i = 0; i < input_names.size(); i++)
         {
-            if (feat.elembits() == 16)
-            {
-                Mat feat_fp32;
-                cast_float16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
-            }
+            NCNN_LOGE("    ex.input(\"%s\", in%d);", input_names[i], (int)i);
         }
-        else
-#endif // NCNN_VFPV4
-#if NCNN_ZVFH
-        if (d->opt.use_fp16_storage && cpu_support_riscv_zvfh() && (type == 0))
+
+        return -1;
+    }
+
+    return input(blob_index, in);
+}
+
+int Extractor::extract(const char* blob_name, std::vector<Mat>& feats, int type)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& output_names = d->net->output_names();
+        for (size_t i = 0; i < output_names.size(); i++)
         {
-            if (feat.elembits() == 16)
-            {
-                Mat feat_fp32;
-                cast_float16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
-            }
+            NCNN_LOGE("    ex.extract(\"%s\", out%d);", output_names[i], (int)i);
         }
-        else
-#endif // NCNN_ZVFH
-#if NCNN_BF16
-        if (d->opt.use_bf16_storage && (type == 0))
+
+        return -1;
+    }
+
+    return extract(blob_index, feats, type);
+}
+#endif // NCNN_STRING
+
+int Extractor::input(int blob_index, const std::vector<Mat>& in)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size() || in.empty())
+        return -1;
+
+    if (!d->batch_blob_mats.empty() && d->batch_blob_mats.size() != in.size())
+    {
+        NCNN_LOGE("batch size %d mismatch, previous input batch size %d", (int)in.size(), (int)d->batch_blob_mats.size());
+        return -1;
+    }
+
+    const Mat& m0 = in[0];
+    for (size_t i = 1; i < in.size(); i++)
+    {
+        const Mat& m = in[i];
+        if (m.dims != m0.dims || m.w != m0.w || m.h != m0.h || m.d != m0.d || m.c != m0.c || m.elemsize != m0.elemsize || m.elempack != m0.elempack)
         {
-            if (feat.elembits() == 16)
-            {
-                Mat feat_fp32;
-                cast_bfloat16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
-            }
+            NCNN_LOGE("batch input %d shape mismatch", (int)i);
+            return -1;
         }
-        else
-#endif // NCNN_BF16
-        if (feat.elembits() == 8 && (type == 0))
+    }
+
+    if (d->batch_blob_mats.empty())
+    {
+        d->batch_blob_mats.resize(in.size(), std::vector<Mat>(d->blob_mats.size()));
+    }
+
+    for (size_t i = 0; i < in.size(); i++)
+    {
+        d->batch_blob_mats[i][blob_index] = in[i];
+    }
+
+    return 0;
+}
+
+int Extractor::extract(int blob_index, std::vector<Mat>& feats, int type)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size() || d->batch_blob_mats.empty())
+        return -1;
+
+    const size_t batch = d->batch_blob_mats.size();
+
+    feats.resize(batch);
+
+#if NCNN_VULKAN
+    if (d->opt.use_vulkan_compute)
+    {
+        // gpu forwards the samples one by one
+        for (size_t i = 0; i < batch; i++)
         {
-            Mat feat_fp32;
-            cast_int8_to_float32(feat, feat_fp32, d->opt);
-            feat = feat_fp32;
+            d->blob_mats.swap(d->batch_blob_mats[i]);
+
+            // intermediate gpu blobs belong to one sample
+            d->blob_mats_gpu.assign(d->blob_mats_gpu.size(), VkMat());
+
+            int ret = extract(blob_index, feats[i], type);
+
+            d->blob_mats.swap(d->batch_blob_mats[i]);
+
+            if (ret != 0)
+                return ret;
         }
-        // *INDENT-ON*
-        // clang-format on
-        if (feat.empty())
-            return -100;
 
-        if (d->opt.use_local_pool_allocator && feat.allocator == d->net->d->local_blob_allocator)
+        d->blob_mats_gpu.assign(d->blob_mats_gpu.size(), VkMat());
+
+        return 0;
+    }
+#endif // NCNN_VULKAN
+
+    int old_blocktime = get_kmp_blocktime();
+    set_kmp_blocktime(d->opt.openmp_blocktime);
+
+    int old_flush_denormals = get_flush_denormals();
+    set_flush_denormals(d->opt.flush_denormals);
+
+    int ret = 0;
+
+    if (d->batch_blob_mats[0][blob_index].dims == 0 && !d->net->d->needed_layers.empty() && !d->net->d->needed_layers[d->net->blobs()[blob_index].producer])
+    {
+        NCNN_LOGE("extract blob %d not declared by declare_outputs", blob_index);
+        ret = -1;
+    }
+    else if (d->batch_blob_mats[0][blob_index].dims == 0)
+    {
+        int layer_index = d->net->blobs()[blob_index].producer;
+
+        d->use_local_allocator();
+
+        ret = d->net->d->forward_layer_batch(layer_index, d->batch_blob_mats, d->profiler, d->get_forward_option());
+    }
+
+    for (size_t i = 0; i < batch && ret == 0; i++)
+    {
+        feats[i] = d->batch_blob_mats[i][blob_index];
+
+        // empty is valid for outputs
+        if (!feats[i].empty())
         {
-            // detach the returned mat from local pool allocator
-            // so we could destroy net instance much earlier
-            feat = feat.clone();
-            if (feat.empty())
-                return -100;
+            ret = d->convert_output(feats[i], type);
         }
     }
 
@@ -9,6 +9,7 @@
 #include "mat.h"
 #include "option.h"
 #include "platform.h"
+#include "profiler.h"
 
 #if NCNN_PLATFORM_API
 #if __ANDROID_API__ >= 9
@@ -81,6 +82,20 @@ public:
     // return 0 if success
     int load_model(FILE* fp);
     int load_model(const char* modelpath);
+
+    // map network weight data from model file into memory
+    // weight data is referenced instead of copied where possible
+    // processes loading the same file share the page cache
+    // the mapping is retained until clear()
+    // return 0 if success
+    int load_model_mmap(const char* modelpath);
+
+    // cache the weights transformed by layer create_pipeline in a file
+    // load_model with the same model, option and cpu maps them back and skips the transform
+    // the cache is keyed on the weight content hashed while loading, the param, option, cpu and ncnn build
+    // otherwise load_model transforms as usual and rewrites the file
+    // call before load_model, null path disables the cache
+    void set_weight_cache(const char* path);
 #endif // NCNN_STDIO
 
     // load network structure from external memory
@@ -112,6 +127,42 @@ public:
 #endif // __ANDROID_API__ >= 9
 #endif // NCNN_PLATFORM_API
 
+    // defer layer create_pipeline from load_model to the first forward reaching the layer
+    // with load_model_mmap, the weights of layers never reached are not even read
+    // call before load_model
+    void set_lazy_pipeline(bool lazy);
+
+#if NCNN_STRING
+    // declare the blobs that extractors are going to extract
+    // layers none of them depends on are never created and extracting their blobs fails
+    // their weights are still read by load_model, use load_model_mmap to keep them as untouched file pages
+    // call after load_param and before load_model
+    // return 0 if success
+    int declare_outputs(const std::vector<const char*>& blob_names);
+#endif // NCNN_STRING
+    int declare_outputs(const std::vector<int>& blob_indexes);
+
+    // plan intermediate blob memory for a fixed input shape
+    // inputs are ordered as input_indexes(), input shape hints are used if empty
+    // extractor with the default local allocator then draws blobs and workspace from one preallocated arena
+    // allocations not matching the plan fall back to heap
+    // call after load_model and before create_extractor
+    // replanning fails while extractors or extracted mats still use the planned arena
+    // return 0 if success
+    int plan_memory(const std::vector<Mat>& inputs = std::vector<Mat>());
+
+    // peak arena bytes of the memory plan, 0 if not planned
+    size_t planned_memory_bytes() const;
+
+    // bytes of weight data still referenced from model memory without copying
+    // weights repacked and released by layers in create_pipeline are not counted
+    // layer_index -1 for all layers
+    size_t referenced_weight_bytes(int layer_index = -1) const;
+
+    // count of bottom blobs cast or repacked before layer forward, summed over all extractors
+    // read it before and after extract for the conversions of one inference
+    int layout_conversion_count() const;
+
     // unload network structure and weight data
     void clear();
 
@@ -134,6 +185,7 @@ public:
 
 protected:
     friend class Extractor;
+    friend class ExtractorPrivate;
 #if NCNN_STRING
     int find_blob_index_by_name(const char* name) const;
     int find_layer_index_by_name(const char* name) const;
@@ -171,6 +223,15 @@ public:
     // enabled by default
     void set_light_mode(bool enable);
 
+    // run independent graph branches concurrently
+    // blob and workspace allocator must be thread-safe
+    // disabled by default
+    void set_branch_parallel(bool enable);
+
+    // record the time, shape and allocation of every cpu layer forward
+    // pass null to stop recording
+    void set_profiler(Profiler* profiler);
+
     // deprecated, no-op
     // instead, set net.opt.num_threads before net.load_param()
     void set_num_threads(int num_threads);
@@ -215,6 +276,25 @@ public:
     // type = 1, do not convert fp16/bf16 or / and packing
     int extract(int blob_index, Mat& feat, int type = 0);
 
+#if NCNN_STRING
+    // set batch input by blob name, one mat per sample of identical shape
+    // return 0 if success
+    int input(const char* blob_name, const std::vector<Mat>& in);
+
+    // get batch result by blob name, one mat per sample
+    // convolution innerproduct and gemm forward all samples at once
+    // return 0 if success
+    int extract(const char* blob_name, std::vector<Mat>& feats, int type = 0);
+#endif // NCNN_STRING
+
+    // set batch input by blob index
+    // return 0 if success
+    int input(int blob_index, const std::vector<Mat>& in);
+
+    // get batch result by blob index
+    // return 0 if success
+    int extract(int blob_index, std::vector<Mat>& feats, int type = 0);
+
 #if NCNN_VULKAN
 #if NCNN_STRING
     // set input by blob name
@@ -67,8 +67,9 @@ Option::Option()
     use_fp16_uniform = true;
     use_int8_uniform = true;
 
-    use_reserved_9 = false;
-    use_reserved_10 = false;
+    use_branch_parallel = false;
+
+    use_storage_assignment = false;
     use_reserved_11 = false;
 }
 
@@ -141,8 +141,18 @@ public:
     bool use_fp16_uniform;
     bool use_int8_uniform;
 
-    bool use_reserved_9;
-    bool use_reserved_10;
+    // run independent graph branches concurrently on cpu
+    // at most num_threads layers run at the same time, each gets a share of num_threads
+    // gemm and convolution with pre-packed tiles keep the load-time tile config
+    // and run with their share, never more than the load-time num_threads
+    // blob and workspace allocator must be thread-safe when enabled
+    // disabled by default
+    bool use_branch_parallel;
+
+    // let load_model pick fp32 or bf16/fp16 storage per layer to minimize the casts between layers
+    // cheap layers between fp32-only layers then run in fp32
+    // disabled by default
+    bool use_storage_assignment;
     bool use_reserved_11;
 };
 
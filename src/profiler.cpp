@@ -0,0 +1,279 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "profiler.h"
+
+#include "benchmark.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace ncnn {
+
+ProfilerRecord::ProfilerRecord()
+{
+    type = 0;
+    layer_index = -1;
+    start = 0.0;
+    end = 0.0;
+    thread_id = 0;
+    num_threads = 1;
+    blob_bytes = 0;
+    workspace_bytes = 0;
+}
+
+class ProfilerPrivate
+{
+public:
+    double origin;
+
+    Mutex lock;
+    std::vector<ProfilerRecord> records;
+
+    // thread index + 1 of the recording threads
+    ThreadLocalStorage thread_index;
+    int thread_count;
+};
+
+Profiler::Profiler()
+    : d(new ProfilerPrivate)
+{
+    d->origin = get_current_time();
+    d->thread_count = 0;
+}
+
+Profiler::~Profiler()
+{
+    delete d;
+}
+
+Profiler::Profiler(const Profiler&)
+    : d(0)
+{
+}
+
+Profiler& Profiler::operator=(const Profiler&)
+{
+    return *this;
+}
+
+void Profiler::clear()
+{
+    MutexLockGuard g(d->lock);
+
+    d->records.clear();
+    d->origin = get_current_time();
+}
+
+std::vector<ProfilerRecord> Profiler::records() const
+{
+    MutexLockGuard g(d->lock);
+
+    return d->records;
+}
+
+void Profiler::record(const ProfilerRecord& r)
+{
+    MutexLockGuard g(d->lock);
+
+    size_t thread_index = (size_t)d->thread_index.get();
+    if (thread_index == 0)
+    {
+        thread_index = ++d->thread_count;
+        d->thread_index.set((void*)thread_index);
+    }
+
+    d->records.push_back(r);
+
+    ProfilerRecord& r2 = d->records.back();
+    r2.start = r.start - d->origin;
+    r2.end = r.end - d->origin;
+    r2.thread_id = (int)thread_index - 1;
+}
+
+int Profiler::layout_conversion_count() const
+{
+    MutexLockGuard g(d->lock);
+
+    int count = 0;
+    for (size_t i = 0; i < d->records.size(); i++)
+    {
+        const ProfilerRecord& r = d->records[i];
+        if (r.type != 1)
+            continue;
+
+        for (size_t j = 0; j < r.bottom_shapes.size() && j < r.top_shapes.size(); j++)
+        {
+            if (r.bottom_shapes[j].elempack != r.top_shapes[j].elempack || r.bottom_shapes[j].elemsize != r.top_shapes[j].elemsize)
+                count++;
+        }
+    }
+
+    return count;
+}
+
+static const char* record_type_name(const ProfilerRecord& r)
+{
+#if NCNN_STRING
+    if (r.type == 0)
+        return r.layer_type.c_str();
+#endif // NCNN_STRING
+
+    return r.type == 0 ? "layer" : "convert_layout";
+}
+
+// records of one layer type summed up
+struct ProfilerSummary
+{
+    const char* type;
+    int count;
+    double total;
+    double min;
+    double max;
+    size_t blob_bytes;
+    size_t workspace_bytes;
+
+    bool operator<(const ProfilerSummary& rhs) const
+    {
+        return total > rhs.total;
+    }
+};
+
+void Profiler::print_summary() const
+{
+    std::vector<ProfilerRecord> rs = records();
+
+    std::vector<ProfilerSummary> summaries;
+    double total = 0.0;
+    for (size_t i = 0; i < rs.size(); i++)
+    {
+        const ProfilerRecord& r = rs[i];
+        const char* type = record_type_name(r);
+        const double duration = r.end - r.start;
+
+        size_t j = 0;
+        for (; j < summaries.size(); j++)
+        {
+            if (strcmp(summaries[j].type, type) == 0)
+                break;
+        }
+        if (j == summaries.size())
+        {
+            ProfilerSummary s;
+            s.type = type;
+            s.count = 0;
+            s.total = 0.0;
+            s.min = duration;
+            s.max = duration;
+            s.blob_bytes = 0;
+            s.workspace_bytes = 0;
+            summaries.push_back(s);
+        }
+
+        ProfilerSummary& s = summaries[j];
+        s.count += 1;
+        s.total += duration;
+        s.min = std::min(s.min, duration);
+        s.max = std::max(s.max, duration);
+        s.blob_bytes += r.blob_bytes;
+        s.workspace_bytes += r.workspace_bytes;
+
+        total += duration;
+    }
+
+    std::sort(summaries.begin(), summaries.end());
+
+    NCNN_LOGE("%-24s %6s %10s %10s %10s %10s %7s %12s %12s", "type", "count", "total ms", "avg ms", "min ms", "max ms", "%", "blob KB", "workspace KB");
+    for (size_t i = 0; i < summaries.size(); i++)
+    {
+        const ProfilerSummary& s = summaries[i];
+        NCNN_LOGE("%-24s %6d %10.3f %10.3f %10.3f %10.3f %6.2f%% %12.1f %12.1f", s.type, s.count, s.total, s.total / s.count, s.min, s.max, total > 0.0 ? s.total * 100.0 / total : 0.0, s.blob_bytes / 1024.0, s.workspace_bytes / 1024.0);
+    }
+    NCNN_LOGE("%-24s %6d %10.3f", "sum", (int)rs.size(), total);
+}
+
+#if NCNN_STDIO
+static void write_json_string(FILE* fp, const char* s)
+{
+    fputc('"', fp);
+    for (; *s; s++)
+    {
+        if (*s == '"' || *s == '\\')
+            fputc('\\', fp);
+        if ((unsigned char)*s < 0x20)
+            continue;
+        fputc(*s, fp);
+    }
+    fputc('"', fp);
+}
+
+static void write_json_shapes(FILE* fp, const std::vector<Mat>& shapes)
+{
+    fprintf(fp, "[");
+    for (size_t i = 0; i < shapes.size(); i++)
+    {
+        const Mat& m = shapes[i];
+        if (i != 0)
+            fprintf(fp, ",");
+
+        if (m.dims == 0)
+        {
+            fprintf(fp, "\"[]\"");
+            continue;
+        }
+
+        // unpacked shape
+        if (m.dims == 1) fprintf(fp, "\"[%d]", m.w * m.elempack);
+        if (m.dims == 2) fprintf(fp, "\"[%d,%d]", m.w, m.h * m.elempack);
+        if (m.dims == 3) fprintf(fp, "\"[%d,%d,%d]", m.w, m.h, m.c * m.elempack);
+        if (m.dims == 4) fprintf(fp, "\"[%d,%d,%d,%d]", m.w, m.h, m.d, m.c * m.elempack);
+        fprintf(fp, " pack%d %dbit\"", m.elempack, m.elembits());
+    }
+    fprintf(fp, "]");
+}
+
+int Profiler::write_chrome_trace(const char* path) const
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    std::vector<ProfilerRecord> rs = records();
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < rs.size(); i++)
+    {
+        const ProfilerRecord& r = rs[i];
+
+        fprintf(fp, "{\"name\":");
+#if NCNN_STRING
+        if (r.type == 0)
+            write_json_string(fp, r.layer_name.c_str());
+        else
+            write_json_string(fp, ("convert " + r.layer_name).c_str());
+#else
+        fprintf(fp, "\"%s %d\"", r.type == 0 ? "layer" : "convert", r.layer_index);
+#endif // NCNN_STRING
+        fprintf(fp, ",\"cat\":");
+        write_json_string(fp, record_type_name(r));
+        fprintf(fp, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d", r.start * 1000, (r.end - r.start) * 1000, r.thread_id);
+
+        fprintf(fp, ",\"args\":{\"layer_index\":%d,\"num_threads\":%d,\"blob_bytes\":%lu,\"workspace_bytes\":%lu", r.layer_index, r.num_threads, (unsigned long)r.blob_bytes, (unsigned long)r.workspace_bytes);
+        fprintf(fp, ",\"bottoms\":");
+        write_json_shapes(fp, r.bottom_shapes);
+        fprintf(fp, ",\"tops\":");
+        write_json_shapes(fp, r.top_shapes);
+        fprintf(fp, "}}%s\n", i + 1 == rs.size() ? "" : ",");
+    }
+    fprintf(fp, "],\"displayTimeUnit\":\"ms\"}\n");
+
+    fclose(fp);
+
+    return 0;
+}
+#endif // NCNN_STDIO
+
+} // namespace ncnn
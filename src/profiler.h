@@ -0,0 +1,86 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_PROFILER_H
+#define NCNN_PROFILER_H
+
+#include "mat.h"
+#include "platform.h"
+
+namespace ncnn {
+
+class NCNN_EXPORT ProfilerRecord
+{
+public:
+    ProfilerRecord();
+
+public:
+    // 0=layer forward 1=layout conversion before layer forward
+    int type;
+
+    int layer_index;
+#if NCNN_STRING
+    std::string layer_type;
+    std::string layer_name;
+#endif // NCNN_STRING
+
+    // milliseconds since profiler created or cleared
+    double start;
+    double end;
+
+    // sequential index of the thread that ran the layer
+    int thread_id;
+    int num_threads;
+
+    // blob shape, elempack and elemsize without data
+    std::vector<Mat> bottom_shapes;
+    std::vector<Mat> top_shapes;
+
+    // bytes allocated from the blob and workspace allocators on the running thread
+    size_t blob_bytes;
+    size_t workspace_bytes;
+};
+
+class ProfilerPrivate;
+class NCNN_EXPORT Profiler
+{
+public:
+    // empty profiler
+    Profiler();
+    // clear
+    ~Profiler();
+
+    // drop all records and restart the clock
+    void clear();
+
+    // records in the order of completion
+    std::vector<ProfilerRecord> records() const;
+
+    // add one record, thread-safe
+    // start and end are absolute get_current_time() values
+    void record(const ProfilerRecord& r);
+
+    // count of bottom blobs cast or repacked before layer forward
+    int layout_conversion_count() const;
+
+    // print the records summed up by layer type, slowest first
+    void print_summary() const;
+
+#if NCNN_STDIO
+    // write chrome trace event json
+    // open it in chrome://tracing or https://ui.perfetto.dev
+    // return 0 if success
+    int write_chrome_trace(const char* path) const;
+#endif // NCNN_STDIO
+
+private:
+    Profiler(const Profiler&);
+    Profiler& operator=(const Profiler&);
+
+private:
+    ProfilerPrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_PROFILER_H
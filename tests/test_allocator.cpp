@@ -0,0 +1,177 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "allocator.h"
+#include "mat.h"
+#include "platform.h"
+#include "testutil.h"
+
+#include <string.h>
+
+static int check_block(const unsigned char* p, size_t size, unsigned char value)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        if (p[i] != value)
+            return -1;
+    }
+    return 0;
+}
+
+static int test_allocator_reuse(ncnn::Allocator* allocator)
+{
+    const size_t sizes[] = {1, 63, 64, 65, 100, 1000, 4096, 12345, 100000, 1 << 20};
+    const int size_count = sizeof(sizes) / sizeof(sizes[0]);
+
+    for (int loop = 0; loop < 3; loop++)
+    {
+        void* ptrs[size_count];
+        for (int i = 0; i < size_count; i++)
+        {
+            ptrs[i] = allocator->fastMalloc(sizes[i]);
+            if (!ptrs[i] || (size_t)ptrs[i] % NCNN_MALLOC_ALIGN != 0)
+            {
+                fprintf(stderr, "test_allocator_reuse malloc %d failed %p\n", (int)sizes[i], ptrs[i]);
+                return -1;
+            }
+
+            memset(ptrs[i], i + 1, sizes[i]);
+        }
+
+        // blocks must not overlap
+        for (int i = 0; i < size_count; i++)
+        {
+            if (check_block((const unsigned char*)ptrs[i], sizes[i], (unsigned char)(i + 1)) != 0)
+            {
+                fprintf(stderr, "test_allocator_reuse block %d corrupted\n", i);
+                return -1;
+            }
+        }
+
+        for (int i = 0; i < size_count; i++)
+        {
+            allocator->fastFree(ptrs[i]);
+        }
+    }
+
+    // mat through allocator
+    ncnn::Mat m(17, 19, 23, (size_t)4u, allocator);
+    m.fill(1.f);
+    ncnn::Mat m2 = m.clone(allocator);
+    if (CompareMat(m, m2, 0.001) != 0)
+    {
+        fprintf(stderr, "test_allocator_reuse mat clone failed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+struct stress_args
+{
+    ncnn::Allocator* allocator;
+    int seed;
+    int ret;
+};
+
+static void* stress_worker(void* _args)
+{
+    stress_args* args = (stress_args*)_args;
+    ncnn::Allocator* allocator = args->allocator;
+
+    const int slot_count = 16;
+    void* ptrs[slot_count];
+    size_t sizes[slot_count];
+    memset(ptrs, 0, sizeof(ptrs));
+
+    unsigned int rng = args->seed;
+    for (int i = 0; i < 20000; i++)
+    {
+        rng = rng * 1103515245 + 12345;
+        const int slot = (rng >> 16) % slot_count;
+
+        if (ptrs[slot])
+        {
+            if (check_block((const unsigned char*)ptrs[slot], sizes[slot], (unsigned char)(slot + args->seed)) != 0)
+            {
+                args->ret = -1;
+                break;
+            }
+
+            allocator->fastFree(ptrs[slot]);
+            ptrs[slot] = 0;
+        }
+        else
+        {
+            rng = rng * 1103515245 + 12345;
+            sizes[slot] = 16 + (rng >> 8) % 70000;
+            ptrs[slot] = allocator->fastMalloc(sizes[slot]);
+            memset(ptrs[slot], slot + args->seed, sizes[slot]);
+        }
+    }
+
+    for (int i = 0; i < slot_count; i++)
+    {
+        if (ptrs[i])
+            allocator->fastFree(ptrs[i]);
+    }
+
+    return 0;
+}
+
+static int test_allocator_stress(ncnn::Allocator* allocator)
+{
+    const int thread_count = 4;
+
+    stress_args args[thread_count];
+    ncnn::Thread* threads[thread_count];
+    for (int i = 0; i < thread_count; i++)
+    {
+        args[i].allocator = allocator;
+        args[i].seed = i * 7 + 1;
+        args[i].ret = 0;
+        threads[i] = new ncnn::Thread(stress_worker, (void*)&args[i]);
+    }
+
+    int ret = 0;
+    for (int i = 0; i < thread_count; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+
+        if (args[i].ret != 0)
+        {
+            fprintf(stderr, "test_allocator_stress thread %d failed\n", i);
+            ret = -1;
+        }
+    }
+
+    return ret;
+}
+
+static int test_pool_allocator()
+{
+    ncnn::PoolAllocator allocator;
+    return test_allocator_reuse(&allocator) || test_allocator_stress(&allocator);
+}
+
+static int test_lockfree_pool_allocator()
+{
+    ncnn::LockFreePoolAllocator allocator;
+    int ret = test_allocator_reuse(&allocator) || test_allocator_stress(&allocator);
+    if (ret != 0)
+        return ret;
+
+    allocator.clear();
+
+    // no budget kept
+    allocator.set_size_drop_threshold(0);
+    return test_allocator_reuse(&allocator) || test_allocator_stress(&allocator);
+}
+
+int main()
+{
+    return 0
+           || test_pool_allocator()
+           || test_lockfree_pool_allocator();
+}
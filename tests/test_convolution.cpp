@@ -77,6 +77,34 @@ static int test_convolution(int w, int h, int c, int outch, int kernel, int dila
         }
     }
 
+    {
+        // weights as stored in fp16 models, kept as fp16 with fp16 storage
+        std::vector<ncnn::Mat> weights_fp16 = weights;
+        weights_fp16[0] = weights[0].clone();
+        for (int i = 0; i < weights_fp16[0].w; i++)
+        {
+            weights_fp16[0][i] = ncnn::float16_to_float32(ncnn::float32_to_float16(weights_fp16[0][i]));
+        }
+
+        for (int sgemm = 0; sgemm < 2; sgemm++)
+        {
+            ncnn::Option opt;
+            opt.num_threads = 1;
+            opt.use_packing_layout = true;
+            opt.use_fp16_storage = true;
+            opt.use_bf16_storage = false;
+            opt.use_sgemm_convolution = sgemm;
+            opt.use_winograd_convolution = false;
+
+            ret = test_layer_opt("Convolution", pd, weights_fp16, opt, a, epsilon);
+            if (ret != 0)
+            {
+                fprintf(stderr, "test_convolution fp16 weights failed w=%d h=%d c=%d outch=%d kernel=%d dilation=%d stride=%d pad=%d bias=%d act=%d actparams=[%f,%f] sgemm=%d\n", w, h, c, outch, kernel, dilation, stride, pad, bias, activation_type, activation_params[0], activation_params[1], sgemm);
+                return ret;
+            }
+        }
+    }
+
 #if __aarch64__
     {
         ncnn::Option opt;
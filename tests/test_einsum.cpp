@@ -3,6 +3,8 @@
 
 #include "testutil.h"
 
+#include "layer/einsum.h"
+
 static int test_einsum(const std::vector<ncnn::Mat>& a, const std::string& equation)
 {
     ncnn::Mat equation_mat(equation.size());
@@ -20,9 +22,40 @@ static int test_einsum(const std::vector<ncnn::Mat>& a, const std::string& equat
     if (ret != 0)
     {
         fprintf(stderr, "test_einsum failed a[0].dims=%d a[0]=(%d %d %d) equation=%s\n", a[0].dims, a[0].w, a[0].h, a[0].c, equation.c_str());
+        return ret;
+    }
+
+    // the gemm and reduction lowering against the generic path
+    ncnn::Einsum* op = (ncnn::Einsum*)ncnn::create_layer_naive("Einsum");
+    op->load_param(pd);
+
+    const int lowering_type = op->lowering_type;
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+
+    std::vector<ncnn::Mat> b(1);
+    std::vector<ncnn::Mat> c(1);
+    op->lowering_type = 0;
+    op->create_pipeline(opt);
+    ret = op->forward(a, b, opt);
+    op->destroy_pipeline(opt);
+
+    op->lowering_type = lowering_type;
+    op->create_pipeline(opt);
+    if (ret == 0)
+        ret = op->forward(a, c, opt);
+    op->destroy_pipeline(opt);
+
+    delete op;
+
+    if (ret != 0 || CompareMat(b[0], c[0], 0.001) != 0)
+    {
+        fprintf(stderr, "test_einsum lowering failed a[0].dims=%d a[0]=(%d %d %d) equation=%s\n", a[0].dims, a[0].w, a[0].h, a[0].c, equation.c_str());
+        return -1;
     }
 
-    return ret;
+    return 0;
 }
 
 static int test_einsum_0()
@@ -149,6 +182,24 @@ static int test_einsum_11()
     return test_einsum(a, "imnj,kmln->ijkl");
 }
 
+static int test_einsum_12()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(16, 13, 4);
+    a[1] = RandomMat(16, 9, 4);
+
+    return test_einsum(a, "ijm,ikm->ijk");
+}
+
+static int test_einsum_13()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(13, 16, 4);
+    a[1] = RandomMat(9, 16);
+
+    return test_einsum(a, "imj,mk->ijk");
+}
+
 int main()
 {
     SRAND(7767517);
@@ -165,5 +216,7 @@ int main()
            || test_einsum_8()
            || test_einsum_9()
            || test_einsum_10()
-           || test_einsum_11();
+           || test_einsum_11()
+           || test_einsum_12()
+           || test_einsum_13();
 }
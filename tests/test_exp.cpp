@@ -0,0 +1,74 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_exp(const ncnn::Mat& a, float base, float scale, float shift)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, base);
+    pd.set(1, scale);
+    pd.set(2, shift);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int ret = test_layer("Exp", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_exp failed a.dims=%d a=(%d %d %d %d) base=%f scale=%f shift=%f\n", a.dims, a.w, a.h, a.d, a.c, base, scale, shift);
+    }
+
+    return ret;
+}
+
+static int test_exp(const ncnn::Mat& a)
+{
+    return 0
+           || test_exp(a, -1.f, 1.f, 0.f)
+           || test_exp(a, -1.f, 0.5f, 0.2f)
+           || test_exp(a, 2.f, 1.f, 0.f)
+           || test_exp(a, 10.f, 0.7f, -0.3f);
+}
+
+static int test_exp_0()
+{
+    return 0
+           || test_exp(RandomMat(5, 6, 7, 24))
+           || test_exp(RandomMat(7, 8, 9, 12))
+           || test_exp(RandomMat(3, 4, 5, 13));
+}
+
+static int test_exp_1()
+{
+    return 0
+           || test_exp(RandomMat(10, 12, 24))
+           || test_exp(RandomMat(3, 6, 18))
+           || test_exp(RandomMat(12, 4, 7));
+}
+
+static int test_exp_2()
+{
+    return 0
+           || test_exp(RandomMat(12, 32))
+           || test_exp(RandomMat(20, 16))
+           || test_exp(RandomMat(19, 13));
+}
+
+static int test_exp_3()
+{
+    return 0
+           || test_exp(RandomMat(64))
+           || test_exp(RandomMat(156))
+           || test_exp(RandomMat(243));
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_exp_0()
+           || test_exp_1()
+           || test_exp_2()
+           || test_exp_3();
+}
@@ -121,10 +121,87 @@ static int test_expression_2()
     return 0;
 }
 
+static int test_list_expression(const ncnn::ListExpression& le, const std::string& expr, const std::vector<ncnn::Mat>& blobs)
+{
+    std::vector<int> true_list;
+    int er = ncnn::eval_list_expression(expr, blobs, true_list);
+    if (er != 0)
+        return -1;
+
+    std::vector<int> list;
+    er = le.eval(blobs, list);
+    if (er != 0 || list.size() != true_list.size())
+    {
+        fprintf(stderr, "test_list_expression failed expr=%s\n", expr.c_str());
+        return -1;
+    }
+
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        if (list[i] != true_list[i])
+        {
+            fprintf(stderr, "test_list_expression failed expr=%s blob0=(%d %d %d) got %d expect %d at %d\n", expr.c_str(), blobs[0].w, blobs[0].h, blobs[0].c, list[i], true_list[i], (int)i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_expression_3()
+{
+    const std::string expr = "+(trunc(*(0w,0.5)),-(0c,10)),floor(/(1h,0.5)),+(0c,1c),round(2.0)";
+
+    ncnn::ListExpression le;
+    if (le.parse(expr) != 0)
+        return -1;
+
+    // alternate between a few shapes, then more shapes than the cache holds
+    static const int shapes[][3] = {
+        {100, 200, 44}, {64, 48, 12}, {320, 240, 3}, {100, 200, 44}, {64, 48, 12}, {320, 240, 3}, {7, 9, 11}, {13, 15, 17}, {19, 21, 23}, {100, 200, 44}, {64, 48, 12}, {7, 9, 11}
+    };
+
+    std::vector<ncnn::Mat> blobs(2);
+    blobs[1] = ncnn::Mat(10, 20, 2, 4);
+    for (int i = 0; i < (int)(sizeof(shapes) / sizeof(shapes[0])); i++)
+    {
+        blobs[0] = ncnn::Mat(shapes[i][0], shapes[i][1], shapes[i][2]);
+        if (test_list_expression(le, expr, blobs) != 0)
+            return -1;
+    }
+
+    // same w h c with different dims, then more distinct shapes than ever cached
+    blobs[0] = ncnn::Mat(30, 40);
+    if (test_list_expression(le, expr, blobs) != 0)
+        return -1;
+    blobs[0] = ncnn::Mat(30, 40, 1);
+    if (test_list_expression(le, expr, blobs) != 0)
+        return -1;
+    for (int i = 0; i < 80; i++)
+    {
+        blobs[0] = ncnn::Mat(i + 1, 2, 3);
+        if (test_list_expression(le, expr, blobs) != 0)
+            return -1;
+    }
+
+    // constant list and empty list
+    ncnn::ListExpression le2;
+    if (le2.parse("3,-1,2") != 0 || test_list_expression(le2, "3,-1,2", blobs) != 0)
+        return -1;
+
+    ncnn::ListExpression le3;
+    std::vector<int> list;
+    if (le3.parse("") != 0 || le3.eval(blobs, list) != 0 || !list.empty())
+        return -1;
+
+    return 0;
+}
+
 int main()
 {
     return 0
            || test_expression_0()
            || test_expression_1()
-           || test_expression_2();
+           || test_expression_2()
+           || test_expression_3();
 }
@@ -125,6 +125,113 @@ static int test_gemm_bias(int M, int N, int K, const ncnn::Mat& C, float alpha,
     return ret;
 }
 
+static int test_gemm_weight_quant(int M, int N, int K, const ncnn::Mat& C, float alpha, float beta, int output_transpose, int bits, int group_size)
+{
+    const int num_group = K / group_size;
+
+    ncnn::ParamDict pd;
+    pd.set(0, alpha);
+    pd.set(1, beta);
+    pd.set(2, 0); // transA
+    pd.set(3, 1); // transB
+    pd.set(4, 0); // constantA
+    pd.set(5, 1); // constantB
+    pd.set(6, 1); // constantC
+    pd.set(7, M);
+    pd.set(8, N);
+    pd.set(9, K);
+    pd.set(10, C.empty() ? -1 : C.w == 1 ? 0 : 4);
+    pd.set(14, output_transpose);
+    pd.set(23, bits);       // weight_quant_bits
+    pd.set(24, group_size); // weight_quant_group_size
+
+    const int qmax = bits == 4 ? 7 : 127;
+
+    ncnn::Mat B(K, N, (size_t)1u);
+    {
+        signed char* p = B;
+        for (int i = 0; i < K * N; i++)
+        {
+            p[i] = (signed char)RandomInt(-qmax - 1, qmax);
+        }
+    }
+
+    ncnn::Mat B_scales = RandomMat(num_group, N, 0.001f, 2.f / qmax);
+    ncnn::Mat B_zeros(num_group, N);
+    for (int i = 0; i < num_group * N; i++)
+    {
+        B_zeros[i] = (float)RandomInt(-qmax - 1, qmax);
+    }
+
+    std::vector<ncnn::Mat> weights;
+    weights.push_back(B);
+    weights.push_back(B_scales);
+    weights.push_back(B_zeros);
+    if (!C.empty())
+        weights.push_back(C);
+
+    std::vector<ncnn::Mat> a(1);
+    a[0] = RandomMat(K, M);
+
+    int flag = TEST_LAYER_DISABLE_GPU_TESTING;
+    int ret = test_layer("Gemm", pd, weights, a, 1, 0.001f, 0, flag);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_gemm_weight_quant failed M=%d N=%d K=%d C.w=%d alpha=%f beta=%f output_transpose=%d bits=%d group_size=%d\n", M, N, K, C.w, alpha, beta, output_transpose, bits, group_size);
+    }
+
+    return ret;
+}
+
+static int test_gemm_fp16_weights(int M, int N, int K, int transA, int transB, int constantA, int constantB)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, 1.f); // alpha
+    pd.set(1, 1.f); // beta
+    pd.set(2, transA);
+    pd.set(3, transB);
+    pd.set(4, constantA);
+    pd.set(5, constantB);
+    pd.set(6, 1);
+    pd.set(7, M);
+    pd.set(8, N);
+    pd.set(9, K);
+    pd.set(10, -1);
+
+    std::vector<ncnn::Mat> weights;
+    if (constantA) weights.push_back(transA ? ncnn::Mat(M, K) : ncnn::Mat(K, M));
+    if (constantB) weights.push_back(transB ? ncnn::Mat(K, N) : ncnn::Mat(N, K));
+
+    std::vector<ncnn::Mat> a;
+    if (!constantA) a.push_back(transA ? ncnn::Mat(M, K) : ncnn::Mat(K, M));
+    if (!constantB) a.push_back(transB ? ncnn::Mat(K, N) : ncnn::Mat(N, K));
+
+    // constants as stored in fp16 models, kept as fp16 with fp16 storage
+    for (size_t i = 0; i < weights.size(); i++)
+    {
+        Randomize(weights[i]);
+
+        float* p = weights[i];
+        for (int j = 0; j < (int)weights[i].total(); j++)
+        {
+            p[j] = ncnn::float16_to_float32(ncnn::float32_to_float16(p[j]));
+        }
+    }
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        Randomize(a[i]);
+    }
+
+    int ret = test_layer("Gemm", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_gemm_fp16_weights failed M=%d N=%d K=%d transA=%d transB=%d constantA=%d constantB=%d\n", M, N, K, transA, transB, constantA, constantB);
+    }
+
+    return ret;
+}
+
 static int test_gemm_0(int M, int N, int K)
 {
     return 0
@@ -234,6 +341,29 @@ static int test_gemm_1(int M, int N, int K)
            || test_gemm_bias(M, N, K, RandomMat(N), 3.1f, 0.6f, 0, 1, 0, 1, 1, 1);
 }
 
+static int test_gemm_3(int M, int N, int K)
+{
+    return 0
+           || test_gemm_fp16_weights(M, N, K, 0, 0, 1, 0)
+           || test_gemm_fp16_weights(M, N, K, 1, 1, 1, 0)
+           || test_gemm_fp16_weights(M, N, K, 0, 1, 0, 1)
+           || test_gemm_fp16_weights(M, N, K, 1, 0, 0, 1)
+           || test_gemm_fp16_weights(M, N, K, 0, 1, 1, 1)
+           || test_gemm_fp16_weights(M, N, K, 1, 0, 1, 1);
+}
+
+static int test_gemm_2()
+{
+    return 0
+           || test_gemm_weight_quant(1, 1, 32, ncnn::Mat(), 1.f, 1.f, 0, 4, 32)
+           || test_gemm_weight_quant(1, 35, 64, RandomMat(35), 1.f, 1.f, 0, 4, 16)
+           || test_gemm_weight_quant(5, 16, 128, RandomMat(1), 2.1f, 0.5f, 0, 8, 64)
+           || test_gemm_weight_quant(12, 24, 96, RandomMat(24), 0.7f, 1.3f, 0, 4, 32)
+           || test_gemm_weight_quant(16, 9, 64, RandomMat(9), 1.f, 1.f, 0, 8, 16)
+           || test_gemm_weight_quant(7, 12, 64, RandomMat(12), 1.5f, 0.6f, 1, 4, 32)
+           || test_gemm_weight_quant(8, 5, 32, ncnn::Mat(), 1.f, 1.f, 1, 8, 32);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -286,11 +416,12 @@ int main()
 
         int ret = 0
                   || test_gemm_0(M, N, K)
-                  || test_gemm_1(M, N, K);
+                  || test_gemm_1(M, N, K)
+                  || test_gemm_3(M, N, K);
 
         if (ret != 0)
             return ret;
     }
 
-    return 0;
+    return test_gemm_2();
 }
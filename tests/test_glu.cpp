@@ -13,7 +13,7 @@ static int test_glu(const ncnn::Mat& a, int axis)
     int ret = test_layer("GLU", pd, weights, a);
     if (ret != 0)
     {
-        fprintf(stderr, "test_glu failed a.dims=%d a=(%d %d %d) axis=%d\n", a.dims, a.w, a.h, a.c, axis);
+        fprintf(stderr, "test_glu failed a.dims=%d a=(%d %d %d %d) axis=%d\n", a.dims, a.w, a.h, a.d, a.c, axis);
     }
 
     return ret;
@@ -48,6 +48,17 @@ static int test_glu_2()
            || test_glu(RandomMat(128), 0);
 }
 
+static int test_glu_3()
+{
+    return 0
+           || test_glu(RandomMat(6, 7, 4, 24), 0)
+           || test_glu(RandomMat(6, 8, 4, 16), 1)
+           || test_glu(RandomMat(6, 8, 5, 16), 2)
+           || test_glu(RandomMat(6, 7, 5, 16), 3)
+           || test_glu(RandomMat(5, 7, 8, 12), -3)
+           || test_glu(RandomMat(6, 7, 5, 40), -4);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -55,5 +66,6 @@ int main()
     return 0
            || test_glu_0()
            || test_glu_1()
-           || test_glu_2();
+           || test_glu_2()
+           || test_glu_3();
 }
@@ -0,0 +1,203 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "datareader.h"
+#include "inferencepool.h"
+#include "testutil.h"
+
+#include <string.h>
+
+// fill every weight with random value
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    virtual size_t read(void* buf, size_t size) const
+    {
+        if (size == 4)
+        {
+            // weight storage flag and tiny weight
+            memset(buf, 0, size);
+            return size;
+        }
+
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / sizeof(float); i++)
+        {
+            p[i] = RandomFloat(-0.5f, 0.5f);
+        }
+        return size;
+    }
+};
+
+static const char* pool_param = "7767517\n"
+                                "5 5\n"
+                                "Input data 0 1 data 0=16 1=16 2=8\n"
+                                "Convolution conv0 1 1 data c0 0=16 1=3 4=1 5=1 6=1152\n"
+                                "ReLU relu0 1 1 c0 r0\n"
+                                "Convolution conv1 1 1 r0 c1 0=8 1=3 3=2 4=1 5=1 6=1152\n"
+                                "Pooling gap 1 1 c1 out 0=1 4=1\n";
+
+static int load_pool_net(ncnn::Net& net, int num_threads)
+{
+    net.opt.num_threads = num_threads;
+
+    int ret = net.load_param_mem(pool_param);
+    if (ret != 0)
+        return ret;
+
+    SRAND(7767517);
+    DataReaderFromRandom dr;
+    return net.load_model(dr);
+}
+
+struct submit_args
+{
+    ncnn::InferencePool* pool;
+    std::vector<ncnn::InferenceRequest*> requests;
+    int ret;
+};
+
+static void* submit_worker(void* _args)
+{
+    submit_args* args = (submit_args*)_args;
+
+    args->ret = 0;
+    for (size_t i = 0; i < args->requests.size(); i++)
+    {
+        // spin while the queue is full
+        while (args->pool->submit(args->requests[i]) != 0)
+        {
+        }
+    }
+
+    for (size_t i = 0; i < args->requests.size(); i++)
+    {
+        if (args->requests[i]->wait() != 0)
+            args->ret = -1;
+    }
+
+    return 0;
+}
+
+static int test_inferencepool(int thread_count, int mode, int submitter_count)
+{
+    ncnn::InferencePool pool;
+
+    int ret = load_pool_net(pool.net(), mode == 0 ? 1 : thread_count);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_pool_net failed\n");
+        return -1;
+    }
+
+    const int request_count = 6 * submitter_count;
+
+    // expected outputs from a plain extractor
+    std::vector<ncnn::Mat> inputs(request_count);
+    std::vector<ncnn::Mat> expects(request_count);
+    for (int i = 0; i < request_count; i++)
+    {
+        inputs[i] = RandomMat(16, 16, 8);
+
+        ncnn::Extractor ex = pool.net().create_extractor();
+        ex.input("data", inputs[i]);
+        ex.extract("out", expects[i]);
+    }
+
+    // latency thread count not matching the net option
+    if (mode == 1 && pool.start(thread_count + 1, mode) == 0)
+    {
+        fprintf(stderr, "start should fail on num_threads mismatch\n");
+        return -1;
+    }
+
+    // tiny queue to exercise the full path
+    ret = pool.start(thread_count, mode, 4);
+    if (ret != 0)
+    {
+        fprintf(stderr, "start failed thread_count=%d mode=%d\n", thread_count, mode);
+        return -1;
+    }
+
+    ncnn::InferenceRequest* requests = new ncnn::InferenceRequest[request_count];
+    for (int i = 0; i < request_count; i++)
+    {
+        requests[i].input(pool.net(), "data", inputs[i]);
+        requests[i].output(pool.net(), "out");
+    }
+
+    std::vector<submit_args> args(submitter_count);
+    std::vector<ncnn::Thread*> threads(submitter_count);
+    for (int i = 0; i < submitter_count; i++)
+    {
+        args[i].pool = &pool;
+        for (int j = i; j < request_count; j += submitter_count)
+        {
+            args[i].requests.push_back(&requests[j]);
+        }
+        threads[i] = new ncnn::Thread(submit_worker, (void*)&args[i]);
+    }
+
+    for (int i = 0; i < submitter_count; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    for (int i = 0; i < submitter_count; i++)
+    {
+        if (args[i].ret != 0)
+        {
+            fprintf(stderr, "request failed thread_count=%d mode=%d\n", thread_count, mode);
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < request_count; i++)
+    {
+        if (!requests[i].finished() || requests[i].outputs.size() != 1 || CompareMat(requests[i].outputs[0], expects[i], 0.001) != 0)
+        {
+            fprintf(stderr, "output mismatch request %d thread_count=%d mode=%d\n", i, thread_count, mode);
+            return -1;
+        }
+    }
+
+    // blocking run after concurrent traffic
+    {
+        ncnn::InferenceRequest request;
+        request.input(pool.net(), "data", inputs[0]);
+        request.output(pool.net(), "out");
+
+        if (pool.run(request) != 0 || CompareMat(request.outputs[0], expects[0], 0.001) != 0)
+        {
+            fprintf(stderr, "run failed thread_count=%d mode=%d\n", thread_count, mode);
+            return -1;
+        }
+    }
+
+    pool.stop();
+
+    delete[] requests;
+
+    // submit after stop must fail
+    {
+        ncnn::InferenceRequest request;
+        if (pool.submit(&request) == 0)
+        {
+            fprintf(stderr, "submit after stop should fail\n");
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    return 0
+           || test_inferencepool(1, 0, 1)
+           || test_inferencepool(2, 0, 3)
+           || test_inferencepool(4, 0, 2)
+           || test_inferencepool(2, 1, 2)
+           || test_inferencepool(4, 1, 3);
+}
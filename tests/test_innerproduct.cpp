@@ -246,6 +246,77 @@ static int test_innerproduct_5()
 }
 #endif // NCNN_INT8
 
+static int test_innerproduct_weight_quant(const ncnn::Mat& a, int outch, int bias, int bits, int group_size)
+{
+    // gemm when a is 2d, flatten otherwise
+    const int k = a.dims == 2 ? a.w : a.w * a.h * a.c;
+    const int num_group = k / group_size;
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch); // num_output
+    pd.set(1, bias);  // bias_term
+    pd.set(2, outch * k);
+    pd.set(11, bits);       // weight_quant_bits
+    pd.set(12, group_size); // weight_quant_group_size
+
+    int activation_type = RAND() % 7; // 0 1 2 3 4 5 6
+    ncnn::Mat activation_params(2);
+    activation_params[0] = (activation_type == 6) ? RandomFloat(0, 1) : RandomFloat(-1, 0); // alpha
+    activation_params[1] = RandomFloat(0, 1);                                               // beta
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    const int qmax = bits == 4 ? 7 : 127;
+
+    ncnn::Mat weight_data(outch * k, (size_t)1u);
+    {
+        signed char* p = weight_data;
+        for (int i = 0; i < outch * k; i++)
+        {
+            p[i] = (signed char)RandomInt(-qmax - 1, qmax);
+        }
+    }
+
+    ncnn::Mat weight_quant_scales = RandomMat(num_group * outch, 0.001f, 2.f / qmax);
+    ncnn::Mat weight_quant_zeros(num_group * outch);
+    for (int i = 0; i < num_group * outch; i++)
+    {
+        weight_quant_zeros[i] = (float)RandomInt(-qmax - 1, qmax);
+    }
+
+    std::vector<ncnn::Mat> weights;
+    weights.push_back(weight_data);
+    if (bias)
+        weights.push_back(RandomMat(outch));
+    weights.push_back(weight_quant_scales);
+    weights.push_back(weight_quant_zeros);
+
+    int flag = TEST_LAYER_DISABLE_GPU_TESTING;
+    int ret = test_layer("InnerProduct", pd, weights, a, 0.001f, 0, flag);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_innerproduct_weight_quant failed a.dims=%d a=(%d %d %d) outch=%d bias=%d bits=%d group_size=%d act=%d actparams=[%f,%f]\n", a.dims, a.w, a.h, a.c, outch, bias, bits, group_size, activation_type, activation_params[0], activation_params[1]);
+    }
+
+    return ret;
+}
+
+static int test_innerproduct_6()
+{
+    return 0
+           || test_innerproduct_weight_quant(RandomMat(32), 1, 1, 4, 32)
+           || test_innerproduct_weight_quant(RandomMat(64), 7, 0, 4, 16)
+           || test_innerproduct_weight_quant(RandomMat(128), 16, 1, 8, 64)
+           || test_innerproduct_weight_quant(RandomMat(4, 4, 8), 12, 1, 4, 32)
+           || test_innerproduct_weight_quant(RandomMat(2, 3, 16), 8, 0, 8, 32)
+           || test_innerproduct_weight_quant(RandomMat(3, 4, 16), 5, 1, 4, 64)
+           || test_innerproduct_weight_quant(RandomMat(32, 1), 3, 1, 8, 32)
+           || test_innerproduct_weight_quant(RandomMat(64, 5), 16, 1, 4, 32)
+           || test_innerproduct_weight_quant(RandomMat(48, 8), 7, 0, 8, 16)
+           || test_innerproduct_weight_quant(RandomMat(256, 13), 24, 1, 4, 128)
+           || test_innerproduct_weight_quant(RandomMat(128, 16), 9, 1, 8, 128);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -257,12 +328,14 @@ int main()
            || test_innerproduct_2()
            || test_innerproduct_3()
            || test_innerproduct_4()
-           || test_innerproduct_5();
+           || test_innerproduct_5()
+           || test_innerproduct_6();
 #else
     return 0
            || test_innerproduct_0()
            || test_innerproduct_1()
            || test_innerproduct_2()
-           || test_innerproduct_4();
+           || test_innerproduct_4()
+           || test_innerproduct_6();
 #endif
 }
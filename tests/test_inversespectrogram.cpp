@@ -37,9 +37,46 @@ static int test_inversespectrogram_0()
            || test_inversespectrogram(124, 28, 55, 2, 12, 55, 1, 1, 2);
 }
 
+static int test_inversespectrogram_stream(int frames, int freqs, int n_fft, int returns, int hoplen, int winlen, int window_type, int normalized)
+{
+    std::vector<ncnn::Mat> as(2);
+    as[0] = RandomMat(2, frames, freqs);
+    as[1] = RandomMat(3, n_fft - hoplen, 0.5f, 1.f);
+
+    ncnn::ParamDict pd;
+    pd.set(0, n_fft);
+    pd.set(1, returns);
+    pd.set(2, hoplen);
+    pd.set(3, winlen);
+    pd.set(4, window_type);
+    pd.set(5, 0);
+    pd.set(7, normalized);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int ret = test_layer("InverseSpectrogram", pd, weights, as, 2);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_inversespectrogram_stream failed frames=%d freqs=%d n_fft=%d returns=%d hoplen=%d winlen=%d window_type=%d normalized=%d\n", frames, freqs, n_fft, returns, hoplen, winlen, window_type, normalized);
+    }
+
+    return ret;
+}
+
+static int test_inversespectrogram_1()
+{
+    return 0
+           || test_inversespectrogram_stream(5, 9, 16, 0, 4, 16, 1, 0)
+           || test_inversespectrogram_stream(7, 17, 17, 1, 7, 15, 2, 1)
+           || test_inversespectrogram_stream(3, 201, 400, 2, 160, 400, 1, 2)
+           || test_inversespectrogram_stream(4, 28, 55, 0, 12, 55, 0, 0);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_inversespectrogram_0();
+    return 0
+           || test_inversespectrogram_0()
+           || test_inversespectrogram_1();
 }
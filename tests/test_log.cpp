@@ -0,0 +1,74 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_log(const ncnn::Mat& a, float base, float scale, float shift)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, base);
+    pd.set(1, scale);
+    pd.set(2, shift);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int ret = test_layer("Log", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_log failed a.dims=%d a=(%d %d %d %d) base=%f scale=%f shift=%f\n", a.dims, a.w, a.h, a.d, a.c, base, scale, shift);
+    }
+
+    return ret;
+}
+
+static int test_log(const ncnn::Mat& a)
+{
+    return 0
+           || test_log(a, -1.f, 1.f, 0.f)
+           || test_log(a, -1.f, 0.5f, 0.2f)
+           || test_log(a, 2.f, 1.f, 0.f)
+           || test_log(a, 10.f, 0.7f, 0.3f);
+}
+
+static int test_log_0()
+{
+    return 0
+           || test_log(RandomMat(5, 6, 7, 24, 0.01f, 3.f))
+           || test_log(RandomMat(7, 8, 9, 12, 0.01f, 3.f))
+           || test_log(RandomMat(3, 4, 5, 13, 0.01f, 3.f));
+}
+
+static int test_log_1()
+{
+    return 0
+           || test_log(RandomMat(10, 12, 24, 0.01f, 3.f))
+           || test_log(RandomMat(3, 6, 18, 0.01f, 3.f))
+           || test_log(RandomMat(12, 4, 7, 0.01f, 3.f));
+}
+
+static int test_log_2()
+{
+    return 0
+           || test_log(RandomMat(12, 32, 0.01f, 3.f))
+           || test_log(RandomMat(20, 16, 0.01f, 3.f))
+           || test_log(RandomMat(19, 13, 0.01f, 3.f));
+}
+
+static int test_log_3()
+{
+    return 0
+           || test_log(RandomMat(64, 0.01f, 3.f))
+           || test_log(RandomMat(156, 0.01f, 3.f))
+           || test_log(RandomMat(243, 0.01f, 3.f));
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_log_0()
+           || test_log_1()
+           || test_log_2()
+           || test_log_3();
+}
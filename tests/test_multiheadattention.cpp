@@ -121,6 +121,180 @@ static int test_multiheadattention_sameqkv(const ncnn::Mat& a, int embed_dim, in
     return ret;
 }
 
+static int test_multiheadattention_kvcache(const ncnn::Mat& a, int past_seqlen, int embed_dim, int num_heads, int attn_mask)
+{
+    const int qdim = a.w;
+
+    ncnn::ParamDict pd;
+    pd.set(0, embed_dim);
+    pd.set(1, num_heads);
+    pd.set(2, embed_dim * qdim);
+    pd.set(3, qdim);
+    pd.set(4, qdim);
+    pd.set(5, attn_mask);
+    pd.set(7, 1);
+
+    std::vector<ncnn::Mat> weights(8);
+    weights[0] = RandomMat(embed_dim * qdim);
+    weights[1] = RandomMat(embed_dim);
+    weights[2] = RandomMat(embed_dim * qdim);
+    weights[3] = RandomMat(embed_dim);
+    weights[4] = RandomMat(embed_dim * qdim);
+    weights[5] = RandomMat(embed_dim);
+    weights[6] = RandomMat(qdim * embed_dim);
+    weights[7] = RandomMat(qdim);
+
+    std::vector<ncnn::Mat> as(1);
+    as[0] = a;
+
+    if (attn_mask)
+    {
+        as.push_back(RandomMat(past_seqlen + a.h, a.h));
+    }
+
+    // caches from a previous step are [embed_dim, past_seqlen, 1], 2d ones are accepted too
+    if (past_seqlen % 2 == 0)
+    {
+        as.push_back(RandomMat(embed_dim, past_seqlen));
+        as.push_back(RandomMat(embed_dim, past_seqlen));
+    }
+    else
+    {
+        as.push_back(RandomMat(embed_dim, past_seqlen, 1));
+        as.push_back(RandomMat(embed_dim, past_seqlen, 1));
+    }
+
+    float epsilon = 0.005;
+
+    int ret = test_layer("MultiHeadAttention", pd, weights, as, 3, epsilon);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_multiheadattention_kvcache failed a=(%d %d) past_seqlen=%d embed_dim=%d num_heads=%d attn_mask=%d\n", a.w, a.h, past_seqlen, embed_dim, num_heads, attn_mask);
+    }
+
+    return ret;
+}
+
+static int forward_kvcache_step(const ncnn::Layer* op, const ncnn::Mat& a, const ncnn::Mat& cache_k, const ncnn::Mat& cache_v, std::vector<ncnn::Mat>& tops, const ncnn::Option& opt)
+{
+    std::vector<ncnn::Mat> bottoms(3);
+    bottoms[0] = a;
+    bottoms[1] = cache_k;
+    bottoms[2] = cache_v;
+    tops.resize(3);
+    return op->forward(bottoms, tops, opt);
+}
+
+// decode token by token feeding the caches back, then fork from an earlier cache
+static int test_multiheadattention_kvcache_steps(int qdim, int embed_dim, int num_heads)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, embed_dim);
+    pd.set(1, num_heads);
+    pd.set(2, embed_dim * qdim);
+    pd.set(3, qdim);
+    pd.set(4, qdim);
+    pd.set(7, 1);
+
+    std::vector<ncnn::Mat> weights(8);
+    weights[0] = RandomMat(embed_dim * qdim);
+    weights[1] = RandomMat(embed_dim);
+    weights[2] = RandomMat(embed_dim * qdim);
+    weights[3] = RandomMat(embed_dim);
+    weights[4] = RandomMat(embed_dim * qdim);
+    weights[5] = RandomMat(embed_dim);
+    weights[6] = RandomMat(qdim * embed_dim);
+    weights[7] = RandomMat(qdim);
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+
+    ncnn::Layer* op_naive = ncnn::create_layer_naive("MultiHeadAttention");
+    ncnn::Layer* op = ncnn::create_layer_cpu("MultiHeadAttention");
+    op_naive->load_param(pd);
+    op->load_param(pd);
+    op_naive->load_model(ncnn::ModelBinFromMatArray(weights.data()));
+    op->load_model(ncnn::ModelBinFromMatArray(weights.data()));
+    op_naive->create_pipeline(opt);
+    op->create_pipeline(opt);
+
+    ncnn::Mat cache_k_naive;
+    ncnn::Mat cache_v_naive;
+    ncnn::Mat cache_k;
+    ncnn::Mat cache_v;
+    ncnn::Mat fork_cache_k_naive;
+    ncnn::Mat fork_cache_v_naive;
+    ncnn::Mat fork_cache_k;
+    ncnn::Mat fork_cache_v;
+
+    int ret = 0;
+    int in_place_steps = 0;
+    for (int i = 0; i < 24 && ret == 0; i++)
+    {
+        // a prompt and then single tokens
+        ncnn::Mat a = RandomMat(qdim, i == 0 ? 7 : 1);
+
+        std::vector<ncnn::Mat> tops_naive;
+        std::vector<ncnn::Mat> tops;
+        ret = forward_kvcache_step(op_naive, a, cache_k_naive, cache_v_naive, tops_naive, opt) || forward_kvcache_step(op, a, cache_k, cache_v, tops, opt);
+        if (ret == 0 && (CompareMat(tops_naive[0], tops[0], 0.005) != 0 || CompareMat(tops_naive[1], tops[1], 0.001) != 0 || CompareMat(tops_naive[2], tops[2], 0.001) != 0))
+        {
+            fprintf(stderr, "kv cache step %d mismatch\n", i);
+            ret = -1;
+        }
+
+        if (tops[1].data == cache_k.data && tops[2].data == cache_v.data)
+            in_place_steps++;
+
+        if (i == 10)
+        {
+            fork_cache_k_naive = cache_k_naive;
+            fork_cache_v_naive = cache_v_naive;
+            fork_cache_k = cache_k;
+            fork_cache_v = cache_v;
+        }
+
+        cache_k_naive = tops_naive[1];
+        cache_v_naive = tops_naive[2];
+        cache_k = tops[1];
+        cache_v = tops[2];
+    }
+
+    if (ret == 0 && in_place_steps == 0)
+    {
+        fprintf(stderr, "kv cache never appended in place\n");
+        ret = -1;
+    }
+
+    // continuing an earlier cache must neither see nor clobber the newer tokens
+    ncnn::Mat cache_k_before = cache_k.clone();
+    for (int i = 0; i < 2 && ret == 0; i++)
+    {
+        ncnn::Mat a = RandomMat(qdim, 1);
+
+        std::vector<ncnn::Mat> tops_naive;
+        std::vector<ncnn::Mat> tops;
+        ret = forward_kvcache_step(op_naive, a, fork_cache_k_naive, fork_cache_v_naive, tops_naive, opt) || forward_kvcache_step(op, a, fork_cache_k, fork_cache_v, tops, opt);
+        if (ret == 0 && (CompareMat(tops_naive[0], tops[0], 0.005) != 0 || CompareMat(tops_naive[1], tops[1], 0.001) != 0 || CompareMat(cache_k_before, cache_k, 0.001) != 0))
+        {
+            fprintf(stderr, "kv cache fork step %d mismatch\n", i);
+            ret = -1;
+        }
+    }
+
+    op_naive->destroy_pipeline(opt);
+    op->destroy_pipeline(opt);
+    delete op_naive;
+    delete op;
+
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_multiheadattention_kvcache_steps failed qdim=%d embed_dim=%d num_heads=%d\n", qdim, embed_dim, num_heads);
+    }
+
+    return ret;
+}
+
 static int test_multiheadattention_0()
 {
     return 0
@@ -152,6 +326,17 @@ static int test_multiheadattention_2()
            || test_multiheadattention_sameqkv(RandomMat(48, 127), 64, 8);
 }
 
+static int test_multiheadattention_3()
+{
+    return 0
+           || test_multiheadattention_kvcache(RandomMat(32, 1), 17, 32, 4, 0)
+           || test_multiheadattention_kvcache(RandomMat(32, 1), 64, 32, 2, 1)
+           || test_multiheadattention_kvcache(RandomMat(24, 5), 127, 32, 4, 1)
+           || test_multiheadattention_kvcache(RandomMat(64, 16), 48, 64, 8, 0)
+           || test_multiheadattention_kvcache_steps(32, 32, 4)
+           || test_multiheadattention_kvcache_steps(48, 64, 2);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -159,5 +344,6 @@ int main()
     return 0
            || test_multiheadattention_0()
            || test_multiheadattention_1()
-           || test_multiheadattention_2();
+           || test_multiheadattention_2()
+           || test_multiheadattention_3();
 }
@@ -0,0 +1,847 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "datareader.h"
+#include "net.h"
+#include "testutil.h"
+
+#include <string.h>
+
+// fill every weight with random value
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    virtual size_t read(void* buf, size_t size) const
+    {
+        if (size == 4)
+        {
+            // weight storage flag and tiny weight
+            memset(buf, 0, size);
+            return size;
+        }
+
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / sizeof(float); i++)
+        {
+            p[i] = RandomFloat(-0.5f, 0.5f);
+        }
+        return size;
+    }
+};
+
+// three independent branches joined by concat
+static const char* branchy_param = "7767517\n"
+                                   "10 12\n"
+                                   "Input data 0 1 data 0=24 1=24 2=16\n"
+                                   "Split split 1 3 data a b c\n"
+                                   "Convolution conv0 1 1 a a0 0=8 1=1 5=1 6=128\n"
+                                   "ReLU relu0 1 1 a0 a1\n"
+                                   "Convolution conv1 1 1 b b0 0=8 1=3 4=1 5=1 6=1152\n"
+                                   "ReLU relu1 1 1 b0 b1\n"
+                                   "Pooling pool 1 1 c c0 0=0 1=3 3=1\n"
+                                   "Convolution conv2 1 1 c0 c1 0=8 1=1 5=1 6=128 9=1\n"
+                                   "Concat concat 3 1 a1 b1 c1 cat\n"
+                                   "Convolution conv3 1 1 cat out 0=4 1=1 5=1 6=96\n";
+
+static int load_branchy_net(ncnn::Net& net, const ncnn::Option& opt)
+{
+    net.opt = opt;
+
+    int ret = net.load_param_mem(branchy_param);
+    if (ret != 0)
+        return ret;
+
+    SRAND(7767517);
+    DataReaderFromRandom dr;
+    return net.load_model(dr);
+}
+
+static int extract_branchy_net(const ncnn::Net& net, const ncnn::Mat& in, bool branch_parallel, ncnn::Mat& out0, ncnn::Mat& out1)
+{
+    ncnn::Extractor ex = net.create_extractor();
+    ex.set_branch_parallel(branch_parallel);
+
+    ex.input("data", in);
+
+    int ret = ex.extract("a1", out0);
+    if (ret != 0)
+        return ret;
+
+    return ex.extract("out", out1);
+}
+
+static int test_net_branch_parallel(bool lightmode, int num_threads)
+{
+    ncnn::Option opt;
+    opt.lightmode = lightmode;
+    opt.num_threads = num_threads;
+
+    ncnn::Net net;
+    int ret = load_branchy_net(net, opt);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_branchy_net failed\n");
+        return -1;
+    }
+
+    ncnn::Mat in = RandomMat(24, 24, 16);
+
+    ncnn::Mat a;
+    ncnn::Mat b;
+    ret = extract_branchy_net(net, in, false, a, b);
+    if (ret != 0)
+    {
+        fprintf(stderr, "sequential extract failed\n");
+        return -1;
+    }
+
+    // run twice to reuse the branch thread pool
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Mat c;
+        ncnn::Mat d;
+        ret = extract_branchy_net(net, in, true, c, d);
+        if (ret != 0)
+        {
+            fprintf(stderr, "branch parallel extract failed\n");
+            return -1;
+        }
+
+        if (CompareMat(a, c, 0.001) != 0 || CompareMat(b, d, 0.001) != 0)
+        {
+            fprintf(stderr, "test_net_branch_parallel failed lightmode=%d num_threads=%d\n", lightmode, num_threads);
+            return -1;
+        }
+    }
+
+    // the branch thread pool and pre-packed layers follow num_threads changed after load
+    const int new_num_threads[2] = {num_threads * 2, std::max(num_threads / 2, 1)};
+    for (int i = 0; i < 2; i++)
+    {
+        net.opt.num_threads = new_num_threads[i];
+
+        ncnn::Extractor ex = net.create_extractor();
+        ex.set_branch_parallel(true);
+
+        ex.input("data", in);
+
+        ncnn::Mat c;
+        ncnn::Mat d;
+        ret = ex.extract("a1", c);
+        if (ret == 0)
+            ret = ex.extract("out", d);
+        if (ret != 0)
+        {
+            fprintf(stderr, "branch parallel extract failed\n");
+            return -1;
+        }
+
+        if (CompareMat(a, c, 0.001) != 0 || CompareMat(b, d, 0.001) != 0)
+        {
+            fprintf(stderr, "test_net_branch_parallel failed lightmode=%d num_threads=%d -> %d\n", lightmode, num_threads, new_num_threads[i]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_net_memory_plan(bool lightmode, bool branch_parallel)
+{
+    ncnn::Option opt;
+    opt.lightmode = lightmode;
+    opt.num_threads = 2;
+
+    ncnn::Net net;
+    int ret = load_branchy_net(net, opt);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_branchy_net failed\n");
+        return -1;
+    }
+
+    ncnn::Mat in = RandomMat(24, 24, 16);
+
+    ncnn::Mat a;
+    ncnn::Mat b;
+    ret = extract_branchy_net(net, in, false, a, b);
+    if (ret != 0)
+    {
+        fprintf(stderr, "extract without memory plan failed\n");
+        return -1;
+    }
+
+    ret = net.plan_memory();
+    if (ret != 0 || net.planned_memory_bytes() == 0)
+    {
+        fprintf(stderr, "plan_memory failed\n");
+        return -1;
+    }
+
+    // arena is reused by the following extractors
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Mat c;
+        ncnn::Mat d;
+        ret = extract_branchy_net(net, in, branch_parallel, c, d);
+        if (ret != 0)
+        {
+            fprintf(stderr, "extract with memory plan failed\n");
+            return -1;
+        }
+
+        if (CompareMat(a, c, 0.001) != 0 || CompareMat(b, d, 0.001) != 0)
+        {
+            fprintf(stderr, "test_net_memory_plan failed lightmode=%d branch_parallel=%d\n", lightmode, branch_parallel);
+            return -1;
+        }
+    }
+
+    // the arena can not be replaced under a live extractor
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+
+        ncnn::Mat c;
+        ret = ex.extract("out", c);
+        if (ret != 0 || net.plan_memory() == 0)
+        {
+            fprintf(stderr, "plan_memory with live extractor should fail\n");
+            return -1;
+        }
+    }
+
+    if (net.plan_memory() != 0)
+    {
+        fprintf(stderr, "plan_memory again failed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int write_branchy_model(const char* path, int seed = 7767517)
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+        return -1;
+
+    // weight and bias sizes of conv0 conv1 conv2 conv3
+    const int sizes[8] = {128, 8, 1152, 8, 128, 8, 96, 4};
+
+    SRAND(seed);
+    for (int i = 0; i < 8; i++)
+    {
+        if (i % 2 == 0)
+        {
+            // raw fp32 weight flag
+            const unsigned int flag = 0;
+            fwrite(&flag, sizeof(flag), 1, fp);
+        }
+
+        ncnn::Mat m = RandomMat(sizes[i], -0.5f, 0.5f);
+        fwrite(m.data, sizeof(float), sizes[i], fp);
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+static int test_net_load_model_mmap(bool lightmode)
+{
+    const char* modelpath = "test_net_branchy.bin";
+    if (write_branchy_model(modelpath) != 0)
+    {
+        fprintf(stderr, "write_branchy_model failed\n");
+        return -1;
+    }
+
+    ncnn::Option opt;
+    opt.lightmode = lightmode;
+    opt.num_threads = 1;
+
+    ncnn::Mat in = RandomMat(24, 24, 16);
+
+    ncnn::Mat a;
+    ncnn::Mat b;
+    {
+        ncnn::Net net;
+        net.opt = opt;
+        net.load_param_mem(branchy_param);
+        int ret = net.load_model(modelpath);
+        if (ret != 0 || extract_branchy_net(net, in, false, a, b) != 0)
+        {
+            fprintf(stderr, "load_model failed\n");
+            remove(modelpath);
+            return -1;
+        }
+
+        if (net.referenced_weight_bytes() != 0)
+        {
+            fprintf(stderr, "load_model referenced weights %d\n", (int)net.referenced_weight_bytes());
+            remove(modelpath);
+            return -1;
+        }
+    }
+
+    ncnn::Net net;
+    net.opt = opt;
+    net.load_param_mem(branchy_param);
+    int ret = net.load_model_mmap(modelpath);
+    remove(modelpath);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_model_mmap failed\n");
+        return -1;
+    }
+
+    // weights are at most referenced as a whole
+    const size_t model_bytes = (128 + 8 + 1152 + 8 + 128 + 8 + 96 + 4) * sizeof(float);
+    size_t layer_bytes = 0;
+    for (size_t i = 0; i < net.layers().size(); i++)
+    {
+        layer_bytes += net.referenced_weight_bytes((int)i);
+    }
+    if (net.referenced_weight_bytes() > model_bytes || layer_bytes != net.referenced_weight_bytes())
+    {
+        fprintf(stderr, "referenced_weight_bytes mismatch %d %d\n", (int)net.referenced_weight_bytes(), (int)layer_bytes);
+        return -1;
+    }
+
+    ncnn::Mat c;
+    ncnn::Mat d;
+    ret = extract_branchy_net(net, in, false, c, d);
+    if (ret != 0)
+    {
+        fprintf(stderr, "extract with mmap model failed\n");
+        return -1;
+    }
+
+    if (CompareMat(a, c, 0.001) != 0 || CompareMat(b, d, 0.001) != 0)
+    {
+        fprintf(stderr, "test_net_load_model_mmap failed lightmode=%d\n", lightmode);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_net_lazy_pipeline(bool declare)
+{
+    const char* modelpath = "test_net_lazy.bin";
+    if (write_branchy_model(modelpath) != 0)
+    {
+        fprintf(stderr, "write_branchy_model failed\n");
+        return -1;
+    }
+
+    ncnn::Option opt;
+    opt.lightmode = true;
+    opt.num_threads = 1;
+
+    ncnn::Mat in = RandomMat(24, 24, 16);
+
+    ncnn::Mat a;
+    {
+        ncnn::Net net;
+        net.opt = opt;
+        net.load_param_mem(branchy_param);
+        net.load_model(modelpath);
+
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        ex.extract("a1", a);
+    }
+
+    ncnn::Net net;
+    net.opt = opt;
+    net.load_param_mem(branchy_param);
+    if (declare)
+    {
+        std::vector<const char*> outputs(1, "a1");
+        net.declare_outputs(outputs);
+    }
+    else
+    {
+        net.set_lazy_pipeline(true);
+    }
+    int ret = net.load_model_mmap(modelpath);
+    remove(modelpath);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_model_mmap failed\n");
+        return -1;
+    }
+
+    // conv0 is layer 2 and conv1 is layer 4
+    // lightmode releases the raw weights once create_pipeline repacked them
+    const size_t conv0_bytes = (128 + 8) * sizeof(float);
+    const size_t conv1_bytes = (1152 + 8) * sizeof(float);
+    const bool conv0_created = net.referenced_weight_bytes(2) < conv0_bytes;
+    if (conv0_created != declare || net.referenced_weight_bytes(4) != conv1_bytes)
+    {
+        fprintf(stderr, "layers created before extract %d %d\n", (int)net.referenced_weight_bytes(2), (int)net.referenced_weight_bytes(4));
+        return -1;
+    }
+
+    ncnn::Mat b;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        ret = ex.extract("a1", b);
+    }
+    if (ret != 0 || CompareMat(a, b, 0.001) != 0)
+    {
+        fprintf(stderr, "test_net_lazy_pipeline failed declare=%d\n", declare);
+        return -1;
+    }
+
+    // only the layers on the way to a1 are created
+    if (net.referenced_weight_bytes(2) >= conv0_bytes || net.referenced_weight_bytes(4) != conv1_bytes)
+    {
+        fprintf(stderr, "layers created after extract %d %d\n", (int)net.referenced_weight_bytes(2), (int)net.referenced_weight_bytes(4));
+        return -1;
+    }
+
+    if (declare)
+    {
+        ncnn::Mat c;
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        if (ex.extract("out", c) == 0)
+        {
+            fprintf(stderr, "extract undeclared output should fail\n");
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+// weight-heavy layers with stackable samples
+static const char* batch_param = "7767517\n"
+                                 "8 8\n"
+                                 "Input data 0 1 data 0=12 1=12 2=8\n"
+                                 "Convolution conv0 1 1 data c0 0=16 1=3 3=2 4=1 5=1 6=1152 9=1\n"
+                                 "Convolution conv1 1 1 c0 c1 0=16 1=1 5=1 6=256\n"
+                                 "Pooling pool 1 1 c1 p0 0=0 1=2 2=2\n"
+                                 "InnerProduct fc0 1 1 p0 fc0 0=32 1=1 2=4608\n"
+                                 "Reshape reshape 1 1 fc0 r0 0=8 1=4\n"
+                                 "Gemm gemm 1 1 r0 g0 5=1 8=6 9=8\n"
+                                 "InnerProduct fc1 1 1 g0 out 0=5 1=1 2=30\n";
+
+static int test_net_batch(bool lightmode, int num_threads)
+{
+    ncnn::Option opt;
+    opt.lightmode = lightmode;
+    opt.num_threads = num_threads;
+
+    ncnn::Net net;
+    net.opt = opt;
+    net.load_param_mem(batch_param);
+    SRAND(7767517);
+    DataReaderFromRandom dr;
+    int ret = net.load_model(dr);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load batch net failed\n");
+        return -1;
+    }
+
+    const int batch = 3;
+    std::vector<ncnn::Mat> in(batch);
+    std::vector<ncnn::Mat> a(batch);
+    std::vector<ncnn::Mat> b(batch);
+    for (int i = 0; i < batch; i++)
+    {
+        in[i] = RandomMat(12, 12, 8);
+
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in[i]);
+        if (ex.extract("c1", b[i]) != 0 || ex.extract("out", a[i]) != 0)
+        {
+            fprintf(stderr, "extract sample %d failed\n", i);
+            return -1;
+        }
+    }
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.input("data", in);
+
+    std::vector<ncnn::Mat> c;
+    std::vector<ncnn::Mat> d;
+    ret = ex.extract("c1", d);
+    if (ret == 0)
+        ret = ex.extract("out", c);
+    if (ret != 0 || (int)c.size() != batch || (int)d.size() != batch)
+    {
+        fprintf(stderr, "batch extract failed\n");
+        return -1;
+    }
+
+    for (int i = 0; i < batch; i++)
+    {
+        if (CompareMat(a[i], c[i], 0.001) != 0 || CompareMat(b[i], d[i], 0.001) != 0)
+        {
+            fprintf(stderr, "test_net_batch failed sample %d lightmode=%d num_threads=%d\n", i, lightmode, num_threads);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_net_profiler(bool lightmode, bool branch_parallel)
+{
+    ncnn::Option opt;
+    opt.lightmode = lightmode;
+    opt.num_threads = 2;
+
+    ncnn::Net net;
+    int ret = load_branchy_net(net, opt);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_branchy_net failed\n");
+        return -1;
+    }
+
+    ncnn::Mat in = RandomMat(24, 24, 16);
+
+    ncnn::Mat a;
+    ncnn::Mat b;
+    ret = extract_branchy_net(net, in, branch_parallel, a, b);
+    if (ret != 0)
+    {
+        fprintf(stderr, "extract without profiler failed\n");
+        return -1;
+    }
+
+    ncnn::Profiler profiler;
+
+    ncnn::Mat c;
+    ncnn::Mat d;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.set_branch_parallel(branch_parallel);
+        ex.set_profiler(&profiler);
+        ex.input("data", in);
+        ret = ex.extract("a1", c);
+        if (ret == 0)
+            ret = ex.extract("out", d);
+    }
+    if (ret != 0 || CompareMat(a, c, 0.001) != 0 || CompareMat(b, d, 0.001) != 0)
+    {
+        fprintf(stderr, "extract with profiler failed\n");
+        return -1;
+    }
+
+    // every layer except input forwards once
+    const std::vector<ncnn::ProfilerRecord> records = profiler.records();
+    int forward_count = 0;
+    size_t blob_bytes = 0;
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const ncnn::ProfilerRecord& r = records[i];
+        if (r.end < r.start || r.layer_index <= 0 || r.layer_index >= (int)net.layers().size() || r.top_shapes.empty())
+        {
+            fprintf(stderr, "test_net_profiler bad record %d\n", (int)i);
+            return -1;
+        }
+
+        if (r.type == 0)
+        {
+            forward_count++;
+            blob_bytes += r.blob_bytes;
+        }
+    }
+    if (forward_count != 9 || blob_bytes == 0)
+    {
+        fprintf(stderr, "test_net_profiler failed lightmode=%d branch_parallel=%d forward_count=%d blob_bytes=%d\n", lightmode, branch_parallel, forward_count, (int)blob_bytes);
+        return -1;
+    }
+
+    const char* tracepath = "test_net_profiler.json";
+    ret = profiler.write_chrome_trace(tracepath);
+    if (ret != 0)
+    {
+        fprintf(stderr, "write_chrome_trace failed\n");
+        return -1;
+    }
+
+    FILE* fp = fopen(tracepath, "rb");
+    char header[16] = {0};
+    size_t nread = fp ? fread(header, 1, 14, fp) : 0;
+    if (fp)
+        fclose(fp);
+    remove(tracepath);
+    if (nread != 14 || strncmp(header, "{\"traceEvents\"", 14) != 0)
+    {
+        fprintf(stderr, "write_chrome_trace bad content\n");
+        return -1;
+    }
+
+    profiler.clear();
+    if (!profiler.records().empty())
+    {
+        fprintf(stderr, "profiler clear failed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+// only cheap layers, no weights
+static const char* cheap_param = "7767517\n"
+                                 "6 7\n"
+                                 "Input data 0 1 data 0=16 1=16 2=8\n"
+                                 "Split split 1 2 data a b\n"
+                                 "ReLU relu 1 1 a a0\n"
+                                 "Sigmoid sigmoid 1 1 b b0\n"
+                                 "BinaryOp add 2 1 a0 b0 c 0=0\n"
+                                 "Pooling pool 1 1 c out 0=0 1=2 2=2\n";
+
+static int extract_cheap_net(bool bf16, const ncnn::Mat& in, ncnn::Mat& out, int& conversion_count)
+{
+    ncnn::Net net;
+    net.opt.use_bf16_storage = bf16;
+    net.opt.use_storage_assignment = true;
+    net.opt.num_threads = 1;
+    net.load_param_mem(cheap_param);
+
+    DataReaderFromRandom dr;
+    int ret = net.load_model(dr);
+    if (ret != 0)
+        return ret;
+
+    ncnn::Profiler profiler;
+
+    const int count0 = net.layout_conversion_count();
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.set_profiler(&profiler);
+    ex.input("data", in);
+    ret = ex.extract("out", out);
+
+    conversion_count = net.layout_conversion_count() - count0;
+
+    // the same count without profiler
+    if (ret == 0 && conversion_count != profiler.layout_conversion_count())
+    {
+        fprintf(stderr, "layout_conversion_count %d while profiler counts %d\n", conversion_count, profiler.layout_conversion_count());
+        return -1;
+    }
+
+    return ret;
+}
+
+static int test_net_layout_assignment()
+{
+    ncnn::Mat in = RandomMat(16, 16, 8);
+
+    ncnn::Mat a;
+    ncnn::Mat b;
+    int a_conversion_count = 0;
+    int b_conversion_count = 0;
+    if (extract_cheap_net(false, in, a, a_conversion_count) != 0 || extract_cheap_net(true, in, b, b_conversion_count) != 0)
+    {
+        fprintf(stderr, "extract_cheap_net failed\n");
+        return -1;
+    }
+
+    // no layer is worth the bf16 casts
+    if (CompareMat(a, b, 0.001) != 0 || a_conversion_count != b_conversion_count)
+    {
+        fprintf(stderr, "test_net_layout_assignment failed conversion_count %d %d\n", a_conversion_count, b_conversion_count);
+        return -1;
+    }
+
+    return 0;
+}
+
+// layers with winograd, packed, sgemm and gemm transformed weights
+static const char* weight_cache_param = "7767517\n"
+                                        "7 7\n"
+                                        "Input data 0 1 data 0=12 1=12 2=16\n"
+                                        "Convolution conv0 1 1 data c0 0=16 1=3 4=1 5=1 6=2304 9=1\n"
+                                        "Convolution conv1 1 1 c0 c1 0=16 1=3 3=2 4=1 5=1 6=2304\n"
+                                        "Convolution conv2 1 1 c1 c2 0=8 1=1 5=1 6=128\n"
+                                        "InnerProduct fc 1 1 c2 fc 0=24 1=1 2=6912\n"
+                                        "Reshape reshape 1 1 fc r0 0=6 1=4\n"
+                                        "Gemm gemm 1 1 r0 out 5=1 8=5 9=6\n";
+
+static int run_weight_cache_net(const ncnn::Option& opt, int seed, const char* cachepath, const ncnn::Mat& in, ncnn::Mat& out)
+{
+    ncnn::Net net;
+    net.opt = opt;
+    net.set_weight_cache(cachepath);
+    net.load_param_mem(weight_cache_param);
+    SRAND(seed);
+    DataReaderFromRandom dr;
+    int ret = net.load_model(dr);
+    if (ret != 0)
+        return ret;
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.input("data", in);
+    return ex.extract("out", out);
+}
+
+static int test_net_weight_cache(bool lightmode)
+{
+    const char* cachepath = "test_net_weight_cache.bin";
+    remove(cachepath);
+
+    ncnn::Option opt;
+    opt.lightmode = lightmode;
+    opt.num_threads = 1;
+
+    ncnn::Mat in = RandomMat(12, 12, 16);
+
+    // without cache, cache written, cache restored
+    ncnn::Mat a;
+    ncnn::Mat b;
+    ncnn::Mat c;
+    int ret = run_weight_cache_net(opt, 7767517, 0, in, a);
+    if (ret == 0)
+        ret = run_weight_cache_net(opt, 7767517, cachepath, in, b);
+    if (ret == 0)
+        ret = run_weight_cache_net(opt, 7767517, cachepath, in, c);
+
+    FILE* fp = fopen(cachepath, "rb");
+    if (ret != 0 || !fp)
+    {
+        fprintf(stderr, "weight cache net failed\n");
+        remove(cachepath);
+        return -1;
+    }
+    fclose(fp);
+
+    // other weights must not pick up the cached ones
+    ncnn::Mat d;
+    ncnn::Mat e;
+    ret = run_weight_cache_net(opt, 233, 0, in, d);
+    if (ret == 0)
+        ret = run_weight_cache_net(opt, 233, cachepath, in, e);
+    remove(cachepath);
+    if (ret != 0)
+    {
+        fprintf(stderr, "weight cache net with other weights failed\n");
+        return -1;
+    }
+
+    if (CompareMat(a, b, 0.001) != 0 || CompareMat(a, c, 0.001) != 0 || CompareMat(d, e, 0.001) != 0)
+    {
+        fprintf(stderr, "test_net_weight_cache failed lightmode=%d\n", lightmode);
+        return -1;
+    }
+
+    return 0;
+}
+
+// models loaded from a path are keyed on the weight content, same size new weights must not restore
+static int test_net_weight_cache_file(bool lightmode)
+{
+    const char* modelpath = "test_net_weight_cache_branchy.bin";
+    const char* cachepath = "test_net_weight_cache_file.bin";
+    remove(cachepath);
+    if (write_branchy_model(modelpath) != 0)
+    {
+        fprintf(stderr, "write_branchy_model failed\n");
+        return -1;
+    }
+
+    ncnn::Option opt;
+    opt.lightmode = lightmode;
+    opt.num_threads = 1;
+
+    ncnn::Mat in = RandomMat(24, 24, 16);
+
+    // without cache, cache written, cache restored
+    ncnn::Mat a[3];
+    ncnn::Mat b[3];
+    int ret = 0;
+    for (int i = 0; i < 3 && ret == 0; i++)
+    {
+        ncnn::Net net;
+        net.opt = opt;
+        if (i > 0)
+            net.set_weight_cache(cachepath);
+        net.load_param_mem(branchy_param);
+        ret = i == 2 ? net.load_model_mmap(modelpath) : net.load_model(modelpath);
+        if (ret == 0)
+            ret = extract_branchy_net(net, in, false, a[i], b[i]);
+    }
+
+    FILE* fp = fopen(cachepath, "rb");
+    if (fp)
+        fclose(fp);
+
+    // overwrite the weights in place, without cache and with the stale cache
+    ncnn::Mat c[2];
+    ncnn::Mat d[2];
+    if (ret == 0 && fp)
+        ret = write_branchy_model(modelpath, 233);
+    for (int i = 0; i < 2 && ret == 0 && fp; i++)
+    {
+        ncnn::Net net;
+        net.opt = opt;
+        if (i > 0)
+            net.set_weight_cache(cachepath);
+        net.load_param_mem(branchy_param);
+        ret = net.load_model(modelpath);
+        if (ret == 0)
+            ret = extract_branchy_net(net, in, false, c[i], d[i]);
+    }
+
+    remove(modelpath);
+    remove(cachepath);
+    if (ret != 0 || !fp)
+    {
+        fprintf(stderr, "weight cache net from file failed\n");
+        return -1;
+    }
+
+    for (int i = 1; i < 3; i++)
+    {
+        if (CompareMat(a[0], a[i], 0.001) != 0 || CompareMat(b[0], b[i], 0.001) != 0)
+        {
+            fprintf(stderr, "test_net_weight_cache_file failed lightmode=%d\n", lightmode);
+            return -1;
+        }
+    }
+
+    if (CompareMat(c[0], c[1], 0.001) != 0 || CompareMat(d[0], d[1], 0.001) != 0)
+    {
+        fprintf(stderr, "test_net_weight_cache_file restored stale weights lightmode=%d\n", lightmode);
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    return 0
+           || test_net_branch_parallel(true, 1)
+           || test_net_branch_parallel(true, 4)
+           || test_net_branch_parallel(false, 2)
+           || test_net_branch_parallel(false, 4)
+           || test_net_memory_plan(true, false)
+           || test_net_memory_plan(false, false)
+           || test_net_memory_plan(true, true)
+           || test_net_load_model_mmap(true)
+           || test_net_load_model_mmap(false)
+           || test_net_lazy_pipeline(false)
+           || test_net_lazy_pipeline(true)
+           || test_net_batch(true, 1)
+           || test_net_batch(false, 1)
+           || test_net_batch(false, 4)
+           || test_net_profiler(true, false)
+           || test_net_profiler(false, false)
+           || test_net_profiler(false, true)
+           || test_net_layout_assignment()
+           || test_net_weight_cache(true)
+           || test_net_weight_cache(false)
+           || test_net_weight_cache_file(true)
+           || test_net_weight_cache_file(false);
+}
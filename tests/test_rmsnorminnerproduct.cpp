@@ -0,0 +1,152 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int forward_unfused(const ncnn::Mat& a, const ncnn::Mat& gamma, const ncnn::Mat& weight, const ncnn::Mat& bias, int outch, int activation_type, const ncnn::Mat& activation_params, float eps, ncnn::Mat& b)
+{
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = false;
+    opt.use_fp16_storage = false;
+    opt.use_bf16_storage = false;
+
+    ncnn::Layer* rmsnorm = ncnn::create_layer_cpu("RMSNorm");
+    {
+        ncnn::ParamDict pd;
+        pd.set(0, a.w);
+        pd.set(1, eps);
+        pd.set(2, 1);
+        rmsnorm->load_param(pd);
+
+        ncnn::Mat weights[1];
+        weights[0] = gamma;
+        rmsnorm->load_model(ncnn::ModelBinFromMatArray(weights));
+        rmsnorm->create_pipeline(opt);
+    }
+
+    ncnn::Layer* innerproduct = ncnn::create_layer_cpu("InnerProduct");
+    {
+        ncnn::ParamDict pd;
+        pd.set(0, outch);
+        pd.set(1, bias.empty() ? 0 : 1);
+        pd.set(2, outch * a.w);
+        pd.set(9, activation_type);
+        pd.set(10, activation_params);
+        innerproduct->load_param(pd);
+
+        ncnn::Mat weights[2];
+        weights[0] = weight;
+        weights[1] = bias;
+        innerproduct->load_model(ncnn::ModelBinFromMatArray(weights));
+        innerproduct->create_pipeline(opt);
+    }
+
+    ncnn::Mat x = a.clone();
+    int ret = rmsnorm->forward_inplace(x, opt);
+    if (ret == 0)
+        ret = innerproduct->forward(x, b, opt);
+
+    rmsnorm->destroy_pipeline(opt);
+    innerproduct->destroy_pipeline(opt);
+    delete rmsnorm;
+    delete innerproduct;
+
+    return ret;
+}
+
+static int test_rmsnorminnerproduct(const ncnn::Mat& a, int outch, int bias)
+{
+    const int num_input = a.w;
+    const float eps = 0.001f;
+
+    int activation_type = RAND() % 7; // 0 1 2 3 4 5 6
+    ncnn::Mat activation_params(2);
+    activation_params[0] = (activation_type == 6) ? RandomFloat(0, 1) : RandomFloat(-1, 0); // alpha
+    activation_params[1] = RandomFloat(0, 1);                                               // beta
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch); // num_output
+    pd.set(1, bias);  // bias_term
+    pd.set(2, outch * num_input);
+    pd.set(3, eps);
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    ncnn::Mat gamma = RandomMat(num_input);
+    ncnn::Mat weight = RandomMat(outch * num_input);
+
+    // fold gamma into weight
+    ncnn::Mat weight_folded(outch * num_input);
+    for (int i = 0; i < outch; i++)
+    {
+        for (int k = 0; k < num_input; k++)
+        {
+            weight_folded[i * num_input + k] = weight[i * num_input + k] * gamma[k];
+        }
+    }
+
+    std::vector<ncnn::Mat> weights(bias ? 2 : 1);
+    weights[0] = weight_folded;
+    if (bias)
+        weights[1] = RandomMat(outch);
+
+    int ret = test_layer("RMSNormInnerProduct", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_rmsnorminnerproduct failed a.dims=%d a=(%d %d) outch=%d bias=%d act=%d actparams=[%f,%f]\n", a.dims, a.w, a.h, outch, bias, activation_type, activation_params[0], activation_params[1]);
+        return ret;
+    }
+
+    // the fused layer must match rmsnorm followed by innerproduct
+    ncnn::Mat b;
+    ret = forward_unfused(a, gamma, weight, bias ? weights[1] : ncnn::Mat(), outch, activation_type, activation_params, eps, b);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_rmsnorminnerproduct forward_unfused failed\n");
+        return ret;
+    }
+
+    ncnn::Mat c;
+    ret = test_layer_naive(ncnn::layer_to_index("RMSNormInnerProduct"), pd, weights, a, c, 0, 0);
+    if (ret != 0 || CompareMat(b, c, 0.001) != 0)
+    {
+        fprintf(stderr, "test_rmsnorminnerproduct unfused mismatch a.dims=%d a=(%d %d) outch=%d bias=%d act=%d\n", a.dims, a.w, a.h, outch, bias, activation_type);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_rmsnorminnerproduct_0()
+{
+    return 0
+           || test_rmsnorminnerproduct(RandomMat(1), 1, 1)
+           || test_rmsnorminnerproduct(RandomMat(3), 2, 0)
+           || test_rmsnorminnerproduct(RandomMat(16), 7, 1)
+           || test_rmsnorminnerproduct(RandomMat(24), 8, 0)
+           || test_rmsnorminnerproduct(RandomMat(15), 32, 1)
+           || test_rmsnorminnerproduct(RandomMat(64), 16, 1);
+}
+
+static int test_rmsnorminnerproduct_1()
+{
+    return 0
+           || test_rmsnorminnerproduct(RandomMat(1, 1), 1, 1)
+           || test_rmsnorminnerproduct(RandomMat(3, 2), 2, 0)
+           || test_rmsnorminnerproduct(RandomMat(9, 8), 7, 1)
+           || test_rmsnorminnerproduct(RandomMat(16, 5), 8, 0)
+           || test_rmsnorminnerproduct(RandomMat(4, 15), 8, 1)
+           || test_rmsnorminnerproduct(RandomMat(32, 16), 16, 0)
+           || test_rmsnorminnerproduct(RandomMat(64, 7), 48, 1)
+           || test_rmsnorminnerproduct(RandomMat(6, 5), 16, 1);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_rmsnorminnerproduct_0()
+           || test_rmsnorminnerproduct_1();
+}
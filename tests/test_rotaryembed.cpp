@@ -0,0 +1,110 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_rotaryembed(const ncnn::Mat& a, int cos_w, int interleaved)
+{
+    const int embed_dim = a.w;
+    const int seqlen = a.dims == 1 ? 1 : a.h;
+
+    ncnn::ParamDict pd;
+    pd.set(0, interleaved);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    std::vector<ncnn::Mat> as(3);
+    as[0] = a;
+    as[1] = RandomMat(cos_w, seqlen, -1.f, 1.f);
+    as[2] = RandomMat(cos_w, seqlen, -1.f, 1.f);
+
+    int ret = test_layer("RotaryEmbed", pd, weights, as);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_rotaryembed failed a.dims=%d a=(%d %d %d) embed_dim=%d cos_w=%d interleaved=%d\n", a.dims, a.w, a.h, a.c, embed_dim, cos_w, interleaved);
+    }
+
+    return ret;
+}
+
+static int test_rotaryembed_table(const ncnn::Mat& a, int interleaved, int max_position, int position_offset)
+{
+    const int embed_dim = a.w;
+    const int seqlen = a.dims == 1 ? 1 : a.h;
+
+    ncnn::ParamDict pd;
+    pd.set(0, interleaved);
+    pd.set(1, 10000.f);
+    pd.set(2, max_position);
+    pd.set(3, embed_dim);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    std::vector<ncnn::Mat> as(position_offset >= 0 ? 2 : 1);
+    as[0] = a;
+    if (position_offset >= 0)
+    {
+        ncnn::Mat positions(seqlen, (size_t)4u);
+        for (int i = 0; i < seqlen; i++)
+        {
+            ((int*)positions)[i] = position_offset + i;
+        }
+        as[1] = positions;
+    }
+
+    int ret = test_layer("RotaryEmbed", pd, weights, as);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_rotaryembed_table failed a.dims=%d a=(%d %d %d) interleaved=%d max_position=%d position_offset=%d\n", a.dims, a.w, a.h, a.c, interleaved, max_position, position_offset);
+    }
+
+    return ret;
+}
+
+static int test_rotaryembed_0()
+{
+    return 0
+           || test_rotaryembed(RandomMat(64, 7, 8), 32, 0)
+           || test_rotaryembed(RandomMat(64, 7, 8), 64, 0)
+           || test_rotaryembed(RandomMat(64, 7, 8), 32, 1)
+           || test_rotaryembed(RandomMat(64, 7, 8), 64, 1)
+           || test_rotaryembed(RandomMat(22, 5, 3), 11, 0)
+           || test_rotaryembed(RandomMat(22, 5, 3), 22, 1)
+           || test_rotaryembed(RandomMat(48, 16, 16), 24, 0)
+           || test_rotaryembed(RandomMat(48, 16, 16), 48, 1)
+           || test_rotaryembed(RandomMat(10, 1, 4), 5, 1);
+}
+
+static int test_rotaryembed_1()
+{
+    return 0
+           || test_rotaryembed(RandomMat(64, 16), 32, 0)
+           || test_rotaryembed(RandomMat(64, 16), 64, 1)
+           || test_rotaryembed(RandomMat(30, 12), 15, 0)
+           || test_rotaryembed(RandomMat(30, 12), 30, 1)
+           || test_rotaryembed(RandomMat(18, 7), 9, 1)
+           || test_rotaryembed(RandomMat(32), 16, 0)
+           || test_rotaryembed(RandomMat(32), 32, 1);
+}
+
+static int test_rotaryembed_2()
+{
+    return 0
+           || test_rotaryembed_table(RandomMat(64, 7, 8), 0, 128, -1)
+           || test_rotaryembed_table(RandomMat(64, 7, 8), 1, 128, -1)
+           || test_rotaryembed_table(RandomMat(32, 16, 4), 0, 0, -1)
+           || test_rotaryembed_table(RandomMat(64, 1, 8), 0, 128, 100)
+           || test_rotaryembed_table(RandomMat(64, 4, 8), 1, 128, 126)
+           || test_rotaryembed_table(RandomMat(48, 8), 0, 16, 5)
+           || test_rotaryembed_table(RandomMat(48, 8), 1, 0, 3);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_rotaryembed_0()
+           || test_rotaryembed_1()
+           || test_rotaryembed_2();
+}
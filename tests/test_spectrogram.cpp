@@ -39,9 +39,46 @@ static int test_spectrogram_0()
            || test_spectrogram(124, 55, 2, 12, 55, 1, 1, 2, 2, 0);
 }
 
+static int test_spectrogram_stream(int size, int cache_size, int n_fft, int power, int hoplen, int winlen, int window_type, int normalized, int onesided)
+{
+    std::vector<ncnn::Mat> as(2);
+    as[0] = RandomMat(size);
+    as[1] = RandomMat(cache_size);
+
+    ncnn::ParamDict pd;
+    pd.set(0, n_fft);
+    pd.set(1, power);
+    pd.set(2, hoplen);
+    pd.set(3, winlen);
+    pd.set(4, window_type);
+    pd.set(7, normalized);
+    pd.set(8, onesided);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int ret = test_layer("Spectrogram", pd, weights, as, 2);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_spectrogram_stream failed size=%d cache_size=%d n_fft=%d power=%d hoplen=%d winlen=%d window_type=%d normalized=%d onesided=%d\n", size, cache_size, n_fft, power, hoplen, winlen, window_type, normalized, onesided);
+    }
+
+    return ret;
+}
+
+static int test_spectrogram_1()
+{
+    return 0
+           || test_spectrogram_stream(40, 8, 16, 0, 4, 16, 1, 0, 1)
+           || test_spectrogram_stream(37, 5, 17, 1, 7, 15, 2, 1, 0)
+           || test_spectrogram_stream(160, 240, 400, 2, 160, 400, 1, 2, 1)
+           || test_spectrogram_stream(100, 27, 55, 0, 12, 55, 0, 0, 1);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_spectrogram_0();
+    return 0
+           || test_spectrogram_0()
+           || test_spectrogram_1();
 }
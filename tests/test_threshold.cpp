@@ -0,0 +1,86 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+// keep values away from threshold so that fp16 and bf16 rounding never flips the output
+static ncnn::Mat AwayFrom(ncnn::Mat m, float threshold)
+{
+    const int size = (int)m.total();
+    for (int i = 0; i < size; i++)
+    {
+        if (fabsf(m[i] - threshold) < 0.05f)
+            m[i] = threshold + 0.1f;
+    }
+
+    return m;
+}
+
+static int test_threshold(const ncnn::Mat& _a, float threshold)
+{
+    ncnn::Mat a = AwayFrom(_a.clone(), threshold);
+
+    ncnn::ParamDict pd;
+    pd.set(0, threshold);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int ret = test_layer("Threshold", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_threshold failed a.dims=%d a=(%d %d %d %d) threshold=%f\n", a.dims, a.w, a.h, a.d, a.c, threshold);
+    }
+
+    return ret;
+}
+
+static int test_threshold(const ncnn::Mat& a)
+{
+    return 0
+           || test_threshold(a, 0.f)
+           || test_threshold(a, 0.3f)
+           || test_threshold(a, -0.6f);
+}
+
+static int test_threshold_0()
+{
+    return 0
+           || test_threshold(RandomMat(5, 6, 7, 24))
+           || test_threshold(RandomMat(7, 8, 9, 12))
+           || test_threshold(RandomMat(3, 4, 5, 13));
+}
+
+static int test_threshold_1()
+{
+    return 0
+           || test_threshold(RandomMat(10, 12, 24))
+           || test_threshold(RandomMat(3, 6, 18))
+           || test_threshold(RandomMat(12, 4, 7));
+}
+
+static int test_threshold_2()
+{
+    return 0
+           || test_threshold(RandomMat(12, 32))
+           || test_threshold(RandomMat(20, 16))
+           || test_threshold(RandomMat(19, 13));
+}
+
+static int test_threshold_3()
+{
+    return 0
+           || test_threshold(RandomMat(64))
+           || test_threshold(RandomMat(156))
+           || test_threshold(RandomMat(243));
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_threshold_0()
+           || test_threshold_1()
+           || test_threshold_2()
+           || test_threshold_3();
+}
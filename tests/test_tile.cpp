@@ -122,7 +122,12 @@ static int test_tile_0()
            || test_tile(c, IntArray(3))
            || test_tile(c, IntArray(1, 1, 4))
            || test_tile(c, IntArray(2, 2, 5))
-           || test_tile(c, IntArray(3, 2, 1, 9));
+           || test_tile(c, IntArray(3, 2, 1, 9))
+
+           // repeat along d only
+           || test_tile(a, IntArray(1, 2, 1, 1))
+           || test_tile(b, IntArray(3, 1, 1))
+           || test_tile(c, IntArray(1, 4, 1, 1));
 }
 
 static int test_tile_1()
@@ -89,9 +89,11 @@
 #include "layer/requantize.h"
 #include "layer/reshape.h"
 #include "layer/rmsnorm.h"
+#include "layer/rmsnorminnerproduct.h"
 #include "layer/rnn.h"
 #include "layer/roialign.h"
 #include "layer/roipooling.h"
+#include "layer/rotaryembed.h"
 #include "layer/scale.h"
 #include "layer/shufflechannel.h"
 #include "layer/slice.h"
@@ -235,6 +237,7 @@ public:
     int fprintf_param_float_array(int id, const ncnn::Mat& m, FILE* pp);
 
     int fwrite_weight_tag_data(const ncnn::Mat& data, FILE* bp, float a = -1.2f, float b = 1.2f);
+    int fwrite_weight_int4_tag_data(const ncnn::Mat& data, FILE* bp);
     int fwrite_weight_data(const ncnn::Mat& data, FILE* bp, float a = -1.2f, float b = 1.2f);
 
     int save(const char* parampath, const char* binpath);
@@ -655,6 +658,41 @@ int ModelWriter::fwrite_weight_tag_data(const ncnn::Mat& data, FILE* bp, float a
     return 0;
 }
 
+int ModelWriter::fwrite_weight_int4_tag_data(const ncnn::Mat& data, FILE* bp)
+{
+    int p0 = ftell(bp);
+
+    ncnn::Mat data_flattened = data.reshape(data.w * data.h * data.d * data.c);
+
+    signed char* ptr = data_flattened;
+    if (gen_random_weight)
+    {
+        for (int i = 0; i < data_flattened.w; i++)
+        {
+            ptr[i] = (signed char)RandomFloat(-8, 7);
+        }
+    }
+
+    const int tag = 0x000D4B34; // int4 magic
+    fwrite(&tag, sizeof(int), 1, bp);
+
+    // two values per byte, low nibble first
+    std::vector<unsigned char> data_int4((data_flattened.w + 1) / 2, 0);
+    for (int i = 0; i < data_flattened.w; i++)
+    {
+        data_int4[i / 2] |= (unsigned char)((ptr[i] & 0x0f) << (i % 2 * 4));
+    }
+    fwrite(&data_int4[0], sizeof(unsigned char), data_int4.size(), bp);
+
+    // padding to 32bit align
+    int nwrite = ftell(bp) - p0;
+    size_t nalign = alignSize(nwrite, 4);
+    unsigned char padding[4] = {0x00, 0x00, 0x00, 0x00};
+    fwrite(padding, sizeof(unsigned char), nalign - nwrite, bp);
+
+    return 0;
+}
+
 int ModelWriter::fwrite_weight_data(const ncnn::Mat& data, FILE* bp, float a, float b)
 {
     int p0 = ftell(bp);
@@ -1775,6 +1813,8 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             fprintf_param_value(" 20=%d", constant_TILE_M)
             fprintf_param_value(" 21=%d", constant_TILE_N)
             fprintf_param_value(" 22=%d", constant_TILE_K)
+            fprintf_param_value(" 23=%d", weight_quant_bits)
+            fprintf_param_value(" 24=%d", weight_quant_group_size)
 
             if (op->constantA == 1)
             {
@@ -1782,7 +1822,16 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             }
             if (op->constantB == 1)
             {
-                fwrite_weight_tag_data(op->B_data, bp);
+                if (op->weight_quant_bits == 4)
+                    fwrite_weight_int4_tag_data(op->B_data, bp);
+                else
+                    fwrite_weight_tag_data(op->B_data, bp);
+
+                if (op->weight_quant_bits)
+                {
+                    fwrite_weight_data(op->B_data_quant_scales, bp, 0.001, 0.1);
+                    fwrite_weight_data(op->B_data_quant_zeros, bp);
+                }
             }
             if (op->constantC == 1 && op->constant_broadcast_type_C != -1)
             {
@@ -1888,10 +1937,21 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             {
                 if (!op->activation_params.empty()) fprintf_param_float_array(10, op->activation_params, pp);
             }
+            fprintf_param_value(" 11=%d", weight_quant_bits)
+            fprintf_param_value(" 12=%d", weight_quant_group_size)
 
-            fwrite_weight_tag_data(op->weight_data, bp);
+            if (op->weight_quant_bits == 4)
+                fwrite_weight_int4_tag_data(op->weight_data, bp);
+            else
+                fwrite_weight_tag_data(op->weight_data, bp);
             fwrite_weight_data(op->bias_data, bp);
 
+            if (op->weight_quant_bits)
+            {
+                fwrite_weight_data(op->weight_quant_scales, bp, 0.001, 0.1);
+                fwrite_weight_data(op->weight_quant_zeros, bp);
+            }
+
 #if NCNN_INT8
             // write int8_scale data
             if (op->int8_scale_term)
@@ -2039,6 +2099,7 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             fprintf_param_value(" 4=%d", vdim)
             fprintf_param_value(" 5=%d", attn_mask)
             fprintf_param_value(" 6=%e", scale)
+            fprintf_param_value(" 7=%d", kv_cache)
             fprintf_param_value(" 18=%d", int8_scale_term)
 
             fwrite_weight_tag_data(op->q_weight_data, bp);
@@ -2360,6 +2421,33 @@ int ModelWriter::save(const char* parampath, const char* binpath)
 
             fwrite_weight_data(op->gamma_data, bp);
         }
+        else if (layer->type == "RMSNormInnerProduct")
+        {
+            ncnn::RMSNormInnerProduct* op = (ncnn::RMSNormInnerProduct*)layer;
+            ncnn::RMSNormInnerProduct* op_default = (ncnn::RMSNormInnerProduct*)layer_default;
+
+            fprintf_param_value(" 0=%d", num_output)
+            fprintf_param_value(" 1=%d", bias_term)
+            fprintf_param_value(" 2=%d", weight_data_size)
+            fprintf_param_value(" 3=%e", eps)
+            fprintf_param_value(" 9=%d", activation_type)
+            {
+                if (!op->activation_params.empty()) fprintf_param_float_array(10, op->activation_params, pp);
+            }
+
+            fwrite_weight_tag_data(op->weight_data, bp);
+            fwrite_weight_data(op->bias_data, bp);
+
+            if (shape_ready)
+            {
+                int inw = blobs[layer->bottoms[0]].shape.w;
+                int inh = blobs[layer->bottoms[0]].shape.h;
+                int inc = blobs[layer->bottoms[0]].shape.c;
+                int outw = blobs[layer->tops[0]].shape.w;
+
+                mac += (uint64_t)inw * inh * inc * outw;
+            }
+        }
         else if (layer->type == "RNN")
         {
             ncnn::RNN* op = (ncnn::RNN*)layer;
@@ -2404,6 +2492,16 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             fprintf_param_value(" 1=%d", pooled_height)
             fprintf_param_value(" 2=%e", spatial_scale)
         }
+        else if (layer->type == "RotaryEmbed")
+        {
+            ncnn::RotaryEmbed* op = (ncnn::RotaryEmbed*)layer;
+            ncnn::RotaryEmbed* op_default = (ncnn::RotaryEmbed*)layer_default;
+
+            fprintf_param_value(" 0=%d", interleaved)
+            fprintf_param_value(" 1=%e", rope_theta)
+            fprintf_param_value(" 2=%d", max_position)
+            fprintf_param_value(" 3=%d", head_dim)
+        }
         else if (layer->type == "Scale")
         {
             ncnn::Scale* op = (ncnn::Scale*)layer;
@@ -60,6 +60,8 @@ public:
     int fuse_innerproduct_activation();
     int fuse_memorydata_binaryop();
     int fuse_binaryop_eltwise();
+    int fuse_slice_sigmoid_binaryop();
+    int fuse_rmsnorm_innerproduct();
 
     int eliminate_dropout();
     int eliminate_pooling1x1();
@@ -2036,6 +2038,187 @@ int NetOptimize::fuse_binaryop_eltwise()
     return 0;
 }
 
+int NetOptimize::fuse_slice_sigmoid_binaryop()
+{
+    const size_t layer_count = layers.size();
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        if (layers[i]->type != "BinaryOp")
+            continue;
+
+        if (layers[i]->bottoms.size() != 2)
+            continue;
+
+        ncnn::BinaryOp* binaryop = (ncnn::BinaryOp*)layers[i];
+
+        if (binaryop->op_type != ncnn::BinaryOp::Operation_MUL)
+            continue;
+
+        if (binaryop->with_scalar)
+            continue;
+
+        // Slice - Sigmoid - BinaryOp to GLU
+        for (int k = 0; k < 2; k++)
+        {
+            int gate_blob_index = binaryop->bottoms[k];
+            int blob_index = binaryop->bottoms[1 - k];
+
+            size_t j = 0;
+            for (; j < i; j++)
+            {
+                if (layers[j]->type != "Sigmoid")
+                    continue;
+
+                if (layers[j]->tops[0] == gate_blob_index)
+                    break;
+            }
+
+            if (j == i)
+                continue;
+
+            ncnn::Layer* sigmoid = layers[j];
+
+            size_t j2 = 0;
+            for (; j2 < j; j2++)
+            {
+                if (layers[j2]->type != "Slice")
+                    continue;
+
+                if (layers[j2]->tops.size() != 2)
+                    continue;
+
+                if (layers[j2]->tops[0] == blob_index && layers[j2]->tops[1] == sigmoid->bottoms[0])
+                    break;
+            }
+
+            if (j2 == j)
+                continue;
+
+            ncnn::Slice* slice = (ncnn::Slice*)layers[j2];
+
+            // equal halves only
+            if (slice->slices.w != 2 || slice->indices.w != 0)
+                continue;
+
+            const int* slices_ptr = slice->slices;
+            if (slices_ptr[0] != -233 || slices_ptr[1] != -233)
+                continue;
+
+            fprintf(stderr, "fuse_slice_sigmoid_binaryop %s %s %s\n", slice->name.c_str(), sigmoid->name.c_str(), binaryop->name.c_str());
+
+            ncnn::GLU* glu = (ncnn::GLU*)ncnn::create_layer_cpu("GLU");
+
+            glu->type = "GLU";
+            glu->name = binaryop->name;
+            glu->bottoms = slice->bottoms;
+            glu->tops = binaryop->tops;
+
+            ncnn::ParamDict pd;
+            glu->load_param(pd);
+
+            glu->axis = slice->axis;
+
+            blobs[glu->bottoms[0]].consumer = i;
+
+            slice->type = "ncnnfused";
+            sigmoid->type = "ncnnfused";
+
+            layers[i] = glu;
+            delete binaryop;
+
+            break;
+        }
+    }
+
+    return 0;
+}
+
+int NetOptimize::fuse_rmsnorm_innerproduct()
+{
+    const size_t layer_count = layers.size();
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        if (layers[i]->type != "RMSNorm")
+            continue;
+
+        // RMSNorm - InnerProduct
+        int top_blob_index = layers[i]->tops[0];
+
+        size_t j = i + 1;
+        for (; j < layer_count; j++)
+        {
+            if (layers[j]->type != "InnerProduct")
+                continue;
+
+            if (layers[j]->bottoms.size() != 1)
+                continue;
+
+            if (layers[j]->bottoms[0] == top_blob_index)
+                break;
+        }
+
+        if (j == layer_count)
+            continue;
+
+        ncnn::RMSNorm* rmsnorm = (ncnn::RMSNorm*)layers[i];
+        ncnn::InnerProduct* innerproduct = (ncnn::InnerProduct*)layers[j];
+
+        if (innerproduct->int8_scale_term != 0 || innerproduct->weight_quant_bits != 0)
+            continue;
+
+        // rmsnorm must cover exactly one innerproduct input row
+        const int num_input = innerproduct->weight_data_size / innerproduct->num_output;
+        if (rmsnorm->affine_size != num_input)
+            continue;
+
+        fprintf(stderr, "fuse_rmsnorm_innerproduct %s %s\n", rmsnorm->name.c_str(), innerproduct->name.c_str());
+
+        ncnn::RMSNormInnerProduct* rmsnorminnerproduct = (ncnn::RMSNormInnerProduct*)ncnn::create_layer_cpu("RMSNormInnerProduct");
+
+        rmsnorminnerproduct->type = "RMSNormInnerProduct";
+        rmsnorminnerproduct->name = innerproduct->name;
+        rmsnorminnerproduct->bottoms = rmsnorm->bottoms;
+        rmsnorminnerproduct->tops = innerproduct->tops;
+
+        ncnn::ParamDict pd;
+        rmsnorminnerproduct->load_param(pd);
+
+        rmsnorminnerproduct->num_output = innerproduct->num_output;
+        rmsnorminnerproduct->bias_term = innerproduct->bias_term;
+        rmsnorminnerproduct->weight_data_size = innerproduct->weight_data_size;
+        rmsnorminnerproduct->eps = rmsnorm->eps;
+        rmsnorminnerproduct->activation_type = innerproduct->activation_type;
+        rmsnorminnerproduct->activation_params = innerproduct->activation_params;
+
+        // fold gamma into weight
+        // w[n][k] = w[n][k] * gamma[k]
+        rmsnorminnerproduct->weight_data = innerproduct->weight_data;
+        if (rmsnorm->affine)
+        {
+            float* weight = rmsnorminnerproduct->weight_data;
+            const float* gamma = rmsnorm->gamma_data;
+            for (int n = 0; n < innerproduct->num_output; n++)
+            {
+                float* weight_outch = weight + num_input * n;
+                for (int k = 0; k < num_input; k++)
+                {
+                    weight_outch[k] *= gamma[k];
+                }
+            }
+        }
+        rmsnorminnerproduct->bias_data = innerproduct->bias_data;
+
+        blobs[rmsnorminnerproduct->bottoms[0]].consumer = j;
+
+        rmsnorm->type = "ncnnfused";
+
+        layers[j] = rmsnorminnerproduct;
+        delete innerproduct;
+    }
+
+    return 0;
+}
+
 int NetOptimize::eliminate_dropout()
 {
     const size_t layer_count = layers.size();
@@ -2826,6 +3009,8 @@ int main(int argc, char** argv)
     optimizer.fuse_innerproduct_activation();
     optimizer.fuse_memorydata_binaryop();
     optimizer.fuse_binaryop_eltwise();
+    optimizer.fuse_slice_sigmoid_binaryop();
+    optimizer.fuse_rmsnorm_innerproduct();
 
     optimizer.eliminate_dropout();
     optimizer.eliminate_pooling1x1();
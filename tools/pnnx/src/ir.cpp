@@ -1786,6 +1786,22 @@ int Graph::python(const std::string& pypath, const std::string& pnnxbinpath, con
                 const std::string& key = op->attrs.begin()->first;
                 fprintf(pyfp, "v_%s = self.%s_%s\n", sanitize_identifier(op->outputs[0]->name).c_str(), sanitize_identifier(op->name).c_str(), sanitize_identifier(key).c_str());
             }
+            else if (op->type == "pnnx.RotaryEmbed")
+            {
+                // x * cos + rotate(x) * sin
+                std::string x = "v_" + sanitize_identifier(op->inputs[0]->name);
+                std::string cos = "v_" + sanitize_identifier(op->inputs[1]->name);
+                std::string sin = "v_" + sanitize_identifier(op->inputs[2]->name);
+                fprintf(pyfp, "v_%s = %s * %s + ", sanitize_identifier(op->outputs[0]->name).c_str(), x.c_str(), cos.c_str());
+                if (op->params.at("interleaved").b)
+                {
+                    fprintf(pyfp, "torch.stack((-%s[..., 1::2], %s[..., ::2]), dim=-1).flatten(-2) * %s\n", x.c_str(), x.c_str(), sin.c_str());
+                }
+                else
+                {
+                    fprintf(pyfp, "torch.cat((-%s[..., %s.size(-1) // 2:], %s[..., :%s.size(-1) // 2]), dim=-1) * %s\n", x.c_str(), x.c_str(), x.c_str(), x.c_str(), sin.c_str());
+                }
+            }
             else if (op->type == "Tensor.slice")
             {
                 // slice expr
@@ -35,6 +35,7 @@
 #include "pass_level5/fuse_pad_conv1d.h"
 #include "pass_level5/fuse_pad_conv2d.h"
 #include "pass_level5/fuse_rmsnorm.h"
+#include "pass_level5/fuse_rotary_embedding.h"
 #include "pass_level5/fuse_scaled_dot_product_attention.h"
 #include "pass_level5/fuse_select_to_unbind.h"
 #include "pass_level5/fuse_silu.h"
@@ -139,6 +140,7 @@ void pass_level5(Graph& g, const std::set<std::string>& foldable_constants, cons
     fuse_channel_shuffle(g);
     fuse_layernorm(g);
     fuse_rmsnorm(g);
+    fuse_rotary_embedding(g);
 
     fuse_transformers_multiheadattention(g);
     fuse_multiheadattention(g);
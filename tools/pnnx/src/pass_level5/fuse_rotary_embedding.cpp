@@ -0,0 +1,95 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "fuse_rotary_embedding.h"
+
+#include "pass_level2.h"
+
+namespace pnnx {
+
+class fuse_rotary_embedding_pass : public GraphRewriterPass
+{
+public:
+    // x * cos + rotate_half(x) * sin
+    // rotate_half(x) = cat(-x[..., half:], x[..., :half]), the two slices are fused into tensor_split already
+    const char* match_pattern_graph() const
+    {
+        return R"PNNXIR(7767517
+8 8
+pnnx.Input              input_0     0 1 input
+pnnx.Input              input_1     0 1 cos
+pnnx.Input              input_2     0 1 sin
+torch.tensor_split      op_0        1 2 input x1 x2 dim=%dim0 indices=(%half)
+pnnx.Expression         op_1        1 1 x2 nx2 expr=neg(@0)
+torch.cat               op_2        2 1 nx2 x1 rh dim=%dim1
+pnnx.Expression         op_3        4 1 input cos rh sin out expr=add(mul(@0,@1),mul(@2,@3))
+pnnx.Output             output      1 0 out
+)PNNXIR";
+    }
+
+    const char* replace_pattern_graph() const
+    {
+        return R"PNNXIR(7767517
+5 4
+pnnx.Input              input_0     0 1 input
+pnnx.Input              input_1     0 1 cos
+pnnx.Input              input_2     0 1 sin
+pnnx.RotaryEmbed        rope        3 1 input cos sin out interleaved=False
+pnnx.Output             output      1 0 out
+)PNNXIR";
+    }
+
+    bool match(const std::map<std::string, const Operator*>& matched_operators, const std::map<std::string, Parameter>& captured_params, const std::map<std::string, Attribute>& /*captured_attrs*/) const
+    {
+        const std::vector<int>& input_shape = matched_operators.at("op_0")->inputs[0]->shape;
+        const int input_rank = (int)input_shape.size();
+        if (input_rank == 0)
+            return false;
+
+        // split and cat on the last axis
+        const int dim0 = captured_params.at("dim0").i;
+        const int dim1 = captured_params.at("dim1").i;
+        if ((dim0 != -1 && dim0 != input_rank - 1) || (dim1 != -1 && dim1 != input_rank - 1))
+            return false;
+
+        // the two halves split the last axis evenly
+        const int size = input_shape[input_rank - 1];
+        const int half = captured_params.at("half").i;
+        if (size <= 0 || half * 2 != size)
+            return false;
+
+        return true;
+    }
+};
+
+class fuse_rotary_embedding_pass_1 : public fuse_rotary_embedding_pass
+{
+public:
+    // x * cos + sin * rotate_half(x)
+    const char* match_pattern_graph() const
+    {
+        return R"PNNXIR(7767517
+8 8
+pnnx.Input              input_0     0 1 input
+pnnx.Input              input_1     0 1 cos
+pnnx.Input              input_2     0 1 sin
+torch.tensor_split      op_0        1 2 input x1 x2 dim=%dim0 indices=(%half)
+pnnx.Expression         op_1        1 1 x2 nx2 expr=neg(@0)
+torch.cat               op_2        2 1 nx2 x1 rh dim=%dim1
+pnnx.Expression         op_3        4 1 input cos sin rh out expr=add(mul(@0,@1),mul(@2,@3))
+pnnx.Output             output      1 0 out
+)PNNXIR";
+    }
+};
+
+void fuse_rotary_embedding(Graph& graph)
+{
+    fuse_rotary_embedding_pass a;
+    fuse_rotary_embedding_pass_1 b;
+    int opindex = 0;
+
+    pnnx_graph_rewrite(graph, &a, opindex);
+    pnnx_graph_rewrite(graph, &b, opindex);
+}
+
+} // namespace pnnx
@@ -0,0 +1,10 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "ir.h"
+
+namespace pnnx {
+
+void fuse_rotary_embedding(Graph& graph);
+
+} // namespace pnnx
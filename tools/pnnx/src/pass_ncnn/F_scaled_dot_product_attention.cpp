@@ -259,6 +259,90 @@ pnnx.Output             output      1 0 out
 
 REGISTER_GLOBAL_PNNX_NCNN_GRAPH_REWRITER_PASS(F_scaled_dot_product_attention_4, 10)
 
+class F_scaled_dot_product_attention_5 : public F_scaled_dot_product_attention
+{
+public:
+    // self attention with kv cache, torch.cat has been converted to Concat here
+    // past_k past_v are the projected key value of previous tokens
+    const char* match_pattern_graph() const
+    {
+        return R"PNNXIR(7767517
+20 19
+pnnx.Input              input_0     0 1 input
+pnnx.Input              input_1     0 1 attn_mask
+pnnx.Input              input_2     0 1 past_k
+pnnx.Input              input_3     0 1 past_v
+nn.Linear               op_0        1 1 input q bias=%qbias in_features=%qdim out_features=%embed_dim @bias @weight
+nn.Linear               op_1        1 1 input 11 bias=%kbias in_features=%kdim out_features=%embed_dim @bias @weight
+nn.Linear               op_2        1 1 input 13 bias=%vbias in_features=%vdim out_features=%embed_dim @bias @weight
+Concat                  op_3        2 1 past_k 11 k 0=0
+Concat                  op_4        2 1 past_v 13 v 0=0
+Tensor.reshape          op_5        1 1 q 10 shape=(%batch,%qsize,%num_heads,%feat_per_head)
+Tensor.reshape          op_6        1 1 k 12 shape=(%batch,%kvsize,%num_heads,%feat_per_head)
+Tensor.reshape          op_7        1 1 v 14 shape=(%batch,%kvsize,%num_heads,%feat_per_head)
+Tensor.permute          op_8        1 1 10 16 dims=(0,2,1,3)
+Tensor.permute          op_9        1 1 12 17 dims=(0,2,1,3)
+Tensor.permute          op_10       1 1 14 18 dims=(0,2,1,3)
+F.scaled_dot_product_attention sdpa 4 1 16 17 18 attn_mask 19 %*=%*
+Tensor.permute          op_12       1 1 19 20 dims=(0,2,1,3)
+Tensor.reshape          op_13       1 1 20 21 shape=(%batch,%qsize,%embed_dim)
+nn.Linear               out_proj    1 1 21 out bias=%outbias in_features=%embed_dim out_features=%qdim @bias @weight
+pnnx.Output             output      3 0 out k v
+)PNNXIR";
+    }
+
+    const char* name_str() const
+    {
+        return "sdpa_attention_kv_cache";
+    }
+
+    void write(Operator* op, const std::map<std::string, Parameter>& captured_params, const std::map<std::string, Attribute>& captured_attrs) const
+    {
+        F_scaled_dot_product_attention::write(op, captured_params, captured_attrs);
+        op->params["7"] = 1;
+    }
+};
+
+REGISTER_GLOBAL_PNNX_NCNN_GRAPH_REWRITER_PASS(F_scaled_dot_product_attention_5, 9)
+
+class F_scaled_dot_product_attention_6 : public F_scaled_dot_product_attention_5
+{
+public:
+    const char* match_pattern_graph() const
+    {
+        return R"PNNXIR(7767517
+19 18
+pnnx.Input              input_0     0 1 input
+pnnx.Input              input_1     0 1 past_k
+pnnx.Input              input_2     0 1 past_v
+nn.Linear               op_0        1 1 input q bias=%qbias in_features=%qdim out_features=%embed_dim @bias @weight
+nn.Linear               op_1        1 1 input 11 bias=%kbias in_features=%kdim out_features=%embed_dim @bias @weight
+nn.Linear               op_2        1 1 input 13 bias=%vbias in_features=%vdim out_features=%embed_dim @bias @weight
+Concat                  op_3        2 1 past_k 11 k 0=0
+Concat                  op_4        2 1 past_v 13 v 0=0
+Tensor.reshape          op_5        1 1 q 10 shape=(%batch,%qsize,%num_heads,%feat_per_head)
+Tensor.reshape          op_6        1 1 k 12 shape=(%batch,%kvsize,%num_heads,%feat_per_head)
+Tensor.reshape          op_7        1 1 v 14 shape=(%batch,%kvsize,%num_heads,%feat_per_head)
+Tensor.permute          op_8        1 1 10 16 dims=(0,2,1,3)
+Tensor.permute          op_9        1 1 12 17 dims=(0,2,1,3)
+Tensor.permute          op_10       1 1 14 18 dims=(0,2,1,3)
+F.scaled_dot_product_attention sdpa 3 1 16 17 18 19 %*=%*
+Tensor.permute          op_12       1 1 19 20 dims=(0,2,1,3)
+Tensor.reshape          op_13       1 1 20 21 shape=(%batch,%qsize,%embed_dim)
+nn.Linear               out_proj    1 1 21 out bias=%outbias in_features=%embed_dim out_features=%qdim @bias @weight
+pnnx.Output             output      3 0 out k v
+)PNNXIR";
+    }
+
+    void write(Operator* op, const std::map<std::string, Parameter>& captured_params, const std::map<std::string, Attribute>& captured_attrs) const
+    {
+        F_scaled_dot_product_attention_5::write(op, captured_params, captured_attrs);
+        op->params["5"] = 0;
+    }
+};
+
+REGISTER_GLOBAL_PNNX_NCNN_GRAPH_REWRITER_PASS(F_scaled_dot_product_attention_6, 9)
+
 } // namespace ncnn
 
 } // namespace pnnx
@@ -0,0 +1,57 @@
+# Copyright 2025 Tencent
+# SPDX-License-Identifier: BSD-3-Clause
+
+import torch
+import torch.nn as nn
+import torch.nn.functional as F
+
+def rotate_half(x):
+    x1 = x[..., : x.shape[-1] // 2]
+    x2 = x[..., x.shape[-1] // 2 :]
+    return torch.cat((-x2, x1), dim=-1)
+
+class Model(nn.Module):
+    def __init__(self):
+        super(Model, self).__init__()
+
+    def forward(self, q, k, cos0, sin0, cos1, sin1):
+        q = q * cos0 + rotate_half(q) * sin0
+        k = k * cos1 + sin1 * rotate_half(k)
+        return q, k
+
+def test():
+    net = Model()
+    net.eval()
+
+    torch.manual_seed(0)
+    q = torch.rand(1, 8, 16, 64)
+    k = torch.rand(1, 12, 32)
+    cos0 = torch.rand(1, 1, 16, 64)
+    sin0 = torch.rand(1, 1, 16, 64)
+    cos1 = torch.rand(1, 12, 32)
+    sin1 = torch.rand(1, 12, 32)
+
+    a = net(q, k, cos0, sin0, cos1, sin1)
+
+    # export torchscript
+    mod = torch.jit.trace(net, (q, k, cos0, sin0, cos1, sin1))
+    mod.save("test_ncnn_fuse_rotary_embedding.pt")
+
+    # torchscript to pnnx
+    import os
+    os.system("../../src/pnnx test_ncnn_fuse_rotary_embedding.pt inputshape=[1,8,16,64],[1,12,32],[1,1,16,64],[1,1,16,64],[1,12,32],[1,12,32]")
+
+    # ncnn inference
+    import test_ncnn_fuse_rotary_embedding_ncnn
+    b = test_ncnn_fuse_rotary_embedding_ncnn.test_inference()
+
+    for a0, b0 in zip(a, b):
+        if not torch.allclose(a0, b0, 1e-4, 1e-4):
+            return False
+    return True
+
+if __name__ == "__main__":
+    if test():
+        exit(0)
+    else:
+        exit(1)
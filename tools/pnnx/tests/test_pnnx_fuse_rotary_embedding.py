@@ -0,0 +1,52 @@
+# Copyright 2025 Tencent
+# SPDX-License-Identifier: BSD-3-Clause
+
+import torch
+import torch.nn as nn
+import torch.nn.functional as F
+
+def rotate_half(x):
+    x1 = x[..., : x.shape[-1] // 2]
+    x2 = x[..., x.shape[-1] // 2 :]
+    return torch.cat((-x2, x1), dim=-1)
+
+class Model(nn.Module):
+    def __init__(self):
+        super(Model, self).__init__()
+
+    def forward(self, q, k, cos, sin):
+        q = q * cos + rotate_half(q) * sin
+        k = k * cos + sin * rotate_half(k)
+        return q, k
+
+def test():
+    net = Model()
+    net.eval()
+
+    torch.manual_seed(0)
+    q = torch.rand(1, 8, 16, 64)
+    k = torch.rand(1, 2, 16, 64)
+    cos = torch.rand(1, 1, 16, 64)
+    sin = torch.rand(1, 1, 16, 64)
+
+    a0, a1 = net(q, k, cos, sin)
+
+    # export torchscript
+    mod = torch.jit.trace(net, (q, k, cos, sin))
+    mod.save("test_pnnx_fuse_rotary_embedding.pt")
+
+    # torchscript to pnnx
+    import os
+    os.system("../src/pnnx test_pnnx_fuse_rotary_embedding.pt inputshape=[1,8,16,64],[1,2,16,64],[1,1,16,64],[1,1,16,64]")
+
+    # pnnx inference
+    import test_pnnx_fuse_rotary_embedding_pnnx
+    b0, b1 = test_pnnx_fuse_rotary_embedding_pnnx.test_inference()
+
+    return torch.allclose(a0, b0, 1e-4, 1e-4) and torch.allclose(a1, b1, 1e-4, 1e-4)
+
+if __name__ == "__main__":
+    if test():
+        exit(0)
+    else:
+        exit(1)
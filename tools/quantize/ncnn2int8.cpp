@@ -126,6 +126,8 @@ public:
     int quantize_gemm();
     int quantize_multiheadattention();
 
+    int quantize_weight_only(int weight_bits, int group_size);
+
     int fuse_requantize();
 };
 
@@ -281,6 +283,9 @@ int NetQuantize::quantize_innerproduct()
         // InnerProduct - quantize weight from fp32 to int8
         ncnn::InnerProduct* fc = (ncnn::InnerProduct*)layers[i];
 
+        if (fc->weight_quant_bits)
+            continue;
+
         ncnn::Mat bottom_blob_int8_scales = iter_data->second;
         ncnn::Mat weight_data_int8_scales = iter->second;
 
@@ -614,6 +619,9 @@ int NetQuantize::quantize_gemm()
         // Gemm - quantize weight from fp32 to int8
         ncnn::Gemm* gemm = (ncnn::Gemm*)layers[i];
 
+        if (gemm->weight_quant_bits)
+            continue;
+
         fprintf(stderr, "quantize_gemm %s\n", gemm->name.c_str());
 
         // TODO move to ncnn2table
@@ -721,6 +729,12 @@ int NetQuantize::quantize_multiheadattention()
         // MultiHeadAttention - quantize weight from fp32 to int8
         ncnn::MultiHeadAttention* mha = (ncnn::MultiHeadAttention*)layers[i];
 
+        if (mha->kv_cache)
+        {
+            fprintf(stderr, "skip quantize_multiheadattention %s with kv_cache\n", mha->name.c_str());
+            continue;
+        }
+
         fprintf(stderr, "quantize_multiheadattention %s\n", mha->name.c_str());
 
         // TODO move to ncnn2table
@@ -842,6 +856,135 @@ int NetQuantize::quantize_multiheadattention()
     return 0;
 }
 
+// asymmetric min/max quantization of each group_size run in each row, w = (q - zero) * scale
+static int quantize_weight_groups(const ncnn::Mat& weight, int weight_bits, int group_size, ncnn::Mat& weight_q, ncnn::Mat& scales, ncnn::Mat& zeros)
+{
+    const int K = weight.w;
+    const int N = weight.h;
+    const int num_group = K / group_size;
+
+    const int qmin = weight_bits == 4 ? -8 : -128;
+    const int qmax = weight_bits == 4 ? 7 : 127;
+
+    weight_q.create(K * N, (size_t)1u);
+    scales.create(num_group, N);
+    zeros.create(num_group, N);
+    if (weight_q.empty() || scales.empty() || zeros.empty())
+        return -100;
+
+    for (int i = 0; i < N; i++)
+    {
+        const float* ptr = weight.row(i);
+        signed char* qptr = (signed char*)weight_q + i * K;
+
+        for (int g = 0; g < num_group; g++)
+        {
+            float minv = ptr[g * group_size];
+            float maxv = ptr[g * group_size];
+            for (int j = 1; j < group_size; j++)
+            {
+                minv = std::min(minv, ptr[g * group_size + j]);
+                maxv = std::max(maxv, ptr[g * group_size + j]);
+            }
+
+            float scale = (maxv - minv) / (qmax - qmin);
+            if (scale == 0.f)
+            {
+                // constant group
+                scale = minv == 0.f ? 1.f : (float)fabs(minv);
+            }
+
+            const int zero = std::min(std::max((int)round(qmin - minv / scale), qmin), qmax);
+
+            for (int j = 0; j < group_size; j++)
+            {
+                const int q = (int)round(ptr[g * group_size + j] / scale) + zero;
+                qptr[g * group_size + j] = (signed char)std::min(std::max(q, qmin), qmax);
+            }
+
+            scales.row(i)[g] = scale;
+            zeros.row(i)[g] = (float)zero;
+        }
+    }
+
+    return 0;
+}
+
+int NetQuantize::quantize_weight_only(int weight_bits, int group_size)
+{
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (layers[i]->type == "InnerProduct")
+        {
+            ncnn::InnerProduct* fc = (ncnn::InnerProduct*)layers[i];
+
+            if (fc->int8_scale_term || fc->weight_quant_bits)
+                continue;
+
+            const int num_input = fc->weight_data_size / fc->num_output;
+            if (num_input % group_size != 0)
+            {
+                fprintf(stderr, "skip quantize_weight_only %s, num_input %d not divisible by group_size %d\n", fc->name.c_str(), num_input, group_size);
+                continue;
+            }
+
+            fprintf(stderr, "quantize_weight_only %s\n", fc->name.c_str());
+
+            ncnn::Mat weight_data_q;
+            int ret = quantize_weight_groups(fc->weight_data.reshape(num_input, fc->num_output), weight_bits, group_size, weight_data_q, fc->weight_quant_scales, fc->weight_quant_zeros);
+            if (ret != 0)
+                return ret;
+
+            fc->weight_data = weight_data_q;
+            fc->weight_quant_bits = weight_bits;
+            fc->weight_quant_group_size = group_size;
+        }
+
+        if (layers[i]->type == "Gemm")
+        {
+            ncnn::Gemm* gemm = (ncnn::Gemm*)layers[i];
+
+            if (!gemm->constantB || gemm->int8_scale_term || gemm->weight_quant_bits)
+                continue;
+
+            if (gemm->constantK % group_size != 0)
+            {
+                fprintf(stderr, "skip quantize_weight_only %s, constantK %d not divisible by group_size %d\n", gemm->name.c_str(), gemm->constantK, group_size);
+                continue;
+            }
+
+            fprintf(stderr, "quantize_weight_only %s\n", gemm->name.c_str());
+
+            if (gemm->transB == 0)
+            {
+                // transpose so that groups run along K
+                ncnn::Mat B_data_transposed(gemm->constantK * gemm->constantN);
+                for (int i = 0; i < gemm->constantN; i++)
+                {
+                    float* ptr = (float*)B_data_transposed + i * gemm->constantK;
+                    for (int j = 0; j < gemm->constantK; j++)
+                    {
+                        ptr[j] = gemm->B_data[j * gemm->constantN + i];
+                    }
+                }
+                gemm->B_data = B_data_transposed;
+                gemm->transB = 1;
+            }
+
+            ncnn::Mat B_data_q;
+            int ret = quantize_weight_groups(gemm->B_data.reshape(gemm->constantK, gemm->constantN), weight_bits, group_size, B_data_q, gemm->B_data_quant_scales, gemm->B_data_quant_zeros);
+            if (ret != 0)
+                return ret;
+
+            gemm->B_data = B_data_q;
+            gemm->weight_quant_bits = weight_bits;
+            gemm->weight_quant_group_size = group_size;
+        }
+    }
+
+    return 0;
+}
+
 int NetQuantize::fuse_requantize()
 {
     const size_t layer_count = layers.size();
@@ -1047,9 +1190,9 @@ int NetQuantize::fuse_requantize()
 
 int main(int argc, char** argv)
 {
-    if (argc != 5 && argc != 6)
+    if (argc < 5)
     {
-        fprintf(stderr, "usage: %s [inparam] [inbin] [outparam] [outbin] [calibration table]\n", argv[0]);
+        fprintf(stderr, "usage: %s [inparam] [inbin] [outparam] [outbin] [calibration table] [weight_bits=4/8] [group_size=128]\n", argv[0]);
         return -1;
     }
 
@@ -1057,7 +1200,51 @@ int main(int argc, char** argv)
     const char* inbin = argv[2];
     const char* outparam = argv[3];
     const char* outbin = argv[4];
-    const char* int8scale_table_path = argc == 6 ? argv[5] : NULL;
+    const char* int8scale_table_path = NULL;
+
+    // weight only quantization of innerproduct and gemm, 0=off
+    int weight_bits = 0;
+    int group_size = 128;
+
+    for (int i = 5; i < argc; i++)
+    {
+        // key=value
+        char* kv = argv[i];
+
+        char* eqs = strchr(kv, '=');
+        if (eqs == NULL)
+        {
+            int8scale_table_path = kv;
+            continue;
+        }
+
+        // split k v
+        eqs[0] = '\0';
+        const char* key = kv;
+        char* value = eqs + 1;
+
+        if (strcmp(key, "weight_bits") == 0)
+            weight_bits = atoi(value);
+        else if (strcmp(key, "group_size") == 0)
+            group_size = atoi(value);
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", key);
+            return -1;
+        }
+    }
+
+    if (weight_bits != 0 && weight_bits != 4 && weight_bits != 8)
+    {
+        fprintf(stderr, "weight_bits must be 4 or 8\n");
+        return -1;
+    }
+
+    if (weight_bits && (group_size <= 0 || group_size % 16 != 0))
+    {
+        fprintf(stderr, "group_size must be a positive multiple of 16\n");
+        return -1;
+    }
 
     NetQuantize quantizer;
     quantizer.storage_type = 1; // use fp16 where int8 not applied
@@ -1083,18 +1270,26 @@ int main(int argc, char** argv)
     else
         quantizer.load_model(inbin);
 
-    quantizer.quantize_convolution();
-    quantizer.quantize_convolutiondepthwise();
-    quantizer.quantize_innerproduct();
-
-    quantizer.quantize_rnn();
-    quantizer.quantize_lstm();
-    quantizer.quantize_gru();
-    quantizer.quantize_embed();
-    quantizer.quantize_gemm();
-    quantizer.quantize_multiheadattention();
+    if (weight_bits)
+    {
+        quantizer.quantize_weight_only(weight_bits, group_size);
+    }
 
-    quantizer.fuse_requantize();
+    if (!weight_bits || int8scale_table_path)
+    {
+        quantizer.quantize_convolution();
+        quantizer.quantize_convolutiondepthwise();
+        quantizer.quantize_innerproduct();
+
+        quantizer.quantize_rnn();
+        quantizer.quantize_lstm();
+        quantizer.quantize_gru();
+        quantizer.quantize_embed();
+        quantizer.quantize_gemm();
+        quantizer.quantize_multiheadattention();
+
+        quantizer.fuse_requantize();
+    }
 
     quantizer.save(outparam, outbin);
 